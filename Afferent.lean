@@ -12,6 +12,11 @@ import Afferent.Core.Paint
 
 -- Rendering
 import Afferent.Render.Tessellation
+import Afferent.Render.PolygonFill
+import Afferent.Render.GradientLUT
+import Afferent.Render.VertexWriter
+import Afferent.Render.NativeTessellation
+import Afferent.Render.Polyline
 import Afferent.Render.Dynamic
 import Afferent.Render.Matrix4
 import Afferent.Render.Mesh
@@ -19,6 +24,9 @@ import Afferent.Render.FPSCamera
 
 -- Canvas API
 import Afferent.Canvas.State
+import Afferent.Canvas.TessellationCache
+import Afferent.Canvas.Culling
+import Afferent.Canvas.DeferredTessellation
 import Afferent.Canvas.Context
 
 -- Text
@@ -7,7 +7,14 @@ import Afferent.Core.Path
 import Afferent.Core.Transform
 import Afferent.Core.Paint
 import Afferent.Canvas.State
+import Afferent.Canvas.TessellationCache
+import Afferent.Canvas.Culling
+import Afferent.Canvas.DeferredTessellation
 import Afferent.Render.Tessellation
+import Afferent.Render.PolygonFill
+import Afferent.Render.GradientLUT
+import Afferent.Render.VertexWriter
+import Afferent.Render.Polyline
 import Afferent.Text.Font
 import Afferent.FFI
 
@@ -97,7 +104,7 @@ def fillRect (ctx : DrawContext) (rect : Rect) (color : Color) : IO Unit := do
   -- Use base (logical) canvas size for NDC conversion to maintain coordinate system
   let result := Tessellation.tessellateRectNDC rect color ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
@@ -107,12 +114,12 @@ def fillRect (ctx : DrawContext) (rect : Rect) (color : Color) : IO Unit := do
 def fillRectXYWH (ctx : DrawContext) (x y w h : Float) (color : Color) : IO Unit :=
   ctx.fillRect (Rect.mk' x y w h) color
 
-/-- Fill a convex path with a solid color (pixel coordinates). -/
+/-- Fill a path with a solid color (pixel coordinates), honoring its fill rule. -/
 def fillPath (ctx : DrawContext) (path : Path) (color : Color) : IO Unit := do
   -- Use base (logical) canvas size for NDC conversion to maintain coordinate system
-  let result := Tessellation.tessellateConvexPathNDC path color ctx.baseWidth ctx.baseHeight
+  let result ← Tessellation.tessellatePathNDC path color ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
@@ -137,7 +144,7 @@ def fillRectWithStyle (ctx : DrawContext) (rect : Rect) (style : FillStyle) : IO
   -- Use base (logical) canvas size for NDC conversion to maintain coordinate system
   let result := Tessellation.tessellateRectFillNDC rect style ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
@@ -147,18 +154,19 @@ def fillRectWithStyle (ctx : DrawContext) (rect : Rect) (style : FillStyle) : IO
 def fillTransformedRectWithStyle (ctx : DrawContext) (rect : Rect) (transform : Transform) (style : FillStyle) : IO Unit := do
   let result := Tessellation.tessellateTransformedRectNDC rect transform style ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
     FFI.Buffer.destroy vertexBuffer
 
-/-- Fill a convex path with a fill style (solid color or gradient). -/
+/-- Fill a path with a fill style (solid color or gradient), honoring its fill rule. -/
 def fillPathWithStyle (ctx : DrawContext) (path : Path) (style : FillStyle) : IO Unit := do
   -- Use base (logical) canvas size for NDC conversion to maintain coordinate system
-  let result := Tessellation.tessellateConvexPathFillNDC path style ctx.baseWidth ctx.baseHeight
+  let result ← Tessellation.tessellatePathFillNDC path path Transform.identity style
+    ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
@@ -196,7 +204,7 @@ def strokePath (ctx : DrawContext) (path : Path) (style : StrokeStyle) : IO Unit
   -- Use base (logical) canvas size for NDC conversion to maintain coordinate system
   let result := Tessellation.tessellateStrokeNDC path style ctx.baseWidth ctx.baseHeight
   if result.vertices.size > 0 && result.indices.size > 0 then
-    let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer result.vertices
+    let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer result.vertices
     let indexBuffer ← FFI.Buffer.createIndex ctx.renderer result.indices
     ctx.renderer.drawTriangles vertexBuffer indexBuffer result.indices.size.toUInt32
     FFI.Buffer.destroy indexBuffer
@@ -236,8 +244,10 @@ def drawLine (ctx : DrawContext) (p1 p2 : Point) (color : Color) (lineWidth : Fl
     This is much faster than issuing separate draw calls for each shape. -/
 def drawBatch (ctx : DrawContext) (batch : Batch) : IO Unit := do
   if batch.isEmpty then return
-  let vertexBuffer ← FFI.Buffer.createVertex ctx.renderer batch.vertices
-  let indexBuffer ← FFI.Buffer.createIndex ctx.renderer batch.indices
+  let vertexBuffer ← FFI.Buffer.createVertexFloatArray ctx.renderer batch.vertices
+  let indexBuffer ← match batch.indexFormat with
+    | .u16 => FFI.Buffer.createIndexU16ByteArray ctx.renderer batch.indexData
+    | .u32 => FFI.Buffer.createIndexByteArray ctx.renderer batch.indexData
   ctx.renderer.drawTriangles vertexBuffer indexBuffer batch.indexCount.toUInt32
   FFI.Buffer.destroy indexBuffer
   FFI.Buffer.destroy vertexBuffer
@@ -310,25 +320,61 @@ structure Canvas where
   stateStack : StateStack
   /-- Active batch accumulator. When Some, drawing ops add to batch instead of drawing immediately. -/
   batch : Option Batch := none
-  /-- Auto-batch: always accumulates geometry, flushed at endFrame. Reduces per-draw allocations. -/
-  autoBatch : Batch := Batch.withCapacity 100
+  /-- Auto-batch: always accumulates geometry, flushed at endFrame. A native writer appended
+      in place and cleared, not freed, at each flush, so its capacity carries across frames. -/
+  autoBatch : FFI.VertexWriter
+  /-- Solid rects, circles and ellipses as shape instances, drawn with one instanced draw.
+      Only one of this and `autoBatch` holds geometry at a time: switching kinds flushes the
+      other first, so painter's order is kept and runs of the same kind share a draw. -/
+  shapeInstances : FFI.VertexWriter
+  /-- Whether solid rects, circles and ellipses go to `shapeInstances` (default: true). -/
+  instancingEnabled : Bool := true
+  /-- Active clip in canvas coordinates, as set by `clip`. -/
+  clipRect : Option Rect := none
+  /-- Whether draws entirely outside the canvas or clip are skipped (default: true). -/
+  cullingEnabled : Bool := true
+  /-- Culling counters of the frame in progress. -/
+  frameCullStats : CullStats := {}
+  /-- Culling counters of the last finished frame. -/
+  lastCullStats : CullStats := {}
+  /-- Whether fills and strokes carry a one-pixel alpha fringe along their edges (default: false). -/
+  fringeAntialiasing : Bool := false
   /-- Whether auto-batching is enabled (default: true). Use CanvasM for automatic state threading. -/
   autoBatchEnabled : Bool := true
   /-- Pre-allocated buffer for instanced rendering (avoids per-frame allocation). -/
-  instanceBuffer : Array Float := #[]
+  instanceBuffer : FloatArray := .empty
   /-- Capacity of instance buffer (in number of instances, not floats). -/
   instanceBufferCapacity : Nat := 0
   /-- High-performance mutable FloatBuffer for zero-copy instanced rendering. -/
   floatBuffer : Option FFI.FloatBuffer := none
   /-- Capacity of FloatBuffer (in floats). -/
   floatBufferCapacity : Nat := 0
+  /-- Local-space tessellations of paths drawn in earlier frames. Held by reference so
+      draws update it in place however the Canvas itself is threaded. -/
+  tessCache : IO.Ref TessellationCache
+  /-- Whether path fills and strokes go through `tessCache` (default: true). -/
+  tessCacheEnabled : Bool := true
+  /-- Auto-batched path fills and strokes not yet tessellated, in draw order. Held by
+      reference, like `tessCache`. -/
+  deferred : IO.Ref (Array DeferredDraw)
+  /-- Tasks deferred draws are tessellated on; 0 (default) tessellates each draw at once. -/
+  tessellationWorkers : Nat := 0
+  /-- Color tables of the gradients filled so far, by stops. Held by reference, like
+      `tessCache`. -/
+  gradientLUTs : IO.Ref GradientLUTCache
 
 namespace Canvas
 
 /-- Create a new canvas with a window. -/
 def create (width height : UInt32) (title : String) : IO Canvas := do
   let ctx ← DrawContext.create width height title
-  pure { ctx, stateStack := StateStack.new }
+  let tessCache ← IO.mkRef TessellationCache.empty
+  let deferred ← IO.mkRef #[]
+  let gradientLUTs ← IO.mkRef ({} : GradientLUTCache)
+  let autoBatch ← FFI.VertexWriter.create
+  let shapeInstances ← FFI.VertexWriter.create 12
+  pure { ctx, stateStack := StateStack.new, autoBatch, shapeInstances, tessCache, deferred,
+         gradientLUTs }
 
 /-- Get the current state. -/
 def state (c : Canvas) : CanvasState :=
@@ -415,6 +461,52 @@ def setAutoBatch (enabled : Bool) (c : Canvas) : Canvas :=
 def isAutoBatching (c : Canvas) : Bool :=
   c.autoBatchEnabled
 
+/-- Enable or disable the tessellation cache. When enabled (default), path fills and
+    strokes reuse geometry tessellated for the same path and style in earlier frames. -/
+def setTessellationCache (enabled : Bool) (c : Canvas) : Canvas :=
+  { c with tessCacheEnabled := enabled }
+
+/-- Enable or disable primitive instancing. When enabled (default) and auto-batching,
+    solid rects, circles and ellipses are drawn as instances instead of triangles. -/
+def setInstancing (enabled : Bool) (c : Canvas) : Canvas :=
+  { c with instancingEnabled := enabled }
+
+/-- Enable or disable culling. When enabled (default), fills and strokes whose bounds
+    lie entirely outside the canvas or the active clip are skipped before tessellation. -/
+def setCulling (enabled : Bool) (c : Canvas) : Canvas :=
+  { c with cullingEnabled := enabled }
+
+/-- Enable or disable fringe anti-aliasing. When enabled, path fills, rects and strokes
+    are inset by half a pixel and ringed by a one-pixel alpha ramp, giving smooth edges
+    without MSAA; pair it with `FFI.Renderer.setMSAAEnabled false` to save MSAA's fill
+    rate and memory. Rects are drawn as fringed paths rather than shape instances, and
+    immediate-mode draws (auto-batch off, no explicit batch) are not fringed. Solid
+    circles and ellipses stay shape instances, whose shader softens their edge itself
+    and whose pipeline follows the MSAA setting. -/
+def setFringeAntialiasing (enabled : Bool) (c : Canvas) : Canvas :=
+  { c with fringeAntialiasing := enabled }
+
+/-- Defer tessellation of auto-batched path fills and strokes and spread it over up to
+    `workers` Lean tasks. Draws are recorded until the auto-batch is next flushed (by a
+    shape instance, text, a clip or endFrame), then tessellated together and appended in
+    draw order, so the frame is unchanged. Pays off on frames with thousands of paths;
+    0 (default) tessellates each draw as it is made. -/
+def setTessellationWorkers (workers : Nat) (c : Canvas) : Canvas :=
+  { c with tessellationWorkers := workers }
+
+/-- Draws tested and culled in the last finished frame. -/
+def cullStats (c : Canvas) : CullStats :=
+  c.lastCullStats
+
+/-- Hit, miss and eviction counters and size of the tessellation cache. -/
+def tessellationCacheStats (c : Canvas) : IO TessellationCacheStats :=
+  return (← c.tessCache.get).stats
+
+/-- Color table of the current fill style's gradient (see `GradientLUT.toRGBA8`), for
+    backends that evaluate gradients per pixel; `none` for a solid fill. -/
+def fillGradientLUT (c : Canvas) : IO (Option GradientLUT) :=
+  GradientLUTCache.forStyle c.gradientLUTs c.state.effectiveFillStyle
+
 /-- Execute an action with batching enabled.
     All shapes drawn within the action are batched and drawn with a single draw call at the end. -/
 def batched (capacityHint : Nat := 1000) (action : Canvas → IO Canvas) (c : Canvas) : IO Canvas := do
@@ -449,7 +541,11 @@ def batchInstancedRectsBy (count : Nat)
       c.instanceBuffer
     else
       -- Allocate with some headroom to avoid frequent reallocation
-      Array.replicate floatCount 0.0
+      Id.run do
+        let mut zeros := FloatArray.emptyWithCapacity floatCount
+        for _ in [:floatCount] do
+          zeros := zeros.push 0.0
+        return zeros
   -- Fill instance data using set! for in-place mutation (8 floats per instance)
   let mut data := data
   for i in [:count] do
@@ -470,38 +566,116 @@ def batchInstancedRectsBy (count : Nat)
     data := data.set! (base + 6) color.b
     data := data.set! (base + 7) color.a
   -- Single GPU draw call with instancing
-  FFI.Renderer.drawInstancedRects c.ctx.renderer data count.toUInt32
+  FFI.Renderer.drawInstancedRectsFloatArray c.ctx.renderer data count.toUInt32
   -- Return canvas with buffer for reuse next frame
   pure { c with instanceBuffer := data, instanceBufferCapacity := count }
 
 /-! ## Drawing operations -/
 
-/-- Fill a path using the current state. Batch-aware: adds to batch if active.
-    When auto-batching is enabled, geometry is accumulated and drawn at endFrame.
-    Note: Gradients are sampled at original path positions since gradient coordinates
-    are defined in the original coordinate space. -/
-def fillPath (path : Path) (c : Canvas) : IO Canvas := do
-  let transformedPath := c.state.transformPath path
-  let style := c.state.effectiveFillStyle
-  -- Use both original and transformed paths: original for gradient sampling, transformed for positions
-  let result := Tessellation.tessellateConvexPathFillNDCWithOriginal path transformedPath style c.ctx.baseWidth c.ctx.baseHeight
+/-- Tessellate the deferred draws across `tessellationWorkers` tasks and append them to
+    the auto-batch in the order they were drawn. -/
+private def resolveDeferred (c : Canvas) : IO Unit := do
+  let draws ← c.deferred.modifyGet fun draws => (draws, #[])
+  if draws.isEmpty then return
+  let cache := if c.tessCacheEnabled then some c.tessCache else none
+  let results ← DeferredTessellation.tessellateAll draws c.tessellationWorkers cache
+    c.ctx.baseWidth c.ctx.baseHeight
+  for result in results do
+    (VertexWriterM.emitTessellation result).run c.autoBatch
+
+/-- Draw and clear pending auto-batch triangles, so instances appended next stay above them. -/
+private def flushAutoTriangles (c : Canvas) : IO Unit := do
+  c.resolveDeferred
+  if (← c.autoBatch.vertexCount) != 0 then
+    c.ctx.renderer.drawVertexWriter c.autoBatch
+    c.autoBatch.clear
+
+/-- Draw and clear pending shape instances, so triangles appended next stay above them. -/
+private def flushShapeInstances (c : Canvas) : IO Unit := do
+  if (← c.shapeInstances.vertexCount) != 0 then
+    c.ctx.renderer.drawInstancedShapesWriter c.shapeInstances
+    c.shapeInstances.clear
+
+/-- The region a draw must overlap to be kept: the clip if one is set, else the canvas. -/
+private def cullRegion (c : Canvas) : Bounds :=
+  Bounds.ofRect (c.clipRect.getD (Rect.mk' 0 0 c.ctx.baseWidth c.ctx.baseHeight))
+
+/-- Test a draw against the cull region and count it; true if it can be skipped.
+    `bounds` is only evaluated with culling on; `none` (unknown) is always kept. -/
+private def cull (c : Canvas) (bounds : Unit → Option Bounds) : Bool × Canvas :=
+  if !c.cullingEnabled then (false, c)
+  else
+    let culled := match bounds () with
+      | some b => b.disjoint c.cullRegion
+      | none => false
+    (culled, { c with frameCullStats := c.frameCullStats.record culled })
+
+/-- How far a fringe reaches past a shape's outline: half a fringe when fringe
+    anti-aliasing is on, else nothing. -/
+private def fringePad (c : Canvas) : Float :=
+  if c.fringeAntialiasing then Tessellation.fringeWidth / 2 else 0
+
+/-- The fill color when the next fill can be a shape instance: auto-batching with no
+    explicit batch, instancing on, and a solid fill style. -/
+private def instanceFillColor? (c : Canvas) : Option Color :=
+  if c.batch.isNone && c.autoBatchEnabled && c.instancingEnabled then
+    match c.state.effectiveFillStyle with
+    | .solid color => some color
+    | _ => none
+  else none
+
+/-- Add a path fill or stroke to the active batch, or run `immediate` when not batching.
+    Auto-batched draws are deferred while `tessellationWorkers` is nonzero. -/
+private def addPathDraw (draw : DeferredDraw) (immediate : IO Unit) (c : Canvas) : IO Canvas := do
+  let cache := if c.tessCacheEnabled then some c.tessCache else none
   match c.batch with
   | some batch =>
+    let result ← draw.tessellate cache c.ctx.baseWidth c.ctx.baseHeight
     pure { c with batch := some (batch.add result) }
   | none =>
     if c.autoBatchEnabled then
-      -- Auto-batch: accumulate in autoBatch, will be flushed at endFrame
-      pure { c with autoBatch := c.autoBatch.add result }
+      c.flushShapeInstances
+      if c.tessellationWorkers > 0 then
+        -- Tessellated with the rest of the run when the auto-batch is next flushed
+        c.deferred.modify (·.push draw)
+      else
+        -- Auto-batch: append to autoBatch in place, will be flushed at endFrame
+        c.resolveDeferred
+        let result ← draw.tessellate cache c.ctx.baseWidth c.ctx.baseHeight
+        (VertexWriterM.emitTessellation result).run c.autoBatch
+      pure c
     else
       -- Immediate mode: draw directly (legacy behavior)
-      c.ctx.fillPathWithStyle transformedPath style
+      immediate
       pure c
 
+/-- `fillPath` without the culling test, for callers that have already culled. -/
+private def fillPathUnculled (path : Path) (c : Canvas) : IO Canvas := do
+  let style := c.state.effectiveFillStyle
+  let lut ← GradientLUTCache.forStyle c.gradientLUTs style
+  -- The draw keeps the original path for gradient sampling; vertices go through the transform
+  c.addPathDraw { path, state := c.state, style := .fill style, antialias := c.fringeAntialiasing, lut }
+    (c.ctx.fillPathWithStyle (c.state.transformPath path) style)
+
+/-- Fill a path using the current state. Batch-aware: adds to batch if active.
+    When auto-batching is enabled, geometry is accumulated and drawn at endFrame.
+    Note: Gradients are sampled at original path positions since gradient coordinates
+    are defined in the original coordinate space. Concave, holed and self-intersecting
+    paths are filled according to `path.fillRule`. -/
+def fillPath (path : Path) (c : Canvas) : IO Canvas := do
+  let (culled, c) := c.cull fun _ => (Culling.pathBounds c.state.transform path).map (·.inflate c.fringePad)
+  if culled then return c
+  c.fillPathUnculled path
+
 /-- Fill a rectangle using the current state. Batch-aware: adds to batch if active.
     Uses fast path that skips Path allocation - just transforms 4 corners directly.
     When auto-batching is enabled, geometry is accumulated and drawn at endFrame. -/
 def fillRect (rect : Rect) (c : Canvas) : IO Canvas := do
   let transform := c.state.transform
+  let (culled, c) := c.cull fun _ => some ((Culling.rectBounds transform rect).inflate c.fringePad)
+  if culled then return c
+  -- The rect fast paths have hard edges; a fringed rect is a four-point path
+  if c.fringeAntialiasing then return (← c.fillPathUnculled (Path.rectangle rect))
   let style := c.state.effectiveFillStyle
   match c.batch with
   | some batch =>
@@ -509,10 +683,18 @@ def fillRect (rect : Rect) (c : Canvas) : IO Canvas := do
     let batch' := batch.addTransformedRect rect transform style c.ctx.baseWidth c.ctx.baseHeight
     pure { c with batch := some batch' }
   | none =>
-    if c.autoBatchEnabled then
-      -- Auto-batch: accumulate in autoBatch, will be flushed at endFrame
-      let autoBatch' := c.autoBatch.addTransformedRect rect transform style c.ctx.baseWidth c.ctx.baseHeight
-      pure { c with autoBatch := autoBatch' }
+    if let some color := c.instanceFillColor? then
+      -- Solid rect: one shape instance, merged with neighbouring rects and ellipses
+      c.flushAutoTriangles
+      (VertexWriterM.emitRectInstance rect transform color c.ctx.baseWidth c.ctx.baseHeight).run
+        c.shapeInstances
+      pure c
+    else if c.autoBatchEnabled then
+      -- Auto-batch: append to autoBatch in place, will be flushed at endFrame
+      c.flushShapeInstances
+      c.resolveDeferred
+      (VertexWriterM.emitTransformedRect rect transform style c.ctx.baseWidth c.ctx.baseHeight).run c.autoBatch
+      pure c
     else
       -- Immediate mode: draw directly (legacy behavior)
       c.ctx.fillTransformedRectWithStyle rect transform style
@@ -522,13 +704,27 @@ def fillRect (rect : Rect) (c : Canvas) : IO Canvas := do
 def fillRectXYWH (x y width height : Float) (c : Canvas) : IO Canvas :=
   c.fillRect (Rect.mk' x y width height)
 
-/-- Fill a circle using the current state. Batch-aware: adds to batch if active. -/
-def fillCircle (center : Point) (radius : Float) (c : Canvas) : IO Canvas :=
-  c.fillPath (Path.circle center radius)
+/-- Fill an ellipse as one shape instance when it can be, else as `path`. -/
+private def fillEllipseOr (center : Point) (radiusX radiusY : Float) (path : Unit → Path)
+    (c : Canvas) : IO Canvas := do
+  let (culled, c) := c.cull fun _ => some (Culling.ellipseBounds c.state.transform center radiusX radiusY)
+  if culled then return c
+  match c.instanceFillColor? with
+  | some color =>
+    c.flushAutoTriangles
+    (VertexWriterM.emitEllipseInstance center radiusX radiusY c.state.transform color
+      c.ctx.baseWidth c.ctx.baseHeight).run c.shapeInstances
+    pure c
+  | none => c.fillPathUnculled (path ())
 
-/-- Fill an ellipse using the current state. Batch-aware: adds to batch if active. -/
+/-- Fill an ellipse using the current state. Batch-aware: adds to batch if active.
+    A solid auto-batched ellipse is one shape instance rather than a tessellated path. -/
 def fillEllipse (center : Point) (radiusX radiusY : Float) (c : Canvas) : IO Canvas :=
-  c.fillPath (Path.ellipse center radiusX radiusY)
+  c.fillEllipseOr center radiusX radiusY fun _ => Path.ellipse center radiusX radiusY
+
+/-- Fill a circle using the current state. Batch-aware: adds to batch if active. -/
+def fillCircle (center : Point) (radius : Float) (c : Canvas) : IO Canvas :=
+  c.fillEllipseOr center radius radius fun _ => Path.circle center radius
 
 /-- Fill a rounded rectangle using the current state. Batch-aware: adds to batch if active. -/
 def fillRoundedRect (rect : Rect) (cornerRadius : Float) (c : Canvas) : IO Canvas :=
@@ -545,20 +741,14 @@ private def effectiveStrokeStyle (c : Canvas) : StrokeStyle :=
 /-- Stroke a path using the current state. Batch-aware: adds to batch if active.
     When auto-batching is enabled, geometry is accumulated and drawn at endFrame. -/
 def strokePath (path : Path) (c : Canvas) : IO Canvas := do
-  let transformedPath := c.state.transformPath path
   let style := c.effectiveStrokeStyle
-  let result := Tessellation.tessellateStrokeNDC transformedPath style c.ctx.baseWidth c.ctx.baseHeight
-  match c.batch with
-  | some batch =>
-    pure { c with batch := some (batch.add result) }
-  | none =>
-    if c.autoBatchEnabled then
-      -- Auto-batch: accumulate in autoBatch, will be flushed at endFrame
-      pure { c with autoBatch := c.autoBatch.add result }
-    else
-      -- Immediate mode: draw directly (legacy behavior)
-      c.ctx.strokePath transformedPath style
-      pure c
+  let (culled, c) := c.cull fun _ =>
+    -- A fringe widens the stroke by half a fringe per side, miters included
+    let padded := { style with lineWidth := style.lineWidth + 2 * c.fringePad }
+    (Culling.pathBounds c.state.transform path).map (·.inflate (Culling.strokePad padded))
+  if culled then return c
+  c.addPathDraw { path, state := c.state, style := .stroke style, antialias := c.fringeAntialiasing }
+    (c.ctx.strokePath (c.state.transformPath path) style)
 
 /-- Stroke a rectangle using the current state. -/
 def strokeRect (rect : Rect) (c : Canvas) : IO Canvas :=
@@ -584,16 +774,28 @@ def strokeRoundedRect (rect : Rect) (cornerRadius : Float) (c : Canvas) : IO Can
 def drawLine (p1 p2 : Point) (c : Canvas) : IO Canvas :=
   c.strokePath (Path.empty |>.moveTo p1 |>.lineTo p2)
 
+/-- Stroke a polyline of x, y pairs using the current state, for large line and chart
+    series. It is first reduced to the points visible under the current transform
+    (see `Polyline.reduce`), so only a few points per pixel column reach the stroker;
+    `none` strokes every point. -/
+def strokePolyline (points : FloatArray) (reduction : Option PolylineReduction := some .auto)
+    (c : Canvas) : IO Canvas := do
+  let points ← match reduction with
+    | some method => Polyline.reduce points c.state.transform (method := method)
+    | none => pure points
+  c.strokePath (Polyline.toPath points)
+
 /-! ## Text operations -/
 
 /-- Flush the auto-batch if it has any pending geometry.
-    Used internally before operations that require a different pipeline (e.g., text). -/
-private def flushAutoBatch (c : Canvas) : IO Canvas := do
-  if c.autoBatchEnabled && !c.autoBatch.isEmpty then
-    c.ctx.drawBatch c.autoBatch
-    pure { c with autoBatch := Batch.withCapacity 100 }
-  else
-    pure c
+    Used before operations that require a different pipeline (e.g., text) or
+    that draw outside the Canvas (command streams). -/
+def flushAutoBatch (c : Canvas) : IO Canvas := do
+  if c.autoBatchEnabled then
+    -- At most one of the two holds geometry
+    c.flushAutoTriangles
+    c.flushShapeInstances
+  pure c
 
 /-- Draw text at a position with a font using the current fill color and transform.
     Note: Text uses a different shader and cannot be batched with shapes.
@@ -648,21 +850,25 @@ def beginFrame (clearColor : Color) (c : Canvas) : IO Bool :=
   c.ctx.beginFrame clearColor
 
 /-- End the current frame. Flushes auto-batch if enabled and presents.
-    Returns updated Canvas with reset autoBatch for next frame. -/
+    The auto-batch is cleared with its capacity kept for the next frame, and the
+    frame's culling counters become `cullStats`. -/
 def endFrame (c : Canvas) : IO Canvas := do
-  -- Flush auto-batch if enabled and has geometry
-  if c.autoBatchEnabled && !c.autoBatch.isEmpty then
-    c.ctx.drawBatch c.autoBatch
+  let c ← c.flushAutoBatch
+  -- Drop geometry left while auto-batching was switched off mid-frame
+  c.deferred.set #[]
+  c.autoBatch.clear
+  c.shapeInstances.clear
   c.ctx.endFrame
-  -- Reset autoBatch for next frame (reuse capacity hint from original size)
-  pure { c with autoBatch := Batch.withCapacity 100 }
+  pure { c with lastCullStats := c.frameCullStats, frameCullStats := {} }
 
 /-- End the current frame (unit version for compatibility).
     Prefer using endFrame when you need the updated Canvas. -/
 def endFrame' (c : Canvas) : IO Unit := do
   discard (c.endFrame)
 
-def destroy (c : Canvas) : IO Unit :=
+def destroy (c : Canvas) : IO Unit := do
+  c.autoBatch.destroy
+  c.shapeInstances.destroy
   c.ctx.destroy
 
 def width (c : Canvas) : IO Float := c.ctx.width
@@ -693,7 +899,7 @@ def clip (rect : Rect) (c : Canvas) : IO Canvas := do
   let w := (rect.width * scaleX).toUInt32
   let h := (rect.height * scaleY).toUInt32
   c.ctx.setScissor x y w h
-  pure c
+  pure { c with clipRect := some rect }
 
 /-- Remove clipping and restore full viewport.
     Flushes any pending auto-batch geometry before resetting the scissor. -/
@@ -701,7 +907,7 @@ def unclip (c : Canvas) : IO Canvas := do
   -- Flush pending geometry so it renders with the current clip
   let c ← c.flushAutoBatch
   c.ctx.resetScissor
-  pure c
+  pure { c with clipRect := none }
 
 /-- Run a render loop with a Canvas that maintains state across frames.
     The draw function can return a modified Canvas with updated state. -/
@@ -800,6 +1006,8 @@ def strokeCircle (center : Point) (radius : Float) : CanvasM Unit := liftCanvas
 def strokeEllipse (center : Point) (radiusX radiusY : Float) : CanvasM Unit := liftCanvas (Canvas.strokeEllipse center radiusX radiusY)
 def strokeRoundedRect (rect : Rect) (cornerRadius : Float) : CanvasM Unit := liftCanvas (Canvas.strokeRoundedRect rect cornerRadius)
 def drawLine (p1 p2 : Point) : CanvasM Unit := liftCanvas (Canvas.drawLine p1 p2)
+def strokePolyline (points : FloatArray) (reduction : Option PolylineReduction := some .auto) : CanvasM Unit :=
+  liftCanvas (Canvas.strokePolyline points reduction)
 
 /-! ## Text operations -/
 
@@ -820,7 +1028,18 @@ def unclip : CanvasM Unit := liftCanvas Canvas.unclip
 
 def beginBatch (capacityHint : Nat := 1000) : CanvasM Unit := modifyCanvas (fun c => Canvas.beginBatch c capacityHint)
 def flushBatch : CanvasM Unit := liftCanvas Canvas.flushBatch
+def flushAutoBatch : CanvasM Unit := liftCanvas Canvas.flushAutoBatch
 def setAutoBatch (enabled : Bool) : CanvasM Unit := modifyCanvas (Canvas.setAutoBatch enabled)
+def setTessellationCache (enabled : Bool) : CanvasM Unit := modifyCanvas (Canvas.setTessellationCache enabled)
+def setInstancing (enabled : Bool) : CanvasM Unit := modifyCanvas (Canvas.setInstancing enabled)
+def tessellationCacheStats : CanvasM TessellationCacheStats := do (← get).tessellationCacheStats
+def fillGradientLUT : CanvasM (Option GradientLUT) := do (← get).fillGradientLUT
+def setCulling (enabled : Bool) : CanvasM Unit := modifyCanvas (Canvas.setCulling enabled)
+def cullStats : CanvasM CullStats := do return (← get).cullStats
+def setFringeAntialiasing (enabled : Bool) : CanvasM Unit :=
+  modifyCanvas (Canvas.setFringeAntialiasing enabled)
+def setTessellationWorkers (workers : Nat) : CanvasM Unit :=
+  modifyCanvas (Canvas.setTessellationWorkers workers)
 
 /-! ## Accessors -/
 
@@ -0,0 +1,124 @@
+/-
+  Afferent Canvas Culling
+  Conservative device-space bounds for Canvas draws, so shapes that land
+  entirely outside the canvas or the active clip are skipped before they are
+  flattened, tessellated or uploaded. Bounds come from the control-point hull
+  of the path as `CanvasState.transformPath` places it: a cubic or quadratic
+  lies inside the hull of its control points, so no curve is flattened to
+  find them.
+-/
+import Afferent.Core.Path
+import Afferent.Core.Transform
+import Afferent.Core.Paint
+
+namespace Afferent
+
+/-- Axis-aligned bounds in canvas pixels. -/
+structure Bounds where
+  minX : Float
+  minY : Float
+  maxX : Float
+  maxY : Float
+deriving Repr, BEq, Inhabited
+
+namespace Bounds
+
+private def inf : Float := 1.0 / 0.0
+
+/-- Covers nothing; `include` grows it. -/
+def empty : Bounds := { minX := inf, minY := inf, maxX := -inf, maxY := -inf }
+
+def isEmpty (b : Bounds) : Bool := b.minX > b.maxX || b.minY > b.maxY
+
+def ofRect (r : Rect) : Bounds :=
+  { minX := r.x, minY := r.y, maxX := r.x + r.width, maxY := r.y + r.height }
+
+/-- Grow to cover `p`, or the square of half-size `pad` around it. -/
+def include (b : Bounds) (p : Point) (pad : Float := 0) : Bounds :=
+  { minX := min b.minX (p.x - pad), minY := min b.minY (p.y - pad),
+    maxX := max b.maxX (p.x + pad), maxY := max b.maxY (p.y + pad) }
+
+/-- Grow by `pad` on every side (stroke half-widths). -/
+def inflate (b : Bounds) (pad : Float) : Bounds :=
+  { minX := b.minX - pad, minY := b.minY - pad, maxX := b.maxX + pad, maxY := b.maxY + pad }
+
+/-- True only when the two provably do not overlap. NaN bounds never count as
+    disjoint, so a degenerate transform draws rather than vanishes. -/
+def disjoint (a b : Bounds) : Bool :=
+  a.maxX < b.minX || b.maxX < a.minX || a.maxY < b.minY || b.maxY < a.minY
+
+end Bounds
+
+/-- Draws tested against the viewport or clip and how many were skipped. -/
+structure CullStats where
+  tested : Nat := 0
+  culled : Nat := 0
+deriving Repr, BEq, Inhabited
+
+namespace CullStats
+
+def record (s : CullStats) (culled : Bool) : CullStats :=
+  { tested := s.tested + 1, culled := if culled then s.culled + 1 else s.culled }
+
+end CullStats
+
+namespace Culling
+
+/-- Box around the whole ellipse `center + cos θ * axisX + sin θ * axisY` under `t`:
+    half-extents are the lengths of the rows of the transformed axis matrix. -/
+private def includeEllipse (b : Bounds) (t : Transform) (center axisX axisY : Point) : Bounds :=
+  let c := t.apply center
+  let u := t.applyVector axisX
+  let v := t.applyVector axisY
+  let ex := Float.sqrt (u.x * u.x + v.x * v.x)
+  let ey := Float.sqrt (u.y * u.y + v.y * v.y)
+  (b.include ⟨c.x - ex, c.y - ey⟩).include ⟨c.x + ex, c.y + ey⟩
+
+/-- Bounds of `path` as `CanvasState.transformPath` draws it under `t`: the hull of
+    the transformed control points, arcs as their whole transformed ellipse, and a
+    rect from its transformed origin (transformPath does not scale rect sizes).
+    `none` for an empty path, and for `arcTo`, whose tangent points are not
+    bounded by its control points. -/
+def pathBounds (t : Transform) (path : Path) : Option Bounds := Id.run do
+  let mut b := Bounds.empty
+  for cmd in path.commands do
+    match cmd with
+    | .moveTo p | .lineTo p => b := b.include (t.apply p)
+    | .quadraticCurveTo cp p => b := (b.include (t.apply cp)).include (t.apply p)
+    | .bezierCurveTo cp1 cp2 p =>
+      b := ((b.include (t.apply cp1)).include (t.apply cp2)).include (t.apply p)
+    | .arc center r _ _ _ => b := includeEllipse b t center ⟨r, 0⟩ ⟨0, r⟩
+    | .ellipseArc center axisX axisY _ _ => b := includeEllipse b t center axisX axisY
+    | .rect r =>
+      let q := t.apply r.origin
+      b := (b.include q).include ⟨q.x + r.width, q.y + r.height⟩
+    | .arcTo .. => return none
+    | .closePath => pure ()
+  return if b.isEmpty then none else some b
+
+/-- Bounds of `rect` under `t`: its four transformed corners. -/
+def rectBounds (t : Transform) (rect : Rect) : Bounds :=
+  [rect.topLeft, rect.topRight, rect.bottomRight, rect.bottomLeft].foldl
+    (fun b p => b.include (t.apply p)) Bounds.empty
+
+/-- Bounds of an ellipse under `t`: the image of the unit disc scaled by the radii
+    has half-extents |a·rx| + |c·ry| and |b·rx| + |d·ry|, padded by 0.1% against
+    rounding in the flattened points. -/
+def ellipseBounds (t : Transform) (center : Point) (radiusX radiusY : Float) : Bounds :=
+  let c := t.apply center
+  let ex := ((t.a * radiusX).abs + (t.c * radiusY).abs) * 1.001
+  let ey := ((t.b * radiusX).abs + (t.d * radiusY).abs) * 1.001
+  { minX := c.x - ex, minY := c.y - ey, maxX := c.x + ex, maxY := c.y + ey }
+
+/-- How far a stroke can reach past its path: half the line width, times the miter
+    limit for every join but bevel (round joins are drawn as capped miters) or √2
+    for square caps. Widths are in canvas pixels, as the stroker applies them to
+    the transformed path. -/
+def strokePad (style : StrokeStyle) : Float :=
+  let joinFactor := if style.lineJoin == .bevel then 1 else max style.miterLimit 1
+  let capFactor := if style.lineCap == .square then 1.4142135623730951 else 1
+  style.lineWidth.abs / 2 * max joinFactor capFactor
+
+end Culling
+
+end Afferent
@@ -0,0 +1,80 @@
+/-
+  Afferent Deferred Tessellation
+  Path fills and strokes recorded as they are drawn and tessellated together
+  when the auto-batch is flushed, spread over Lean tasks. Each draw's
+  tessellation depends only on its own path, style and transform, so they
+  run in any order; results are appended in submission order, so the batch
+  is the same as serial tessellation would build.
+-/
+import Afferent.Canvas.State
+import Afferent.Canvas.TessellationCache
+import Afferent.Render.PolygonFill
+
+namespace Afferent
+
+/-- A path fill or stroke waiting to be tessellated. -/
+structure DeferredDraw where
+  /-- The path as drawn, before `state.transform`. -/
+  path : Path
+  /-- State at the draw, for its transform. -/
+  state : CanvasState
+  /-- Effective fill or stroke style, global alpha applied. -/
+  style : CachedStyle
+  antialias : Bool := false
+  /-- Table of a gradient fill's stops, looked up when the draw was made. -/
+  lut : Option GradientLUT := none
+
+namespace DeferredDraw
+
+/-- Tessellate the draw in NDC for a `screenWidth`x`screenHeight` canvas, through
+    `cache` when one is given; what the Canvas would have emitted for it at once. -/
+def tessellate (d : DeferredDraw) (cache : Option (IO.Ref TessellationCache))
+    (screenWidth screenHeight : Float) : IO TessellationResult :=
+  match d.style, cache with
+  | .fill style, some cache =>
+    TessellationCache.fillPath cache d.path d.state style screenWidth screenHeight d.antialias d.lut
+  | .fill style, none =>
+    Tessellation.tessellatePathFillNDC d.path (d.state.transformPath d.path) d.state.transform style
+      screenWidth screenHeight (antialias := d.antialias) (lut := d.lut)
+  | .stroke style, some cache =>
+    TessellationCache.strokePath cache d.path d.state style screenWidth screenHeight d.antialias
+  | .stroke style, none =>
+    pure (Tessellation.tessellateStrokeNDC (d.state.transformPath d.path) style screenWidth
+      screenHeight (antialias := d.antialias))
+
+end DeferredDraw
+
+namespace DeferredTessellation
+
+/-- Fewest draws worth handing to each extra task; smaller runs stay on the caller. -/
+def minDrawsPerTask : Nat := 16
+
+/-- Tessellate `draws` on up to `workers` tasks, returning results in the order of
+    `draws`. Task `k` takes draws `k`, `k + tasks`, ..., so runs of large and small
+    paths are spread evenly. The first error raised by any draw is rethrown. -/
+def tessellateAll (draws : Array DeferredDraw) (workers : Nat)
+    (cache : Option (IO.Ref TessellationCache)) (screenWidth screenHeight : Float) :
+    IO (Array TessellationResult) := do
+  let tasks := max 1 (min workers (draws.size / minDrawsPerTask))
+  if tasks == 1 then
+    return (← draws.mapM (·.tessellate cache screenWidth screenHeight))
+  let strided (k : Nat) : IO (Array TessellationResult) := do
+    let mut out := Array.emptyWithCapacity (draws.size / tasks + 1)
+    let mut i := k
+    while i < draws.size do
+      out := out.push (← draws[i]!.tessellate cache screenWidth screenHeight)
+      i := i + tasks
+    return out
+  -- The caller takes stride 0 instead of waiting idle
+  let running ← (List.range tasks).tail.toArray.mapM fun k => IO.asTask (strided k)
+  let mut parts := #[← strided 0]
+  for task in running do
+    parts := parts.push (← IO.ofExcept (← IO.wait task))
+  let mut results := Array.emptyWithCapacity draws.size
+  for i in [:draws.size] do
+    results := results.push parts[i % tasks]![i / tasks]!
+  return results
+
+end DeferredTessellation
+
+end Afferent
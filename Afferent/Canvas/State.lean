@@ -130,7 +130,12 @@ def transformPath (state : CanvasState) (path : Path) : Path :=
     | .arcTo p1 p2 r =>
         .arcTo (state.transform.apply p1) (state.transform.apply p2) r  -- radius doesn't scale uniformly
     | .arc center r startAngle endAngle ccw =>
-        .arc (state.transform.apply center) r startAngle endAngle ccw  -- needs proper transform handling
+        -- An ellipse arc maps exactly, so the arc is scaled, skewed and flattened on screen
+        .ellipseArc (state.transform.apply center) (state.transform.applyVector ⟨r, 0⟩)
+          (state.transform.applyVector ⟨0, r⟩) startAngle (Path.arcSweep startAngle endAngle ccw)
+    | .ellipseArc center axisX axisY startAngle sweep =>
+        .ellipseArc (state.transform.apply center) (state.transform.applyVector axisX)
+          (state.transform.applyVector axisY) startAngle sweep
     | .rect rect =>
         -- Transform rectangle to path since rectangles don't transform well
         .rect { origin := state.transform.apply rect.origin, size := rect.size }
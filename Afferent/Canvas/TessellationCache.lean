@@ -0,0 +1,300 @@
+/-
+  Afferent Tessellation Cache
+  Tessellated fills and strokes kept across frames, so static shapes (widget
+  backgrounds, borders, icons) are flattened and triangulated once rather than
+  every frame. Geometry is stored in local space, keyed by a structural hash of
+  the path, the fill or stroke style and the transform's scale class; a hit
+  only maps the stored vertices through the current transform into NDC.
+  Least recently used entries are evicted to keep the cache within a byte
+  budget.
+-/
+import Std.Data.HashMap
+import Afferent.Canvas.State
+import Afferent.Render.PolygonFill
+
+namespace Afferent
+
+/-- The style a cached tessellation was built with. -/
+inductive CachedStyle where
+  | fill (style : FillStyle)
+  | stroke (style : StrokeStyle)
+deriving BEq
+
+/-- Everything a cached tessellation depends on. Compared in full on lookup, so a
+    hash collision is a miss rather than the wrong geometry. -/
+structure TessellationKey where
+  commands : Array PathCommand
+  fillRule : FillRule
+  style : CachedStyle
+  /-- Uniform scale the path was tessellated at; see `TessellationCache.fillScale`. -/
+  scale : Float
+  /-- Whether edges carry an anti-aliasing fringe. -/
+  antialias : Bool := false
+deriving BEq
+
+namespace TessellationKey
+
+private def hashFloat (h : UInt64) (x : Float) : UInt64 := mixHash h x.toBits
+
+private def hashPoint (h : UInt64) (p : Point) : UInt64 := hashFloat (hashFloat h p.x) p.y
+
+private def hashColor (h : UInt64) (c : Color) : UInt64 :=
+  hashFloat (hashFloat (hashFloat (hashFloat h c.r) c.g) c.b) c.a
+
+private def hashCommand (h : UInt64) : PathCommand → UInt64
+  | .moveTo p => hashPoint (mixHash h 1) p
+  | .lineTo p => hashPoint (mixHash h 2) p
+  | .quadraticCurveTo cp p => hashPoint (hashPoint (mixHash h 3) cp) p
+  | .bezierCurveTo cp1 cp2 p => hashPoint (hashPoint (hashPoint (mixHash h 4) cp1) cp2) p
+  | .arcTo p1 p2 r => hashFloat (hashPoint (hashPoint (mixHash h 5) p1) p2) r
+  | .arc center r startAngle endAngle ccw =>
+    let h := hashFloat (hashFloat (hashFloat (hashPoint (mixHash h 6) center) r) startAngle) endAngle
+    mixHash h (if ccw then 1 else 0)
+  | .ellipseArc center axisX axisY startAngle sweep =>
+    let h := hashPoint (hashPoint (hashPoint (mixHash h 9) center) axisX) axisY
+    hashFloat (hashFloat h startAngle) sweep
+  | .rect r => hashFloat (hashFloat (hashPoint (mixHash h 7) r.origin) r.size.width) r.size.height
+  | .closePath => mixHash h 8
+
+private def hashStops (h : UInt64) (stops : Array GradientStop) : UInt64 :=
+  stops.foldl (fun h s => hashColor (hashFloat h s.position) s.color) h
+
+private def hashStyle (h : UInt64) : CachedStyle → UInt64
+  | .fill (.solid c) => hashColor (mixHash h 1) c
+  | .fill (.gradient (.linear start finish stops)) =>
+    hashStops (hashPoint (hashPoint (mixHash h 2) start) finish) stops
+  | .fill (.gradient (.radial center radius stops)) =>
+    hashStops (hashFloat (hashPoint (mixHash h 3) center) radius) stops
+  | .stroke s =>
+    let h := hashFloat (hashFloat (hashColor (mixHash h 4) s.color) s.lineWidth) s.miterLimit
+    let cap : UInt64 := match s.lineCap with | .butt => 0 | .round => 1 | .square => 2
+    let join : UInt64 := match s.lineJoin with | .miter => 0 | .round => 1 | .bevel => 2
+    mixHash (mixHash h cap) join
+
+/-- Structural hash of the key. -/
+def hash (k : TessellationKey) : UInt64 :=
+  let h := k.commands.foldl hashCommand 7
+  let h := mixHash h (match k.fillRule with | .nonZero => 0 | .evenOdd => 1)
+  mixHash (hashFloat (hashStyle h k.style) k.scale) (if k.antialias then 1 else 0)
+
+end TessellationKey
+
+/-- A cached tessellation. -/
+structure TessellationCacheEntry where
+  key : TessellationKey
+  /-- Geometry tessellated at `key.scale` onto a `localCanvas` square canvas. -/
+  result : TessellationResult
+  bytes : Nat
+  lastUse : Nat
+
+/-- Counters for a tessellation cache. -/
+structure TessellationCacheStats where
+  hits : Nat
+  misses : Nat
+  /-- Draws whose transform no cached geometry can be reused under. -/
+  bypasses : Nat
+  evictions : Nat
+  entries : Nat
+  bytes : Nat
+deriving Repr
+
+/-- LRU cache of local-space tessellations with a byte budget. -/
+structure TessellationCache where
+  entries : Std.HashMap UInt64 TessellationCacheEntry := {}
+  /-- Upper bound on `bytes`. -/
+  budget : Nat
+  /-- Approximate heap size of the cached geometry. -/
+  bytes : Nat := 0
+  tick : Nat := 0
+  hits : Nat := 0
+  misses : Nat := 0
+  bypasses : Nat := 0
+  evictions : Nat := 0
+
+namespace TessellationCache
+
+/-- Default byte budget: 8 MB, a few thousand widget-sized shapes. -/
+def defaultBudget : Nat := 8 * 1024 * 1024
+
+/-- Create an empty cache. -/
+def empty (budget : Nat := defaultBudget) : TessellationCache := { budget }
+
+/-- Side of the square canvas cached geometry is tessellated onto. Its NDC is
+    pixel space flipped and shifted by one, so placing the geometry on the real
+    canvas is a single affine map. -/
+def localCanvas : Float := 2.0
+
+/-- Current counters and size. -/
+def stats (cache : TessellationCache) : TessellationCacheStats :=
+  { hits := cache.hits, misses := cache.misses, bypasses := cache.bypasses,
+    evictions := cache.evictions, entries := cache.entries.size, bytes := cache.bytes }
+
+/-- Approximate heap bytes of a tessellation: 8 per vertex float and per boxed index. -/
+def entryBytes (result : TessellationResult) : Nat :=
+  (result.vertices.size + result.indices.size) * 8 + 64
+
+/-- Look up a tessellation, marking it most recently used. -/
+def find? (cache : TessellationCache) (hash : UInt64) (key : TessellationKey) :
+    Option TessellationResult × TessellationCache :=
+  match cache.entries.get? hash with
+  | some entry =>
+    if entry.key == key then
+      let tick := cache.tick + 1
+      (some entry.result, { cache with
+        entries := cache.entries.insert hash { entry with lastUse := tick }
+        tick, hits := cache.hits + 1 })
+    else
+      (none, { cache with misses := cache.misses + 1 })
+  | none => (none, { cache with misses := cache.misses + 1 })
+
+/-- Evict least recently used entries down to 3/4 of the budget, so one sort
+    pays for many insertions. -/
+private def evict (cache : TessellationCache) : TessellationCache := Id.run do
+  let target := cache.budget * 3 / 4
+  let order := (cache.entries.toArray.map fun (h, e) => (e.lastUse, h, e.bytes)).qsort
+    (fun a b => a.1 < b.1)
+  let mut cache := cache
+  for (_, h, bytes) in order do
+    if cache.bytes <= target then break
+    cache := { cache with
+      entries := cache.entries.erase h
+      bytes := cache.bytes - bytes
+      evictions := cache.evictions + 1 }
+  return cache
+
+/-- Store a tessellation as most recently used, replacing any entry with the same
+    hash. Geometry larger than the whole budget is not stored. -/
+def insert (cache : TessellationCache) (hash : UInt64) (key : TessellationKey)
+    (result : TessellationResult) : TessellationCache :=
+  let bytes := entryBytes result
+  if bytes > cache.budget then cache
+  else
+    let replaced := match cache.entries.get? hash with
+      | some e => e.bytes
+      | none => 0
+    let tick := cache.tick + 1
+    let cache := { cache with
+      entries := cache.entries.insert hash { key, result, bytes, lastUse := tick }
+      bytes := cache.bytes - replaced + bytes
+      tick }
+    if cache.bytes > cache.budget then evict cache else cache
+
+/-- Drop every entry, keeping the counters. -/
+def clear (cache : TessellationCache) : TessellationCache :=
+  { cache with entries := {}, bytes := 0 }
+
+/-! ## Transform classes -/
+
+private def hasIdentityLinearPart (t : Transform) : Bool :=
+  t.a == 1.0 && t.b == 0.0 && t.c == 0.0 && t.d == 1.0
+
+/-- `transformPath` moves rects and arcTo radii without scaling or rotating them,
+    so paths containing them are only reused under translations. -/
+private def hasUntransformedCommands (path : Path) : Bool :=
+  path.commands.any fun
+    | .rect _ | .arcTo .. => true
+    | _ => false
+
+/-- Scale a fill under `t` is tessellated at: `t.maxScale` rounded up to a
+    quarter octave, so the flattening tolerance still holds on screen and nearby
+    scales share an entry. `none` when nothing can be reused. -/
+def fillScale (t : Transform) (path : Path) : Option Float :=
+  if hasIdentityLinearPart t then some 1.0
+  else if hasUntransformedCommands path || t.determinant == 0.0 then none
+  else
+    let s := t.maxScale
+    if !(s > 0.0) || s.isInf then none
+    else some (Float.exp2 (Float.ceil (4.0 * Float.log2 s - 1e-9) / 4.0))
+
+/-- Scale a stroke under `t` is tessellated at. Line widths are in screen pixels,
+    so only similarity transforms (rotation, reflection and uniform scale) can
+    reuse local geometry, and only at their own scale. The scale is snapped to
+    2^-20 of an octave so rounding in a rotation's matrix does not split entries;
+    the width error that leaves is below 1e-6 of the line width. -/
+def strokeScale (t : Transform) (path : Path) : Option Float :=
+  if hasIdentityLinearPart t then some 1.0
+  else if hasUntransformedCommands path then none
+  else
+    let p := t.a * t.a + t.b * t.b
+    let q := t.c * t.c + t.d * t.d
+    let r := t.a * t.c + t.b * t.d
+    let eps := 1e-9 * (p + q)
+    if p > 0.0 && !p.isInf && (p - q).abs <= eps && r.abs <= eps then
+      some (Float.exp2 (Float.round (Float.log2 (Float.sqrt p) * 1048576.0) / 1048576.0))
+    else none
+
+/-- Affine map from cached vertices (tessellated at uniform `scale` onto the local
+    canvas) to the NDC of a `w`x`h` canvas under `transform`. -/
+def placement (scale : Float) (transform : Transform) (w h : Float) : Transform :=
+  let fromLocalCanvas : Transform := { a := 1.0, b := 0.0, c := 0.0, d := -1.0, tx := 1.0, ty := 1.0 }
+  let toNDC : Transform := { a := 2.0 / w, b := 0.0, c := 0.0, d := -2.0 / h, tx := -1.0, ty := 1.0 }
+  ((fromLocalCanvas.concat (Transform.scale (1.0 / scale) (1.0 / scale))).concat transform).concat toNDC
+
+/-- Map cached vertex positions through `m`, keeping colors and indices. -/
+def place (result : TessellationResult) (m : Transform) : TessellationResult := Id.run do
+  let mut vertices := result.vertices
+  for i in [:vertices.size / 6] do
+    let base := i * 6
+    let x := vertices[base]!
+    let y := vertices[base + 1]!
+    vertices := vertices.set! base (m.a * x + m.c * y + m.tx)
+    vertices := vertices.set! (base + 1) (m.b * x + m.d * y + m.ty)
+  return { vertices, indices := result.indices }
+
+/-! ## Cached tessellation -/
+
+/-- Fill `path` under `state.transform` with `style`, in NDC, reusing cached
+    geometry when the path, style and scale class have been seen before. Same
+    output as `Tessellation.tessellatePathFillNDC` on the transformed path.
+    Antialiased fills have a fringe one screen pixel wide, so like strokes they are
+    only reused under similarity transforms, at their own scale. `lut` is the
+    gradient's table, passed on to the tessellator. -/
+def fillPath (cache : IO.Ref TessellationCache) (path : Path) (state : CanvasState)
+    (style : FillStyle) (screenWidth screenHeight : Float) (antialias : Bool := false)
+    (lut : Option GradientLUT := none) : IO TessellationResult := do
+  let scale? := if antialias then strokeScale state.transform path else fillScale state.transform path
+  match scale? with
+  | none =>
+    cache.modify fun c => { c with bypasses := c.bypasses + 1 }
+    Tessellation.tessellatePathFillNDC path (state.transformPath path) state.transform style
+      screenWidth screenHeight (antialias := antialias) (lut := lut)
+  | some scale =>
+    let key : TessellationKey :=
+      { commands := path.commands, fillRule := path.fillRule, style := .fill style, scale, antialias }
+    let hash := key.hash
+    let m := placement scale state.transform screenWidth screenHeight
+    if let some result := (← cache.modifyGet (·.find? hash key)) then
+      return place result m
+    let localState := { state with transform := Transform.scale scale scale }
+    let result ← Tessellation.tessellatePathFillNDC path (localState.transformPath path)
+      localState.transform style localCanvas localCanvas (antialias := antialias) (lut := lut)
+    cache.modify (·.insert hash key result)
+    return place result m
+
+/-- Stroke `path` under `state.transform` with `style`, in NDC, reusing cached
+    geometry when possible. Same output as `Tessellation.tessellateStrokeNDC` on
+    the transformed path. -/
+def strokePath (cache : IO.Ref TessellationCache) (path : Path) (state : CanvasState)
+    (style : StrokeStyle) (screenWidth screenHeight : Float) (antialias : Bool := false) :
+    IO TessellationResult := do
+  match strokeScale state.transform path with
+  | none =>
+    cache.modify fun c => { c with bypasses := c.bypasses + 1 }
+    return Tessellation.tessellateStrokeNDC (state.transformPath path) style screenWidth screenHeight
+      (antialias := antialias)
+  | some scale =>
+    let key : TessellationKey :=
+      { commands := path.commands, fillRule := path.fillRule, style := .stroke style, scale, antialias }
+    let hash := key.hash
+    let m := placement scale state.transform screenWidth screenHeight
+    if let some result := (← cache.modifyGet (·.find? hash key)) then
+      return place result m
+    let localState := { state with transform := Transform.scale scale scale }
+    let result := Tessellation.tessellateStrokeNDC (localState.transformPath path) style
+      localCanvas localCanvas (antialias := antialias)
+    cache.modify (·.insert hash key result)
+    return place result m
+
+end TessellationCache
+
+end Afferent
@@ -14,6 +14,10 @@ inductive PathCommand where
   | bezierCurveTo (cp1 cp2 : Point) (p : Point)
   | arcTo (p1 p2 : Point) (radius : Float)
   | arc (center : Point) (radius : Float) (startAngle endAngle : Float) (counterclockwise : Bool)
+  /-- Elliptical arc through `center + cos θ * axisX + sin θ * axisY` for θ from `startAngle`
+      over `sweep` (negative runs counterclockwise). Unlike `arc`, it maps exactly under any
+      affine transform, so it is flattened on screen at its on-screen size. -/
+  | ellipseArc (center axisX axisY : Point) (startAngle sweep : Float)
   | rect (r : Rect)
   | closePath
 deriving Repr, BEq
@@ -78,6 +82,27 @@ def arc (center : Point) (radius : Float) (startAngle endAngle : Float)
     commands := path.commands.push (.arc center radius startAngle endAngle counterclockwise)
     currentPoint := some endPt }
 
+/-- The point of an elliptical arc at angle `angle`; see `PathCommand.ellipseArc`. -/
+def ellipsePoint (center axisX axisY : Point) (angle : Float) : Point :=
+  let c := Float.cos angle
+  let s := Float.sin angle
+  ⟨center.x + axisX.x * c + axisY.x * s, center.y + axisX.y * c + axisY.y * s⟩
+
+/-- Signed sweep of an `arc` from `startAngle` to `endAngle`: positive (clockwise on
+    screen) unless `counterclockwise`, and at most one turn. -/
+def arcSweep (startAngle endAngle : Float) (counterclockwise : Bool) : Float :=
+  let twoPi := 2.0 * 3.14159265358979323846
+  let sweep := endAngle - startAngle
+  if counterclockwise then
+    if sweep > 0 then sweep - twoPi else sweep
+  else
+    if sweep < 0 then sweep + twoPi else sweep
+
+def ellipseArc (center axisX axisY : Point) (startAngle sweep : Float) (path : Path) : Path :=
+  { path with
+    commands := path.commands.push (.ellipseArc center axisX axisY startAngle sweep)
+    currentPoint := some (ellipsePoint center axisX axisY (startAngle + sweep)) }
+
 def rect (r : Rect) (path : Path) : Path :=
   { path with
     commands := path.commands.push (.rect r)
@@ -105,73 +130,52 @@ def rectangle (r : Rect) : Path :=
 def rectangleXYWH (x y width height : Float) : Path :=
   rectangle (Rect.mk' x y width height)
 
-/-- Approximate a circle using cubic Bezier curves (4 segments). -/
-def circle (center : Point) (radius : Float) : Path :=
-  -- Magic number for circular arc approximation with cubic beziers
-  -- k = 4/3 * tan(π/8) ≈ 0.5522847498
-  let k := 0.5522847498 * radius
-  let cx := center.x
-  let cy := center.y
-  let r := radius
-  empty
-    |>.moveTo ⟨cx + r, cy⟩
-    |>.bezierCurveTo ⟨cx + r, cy + k⟩ ⟨cx + k, cy + r⟩ ⟨cx, cy + r⟩
-    |>.bezierCurveTo ⟨cx - k, cy + r⟩ ⟨cx - r, cy + k⟩ ⟨cx - r, cy⟩
-    |>.bezierCurveTo ⟨cx - r, cy - k⟩ ⟨cx - k, cy - r⟩ ⟨cx, cy - r⟩
-    |>.bezierCurveTo ⟨cx + k, cy - r⟩ ⟨cx + r, cy - k⟩ ⟨cx + r, cy⟩
-    |>.closePath
-
 /-- Create an ellipse path. -/
 def ellipse (center : Point) (radiusX radiusY : Float) : Path :=
-  let k := 0.5522847498
-  let kx := k * radiusX
-  let ky := k * radiusY
-  let cx := center.x
-  let cy := center.y
+  let twoPi := 2.0 * 3.14159265358979323846
   empty
-    |>.moveTo ⟨cx + radiusX, cy⟩
-    |>.bezierCurveTo ⟨cx + radiusX, cy + ky⟩ ⟨cx + kx, cy + radiusY⟩ ⟨cx, cy + radiusY⟩
-    |>.bezierCurveTo ⟨cx - kx, cy + radiusY⟩ ⟨cx - radiusX, cy + ky⟩ ⟨cx - radiusX, cy⟩
-    |>.bezierCurveTo ⟨cx - radiusX, cy - ky⟩ ⟨cx - kx, cy - radiusY⟩ ⟨cx, cy - radiusY⟩
-    |>.bezierCurveTo ⟨cx + kx, cy - radiusY⟩ ⟨cx + radiusX, cy - ky⟩ ⟨cx + radiusX, cy⟩
+    |>.moveTo ⟨center.x + radiusX, center.y⟩
+    |>.ellipseArc center ⟨radiusX, 0⟩ ⟨0, radiusY⟩ 0 twoPi
     |>.closePath
 
+/-- Create a circle path: one full-turn elliptical arc, flattened into as many
+    segments as its on-screen radius needs. -/
+def circle (center : Point) (radius : Float) : Path :=
+  ellipse center radius radius
+
 /-- Create a rounded rectangle path. -/
 def roundedRect (r : Rect) (cornerRadius : Float) : Path :=
   let cr := min cornerRadius (min (r.width / 2) (r.height / 2))
-  let k := 0.5522847498 * cr
+  let halfPi := 3.14159265358979323846 / 2.0
   let x := r.x
   let y := r.y
   let w := r.width
   let h := r.height
+  let corner (cx cy start : Float) (path : Path) : Path :=
+    path.ellipseArc ⟨cx, cy⟩ ⟨cr, 0⟩ ⟨0, cr⟩ start halfPi
   empty
     |>.moveTo ⟨x + cr, y⟩
     |>.lineTo ⟨x + w - cr, y⟩
-    |>.bezierCurveTo ⟨x + w - cr + k, y⟩ ⟨x + w, y + cr - k⟩ ⟨x + w, y + cr⟩
+    |> corner (x + w - cr) (y + cr) (-halfPi)
     |>.lineTo ⟨x + w, y + h - cr⟩
-    |>.bezierCurveTo ⟨x + w, y + h - cr + k⟩ ⟨x + w - cr + k, y + h⟩ ⟨x + w - cr, y + h⟩
+    |> corner (x + w - cr) (y + h - cr) 0
     |>.lineTo ⟨x + cr, y + h⟩
-    |>.bezierCurveTo ⟨x + cr - k, y + h⟩ ⟨x, y + h - cr + k⟩ ⟨x, y + h - cr⟩
+    |> corner (x + cr) (y + h - cr) halfPi
     |>.lineTo ⟨x, y + cr⟩
-    |>.bezierCurveTo ⟨x, y + cr - k⟩ ⟨x + cr - k, y⟩ ⟨x + cr, y⟩
+    |> corner (x + cr) (y + cr) (2 * halfPi)
     |>.closePath
 
 /-- Convert an arc to cubic Bezier curves.
     Returns an array of (cp1, cp2, endPoint) tuples for each Bezier segment.
-    Uses the standard approach of splitting arcs > 90° into multiple segments. -/
+    Uses the standard approach of splitting arcs > 90° into multiple segments.
+    Paths no longer flatten arcs through this (see `PathCommand.ellipseArc`); it
+    is kept for consumers that need the Bezier form. -/
 def arcToBeziers (center : Point) (radius : Float) (startAngle endAngle : Float)
     (counterclockwise : Bool := false) : Array (Point × Point × Point) := Id.run do
   let pi := 3.14159265358979323846
-  let twoPi := 2.0 * pi
 
-  -- Normalize angles and compute sweep
   let mut start := startAngle
-  let mut sweep := endAngle - startAngle
-
-  if counterclockwise then
-    if sweep > 0 then sweep := sweep - twoPi
-  else
-    if sweep < 0 then sweep := sweep + twoPi
+  let sweep := arcSweep startAngle endAngle counterclockwise
 
   -- Split into segments of at most 90 degrees (π/2)
   let maxSweep := pi / 2.0
@@ -210,37 +214,20 @@ def arcToBeziers (center : Point) (radius : Float) (startAngle endAngle : Float)
   return result
 
 /-- Create a pie/wedge shape (like a pie chart slice). -/
-def pie (center : Point) (radius : Float) (startAngle endAngle : Float) : Path := Id.run do
-  let beziers := arcToBeziers center radius startAngle endAngle false
-
-  let startPt := Point.mk'
-    (center.x + radius * Float.cos startAngle)
-    (center.y + radius * Float.sin startAngle)
-
-  let mut path := empty
+def pie (center : Point) (radius : Float) (startAngle endAngle : Float) : Path :=
+  empty
     |>.moveTo center
-    |>.lineTo startPt
-
-  for (cp1, cp2, endPt) in beziers do
-    path := path.bezierCurveTo cp1 cp2 endPt
-
-  return path.closePath
+    |>.lineTo (ellipsePoint center ⟨radius, 0⟩ ⟨0, radius⟩ startAngle)
+    |>.ellipseArc center ⟨radius, 0⟩ ⟨0, radius⟩ startAngle (arcSweep startAngle endAngle false)
+    |>.closePath
 
 /-- Create an arc path (just the curved part, not closed). -/
 def arcPath (center : Point) (radius : Float) (startAngle endAngle : Float)
-    (counterclockwise : Bool := false) : Path := Id.run do
-  let beziers := arcToBeziers center radius startAngle endAngle counterclockwise
-
-  let startPt := Point.mk'
-    (center.x + radius * Float.cos startAngle)
-    (center.y + radius * Float.sin startAngle)
-
-  let mut path := empty |>.moveTo startPt
-
-  for (cp1, cp2, endPt) in beziers do
-    path := path.bezierCurveTo cp1 cp2 endPt
-
-  return path
+    (counterclockwise : Bool := false) : Path :=
+  empty
+    |>.moveTo (ellipsePoint center ⟨radius, 0⟩ ⟨0, radius⟩ startAngle)
+    |>.ellipseArc center ⟨radius, 0⟩ ⟨0, radius⟩ startAngle
+      (arcSweep startAngle endAngle counterclockwise)
 
 /-- Create a semicircle. -/
 def semicircle (center : Point) (radius : Float) (startAngle : Float := 0.0) : Path :=
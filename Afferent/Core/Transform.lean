@@ -66,6 +66,11 @@ def apply (t : Transform) (p : Point) : Point :=
   { x := t.a * p.x + t.c * p.y + t.tx
     y := t.b * p.x + t.d * p.y + t.ty }
 
+/-- Apply the linear part of a transform to a vector (no translation). -/
+def applyVector (t : Transform) (v : Point) : Point :=
+  { x := t.a * v.x + t.c * v.y
+    y := t.b * v.x + t.d * v.y }
+
 /-- Compute the determinant of the transform matrix. -/
 def determinant (t : Transform) : Float :=
   t.a * t.d - t.b * t.c
@@ -74,6 +79,16 @@ def determinant (t : Transform) : Float :=
 def isInvertible (t : Transform) : Bool :=
   t.determinant != 0.0
 
+/-- The largest factor by which the transform stretches any vector (the larger
+    singular value of the linear part). Dividing a pixel tolerance by it gives
+    the matching tolerance in untransformed coordinates. -/
+def maxScale (t : Transform) : Float :=
+  let p := t.a * t.a + t.b * t.b
+  let q := t.c * t.c + t.d * t.d
+  let r := t.a * t.c + t.b * t.d
+  let half := (p - q) / 2.0
+  Float.sqrt ((p + q) / 2.0 + Float.sqrt (half * half + r * r))
+
 /-- Compute the inverse transform (returns identity if not invertible). -/
 def inverse (t : Transform) : Transform :=
   let det := t.determinant
@@ -9,6 +9,17 @@ import Afferent.FFI.Renderer
 import Afferent.FFI.Renderer3D
 import Afferent.FFI.Text
 import Afferent.FFI.FloatBuffer
+import Afferent.FFI.PackedBuffer
+import Afferent.FFI.SpatialHash
+import Afferent.FFI.ParticleSystem
+import Afferent.FFI.FixedStepper
+import Afferent.FFI.ParticleInit
+import Afferent.FFI.Marshal
+import Afferent.FFI.Mesh
+import Afferent.FFI.FrameArena
+import Afferent.FFI.VertexWriter
+import Afferent.FFI.Tessellator
+import Afferent.FFI.CommandStream
 import Afferent.FFI.Texture
 
 namespace Afferent.FFI
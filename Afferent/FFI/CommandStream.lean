@@ -0,0 +1,30 @@
+/-
+  Afferent FFI CommandStream
+  Execute a packed frame of 2D commands (built with Afferent.Render.CommandStream)
+  in one FFI call. The stream is validated in full before anything is drawn;
+  a malformed stream raises an IO error naming the byte offset.
+-/
+import Afferent.FFI.Types
+
+namespace Afferent.FFI
+
+/-- Execute a command stream. `fonts` and `textures` are the tables that TEXT
+    and SPRITES commands index into. Returns the number of commands run. -/
+@[extern "lean_afferent_renderer_execute_commands"]
+opaque Renderer.executeCommands
+  (renderer : @& Renderer)
+  (stream : @& ByteArray)
+  (fonts : @& Array Font)
+  (textures : @& Array Texture)
+  (canvasWidth canvasHeight : Float) : IO UInt32
+
+-- Validate a stream without drawing; returns the command count
+@[extern "lean_afferent_command_stream_validate"]
+opaque CommandStream.validate (stream : @& ByteArray) (fontCount textureCount : UInt32) : IO UInt32
+
+-- Decode through the native recording sink: one line per backend call
+-- ("triangles", "text", "clip", "unclip", "sprites"). Used by tests.
+@[extern "lean_afferent_command_stream_record"]
+opaque CommandStream.record (stream : @& ByteArray) (fontCount textureCount : UInt32) : IO String
+
+end Afferent.FFI
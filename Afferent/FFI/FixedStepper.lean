@@ -0,0 +1,78 @@
+/-
+  Afferent FFI FixedStepper
+  Fixed-timestep bouncing particle simulation. Frame time is consumed in whole
+  fixed substeps (so results never depend on frame rate) and instance buffers
+  receive positions interpolated between the last two steps.
+  State layout: [x, y, vx, vy, hue] per particle.
+-/
+import Afferent.FFI.Types
+import Afferent.FFI.ParticleSystem
+
+namespace Afferent.FFI
+
+-- Create a stepper for `count` particles stepping `fixedDt` seconds at a time.
+-- At most `maxSubsteps` run per advance; older frame time is dropped.
+@[extern "lean_afferent_fixed_stepper_create"]
+opaque FixedStepper.create (count : UInt32) (fixedDt : Float := 1.0 / 120.0)
+  (maxSubsteps : UInt32 := 8) : IO FixedStepper
+
+@[extern "lean_afferent_fixed_stepper_destroy"]
+opaque FixedStepper.destroy (stepper : @& FixedStepper) : IO Unit
+
+-- Walls at [radius, width - radius] x [radius, height - radius]; radius is
+-- also written as the instance radius / half size
+@[extern "lean_afferent_fixed_stepper_set_bounds"]
+opaque FixedStepper.setBounds (stepper : @& FixedStepper) (width height radius : Float) : IO Unit
+
+-- Seeded random positions and velocities (bit-identical on every machine)
+@[extern "lean_afferent_fixed_stepper_init_random"]
+opaque FixedStepper.initRandom (stepper : @& FixedStepper) (width height : Float)
+  (maxSpeed : Float := 200.0) (seed : UInt32 := 1) : IO Unit
+
+-- Load [x, y, vx, vy, hue] particles (e.g. ParticleState.data). Returns the count loaded.
+@[extern "lean_afferent_fixed_stepper_load"]
+opaque FixedStepper.load (stepper : @& FixedStepper) (data : @& FloatArray) : IO UInt32
+
+@[extern "lean_afferent_fixed_stepper_advance"]
+opaque FixedStepper.advanceRaw (stepper : @& FixedStepper) (frameDt : Float)
+  (buffer : @& FloatBuffer) (layout : UInt8) : IO UInt32
+
+@[extern "lean_afferent_fixed_stepper_write"]
+opaque FixedStepper.writeRaw (stepper : @& FixedStepper)
+  (buffer : @& FloatBuffer) (layout : UInt8) : IO UInt32
+
+-- Headless: run exactly `steps` fixed steps (no interpolation, no wall clock)
+@[extern "lean_afferent_fixed_stepper_run"]
+opaque FixedStepper.run (stepper : @& FixedStepper) (steps : UInt32) : IO Unit
+
+-- Interpolation factor in [0, 1) from the last advance
+@[extern "lean_afferent_fixed_stepper_alpha"]
+opaque FixedStepper.alpha (stepper : @& FixedStepper) : IO Float
+
+@[extern "lean_afferent_fixed_stepper_step_count"]
+opaque FixedStepper.stepCount (stepper : @& FixedStepper) : IO UInt64
+
+-- Frame time discarded by the maxSubsteps clamp (seconds)
+@[extern "lean_afferent_fixed_stepper_dropped_time"]
+opaque FixedStepper.droppedTime (stepper : @& FixedStepper) : IO Float
+
+-- Hash of the exact state bits; equal step counts from equal seeds give equal checksums
+@[extern "lean_afferent_fixed_stepper_checksum"]
+opaque FixedStepper.checksum (stepper : @& FixedStepper) : IO UInt64
+
+-- Copy of the current state as [x, y, vx, vy, hue] per particle
+@[extern "lean_afferent_fixed_stepper_state"]
+opaque FixedStepper.state (stepper : @& FixedStepper) : IO FloatArray
+
+/-- Add wall-clock frame time, run the fixed substeps it covers and write
+    interpolated instances into `buffer` in one pass. Returns the substeps taken. -/
+def FixedStepper.advance (stepper : FixedStepper) (frameDt : Float) (buffer : FloatBuffer)
+    (layout : ParticleLayout := .circles) : IO UInt32 :=
+  stepper.advanceRaw frameDt buffer layout.toUInt8
+
+/-- Write interpolated instances without stepping. Returns particles written. -/
+def FixedStepper.write (stepper : FixedStepper) (buffer : FloatBuffer)
+    (layout : ParticleLayout := .circles) : IO UInt32 :=
+  stepper.writeRaw buffer layout.toUInt8
+
+end Afferent.FFI
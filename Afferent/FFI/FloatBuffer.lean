@@ -2,6 +2,14 @@
   Afferent FFI FloatBuffer
   High-performance mutable float array for instance data.
   Lives in C memory to avoid Lean's copy-on-write array semantics.
+
+  Particle state can instead stay in a Lean `FloatArray` that native code
+  reads and updates in place, with no FloatBuffer mirror:
+  - `@& FloatArray` arguments are borrowed. The payload is read directly for
+    the duration of the call and never retained.
+  - `Particles.updateBouncing` takes the array by value and returns it. It
+    mutates in place only when the caller held the sole reference, so keep
+    the state linear (`let p ← updateBouncing p ...`) or it copies once.
 -/
 import Afferent.FFI.Types
 import Init.Data.FloatArray
@@ -31,6 +39,12 @@ opaque FloatBuffer.setVec8 (buf : @& FloatBuffer) (index : USize)
 opaque FloatBuffer.setVec5 (buf : @& FloatBuffer) (index : USize)
   (v0 v1 v2 v3 v4 : Float) : IO Unit
 
+-- Copy `count` floats from `src` at `srcIndex` into `dst` at `dstIndex`.
+-- Raises if either range exceeds its buffer's capacity.
+@[extern "lean_afferent_float_buffer_copy"]
+opaque FloatBuffer.copy (dst : @& FloatBuffer) (dstIndex : USize)
+  (src : @& FloatBuffer) (srcIndex : USize) (count : USize) : IO Unit
+
 -- Bulk-write sprite instance data from a ParticleState data array.
 -- particleData layout: [x, y, vx, vy, hue] per particle (5 floats).
 -- Writes SpriteInstanceData layout into FloatBuffer: [x, y, rotation, halfSize, alpha].
@@ -45,6 +59,17 @@ opaque FloatBuffer.writeSpritesFromParticles
 
 namespace Particles
 
+-- Update bouncing physics in the particle array itself ([x, y, vx, vy, hue] per
+-- particle). In place when `particleData` is unshared; see the module note.
+@[extern "lean_afferent_particles_update_bouncing"]
+opaque updateBouncing
+  (particleData : FloatArray)
+  (count : UInt32)
+  (dt : Float)
+  (radius : Float)
+  (screenWidth : Float)
+  (screenHeight : Float) : IO FloatArray
+
 -- Update bouncing physics and write sprite instance data in the same pass.
 -- particleData layout: [x, y, vx, vy, hue] per particle (5 floats).
 -- spriteBuffer layout: [x, y, rotation(=0), halfSize, alpha(=1)] per particle (5 floats).
@@ -0,0 +1,103 @@
+/-
+  Afferent FFI FrameArena
+  Bump-pointer scratch memory for transient FFI conversions. Every renderer
+  owns one, reset at beginFrame; draw calls mark it, convert their Lean
+  arrays into it, and rewind once the data is on the GPU. Standalone arenas
+  exist for headless tests and benchmarks.
+-/
+import Afferent.FFI.Types
+
+namespace Afferent.FFI
+
+/-- Arena usage. Peak and allocation counts refer to the last completed frame. -/
+structure FrameArenaStats where
+  /-- Bytes currently allocated (0 between draw calls) -/
+  bytesInUse : Nat
+  /-- Most bytes live at once during the last frame -/
+  framePeakBytes : Nat
+  /-- Most bytes ever live at once -/
+  highWaterBytes : Nat
+  /-- Bytes reserved across all blocks -/
+  capacityBytes : Nat
+  blockCount : Nat
+  frames : Nat
+  /-- Total calls to malloc since creation -/
+  systemAllocs : Nat
+  /-- Calls to malloc during the last frame (0 once warmed up) -/
+  lastFrameAllocs : Nat
+  deriving Repr, Inhabited
+
+/-- Arena position to rewind to. Marks nest: rewind in reverse order. -/
+structure FrameArenaMark where
+  block : UInt64
+  used : UInt64
+  deriving Repr, BEq, Inhabited
+
+-- Create an arena; 0 uses the default block size (64 KiB)
+@[extern "lean_afferent_frame_arena_create"]
+opaque FrameArena.create (initialBytes : UInt64 := 0) : IO FrameArena
+
+@[extern "lean_afferent_frame_arena_destroy"]
+opaque FrameArena.destroy (arena : @& FrameArena) : IO Unit
+
+-- Allocate `bytes` (rounded up to 16); false if the system is out of memory
+@[extern "lean_afferent_frame_arena_alloc"]
+opaque FrameArena.alloc (arena : @& FrameArena) (bytes : UInt64) : IO Bool
+
+@[extern "lean_afferent_frame_arena_mark"]
+opaque FrameArena.markRaw (arena : @& FrameArena) : IO (Array UInt64)
+
+@[extern "lean_afferent_frame_arena_rewind"]
+opaque FrameArena.rewindRaw (arena : @& FrameArena) (block used : UInt64) : IO Unit
+
+-- End the frame: release everything and fold overflow blocks into one
+@[extern "lean_afferent_frame_arena_reset"]
+opaque FrameArena.reset (arena : @& FrameArena) : IO Unit
+
+-- Passthrough mode mallocs and frees every allocation, as the bridge did
+-- before the arena; used to measure the difference
+@[extern "lean_afferent_frame_arena_set_passthrough"]
+opaque FrameArena.setPassthroughRaw (arena : @& FrameArena) (passthrough : UInt8) : IO Unit
+
+@[extern "lean_afferent_frame_arena_stats"]
+opaque FrameArena.statsRaw (arena : @& FrameArena) : IO (Array UInt64)
+
+-- One draw-call style conversion: mark, narrow `data` to float32 scratch,
+-- consume it, rewind. Returns a sampled sum of the narrowed data.
+@[extern "lean_afferent_frame_arena_narrow_scratch"]
+opaque FrameArena.narrowScratch (arena : @& FrameArena) (data : @& FloatArray) : IO Float
+
+@[extern "lean_afferent_renderer_frame_arena_stats"]
+opaque Renderer.frameArenaStatsRaw (renderer : @& Renderer) : IO (Array UInt64)
+
+@[extern "lean_afferent_renderer_set_frame_arena_passthrough"]
+opaque Renderer.setFrameArenaPassthroughRaw (renderer : @& Renderer) (passthrough : UInt8) : IO Unit
+
+private def statsOfRaw (raw : Array UInt64) : FrameArenaStats :=
+  let get (i : Nat) : Nat := (raw.getD i 0).toNat
+  { bytesInUse := get 0, framePeakBytes := get 1, highWaterBytes := get 2,
+    capacityBytes := get 3, blockCount := get 4, frames := get 5,
+    systemAllocs := get 6, lastFrameAllocs := get 7 }
+
+def FrameArena.mark (arena : FrameArena) : IO FrameArenaMark := do
+  let raw ← arena.markRaw
+  pure { block := raw.getD 0 0, used := raw.getD 1 0 }
+
+/-- Release everything allocated since `mark` was taken. -/
+def FrameArena.rewind (arena : FrameArena) (mark : FrameArenaMark) : IO Unit :=
+  arena.rewindRaw mark.block mark.used
+
+def FrameArena.setPassthrough (arena : FrameArena) (passthrough : Bool) : IO Unit :=
+  arena.setPassthroughRaw (if passthrough then 1 else 0)
+
+def FrameArena.stats (arena : FrameArena) : IO FrameArenaStats :=
+  statsOfRaw <$> arena.statsRaw
+
+/-- Stats of the renderer's own arena (text and draw-call conversions). -/
+def Renderer.frameArenaStats (renderer : Renderer) : IO FrameArenaStats :=
+  statsOfRaw <$> renderer.frameArenaStatsRaw
+
+def Renderer.setFrameArenaPassthrough (renderer : Renderer) (passthrough : Bool) : IO Unit :=
+  renderer.setFrameArenaPassthroughRaw (if passthrough then 1 else 0)
+
+end Afferent.FFI
@@ -0,0 +1,33 @@
+/-
+  Afferent FFI Marshalling
+  Renderer-free hooks for the two ways float data crosses into native code:
+  `Array Float` (one boxed Float per element) and `FloatArray` (contiguous
+  doubles, SIMD-narrowed to float32), and likewise for indices (`Array UInt32`
+  vs packed u16/u32 `ByteArray`). Used to benchmark marshalling cost.
+-/
+import Afferent.FFI.Types
+import Init.Data.FloatArray
+
+namespace Afferent.FFI
+
+/-- Convert an `Array Float` to float32 the way the `Array Float` draw calls do.
+    Returns a sampled sum of the result. -/
+@[extern "lean_afferent_marshal_array"]
+opaque Marshal.narrowArray (data : @& Array Float) : IO Float
+
+/-- Convert a `FloatArray` to float32 the way the `FloatArray` draw calls do.
+    Returns a sampled sum of the result. -/
+@[extern "lean_afferent_marshal_float_array"]
+opaque Marshal.narrowFloatArray (data : @& FloatArray) : IO Float
+
+/-- Copy indices out of an `Array UInt32` the way `Buffer.createIndex` does.
+    Returns a sampled sum of the indices. -/
+@[extern "lean_afferent_marshal_index_array"]
+opaque Marshal.copyIndexArray (indices : @& Array UInt32) : IO UInt64
+
+/-- Copy packed indices (`width` bytes each, 2 or 4) the way the ByteArray
+    index uploads do. Returns a sampled sum of the indices. -/
+@[extern "lean_afferent_marshal_index_bytes"]
+opaque Marshal.copyIndexBytes (indices : @& ByteArray) (width : UInt8) : IO UInt64
+
+end Afferent.FFI
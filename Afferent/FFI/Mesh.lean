@@ -0,0 +1,157 @@
+/-
+  Afferent FFI Mesh
+  Persistent 3D meshes. Vertices and indices cross the FFI once at creation;
+  the GPU buffers are built on first draw, and an update crosses only its
+  sub-range. At the next draw the changed buffer is replaced by a new one that
+  takes the updated range from the native copy and the rest from the old
+  buffer by a GPU blit (draws already encoded keep reading the old one). Draws
+  pass the handle plus an index range, so static geometry is never
+  re-marshalled per frame.
+-/
+import Afferent.FFI.Types
+
+namespace Afferent.FFI
+
+/-- Vertex layout of a mesh. -/
+inductive MeshFormat where
+  /-- position[3], normal[3], color[4] (drawMesh3D layout) -/
+  | lit
+  /-- position[3], normal[3], uv[2], color[4] (drawMesh3DTextured layout) -/
+  | textured
+  deriving Repr, BEq, Inhabited
+
+namespace MeshFormat
+
+def toUInt8 : MeshFormat → UInt8
+  | .lit => 0
+  | .textured => 1
+
+/-- Floats per vertex. -/
+def floatCount : MeshFormat → Nat
+  | .lit => 10
+  | .textured => 12
+
+end MeshFormat
+
+/-- Ranges written since the last GPU sync (count 0 = clean). -/
+structure MeshDirty where
+  vertexFirst : Nat
+  vertexCount : Nat
+  indexFirst : Nat
+  indexCount : Nat
+  deriving Repr, BEq, Inhabited
+
+/-- Update counters and storage for a mesh. -/
+structure MeshStats where
+  vertexUpdates : Nat
+  indexUpdates : Nat
+  /-- Bytes of native vertex + index storage -/
+  cpuBytes : Nat
+  /-- Whether the backend has created the GPU buffers -/
+  gpuResident : Bool
+  deriving Repr, Inhabited
+
+@[extern "lean_afferent_mesh_create"]
+opaque Mesh.createRaw (format : UInt8) (vertices : @& FloatArray)
+  (indices : @& Array UInt32) : IO Mesh
+
+@[extern "lean_afferent_mesh_destroy"]
+opaque Mesh.destroy (mesh : @& Mesh) : IO Unit
+
+@[extern "lean_afferent_mesh_vertex_count"]
+opaque Mesh.vertexCount (mesh : @& Mesh) : IO UInt32
+
+@[extern "lean_afferent_mesh_index_count"]
+opaque Mesh.indexCount (mesh : @& Mesh) : IO UInt32
+
+-- Overwrite whole vertices starting at `firstVertex`; fails if the range
+-- runs past the end of the mesh
+@[extern "lean_afferent_mesh_update_vertices"]
+opaque Mesh.updateVertices (mesh : @& Mesh) (firstVertex : UInt32) (data : @& FloatArray) : IO Unit
+
+-- Overwrite indices starting at `firstIndex`; fails if the range runs past
+-- the end or an index does not address a vertex
+@[extern "lean_afferent_mesh_update_indices"]
+opaque Mesh.updateIndices (mesh : @& Mesh) (firstIndex : UInt32) (indices : @& Array UInt32) : IO Unit
+
+-- Copy of the native vertex storage (float32 precision)
+@[extern "lean_afferent_mesh_vertex_data"]
+opaque Mesh.vertexData (mesh : @& Mesh) : IO FloatArray
+
+@[extern "lean_afferent_mesh_index_data"]
+opaque Mesh.indexData (mesh : @& Mesh) : IO (Array UInt32)
+
+@[extern "lean_afferent_mesh_dirty_ranges"]
+opaque Mesh.dirtyRaw (mesh : @& Mesh) : IO (Array UInt32)
+
+@[extern "lean_afferent_mesh_stats"]
+opaque Mesh.statsRaw (mesh : @& Mesh) : IO (Array UInt64)
+
+-- Index range actually drawn for a submesh request, as [offset, count]
+@[extern "lean_afferent_mesh_clamp_range"]
+opaque Mesh.clampRangeRaw (mesh : @& Mesh) (indexOffset indexCount : UInt32) : IO (Array UInt32)
+
+/-- Draw `indexCount` indices of a lit mesh starting at `indexOffset`.
+    Matrices and lighting are as for drawMesh3D. -/
+@[extern "lean_afferent_renderer_draw_mesh"]
+opaque Renderer.drawMesh
+  (renderer : @& Renderer)
+  (mesh : @& Mesh)
+  (indexOffset indexCount : UInt32)
+  (mvpMatrix : @& Array Float)
+  (modelMatrix : @& Array Float)
+  (lightDir : @& Array Float)
+  (ambient : Float) : IO Unit
+
+/-- drawMesh with fog, as for drawMesh3DWithFog. -/
+@[extern "lean_afferent_renderer_draw_mesh_with_fog"]
+opaque Renderer.drawMeshWithFog
+  (renderer : @& Renderer)
+  (mesh : @& Mesh)
+  (indexOffset indexCount : UInt32)
+  (mvpMatrix : @& Array Float)
+  (modelMatrix : @& Array Float)
+  (lightDir : @& Array Float)
+  (ambient : Float)
+  (cameraPos : @& Array Float)
+  (fogColor : @& Array Float)
+  (fogStart fogEnd : Float) : IO Unit
+
+/-- Draw a submesh of a textured mesh with fog, as for drawMesh3DTextured. -/
+@[extern "lean_afferent_renderer_draw_mesh_textured"]
+opaque Renderer.drawMeshTextured
+  (renderer : @& Renderer)
+  (mesh : @& Mesh)
+  (indexOffset indexCount : UInt32)
+  (mvpMatrix : @& Array Float)
+  (modelMatrix : @& Array Float)
+  (lightDir : @& Array Float)
+  (ambient : Float)
+  (cameraPos : @& Array Float)
+  (fogColor : @& Array Float)
+  (fogStart fogEnd : Float)
+  (texture : @& Texture) : IO Unit
+
+/-- Create a mesh from interleaved vertices (`format.floatCount` per vertex)
+    and triangle indices. Fails on empty geometry or an out-of-range index. -/
+def Mesh.create (format : MeshFormat) (vertices : FloatArray) (indices : Array UInt32) : IO Mesh :=
+  Mesh.createRaw format.toUInt8 vertices indices
+
+def Mesh.dirty (mesh : Mesh) : IO MeshDirty := do
+  let raw ← mesh.dirtyRaw
+  let get (i : Nat) : Nat := (raw.getD i 0).toNat
+  pure { vertexFirst := get 0, vertexCount := get 1, indexFirst := get 2, indexCount := get 3 }
+
+def Mesh.stats (mesh : Mesh) : IO MeshStats := do
+  let raw ← mesh.statsRaw
+  let get (i : Nat) : Nat := (raw.getD i 0).toNat
+  pure { vertexUpdates := get 0, indexUpdates := get 1, cpuBytes := get 2,
+         gpuResident := get 3 != 0 }
+
+/-- Clamp a submesh range to the index buffer. Returns (offset, count);
+    count 0 means nothing would be drawn. -/
+def Mesh.clampRange (mesh : Mesh) (indexOffset indexCount : UInt32) : IO (UInt32 × UInt32) := do
+  let raw ← mesh.clampRangeRaw indexOffset indexCount
+  pure (raw.getD 0 0, raw.getD 1 0)
+
+end Afferent.FFI
@@ -0,0 +1,112 @@
+/-
+  Afferent FFI PackedBuffer
+  Schema-driven packed instance buffer. Each field picks its own encoding
+  (f32, f16, unorm8x4, snorm16) so instance streams shrink from all-f32
+  layouts (32 bytes per rect instance) to 12-16 bytes.
+-/
+import Afferent.FFI.Types
+import Init.Data.FloatArray
+
+namespace Afferent.FFI
+
+/-- Per-field encoding of a packed instance. Values match `AfferentFieldEncoding`. -/
+inductive FieldEncoding where
+  | f32       -- 1 float  -> 4 bytes
+  | f16       -- 1 float  -> 2 bytes (IEEE half, round-to-nearest-even)
+  | unorm8x4  -- 4 floats -> 4 bytes (clamped to [0, 1], e.g. RGBA color)
+  | snorm16   -- 1 float  -> 2 bytes (clamped to [-1, 1])
+deriving Repr, BEq, Inhabited
+
+namespace FieldEncoding
+
+def toUInt8 : FieldEncoding → UInt8
+  | .f32 => 0
+  | .f16 => 1
+  | .unorm8x4 => 2
+  | .snorm16 => 3
+
+/-- Number of logical floats a field consumes from the source stream. -/
+def floatCount : FieldEncoding → Nat
+  | .unorm8x4 => 4
+  | _ => 1
+
+/-- Encoded size of the field in bytes. -/
+def byteSize : FieldEncoding → Nat
+  | .f32 => 4
+  | .f16 => 2
+  | .unorm8x4 => 4
+  | .snorm16 => 2
+
+end FieldEncoding
+
+/-- Ordered list of field encodings describing one packed instance. -/
+abbrev PackedSchema := Array FieldEncoding
+
+namespace PackedSchema
+
+def toByteArray (schema : PackedSchema) : ByteArray :=
+  schema.foldl (fun acc e => acc.push e.toUInt8) (ByteArray.mkEmpty schema.size)
+
+/-- Logical floats per instance (the unpacked layout). -/
+def floatCount (schema : PackedSchema) : Nat :=
+  schema.foldl (fun acc e => acc + e.floatCount) 0
+
+/-- InstanceData `[x, y, angle, halfSize, r, g, b, a]` in 16 bytes:
+    f32 NDC position, f16 angle/halfSize, unorm8x4 color. Positions stay f32, as
+    an f16 NDC coordinate drifts by 1-2 px on canvases past ~2048 px. -/
+def instanceRect : PackedSchema := #[.f32, .f32, .f16, .f16, .unorm8x4]
+
+/-- SpriteInstanceData `[x, y, rotation, halfSize, alpha]` in 12 bytes:
+    f32 pixel position, f16 rotation/halfSize/alpha. -/
+def sprite : PackedSchema := #[.f32, .f32, .f16, .f16]
+
+/-- DynamicCircleData `[x, y, hue, radius]` in 12 bytes:
+    f32 pixel position, snorm16 hue (0-1), f16 radius. -/
+def dynamicCircle : PackedSchema := #[.f32, .f32, .snorm16, .f16]
+
+end PackedSchema
+
+@[extern "lean_afferent_packed_buffer_create"]
+opaque PackedBuffer.createRaw (schema : @& ByteArray) (capacity : USize) : IO PackedBuffer
+
+/-- Create a packed buffer holding `capacity` instances of `schema`. -/
+def PackedBuffer.create (schema : PackedSchema) (capacity : USize) : IO PackedBuffer :=
+  PackedBuffer.createRaw schema.toByteArray capacity
+
+@[extern "lean_afferent_packed_buffer_destroy"]
+opaque PackedBuffer.destroy (buf : @& PackedBuffer) : IO Unit
+
+-- Capacity in instances
+@[extern "lean_afferent_packed_buffer_capacity"]
+opaque PackedBuffer.capacity (buf : @& PackedBuffer) : IO USize
+
+-- Bytes per packed instance (always a multiple of 4)
+@[extern "lean_afferent_packed_buffer_stride"]
+opaque PackedBuffer.stride (buf : @& PackedBuffer) : IO UInt32
+
+-- Logical floats per instance in the unpacked stream
+@[extern "lean_afferent_packed_buffer_floats_per_instance"]
+opaque PackedBuffer.floatsPerInstance (buf : @& PackedBuffer) : IO UInt32
+
+-- Pack `count` instances from a FloatArray into the buffer starting at instance `first`.
+-- Returns the number of bytes written (count is clamped to the array and capacity).
+@[extern "lean_afferent_packed_buffer_pack_float_array"]
+opaque PackedBuffer.packFloatArray (buf : @& PackedBuffer) (first : USize)
+  (src : @& FloatArray) (count : USize) : IO USize
+
+-- Pack `count` instances straight from a FloatBuffer. Returns bytes written.
+@[extern "lean_afferent_packed_buffer_pack_from_float_buffer"]
+opaque PackedBuffer.packFromFloatBuffer (buf : @& PackedBuffer) (first : USize)
+  (src : @& FloatBuffer) (count : USize) : IO USize
+
+-- Decode `count` instances back into floats (floatsPerInstance values each).
+@[extern "lean_afferent_packed_buffer_unpack_float_array"]
+opaque PackedBuffer.unpackFloatArray (buf : @& PackedBuffer) (first : USize)
+  (count : USize) : IO FloatArray
+
+-- Raw packed bytes of `count` instances starting at `first`.
+@[extern "lean_afferent_packed_buffer_to_byte_array"]
+opaque PackedBuffer.toByteArray (buf : @& PackedBuffer) (first : USize)
+  (count : USize) : IO ByteArray
+
+end Afferent.FFI
@@ -0,0 +1,87 @@
+/-
+  Afferent FFI ParticleInit
+  Parallel native particle initialization. Values come from a counter-based
+  generator (Philox4x32-10 keyed by seed, counter = particle index), so the
+  work splits across threads and the result never depends on thread count.
+  Output layout: [x, y, vx, vy, hue] per particle.
+-/
+import Afferent.FFI.Types
+import Init.Data.FloatArray
+
+namespace Afferent.FFI
+
+/-- Where particles start. -/
+inductive PositionDist where
+  /-- Uniform over the rectangle at (x, y) with the given size -/
+  | rect (x y width height : Float)
+  /-- Uniform over the disc's area -/
+  | disc (cx cy radius : Float)
+  /-- Normal distribution around the center -/
+  | gaussian (cx cy sigma : Float)
+  deriving Repr, Inhabited
+
+/-- How fast particles start. -/
+inductive VelocityDist where
+  | zero
+  /-- Each axis uniform in [-maxSpeed, maxSpeed) -/
+  | box (maxSpeed : Float)
+  /-- Uniform random direction with speed in [minSpeed, maxSpeed) -/
+  | directional (minSpeed maxSpeed : Float)
+  deriving Repr, Inhabited
+
+/-- Per-particle hue. -/
+inductive HueDist where
+  /-- index / count (a rainbow across the particle array) -/
+  | byIndex
+  | random (min max : Float)
+  | constant (hue : Float)
+  deriving Repr, Inhabited
+
+structure ParticleInit where
+  position : PositionDist
+  velocity : VelocityDist := .zero
+  hue : HueDist := .byIndex
+  deriving Repr, Inhabited
+
+/-- Parameters in native order:
+    [positionKind, p0, p1, p2, p3, velocityKind, v0, v1, hueKind, h0, h1]. -/
+def ParticleInit.toFloatArray (init : ParticleInit) : FloatArray :=
+  let pos := match init.position with
+    | .rect x y w h => #[0.0, x, y, w, h]
+    | .disc cx cy r => #[1.0, cx, cy, r, 0.0]
+    | .gaussian cx cy sigma => #[2.0, cx, cy, sigma, 0.0]
+  let vel := match init.velocity with
+    | .zero => #[0.0, 0.0, 0.0]
+    | .box maxSpeed => #[1.0, maxSpeed, 0.0]
+    | .directional lo hi => #[2.0, lo, hi]
+  let hue := match init.hue with
+    | .byIndex => #[0.0, 0.0, 0.0]
+    | .random lo hi => #[1.0, lo, hi]
+    | .constant h => #[2.0, h, 0.0]
+  ⟨pos ++ vel ++ hue⟩
+
+namespace Particles
+
+-- Generate `count` particles (threads = 0: one per CPU). Pure: the same
+-- arguments always produce the same array, whatever the thread count.
+@[extern "lean_afferent_particles_generate"]
+opaque generateRaw (count : UInt32) (params : @& FloatArray) (seed : UInt32)
+  (threads : UInt32) : FloatArray
+
+/-- Generate `count` particles as a FloatArray [x, y, vx, vy, hue] per particle. -/
+def generate (count : Nat) (init : ParticleInit) (seed : UInt32)
+    (threads : UInt32 := 0) : FloatArray :=
+  generateRaw count.toUInt32 init.toFloatArray seed threads
+
+end Particles
+
+@[extern "lean_afferent_float_buffer_init_particles"]
+opaque FloatBuffer.initParticlesRaw (buffer : @& FloatBuffer) (count : UInt32)
+  (params : @& FloatArray) (seed : UInt32) (threads : UInt32) : IO Unit
+
+/-- Fill a FloatBuffer with `count` particles [x, y, vx, vy, hue] (clamped to capacity). -/
+def FloatBuffer.initParticles (buffer : FloatBuffer) (count : UInt32) (init : ParticleInit)
+    (seed : UInt32) (threads : UInt32 := 0) : IO Unit :=
+  FloatBuffer.initParticlesRaw buffer count init.toFloatArray seed threads
+
+end Afferent.FFI
@@ -0,0 +1,164 @@
+/-
+  Afferent FFI ParticleSystem
+  Native particle engine: emitters spawn particles that age, feel gravity,
+  drag and point attractors, and die. Dead particles are swap-removed so the
+  live set stays dense, and each step writes it straight into a FloatBuffer
+  ready for drawDynamicCirclesBuffer or drawSpritesInstanceBuffer.
+-/
+import Afferent.FFI.Types
+import Afferent.FFI.Texture
+
+namespace Afferent.FFI
+
+/-- Instance layout written by `ParticleSystem.step`. -/
+inductive ParticleLayout where
+  /-- [x, y, hueBase, radius] per particle (drawDynamicCirclesBuffer, time = 0) -/
+  | circles
+  /-- [x, y, rotation, halfSize, alpha] per particle (drawSpritesInstanceBuffer) -/
+  | sprites
+  deriving Repr, BEq, Inhabited
+
+namespace ParticleLayout
+
+def toUInt8 : ParticleLayout → UInt8
+  | .circles => 0
+  | .sprites => 1
+
+/-- Floats written per particle. -/
+def floatCount : ParticleLayout → Nat
+  | .circles => 4
+  | .sprites => 5
+
+end ParticleLayout
+
+/-- Emitter configuration. Ranges are sampled uniformly per particle; the
+    `*Start`/`*End` pairs are interpolated over each particle's life. -/
+structure EmitterConfig where
+  x : Float := 0.0
+  y : Float := 0.0
+  /-- Particles per second (0 = bursts only) -/
+  rate : Float := 100.0
+  speedMin : Float := 50.0
+  speedMax : Float := 100.0
+  /-- Emission direction (radians) -/
+  angle : Float := 0.0
+  /-- Half-angle of the emission cone (radians); pi emits in all directions -/
+  spread : Float := 3.14159265358979
+  lifeMin : Float := 1.0
+  lifeMax : Float := 2.0
+  sizeStart : Float := 4.0
+  sizeEnd : Float := 0.0
+  hueStart : Float := 0.0
+  hueEnd : Float := 0.15
+  alphaStart : Float := 1.0
+  alphaEnd : Float := 0.0
+  /-- Sprite rotation speed (radians/second) -/
+  spin : Float := 0.0
+  deriving Repr, Inhabited
+
+/-- Parameters in native AfferentEmitterDesc field order. -/
+def EmitterConfig.toFloatArray (c : EmitterConfig) : FloatArray :=
+  ⟨#[c.x, c.y, c.rate, c.speedMin, c.speedMax, c.angle, c.spread,
+     c.lifeMin, c.lifeMax, c.sizeStart, c.sizeEnd, c.hueStart, c.hueEnd,
+     c.alphaStart, c.alphaEnd, c.spin]⟩
+
+/-- Lifetime counters for a particle system. -/
+structure ParticleStats where
+  live : Nat
+  totalSpawned : Nat
+  totalDied : Nat
+  /-- Spawns rejected because the system was at capacity -/
+  totalDropped : Nat
+  deriving Repr, Inhabited
+
+-- Create a particle system holding at most `capacity` live particles.
+-- The same seed and step sequence reproduces the same particles.
+@[extern "lean_afferent_particle_system_create"]
+opaque ParticleSystem.create (capacity : UInt32) (seed : UInt32 := 1) : IO ParticleSystem
+
+@[extern "lean_afferent_particle_system_destroy"]
+opaque ParticleSystem.destroy (sys : @& ParticleSystem) : IO Unit
+
+-- Kill all particles (emitters and forces are kept)
+@[extern "lean_afferent_particle_system_clear"]
+opaque ParticleSystem.clear (sys : @& ParticleSystem) : IO Unit
+
+@[extern "lean_afferent_particle_system_live_count"]
+opaque ParticleSystem.liveCount (sys : @& ParticleSystem) : IO UInt32
+
+@[extern "lean_afferent_particle_system_stats"]
+opaque ParticleSystem.statsRaw (sys : @& ParticleSystem) : IO (Array UInt64)
+
+@[extern "lean_afferent_particle_system_add_emitter"]
+opaque ParticleSystem.addEmitterRaw (sys : @& ParticleSystem)
+  (params : @& FloatArray) : IO UInt32
+
+@[extern "lean_afferent_particle_system_set_emitter_position"]
+opaque ParticleSystem.setEmitterPosition (sys : @& ParticleSystem) (emitter : UInt32)
+  (x y : Float) : IO Unit
+
+@[extern "lean_afferent_particle_system_set_emitter_rate"]
+opaque ParticleSystem.setEmitterRate (sys : @& ParticleSystem) (emitter : UInt32)
+  (rate : Float) : IO Unit
+
+-- Inactive emitters stop continuous emission but still accept bursts
+@[extern "lean_afferent_particle_system_set_emitter_active"]
+opaque ParticleSystem.setEmitterActive (sys : @& ParticleSystem) (emitter : UInt32)
+  (active : Bool) : IO Unit
+
+-- Spawn `count` particles from an emitter now. Returns how many fit.
+@[extern "lean_afferent_particle_system_burst"]
+opaque ParticleSystem.burst (sys : @& ParticleSystem) (emitter : UInt32)
+  (count : UInt32) : IO UInt32
+
+-- Constant acceleration (pixels/second²)
+@[extern "lean_afferent_particle_system_set_gravity"]
+opaque ParticleSystem.setGravity (sys : @& ParticleSystem) (gx gy : Float) : IO Unit
+
+-- Linear drag coefficient (1/second)
+@[extern "lean_afferent_particle_system_set_drag"]
+opaque ParticleSystem.setDrag (sys : @& ParticleSystem) (drag : Float) : IO Unit
+
+-- Inverse-square point attractor (negative strength repels). At most 8.
+@[extern "lean_afferent_particle_system_add_attractor"]
+opaque ParticleSystem.addAttractor (sys : @& ParticleSystem) (x y strength : Float)
+  (softening : Float := 10.0) : IO UInt32
+
+@[extern "lean_afferent_particle_system_set_attractor"]
+opaque ParticleSystem.setAttractor (sys : @& ParticleSystem) (attractor : UInt32)
+  (x y strength : Float) : IO Unit
+
+@[extern "lean_afferent_particle_system_clear_attractors"]
+opaque ParticleSystem.clearAttractors (sys : @& ParticleSystem) : IO Unit
+
+@[extern "lean_afferent_particle_system_step"]
+opaque ParticleSystem.stepRaw (sys : @& ParticleSystem) (dt : Float)
+  (buffer : @& FloatBuffer) (layout : UInt8) : IO UInt32
+
+@[extern "lean_afferent_particle_system_write"]
+opaque ParticleSystem.writeRaw (sys : @& ParticleSystem)
+  (buffer : @& FloatBuffer) (layout : UInt8) : IO UInt32
+
+/-- Add an emitter, returning its index. -/
+def ParticleSystem.addEmitter (sys : ParticleSystem) (config : EmitterConfig) : IO UInt32 :=
+  sys.addEmitterRaw config.toFloatArray
+
+/-- Emit, age, integrate and compact, then write the live particles into
+    `buffer` in `layout`. Returns the live count to pass as the draw count.
+    Size the buffer as capacity * layout.floatCount; extra particles are
+    simulated but not written. -/
+def ParticleSystem.step (sys : ParticleSystem) (dt : Float) (buffer : FloatBuffer)
+    (layout : ParticleLayout := .circles) : IO UInt32 :=
+  sys.stepRaw dt buffer layout.toUInt8
+
+/-- Write the live particles without stepping. Returns the number written. -/
+def ParticleSystem.write (sys : ParticleSystem) (buffer : FloatBuffer)
+    (layout : ParticleLayout := .circles) : IO UInt32 :=
+  sys.writeRaw buffer layout.toUInt8
+
+def ParticleSystem.stats (sys : ParticleSystem) : IO ParticleStats := do
+  let raw ← sys.statsRaw
+  let get (i : Nat) : Nat := (raw.getD i 0).toNat
+  pure { live := get 0, totalSpawned := get 1, totalDied := get 2, totalDropped := get 3 }
+
+end Afferent.FFI
@@ -37,6 +37,19 @@ opaque Buffer.createVertex (renderer : @& Renderer) (vertices : @& Array Float)
 @[extern "lean_afferent_buffer_create_index"]
 opaque Buffer.createIndex (renderer : @& Renderer) (indices : @& Array UInt32) : IO Buffer
 
+-- FloatArray/ByteArray overloads: read as contiguous memory (no per-element unboxing),
+-- narrowed to float32 with SIMD on the native side.
+@[extern "lean_afferent_buffer_create_vertex_float_array"]
+opaque Buffer.createVertexFloatArray (renderer : @& Renderer) (vertices : @& FloatArray) : IO Buffer
+
+-- Indices: ByteArray of little-endian UInt32 (4 bytes per index)
+@[extern "lean_afferent_buffer_create_index_byte_array"]
+opaque Buffer.createIndexByteArray (renderer : @& Renderer) (indices : @& ByteArray) : IO Buffer
+
+-- Indices: ByteArray of little-endian UInt16 (2 bytes per index, at most 65536 vertices)
+@[extern "lean_afferent_buffer_create_index_u16_byte_array"]
+opaque Buffer.createIndexU16ByteArray (renderer : @& Renderer) (indices : @& ByteArray) : IO Buffer
+
 @[extern "lean_afferent_buffer_destroy"]
 opaque Buffer.destroy (buffer : @& Buffer) : IO Unit
 
@@ -71,6 +84,25 @@ opaque Renderer.drawInstancedCircles
   (instanceData : @& Array Float)
   (instanceCount : UInt32) : IO Unit
 
+-- Instanced drawing from FloatArray (same 8-float layout, no per-element unboxing)
+@[extern "lean_afferent_renderer_draw_instanced_rects_float_array"]
+opaque Renderer.drawInstancedRectsFloatArray
+  (renderer : @& Renderer)
+  (instanceData : @& FloatArray)
+  (instanceCount : UInt32) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_instanced_triangles_float_array"]
+opaque Renderer.drawInstancedTrianglesFloatArray
+  (renderer : @& Renderer)
+  (instanceData : @& FloatArray)
+  (instanceCount : UInt32) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_instanced_circles_float_array"]
+opaque Renderer.drawInstancedCirclesFloatArray
+  (renderer : @& Renderer)
+  (instanceData : @& FloatArray)
+  (instanceCount : UInt32) : IO Unit
+
 -- Scissor rect for clipping
 @[extern "lean_afferent_renderer_set_scissor"]
 opaque Renderer.setScissor
@@ -209,6 +241,34 @@ opaque Renderer.drawDynamicTriangles
   (canvasWidth : Float)
   (canvasHeight : Float) : IO Unit
 
+-- Dynamic drawing from FloatArray (same layouts as above, no per-element unboxing)
+@[extern "lean_afferent_renderer_draw_dynamic_circles_float_array"]
+opaque Renderer.drawDynamicCirclesFloatArray
+  (renderer : @& Renderer)
+  (data : @& FloatArray)
+  (count : UInt32)
+  (time : Float)
+  (canvasWidth : Float)
+  (canvasHeight : Float) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_dynamic_rects_float_array"]
+opaque Renderer.drawDynamicRectsFloatArray
+  (renderer : @& Renderer)
+  (data : @& FloatArray)
+  (count : UInt32)
+  (time : Float)
+  (canvasWidth : Float)
+  (canvasHeight : Float) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_dynamic_triangles_float_array"]
+opaque Renderer.drawDynamicTrianglesFloatArray
+  (renderer : @& Renderer)
+  (data : @& FloatArray)
+  (count : UInt32)
+  (time : Float)
+  (canvasWidth : Float)
+  (canvasHeight : Float) : IO Unit
+
 -- ============================================================================
 -- TEXTURED RECTANGLE RENDERING - Map tile rendering with source/dest rects
 -- ============================================================================
@@ -42,6 +42,32 @@ opaque Renderer.drawMesh3DWithFog
   (fogColor : @& Array Float)
   (fogStart fogEnd : Float) : IO Unit
 
+/-- drawMesh3D with vertices in a FloatArray (10 per vertex), read without
+    per-element unboxing. -/
+@[extern "lean_afferent_renderer_draw_mesh_3d_float_array"]
+opaque Renderer.drawMesh3DFloatArray
+  (renderer : @& Renderer)
+  (vertices : @& FloatArray)
+  (indices : @& Array UInt32)
+  (mvpMatrix : @& Array Float)
+  (modelMatrix : @& Array Float)
+  (lightDir : @& Array Float)
+  (ambient : Float) : IO Unit
+
+/-- drawMesh3DWithFog with vertices in a FloatArray (10 per vertex). -/
+@[extern "lean_afferent_renderer_draw_mesh_3d_with_fog_float_array"]
+opaque Renderer.drawMesh3DWithFogFloatArray
+  (renderer : @& Renderer)
+  (vertices : @& FloatArray)
+  (indices : @& Array UInt32)
+  (mvpMatrix : @& Array Float)
+  (modelMatrix : @& Array Float)
+  (lightDir : @& Array Float)
+  (ambient : Float)
+  (cameraPos : @& Array Float)
+  (fogColor : @& Array Float)
+  (fogStart fogEnd : Float) : IO Unit
+
 /-- Draw an infinite-feeling ocean using a projected grid + Gerstner waves on the GPU.
     This avoids per-frame large vertex array marshaling from Lean.
     `waveParams` layout (Float array, length ≥ 32):
@@ -0,0 +1,62 @@
+/-
+  Afferent FFI SpatialHash
+  Uniform-grid spatial hash for particle neighbor queries.
+  Rebuilt from a particle FloatBuffer ([x, y, ...] per particle) with a
+  counting sort over cell IDs, so a rebuild per frame is cheap.
+-/
+import Afferent.FFI.Types
+import Afferent.FFI.Texture
+
+namespace Afferent.FFI
+
+-- Create a spatial hash with the given (minimum) cell size.
+-- A cell size close to the query radius gives the best query speed.
+@[extern "lean_afferent_spatial_hash_create"]
+opaque SpatialHash.create (cellSize : Float) : IO SpatialHash
+
+@[extern "lean_afferent_spatial_hash_destroy"]
+opaque SpatialHash.destroy (hash : @& SpatialHash) : IO Unit
+
+-- Effective cell size of the last rebuild (grows for very sparse bounds)
+@[extern "lean_afferent_spatial_hash_cell_size"]
+opaque SpatialHash.cellSize (hash : @& SpatialHash) : IO Float
+
+-- Bin `count` particles of `stride` floats each from a FloatBuffer.
+-- Count is clamped to what the buffer holds. Raises if stride < 2.
+@[extern "lean_afferent_spatial_hash_rebuild"]
+opaque SpatialHash.rebuild (hash : @& SpatialHash) (buffer : @& FloatBuffer)
+  (count : UInt32) (stride : UInt32) : IO Unit
+
+-- Indices of particles within `radius` of (x, y) as of the last rebuild.
+@[extern "lean_afferent_spatial_hash_query_radius"]
+opaque SpatialHash.queryRadius (hash : @& SpatialHash) (x y radius : Float)
+  (maxResults : UInt32 := 1024) : IO (Array UInt32)
+
+-- Particle pairs at most `radius` apart, flattened as [i0, j0, i1, j1, ...] with i < j.
+@[extern "lean_afferent_spatial_hash_query_pairs"]
+opaque SpatialHash.queryPairs (hash : @& SpatialHash) (radius : Float)
+  (maxPairs : UInt32) : IO (Array UInt32)
+
+-- Number of particle pairs at most `radius` apart (no allocation per pair).
+@[extern "lean_afferent_spatial_hash_count_pairs"]
+opaque SpatialHash.countPairs (hash : @& SpatialHash) (radius : Float) : IO UInt64
+
+-- Rebuild from `buffer` and resolve collisions between equal-mass discs of
+-- `radius` in place: overlaps are separated and approaching pairs exchange
+-- normal velocity (restitution 1.0 = perfectly elastic).
+-- Layout: [x, y, vx, vy, ...] per particle (stride >= 4), e.g. the sprite
+-- physics buffer used by FloatBuffer.updateSprites. Returns the contact count.
+@[extern "lean_afferent_spatial_hash_resolve_collisions"]
+opaque SpatialHash.resolveCollisions (hash : @& SpatialHash) (buffer : @& FloatBuffer)
+  (count : UInt32) (stride : UInt32) (radius : Float)
+  (restitution : Float := 1.0) : IO UInt32
+
+/-- Bounce sprites off the walls, then resolve sprite-sprite collisions.
+    Layout: [x, y, vx, vy, rotation] per sprite (5 floats). -/
+def SpatialHash.updateSpritesColliding (hash : SpatialHash) (buffer : FloatBuffer)
+    (count : UInt32) (dt halfSize screenWidth screenHeight : Float)
+    (restitution : Float := 1.0) : IO UInt32 := do
+  FloatBuffer.updateSprites buffer count dt halfSize screenWidth screenHeight
+  hash.resolveCollisions buffer count 5 halfSize restitution
+
+end Afferent.FFI
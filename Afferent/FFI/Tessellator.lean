@@ -0,0 +1,41 @@
+/-
+  Afferent FFI Tessellator
+  Native path flattening, convex fill and stroke expansion into a
+  VertexWriter. Paths are passed as an encoded command stream (see
+  Afferent.Render.NativeTessellation for the encoder). Also the polygon
+  triangulator behind non-convex fills (Afferent.Render.PolygonFill) and the
+  polyline reducer run before stroking long series (Afferent.Render.Polyline).
+-/
+import Afferent.FFI.Types
+
+namespace Afferent.FFI
+
+-- Fan-fill an encoded path into a stride-6 writer; `transform` is empty or 6 floats
+-- (a, b, c, d, tx, ty); output is NDC when ndcWidth/ndcHeight > 0
+@[extern "lean_afferent_tessellate_fill_convex"]
+opaque Tessellator.fillConvex (writer : @& VertexWriter) (commands : @& FloatArray)
+    (transform : @& FloatArray) (tolerance ndcWidth ndcHeight : Float)
+    (r g b a : Float) : IO Unit
+
+-- Stroke an encoded path into a stride-6 writer; cap/join as in afferent.h
+@[extern "lean_afferent_tessellate_stroke"]
+opaque Tessellator.stroke (writer : @& VertexWriter) (commands : @& FloatArray)
+    (transform : @& FloatArray) (tolerance ndcWidth ndcHeight : Float)
+    (r g b a : Float) (lineWidth miterLimit : Float) (cap join : UInt8) : IO Unit
+
+-- Triangulate flattened contours (x, y pairs; contourEnds are exclusive point counts)
+-- under a fill rule (0 nonzero, 1 even-odd). Returns the triangle points as x, y
+-- pairs, which may include edge crossings, their indices, and the method used
+-- (0 nothing to fill, 1 ear clipping, 2 sweep)
+@[extern "lean_afferent_triangulate"]
+opaque Tessellator.triangulate (points : @& FloatArray) (contourEnds : @& Array UInt32)
+    (rule : UInt8) : IO (FloatArray × Array UInt32 × UInt8)
+
+-- Reduce a polyline (x, y pairs) to the points a stroke can show under `transform`
+-- (empty or 6 floats), `tolerance` pixels apart; method 0 auto, 1 min/max per
+-- column, 2 Ramer-Douglas-Peucker. Returns the kept points, untransformed
+@[extern "lean_afferent_polyline_reduce"]
+opaque Tessellator.reducePolyline (points : @& FloatArray) (transform : @& FloatArray)
+    (tolerance : Float) (method : UInt8) : IO FloatArray
+
+end Afferent.FFI
@@ -69,6 +69,19 @@ opaque Renderer.drawSpritesBuffer
   (canvasWidth : Float)
   (canvasHeight : Float) : IO Unit
 
+-- Draw sprites straight from particle state ([x, y, vx, vy, hue] per particle),
+-- packed into the GPU instance buffer during the upload copy. `particleData` is
+-- borrowed and read in place; nothing is retained after the call returns.
+@[extern "lean_afferent_renderer_draw_sprites_particles"]
+opaque Renderer.drawSpritesParticles
+  (renderer : @& Renderer)
+  (texture : @& Texture)
+  (particleData : @& FloatArray)
+  (count : UInt32)
+  (halfSize : Float)
+  (canvasWidth : Float)
+  (canvasHeight : Float) : IO Unit
+
 -- Draw sprites from FloatBuffer already in SpriteInstanceData layout.
 @[extern "lean_afferent_renderer_draw_sprites_instance_buffer"]
 opaque Renderer.drawSpritesInstanceBuffer
@@ -36,4 +36,40 @@ opaque TexturePointed : NonemptyType
 def Texture : Type := TexturePointed.type
 instance : Nonempty Texture := TexturePointed.property
 
+-- PackedBuffer: Schema-driven packed instance data (f32/f16/unorm8x4/snorm16 fields)
+-- Lives in C memory like FloatBuffer, but at 12-16 bytes per instance instead of 32
+opaque PackedBufferPointed : NonemptyType
+def PackedBuffer : Type := PackedBufferPointed.type
+instance : Nonempty PackedBuffer := PackedBufferPointed.property
+
+-- SpatialHash: Uniform-grid neighbor index over particle FloatBuffers
+opaque SpatialHashPointed : NonemptyType
+def SpatialHash : Type := SpatialHashPointed.type
+instance : Nonempty SpatialHash := SpatialHashPointed.property
+
+-- ParticleSystem: Native emitters, lifetimes and forces
+opaque ParticleSystemPointed : NonemptyType
+def ParticleSystem : Type := ParticleSystemPointed.type
+instance : Nonempty ParticleSystem := ParticleSystemPointed.property
+
+-- FixedStepper: Deterministic fixed-timestep bouncing particles
+opaque FixedStepperPointed : NonemptyType
+def FixedStepper : Type := FixedStepperPointed.type
+instance : Nonempty FixedStepper := FixedStepperPointed.property
+
+-- Mesh: Persistent 3D geometry kept in native (and GPU) memory
+opaque MeshPointed : NonemptyType
+def Mesh : Type := MeshPointed.type
+instance : Nonempty Mesh := MeshPointed.property
+
+-- FrameArena: Bump-pointer scratch memory reset once per frame
+opaque FrameArenaPointed : NonemptyType
+def FrameArena : Type := FrameArenaPointed.type
+instance : Nonempty FrameArena := FrameArenaPointed.property
+
+-- VertexWriter: Growable native float32 vertex and packed index storage
+opaque VertexWriterPointed : NonemptyType
+def VertexWriter : Type := VertexWriterPointed.type
+instance : Nonempty VertexWriter := VertexWriterPointed.property
+
 end Afferent.FFI
@@ -0,0 +1,123 @@
+/-
+  Afferent FFI VertexWriter
+  Growable native storage for geometry built in Lean. Vertices are written
+  as float32 (`stride` floats each) and triangle indices as packed u16,
+  widened once to u32 past 65536 vertices, so nothing is accumulated in
+  Lean arrays or converted again at upload. Growth happens natively;
+  `clear` keeps the capacity for the next frame.
+-/
+import Afferent.FFI.Types
+
+namespace Afferent.FFI
+
+/-- Writer usage and capacity. -/
+structure VertexWriterStats where
+  vertexCount : Nat
+  indexCount : Nat
+  /-- Vertices that fit before the next reallocation -/
+  vertexCapacity : Nat
+  /-- Indices that fit before the next reallocation -/
+  indexCapacity : Nat
+  bytesReserved : Nat
+  /-- Reallocations since creation (0 if the initial capacity was enough) -/
+  grows : Nat
+  /-- Floats per vertex -/
+  stride : Nat
+  /-- Bytes per index: 2, or 4 once widened -/
+  indexWidth : Nat
+  deriving Repr, Inhabited
+
+-- Create a writer of `stride`-float vertices; capacities are hints (0 = allocate on first emit)
+@[extern "lean_afferent_vertex_writer_create"]
+opaque VertexWriter.create (stride : UInt32 := 6) (vertexCapacity : UInt64 := 0)
+    (indexCapacity : UInt64 := 0) : IO VertexWriter
+
+@[extern "lean_afferent_vertex_writer_destroy"]
+opaque VertexWriter.destroy (writer : @& VertexWriter) : IO Unit
+
+-- Drop all geometry, keeping capacity; indices go back to u16
+@[extern "lean_afferent_vertex_writer_clear"]
+opaque VertexWriter.clear (writer : @& VertexWriter) : IO Unit
+
+-- Following emitIndexTri indices are relative to the next vertex emitted
+@[extern "lean_afferent_vertex_writer_begin_shape"]
+opaque VertexWriter.beginShape (writer : @& VertexWriter) : IO Unit
+
+-- One vertex of a stride-6 writer: NDC position and color
+@[extern "lean_afferent_vertex_writer_emit_vertex"]
+opaque VertexWriter.emitVertex (writer : @& VertexWriter) (x y r g b a : Float) : IO Unit
+
+-- One record of a stride-4 writer
+@[extern "lean_afferent_vertex_writer_emit4"]
+opaque VertexWriter.emit4 (writer : @& VertexWriter) (f0 f1 f2 f3 : Float) : IO Unit
+
+-- One record of a stride-5 writer
+@[extern "lean_afferent_vertex_writer_emit5"]
+opaque VertexWriter.emit5 (writer : @& VertexWriter) (f0 f1 f2 f3 f4 : Float) : IO Unit
+
+-- One Canvas shape instance on a stride-12 writer: center and the images of the
+-- unit axes in NDC, color, and kind (0 = rect, 1 = ellipse)
+@[extern "lean_afferent_vertex_writer_emit_shape_instance"]
+opaque VertexWriter.emitShapeInstance (writer : @& VertexWriter)
+    (cx cy ux uy vx vy : Float) (r g b a : Float) (kind : Float) : IO Unit
+
+-- Solid-color quad on a stride-6 writer: four corners in order, two triangles
+@[extern "lean_afferent_vertex_writer_emit_quad"]
+opaque VertexWriter.emitQuad (writer : @& VertexWriter)
+    (x0 y0 x1 y1 x2 y2 x3 y3 : Float) (r g b a : Float) : IO Unit
+
+-- Triangle with indices relative to the current shape; fails if one has not been emitted
+@[extern "lean_afferent_vertex_writer_emit_index_tri"]
+opaque VertexWriter.emitIndexTri (writer : @& VertexWriter) (a b c : UInt32) : IO Unit
+
+-- A whole shape in one call: vertices plus shape-relative indices, checked up front
+@[extern "lean_afferent_vertex_writer_emit_shape"]
+opaque VertexWriter.emitShape (writer : @& VertexWriter) (vertices : @& FloatArray)
+    (indices : @& Array UInt32) : IO Unit
+
+@[extern "lean_afferent_vertex_writer_vertex_count"]
+opaque VertexWriter.vertexCount (writer : @& VertexWriter) : IO UInt32
+
+@[extern "lean_afferent_vertex_writer_index_count"]
+opaque VertexWriter.indexCount (writer : @& VertexWriter) : IO UInt32
+
+@[extern "lean_afferent_vertex_writer_stats"]
+opaque VertexWriter.statsRaw (writer : @& VertexWriter) : IO (Array UInt64)
+
+-- Copy of the vertex data (for tests and interop; draws read it in place)
+@[extern "lean_afferent_vertex_writer_vertices"]
+opaque VertexWriter.vertices (writer : @& VertexWriter) : IO FloatArray
+
+-- Copy of the packed little-endian indices
+@[extern "lean_afferent_vertex_writer_index_bytes"]
+opaque VertexWriter.indexBytes (writer : @& VertexWriter) : IO ByteArray
+
+-- Draw a stride-6 writer as one indexed triangle draw
+@[extern "lean_afferent_renderer_draw_vertex_writer"]
+opaque Renderer.drawVertexWriter (renderer : @& Renderer) (writer : @& VertexWriter) : IO Unit
+
+-- Draw a stride-12 writer of shape instances as one instanced draw
+@[extern "lean_afferent_renderer_draw_instanced_shapes_writer"]
+opaque Renderer.drawInstancedShapesWriter (renderer : @& Renderer) (writer : @& VertexWriter) : IO Unit
+
+-- Dynamic shapes from writer records (see Render.Dynamic for the layouts)
+@[extern "lean_afferent_renderer_draw_dynamic_circles_writer"]
+opaque Renderer.drawDynamicCirclesWriter (renderer : @& Renderer) (writer : @& VertexWriter)
+    (time canvasWidth canvasHeight : Float) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_dynamic_rects_writer"]
+opaque Renderer.drawDynamicRectsWriter (renderer : @& Renderer) (writer : @& VertexWriter)
+    (time canvasWidth canvasHeight : Float) : IO Unit
+
+@[extern "lean_afferent_renderer_draw_dynamic_triangles_writer"]
+opaque Renderer.drawDynamicTrianglesWriter (renderer : @& Renderer) (writer : @& VertexWriter)
+    (time canvasWidth canvasHeight : Float) : IO Unit
+
+def VertexWriter.stats (writer : VertexWriter) : IO VertexWriterStats := do
+  let raw ← writer.statsRaw
+  let get (i : Nat) : Nat := (raw.getD i 0).toNat
+  pure { vertexCount := get 0, indexCount := get 1, vertexCapacity := get 2,
+         indexCapacity := get 3, bytesReserved := get 4, grows := get 5,
+         stride := get 6, indexWidth := if get 7 == 0 then 2 else 4 }
+
+end Afferent.FFI
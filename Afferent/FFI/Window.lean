@@ -10,6 +10,11 @@ namespace Afferent.FFI
 @[extern "lean_afferent_window_create"]
 opaque Window.create (width height : UInt32) (title : @& String) : IO Window
 
+-- Window with a Metal device but nothing on screen: input getters return zeroed
+-- state and renderers created on it never begin a frame (draws are no-ops).
+@[extern "lean_afferent_window_create_headless"]
+opaque Window.createHeadless (width height : UInt32) : IO Window
+
 @[extern "lean_afferent_window_destroy"]
 opaque Window.destroy (window : @& Window) : IO Unit
 
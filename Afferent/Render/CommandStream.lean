@@ -0,0 +1,156 @@
+/-
+  Afferent Command Stream
+  Encoder for the packed 2D command format that FFI.Renderer.executeCommands
+  runs natively in a single call (byte layout documented in afferent.h).
+  Shapes are tessellated in Lean as usual; consecutive fills and strokes are
+  merged into one TRIANGLES command, and text, clip and sprite commands flush
+  that pending geometry first so draw order is preserved.
+-/
+import Afferent.Core.Types
+import Afferent.Core.Transform
+import Afferent.Render.Tessellation
+import Afferent.FFI.CommandStream
+
+namespace Afferent
+
+/-- Command opcodes (AfferentCommandOp in afferent.h). -/
+inductive CommandOp where
+  /-- Indexed triangles in NDC (fills and strokes) -/
+  | triangles
+  | text
+  /-- Clip to a rect in logical pixels, intersected with the enclosing clip -/
+  | pushClip
+  | popClip
+  | sprites
+  deriving Repr, BEq, Inhabited
+
+namespace CommandOp
+
+def toUInt32 : CommandOp → UInt32
+  | .triangles => 1
+  | .text => 2
+  | .pushClip => 3
+  | .popClip => 4
+  | .sprites => 5
+
+end CommandOp
+
+/-- A frame of packed draw commands. -/
+structure CommandStream where
+  /-- Header plus every command written so far. -/
+  bytes : ByteArray
+  /-- Fills and strokes not yet written; emitted as one TRIANGLES command. -/
+  pending : Batch
+  /-- Commands in `bytes` (pending geometry not included). -/
+  commandCount : Nat
+deriving Inhabited
+
+namespace CommandStream
+
+def magic : UInt32 := 0x53434641
+def version : UInt32 := 1
+
+/-- Append a little-endian u32. -/
+def pushU32 (b : ByteArray) (v : UInt32) : ByteArray :=
+  b.push v.toUInt8 |>.push (v >>> 8).toUInt8 |>.push (v >>> 16).toUInt8 |>.push (v >>> 24).toUInt8
+
+/-- Append a float narrowed to a little-endian f32. -/
+def pushF32 (b : ByteArray) (x : Float) : ByteArray :=
+  pushU32 b x.toFloat32.toBits
+
+/-- Start a stream; `capacity` is a byte-size hint. -/
+def withCapacity (capacity : Nat := 4096) : CommandStream :=
+  { bytes := pushU32 (pushU32 (ByteArray.emptyWithCapacity capacity) magic) version
+    pending := Batch.empty
+    commandCount := 0 }
+
+def empty : CommandStream := withCapacity
+
+/-- Write pending fills/strokes as a single TRIANGLES command. -/
+def flush (s : CommandStream) : CommandStream :=
+  if s.pending.isEmpty then s
+  else Id.run do
+    let batch := s.pending
+    let mut b := pushU32 s.bytes CommandOp.triangles.toUInt32
+    b := pushU32 b batch.vertexCount.toUInt32
+    b := pushU32 b batch.indexCount.toUInt32
+    for x in batch.vertices do
+      b := pushF32 b x
+    match batch.indexFormat with
+    | .u32 => b := b ++ batch.indexData
+    | .u16 =>
+      -- The stream format is u32; zero-extend each little-endian u16
+      let data := batch.indexData
+      for n in [:batch.indexCount] do
+        b := b.push data[2 * n]! |>.push data[2 * n + 1]! |>.push 0 |>.push 0
+    { bytes := b, pending := Batch.empty, commandCount := s.commandCount + 1 }
+
+/-! ## Commands -/
+
+/-- Add tessellated geometry (fill or stroke, NDC vertices). -/
+def triangles (result : TessellationResult) (s : CommandStream) : CommandStream :=
+  { s with pending := s.pending.add result }
+
+/-- Fill a transformed rectangle (fast path, no Path). -/
+def fillRect (rect : Rect) (transform : Transform) (style : FillStyle)
+    (canvasWidth canvasHeight : Float) (s : CommandStream) : CommandStream :=
+  { s with pending := s.pending.addTransformedRect rect transform style canvasWidth canvasHeight }
+
+/-- Draw text with font `font` (index into the font table passed at execution). -/
+def text (font : Nat) (str : String) (x y : Float) (color : Color) (transform : Transform)
+    (s : CommandStream) : CommandStream := Id.run do
+  let s := s.flush
+  let utf8 := str.toUTF8
+  let mut b := pushU32 s.bytes CommandOp.text.toUInt32
+  b := pushU32 b font.toUInt32
+  b := pushF32 (pushF32 b x) y
+  b := pushF32 (pushF32 (pushF32 (pushF32 b color.r) color.g) color.b) color.a
+  for v in transform.toArray do
+    b := pushF32 b v
+  b := pushU32 b utf8.size.toUInt32
+  b := b ++ utf8
+  for _ in [:(4 - utf8.size % 4) % 4] do
+    b := b.push 0
+  { s with bytes := b, commandCount := s.commandCount + 1 }
+
+/-- Clip subsequent drawing to `rect` (logical pixels) within the current clip. -/
+def pushClip (rect : Rect) (s : CommandStream) : CommandStream :=
+  let s := s.flush
+  let b := pushU32 s.bytes CommandOp.pushClip.toUInt32
+  let b := pushF32 (pushF32 (pushF32 (pushF32 b rect.x) rect.y) rect.width) rect.height
+  { s with bytes := b, commandCount := s.commandCount + 1 }
+
+/-- Restore the clip from before the matching pushClip. -/
+def popClip (s : CommandStream) : CommandStream :=
+  let s := s.flush
+  { s with bytes := pushU32 s.bytes CommandOp.popClip.toUInt32, commandCount := s.commandCount + 1 }
+
+/-- Draw sprites with texture `texture` (index into the texture table).
+    `data` is [pixelX, pixelY, rotation, halfSizePixels, alpha] per sprite. -/
+def sprites (texture : Nat) (data : FloatArray) (s : CommandStream) : CommandStream := Id.run do
+  let s := s.flush
+  let count := data.size / 5
+  let mut b := pushU32 s.bytes CommandOp.sprites.toUInt32
+  b := pushU32 (pushU32 b texture.toUInt32) count.toUInt32
+  for i in [:count * 5] do
+    b := pushF32 b data[i]!
+  { s with bytes := b, commandCount := s.commandCount + 1 }
+
+/-! ## Output -/
+
+/-- The encoded stream, including any pending geometry. -/
+def finish (s : CommandStream) : ByteArray :=
+  s.flush.bytes
+
+/-- Commands in the finished stream. -/
+def size (s : CommandStream) : Nat :=
+  (s.flush).commandCount
+
+/-- Execute the whole stream in one FFI call. -/
+def execute (s : CommandStream) (renderer : FFI.Renderer) (fonts : Array FFI.Font)
+    (textures : Array FFI.Texture) (canvasWidth canvasHeight : Float) : IO UInt32 :=
+  renderer.executeCommands s.finish fonts textures canvasWidth canvasHeight
+
+end CommandStream
+
+end Afferent
@@ -14,6 +14,7 @@
 -/
 
 import Afferent.FFI
+import Afferent.Render.VertexWriter
 import Init.Data.FloatArray
 
 namespace Afferent.Render.Dynamic
@@ -35,28 +36,12 @@ structure ParticleState where
   screenHeight : Float
   deriving Inhabited
 
-/-- Create initial particle state with random positions and velocities. -/
+/-- Create initial particle state with random positions and velocities.
+    Generated natively in parallel; the result depends only on `seed`. -/
 def ParticleState.create (count : Nat) (screenWidth screenHeight : Float) (seed : Nat) : ParticleState :=
-  let data := Id.run do
-    let mut arr := FloatArray.emptyWithCapacity (count * 5)
-    let mut s := seed
-    for i in [:count] do
-      -- Simple LCG for deterministic randomness
-      s := (s * 1103515245 + 12345) % (2^31)
-      let x := (s.toFloat / 2147483648.0) * screenWidth
-      s := (s * 1103515245 + 12345) % (2^31)
-      let y := (s.toFloat / 2147483648.0) * screenHeight
-      s := (s * 1103515245 + 12345) % (2^31)
-      let vx := (s.toFloat / 2147483648.0 - 0.5) * 400.0
-      s := (s * 1103515245 + 12345) % (2^31)
-      let vy := (s.toFloat / 2147483648.0 - 0.5) * 400.0
-      let hue := i.toFloat / count.toFloat
-      arr := arr.push x
-      arr := arr.push y
-      arr := arr.push vx
-      arr := arr.push vy
-      arr := arr.push hue
-    arr
+  let data := FFI.Particles.generate count
+    { position := .rect 0.0 0.0 screenWidth screenHeight, velocity := .box 200.0 }
+    seed.toUInt32
   { data, count, screenWidth, screenHeight }
 
 /-- Update particle positions with simple bouncing physics. -/
@@ -105,6 +90,13 @@ def ParticleState.updateBouncingAndWriteSprites (p : ParticleState)
     p.data p.count.toUInt32 dt halfSize p.screenWidth p.screenHeight spriteBuffer
   pure { p with data }
 
+/-- Update bouncing physics natively, in place in `p.data`.
+    Pair with `drawSpritesFromParticles` to skip the sprite FloatBuffer. -/
+def ParticleState.updateBouncingInPlace (p : ParticleState)
+    (dt radius : Float) : IO ParticleState := do
+  let data ← FFI.Particles.updateBouncing p.data p.count.toUInt32 dt radius p.screenWidth p.screenHeight
+  pure { p with data }
+
 /-- Update bouncing physics and write dynamic circle buffer in one pass. -/
 def ParticleState.updateBouncingAndWriteCircles (p : ParticleState)
     (dt radius : Float) (circleBuffer : FFI.FloatBuffer) : IO ParticleState := do
@@ -144,8 +136,8 @@ format expected by each shader. -/
 
 /-- Build dynamic circle data from particle state.
     Format: [pixelX, pixelY, hueBase, radiusPixels] × count (4 floats per circle) -/
-def buildCircleData (particles : ParticleState) (radius : Float) : Array Float := Id.run do
-  let mut data := Array.mkEmpty (particles.count * 4)
+def buildCircleData (particles : ParticleState) (radius : Float) : FloatArray := Id.run do
+  let mut data := FloatArray.emptyWithCapacity (particles.count * 4)
   for i in [:particles.count] do
     let base := i * 5
     let x := particles.data.get! base
@@ -160,8 +152,8 @@ def buildCircleData (particles : ParticleState) (radius : Float) : Array Float :
 /-- Build dynamic rect data from particle state.
     Format: [pixelX, pixelY, hueBase, halfSizePixels, rotation] × count (5 floats per rect)
     Rotation can be time-based or per-particle stored. -/
-def buildRectData (particles : ParticleState) (halfSize : Float) (getRotation : Nat → Float) : Array Float := Id.run do
-  let mut data := Array.mkEmpty (particles.count * 5)
+def buildRectData (particles : ParticleState) (halfSize : Float) (getRotation : Nat → Float) : FloatArray := Id.run do
+  let mut data := FloatArray.emptyWithCapacity (particles.count * 5)
   for i in [:particles.count] do
     let base := i * 5
     let x := particles.data.get! base
@@ -175,19 +167,19 @@ def buildRectData (particles : ParticleState) (halfSize : Float) (getRotation :
   data
 
 /-- Build dynamic rect data with uniform rotation for all particles. -/
-def buildRectDataUniform (particles : ParticleState) (halfSize rotation : Float) : Array Float :=
+def buildRectDataUniform (particles : ParticleState) (halfSize rotation : Float) : FloatArray :=
   buildRectData particles halfSize (fun _ => rotation)
 
 /-- Build dynamic rect data with time-based per-particle rotation. -/
-def buildRectDataAnimated (particles : ParticleState) (halfSize t spinSpeed : Float) : Array Float :=
+def buildRectDataAnimated (particles : ParticleState) (halfSize t spinSpeed : Float) : FloatArray :=
   buildRectData particles halfSize (fun i =>
     let hue := particles.data.get! (i * 5 + 4)
     t * spinSpeed + hue * 6.28)
 
 /-- Build dynamic triangle data from particle state.
     Format: [pixelX, pixelY, hueBase, halfSizePixels, rotation] × count (5 floats per triangle) -/
-def buildTriangleData (particles : ParticleState) (halfSize : Float) (getRotation : Nat → Float) : Array Float := Id.run do
-  let mut data := Array.mkEmpty (particles.count * 5)
+def buildTriangleData (particles : ParticleState) (halfSize : Float) (getRotation : Nat → Float) : FloatArray := Id.run do
+  let mut data := FloatArray.emptyWithCapacity (particles.count * 5)
   for i in [:particles.count] do
     let base := i * 5
     let x := particles.data.get! base
@@ -201,15 +193,44 @@ def buildTriangleData (particles : ParticleState) (halfSize : Float) (getRotatio
   data
 
 /-- Build dynamic triangle data with uniform rotation. -/
-def buildTriangleDataUniform (particles : ParticleState) (halfSize rotation : Float) : Array Float :=
+def buildTriangleDataUniform (particles : ParticleState) (halfSize rotation : Float) : FloatArray :=
   buildTriangleData particles halfSize (fun _ => rotation)
 
 /-- Build dynamic triangle data with time-based per-particle rotation. -/
-def buildTriangleDataAnimated (particles : ParticleState) (halfSize t spinSpeed : Float) : Array Float :=
+def buildTriangleDataAnimated (particles : ParticleState) (halfSize t spinSpeed : Float) : FloatArray :=
   buildTriangleData particles halfSize (fun i =>
     let hue := particles.data.get! (i * 5 + 4)
     t * spinSpeed + hue * 6.28)
 
+/-! ## Vertex Writer Builders
+
+The same record layouts, emitted into a native VertexWriter (stride 4 for
+circles, 5 for rects and triangles) instead of a FloatArray. Records land
+as float32 where the draw reads them, so there is no per-frame array to
+grow and no narrowing copy at draw time. Clear the writer between frames. -/
+
+/-- Emit [pixelX, pixelY, hueBase, radiusPixels] per particle. -/
+def writeCircleData (particles : ParticleState) (radius : Float) : VertexWriterM Unit := do
+  for i in [:particles.count] do
+    let base := i * 5
+    VertexWriterM.emit4 (particles.data.get! base) (particles.data.get! (base + 1))
+      (particles.data.get! (base + 4)) radius
+
+/-- Emit [pixelX, pixelY, hueBase, halfSizePixels, rotation] per particle
+    (the rect and triangle layout). -/
+def writeRectData (particles : ParticleState) (halfSize : Float) (getRotation : Nat → Float) :
+    VertexWriterM Unit := do
+  for i in [:particles.count] do
+    let base := i * 5
+    VertexWriterM.emit5 (particles.data.get! base) (particles.data.get! (base + 1))
+      (particles.data.get! (base + 4)) halfSize (getRotation i)
+
+/-- Emit rect records with time-based per-particle rotation. -/
+def writeRectDataAnimated (particles : ParticleState) (halfSize t spinSpeed : Float) : VertexWriterM Unit :=
+  writeRectData particles halfSize (fun i =>
+    let hue := particles.data.get! (i * 5 + 4)
+    t * spinSpeed + hue * 6.28)
+
 /-! ## Draw Functions
 
 These wrap the FFI calls with a cleaner interface.
@@ -218,31 +239,52 @@ Canvas width/height are the logical (not physical) dimensions for coordinate con
 /-- Draw dynamic circles. GPU computes color + NDC conversion. -/
 def drawCircles (renderer : FFI.Renderer) (particles : ParticleState) (radius t : Float) : IO Unit := do
   let data := buildCircleData particles radius
-  FFI.Renderer.drawDynamicCircles renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+  FFI.Renderer.drawDynamicCirclesFloatArray renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
 
 /-- Draw dynamic rects with time-based rotation. GPU computes color + NDC. -/
 def drawRectsAnimated (renderer : FFI.Renderer) (particles : ParticleState)
     (halfSize t spinSpeed : Float) : IO Unit := do
   let data := buildRectDataAnimated particles halfSize t spinSpeed
-  FFI.Renderer.drawDynamicRects renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+  FFI.Renderer.drawDynamicRectsFloatArray renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
 
 /-- Draw dynamic rects with uniform rotation. GPU computes color + NDC. -/
 def drawRectsUniform (renderer : FFI.Renderer) (particles : ParticleState)
     (halfSize rotation t : Float) : IO Unit := do
   let data := buildRectDataUniform particles halfSize rotation
-  FFI.Renderer.drawDynamicRects renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+  FFI.Renderer.drawDynamicRectsFloatArray renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
 
 /-- Draw dynamic triangles with time-based rotation. GPU computes color + NDC. -/
 def drawTrianglesAnimated (renderer : FFI.Renderer) (particles : ParticleState)
     (halfSize t spinSpeed : Float) : IO Unit := do
   let data := buildTriangleDataAnimated particles halfSize t spinSpeed
-  FFI.Renderer.drawDynamicTriangles renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+  FFI.Renderer.drawDynamicTrianglesFloatArray renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
 
 /-- Draw dynamic triangles with uniform rotation. GPU computes color + NDC. -/
 def drawTrianglesUniform (renderer : FFI.Renderer) (particles : ParticleState)
     (halfSize rotation t : Float) : IO Unit := do
   let data := buildTriangleDataUniform particles halfSize rotation
-  FFI.Renderer.drawDynamicTriangles renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+  FFI.Renderer.drawDynamicTrianglesFloatArray renderer data particles.count.toUInt32 t particles.screenWidth particles.screenHeight
+
+/-- Draw dynamic circles through `writer` (stride 4), reusing its storage. -/
+def drawCirclesWriter (renderer : FFI.Renderer) (writer : FFI.VertexWriter) (particles : ParticleState)
+    (radius t : Float) : IO Unit := do
+  writer.clear
+  (writeCircleData particles radius).run writer
+  FFI.Renderer.drawDynamicCirclesWriter renderer writer t particles.screenWidth particles.screenHeight
+
+/-- Draw dynamic rects with time-based rotation through `writer` (stride 5). -/
+def drawRectsAnimatedWriter (renderer : FFI.Renderer) (writer : FFI.VertexWriter) (particles : ParticleState)
+    (halfSize t spinSpeed : Float) : IO Unit := do
+  writer.clear
+  (writeRectDataAnimated particles halfSize t spinSpeed).run writer
+  FFI.Renderer.drawDynamicRectsWriter renderer writer t particles.screenWidth particles.screenHeight
+
+/-- Draw dynamic triangles with time-based rotation through `writer` (stride 5). -/
+def drawTrianglesAnimatedWriter (renderer : FFI.Renderer) (writer : FFI.VertexWriter) (particles : ParticleState)
+    (halfSize t spinSpeed : Float) : IO Unit := do
+  writer.clear
+  (writeRectDataAnimated particles halfSize t spinSpeed).run writer
+  FFI.Renderer.drawDynamicTrianglesWriter renderer writer t particles.screenWidth particles.screenHeight
 
 /-! ## Sprite Data Builders
 
@@ -306,6 +348,13 @@ def writeSpritesToBuffer (particles : ParticleState) (buffer : FFI.FloatBuffer)
   -- One FFI call for all sprites (avoids 100k boundary crossings per frame)
   FFI.FloatBuffer.writeSpritesFromParticles buffer particles.data particles.count.toUInt32 halfSize rotation alpha
 
+/-- Draw sprites directly from particle state. The particle array is read in
+    place and packed during the GPU upload, so no sprite FloatBuffer is written. -/
+def drawSpritesFromParticles (renderer : FFI.Renderer) (texture : FFI.Texture)
+    (particles : ParticleState) (halfSize : Float) : IO Unit :=
+  FFI.Renderer.drawSpritesParticles renderer texture particles.data particles.count.toUInt32
+    halfSize particles.screenWidth particles.screenHeight
+
 /-- Draw sprites from a FloatBuffer. Call writeSpritesToBuffer first, then this. -/
 def drawSpritesFromBuffer (renderer : FFI.Renderer) (texture : FFI.Texture)
     (buffer : FFI.FloatBuffer) (count : UInt32) (_halfSize : Float)
@@ -0,0 +1,136 @@
+/-
+  Afferent Gradient Lookup Tables
+  A gradient's stops evaluated once into a fixed-size color table, so sampling
+  it is a clamp, an index and one lerp instead of a search through the stops.
+  The table doubles as a 1-pixel-high RGBA8 texture, so a backend can evaluate
+  gradients per pixel rather than only at vertices. Tables are kept in a cache
+  keyed by a hash of the stops, as the same few gradients are drawn every frame.
+-/
+import Std.Data.HashMap
+import Afferent.Render.Tessellation
+
+namespace Afferent
+
+/-- A gradient's colors at evenly spaced positions: entry `i` of `size` is the color
+    at `i / (size - 1)`, as `Tessellation.interpolateGradientStops` gives it. -/
+structure GradientLUT where
+  /-- RGBA per entry, straight (not premultiplied) alpha. -/
+  colors : FloatArray
+
+namespace GradientLUT
+
+/-- Entries in a table: 256, one per 8-bit color step across the gradient. -/
+def defaultSize : Nat := 256
+
+/-- Evaluate `stops` at `size` evenly spaced positions from 0 to 1. -/
+def build (stops : Array GradientStop) (size : Nat := defaultSize) : GradientLUT := Id.run do
+  let mut colors : FloatArray := FloatArray.emptyWithCapacity (size * 4)
+  let last := if size > 1 then (size - 1).toFloat else 1.0
+  for i in [:size] do
+    let c := Tessellation.interpolateGradientStops stops (i.toFloat / last)
+    colors := colors.push c.r |>.push c.g |>.push c.b |>.push c.a
+  return { colors }
+
+/-- Number of entries. -/
+def size (lut : GradientLUT) : Nat :=
+  lut.colors.size / 4
+
+private def entry (lut : GradientLUT) (i : Nat) : Color :=
+  let base := i * 4
+  Color.rgba lut.colors[base]! lut.colors[base + 1]! lut.colors[base + 2]! lut.colors[base + 3]!
+
+/-- Color at gradient position `t`, clamped to [0, 1], interpolated between the two
+    nearest entries as a linearly filtered texture would be. -/
+def sample (lut : GradientLUT) (t : Float) : Color :=
+  let n := lut.size
+  if n == 0 then Color.black
+  else if n == 1 then lut.entry 0
+  else
+    let t := if t < 0.0 then 0.0 else if t > 1.0 then 1.0 else t
+    let x := t * (n - 1).toFloat
+    let i := min x.floor.toUInt64.toNat (n - 2)
+    Color.lerp (lut.entry i) (lut.entry (i + 1)) (x - i.toFloat)
+
+/-- Sample gradient `g`, whose stops this table was built from, at `p`. Degenerate
+    gradients fall back to `Tessellation.sampleGradient`. -/
+def sampleGradient (lut : GradientLUT) (g : Gradient) (p : Point) : Color :=
+  let t := match g with
+    | .linear start finish _ => Tessellation.linearGradientPosition start finish p
+    | .radial center radius _ => Tessellation.radialGradientPosition center radius p
+  match t with
+  | some t => lut.sample t
+  | none => Tessellation.sampleGradient g p
+
+/-- The color function of a fill style: solid colors as they are, gradients through
+    `lut` when one is given, else `Tessellation.sampleFillStyle`. -/
+def sampler (lut : Option GradientLUT) (style : FillStyle) : Point → Color :=
+  match style, lut with
+  | .solid c, _ => fun _ => c
+  | .gradient g, some lut => lut.sampleGradient g
+  | .gradient g, none => Tessellation.sampleGradient g
+
+/-- The table as a `size`x1 RGBA8 texture row, straight alpha. Texel `i` holds
+    position `i / (size - 1)`, so a linearly filtered lookup of position `t` reads
+    texture coordinate `(t * (size - 1) + 0.5) / size`. -/
+def toRGBA8 (lut : GradientLUT) : ByteArray := Id.run do
+  let mut bytes := ByteArray.emptyWithCapacity lut.colors.size
+  for i in [:lut.colors.size] do
+    let c := lut.colors[i]!
+    let c := if c < 0.0 then 0.0 else if c > 1.0 then 1.0 else c
+    bytes := bytes.push (c * 255.0).round.toUInt8
+  return bytes
+
+end GradientLUT
+
+/-- Gradient tables by stops, built on first use. -/
+structure GradientLUTCache where
+  /-- Tables by stop hash, with the stops they were built from, so a hash collision
+      is a miss rather than the wrong colors. -/
+  entries : Std.HashMap UInt64 (Array GradientStop × GradientLUT) := {}
+  hits : Nat := 0
+  misses : Nat := 0
+
+namespace GradientLUTCache
+
+/-- Most tables kept; past it the cache is emptied and refilled by what is drawn. -/
+def maxEntries : Nat := 1024
+
+/-- Structural hash of a stop array. -/
+def hashStops (stops : Array GradientStop) : UInt64 :=
+  stops.foldl (init := 11) fun h s =>
+    let h := mixHash (mixHash h s.position.toBits) s.color.r.toBits
+    mixHash (mixHash (mixHash h s.color.g.toBits) s.color.b.toBits) s.color.a.toBits
+
+/-- The stored table for `stops`, counting the hit or miss. -/
+def find? (cache : GradientLUTCache) (hash : UInt64) (stops : Array GradientStop) :
+    Option GradientLUT × GradientLUTCache :=
+  match cache.entries.get? hash with
+  | some (cached, lut) =>
+    if cached == stops then (some lut, { cache with hits := cache.hits + 1 })
+    else (none, { cache with misses := cache.misses + 1 })
+  | none => (none, { cache with misses := cache.misses + 1 })
+
+/-- Store `lut` as the table for `stops`, emptying a full cache first. -/
+def insert (cache : GradientLUTCache) (hash : UInt64) (stops : Array GradientStop)
+    (lut : GradientLUT) : GradientLUTCache :=
+  let entries := if cache.entries.size >= maxEntries then {} else cache.entries
+  { cache with entries := entries.insert hash (stops, lut) }
+
+/-- The table for `stops`, building and storing it on a miss. The table is built
+    outside the ref, which only holds the cache while it is looked up or updated. -/
+def lookup (cache : IO.Ref GradientLUTCache) (stops : Array GradientStop) : IO GradientLUT := do
+  let hash := hashStops stops
+  if let some lut := (← cache.modifyGet (·.find? hash stops)) then
+    return lut
+  let lut := GradientLUT.build stops
+  cache.modify (·.insert hash stops lut)
+  return lut
+
+/-- The table for a fill style's gradient; `none` for solid colors. -/
+def forStyle (cache : IO.Ref GradientLUTCache) : FillStyle → IO (Option GradientLUT)
+  | .solid _ => pure none
+  | .gradient (.linear _ _ stops) | .gradient (.radial _ _ stops) => some <$> lookup cache stops
+
+end GradientLUTCache
+
+end Afferent
@@ -46,6 +46,9 @@ def cubeVertices : Array Float := #[
   -0.5, -0.5,  0.5,   0, -1, 0,  0.9, 0.2, 0.9, 1
 ]
 
+/-- Cube vertices as an unboxed FloatArray (for the drawMesh3D*FloatArray paths). -/
+def cubeVertexData : FloatArray := ⟨cubeVertices⟩
+
 /-- Cube mesh indices: 36 indices (6 faces x 2 triangles x 3 vertices) -/
 def cubeIndices : Array UInt32 := #[
   -- Front face
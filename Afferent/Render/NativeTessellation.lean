@@ -0,0 +1,88 @@
+/-
+  Afferent Native Tessellation
+  Paths encoded as a flat Float command stream and tessellated in native
+  code straight into a VertexWriter. Output matches Afferent.Tessellation
+  (tessellateConvexPathNDC / tessellateStrokeNDC of the transformed path)
+  up to float32 precision, with no per-segment Lean allocation.
+-/
+import Afferent.Render.VertexWriter
+import Afferent.FFI.Tessellator
+
+namespace Afferent
+
+namespace NativeTessellation
+
+/-! ## Encoding
+
+One Float opcode (AfferentPathOp in afferent.h) followed by its operands.
+Encoded paths can be kept and re-tessellated under different transforms. -/
+
+@[inline] private def push2 (out : FloatArray) (p : Point) : FloatArray :=
+  out.push p.x |>.push p.y
+
+/-- Append one command to an encoded stream. -/
+def encodeCommand (out : FloatArray) : PathCommand → FloatArray
+  | .moveTo p => push2 (out.push 0) p
+  | .lineTo p => push2 (out.push 1) p
+  | .quadraticCurveTo cp p => push2 (push2 (out.push 2) cp) p
+  | .bezierCurveTo cp1 cp2 p => push2 (push2 (push2 (out.push 3) cp1) cp2) p
+  | .arcTo p1 p2 radius => push2 (push2 (out.push 4) p1) p2 |>.push radius
+  | .arc center radius startAngle endAngle ccw =>
+    push2 (out.push 5) center |>.push radius |>.push startAngle |>.push endAngle
+      |>.push (if ccw then 1 else 0)
+  | .rect r => push2 (out.push 6) r.origin |>.push r.size.width |>.push r.size.height
+  | .closePath => out.push 7
+  | .ellipseArc center axisX axisY startAngle sweep =>
+    push2 (push2 (push2 (out.push 8) center) axisX) axisY |>.push startAngle |>.push sweep
+
+/-- Encode a whole path. -/
+def encodePath (path : Path) : FloatArray :=
+  path.commands.foldl encodeCommand (FloatArray.emptyWithCapacity (path.commands.size * 7))
+
+/-- The transform operand: empty for identity, otherwise a, b, c, d, tx, ty. -/
+def encodeTransform (t : Transform) : FloatArray :=
+  if t == Transform.identity then .empty
+  else ⟨#[t.a, t.b, t.c, t.d, t.tx, t.ty]⟩
+
+def lineCapCode : LineCap → UInt8
+  | .butt => 0
+  | .round => 1
+  | .square => 2
+
+def lineJoinCode : LineJoin → UInt8
+  | .miter => 0
+  | .round => 1
+  | .bevel => 2
+
+end NativeTessellation
+
+namespace VertexWriterM
+
+open NativeTessellation
+
+/-- Fill an encoded convex path (fan triangulation), in NDC for the given canvas. -/
+def emitFillEncoded (commands : FloatArray) (color : Color) (screenWidth screenHeight : Float)
+    (transform : Transform := Transform.identity) (tolerance : Float := 0.5) : VertexWriterM Unit := fun w =>
+  FFI.Tessellator.fillConvex w commands (encodeTransform transform) tolerance screenWidth screenHeight
+    color.r color.g color.b color.a
+
+/-- Stroke an encoded path, in NDC for the given canvas. -/
+def emitStrokeEncoded (commands : FloatArray) (style : StrokeStyle) (screenWidth screenHeight : Float)
+    (transform : Transform := Transform.identity) (tolerance : Float := 0.5) : VertexWriterM Unit := fun w =>
+  FFI.Tessellator.stroke w commands (encodeTransform transform) tolerance screenWidth screenHeight
+    style.color.r style.color.g style.color.b style.color.a style.lineWidth style.miterLimit
+    (lineCapCode style.lineCap) (lineJoinCode style.lineJoin)
+
+/-- Native counterpart of `tessellateConvexPathNDC`. -/
+def emitFillPath (path : Path) (color : Color) (screenWidth screenHeight : Float)
+    (transform : Transform := Transform.identity) (tolerance : Float := 0.5) : VertexWriterM Unit :=
+  emitFillEncoded (encodePath path) color screenWidth screenHeight transform tolerance
+
+/-- Native counterpart of `tessellateStrokeNDC`. -/
+def emitStrokePath (path : Path) (style : StrokeStyle) (screenWidth screenHeight : Float)
+    (transform : Transform := Transform.identity) (tolerance : Float := 0.5) : VertexWriterM Unit :=
+  emitStrokeEncoded (encodePath path) style screenWidth screenHeight transform tolerance
+
+end VertexWriterM
+
+end Afferent
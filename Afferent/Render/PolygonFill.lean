@@ -0,0 +1,160 @@
+/-
+  Afferent Polygon Fill
+  Path fills of any shape: concave outlines, holes and self-intersections,
+  honoring the path's fill rule. A single convex contour keeps the fan
+  triangulation of Afferent.Tessellation; everything else goes through the
+  native polygon triangulator (ear clipping for simple rings, a sweep for
+  crossing edges).
+-/
+import Afferent.Render.Tessellation
+import Afferent.Render.GradientLUT
+import Afferent.FFI.Tessellator
+
+namespace Afferent
+
+namespace Tessellation
+
+/-- Fill rule code understood by the native triangulator. -/
+def fillRuleCode : FillRule → UInt8
+  | .nonZero => 0
+  | .evenOdd => 1
+
+/-- True when the closed polygon through `points` is convex and winds once,
+    so a fan from its first point covers it exactly. Repeated points and
+    collinear runs are allowed. -/
+def isConvexPolygon (points : Array Point) : Bool := Id.run do
+  let n := points.size
+  if n < 4 then return true
+  let mut turnSign := 0.0
+  let mut dxSign := 0.0
+  let mut firstDxSign := 0.0
+  let mut dxFlips := 0
+  let mut prev : Option Point := none
+  let mut first : Option Point := none
+  for i in [:n + 1] do
+    -- One extra step compares the closing edge against the first edge
+    let edge : Option Point :=
+      if i < n then
+        let a := points[i]!
+        let b := points[(i + 1) % n]!
+        if a.x == b.x && a.y == b.y then none else some ⟨b.x - a.x, b.y - a.y⟩
+      else first
+    match edge with
+    | none => pure ()
+    | some e =>
+      if let some p := prev then
+        let cross := p.x * e.y - p.y * e.x
+        if cross != 0 then
+          if turnSign == 0 then turnSign := cross
+          else if (cross > 0) != (turnSign > 0) then return false
+      if i < n then
+        if first.isNone then first := some e
+        if e.x != 0 then
+          let s := if e.x > 0 then 1.0 else -1.0
+          if dxSign == 0 then firstDxSign := s
+          else if s != dxSign then dxFlips := dxFlips + 1
+          dxSign := s
+      prev := some e
+  -- The x direction changes twice around a convex polygon; more means it
+  -- winds more than once (e.g. a pentagram's vertices in star order)
+  if dxSign != 0 && dxSign != firstDxSign then dxFlips := dxFlips + 1
+  return dxFlips <= 2
+
+/-- Triangulate flattened contours with the native triangulator, returning the
+    triangle points (which may include edge crossings) and their indices. -/
+private def triangulateContours (points : Array Point) (contourEnds : Array UInt32)
+    (fillRule : FillRule) : IO (Array Point × Array UInt32) := do
+  let mut coords : FloatArray := FloatArray.emptyWithCapacity (points.size * 2)
+  for p in points do
+    coords := coords.push p.x |>.push p.y
+  let (triPoints, indices, _) ← FFI.Tessellator.triangulate coords contourEnds (fillRuleCode fillRule)
+  let mut out : Array Point := Array.mkEmpty (triPoints.size / 2)
+  for i in [:triPoints.size / 2] do
+    out := out.push ⟨triPoints[2 * i]!, triPoints[2 * i + 1]!⟩
+  return (out, indices)
+
+/-- Fill with a fringe (see `fringeOffsets`): the contours inset by half a fringe are
+    filled opaque, and each contour edge gets a quad out to the contour offset by half
+    a fringe, transparent on its outer side. Adds two vertices and six indices per
+    flattened point over the plain fill. Gradients are sampled at every vertex in
+    original space. -/
+private def tessellatePathFillFringeNDC (transformedPath : Path) (transform : Transform)
+    (style : FillStyle) (screenWidth screenHeight tolerance : Float) (lut : Option GradientLUT) :
+    IO TessellationResult := do
+  let (points, contourEnds) := pathToContours transformedPath tolerance
+  let offsets := fringeOffsets points contourEnds transformedPath.fillRule
+  let mut inner : Array Point := Array.mkEmpty points.size
+  let mut outer : Array Point := Array.mkEmpty points.size
+  for i in [:points.size] do
+    let p := points[i]!
+    let o := offsets[i]!
+    inner := inner.push ⟨p.x - o.x, p.y - o.y⟩
+    outer := outer.push ⟨p.x + o.x, p.y + o.y⟩
+  let toOriginal := transform.inverse
+  let sample := GradientLUT.sampler lut style
+  let colorAt (p : Point) : Color := sample (toOriginal.apply p)
+  -- Opaque core: the inset contours, filled as the plain fill would fill them
+  let core ←
+    if contourEnds.size <= 1 && isConvexPolygon inner then
+      pure (tessellateConvexPointsFillNDC (inner.map toOriginal.apply) inner style
+        screenWidth screenHeight sample)
+    else do
+      let (triPoints, indices) ← triangulateContours inner contourEnds transformedPath.fillRule
+      let mut vertices : FloatArray := FloatArray.emptyWithCapacity ((triPoints.size + 2 * points.size) * 6)
+      for p in triPoints do
+        vertices := pushVertexNDC vertices p (colorAt p) screenWidth screenHeight
+      let result : TessellationResult := { vertices, indices }
+      pure result
+  -- Fringe: an opaque inner and a transparent outer vertex per point
+  let base := core.vertices.size / 6
+  let mut vertices := core.vertices
+  for i in [:points.size] do
+    let edge := colorAt outer[i]!
+    vertices := pushVertexNDC vertices inner[i]! (colorAt inner[i]!) screenWidth screenHeight
+    vertices := pushVertexNDC vertices outer[i]! { edge with a := 0.0 } screenWidth screenHeight
+  let mut indices := core.indices
+  let mut start := 0
+  for e in contourEnds do
+    let stop := e.toNat
+    if stop - start >= 3 then
+      for i in [start:stop] do
+        let j := if i + 1 < stop then i + 1 else start
+        let vi := (base + 2 * i).toUInt32
+        let vj := (base + 2 * j).toUInt32
+        indices := pushFringeQuad indices vi (vi + 1) vj (vj + 1)
+    start := stop
+  return { vertices, indices }
+
+/-- Tessellate a path fill of any shape under `transformedPath.fillRule`, converting to NDC.
+    `transform` maps the original path onto transformedPath; gradients are sampled in
+    original space by mapping each vertex back through `transform.inverse`, so every
+    vertex gets its own color under any transform. `tolerance` is in screen pixels. With
+    `antialias`, edges get a `fringeWidth` alpha ramp instead of relying on MSAA. A
+    gradient is sampled from `lut`, the table of its stops, when one is given. -/
+def tessellatePathFillNDC (_originalPath transformedPath : Path) (transform : Transform)
+    (style : FillStyle) (screenWidth screenHeight : Float) (tolerance : Float := 0.5)
+    (antialias : Bool := false) (lut : Option GradientLUT := none) : IO TessellationResult := do
+  if antialias then
+    return (← tessellatePathFillFringeNDC transformedPath transform style screenWidth screenHeight
+      tolerance lut)
+  let toOriginal := transform.inverse
+  let sample := GradientLUT.sampler lut style
+  let (points, contourEnds) := pathToContours transformedPath tolerance
+  if contourEnds.size <= 1 && isConvexPolygon points then
+    return tessellateConvexPointsFillNDC (points.map toOriginal.apply) points
+      style screenWidth screenHeight sample
+  let (triPoints, indices) ← triangulateContours points contourEnds transformedPath.fillRule
+  let mut vertices : FloatArray := FloatArray.emptyWithCapacity (triPoints.size * 6)
+  for p in triPoints do
+    vertices := pushVertexNDC vertices p (sample (toOriginal.apply p)) screenWidth screenHeight
+  return { vertices, indices }
+
+/-- Solid-color path fill of any shape, in NDC; see `tessellatePathFillNDC`. -/
+def tessellatePathNDC (path : Path) (color : Color) (screenWidth screenHeight : Float)
+    (tolerance : Float := 0.5) (antialias : Bool := false) : IO TessellationResult :=
+  tessellatePathFillNDC path path Transform.identity (.solid color) screenWidth screenHeight tolerance
+    antialias
+
+end Tessellation
+
+end Afferent
@@ -0,0 +1,77 @@
+/-
+  Afferent Polyline Reduction
+  Long line and chart series (x, y pairs in a FloatArray) reduced to the
+  points a stroke can show at the current transform before they are
+  stroked, so a million-point series costs a few points per pixel column
+  rather than a few triangles per point. The reducer is native
+  (polyline_reducer.c); kept points are input points, untransformed.
+-/
+import Afferent.Render.NativeTessellation
+import Afferent.FFI.Tessellator
+
+namespace Afferent
+
+/-- How `Polyline.reduce` picks the points to keep. -/
+inductive PolylineReduction where
+  /-- `minMax` when the series' pixel x is monotonic, else `rdp`. -/
+  | auto
+  /-- First, lowest, highest and last point of each pixel column: exact for
+      time series and other monotonic-x data. -/
+  | minMax
+  /-- Ramer-Douglas-Peucker after a radial-distance pass: any polyline. -/
+  | rdp
+deriving Repr, BEq, Inhabited
+
+namespace PolylineReduction
+
+/-- Method code understood by the native reducer. -/
+def code : PolylineReduction → UInt8
+  | .auto => 0
+  | .minMax => 1
+  | .rdp => 2
+
+end PolylineReduction
+
+namespace Polyline
+
+/-- Reduce a polyline of x, y pairs to the points that matter when it is drawn under
+    `transform`: min/max columns are `2 * tolerance` pixels wide and RDP keeps points
+    more than `tolerance` pixels off the simplified line. First and last points are
+    always kept. Fails on non-finite points. -/
+def reduce (points : FloatArray) (transform : Transform := Transform.identity)
+    (tolerance : Float := 0.5) (method : PolylineReduction := .auto) : IO FloatArray :=
+  FFI.Tessellator.reducePolyline points (NativeTessellation.encodeTransform transform) tolerance
+    method.code
+
+/-- An open path through the x, y pairs. -/
+def toPath (points : FloatArray) : Path := Id.run do
+  let mut path := Path.empty
+  for i in [:points.size / 2] do
+    let p : Point := ⟨points[2 * i]!, points[2 * i + 1]!⟩
+    path := if i == 0 then path.moveTo p else path.lineTo p
+  return path
+
+/-- The native command stream of `toPath points`, built without the Path. -/
+def encode (points : FloatArray) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (points.size / 2 * 3)
+  for i in [:points.size / 2] do
+    out := out.push (if i == 0 then 0 else 1) |>.push points[2 * i]! |>.push points[2 * i + 1]!
+  return out
+
+end Polyline
+
+namespace VertexWriterM
+
+/-- Stroke a polyline of x, y pairs natively, in NDC for the given canvas, reducing it
+    first with `reduction` at `tolerance` under `transform` (`none` strokes every point). -/
+def emitStrokePolyline (points : FloatArray) (style : StrokeStyle) (screenWidth screenHeight : Float)
+    (transform : Transform := Transform.identity) (tolerance : Float := 0.5)
+    (reduction : Option PolylineReduction := some .auto) : VertexWriterM Unit := fun w => do
+  let points ← match reduction with
+    | some method => Polyline.reduce points transform tolerance method
+    | none => pure points
+  (emitStrokeEncoded (Polyline.encode points) style screenWidth screenHeight transform tolerance).run w
+
+end VertexWriterM
+
+end Afferent
@@ -10,10 +10,15 @@ import Afferent.Core.Transform
 
 namespace Afferent
 
+/-- FloatArray shown as its elements, so TessellationResult can derive `Repr`. -/
+private instance : Repr FloatArray where
+  reprPrec a prec := Repr.addAppParen ("FloatArray.mk " ++ reprArg a.data) prec
+
 /-- Result of tessellating a path into triangles. -/
 structure TessellationResult where
-  /-- Flat array of vertex data: x, y, r, g, b, a per vertex. -/
-  vertices : Array Float
+  /-- Flat array of vertex data: x, y, r, g, b, a per vertex.
+      Unboxed, so it crosses the FFI as contiguous memory. -/
+  vertices : FloatArray
   /-- Triangle indices (3 per triangle). -/
   indices : Array UInt32
 deriving Repr, Inhabited
@@ -24,54 +29,151 @@ namespace Tessellation
     Reused across all rectangle tessellation to avoid repeated allocation. -/
 private def rectIndices : Array UInt32 := #[0, 1, 2, 0, 2, 3]
 
-/-- Flatten a cubic Bezier curve to line segments using de Casteljau subdivision.
+/-- Upper bound on the segments one curve is flattened into, so huge or
+    non-finite control points cannot allocate without bound. -/
+def maxCurveSegments : Nat := 4096
+
+/-- Wang's formula: a degree-d Bezier whose control points have largest second
+    difference `m` stays within `tolerance` of its n-segment chord polyline when
+    n = ⌈√(d(d-1)/8 · m / tolerance)⌉. Clamped to [1, maxCurveSegments]. -/
+private def wangSegmentCount (degreeFactor m tolerance : Float) : Nat :=
+  let n := (Float.ceil (Float.sqrt (degreeFactor * m / tolerance))).toUInt32.toNat
+  if n < 1 then 1 else if n > maxCurveSegments then maxCurveSegments else n
+
+/-- Segments `flattenCubicBezier` uses for this cubic and tolerance. -/
+def cubicSegmentCount (p0 p1 p2 p3 : Point) (tolerance : Float := 0.5) : Nat :=
+  let ax := p0.x - 2.0 * p1.x + p2.x
+  let ay := p0.y - 2.0 * p1.y + p2.y
+  let bx := p1.x - 2.0 * p2.x + p3.x
+  let by_ := p1.y - 2.0 * p2.y + p3.y
+  let m := max (Float.sqrt (ax * ax + ay * ay)) (Float.sqrt (bx * bx + by_ * by_))
+  wangSegmentCount 0.75 m tolerance
+
+/-- Segments `flattenQuadraticBezier` uses for this quadratic and tolerance. -/
+def quadraticSegmentCount (p0 cp p2 : Point) (tolerance : Float := 0.5) : Nat :=
+  let ax := p0.x - 2.0 * cp.x + p2.x
+  let ay := p0.y - 2.0 * cp.y + p2.y
+  wangSegmentCount 0.25 (Float.sqrt (ax * ax + ay * ay)) tolerance
+
+/-- Flatten a cubic Bezier curve to line segments. The segment count comes from
+    Wang's formula and the points from forward differencing, so there is no
+    recursion and no per-point polynomial evaluation.
     Returns array of points (excluding start point, which caller already has). -/
-partial def flattenCubicBezier (p0 p1 p2 p3 : Point) (tolerance : Float := 0.5) : Array Point :=
-  let rec go (p0 p1 p2 p3 : Point) (acc : Array Point) : Array Point :=
-    -- Check if curve is flat enough using distance from control points to line
-    let d1 := linePointDistance p0 p3 p1
-    let d2 := linePointDistance p0 p3 p2
-    if max d1 d2 < tolerance then
-      acc.push p3
-    else
-      -- Subdivide at t=0.5 using de Casteljau
-      let m01 := Point.midpoint p0 p1
-      let m12 := Point.midpoint p1 p2
-      let m23 := Point.midpoint p2 p3
-      let m012 := Point.midpoint m01 m12
-      let m123 := Point.midpoint m12 m23
-      let mid := Point.midpoint m012 m123
-      let acc' := go p0 m01 m012 mid acc
-      go mid m123 m23 p3 acc'
-  -- Start with capacity for typical curve subdivision depth (8-16 segments)
-  go p0 p1 p2 p3 (Array.mkEmpty 16)
-where
-  linePointDistance (lineStart lineEnd point : Point) : Float :=
-    let dx := lineEnd.x - lineStart.x
-    let dy := lineEnd.y - lineStart.y
-    let len := Float.sqrt (dx * dx + dy * dy)
-    if len < 0.0001 then
-      Point.distance lineStart point
-    else
-      Float.abs ((point.x - lineStart.x) * dy - (point.y - lineStart.y) * dx) / len
-
-/-- Flatten a quadratic Bezier curve by converting to cubic and flattening. -/
-def flattenQuadraticBezier (p0 cp p2 : Point) (tolerance : Float := 0.5) : Array Point :=
-  -- Convert quadratic to cubic: cubic control points are 2/3 of the way to quadratic control point
-  let cp1 := Point.lerp p0 cp (2.0 / 3.0)
-  let cp2 := Point.lerp p2 cp (2.0 / 3.0)
-  flattenCubicBezier p0 cp1 cp2 p2 tolerance
-
-/-- Convert a path to an array of polygon vertices (flatten all curves).
-    Also returns whether the path is closed (ends with closePath or first/last points match). -/
-def pathToPolygonWithClosed (path : Path) (tolerance : Float := 0.5) : Array Point × Bool := Id.run do
+def flattenCubicBezier (p0 p1 p2 p3 : Point) (tolerance : Float := 0.5) : Array Point := Id.run do
+  let n := cubicSegmentCount p0 p1 p2 p3 tolerance
+  let mut out : Array Point := Array.mkEmpty n
+  if n > 1 then
+    let h := 1.0 / n.toFloat
+    let h2 := h * h
+    let h3 := h2 * h
+    -- B(t) = a t³ + b t² + c t + p0
+    let ax := (p3.x - p0.x) + 3.0 * (p1.x - p2.x)
+    let ay := (p3.y - p0.y) + 3.0 * (p1.y - p2.y)
+    let bx := 3.0 * (p0.x - 2.0 * p1.x + p2.x)
+    let by_ := 3.0 * (p0.y - 2.0 * p1.y + p2.y)
+    let cx := 3.0 * (p1.x - p0.x)
+    let cy := 3.0 * (p1.y - p0.y)
+    -- First, second and third forward differences at t = 0
+    let mut dx := ax * h3 + bx * h2 + cx * h
+    let mut dy := ay * h3 + by_ * h2 + cy * h
+    let mut ddx := 6.0 * ax * h3 + 2.0 * bx * h2
+    let mut ddy := 6.0 * ay * h3 + 2.0 * by_ * h2
+    let dddx := 6.0 * ax * h3
+    let dddy := 6.0 * ay * h3
+    let mut x := p0.x
+    let mut y := p0.y
+    for _ in [1:n] do
+      x := x + dx
+      y := y + dy
+      dx := dx + ddx
+      dy := dy + ddy
+      ddx := ddx + dddx
+      ddy := ddy + dddy
+      out := out.push ⟨x, y⟩
+  -- The end point is exact, not accumulated
+  return out.push p3
+
+/-- Flatten a quadratic Bezier curve to line segments (Wang's formula and
+    forward differencing, as `flattenCubicBezier`). -/
+def flattenQuadraticBezier (p0 cp p2 : Point) (tolerance : Float := 0.5) : Array Point := Id.run do
+  let n := quadraticSegmentCount p0 cp p2 tolerance
+  let mut out : Array Point := Array.mkEmpty n
+  if n > 1 then
+    let h := 1.0 / n.toFloat
+    let h2 := h * h
+    -- B(t) = a t² + b t + p0
+    let ax := p0.x - 2.0 * cp.x + p2.x
+    let ay := p0.y - 2.0 * cp.y + p2.y
+    let bx := 2.0 * (cp.x - p0.x)
+    let by_ := 2.0 * (cp.y - p0.y)
+    let mut dx := ax * h2 + bx * h
+    let mut dy := ay * h2 + by_ * h
+    let ddx := 2.0 * ax * h2
+    let ddy := 2.0 * ay * h2
+    let mut x := p0.x
+    let mut y := p0.y
+    for _ in [1:n] do
+      x := x + dx
+      y := y + dy
+      dx := dx + ddx
+      dy := dy + ddy
+      out := out.push ⟨x, y⟩
+  return out.push p2
+
+/-- Segments `flattenEllipseArc` uses for this arc and tolerance. A chord spanning h
+    radians of an ellipse whose larger semi-axis is R strays at most R(1 - cos(h/2))
+    from it, so n = ⌈|sweep| / 2acos(1 - tolerance/R)⌉, with R measured after the
+    transform. At least one segment per quarter turn, so a dot stays a diamond.
+    Clamped to [1, maxCurveSegments]. -/
+def ellipseArcSegmentCount (axisX axisY : Point) (sweep : Float) (tolerance : Float := 0.5) : Nat :=
+  let axes : Transform := { a := axisX.x, b := axisX.y, c := axisY.x, d := axisY.y, tx := 0, ty := 0 }
+  let radius := axes.maxScale
+  let quarters := Float.ceil (sweep.abs / (3.14159265358979323846 / 2.0))
+  -- Below half the tolerance a single chord per quarter is already within it
+  let chords :=
+    if radius > tolerance / 2.0 then
+      Float.ceil (sweep.abs / (2.0 * Float.acos (1.0 - tolerance / radius)))
+    else 0.0
+  let n := (max quarters chords).toUInt32.toNat
+  if n < 1 then 1 else if n > maxCurveSegments then maxCurveSegments else n
+
+/-- Flatten an elliptical arc (`PathCommand.ellipseArc`) straight to points on the
+    ellipse, evenly spaced in angle, without going through cubics. An arc ending
+    within a millionth of `tolerance` of `closeTo` (its subpath's start) ends
+    exactly on it, so a closed circle repeats its first point exactly.
+    Returns array of points (excluding start point, which caller already has). -/
+def flattenEllipseArc (center axisX axisY : Point) (startAngle sweep : Float) (closeTo : Point)
+    (tolerance : Float := 0.5) : Array Point := Id.run do
+  let n := ellipseArcSegmentCount axisX axisY sweep tolerance
+  let mut out : Array Point := Array.mkEmpty n
+  for i in [1:n + 1] do
+    let angle := startAngle + sweep * i.toFloat / n.toFloat
+    out := out.push (Path.ellipsePoint center axisX axisY angle)
+  let last := out[n - 1]!
+  let snap := tolerance * 1e-6
+  if (last.x - closeTo.x).abs <= snap && (last.y - closeTo.y).abs <= snap then
+    out := out.set! (n - 1) closeTo
+  return out
+
+/-- Flatten a path into polygon vertices, the exclusive end index of each
+    subpath (contour) in them, and whether the path is closed. -/
+private def flattenPath (path : Path) (tolerance : Float) : Array Point × Array UInt32 × Bool := Id.run do
   -- Estimate capacity: typically 2-4 points per command on average
   let mut points : Array Point := Array.mkEmpty (path.commands.size * 4)
+  let mut contourEnds : Array UInt32 := #[]
+  let mut contourStart := 0
   let mut current := Point.zero
   let mut subpathStart := Point.zero
   let mut isClosed := false
 
   for cmd in path.commands do
+    -- moveTo and rect begin a new contour
+    match cmd with
+    | .moveTo _ | .rect _ =>
+      if points.size > contourStart then
+        contourEnds := contourEnds.push points.size.toUInt32
+        contourStart := points.size
+    | _ => pure ()
     match cmd with
     | .moveTo p =>
       current := p
@@ -103,13 +205,16 @@ def pathToPolygonWithClosed (path : Path) (tolerance : Float := 0.5) : Array Poi
       isClosed := true
       current := subpathStart
     | .arc center radius startAngle endAngle counterclockwise =>
-      -- Convert arc to bezier segments
-      let beziers := Path.arcToBeziers center radius startAngle endAngle counterclockwise
-      for (cp1, cp2, endPt) in beziers do
-        let flat := flattenCubicBezier current cp1 cp2 endPt tolerance
-        for pt in flat do
-          points := points.push pt
-        current := endPt
+      let sweep := Path.arcSweep startAngle endAngle counterclockwise
+      let flat := flattenEllipseArc center ⟨radius, 0⟩ ⟨0, radius⟩ startAngle sweep subpathStart tolerance
+      for pt in flat do
+        points := points.push pt
+      current := flat.back!
+    | .ellipseArc center axisX axisY startAngle sweep =>
+      let flat := flattenEllipseArc center axisX axisY startAngle sweep subpathStart tolerance
+      for pt in flat do
+        points := points.push pt
+      current := flat.back!
     | .arcTo p1 p2 _radius =>
       -- arcTo draws a line to p1, then an arc tangent to both lines
       -- For now, approximate with line to p2 (full implementation is complex)
@@ -117,7 +222,21 @@ def pathToPolygonWithClosed (path : Path) (tolerance : Float := 0.5) : Array Poi
       points := points.push p2
       current := p2
 
-  return (points, isClosed)
+  if points.size > contourStart then
+    contourEnds := contourEnds.push points.size.toUInt32
+  return (points, contourEnds, isClosed)
+
+/-- Convert a path to an array of polygon vertices (flatten all curves).
+    Also returns whether the path is closed (ends with closePath or first/last points match). -/
+def pathToPolygonWithClosed (path : Path) (tolerance : Float := 0.5) : Array Point × Bool :=
+  let (points, _, isClosed) := flattenPath path tolerance
+  (points, isClosed)
+
+/-- Flatten a path into one point array plus the exclusive end index of each
+    contour (subpath) in it, as the polygon triangulator takes them. -/
+def pathToContours (path : Path) (tolerance : Float := 0.5) : Array Point × Array UInt32 :=
+  let (points, contourEnds, _) := flattenPath path tolerance
+  (points, contourEnds)
 
 /-- Convert a path to an array of polygon vertices (flatten all curves). -/
 def pathToPolygon (path : Path) (tolerance : Float := 0.5) : Array Point :=
@@ -143,12 +262,11 @@ def tessellateRect (r : Rect) (color : Color) : TessellationResult :=
   let br := r.bottomRight
 
   -- 4 vertices, 6 floats each (x, y, r, g, b, a)
-  let vertices := #[
-    tl.x, tl.y, color.r, color.g, color.b, color.a,  -- 0: top-left
-    tr.x, tr.y, color.r, color.g, color.b, color.a,  -- 1: top-right
-    br.x, br.y, color.r, color.g, color.b, color.a,  -- 2: bottom-right
-    bl.x, bl.y, color.r, color.g, color.b, color.a   -- 3: bottom-left
-  ]
+  let vertices := FloatArray.emptyWithCapacity 24
+    |>.push tl.x |>.push tl.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a  -- 0: top-left
+    |>.push tr.x |>.push tr.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a  -- 1: top-right
+    |>.push br.x |>.push br.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a  -- 2: bottom-right
+    |>.push bl.x |>.push bl.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a  -- 3: bottom-left
 
   { vertices, indices := rectIndices }
 
@@ -157,10 +275,10 @@ def tessellateConvexPath (path : Path) (color : Color) (tolerance : Float := 0.5
   let points := pathToPolygon path tolerance
 
   if points.size < 3 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- Build vertex array (6 floats per vertex: x, y, r, g, b, a)
-  let mut vertices : Array Float := Array.mkEmpty (points.size * 6)
+  let mut vertices : FloatArray := FloatArray.emptyWithCapacity (points.size * 6)
   for p in points do
     vertices := vertices.push p.x
     vertices := vertices.push p.y
@@ -187,12 +305,11 @@ def tessellateRectNDC (r : Rect) (color : Color) (screenWidth screenHeight : Flo
   let bl := toNDC r.bottomLeft
   let br := toNDC r.bottomRight
 
-  let vertices := #[
-    tl.x, tl.y, color.r, color.g, color.b, color.a,
-    tr.x, tr.y, color.r, color.g, color.b, color.a,
-    br.x, br.y, color.r, color.g, color.b, color.a,
-    bl.x, bl.y, color.r, color.g, color.b, color.a
-  ]
+  let vertices := FloatArray.emptyWithCapacity 24
+    |>.push tl.x |>.push tl.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a
+    |>.push tr.x |>.push tr.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a
+    |>.push br.x |>.push br.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a
+    |>.push bl.x |>.push bl.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a
 
   { vertices, indices := rectIndices }
 
@@ -202,10 +319,10 @@ def tessellateConvexPathNDC (path : Path) (color : Color)
   let points := pathToPolygon path tolerance
 
   if points.size < 3 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- Pre-allocate vertex array (6 floats per vertex: x, y, r, g, b, a)
-  let mut vertices : Array Float := Array.mkEmpty (points.size * 6)
+  let mut vertices : FloatArray := FloatArray.emptyWithCapacity (points.size * 6)
   for p in points do
     let ndc := pixelToNDC p.x p.y screenWidth screenHeight
     vertices := vertices.push ndc.x
@@ -253,33 +370,41 @@ def interpolateGradientStops (stops : Array GradientStop) (t : Float) : Color :=
   let localT := (t - prevStop.position) / (nextStop.position - prevStop.position)
   Color.lerp prevStop.color nextStop.color localT
 
-/-- Sample a linear gradient at a given point.
-    Projects the point onto the gradient line and returns the interpolated color. -/
-def sampleLinearGradient (start finish : Point) (stops : Array GradientStop) (p : Point) : Color :=
+/-- Position of a point along a linear gradient, unclamped: 0 at `start`, 1 at
+    `finish`. `none` for a degenerate gradient (start == finish). -/
+def linearGradientPosition (start finish : Point) (p : Point) : Option Float :=
   -- Vector from start to finish
   let dx := finish.x - start.x
   let dy := finish.y - start.y
   let lenSq := dx * dx + dy * dy
 
-  if lenSq < 0.0001 then
-    -- Degenerate gradient (start == finish)
-    if stops.size > 0 then stops[0]!.color else Color.black
+  if lenSq < 0.0001 then none
   else
     -- Project point onto gradient line
     let px := p.x - start.x
     let py := p.y - start.y
-    let t := (px * dx + py * dy) / lenSq
-    interpolateGradientStops stops t
+    some ((px * dx + py * dy) / lenSq)
+
+/-- Position of a point in a radial gradient, unclamped: its distance from the
+    center in radii. `none` for a degenerate (zero) radius. -/
+def radialGradientPosition (center : Point) (radius : Float) (p : Point) : Option Float :=
+  if radius < 0.0001 then none
+  else some (Point.distance center p / radius)
+
+/-- Sample a linear gradient at a given point.
+    Projects the point onto the gradient line and returns the interpolated color. -/
+def sampleLinearGradient (start finish : Point) (stops : Array GradientStop) (p : Point) : Color :=
+  match linearGradientPosition start finish p with
+  | some t => interpolateGradientStops stops t
+  -- Degenerate gradient (start == finish)
+  | none => if stops.size > 0 then stops[0]!.color else Color.black
 
 /-- Sample a radial gradient at a given point.
     Uses distance from center to determine color. -/
 def sampleRadialGradient (center : Point) (radius : Float) (stops : Array GradientStop) (p : Point) : Color :=
-  if radius < 0.0001 then
-    if stops.size > 0 then stops[0]!.color else Color.black
-  else
-    let dist := Point.distance center p
-    let t := dist / radius
-    interpolateGradientStops stops t
+  match radialGradientPosition center radius p with
+  | some t => interpolateGradientStops stops t
+  | none => if stops.size > 0 then stops[0]!.color else Color.black
 
 /-- Sample any gradient type at a given point. -/
 def sampleGradient (g : Gradient) (p : Point) : Color :=
@@ -299,10 +424,10 @@ def tessellateConvexPathFillNDC (path : Path) (style : FillStyle)
   let points := pathToPolygon path tolerance
 
   if points.size < 3 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- Pre-allocate vertex array (6 floats per vertex: x, y, r, g, b, a)
-  let mut vertices : Array Float := Array.mkEmpty (points.size * 6)
+  let mut vertices : FloatArray := FloatArray.emptyWithCapacity (points.size * 6)
   for p in points do
     let color := sampleFillStyle style p
     let ndc := pixelToNDC p.x p.y screenWidth screenHeight
@@ -326,21 +451,17 @@ private def computeCentroid (points : Array Point) : Point := Id.run do
     sumY := sumY + p.y
   { x := sumX / points.size.toFloat, y := sumY / points.size.toFloat }
 
-/-- Tessellate a convex path with separate original/transformed paths for correct gradient sampling.
-    - originalPath: used for gradient color sampling (in original coordinate space)
-    - transformedPath: used for vertex positions (after transform applied)
-    This is needed because gradients are defined in original space but shapes are transformed.
-    For radial gradients, adds a center vertex to ensure proper color interpolation from center to edge. -/
-def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path) (style : FillStyle)
-    (screenWidth screenHeight : Float) (tolerance : Float := 0.5) : TessellationResult := Id.run do
-  let originalPoints := pathToPolygon originalPath tolerance
-  let transformedPoints := pathToPolygon transformedPath tolerance
-
+/-- `tessellateConvexPathFillNDCWithOriginal` on already flattened points: positions from
+    `transformedPoints`, gradient colors sampled at `originalPoints` by `colorAt`
+    (`sampleFillStyle style` unless a caller has a faster sampler for the style). -/
+def tessellateConvexPointsFillNDC (originalPoints transformedPoints : Array Point) (style : FillStyle)
+    (screenWidth screenHeight : Float) (colorAt : Point → Color := sampleFillStyle style) :
+    TessellationResult := Id.run do
   -- Both paths should produce same number of points (same topology, different positions)
   let numPoints := min originalPoints.size transformedPoints.size
 
   if numPoints < 3 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- Check if this is a radial gradient - if so, we need a center vertex for proper interpolation
   let isRadialGradient := match style with
@@ -352,11 +473,11 @@ def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path
     -- This ensures the gradient interpolates properly from center (t=0) to edge (t=1)
     let originalCenter := computeCentroid originalPoints
     let transformedCenter := computeCentroid transformedPoints
-    let centerColor := sampleFillStyle style originalCenter
+    let centerColor := colorAt originalCenter
     let centerNDC := pixelToNDC transformedCenter.x transformedCenter.y screenWidth screenHeight
 
     -- Vertex 0 is center, vertices 1..n are perimeter
-    let mut vertices : Array Float := Array.mkEmpty ((numPoints + 1) * 6)
+    let mut vertices : FloatArray := FloatArray.emptyWithCapacity ((numPoints + 1) * 6)
 
     -- Add center vertex first
     vertices := vertices.push centerNDC.x
@@ -369,7 +490,7 @@ def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path
     -- Add perimeter vertices
     for i in [:numPoints] do
       if h : i < originalPoints.size ∧ i < transformedPoints.size then
-        let color := sampleFillStyle style originalPoints[i]
+        let color := colorAt originalPoints[i]
         let ndc := pixelToNDC transformedPoints[i].x transformedPoints[i].y screenWidth screenHeight
         vertices := vertices.push ndc.x
         vertices := vertices.push ndc.y
@@ -390,10 +511,10 @@ def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path
     return { vertices, indices }
   else
     -- For solid colors and linear gradients: use standard fan triangulation
-    let mut vertices : Array Float := Array.mkEmpty (numPoints * 6)
+    let mut vertices : FloatArray := FloatArray.emptyWithCapacity (numPoints * 6)
     for i in [:numPoints] do
       if h : i < originalPoints.size ∧ i < transformedPoints.size then
-        let color := sampleFillStyle style originalPoints[i]
+        let color := colorAt originalPoints[i]
         let ndc := pixelToNDC transformedPoints[i].x transformedPoints[i].y screenWidth screenHeight
         vertices := vertices.push ndc.x
         vertices := vertices.push ndc.y
@@ -405,6 +526,16 @@ def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path
     let indices := triangulateConvexFan numPoints
     return { vertices, indices }
 
+/-- Tessellate a convex path with separate original/transformed paths for correct gradient sampling.
+    - originalPath: used for gradient color sampling (in original coordinate space)
+    - transformedPath: used for vertex positions (after transform applied)
+    This is needed because gradients are defined in original space but shapes are transformed.
+    For radial gradients, adds a center vertex to ensure proper color interpolation from center to edge. -/
+def tessellateConvexPathFillNDCWithOriginal (originalPath transformedPath : Path) (style : FillStyle)
+    (screenWidth screenHeight : Float) (tolerance : Float := 0.5) : TessellationResult :=
+  tessellateConvexPointsFillNDC (pathToPolygon originalPath tolerance)
+    (pathToPolygon transformedPath tolerance) style screenWidth screenHeight
+
 /-- Tessellate a rectangle with a fill style (solid or gradient), converting to NDC. -/
 def tessellateRectFillNDC (r : Rect) (style : FillStyle) (screenWidth screenHeight : Float) : TessellationResult :=
   let tl := r.topLeft
@@ -424,12 +555,11 @@ def tessellateRectFillNDC (r : Rect) (style : FillStyle) (screenWidth screenHeig
   let blNDC := toNDC bl
   let brNDC := toNDC br
 
-  let vertices := #[
-    tlNDC.x, tlNDC.y, tlColor.r, tlColor.g, tlColor.b, tlColor.a,
-    trNDC.x, trNDC.y, trColor.r, trColor.g, trColor.b, trColor.a,
-    brNDC.x, brNDC.y, brColor.r, brColor.g, brColor.b, brColor.a,
-    blNDC.x, blNDC.y, blColor.r, blColor.g, blColor.b, blColor.a
-  ]
+  let vertices := FloatArray.emptyWithCapacity 24
+    |>.push tlNDC.x |>.push tlNDC.y |>.push tlColor.r |>.push tlColor.g |>.push tlColor.b |>.push tlColor.a
+    |>.push trNDC.x |>.push trNDC.y |>.push trColor.r |>.push trColor.g |>.push trColor.b |>.push trColor.a
+    |>.push brNDC.x |>.push brNDC.y |>.push brColor.r |>.push brColor.g |>.push brColor.b |>.push brColor.a
+    |>.push blNDC.x |>.push blNDC.y |>.push blColor.r |>.push blColor.g |>.push blColor.b |>.push blColor.a
 
   { vertices, indices := rectIndices }
 
@@ -461,12 +591,11 @@ def tessellateTransformedRectNDC
   let blNDC := toNDC bl
   let brNDC := toNDC br
 
-  let vertices := #[
-    tlNDC.x, tlNDC.y, tlColor.r, tlColor.g, tlColor.b, tlColor.a,
-    trNDC.x, trNDC.y, trColor.r, trColor.g, trColor.b, trColor.a,
-    brNDC.x, brNDC.y, brColor.r, brColor.g, brColor.b, brColor.a,
-    blNDC.x, blNDC.y, blColor.r, blColor.g, blColor.b, blColor.a
-  ]
+  let vertices := FloatArray.emptyWithCapacity 24
+    |>.push tlNDC.x |>.push tlNDC.y |>.push tlColor.r |>.push tlColor.g |>.push tlColor.b |>.push tlColor.a
+    |>.push trNDC.x |>.push trNDC.y |>.push trColor.r |>.push trColor.g |>.push trColor.b |>.push trColor.a
+    |>.push brNDC.x |>.push brNDC.y |>.push brColor.r |>.push brColor.g |>.push brColor.b |>.push brColor.a
+    |>.push blNDC.x |>.push blNDC.y |>.push blColor.r |>.push blColor.g |>.push blColor.b |>.push blColor.a
 
   { vertices, indices := rectIndices }
 
@@ -615,11 +744,11 @@ def expandPolylineToStroke (points : Array Point) (halfWidth : Float)
 def strokeEdgesToTriangles (leftPoints rightPoints : Array Point) (color : Color)
     : TessellationResult := Id.run do
   if leftPoints.size < 2 || rightPoints.size < 2 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   let numPairs := min leftPoints.size rightPoints.size
   -- Pre-allocate: 2 vertices per pair, 6 floats per vertex
-  let mut vertices : Array Float := Array.mkEmpty (numPairs * 2 * 6)
+  let mut vertices : FloatArray := FloatArray.emptyWithCapacity (numPairs * 2 * 6)
   -- Pre-allocate: 2 triangles per segment, 3 indices per triangle
   let mut indices : Array UInt32 := Array.mkEmpty ((numPairs - 1) * 6)
 
@@ -665,7 +794,7 @@ def tessellateStroke (path : Path) (style : StrokeStyle) (tolerance : Float := 0
   let (points, isClosed) := pathToPolygonWithClosed path tolerance
 
   if points.size < 2 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- For closed paths, add the first point at the end to close the loop
   let points := if isClosed && points.size > 0 then
@@ -679,14 +808,186 @@ def tessellateStroke (path : Path) (style : StrokeStyle) (tolerance : Float := 0
 
   return strokeEdgesToTriangles leftPoints rightPoints style.color
 
-/-- Tessellate a path as a stroke with NDC conversion. -/
+/-! ## Fringe Anti-aliasing
+
+Smooth edges without MSAA. The shape is inset by half a pixel and ringed by a
+fringe one pixel wide whose outer vertices have zero alpha, so interpolation
+across the fringe ramps coverage from the shape's alpha to nothing. Widths are
+screen pixels, so fringes are built on the transformed (pixel-space) outline. -/
+
+/-- Width of the alpha ramp along antialiased edges, in screen pixels. -/
+def fringeWidth : Float := 1.0
+
+/-- Append one vertex at pixel position `p`, converted to NDC. -/
+@[inline] def pushVertexNDC (vertices : FloatArray) (p : Point) (color : Color)
+    (screenWidth screenHeight : Float) : FloatArray :=
+  let ndc := pixelToNDC p.x p.y screenWidth screenHeight
+  vertices.push ndc.x |>.push ndc.y |>.push color.r |>.push color.g |>.push color.b |>.push color.a
+
+/-- Two triangles joining the inner edge `i0`-`i1` to the outer edge `o0`-`o1`. -/
+@[inline] def pushFringeQuad (indices : Array UInt32) (i0 o0 i1 o1 : UInt32) : Array UInt32 :=
+  indices.push i0 |>.push o0 |>.push o1 |>.push i0 |>.push o1 |>.push i1
+
+/-- Winding number of the closed contours around `p`. -/
+private def windingNumber (points : Array Point) (contourEnds : Array UInt32) (p : Point) : Int := Id.run do
+  let mut wn : Int := 0
+  let mut start := 0
+  for e in contourEnds do
+    let stop := e.toNat
+    for i in [start:stop] do
+      let a := points[i]!
+      let b := points[if i + 1 < stop then i + 1 else start]!
+      let cross := (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y)
+      if a.y <= p.y && p.y < b.y && cross > 0 then wn := wn + 1
+      else if b.y <= p.y && p.y < a.y && cross < 0 then wn := wn - 1
+    start := stop
+  return wn
+
+/-- Per-point offsets of half a fringe, pointing away from the region `fillRule`
+    fills: `p - offset` bounds the opaque core and `p + offset` is the transparent
+    edge of the fringe. Each contour's outward side is found by probing beside its
+    longest edge, so holes fringe into the hole under either fill rule. Zero-length
+    edges take their neighbour's normal, and corners are mitered so both edges
+    move by exactly half a fringe, with the miter capped at ten times that.
+    Contours of fewer than three points get zero offsets. -/
+def fringeOffsets (points : Array Point) (contourEnds : Array UInt32) (fillRule : FillRule) :
+    Array Point := Id.run do
+  let half := fringeWidth / 2.0
+  let mut offsets : Array Point := Array.replicate points.size ⟨0, 0⟩
+  let mut start := 0
+  for e in contourEnds do
+    let stop := e.toNat
+    let n := stop - start
+    if n >= 3 then
+      -- Unit normal to the right of each edge; none for zero-length edges
+      let mut normals : Array (Option Point) := Array.mkEmpty n
+      let mut longest := 0
+      let mut longestLen := 0.0
+      for k in [:n] do
+        let a := points[start + k]!
+        let b := points[start + (k + 1) % n]!
+        let dx := b.x - a.x
+        let dy := b.y - a.y
+        let len := Float.sqrt (dx * dx + dy * dy)
+        if len > 1e-9 then
+          normals := normals.push (some ⟨dy / len, -dx / len⟩)
+          if len > longestLen then
+            longest := k
+            longestLen := len
+        else
+          normals := normals.push none
+      if longestLen > 0 then
+        -- The nearest real edge normal before and after each edge
+        let nm := normals[longest]!.getD ⟨0, 0⟩
+        let mut before : Array Point := Array.replicate n nm
+        let mut after : Array Point := Array.replicate n nm
+        let mut prev := nm
+        let mut next := nm
+        for j in [:n] do
+          let k := (longest + j) % n
+          if let some e := normals[k]! then prev := e
+          before := before.set! k prev
+          let k' := (longest + n - j) % n
+          if let some e := normals[k']! then next := e
+          after := after.set! k' next
+        -- Outward is the side of the longest edge that is not filled
+        let a := points[start + longest]!
+        let b := points[start + (longest + 1) % n]!
+        let eps := longestLen * 1e-4
+        let probe : Point := ⟨(a.x + b.x) / 2 + nm.x * eps, (a.y + b.y) / 2 + nm.y * eps⟩
+        let wn := windingNumber points contourEnds probe
+        let filled := match fillRule with
+          | .nonZero => wn != 0
+          | .evenOdd => wn % 2 != 0
+        let sign := if filled then -half else half
+        for k in [:n] do
+          let n0 := before[(k + n - 1) % n]!
+          let n1 := after[k]!
+          let mx := (n0.x + n1.x) / 2
+          let my := (n0.y + n1.y) / 2
+          let d2 := mx * mx + my * my
+          -- Scale the averaged normal by 1/cos² of the half angle (a miter), capped
+          let s := if d2 > 1e-6 then min (1.0 / d2) 100.0 else 0.0
+          let (ox, oy) := if d2 > 1e-6 then (mx * s, my * s) else (n1.x, n1.y)
+          offsets := offsets.set! (start + k) ⟨ox * sign, oy * sign⟩
+    start := stop
+  return offsets
+
+/-- Move the first and last points of an open polyline `d` pixels outward along
+    their segments (inward for negative `d`). Inward moves are skipped for end
+    segments no longer than `2 * |d|`, so short strokes keep their direction. -/
+private def extendEnds (points : Array Point) (d : Float) : Array Point := Id.run do
+  let n := points.size
+  if n < 2 then return points
+  let move (p q : Point) : Point :=
+    let dx := p.x - q.x
+    let dy := p.y - q.y
+    let len := Float.sqrt (dx * dx + dy * dy)
+    if len < 1e-9 || (d < 0 && len <= 2 * d.abs) then p
+    else ⟨p.x + dx / len * d, p.y + dy / len * d⟩
+  let first := move points[0]! points[1]!
+  let last := move points[n - 1]! points[n - 2]!
+  return (points.set! 0 first).set! (n - 1) last
+
+/-- Stroke a flattened pixel-space polyline with a fringe on both sides and, for
+    open polylines, across both ends. The core is stroked `fringeWidth` narrower
+    and the transparent outline `fringeWidth` wider; both come from the same
+    expansion so their edge points pair up. Strokes thinner than a fringe keep a
+    zero-width core and scale alpha down to keep their total coverage. -/
+private def strokeFringeNDC (points : Array Point) (isClosed : Bool) (style : StrokeStyle)
+    (screenWidth screenHeight : Float) : TessellationResult := Id.run do
+  let half := fringeWidth / 2.0
+  let halfWidth := style.lineWidth / 2.0
+  let coreHalf := max (halfWidth - half) 0.0
+  let outerHalf := halfWidth + half
+  let color := style.color
+  let color :=
+    if style.lineWidth < fringeWidth then { color with a := color.a * style.lineWidth / outerHalf }
+    else color
+  -- Butt (and simplified round) caps need the fringe added at the ends; square
+  -- caps already extend by the core and outer half widths
+  let extend := !isClosed && style.lineCap != .square
+  let corePoints := if extend then extendEnds points (-half) else points
+  let outerPoints := if extend then extendEnds points half else points
+  let (coreLeft, coreRight) := expandPolylineToStroke corePoints coreHalf
+    style.lineCap style.lineJoin style.miterLimit
+  let (outerLeft, outerRight) := expandPolylineToStroke outerPoints outerHalf
+    style.lineCap style.lineJoin style.miterLimit
+  let toNDC := fun (p : Point) => pixelToNDC p.x p.y screenWidth screenHeight
+  let core := strokeEdgesToTriangles (coreLeft.map toNDC) (coreRight.map toNDC) color
+  if core.vertices.size == 0 then return core
+  let m := min coreLeft.size coreRight.size
+  let transparent := { color with a := 0.0 }
+  let mut vertices := core.vertices
+  for i in [:m] do
+    vertices := pushVertexNDC vertices outerLeft[i]! transparent screenWidth screenHeight
+    vertices := pushVertexNDC vertices outerRight[i]! transparent screenWidth screenHeight
+  -- A zero-width core has no area of its own, only the fringes
+  let mut indices := if coreHalf > 0 then core.indices else Array.mkEmpty (m * 12 + 12)
+  -- Core vertices are L0, R0, L1, R1, ...; outer ones follow in the same order
+  let outer := (2 * m).toUInt32
+  for i in [:m - 1] do
+    let l := (2 * i).toUInt32
+    let r := l + 1
+    indices := pushFringeQuad indices l (outer + l) (l + 2) (outer + l + 2)
+    indices := pushFringeQuad indices r (outer + r) (r + 2) (outer + r + 2)
+  if !isClosed then
+    let last := (2 * (m - 1)).toUInt32
+    indices := pushFringeQuad indices 0 outer 1 (outer + 1)
+    indices := pushFringeQuad indices last (outer + last) (last + 1) (outer + last + 1)
+  return { vertices, indices }
+
+/-! ## Stroked Paths -/
+
+/-- Tessellate a path as a stroke with NDC conversion. With `antialias`, edges get
+    a `fringeWidth` alpha ramp instead of relying on MSAA. -/
 def tessellateStrokeNDC (path : Path) (style : StrokeStyle)
-    (screenWidth screenHeight : Float) (tolerance : Float := 0.5)
+    (screenWidth screenHeight : Float) (tolerance : Float := 0.5) (antialias : Bool := false)
     : TessellationResult := Id.run do
   let (points, isClosed) := pathToPolygonWithClosed path tolerance
 
   if points.size < 2 then
-    return { vertices := #[], indices := #[] }
+    return { vertices := .empty, indices := #[] }
 
   -- For closed paths, add the first point at the end to close the loop
   let points := if isClosed && points.size > 0 then
@@ -694,6 +995,9 @@ def tessellateStrokeNDC (path : Path) (style : StrokeStyle)
   else
     points
 
+  if antialias then
+    return strokeFringeNDC points isClosed style screenWidth screenHeight
+
   let halfWidth := style.lineWidth / 2.0
   let (leftPoints, rightPoints) := expandPolylineToStroke points halfWidth
     style.lineCap style.lineJoin style.miterLimit
@@ -721,43 +1025,112 @@ end Tessellation
 
 /-! ## Batch Accumulation -/
 
+/-- Width of a batch's indices (AfferentIndexFormat in afferent.h). -/
+inductive IndexFormat where
+  | u16
+  | u32
+  deriving Repr, BEq, Inhabited
+
+namespace IndexFormat
+
+def bytesPerIndex : IndexFormat → Nat
+  | .u16 => 2
+  | .u32 => 4
+
+/-- Most vertices addressable with 16-bit indices. -/
+def u16MaxVertices : Nat := 65536
+
+/-- Append a little-endian index. -/
+@[inline] def push (format : IndexFormat) (b : ByteArray) (i : UInt32) : ByteArray :=
+  match format with
+  | .u16 => b.push i.toUInt8 |>.push (i >>> 8).toUInt8
+  | .u32 => b.push i.toUInt8 |>.push (i >>> 8).toUInt8 |>.push (i >>> 16).toUInt8 |>.push (i >>> 24).toUInt8
+
+/-- Read the `n`th little-endian index. -/
+@[inline] def get (format : IndexFormat) (b : ByteArray) (n : Nat) : UInt32 :=
+  match format with
+  | .u16 =>
+    let o := n * 2
+    b[o]!.toUInt32 ||| (b[o + 1]!.toUInt32 <<< 8)
+  | .u32 =>
+    let o := n * 4
+    b[o]!.toUInt32 ||| (b[o + 1]!.toUInt32 <<< 8) ||| (b[o + 2]!.toUInt32 <<< 16) ||| (b[o + 3]!.toUInt32 <<< 24)
+
+end IndexFormat
+
 /-- Accumulates tessellated geometry for a single draw call.
-    Use this to batch many shapes into one draw call for better performance. -/
+    Use this to batch many shapes into one draw call for better performance.
+    Indices are stored packed, ready to upload as-is: 16-bit until the batch
+    grows past 65536 vertices, then widened once to 32-bit. -/
 structure Batch where
   /-- Accumulated vertex data (6 floats per vertex: x, y, r, g, b, a). -/
-  vertices : Array Float
-  /-- Accumulated triangle indices. -/
-  indices : Array UInt32
+  vertices : FloatArray
+  /-- Accumulated triangle indices, little-endian, `indexFormat.bytesPerIndex` bytes each. -/
+  indexData : ByteArray
+  indexFormat : IndexFormat
   /-- Current vertex count (vertices.size / 6), used for index remapping. -/
   vertexCount : Nat
 deriving Inhabited
 
 namespace Batch
 
+/-- Append `src` onto `dst` in place (FloatArray has no `++`). -/
+private def appendFloats (dst src : FloatArray) : FloatArray := Id.run do
+  let mut out := dst
+  for x in src do
+    out := out.push x
+  return out
+
 /-- Create an empty batch. -/
-def empty : Batch := { vertices := #[], indices := #[], vertexCount := 0 }
+def empty : Batch := { vertices := .empty, indexData := .empty, indexFormat := .u16, vertexCount := 0 }
 
 /-- Create a batch with pre-allocated capacity for estimated shape count.
     Assumes ~30 floats and ~10 indices per shape on average. -/
 def withCapacity (shapeCount : Nat) : Batch :=
-  { vertices := Array.mkEmpty (shapeCount * 30)
-    indices := Array.mkEmpty (shapeCount * 10)
+  { vertices := FloatArray.emptyWithCapacity (shapeCount * 30)
+    indexData := ByteArray.emptyWithCapacity (shapeCount * 20)
+    indexFormat := .u16
     vertexCount := 0 }
 
+/-- Get the number of indices (for draw call). -/
+def indexCount (batch : Batch) : Nat := batch.indexData.size / batch.indexFormat.bytesPerIndex
+
+/-- The `n`th index. -/
+def indexAt (batch : Batch) (n : Nat) : UInt32 := batch.indexFormat.get batch.indexData n
+
+/-- Decode the indices (for inspection; uploads use `indexData` directly). -/
+def indices (batch : Batch) : Array UInt32 := Id.run do
+  let mut out := Array.mkEmpty batch.indexCount
+  for n in [:batch.indexCount] do
+    out := out.push (batch.indexAt n)
+  return out
+
+/-- Make room for `vertexCount` vertices in total, re-encoding the indices
+    as 32-bit the first time the batch outgrows 16-bit indices. -/
+def reserveVertices (batch : Batch) (vertexCount : Nat) : Batch :=
+  if batch.indexFormat == .u16 && vertexCount > IndexFormat.u16MaxVertices then Id.run do
+    let mut data := ByteArray.emptyWithCapacity (batch.indexData.size * 2)
+    for n in [:batch.indexCount] do
+      data := IndexFormat.u32.push data (batch.indexAt n)
+    { batch with indexData := data, indexFormat := .u32 }
+  else batch
+
 /-- Add a tessellation result to the batch.
     Indices are automatically remapped to account for existing vertices.
     Uses in-place push loop to avoid intermediate array allocation from .map -/
 def add (batch : Batch) (result : TessellationResult) : Batch :=
   if result.vertices.size == 0 then batch
   else Id.run do
+    let vertexCount := batch.vertexCount + result.vertices.size / 6
+    let batch := batch.reserveVertices vertexCount
     let offset := batch.vertexCount.toUInt32
+    let format := batch.indexFormat
     -- Push indices one by one with offset applied inline (no intermediate array)
-    let mut indices := batch.indices
+    let mut indexData := batch.indexData
     for idx in result.indices do
-      indices := indices.push (idx + offset)
-    { vertices := batch.vertices ++ result.vertices
-      indices := indices
-      vertexCount := batch.vertexCount + result.vertices.size / 6 }
+      indexData := format.push indexData (idx + offset)
+    { vertices := appendFloats batch.vertices result.vertices
+      indexData, indexFormat := format, vertexCount }
 
 /-- Combine two batches.
     Uses in-place push loop to avoid intermediate array allocation from .map -/
@@ -765,14 +1138,21 @@ def append (b1 b2 : Batch) : Batch :=
   if b2.vertices.size == 0 then b1
   else if b1.vertices.size == 0 then b2
   else Id.run do
+    let vertexCount := b1.vertexCount + b2.vertexCount
+    let b1 := b1.reserveVertices vertexCount
     let offset := b1.vertexCount.toUInt32
+    let format := b1.indexFormat
     -- Push indices one by one with offset applied inline (no intermediate array)
-    let mut indices := b1.indices
-    for idx in b2.indices do
-      indices := indices.push (idx + offset)
-    { vertices := b1.vertices ++ b2.vertices
-      indices := indices
-      vertexCount := b1.vertexCount + b2.vertexCount }
+    let mut indexData := b1.indexData
+    for n in [:b2.indexCount] do
+      indexData := format.push indexData (b2.indexAt n + offset)
+    { vertices := appendFloats b1.vertices b2.vertices
+      indexData, indexFormat := format, vertexCount }
+
+/-- Two triangles (0,1,2) and (0,2,3) of a quad starting at `baseIdx`. -/
+@[inline] private def pushQuadIndices (format : IndexFormat) (b : ByteArray) (baseIdx : UInt32) : ByteArray :=
+  let b := format.push (format.push (format.push b baseIdx) (baseIdx + 1)) (baseIdx + 2)
+  format.push (format.push (format.push b baseIdx) (baseIdx + 2)) (baseIdx + 3)
 
 /-- FAST PATH: Add a transformed rectangle directly to the batch.
     No intermediate TessellationResult allocation - writes directly to batch arrays.
@@ -801,6 +1181,7 @@ def addTransformedRect (batch : Batch) (rect : Rect) (transform : Transform)
   let brNDC := Tessellation.pixelToNDC br.x br.y screenWidth screenHeight
 
   -- Current vertex index for this rect
+  let batch := batch.reserveVertices (batch.vertexCount + 4)
   let baseIdx := batch.vertexCount.toUInt32
 
   -- Push vertices directly (no intermediate array)
@@ -811,11 +1192,9 @@ def addTransformedRect (batch : Batch) (rect : Rect) (transform : Transform)
     |>.push blNDC.x |>.push blNDC.y |>.push blColor.r |>.push blColor.g |>.push blColor.b |>.push blColor.a
 
   -- Push indices directly (two triangles: 0,1,2 and 0,2,3 offset by baseIdx)
-  let indices := batch.indices
-    |>.push baseIdx |>.push (baseIdx + 1) |>.push (baseIdx + 2)
-    |>.push baseIdx |>.push (baseIdx + 2) |>.push (baseIdx + 3)
+  let indexData := pushQuadIndices batch.indexFormat batch.indexData baseIdx
 
-  { vertices, indices, vertexCount := batch.vertexCount + 4 }
+  { batch with vertices, indexData, vertexCount := batch.vertexCount + 4 }
 
 /-- FASTEST PATH: Add a rectangle with pre-computed position, rotation, size, and color.
     Computes transform inline - no Canvas state, no Transform struct allocation.
@@ -855,6 +1234,7 @@ def addRectDirect (batch : Batch) (x y angle halfSize : Float) (color : Color)
   let brNdcX := toNdcX brX; let brNdcY := toNdcY brY
   let blNdcX := toNdcX blX; let blNdcY := toNdcY blY
 
+  let batch := batch.reserveVertices (batch.vertexCount + 4)
   let baseIdx := batch.vertexCount.toUInt32
 
   let vertices := batch.vertices
@@ -863,18 +1243,13 @@ def addRectDirect (batch : Batch) (x y angle halfSize : Float) (color : Color)
     |>.push brNdcX |>.push brNdcY |>.push color.r |>.push color.g |>.push color.b |>.push color.a
     |>.push blNdcX |>.push blNdcY |>.push color.r |>.push color.g |>.push color.b |>.push color.a
 
-  let indices := batch.indices
-    |>.push baseIdx |>.push (baseIdx + 1) |>.push (baseIdx + 2)
-    |>.push baseIdx |>.push (baseIdx + 2) |>.push (baseIdx + 3)
+  let indexData := pushQuadIndices batch.indexFormat batch.indexData baseIdx
 
-  { vertices, indices, vertexCount := batch.vertexCount + 4 }
+  { batch with vertices, indexData, vertexCount := batch.vertexCount + 4 }
 
 /-- Check if the batch is empty. -/
 def isEmpty (batch : Batch) : Bool := batch.vertices.size == 0
 
-/-- Get the number of indices (for draw call). -/
-def indexCount (batch : Batch) : Nat := batch.indices.size
-
 /-- Get the number of vertices. -/
 def vertexCount' (batch : Batch) : Nat := batch.vertexCount
 
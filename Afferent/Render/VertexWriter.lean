@@ -0,0 +1,114 @@
+/-
+  Afferent Vertex Writer
+  Geometry builders that write straight into a native VertexWriter instead
+  of accumulating a Batch. Each emit is one FFI call that stores float32
+  vertices and packed indices in place; no Lean arrays are grown, copied
+  or narrowed on the way to the GPU.
+-/
+import Afferent.Render.Tessellation
+import Afferent.FFI.VertexWriter
+
+namespace Afferent
+
+/-- Builder monad over a native vertex writer. -/
+abbrev VertexWriterM := ReaderT FFI.VertexWriter IO
+
+namespace VertexWriterM
+
+/-- Run a builder against `writer`, appending to what it already holds. -/
+def run (m : VertexWriterM α) (writer : FFI.VertexWriter) : IO α := m writer
+
+/-- Start a shape: `emitIndexTri` indices count from the next vertex. -/
+@[inline] def beginShape : VertexWriterM Unit := fun w => w.beginShape
+
+/-- One vertex: NDC position and color. -/
+@[inline] def emitVertex (x y : Float) (color : Color) : VertexWriterM Unit := fun w =>
+  w.emitVertex x y color.r color.g color.b color.a
+
+/-- A solid-color quad, corners in order, as triangles (0,1,2) and (0,2,3). -/
+@[inline] def emitQuad (p0 p1 p2 p3 : Point) (color : Color) : VertexWriterM Unit := fun w =>
+  w.emitQuad p0.x p0.y p1.x p1.y p2.x p2.y p3.x p3.y color.r color.g color.b color.a
+
+/-- A triangle of vertices emitted since `beginShape`. -/
+@[inline] def emitIndexTri (a b c : UInt32) : VertexWriterM Unit := fun w =>
+  w.emitIndexTri a b c
+
+/-- A 4-float record (dynamic circles). -/
+@[inline] def emit4 (f0 f1 f2 f3 : Float) : VertexWriterM Unit := fun w => w.emit4 f0 f1 f2 f3
+
+/-- A 5-float record (dynamic rects and triangles). -/
+@[inline] def emit5 (f0 f1 f2 f3 f4 : Float) : VertexWriterM Unit := fun w => w.emit5 f0 f1 f2 f3 f4
+
+/-- Writer counterpart of `Batch.add`: the whole result in one call,
+    indices offset natively. -/
+def emitTessellation (result : TessellationResult) : VertexWriterM Unit := fun w =>
+  w.emitShape result.vertices result.indices
+
+/-- Writer counterpart of `Batch.addTransformedRect`. Gradients are sampled at
+    the untransformed corners, as in the batch path; a per-corner color needs
+    four vertices and two triangles rather than `emitQuad`. -/
+def emitTransformedRect (rect : Rect) (transform : Transform) (style : FillStyle)
+    (screenWidth screenHeight : Float) : VertexWriterM Unit := do
+  let ndc (p : Point) : Point :=
+    let q := transform.apply p
+    Tessellation.pixelToNDC q.x q.y screenWidth screenHeight
+  match style with
+  | .solid color =>
+    emitQuad (ndc rect.topLeft) (ndc rect.topRight) (ndc rect.bottomRight) (ndc rect.bottomLeft) color
+  | _ =>
+    beginShape
+    for corner in [rect.topLeft, rect.topRight, rect.bottomRight, rect.bottomLeft] do
+      let p := ndc corner
+      emitVertex p.x p.y (Tessellation.sampleFillStyle style corner)
+    emitIndexTri 0 1 2
+    emitIndexTri 0 2 3
+
+/-- Writer counterpart of `Batch.addRectDirect`: a rotated square centered
+    on (x, y), one `emitQuad` call. -/
+@[inline] def emitRectDirect (x y angle halfSize : Float) (color : Color)
+    (screenWidth screenHeight : Float) : VertexWriterM Unit :=
+  let cosA := Float.cos angle
+  let sinA := Float.sin angle
+  let h := halfSize
+  let toNdc (px py : Float) : Point :=
+    ⟨(px / screenWidth) * 2.0 - 1.0, 1.0 - (py / screenHeight) * 2.0⟩
+  -- Corner offsets (-h,-h), (h,-h), (h,h), (-h,h), rotated then translated
+  emitQuad
+    (toNdc (x - h * cosA + h * sinA) (y - h * sinA - h * cosA))
+    (toNdc (x + h * cosA + h * sinA) (y + h * sinA - h * cosA))
+    (toNdc (x + h * cosA - h * sinA) (y + h * sinA + h * cosA))
+    (toNdc (x - h * cosA - h * sinA) (y - h * sinA + h * cosA))
+    color
+
+/-- One Canvas shape instance on a stride-12 writer: the unit square (`rect`) or
+    disc (`ellipse`) scaled by half-extents `halfW`/`halfH` about `center`, all
+    in pixels, then mapped by `transform`. Affine images of rects and ellipses
+    are exact as instances, so no transform has to fall back to triangles. -/
+@[inline] def emitShapeInstance (ellipse : Bool) (center : Point) (halfW halfH : Float)
+    (transform : Transform) (color : Color) (screenWidth screenHeight : Float) :
+    VertexWriterM Unit := fun w =>
+  let c := Tessellation.pixelToNDC (transform.a * center.x + transform.c * center.y + transform.tx)
+    (transform.b * center.x + transform.d * center.y + transform.ty) screenWidth screenHeight
+  -- Axis images are vectors: linear part only, y flipped into NDC
+  let sx := 2.0 / screenWidth
+  let sy := -2.0 / screenHeight
+  w.emitShapeInstance c.x c.y (transform.a * halfW * sx) (transform.b * halfW * sy)
+    (transform.c * halfH * sx) (transform.d * halfH * sy)
+    color.r color.g color.b color.a (if ellipse then 1.0 else 0.0)
+
+/-- Writer counterpart of a solid `addTransformedRect` as a shape instance. -/
+@[inline] def emitRectInstance (rect : Rect) (transform : Transform) (color : Color)
+    (screenWidth screenHeight : Float) : VertexWriterM Unit :=
+  let hw := rect.size.width / 2
+  let hh := rect.size.height / 2
+  emitShapeInstance false ⟨rect.origin.x + hw, rect.origin.y + hh⟩ hw hh transform color
+    screenWidth screenHeight
+
+/-- A solid ellipse (or circle) as a shape instance. -/
+@[inline] def emitEllipseInstance (center : Point) (radiusX radiusY : Float) (transform : Transform)
+    (color : Color) (screenWidth screenHeight : Float) : VertexWriterM Unit :=
+  emitShapeInstance true center radiusX radiusY transform color screenWidth screenHeight
+
+end VertexWriterM
+
+end Afferent
@@ -0,0 +1,152 @@
+/-
+  Afferent Command Stream Tests
+  Encoder output decoded through the native recording sink, clip stack
+  semantics, and rejection of malformed or fuzzed streams (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.Render.CommandStream
+
+namespace Afferent.Tests.CommandStreamTests
+
+open Crucible
+open Afferent
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "Command Stream Tests"
+
+private def red : Color := ⟨1, 0, 0, 1⟩
+private def white : Color := ⟨1, 1, 1, 1⟩
+
+/-- Fill a rect in a 100x100 canvas with the identity transform. -/
+private def rect (x y w h : Float) (color : Color := red) (s : CommandStream) : CommandStream :=
+  s.fillRect (Rect.mk' x y w h) Transform.identity (.solid color) 100 100
+
+/-- Record with one font and one texture available. -/
+private def record (s : CommandStream) : IO (List String) := do
+  let log ← CommandStream.record s.finish 1 1
+  pure (log.splitOn "\n" |>.filter (· != ""))
+
+/-- A stream exercising every opcode. -/
+private def sample : CommandStream :=
+  CommandStream.empty
+    |> rect 0 0 10 10
+    |>.pushClip (Rect.mk' 10 10 50 50)
+    |>.text 0 "hi" 5 6 white Transform.identity
+    |>.sprites 0 ⟨#[1, 2, 3, 4, 0.5]⟩
+    |>.popClip
+
+/-! ## Encoding -/
+
+test "empty stream has only the header" := do
+  let bytes := CommandStream.empty.finish
+  ensure (bytes.size == 8) s!"Expected an 8 byte header, got {bytes.size}"
+  ensure ((← CommandStream.validate bytes 0 0) == 0) "Expected no commands"
+  ensure ((← record CommandStream.empty) == []) "Expected no sink calls"
+
+test "consecutive fills merge into one triangles command" := do
+  let s := CommandStream.empty |> rect 0 0 10 10 |> rect 20 20 10 10
+  ensure (s.size == 1) s!"Expected 1 command, got {s.size}"
+  ensure ((← record s) == ["triangles 8 12 -1 1 1 0 0 1"]) s!"Unexpected log {← record s}"
+
+test "text flushes pending geometry to preserve order" := do
+  let s := CommandStream.empty
+    |> rect 0 0 10 10
+    |>.text 0 "hello" 5 6 white Transform.identity
+    |> rect 0 0 10 10
+  let log ← record s
+  ensure (log.length == 3) s!"Expected 3 sink calls, got {log}"
+  ensure (log[1]! == "text 0 \"hello\" 5 6 1 1 1 1 [1 0 0 1 0 0]") s!"Unexpected text line {log[1]!}"
+  ensure (log[0]!.startsWith "triangles" && log[2]!.startsWith "triangles") "Fills should surround the text"
+
+test "text of any length round-trips through padding" := do
+  for str in ["", "a", "ab", "abc", "abcd", "héllo"] do
+    let log ← record (CommandStream.empty.text 0 str 0 0 white Transform.identity)
+    ensure (log == [s!"text 0 \"{str}\" 0 0 1 1 1 1 [1 0 0 1 0 0]"]) s!"Bad round trip for {repr str}: {log}"
+
+test "floats are encoded at f32 precision" := do
+  let log ← record (CommandStream.empty |> rect 0 0 10 10 ⟨0.1, 0.2, 0.3, 0.4⟩)
+  ensure (log == ["triangles 4 6 -1 1 0.1 0.2 0.3 0.4"]) s!"Unexpected log {log}"
+
+test "sprites record texture, count and first sprite" := do
+  let s := CommandStream.empty.sprites 0 ⟨#[1, 2, 3, 4, 0.5, 6, 7, 8, 9, 1]⟩
+  ensure ((← record s) == ["sprites 0 2 1 2 3 4 0.5"]) s!"Unexpected log {← record s}"
+
+/-! ## Clipping -/
+
+test "nested clips intersect and pop restores the parent" := do
+  let s := CommandStream.empty
+    |>.pushClip (Rect.mk' 10 10 100 100)
+    |>.pushClip (Rect.mk' 50 0 100 40)
+    |>.popClip
+    |>.popClip
+  let log ← record s
+  ensure (log == ["clip 10 10 100 100", "clip 50 10 60 30", "clip 10 10 100 100", "unclip"])
+    s!"Unexpected log {log}"
+
+test "unbalanced clips are closed at the end of the stream" := do
+  let log ← record (CommandStream.empty.pushClip (Rect.mk' 0 0 5 5))
+  ensure (log == ["clip 0 0 5 5", "unclip"]) s!"Unexpected log {log}"
+
+test "disjoint clips produce an empty clip" := do
+  let s := CommandStream.empty |>.pushClip (Rect.mk' 0 0 10 10) |>.pushClip (Rect.mk' 20 20 10 10)
+  let log ← record s
+  ensure (log[1]! == "clip 20 20 0 0") s!"Expected an empty clip, got {log}"
+
+/-! ## Validation -/
+
+test "sample stream validates" := do
+  ensure ((← CommandStream.validate sample.finish 1 1) == 5) "Expected 5 commands"
+
+test "bad magic is rejected" := do
+  let bytes := CommandStream.pushU32 (CommandStream.pushU32 .empty 0x12345678) 1
+  ensure (← fails (CommandStream.validate bytes 0 0)) "Expected bad magic to fail"
+
+test "unknown opcode is rejected" := do
+  let bytes := CommandStream.pushU32 CommandStream.empty.finish 99
+  ensure (← fails (CommandStream.validate bytes 0 0)) "Expected unknown opcode to fail"
+
+test "missing font and texture tables are rejected" := do
+  ensure (← fails (CommandStream.validate sample.finish 0 1)) "Expected font index to fail"
+  ensure (← fails (CommandStream.validate sample.finish 1 0)) "Expected texture index to fail"
+
+test "clip underflow is rejected" := do
+  ensure (← fails (CommandStream.validate CommandStream.empty.popClip.finish 0 0))
+    "Expected pop without push to fail"
+
+test "out-of-range triangle index is rejected" := do
+  let bad : TessellationResult := { vertices := ⟨#[0, 0, 1, 1, 1, 1]⟩, indices := #[0, 0, 1] }
+  ensure (← fails (CommandStream.validate (CommandStream.empty.triangles bad).finish 0 0))
+    "Expected index 1 of 1 vertex to fail"
+
+test "a malformed stream dispatches nothing" := do
+  let bytes := CommandStream.pushU32 sample.finish 99
+  ensure (← fails (CommandStream.record bytes 1 1)) "Expected the whole stream to be rejected"
+
+/-! ## Fuzzing -/
+
+test "every truncation either validates or fails cleanly" := do
+  let bytes := sample.finish
+  let mut accepted := 0
+  for n in [:bytes.size + 1] do
+    let prefix := bytes.extract 0 n
+    unless (← fails (CommandStream.record prefix 1 1)) do
+      accepted := accepted + 1
+  -- Exactly the prefixes ending on a command boundary are well-formed
+  ensure (accepted == 6) s!"Expected 6 valid prefixes, got {accepted}"
+
+test "random byte mutations never crash the decoder" := do
+  let bytes := sample.finish
+  let mut seed : UInt64 := 0x9E3779B97F4A7C15
+  for _ in [:2000] do
+    let mut mutated := bytes
+    for _ in [:3] do
+      seed := seed * 6364136223846793005 + 1442695040888963407
+      let pos := (seed >>> 33).toNat % bytes.size
+      mutated := mutated.set! pos (seed >>> 17).toUInt8
+    discard <| fails (CommandStream.record mutated 1 1)
+  ensure true "Decoder survived all mutations"
+
+#generate_tests
+
+end Afferent.Tests.CommandStreamTests
@@ -0,0 +1,107 @@
+/-
+  Afferent Culling Tests
+  Cull bounds contain the geometry the tessellators actually emit for fills
+  and strokes under transforms, and the disjointness test only culls what is
+  provably outside.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Path
+import Afferent.Canvas.State
+import Afferent.Canvas.Culling
+import Afferent.Render.PolygonFill
+
+namespace Afferent.Tests.CullingTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+
+testSuite "Culling Tests"
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- Every tessellated vertex, mapped back from NDC to canvas pixels, lies in `b`. -/
+private def covers (b : Bounds) (result : TessellationResult) : Bool := Id.run do
+  let mut i := 0
+  while i + 1 < result.vertices.size do
+    let x := (result.vertices[i]! + 1) / 2 * canvasW
+    let y := (1 - result.vertices[i + 1]!) / 2 * canvasH
+    -- float32-level slack for the NDC round trip
+    if x < b.minX - 1e-6 || x > b.maxX + 1e-6 || y < b.minY - 1e-6 || y > b.maxY + 1e-6 then
+      return false
+    i := i + 6
+  return true
+
+private def transforms : List Transform := [
+  Transform.identity,
+  Transform.translate 300 120,
+  (Transform.rotate 0.7).scaled 1.5 0.8 |>.translated 400 300
+]
+
+private def paths : List Path := [
+  Path.star ⟨100, 100⟩ 60 25 7,
+  Path.heart ⟨200, 150⟩ 90,
+  Path.ellipse ⟨150, 120⟩ 80 30,
+  Path.empty |>.moveTo ⟨10, 10⟩ |>.bezierCurveTo ⟨300, -50⟩ ⟨-80, 200⟩ ⟨150, 160⟩ |>.closePath,
+  Path.pie ⟨120, 120⟩ 70 0.3 2.5,
+  Path.empty |>.moveTo ⟨200, 100⟩ |>.arc ⟨150, 100⟩ 50 0.2 2.8 |>.closePath
+]
+
+/-! ## Bounds -/
+
+test "path bounds contain the tessellated fill" := do
+  for t in transforms do
+    for path in paths do
+      let state := { CanvasState.default with transform := t }
+      let result ← Tessellation.tessellatePathNDC (state.transformPath path) Color.red canvasW canvasH
+      match Culling.pathBounds t path with
+      | some b => ensure (covers b result) s!"Fill escapes its bounds under {repr t}"
+      | none => ensure false "Expected bounds for a path without arcTo"
+
+test "inflated path bounds contain the tessellated stroke" := do
+  for t in transforms do
+    for path in paths do
+      for style in [{ StrokeStyle.default with lineWidth := 6 },
+                    { StrokeStyle.default with lineWidth := 4, lineJoin := .round },
+                    { StrokeStyle.default with lineWidth := 4, lineCap := .square, lineJoin := .round },
+                    { StrokeStyle.default with lineWidth := 5, lineJoin := .bevel }] do
+        let state := { CanvasState.default with transform := t }
+        let result := Tessellation.tessellateStrokeNDC (state.transformPath path) style canvasW canvasH
+        let b := (Culling.pathBounds t path).get!.inflate (Culling.strokePad style)
+        ensure (covers b result) s!"Stroke escapes its bounds under {repr t}"
+
+test "rect and ellipse bounds contain their tessellations" := do
+  for t in transforms do
+    let state := { CanvasState.default with transform := t }
+    let rect := Rect.mk' 20 30 200 80
+    let rectFill ← Tessellation.tessellatePathNDC (state.transformPath (Path.rectangle rect)) Color.red
+      canvasW canvasH
+    ensure (covers (Culling.rectBounds t rect) rectFill) s!"Rect escapes its bounds under {repr t}"
+    let ellipse ← Tessellation.tessellatePathNDC (state.transformPath (Path.ellipse ⟨300, 200⟩ 120 40))
+      Color.red canvasW canvasH
+    ensure (covers (Culling.ellipseBounds t ⟨300, 200⟩ 120 40) ellipse)
+      s!"Ellipse escapes its bounds under {repr t}"
+
+test "arcTo and empty paths have no bounds" := do
+  let rounded := Path.empty |>.moveTo ⟨0, 0⟩ |>.arcTo ⟨100, 0⟩ ⟨100, 100⟩ 20
+  ensure (Culling.pathBounds Transform.identity rounded).isNone "arcTo should leave bounds unknown"
+  ensure (Culling.pathBounds Transform.identity Path.empty).isNone "Empty path should have no bounds"
+
+/-! ## Disjointness -/
+
+test "only provably separate bounds are disjoint" := do
+  let view := Bounds.ofRect (Rect.mk' 0 0 canvasW canvasH)
+  let inside : Bounds := { minX := 10, minY := 10, maxX := 20, maxY := 20 }
+  let straddling : Bounds := { minX := -50, minY := 790, maxX := 5, maxY := 900 }
+  let outside : Bounds := { minX := 1300, minY := 10, maxX := 1400, maxY := 20 }
+  let nan : Float := 0.0 / 0.0
+  let degenerate : Bounds := { minX := nan, minY := nan, maxX := nan, maxY := nan }
+  ensure (!inside.disjoint view && !straddling.disjoint view) "Visible bounds were culled"
+  ensure (outside.disjoint view) "Off-screen bounds were kept"
+  ensure (!degenerate.disjoint view) "NaN bounds should never be culled"
+
+#generate_tests
+
+end Afferent.Tests.CullingTests
@@ -0,0 +1,70 @@
+/-
+  Afferent Deferred Tessellation Tests
+  Draws tessellated across tasks come back in submission order with the
+  geometry serial tessellation produces, with and without a shared cache.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Path
+import Afferent.Canvas.State
+import Afferent.Canvas.DeferredTessellation
+
+namespace Afferent.Tests.DeferredTessellationTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+
+testSuite "Deferred Tessellation Tests"
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- `count` draws cycling through concave and convex fills, a gradient and strokes,
+    each under its own transform, so every result is distinguishable. Draw `i` is
+    rotated by `i * spin`. -/
+private def draws (count : Nat) (spin : Float := 0.1) : Array DeferredDraw := Id.run do
+  let gradient := FillStyle.gradient (.linear ⟨0, 0⟩ ⟨100, 0⟩ #[⟨0, Color.black⟩, ⟨1, Color.white⟩])
+  let mut out : Array DeferredDraw := #[]
+  for i in [:count] do
+    let t := (Transform.rotate (i.toFloat * spin)).translated (i.toFloat * 3) (i.toFloat * 2)
+    let state := { CanvasState.default with transform := t }
+    let stroke : StrokeStyle := { StrokeStyle.default with lineWidth := 1 + (i % 4).toFloat }
+    out := out.push <| match i % 4 with
+      | 0 => { path := Path.star ⟨50, 50⟩ 40 15 (5 + i % 3), state, style := .fill (.solid Color.red) }
+      | 1 => { path := Path.heart ⟨60, 60⟩ 50, state, style := .fill gradient }
+      | 2 => { path := Path.circle ⟨40, 40⟩ (10 + i.toFloat), state, style := .stroke stroke }
+      | _ => { path := Path.roundedRect (Rect.mk' 0 0 80 40) 8, state, style := .fill (.solid Color.blue),
+               antialias := true }
+  return out
+
+/-! ## Ordering and geometry -/
+
+test "results match serial tessellation in draw order for any worker count" := do
+  let ds := draws 203
+  let serial ← ds.mapM (·.tessellate none canvasW canvasH)
+  for workers in [1, 2, 3, 8] do
+    let results ← DeferredTessellation.tessellateAll ds workers none canvasW canvasH
+    ensure (results.size == serial.size) s!"{workers} workers returned {results.size} results"
+    for i in [:serial.size] do
+      ensure (sameGeometry results[i]! serial[i]!) s!"{workers} workers: draw {i} differs"
+
+test "tasks sharing a cache match uncached geometry" := do
+  -- Translations only: cached geometry is placed, not re-triangulated, under rotations
+  let ds := draws 128 (spin := 0)
+  let serial ← ds.mapM (·.tessellate none canvasW canvasH)
+  let cache ← IO.mkRef TessellationCache.empty
+  for pass in [0, 1] do
+    let results ← DeferredTessellation.tessellateAll ds 4 (some cache) canvasW canvasH
+    for i in [:serial.size] do
+      ensure (sameGeometry results[i]! serial[i]!) s!"Pass {pass}: cached draw {i} differs"
+  ensure ((← cache.get).hits > 0) "Expected the second pass to hit the cache"
+
+test "a short run stays serial and still returns every draw" := do
+  let ds := draws (DeferredTessellation.minDrawsPerTask - 1)
+  let results ← DeferredTessellation.tessellateAll ds 8 none canvasW canvasH
+  ensure (results.size == ds.size) s!"Expected {ds.size} results, got {results.size}"
+
+#generate_tests
+
+end Afferent.Tests.DeferredTessellationTests
@@ -1,9 +1,11 @@
 /-
   Afferent FFI Safety Tests
-  Regression tests for common FFI footguns (e.g., missing init).
+  Regression tests for common FFI footguns (e.g., missing init, in-place
+  mutation of shared arrays).
 -/
 import Afferent.Tests.Framework
 import Afferent.FFI
+import Afferent.Render.Dynamic
 
 namespace Afferent.Tests.FFISafetyTests
 
@@ -30,6 +32,36 @@ test "Texture can be cached in IO.Ref" := do
   r.set none
   Afferent.FFI.Texture.destroy texForDestroy
 
+test "In-place particle update leaves shared arrays untouched" := do
+  let data : FloatArray := ⟨#[10, 10, 100, 0, 0.5]⟩
+  let kept := data
+  let updated ← Afferent.FFI.Particles.updateBouncing data 1 0.5 1 1000 1000
+  ensure (kept[0]! == 10) s!"Shared array was mutated: x = {kept[0]!}"
+  ensure (updated[0]! == 60) s!"Expected x = 60, got {updated[0]!}"
+
+test "In-place particle update matches the fused sprite path" := do
+  let p := Afferent.Render.Dynamic.ParticleState.create 1000 200 100 3
+  let sprites ← Afferent.FFI.FloatBuffer.create 5000
+  let staging ← Afferent.FFI.FloatBuffer.create 5000
+  let fused ← p.updateBouncingAndWriteSprites 0.25 4 sprites
+  let inPlace ← p.updateBouncingInPlace 0.25 4
+  Afferent.FFI.FloatBuffer.writeSpritesFromParticles staging inPlace.data 1000 4 0 1
+  ensure (fused.data.data == inPlace.data.data) "Particle state differs"
+  for i in [:5000] do
+    ensure ((← sprites.get i.toUSize) == (← staging.get i.toUSize)) s!"Sprite float {i} differs"
+  sprites.destroy
+  staging.destroy
+
+test "FloatBuffer.copy rejects ranges past capacity" := do
+  let a ← Afferent.FFI.FloatBuffer.create 8
+  let b ← Afferent.FFI.FloatBuffer.create 4
+  a.set 6 2.5
+  Afferent.FFI.FloatBuffer.copy b 0 a 4 4
+  ensure ((← b.get 2) == 2.5) "Expected copied value"
+  ensure (← fails (Afferent.FFI.FloatBuffer.copy b 1 a 0 4)) "Expected out-of-range copy to fail"
+  a.destroy
+  b.destroy
+
 #generate_tests
 
 end Afferent.Tests.FFISafetyTests
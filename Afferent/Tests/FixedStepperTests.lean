@@ -0,0 +1,97 @@
+/-
+  Afferent FixedStepper Tests
+  Accumulator substep counts, interpolation and seeded determinism of the
+  fixed-timestep stepper (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.FixedStepper
+
+namespace Afferent.Tests.FixedStepperTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "FixedStepper Tests"
+
+/-- One particle at (x, 50) moving right at `vx`, inside a 1000x100 box. -/
+private def single (x vx : Float) (fixedDt : Float := 0.01) : IO FixedStepper := do
+  let s ← FixedStepper.create 1 fixedDt
+  s.setBounds 1000.0 100.0 1.0
+  let _ ← s.load ⟨#[x, 50.0, vx, 0.0, 0.25]⟩
+  pure s
+
+/-! ## Accumulator -/
+
+test "frame time is consumed in whole substeps" := do
+  let s ← single 10.0 100.0
+  let buf ← FloatBuffer.create 4
+  let n1 ← s.advance 0.025 buf
+  ensure (n1 == 2) s!"Expected 2 substeps for 25ms at 10ms, got {n1}"
+  shouldBeNear (← s.alpha) 0.5
+  let n2 ← s.advance 0.005 buf
+  ensure (n2 == 1) s!"Expected the carried 5ms to complete a step, got {n2}"
+  ensure ((← s.stepCount) == 3) "Expected 3 steps in total"
+  buf.destroy
+  s.destroy
+
+test "long stalls are clamped to maxSubsteps" := do
+  let s ← FixedStepper.create 1 0.01 4
+  s.setBounds 100.0 100.0 1.0
+  let buf ← FloatBuffer.create 4
+  let n ← s.advance 1.0 buf
+  ensure (n == 4) s!"Expected 4 substeps, got {n}"
+  shouldBeNear (← s.droppedTime) 0.96
+  buf.destroy
+  s.destroy
+
+/-! ## Interpolation -/
+
+test "instances are interpolated between steps" := do
+  let s ← single 10.0 100.0
+  let buf ← FloatBuffer.create 4
+  -- One step moves x from 10 to 11; alpha 0.5 draws halfway
+  let _ ← s.advance 0.015 buf .circles
+  shouldBeNear (← buf.get 0) 10.5
+  shouldBeNear (← buf.get 1) 50.0
+  shouldBeNear (← buf.get 2) 0.25
+  shouldBeNear (← buf.get 3) 1.0
+  buf.destroy
+  s.destroy
+
+/-! ## Determinism -/
+
+test "results depend only on step count, not frame timing" := do
+  let a ← FixedStepper.create 2000
+  let b ← FixedStepper.create 2000
+  for s in [a, b] do
+    s.setBounds 800.0 600.0 2.0
+    s.initRandom 800.0 600.0 300.0 99
+  let buf ← FloatBuffer.create 8000
+  -- Irregular frame times for `a`, a plain headless run for `b`
+  for i in [0:200] do
+    let _ ← a.advance (0.004 + (i % 7).toFloat * 0.003) buf
+  b.run (← a.stepCount).toUInt32
+  ensure ((← a.checksum) == (← b.checksum)) "Expected identical state after equal step counts"
+  buf.destroy
+  a.destroy
+  b.destroy
+
+test "same seed gives the same headless run" := do
+  let run (seed : UInt32) : IO UInt64 := do
+    let s ← FixedStepper.create 500
+    s.setBounds 640.0 480.0 2.0
+    s.initRandom 640.0 480.0 200.0 seed
+    s.run 600
+    let sum ← s.checksum
+    s.destroy
+    pure sum
+  let x ← run 7
+  let y ← run 7
+  let z ← run 8
+  ensure (x == y) "Expected equal checksums for equal seeds"
+  ensure (x != z) "Expected different checksums for different seeds"
+
+#generate_tests
+
+end Afferent.Tests.FixedStepperTests
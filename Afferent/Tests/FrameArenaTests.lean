@@ -0,0 +1,122 @@
+/-
+  Afferent FrameArena Tests
+  Alignment, mark/rewind, per-frame reset, high-water tracking and block
+  coalescing of the transient scratch arena (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.FrameArena
+
+namespace Afferent.Tests.FrameArenaTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "FrameArena Tests"
+
+/-! ## Allocation -/
+
+test "allocations are rounded up to 16 bytes" := do
+  let a ← FrameArena.create 4096
+  ensure (← a.alloc 1) "Expected allocation to succeed"
+  ensure ((← a.stats).bytesInUse == 16) "1 byte should occupy 16"
+  ensure (← a.alloc 17) "Expected allocation to succeed"
+  ensure ((← a.stats).bytesInUse == 48) "17 bytes should occupy 32"
+  a.destroy
+
+test "preallocated block serves allocations without malloc" := do
+  let a ← FrameArena.create 4096
+  let before := (← a.stats).systemAllocs
+  for _ in [:100] do
+    discard <| a.alloc 32
+  ensure ((← a.stats).systemAllocs == before) "Expected no mallocs within the first block"
+  a.destroy
+
+test "oversized allocation gets its own block" := do
+  let a ← FrameArena.create 1024
+  ensure (← a.alloc 100000) "Expected large allocation to succeed"
+  let s ← a.stats
+  ensure (s.bytesInUse == 100000) s!"Unexpected bytesInUse {s.bytesInUse}"
+  ensure (s.capacityBytes ≥ 100000) "Capacity should cover the allocation"
+  a.destroy
+
+/-! ## Mark / rewind -/
+
+test "rewind restores usage to the mark" := do
+  let a ← FrameArena.create 4096
+  discard <| a.alloc 64
+  let m ← a.mark
+  discard <| a.alloc 128
+  discard <| a.alloc 10000
+  a.rewind m
+  ensure ((← a.stats).bytesInUse == 64) "Rewind should release everything after the mark"
+  a.destroy
+
+test "nested marks rewind in order" := do
+  let a ← FrameArena.create 4096
+  let outer ← a.mark
+  discard <| a.alloc 32
+  let inner ← a.mark
+  discard <| a.alloc 32
+  a.rewind inner
+  ensure ((← a.stats).bytesInUse == 32) "Inner rewind should keep the outer allocation"
+  a.rewind outer
+  ensure ((← a.stats).bytesInUse == 0) "Outer rewind should release everything"
+  a.destroy
+
+test "scratch conversions leave nothing allocated" := do
+  let a ← FrameArena.create 1024
+  let data : FloatArray := ⟨(Array.range 1000).map (·.toFloat)⟩
+  let sum ← a.narrowScratch data
+  shouldBeNear sum (Array.range 16 |>.foldl (fun acc i => acc + (i * 64).toFloat) 0.0)
+  let s ← a.stats
+  ensure (s.bytesInUse == 0) "Conversion should rewind its scratch"
+  ensure (s.highWaterBytes == 4000) s!"Expected 4000 byte high-water, got {s.highWaterBytes}"
+  a.destroy
+
+/-! ## Frames -/
+
+test "reset releases all memory and records the frame peak" := do
+  let a ← FrameArena.create 4096
+  discard <| a.alloc 512
+  discard <| a.alloc 512
+  a.reset
+  let s ← a.stats
+  ensure (s.bytesInUse == 0) "Reset should release all memory"
+  ensure (s.framePeakBytes == 1024) s!"Unexpected frame peak {s.framePeakBytes}"
+  ensure (s.frames == 1) "Expected one completed frame"
+  a.reset
+  let s ← a.stats
+  ensure (s.framePeakBytes == 0) "An empty frame should have no peak"
+  ensure (s.highWaterBytes == 1024) "High-water should persist across frames"
+  a.destroy
+
+test "overflow blocks are coalesced so the next frame never mallocs" := do
+  let a ← FrameArena.create 1024
+  for _ in [:20] do
+    discard <| a.alloc 1000
+  a.reset
+  ensure ((← a.stats).blockCount == 1) "Reset should fold the blocks into one"
+  for _ in [:20] do
+    discard <| a.alloc 1000
+  a.reset
+  let s ← a.stats
+  ensure (s.lastFrameAllocs == 0) s!"Expected no mallocs in a warm frame, got {s.lastFrameAllocs}"
+  ensure (s.blockCount == 1) "Expected a single block"
+  a.destroy
+
+test "passthrough mode mallocs once per allocation" := do
+  let a ← FrameArena.create 1024
+  a.setPassthrough true
+  let data : FloatArray := ⟨(Array.range 100).map (·.toFloat)⟩
+  for _ in [:10] do
+    discard <| a.narrowScratch data
+  a.reset
+  let s ← a.stats
+  ensure (s.lastFrameAllocs == 10) s!"Expected 10 mallocs, got {s.lastFrameAllocs}"
+  ensure (s.capacityBytes == 0) "Passthrough should free on rewind"
+  a.destroy
+
+#generate_tests
+
+end Afferent.Tests.FrameArenaTests
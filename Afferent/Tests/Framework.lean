@@ -1,9 +1,11 @@
 /-
   Afferent Test Framework
-  Float comparison helpers for unit testing.
+  Float comparison, failure and geometry helpers shared by the test suites.
   Core test infrastructure is provided by Crucible.
 -/
 import Crucible
+import Afferent.Render.Tessellation
+import Afferent.FFI.FloatBuffer
 
 namespace Afferent.Tests
 
@@ -18,4 +20,26 @@ abbrev shouldBeNear := Crucible.shouldBeNear
 /-- Alias for approximate float equality assertions. -/
 abbrev shouldBeApprox := Crucible.shouldBeApprox
 
+/-- Run `action`, returning true if it threw. -/
+def fails (action : IO α) : IO Bool := do
+  try
+    discard action
+    pure false
+  catch _ =>
+    pure true
+
+/-- Same indices, and vertices equal to within NDC rounding. -/
+def sameGeometry (a b : TessellationResult) : Bool := Id.run do
+  if a.indices != b.indices || a.vertices.size != b.vertices.size then return false
+  for i in [:a.vertices.size] do
+    if (a.vertices[i]! - b.vertices[i]!).abs > 1e-9 then return false
+  return true
+
+/-- The first `n` floats of `buf`. -/
+def readBack (buf : FFI.FloatBuffer) (n : Nat) : IO (Array Float) := do
+  let mut out : Array Float := #[]
+  for i in [0:n] do
+    out := out.push (← buf.get i.toUSize)
+  pure out
+
 end Afferent.Tests
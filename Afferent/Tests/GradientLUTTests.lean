@@ -0,0 +1,101 @@
+/-
+  Afferent Gradient LUT Tests
+  Tables hold the stop interpolation at their entries, sample within one
+  8-bit step of it in between, and are shared through the cache by stops.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Path
+import Afferent.Core.Paint
+import Afferent.Render.GradientLUT
+import Afferent.Render.PolygonFill
+
+namespace Afferent.Tests.GradientLUTTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+
+testSuite "Gradient LUT Tests"
+
+/-- The sunset stops of the Gradients demo. -/
+private def sunset : Array GradientStop := #[
+  { position := 0.0, color := Color.hsva 0.667 0.667 0.3 1.0 },
+  { position := 0.3, color := Color.hsva 0.833 0.6 0.5 1.0 },
+  { position := 0.5, color := Color.hsva 0.024 0.778 0.9 1.0 },
+  { position := 0.7, color := Color.hsva 0.083 0.8 1.0 1.0 },
+  { position := 1.0, color := Color.hsva 0.139 0.6 1.0 1.0 }
+]
+
+private def colorDistance (a b : Color) : Float :=
+  max (max (a.r - b.r).abs (a.g - b.g).abs) (max (a.b - b.b).abs (a.a - b.a).abs)
+
+/-! ## Tables -/
+
+test "entries hold the stop interpolation at their positions" := do
+  let lut := GradientLUT.build sunset
+  ensure (lut.size == GradientLUT.defaultSize)
+    s!"Expected {GradientLUT.defaultSize} entries, got {lut.size}"
+  for i in [:lut.size] do
+    let t := i.toFloat / (lut.size - 1).toFloat
+    let d := colorDistance (lut.sample t) (Tessellation.interpolateGradientStops sunset t)
+    ensure (d < 1e-9) s!"Entry {i} is off by {d}"
+
+test "sampling between entries stays within one 8-bit step" := do
+  let lut := GradientLUT.build sunset
+  for i in [:1000] do
+    let t := i.toFloat / 999.0
+    let d := colorDistance (lut.sample t) (Tessellation.interpolateGradientStops sunset t)
+    ensure (d <= 1.0 / 255.0) s!"Sample at {t} is off by {d}"
+  -- A two-stop gradient is linear, so interpolated entries reproduce it
+  let stops := gradient![Color.red, Color.blue]
+  let d := colorDistance ((GradientLUT.build stops).sample 0.4321)
+    (Tessellation.interpolateGradientStops stops 0.4321)
+  ensure (d < 1e-9) s!"Two-stop sample is off by {d}"
+
+test "positions outside the gradient clamp to its ends" := do
+  let lut := GradientLUT.build gradient![Color.red, Color.green, Color.blue]
+  ensure (colorDistance (lut.sample (-3.0)) Color.red < 1e-9) "Expected red before the start"
+  ensure (colorDistance (lut.sample 7.5) Color.blue < 1e-9) "Expected blue past the end"
+
+test "texture row is RGBA8 with straight alpha" := do
+  let lut := GradientLUT.build #[⟨0, Color.rgba 1 0 0 1⟩, ⟨1, Color.rgba 0 0 1 0⟩]
+  let bytes := lut.toRGBA8
+  ensure (bytes.size == 4 * GradientLUT.defaultSize)
+    s!"Expected {4 * GradientLUT.defaultSize} bytes"
+  ensure (bytes[0]! == 255 && bytes[2]! == 0 && bytes[3]! == 255) "First texel should be opaque red"
+  let last := bytes.size - 4
+  ensure (bytes[last]! == 0 && bytes[last + 2]! == 255 && bytes[last + 3]! == 0)
+    "Last texel should be transparent blue"
+
+/-! ## Cache -/
+
+test "cache shares a table between equal stops" := do
+  let cache ← IO.mkRef ({} : GradientLUTCache)
+  let a ← GradientLUTCache.lookup cache sunset
+  let b ← GradientLUTCache.lookup cache sunset
+  discard <| GradientLUTCache.lookup cache gradient![Color.black, Color.white]
+  let c ← cache.get
+  ensure (c.hits == 1 && c.misses == 2)
+    s!"Expected 1 hit and 2 misses, got {c.hits} and {c.misses}"
+  ensure (a.colors.data == b.colors.data) "A hit should return the stored table"
+  ensure ((← GradientLUTCache.forStyle cache (.solid Color.red)).isNone) "Solid fills have no table"
+
+/-! ## Fills -/
+
+test "fill sampled through a table matches exact sampling" := do
+  let style := FillStyle.linearGradient ⟨0, 0⟩ ⟨200, 120⟩ sunset
+  let lut := GradientLUT.build sunset
+  for path in [Path.star ⟨100, 60⟩ 60 25 5, Path.circle ⟨100, 60⟩ 50] do
+    let exact ← Tessellation.tessellatePathFillNDC path path Transform.identity style 800 600
+    let viaLUT ← Tessellation.tessellatePathFillNDC path path Transform.identity style 800 600
+      (lut := some lut)
+    ensure (exact.indices == viaLUT.indices && exact.vertices.size == viaLUT.vertices.size)
+      "Geometry should not depend on the table"
+    for i in [:exact.vertices.size] do
+      ensure ((exact.vertices[i]! - viaLUT.vertices[i]!).abs <= 1.0 / 255.0)
+        s!"Vertex float {i} differs by more than an 8-bit step"
+
+#generate_tests
+
+end Afferent.Tests.GradientLUTTests
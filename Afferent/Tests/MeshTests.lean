@@ -0,0 +1,121 @@
+/-
+  Afferent Mesh Tests
+  CPU-side storage, sub-range updates, dirty-range bookkeeping and submesh
+  clamping of persistent meshes (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.Mesh
+
+namespace Afferent.Tests.MeshTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "Mesh Tests"
+
+/-- `n` lit vertices whose every float is the vertex index plus `base`. -/
+private def litVertices (n : Nat) (base : Float := 0.0) : FloatArray := Id.run do
+  let mut data := FloatArray.emptyWithCapacity (n * 10)
+  for i in [:n] do
+    for _ in [:10] do
+      data := data.push (i.toFloat + base)
+  return data
+
+/-- A quad: 4 vertices, 2 triangles. -/
+private def quad : IO Mesh :=
+  Mesh.create .lit (litVertices 4) #[0, 1, 2, 2, 3, 0]
+
+/-! ## Creation -/
+
+test "create stores counts and data" := do
+  let m ← quad
+  ensure ((← m.vertexCount) == 4) "Expected 4 vertices"
+  ensure ((← m.indexCount) == 6) "Expected 6 indices"
+  let v ← m.vertexData
+  ensure (v.size == 40) s!"Expected 40 floats, got {v.size}"
+  shouldBeNear v[35]! 3.0
+  ensure ((← m.indexData) == #[0, 1, 2, 2, 3, 0]) "Index data should round-trip"
+  m.destroy
+
+test "textured format uses 12 floats per vertex" := do
+  let data : FloatArray := ⟨(Array.range 36).map (·.toFloat)⟩
+  let m ← Mesh.create .textured data #[0, 1, 2]
+  ensure ((← m.vertexCount) == 3) "Expected 3 textured vertices"
+  let stats ← m.stats
+  ensure (stats.cpuBytes == 36 * 4 + 3 * 4) s!"Unexpected cpuBytes {stats.cpuBytes}"
+  m.destroy
+
+test "vertices are stored at float32 precision" := do
+  let m ← Mesh.create .lit (litVertices 3 0.1) #[0, 1, 2]
+  let v ← m.vertexData
+  ensure (v[0]! != 0.1) "Expected storage to be narrowed to float32"
+  shouldBeNear v[0]! 0.1
+  m.destroy
+
+test "empty geometry is rejected" := do
+  ensure (← fails (do let m ← Mesh.create .lit .empty #[]; m.destroy))
+    "Expected empty mesh to fail"
+
+test "out-of-range index is rejected" := do
+  ensure (← fails (do let m ← Mesh.create .lit (litVertices 3) #[0, 1, 3]; m.destroy))
+    "Expected index 3 of 3 vertices to fail"
+
+/-! ## Updates -/
+
+test "new meshes start clean with no GPU buffers" := do
+  let m ← quad
+  let d ← m.dirty
+  ensure (d.vertexCount == 0 && d.indexCount == 0) "Expected no dirty ranges"
+  let stats ← m.stats
+  ensure (!stats.gpuResident) "Expected no GPU buffers before the first draw"
+  m.destroy
+
+test "vertex updates overwrite and mark a range" := do
+  let m ← quad
+  m.updateVertices 1 (litVertices 2 10.0)
+  let v ← m.vertexData
+  shouldBeNear v[10]! 10.0
+  shouldBeNear v[20]! 11.0
+  shouldBeNear v[30]! 3.0
+  let d ← m.dirty
+  ensure (d.vertexFirst == 1 && d.vertexCount == 2) s!"Unexpected dirty range {repr d}"
+  m.destroy
+
+test "disjoint updates merge into one covering range" := do
+  let m ← quad
+  m.updateVertices 3 (litVertices 1)
+  m.updateVertices 0 (litVertices 1)
+  m.updateIndices 4 #[1, 1]
+  m.updateIndices 1 #[2]
+  let d ← m.dirty
+  ensure (d.vertexFirst == 0 && d.vertexCount == 4) s!"Unexpected vertex range {repr d}"
+  ensure (d.indexFirst == 1 && d.indexCount == 5) s!"Unexpected index range {repr d}"
+  let stats ← m.stats
+  ensure (stats.vertexUpdates == 2 && stats.indexUpdates == 2) "Expected 2 updates of each kind"
+  ensure ((← m.indexData) == #[0, 2, 2, 2, 1, 1]) "Index updates should be applied"
+  m.destroy
+
+test "out-of-range updates are rejected and leave data intact" := do
+  let m ← quad
+  ensure (← fails (m.updateVertices 3 (litVertices 2))) "Expected vertex overrun to fail"
+  ensure (← fails (m.updateIndices 5 #[0, 0])) "Expected index overrun to fail"
+  ensure (← fails (m.updateIndices 0 #[4])) "Expected invalid vertex index to fail"
+  ensure ((← m.indexData) == #[0, 1, 2, 2, 3, 0]) "Rejected updates should not write"
+  let d ← m.dirty
+  ensure (d.vertexCount == 0 && d.indexCount == 0) "Rejected updates should not mark ranges"
+  m.destroy
+
+/-! ## Submesh ranges -/
+
+test "submesh ranges are clamped to the index buffer" := do
+  let m ← quad
+  ensure ((← m.clampRange 3 3) == (3, 3)) "In-range submesh should be unchanged"
+  ensure ((← m.clampRange 3 100) == (3, 3)) "Overlong submesh should be clamped"
+  let (_, count) ← m.clampRange 6 3
+  ensure (count == 0) "Submesh past the end should draw nothing"
+  m.destroy
+
+#generate_tests
+
+end Afferent.Tests.MeshTests
@@ -0,0 +1,136 @@
+/-
+  Afferent PackedBuffer Tests
+  Round-trip tests for the packed instance encodings (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.PackedBuffer
+
+namespace Afferent.Tests.PackedBufferTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "PackedBuffer Tests"
+
+/-- Pack `values` as instances of `schema`, unpack them, and return the decoded floats. -/
+private def roundTrip (schema : PackedSchema) (values : Array Float) : IO FloatArray := do
+  let perInstance := schema.floatCount
+  let count := values.size / perInstance
+  let buf ← PackedBuffer.create schema count.toUSize
+  let _ ← buf.packFloatArray 0 ⟨values⟩ count.toUSize
+  let out ← buf.unpackFloatArray 0 count.toUSize
+  buf.destroy
+  pure out
+
+private def ensureClose (actual expected tol : Float) (what : String) : IO Unit :=
+  ensure ((actual - expected).abs <= tol) s!"{what}: expected {expected}, got {actual} (tol {tol})"
+
+/-! ## Layout -/
+
+test "rect instance schema packs into 16 bytes" := do
+  let buf ← PackedBuffer.create PackedSchema.instanceRect 4
+  let stride ← buf.stride
+  let floats ← buf.floatsPerInstance
+  buf.destroy
+  ensure (stride == 16) s!"Expected stride 16, got {stride}"
+  ensure (floats == 8) s!"Expected 8 logical floats, got {floats}"
+
+test "4-byte fields are aligned and stride is a multiple of 4" := do
+  let buf ← PackedBuffer.create #[.f16, .f32, .snorm16] 1
+  let stride ← buf.stride
+  buf.destroy
+  -- f16 at 0, f32 realigned to 4, snorm16 at 8, padded to 12
+  ensure (stride == 12) s!"Expected stride 12, got {stride}"
+
+test "pack reports bytes written and clamps to capacity" := do
+  let buf ← PackedBuffer.create PackedSchema.sprite 2
+  let data : FloatArray := ⟨Array.replicate 15 1.0⟩
+  let written ← buf.packFloatArray 1 data 3
+  buf.destroy
+  -- Only instance 1 fits (capacity 2), 12 bytes per sprite instance
+  ensure (written == 12) s!"Expected 12 bytes written, got {written}"
+
+test "invalid schema is rejected" := do
+  let buf? ← try
+    pure (some (← PackedBuffer.createRaw (ByteArray.mk #[0, 7]) 1))
+  catch _ =>
+    pure none
+  match buf? with
+  | none => pure ()
+  | some buf =>
+      buf.destroy
+      ensure false "Expected unknown encoding to fail"
+
+/-! ## Round trips -/
+
+test "f32 fields round-trip exactly" := do
+  let values := #[0.0, 1.5, -1234.25, 3.0e7]
+  let out ← roundTrip #[.f32] values
+  for i in [0:values.size] do
+    ensure (out.get! i == values[i]!) s!"f32[{i}] changed: {out.get! i}"
+
+test "f16 fields round-trip within half precision" := do
+  let values := #[0.0, 1.0, -2.5, 0.333333, 1000.7, -65504.0, 0.00006103515625]
+  let out ← roundTrip #[.f16] values
+  for i in [0:values.size] do
+    let v := values[i]!
+    -- 10 mantissa bits => relative error <= 2^-11
+    ensureClose (out.get! i) v (v.abs * 0.00049 + 1.0e-7) s!"f16[{i}]"
+
+test "f16 overflow saturates to infinity" := do
+  let out ← roundTrip #[.f16] #[100000.0, -100000.0]
+  ensure (out.get! 0).isInf s!"Expected +inf, got {out.get! 0}"
+  ensure ((out.get! 1).isInf && out.get! 1 < 0) s!"Expected -inf, got {out.get! 1}"
+
+test "unorm8x4 colors round-trip within 1/510 and clamp" := do
+  let values := #[0.0, 0.25, 0.5, 1.0, -0.5, 1.5, 0.1, 0.9]
+  let out ← roundTrip #[.unorm8x4] values
+  let expected := #[0.0, 0.25, 0.5, 1.0, 0.0, 1.0, 0.1, 0.9]
+  for i in [0:expected.size] do
+    ensureClose (out.get! i) expected[i]! (1.0 / 510.0 + 1.0e-6) s!"unorm8[{i}]"
+
+test "snorm16 fields round-trip within 1/65534 and clamp" := do
+  let values := #[-1.0, -0.5, 0.0, 0.123456, 1.0, 2.0, -3.0]
+  let out ← roundTrip #[.snorm16] values
+  let expected := #[-1.0, -0.5, 0.0, 0.123456, 1.0, 1.0, -1.0]
+  for i in [0:expected.size] do
+    ensureClose (out.get! i) expected[i]! (1.0 / 65534.0 + 1.0e-6) s!"snorm16[{i}]"
+
+test "mixed rect instances round-trip field by field" := do
+  -- Two InstanceData records: [x, y, angle, halfSize, r, g, b, a]
+  let values := #[0.25, -0.75, 1.5707, 0.01, 1.0, 0.5, 0.0, 0.8,
+                  -0.9, 0.9, -3.14159, 0.2, 0.2, 0.4, 0.6, 1.0]
+  let out ← roundTrip PackedSchema.instanceRect values
+  ensure (out.size == values.size) s!"Expected {values.size} floats, got {out.size}"
+  for inst in [0:2] do
+    let base := inst * 8
+    for i in [0:2] do
+      let v := values[base + i]!
+      ensureClose (out.get! (base + i)) v (v.abs * 6.0e-8) s!"rect[{inst}].f32[{i}]"
+    for i in [2:4] do
+      let v := values[base + i]!
+      ensureClose (out.get! (base + i)) v (v.abs * 0.00049 + 1.0e-7) s!"rect[{inst}].f16[{i}]"
+    for i in [4:8] do
+      ensureClose (out.get! (base + i)) values[base + i]! (1.0 / 510.0 + 1.0e-6) s!"rect[{inst}].color[{i - 4}]"
+
+test "packing from a FloatBuffer matches packing from a FloatArray" := do
+  let values := #[10.0, 20.0, 0.5, 4.0, 1.0, 30.5, 40.25, 0.0, 8.0, 0.5]
+  let src ← FloatBuffer.create values.size.toUSize
+  for i in [0:values.size] do
+    src.set i.toUSize values[i]!
+  let a ← PackedBuffer.create PackedSchema.sprite 2
+  let b ← PackedBuffer.create PackedSchema.sprite 2
+  let wa ← a.packFromFloatBuffer 0 src 2
+  let wb ← b.packFloatArray 0 ⟨values⟩ 2
+  let bytesA ← a.toByteArray 0 2
+  let bytesB ← b.toByteArray 0 2
+  a.destroy
+  b.destroy
+  src.destroy
+  ensure (wa == 24 && wb == 24) s!"Expected 24 bytes each, got {wa} and {wb}"
+  ensure (bytesA.data == bytesB.data) "Packed bytes differ between FloatBuffer and FloatArray sources"
+
+#generate_tests
+
+end Afferent.Tests.PackedBufferTests
@@ -0,0 +1,76 @@
+/-
+  Afferent ParticleInit Tests
+  Native parallel initialization: thread-count independence and
+  distribution bounds (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.ParticleInit
+
+namespace Afferent.Tests.ParticleInitTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "ParticleInit Tests"
+
+private def screen : ParticleInit :=
+  { position := .rect 0.0 0.0 1920.0 1080.0, velocity := .box 200.0 }
+
+/-! ## Determinism -/
+
+test "output is identical for any thread count" := do
+  -- Large enough that the native side really splits the work
+  let count := 200000
+  let one := Particles.generate count screen 42 1
+  let four := Particles.generate count screen 42 4
+  let auto := Particles.generate count screen 42 0
+  ensure (one.size == count * 5) s!"Expected {count * 5} floats, got {one.size}"
+  ensure (one.data == four.data) "1-thread and 4-thread output differ"
+  ensure (one.data == auto.data) "1-thread and auto-thread output differ"
+
+test "different seeds give different particles" := do
+  let a := Particles.generate 100 screen 1
+  let b := Particles.generate 100 screen 2
+  ensure (a.data != b.data) "Expected different output for different seeds"
+
+test "FloatBuffer init matches the FloatArray path" := do
+  let count := 1000
+  let expected := Particles.generate count screen 9
+  let buf ← FloatBuffer.create (count * 5).toUSize
+  buf.initParticles count.toUInt32 screen 9
+  for i in [0:count * 5] do
+    let v ← buf.get i.toUSize
+    ensure (v == expected[i]!) s!"Float {i}: buffer {v} vs array {expected[i]!}"
+  buf.destroy
+
+/-! ## Distributions -/
+
+test "rect and box stay in bounds, hue follows index" := do
+  let count := 5000
+  let data := Particles.generate count screen 3
+  for i in [0:count] do
+    let x := data[i * 5]!
+    let y := data[i * 5 + 1]!
+    let vx := data[i * 5 + 2]!
+    let vy := data[i * 5 + 3]!
+    ensure (x >= 0.0 && x < 1920.0 && y >= 0.0 && y < 1080.0) s!"Particle {i} outside rect"
+    ensure (vx >= -200.0 && vx < 200.0 && vy >= -200.0 && vy < 200.0) s!"Particle {i} too fast"
+  shouldBeNear data[5 * 2500 + 4]! 0.5
+
+test "disc positions stay within the radius" := do
+  let init : ParticleInit :=
+    { position := .disc 100.0 50.0 25.0, velocity := .directional 10.0 20.0, hue := .constant 0.3 }
+  let count := 5000
+  let data := Particles.generate count init 5
+  for i in [0:count] do
+    let dx := data[i * 5]! - 100.0
+    let dy := data[i * 5 + 1]! - 50.0
+    let speed := (data[i * 5 + 2]! * data[i * 5 + 2]! + data[i * 5 + 3]! * data[i * 5 + 3]!).sqrt
+    ensure (dx * dx + dy * dy <= 25.0 * 25.0 + 0.01) s!"Particle {i} outside disc"
+    ensure (speed >= 9.99 && speed <= 20.01) s!"Particle {i} speed {speed} out of range"
+  shouldBeNear data[4]! 0.3
+
+#generate_tests
+
+end Afferent.Tests.ParticleInitTests
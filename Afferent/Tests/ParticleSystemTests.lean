@@ -0,0 +1,137 @@
+/-
+  Afferent ParticleSystem Tests
+  Emission, lifetimes, forces and compaction of the native particle system
+  (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.ParticleSystem
+
+namespace Afferent.Tests.ParticleSystemTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "ParticleSystem Tests"
+
+/-- A still emitter at (100, 50) with a fixed long lifetime. -/
+private def stillEmitter : EmitterConfig :=
+  { x := 100.0, y := 50.0, rate := 0.0, speedMin := 0.0, speedMax := 0.0,
+    lifeMin := 10.0, lifeMax := 10.0, sizeStart := 3.0, sizeEnd := 3.0 }
+
+/-! ## Emission and lifetimes -/
+
+test "rate emits rate * elapsed particles" := do
+  let sys ← ParticleSystem.create 1000
+  let _ ← sys.addEmitter { stillEmitter with rate := 60.0 }
+  let buf ← FloatBuffer.create 4000
+  let mut live : UInt32 := 0
+  for _ in [0:30] do
+    live ← sys.step (1.0 / 60.0) buf
+  ensure (live == 30) s!"Expected 30 particles after 0.5s at 60/s, got {live}"
+  buf.destroy
+  sys.destroy
+
+test "burst is clamped to capacity and counts drops" := do
+  let sys ← ParticleSystem.create 100
+  let e ← sys.addEmitter stillEmitter
+  let spawned ← sys.burst e 150
+  ensure (spawned == 100) s!"Expected 100 spawned, got {spawned}"
+  let stats ← sys.stats
+  ensure (stats.live == 100) s!"Expected 100 live, got {stats.live}"
+  ensure (stats.totalDropped == 50) s!"Expected 50 dropped, got {stats.totalDropped}"
+  sys.destroy
+
+test "particles die after their lifetime" := do
+  let sys ← ParticleSystem.create 500
+  let e ← sys.addEmitter { stillEmitter with lifeMin := 0.5, lifeMax := 1.0 }
+  let _ ← sys.burst e 400
+  let buf ← FloatBuffer.create 2000
+  let mut live : UInt32 := 0
+  for _ in [0:70] do
+    live ← sys.step (1.0 / 60.0) buf
+  ensure (live == 0) s!"Expected all particles dead, {live} remain"
+  let stats ← sys.stats
+  ensure (stats.totalSpawned == 400 && stats.totalDied == 400)
+    s!"Expected 400 spawned and died, got {stats.totalSpawned} / {stats.totalDied}"
+  buf.destroy
+  sys.destroy
+
+test "live range stays dense while particles die" := do
+  let sys ← ParticleSystem.create 300
+  let e ← sys.addEmitter { stillEmitter with lifeMin := 0.1, lifeMax := 2.0 }
+  let _ ← sys.burst e 300
+  let buf ← FloatBuffer.create 1200
+  let live ← sys.step 0.9 buf
+  ensure (live > 0 && live < 300) s!"Expected some particles to die, live = {live}"
+  let data ← readBack buf (live.toNat * 4)
+  for i in [0:live.toNat] do
+    ensure (data[i * 4 + 3]! == 3.0) s!"Slot {i} is not a live particle"
+  buf.destroy
+  sys.destroy
+
+/-! ## Forces and ramps -/
+
+test "gravity accelerates particles" := do
+  let sys ← ParticleSystem.create 10
+  let e ← sys.addEmitter stillEmitter
+  sys.setGravity 0.0 100.0
+  let _ ← sys.burst e 1
+  let buf ← FloatBuffer.create 4
+  let _ ← sys.step 1.0 buf
+  let data ← readBack buf 4
+  shouldBeNear data[0]! 100.0
+  shouldBeNear data[1]! 150.0
+  buf.destroy
+  sys.destroy
+
+test "attractor pulls particles toward it" := do
+  let sys ← ParticleSystem.create 10
+  let e ← sys.addEmitter stillEmitter
+  let _ ← sys.addAttractor 200.0 50.0 100000.0
+  let _ ← sys.burst e 1
+  let buf ← FloatBuffer.create 4
+  let _ ← sys.step 0.1 buf
+  let data ← readBack buf 4
+  ensure (data[0]! > 100.0) s!"Expected x to move toward the attractor, got {data[0]!}"
+  shouldBeNear data[1]! 50.0
+  buf.destroy
+  sys.destroy
+
+test "size and hue ramp over life" := do
+  let sys ← ParticleSystem.create 10
+  let e ← sys.addEmitter { stillEmitter with lifeMin := 2.0, lifeMax := 2.0,
+    sizeStart := 4.0, sizeEnd := 0.0, hueStart := 0.0, hueEnd := 1.0,
+    alphaStart := 1.0, alphaEnd := 0.0 }
+  let _ ← sys.burst e 1
+  let buf ← FloatBuffer.create 5
+  let _ ← sys.step 1.0 buf .circles
+  let circle ← readBack buf 4
+  shouldBeNear circle[2]! 0.5
+  shouldBeNear circle[3]! 2.0
+  let _ ← sys.write buf .sprites
+  let sprite ← readBack buf 5
+  shouldBeNear sprite[3]! 2.0
+  shouldBeNear sprite[4]! 0.5
+  buf.destroy
+  sys.destroy
+
+test "same seed reproduces the same particles" := do
+  let run : IO (Array Float) := do
+    let sys ← ParticleSystem.create 200 42
+    let _ ← sys.addEmitter { rate := 600.0, x := 10.0, y := 10.0 }
+    let buf ← FloatBuffer.create 800
+    let mut live : UInt32 := 0
+    for _ in [0:20] do
+      live ← sys.step (1.0 / 60.0) buf
+    let data ← readBack buf (live.toNat * 4)
+    buf.destroy
+    sys.destroy
+    pure data
+  let a ← run
+  let b ← run
+  ensure (a.size > 0 && a == b) "Expected identical particle output for the same seed"
+
+#generate_tests
+
+end Afferent.Tests.ParticleSystemTests
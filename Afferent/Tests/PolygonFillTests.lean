@@ -0,0 +1,276 @@
+/-
+  Afferent Polygon Fill Tests
+  Non-convex, holed and self-intersecting fills through the native polygon
+  triangulator, checked by covered area under each fill rule.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Path
+import Afferent.Render.PolygonFill
+import Afferent.Canvas.State
+
+namespace Afferent.Tests.PolygonFillTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+open Afferent.Tessellation
+
+testSuite "Polygon Fill Tests"
+
+private def pi : Float := 3.14159265358979323846
+
+/-- Triangulate contours given as point arrays. -/
+private def triangulate (contours : Array (Array Point)) (rule : FillRule) :
+    IO (FloatArray × Array UInt32 × UInt8) := do
+  let mut coords : FloatArray := .empty
+  let mut ends : Array UInt32 := #[]
+  for contour in contours do
+    for p in contour do
+      coords := coords.push p.x |>.push p.y
+    ends := ends.push (coords.size / 2).toUInt32
+  FFI.Tessellator.triangulate coords ends (fillRuleCode rule)
+
+/-- Total area of the triangles (they never overlap, so this is the covered area). -/
+private def coveredArea (points : FloatArray) (indices : Array UInt32) : Float := Id.run do
+  let mut sum := 0.0
+  for t in [:indices.size / 3] do
+    let a := indices[3 * t]!.toNat
+    let b := indices[3 * t + 1]!.toNat
+    let c := indices[3 * t + 2]!.toNat
+    let (ax, ay) := (points[2 * a]!, points[2 * a + 1]!)
+    let (bx, by_) := (points[2 * b]!, points[2 * b + 1]!)
+    let (cx, cy) := (points[2 * c]!, points[2 * c + 1]!)
+    sum := sum + ((bx - ax) * (cy - ay) - (cx - ax) * (by_ - ay)).abs / 2
+  return sum
+
+private def shoelace (points : Array Point) : Float := Id.run do
+  let mut sum := 0.0
+  for i in [:points.size] do
+    let a := points[i]!
+    let b := points[(i + 1) % points.size]!
+    sum := sum + a.x * b.y - b.x * a.y
+  return sum.abs / 2
+
+private def near (a b : Float) : Bool := (a - b).abs <= 1e-6 * (1 + b.abs)
+
+private def square (x y size : Float) (clockwise : Bool := true) : Array Point :=
+  let corners := #[⟨x, y⟩, ⟨x + size, y⟩, ⟨x + size, y + size⟩, ⟨x, y + size⟩]
+  if clockwise then corners else corners.reverse
+
+/-- Vertices of a regular pentagon in star order ({5/2}). -/
+private def pentagram (center : Point) (radius : Float) : Array Point :=
+  (Array.range 5).map fun i =>
+    let angle := -pi / 2 + (i * 2 % 5).toFloat * 2 * pi / 5
+    ⟨center.x + radius * Float.cos angle, center.y + radius * Float.sin angle⟩
+
+/-- Vertices of the star polygon {n/k} of radius 80 about (200, 200), vertex
+    `i` at angle `rotation + 2π((i * k) % n) / n`. -/
+private def starPolygon (n k : Nat) (rotation : Float) : Array Point :=
+  (Array.range n).map fun i =>
+    let angle := rotation + 2 * pi * (i * k % n).toFloat / n.toFloat
+    ⟨200 + 80 * Float.cos angle, 200 + 80 * Float.sin angle⟩
+
+/-- Winding number of the closed polygon around `p`. -/
+private def windingAt (polygon : Array Point) (p : Point) : Int := Id.run do
+  let mut winding : Int := 0
+  for i in [:polygon.size] do
+    let a := polygon[i]!
+    let b := polygon[(i + 1) % polygon.size]!
+    let side := (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y)
+    if a.y <= p.y && b.y > p.y && side > 0 then winding := winding + 1
+    if a.y > p.y && b.y <= p.y && side < 0 then winding := winding - 1
+  return winding
+
+/-- Number of triangles with `p` strictly inside. -/
+private def coverageAt (points : FloatArray) (indices : Array UInt32) (p : Point) : Nat := Id.run do
+  let mut count := 0
+  for t in [:indices.size / 3] do
+    let corner := fun k =>
+      let i := indices[3 * t + k]!.toNat
+      (points[2 * i]!, points[2 * i + 1]!)
+    let (ax, ay) := corner 0
+    let (bx, by_) := corner 1
+    let (cx, cy) := corner 2
+    let d1 := (bx - ax) * (p.y - ay) - (by_ - ay) * (p.x - ax)
+    let d2 := (cx - bx) * (p.y - by_) - (cy - by_) * (p.x - bx)
+    let d3 := (ax - cx) * (p.y - cy) - (ay - cy) * (p.x - cx)
+    if (d1 > 0 && d2 > 0 && d3 > 0) || (d1 < 0 && d2 < 0 && d3 < 0) then count := count + 1
+  return count
+
+/-! ## Convexity Fast Path -/
+
+test "isConvexPolygon accepts convex outlines and rejects concave or multiply wound ones" := do
+  ensure (isConvexPolygon (pathToPolygon (Path.hexagon ⟨100, 100⟩ 50))) "Hexagon is convex"
+  ensure (isConvexPolygon (pathToPolygon (Path.circle ⟨100, 100⟩ 50))) "Circle is convex"
+  ensure (isConvexPolygon (square 0 0 10 ++ #[⟨0, 0⟩])) "A closing duplicate keeps it convex"
+  ensure (!isConvexPolygon (pathToPolygon (Path.star ⟨100, 100⟩ 50 25 5))) "Star is concave"
+  ensure (!isConvexPolygon (pentagram ⟨100, 100⟩ 50)) "Pentagram winds twice"
+
+test "convex paths keep the fan triangulation" := do
+  for path in [Path.hexagon ⟨100, 100⟩ 50, Path.circle ⟨620, 65⟩ 35,
+               Path.roundedRect (Rect.mk' 450 130 120 80) 10] do
+    let ref := tessellateConvexPathFillNDCWithOriginal path path (.solid Color.red) 1280 800
+    let result ← tessellatePathNDC path Color.red 1280 800
+    ensure (result.vertices.data == ref.vertices.data && result.indices == ref.indices)
+      s!"Convex fill changed for {repr path.commands}"
+
+test "pathToContours ends a contour at each moveTo and rect" := do
+  let path := Path.empty
+    |>.moveTo ⟨0, 0⟩ |>.lineTo ⟨10, 0⟩ |>.lineTo ⟨10, 10⟩ |>.closePath
+    |>.rect (Rect.mk' 20 20 5 5)
+    |>.moveTo ⟨40, 40⟩ |>.lineTo ⟨50, 40⟩ |>.lineTo ⟨50, 50⟩
+  let (points, ends) := pathToContours path
+  ensure (points.size == 10) s!"Expected 10 points, got {points.size}"
+  ensure (ends == #[3, 7, 10]) s!"Unexpected contour ends {ends}"
+
+/-! ## Triangulation by Fill Rule -/
+
+test "concave star is ear clipped with n - 2 triangles" := do
+  let outline := pathToPolygon (Path.star ⟨100, 100⟩ 50 20 7)
+  let (points, indices, method) ← triangulate #[outline] .nonZero
+  ensure (method == 1) s!"Expected ear clipping, got method {method}"
+  ensure (indices.size == (outline.size - 2) * 3) s!"Expected {outline.size - 2} triangles"
+  ensure (near (coveredArea points indices) (shoelace outline)) "Star area mismatch"
+
+test "opposite-direction hole is cut out under both rules" := do
+  for rule in [FillRule.nonZero, .evenOdd] do
+    let (points, indices, method) ← triangulate #[square 0 0 100, square 25 25 50 false] rule
+    ensure (method == 1) s!"Expected ear clipping, got method {method}"
+    ensure (near (coveredArea points indices) 7500) s!"Hole area mismatch for {repr rule}"
+
+test "same-direction inner ring is filled under nonZero and a hole under evenOdd" := do
+  let rings := #[square 0 0 100, square 25 25 50]
+  let (p1, i1, _) ← triangulate rings .nonZero
+  ensure (near (coveredArea p1 i1) 10000) s!"nonZero should fill it all, got {coveredArea p1 i1}"
+  let (p2, i2, _) ← triangulate rings .evenOdd
+  ensure (near (coveredArea p2 i2) 7500) s!"evenOdd should cut the hole, got {coveredArea p2 i2}"
+
+test "pentagram centre is filled under nonZero only" := do
+  let radius := 100.0
+  let star := pentagram ⟨200, 200⟩ radius
+  -- Outline area of the {5/2} star and of its inner pentagon
+  let inner := radius * Float.cos (2 * pi / 5) / Float.cos (pi / 5)
+  let outline := pathToPolygon (Path.star ⟨200, 200⟩ radius inner 5)
+  let pentagon := 2.5 * inner * inner * Float.sin (2 * pi / 5)
+  let (p1, i1, m1) ← triangulate #[star] .nonZero
+  ensure (m1 == 2) s!"Self-intersecting input should use the sweep, got method {m1}"
+  ensure (near (coveredArea p1 i1) (shoelace outline)) s!"nonZero area {coveredArea p1 i1}"
+  let (p2, i2, _) ← triangulate #[star] .evenOdd
+  ensure (near (coveredArea p2 i2) (shoelace outline - pentagon)) s!"evenOdd area {coveredArea p2 i2}"
+
+test "symmetric star polygons cover each filled sample exactly once" := do
+  -- Regular stars put vertex pairs and crossings on one row up to rounding
+  let stars : List (Nat × Nat) := [(10, 3), (14, 3), (14, 5), (18, 5), (20, 6), (22, 3), (22, 7),
+    (26, 5), (26, 7), (26, 9), (26, 11), (28, 6), (28, 10), (30, 7), (30, 9), (40, 12)]
+  for (n, k) in stars do
+    for rotation in [0.0, -pi / 2] do
+      let star := starPolygon n k rotation
+      for rule in [FillRule.nonZero, .evenOdd] do
+        let (points, indices, _) ← triangulate #[star] rule
+        let mut wrong := 0
+        -- 40x40 samples over the bounding box, kept off its 4-unit lattice
+        for sy in [:40] do
+          for sx in [:40] do
+            let p : Point := ⟨120 + (sx.toFloat + 0.37) * 4, 120 + (sy.toFloat + 0.61) * 4⟩
+            let winding := windingAt star p
+            let inside := if rule == .evenOdd then winding % 2 != 0 else winding != 0
+            if coverageAt points indices p != (if inside then 1 else 0) then wrong := wrong + 1
+        ensure (wrong == 0)
+          s!"Star {n}/{k} at rotation {rotation} under {repr rule}: {wrong} of 1600 samples wrong"
+
+test "bowtie fills both lobes" := do
+  let bowtie : Array Point := #[⟨0, 0⟩, ⟨100, 100⟩, ⟨100, 0⟩, ⟨0, 100⟩]
+  for rule in [FillRule.nonZero, .evenOdd] do
+    let (points, indices, _) ← triangulate #[bowtie] rule
+    ensure (near (coveredArea points indices) 5000) s!"Bowtie area mismatch for {repr rule}"
+
+test "degenerate input yields no triangles" := do
+  let (_, i1, m1) ← triangulate #[#[⟨0, 0⟩, ⟨10, 10⟩]] .nonZero
+  ensure (i1.isEmpty && m1 == 0) "Two points fill nothing"
+  let (_, i2, _) ← triangulate #[#[⟨0, 0⟩, ⟨10, 10⟩, ⟨20, 20⟩]] .nonZero
+  ensure i2.isEmpty "Collinear points fill nothing"
+
+test "triangulator rejects non-finite points and contour ends past the data" := do
+  ensure (← fails (FFI.Tessellator.triangulate ⟨#[0, 0, 0.0 / 0.0, 1, 1, 1]⟩ #[3] 0))
+    "Expected a NaN coordinate to fail"
+  ensure (← fails (FFI.Tessellator.triangulate ⟨#[0, 0, 1, 0, 1, 1]⟩ #[4] 0))
+    "Expected a contour end past the last point to fail"
+
+/-! ## NDC Fills -/
+
+test "non-convex fill samples gradients in original space" := do
+  let path := Path.star ⟨100, 100⟩ 50 20 5
+  let t := Transform.translate 300 0
+  let state := { CanvasState.default with transform := t }
+  let style := FillStyle.gradient (.linear ⟨50, 0⟩ ⟨150, 0⟩ #[⟨0, Color.black⟩, ⟨1, Color.white⟩])
+  let result ← tessellatePathFillNDC path (state.transformPath path) t style 1280 800
+  ensure (result.indices.size == 8 * 3) s!"Expected 8 triangles, got {result.indices.size / 3}"
+  for i in [:result.vertices.size / 6] do
+    let ndcX := result.vertices[6 * i]!
+    let x := (ndcX + 1) / 2 * 1280 - 300
+    let expected := ((x - 50) / 100).max 0 |>.min 1
+    ensure ((result.vertices[6 * i + 2]! - expected).abs < 1e-6)
+      s!"Vertex {i} at x={x} has red {result.vertices[6 * i + 2]!}, expected {expected}"
+
+test "convex fill under a non-uniform scale samples gradients at each vertex's original point" := do
+  let path := Path.circle ⟨100, 100⟩ 50
+  let t := Transform.scale 3 1
+  let state := { CanvasState.default with transform := t }
+  let style := FillStyle.gradient (.linear ⟨50, 0⟩ ⟨150, 0⟩ #[⟨0, Color.black⟩, ⟨1, Color.white⟩])
+  let result ← tessellatePathFillNDC path (state.transformPath path) t style 1280 800
+  ensure (result.vertices.size > 0) "Expected a fill"
+  for i in [:result.vertices.size / 6] do
+    let x := (result.vertices[6 * i]! + 1) / 2 * 1280 / 3
+    let expected := ((x - 50) / 100).max 0 |>.min 1
+    ensure ((result.vertices[6 * i + 2]! - expected).abs < 1e-6)
+      s!"Vertex {i} at original x={x} has red {result.vertices[6 * i + 2]!}, expected {expected}"
+
+/-! ## Fringe Anti-aliasing -/
+
+/-- Pixel position and alpha of vertex `i` of an NDC result on a `w`x`h` canvas. -/
+private def vertexAt (result : TessellationResult) (i : Nat) (w h : Float) : Point × Float :=
+  (⟨(result.vertices[6 * i]! + 1) / 2 * w, (1 - result.vertices[6 * i + 1]!) / 2 * h⟩,
+   result.vertices[6 * i + 5]!)
+
+/-- A path through each contour's points in turn, each contour closed. -/
+private def contoursPath (contours : Array (Array Point)) (rule : FillRule) : Path := Id.run do
+  let mut path := Path.empty
+  for contour in contours do
+    path := path.moveTo contour[0]!
+    for p in contour[1:] do
+      path := path.lineTo p
+    path := path.closePath
+  return { path with fillRule := rule }
+
+test "fringed fill insets the core and ramps alpha to zero one pixel out" := do
+  let center : Point := ⟨200, 200⟩
+  let path := Path.circle center 50
+  let plain ← tessellatePathNDC path Color.red 400 400
+  let fringed ← tessellatePathNDC path Color.red 400 400 (antialias := true)
+  let n := plain.vertices.size / 6
+  ensure (fringed.vertices.size / 6 == 3 * n && fringed.indices.size == plain.indices.size + 6 * n)
+    s!"Expected {3 * n} vertices, got {fringed.vertices.size / 6}"
+  for i in [:3 * n] do
+    let (p, alpha) := vertexAt fringed i 400 400
+    let r := Float.sqrt ((p.x - center.x) ^ 2 + (p.y - center.y) ^ 2)
+    -- Core, then an opaque inner and a transparent outer vertex per point
+    let (lo, hi, a) := if i < n || (i - n) % 2 == 0 then (49.47, 49.52, 1.0) else (50.48, 50.53, 0.0)
+    ensure (r > lo && r < hi && alpha == a) s!"Vertex {i} at radius {r} with alpha {alpha}"
+
+test "fringed holes ramp into the hole under both fill rules" := do
+  for (rule, clockwise) in [(FillRule.evenOdd, true), (FillRule.nonZero, false)] do
+    let path := contoursPath #[square 100 100 100, square 130 130 40 clockwise] rule
+    let result ← tessellatePathNDC path Color.red 400 400 (antialias := true)
+    let count := result.vertices.size / 6
+    -- The last 16 vertices are the fringe pairs: 4 outer-ring points, then 4 hole points
+    for k in [:8] do
+      let (outer, alpha) := vertexAt result (count - 16 + 2 * k + 1) 400 400
+      let inHole := outer.x > 130 && outer.x < 170 && outer.y > 130 && outer.y < 170
+      let outside := outer.x < 100 || outer.x > 200 || outer.y < 100 || outer.y > 200
+      ensure (alpha == 0 && if k < 4 then outside else inHole)
+        s!"Fringe point {k} at ({outer.x}, {outer.y}) is on the filled side"
+
+#generate_tests
+
+end Afferent.Tests.PolygonFillTests
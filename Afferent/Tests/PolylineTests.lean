@@ -0,0 +1,119 @@
+/-
+  Afferent Polyline Reduction Tests
+  The native reducer keeps what a stroke of the series shows: the extremes
+  of every pixel column for monotonic-x data, and a line within tolerance of
+  every dropped point otherwise, measured in pixels under the transform.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Transform
+import Afferent.Render.Polyline
+
+namespace Afferent.Tests.PolylineTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+
+testSuite "Polyline Reduction Tests"
+
+/-- `count` points with x rising evenly over [0, width) and a noisy wave for y. -/
+private def series (count : Nat) (width : Float) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (2 * count)
+  for i in [:count] do
+    let x := i.toFloat * width / count.toFloat
+    out := out.push x |>.push (50 + 30 * Float.sin (x * 0.7) + 5 * Float.sin (i.toFloat * 1.3))
+  out
+
+/-- A Lissajous figure: x reverses many times. -/
+private def lissajous (count : Nat) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (2 * count)
+  for i in [:count] do
+    let t := i.toFloat / count.toFloat * 6.283185307179586
+    out := out.push (200 + 150 * Float.sin (3 * t)) |>.push (200 + 150 * Float.sin (4 * t + 0.5))
+  out
+
+private def pointAt (points : FloatArray) (i : Nat) : Point :=
+  ⟨points[2 * i]!, points[2 * i + 1]!⟩
+
+private def segmentDistance (p a b : Point) : Float :=
+  let dx := b.x - a.x
+  let dy := b.y - a.y
+  let lenSq := dx * dx + dy * dy
+  let s := if lenSq > 0 then (((p.x - a.x) * dx + (p.y - a.y) * dy) / lenSq).max 0 |>.min 1 else 0
+  let ex := a.x + s * dx - p.x
+  let ey := a.y + s * dy - p.y
+  Float.sqrt (ex * ex + ey * ey)
+
+/-- Largest distance from an input point to the reduced polyline. -/
+private def maxDeviation (full reduced : FloatArray) : Float := Id.run do
+  let mut worst := 0.0
+  for i in [:full.size / 2] do
+    let p := pointAt full i
+    let mut best := 1.0 / 0.0
+    for k in [:reduced.size / 2 - 1] do
+      best := min best (segmentDistance p (pointAt reduced k) (pointAt reduced (k + 1)))
+    worst := max worst best
+  return worst
+
+/-! ## Min/max per column -/
+
+test "min/max reduction keeps the extremes of every pixel column" := do
+  let full := series 5000 20
+  let reduced ← Polyline.reduce full (method := .minMax)
+  -- 20 one-pixel columns, at most 4 points each
+  ensure (reduced.size / 2 <= 80) s!"Expected at most 80 points, got {reduced.size / 2}"
+  ensure (pointAt reduced 0 == pointAt full 0 &&
+      pointAt reduced (reduced.size / 2 - 1) == pointAt full (full.size / 2 - 1))
+    "First and last points should be kept"
+  for column in [:20] do
+    let inColumn (points : FloatArray) : Array Float := Id.run do
+      let mut ys := #[]
+      for i in [:points.size / 2] do
+        if (pointAt points i).x.floor == column.toFloat then ys := ys.push (pointAt points i).y
+      return ys
+    let fullYs := inColumn full
+    let keptYs := inColumn reduced
+    let lo (ys : Array Float) := ys.foldl min (1.0 / 0.0)
+    let hi (ys : Array Float) := ys.foldl max (-1.0 / 0.0)
+    ensure (lo keptYs == lo fullYs && hi keptYs == hi fullYs)
+      s!"Column {column} lost its extremes"
+
+test "columns are pixels under the transform" := do
+  let full := series 5000 20
+  let plain ← Polyline.reduce full (method := .minMax)
+  let zoomed ← Polyline.reduce full (Transform.scale 10 1) (method := .minMax)
+  ensure (zoomed.size > 4 * plain.size)
+    s!"10x zoom kept {zoomed.size / 2} points vs {plain.size / 2} unzoomed"
+
+/-! ## Ramer-Douglas-Peucker -/
+
+test "RDP keeps the reduced line within tolerance of every point" := do
+  let full := lissajous 4000
+  let reduced ← Polyline.reduce full (tolerance := 0.5) (method := .rdp)
+  ensure (reduced.size < full.size / 2) s!"Expected a reduction, kept {reduced.size / 2} of 4000"
+  -- Half a pixel from the radial pass plus half from the simplification
+  let deviation := maxDeviation full reduced
+  ensure (deviation <= 1.0 + 1e-9) s!"A dropped point is {deviation} px off the reduced line"
+
+test "auto picks min/max for monotonic x, under flips too, and RDP otherwise" := do
+  let flipped := Transform.scale (-1) 1
+  let monotonic := series 2000 20
+  let auto ← Polyline.reduce monotonic flipped
+  let minMax ← Polyline.reduce monotonic flipped (method := .minMax)
+  ensure (auto.data == minMax.data) "Monotonic series should use min/max"
+  let curve := lissajous 2000
+  let auto ← Polyline.reduce curve
+  let rdp ← Polyline.reduce curve (method := .rdp)
+  ensure (auto.data == rdp.data) "Non-monotonic series should use RDP"
+
+/-! ## Edge cases -/
+
+test "short polylines are kept and non-finite points rejected" := do
+  let two : FloatArray := ⟨#[0, 0, 0.1, 0.1]⟩
+  ensure ((← Polyline.reduce two).data == two.data) "Two points should be kept as they are"
+  ensure (← fails (Polyline.reduce ⟨#[0, 0, 0.0 / 0.0, 1, 2, 2]⟩)) "Expected NaN to be rejected"
+
+#generate_tests
+
+end Afferent.Tests.PolylineTests
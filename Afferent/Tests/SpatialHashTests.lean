@@ -0,0 +1,174 @@
+/-
+  Afferent SpatialHash Tests
+  Neighbor queries checked against brute force, plus collision resolution
+  invariants (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.FFI.SpatialHash
+
+namespace Afferent.Tests.SpatialHashTests
+
+open Crucible
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "SpatialHash Tests"
+
+/-- Deterministic pseudo-random particles: [x, y, vx, vy, 0] per particle. -/
+private def mkParticles (count : Nat) (extent : Float) (seed : UInt32 := 7) : IO (FloatBuffer × Array Float) := do
+  let buf ← FloatBuffer.create (count * 5).toUSize
+  let mut s := seed
+  let mut values : Array Float := #[]
+  for i in [0:count * 5] do
+    s := s * 1103515245 + 12345
+    let r := (s &&& 0x7FFFFFFF).toFloat / 2147483648.0
+    let v := if i % 5 < 2 then r * extent else if i % 5 < 4 then (r - 0.5) * 100.0 else 0.0
+    buf.set i.toUSize v
+    values := values.push v
+  pure (buf, values)
+
+/-! ## Queries -/
+
+test "radius query matches brute force" := do
+  let count := 400
+  let (buf, values) ← mkParticles count 100.0
+  let hash ← SpatialHash.create 5.0
+  hash.rebuild buf count.toUInt32 5
+  for q in [0:40] do
+    let x := values[q * 5]!
+    let y := values[q * 5 + 1]!
+    let r := if q % 2 == 0 then 4.0 else 17.0
+    let got ← hash.queryRadius x y r 4096
+    let mut expected := 0
+    for j in [0:count] do
+      let dx := values[j * 5]! - x
+      let dy := values[j * 5 + 1]! - y
+      if dx * dx + dy * dy <= r * r then expected := expected + 1
+    ensure (got.size == expected) s!"query {q}: expected {expected} neighbors, got {got.size}"
+    ensure (got.contains q.toUInt32) s!"query {q}: particle should find itself"
+  hash.destroy
+  buf.destroy
+
+test "pair query matches brute force and orders i < j" := do
+  let count := 300
+  let (buf, values) ← mkParticles count 80.0 11
+  let hash ← SpatialHash.create 3.0
+  hash.rebuild buf count.toUInt32 5
+  let radius := 6.0
+  let mut expected : Nat := 0
+  for i in [0:count] do
+    for j in [i + 1:count] do
+      let dx := values[j * 5]! - values[i * 5]!
+      let dy := values[j * 5 + 1]! - values[i * 5 + 1]!
+      if dx * dx + dy * dy <= radius * radius then expected := expected + 1
+  let counted ← hash.countPairs radius
+  let pairs ← hash.queryPairs radius 100000
+  hash.destroy
+  buf.destroy
+  ensure (counted.toNat == expected) s!"Expected {expected} pairs, countPairs gave {counted}"
+  ensure (pairs.size == 2 * expected) s!"Expected {2 * expected} indices, got {pairs.size}"
+  for k in [0:pairs.size / 2] do
+    ensure (pairs[2 * k]! < pairs[2 * k + 1]!) s!"pair {k} not ordered"
+
+test "pair query respects maxPairs" := do
+  let (buf, _) ← mkParticles 200 20.0
+  let hash ← SpatialHash.create 2.0
+  hash.rebuild buf 200 5
+  let pairs ← hash.queryPairs 5.0 10
+  hash.destroy
+  buf.destroy
+  ensure (pairs.size == 20) s!"Expected 10 pairs (20 indices), got {pairs.size}"
+
+test "pairs exactly radius apart are included" := do
+  let buf ← FloatBuffer.create 10
+  for (i, v) in [(0, 0.0), (1, 0.0), (5, 3.0), (6, 4.0)] do
+    buf.set i.toUSize v
+  let hash ← SpatialHash.create 2.0
+  hash.rebuild buf 2 5
+  let counted ← hash.countPairs 5.0
+  let pairs ← hash.queryPairs 5.0 10
+  hash.destroy
+  buf.destroy
+  ensure (counted == 1 && pairs == #[0, 1]) s!"Expected the pair 5 apart, got {pairs}"
+
+test "rebuild rejects a stride below 2" := do
+  let buf ← FloatBuffer.create 10
+  let hash ← SpatialHash.create 1.0
+  let rejected ← fails (hash.rebuild buf 5 1)
+  hash.destroy
+  buf.destroy
+  ensure rejected "Expected stride 1 to fail"
+
+test "sparse bounds coarsen the grid instead of exploding memory" := do
+  let buf ← FloatBuffer.create 10
+  buf.set 0 0.0
+  buf.set 1 0.0
+  buf.set 5 1.0e7
+  buf.set 6 1.0e7
+  let hash ← SpatialHash.create 1.0
+  hash.rebuild buf 2 5
+  let cell ← hash.cellSize
+  let near ← hash.queryRadius 1.0e7 1.0e7 1.0
+  hash.destroy
+  buf.destroy
+  ensure (cell > 1.0) s!"Expected a coarsened cell size, got {cell}"
+  ensure (near == #[1]) s!"Expected only particle 1 near the far corner, got {near}"
+
+test "queries wholly outside the grid find nothing" := do
+  let buf ← FloatBuffer.create 20
+  for (i, v) in [(0, 0.0), (1, 0.0), (5, 10.0), (6, 0.0), (10, 0.0), (11, 10.0),
+                 (15, 10.0), (16, 10.0)] do
+    buf.set i.toUSize v
+  let hash ← SpatialHash.create 1.0
+  hash.rebuild buf 4 5
+  let mut hits : Array UInt32 := #[]
+  for (x, y) in [(1.0e9, 5.0), (-1.0e9, 5.0), (5.0, 1.0e9), (5.0, -1.0e9),
+                 (1.0e9, 1.0e9), (-1.0e9, -1.0e9), (20.0, 5.0), (5.0, -10.0)] do
+    hits := hits ++ (← hash.queryRadius x y 1.0)
+  hash.destroy
+  buf.destroy
+  ensure hits.isEmpty s!"Expected no particles outside the grid, got {hits}"
+
+/-! ## Collisions -/
+
+test "head-on elastic collision swaps velocities and separates discs" := do
+  let buf ← FloatBuffer.create 10
+  -- Two discs of radius 2 overlapping by 1, moving toward each other
+  for (i, v) in [(0, 10.0), (1, 5.0), (2, 3.0), (3, 0.0),
+                 (5, 13.0), (6, 5.0), (7, -1.0), (8, 0.0)] do
+    buf.set i.toUSize v
+  let hash ← SpatialHash.create 4.0
+  let contacts ← hash.resolveCollisions buf 2 5 2.0 1.0
+  let data ← readBack buf 10
+  hash.destroy
+  buf.destroy
+  ensure (contacts == 1) s!"Expected 1 contact, got {contacts}"
+  shouldBeNear data[2]! (-1.0)
+  shouldBeNear data[7]! 3.0
+  shouldBeNear (data[5]! - data[0]!) 4.0
+
+test "collision resolution conserves momentum" := do
+  let count := 500
+  let (buf, _) ← mkParticles count 60.0 3
+  let before ← readBack buf (count * 5)
+  let hash ← SpatialHash.create 2.0
+  let contacts ← hash.resolveCollisions buf count.toUInt32 5 1.0
+  let after ← readBack buf (count * 5)
+  hash.destroy
+  buf.destroy
+  let mut px0 := 0.0
+  let mut py0 := 0.0
+  let mut px1 := 0.0
+  let mut py1 := 0.0
+  for i in [0:count] do
+    px0 := px0 + before[i * 5 + 2]!
+    py0 := py0 + before[i * 5 + 3]!
+    px1 := px1 + after[i * 5 + 2]!
+    py1 := py1 + after[i * 5 + 3]!
+  ensure (contacts > 0) "Expected some contacts in a dense cloud"
+  ensure ((px0 - px1).abs < 0.01 && (py0 - py1).abs < 0.01)
+    s!"Momentum changed: ({px0}, {py0}) -> ({px1}, {py1})"
+
+#generate_tests
+
+end Afferent.Tests.SpatialHashTests
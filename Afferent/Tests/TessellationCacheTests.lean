@@ -0,0 +1,143 @@
+/-
+  Afferent Tessellation Cache Tests
+  Cached fills and strokes match uncached tessellation under the transforms
+  they are reused for, and the cache keeps to its byte budget in LRU order.
+-/
+import Afferent.Tests.Framework
+import Afferent.Core.Types
+import Afferent.Core.Path
+import Afferent.Canvas.State
+import Afferent.Canvas.TessellationCache
+
+namespace Afferent.Tests.TessellationCacheTests
+
+open Crucible
+open Afferent
+open Afferent.Tests
+
+testSuite "Tessellation Cache Tests"
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+private def stateWith (t : Transform) : CanvasState :=
+  { CanvasState.default with transform := t }
+
+private def stroke (width : Float) : StrokeStyle :=
+  { StrokeStyle.default with color := Color.white, lineWidth := width }
+
+/-! ## Reuse -/
+
+test "second fill of a path is a hit and matches the uncached fill" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let path := Path.roundedRect (Rect.mk' 10 20 120 60) 12
+  for t in [Transform.identity, Transform.translate 300 150] do
+    let state := stateWith t
+    let ref ← Tessellation.tessellatePathFillNDC path (state.transformPath path) t (.solid Color.red)
+      canvasW canvasH
+    let first ← TessellationCache.fillPath cache path state (.solid Color.red) canvasW canvasH
+    let second ← TessellationCache.fillPath cache path state (.solid Color.red) canvasW canvasH
+    ensure (sameGeometry first ref && sameGeometry second ref) s!"Cached fill differs under {repr t}"
+  let stats := (← cache.get).stats
+  ensure (stats.misses == 1 && stats.hits == 3 && stats.entries == 1)
+    s!"Expected 1 miss and 3 hits, got {repr stats}"
+
+test "concave fill with a gradient is reused under a translation" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let path := Path.star ⟨100, 100⟩ 50 20 5
+  let style := FillStyle.gradient (.linear ⟨50, 0⟩ ⟨150, 0⟩ #[⟨0, Color.black⟩, ⟨1, Color.white⟩])
+  discard <| TessellationCache.fillPath cache path CanvasState.default style canvasW canvasH
+  let state := stateWith (Transform.translate 300 40)
+  let ref ← Tessellation.tessellatePathFillNDC path (state.transformPath path) state.transform style
+    canvasW canvasH
+  let cached ← TessellationCache.fillPath cache path state style canvasW canvasH
+  ensure (sameGeometry cached ref) "Translated gradient fill differs from the uncached fill"
+  ensure ((← cache.get).hits == 1) "Expected the translated fill to hit"
+
+test "stroke is reused under rotation at the same scale" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let path := Path.circle ⟨60, 60⟩ 40
+  let t := (Transform.rotate 0.6).scaled 2 2 |>.translated 100 50
+  let state := stateWith t
+  let ref := Tessellation.tessellateStrokeNDC (state.transformPath path) (stroke 3) canvasW canvasH
+  let first ← TessellationCache.strokePath cache path state (stroke 3) canvasW canvasH
+  let moved := stateWith ((Transform.rotate 2.0).scaled 2 2 |>.translated 400 300)
+  let second ← TessellationCache.strokePath cache path moved (stroke 3) canvasW canvasH
+  let movedRef := Tessellation.tessellateStrokeNDC (moved.transformPath path) (stroke 3) canvasW canvasH
+  ensure (first.indices == ref.indices && second.indices == movedRef.indices) "Stroke topology differs"
+  for i in [:ref.vertices.size] do
+    -- The snapped scale leaves a width error far below a float32 ulp
+    ensure ((first.vertices[i]! - ref.vertices[i]!).abs < 1e-7) s!"Rotated stroke float {i} differs"
+    ensure ((second.vertices[i]! - movedRef.vertices[i]!).abs < 1e-7) s!"Moved stroke float {i} differs"
+  ensure ((← cache.get).hits == 1) "Expected the second stroke to hit"
+
+test "fill under a scale flattens within tolerance of its scale class" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let path := Path.circle ⟨0, 0⟩ 10
+  for s in [1.5, 1.6] do
+    let state := stateWith (Transform.scale s s)
+    let ref ← Tessellation.tessellatePathFillNDC path (state.transformPath path) state.transform
+      (.solid Color.red) canvasW canvasH
+    let cached ← TessellationCache.fillPath cache path state (.solid Color.red) canvasW canvasH
+    ensure (cached.vertices.size >= ref.vertices.size)
+      s!"Scale {s}: cached fill has fewer vertices ({cached.vertices.size}) than the uncached one"
+  -- 1.5 and 1.6 both round up to 2^(3/4)
+  let stats := (← cache.get).stats
+  ensure (stats.misses == 1 && stats.hits == 1) s!"Expected one shared entry, got {repr stats}"
+
+test "style, fill rule and stroke scale are part of the key" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let path := Path.star ⟨100, 100⟩ 50 20 5
+  discard <| TessellationCache.fillPath cache path CanvasState.default (.solid Color.red) canvasW canvasH
+  discard <| TessellationCache.fillPath cache path CanvasState.default (.solid Color.blue) canvasW canvasH
+  discard <| TessellationCache.fillPath cache (path.withFillRule .evenOdd) CanvasState.default
+    (.solid Color.red) canvasW canvasH
+  discard <| TessellationCache.strokePath cache path CanvasState.default (stroke 1) canvasW canvasH
+  discard <| TessellationCache.strokePath cache path (stateWith (Transform.scale 2 2)) (stroke 1)
+    canvasW canvasH
+  let stats := (← cache.get).stats
+  ensure (stats.hits == 0 && stats.entries == 5) s!"Expected 5 distinct entries, got {repr stats}"
+
+test "strokes under non-uniform scale and scaled rects bypass the cache" := do
+  let cache ← IO.mkRef TessellationCache.empty
+  let skewed := stateWith (Transform.scale 2 1)
+  let path := Path.circle ⟨60, 60⟩ 40
+  let ref := Tessellation.tessellateStrokeNDC (skewed.transformPath path) (stroke 2) canvasW canvasH
+  let result ← TessellationCache.strokePath cache path skewed (stroke 2) canvasW canvasH
+  ensure (sameGeometry result ref) "Bypassed stroke differs from the uncached stroke"
+  discard <| TessellationCache.fillPath cache (Path.empty.rect (Rect.mk' 0 0 10 10))
+    (stateWith (Transform.scale 2 2)) (.solid Color.red) canvasW canvasH
+  let stats := (← cache.get).stats
+  ensure (stats.bypasses == 2 && stats.entries == 0) s!"Expected 2 bypasses, got {repr stats}"
+
+/-! ## Eviction -/
+
+test "least recently used entries are evicted to stay within the budget" := do
+  let result ← Tessellation.tessellatePathNDC (Path.circle ⟨0, 0⟩ 20) Color.red canvasW canvasH
+  let entry := TessellationCache.entryBytes result
+  let keyFor (i : Nat) : TessellationKey :=
+    { commands := #[.moveTo ⟨i.toFloat, 0⟩], fillRule := .nonZero, style := .fill (.solid Color.red),
+      scale := 1 }
+  let mut cache := TessellationCache.empty (entry * 4)
+  for i in [:4] do
+    cache := cache.insert (keyFor i).hash (keyFor i) result
+  -- Touch entry 0 so entry 1 is the least recently used
+  let (hit, touched) := cache.find? (keyFor 0).hash (keyFor 0)
+  ensure hit.isSome "Expected entry 0 to be cached"
+  cache := touched.insert (keyFor 4).hash (keyFor 4) result
+  ensure (cache.bytes <= entry * 4) s!"Cache holds {cache.bytes} bytes, budget {entry * 4}"
+  ensure (cache.find? (keyFor 0).hash (keyFor 0)).1.isSome "Recently used entry 0 was evicted"
+  ensure (cache.find? (keyFor 4).hash (keyFor 4)).1.isSome "Newest entry 4 was evicted"
+  ensure (cache.find? (keyFor 1).hash (keyFor 1)).1.isNone "Least recently used entry 1 was kept"
+  ensure (cache.evictions >= 1) "Expected an eviction"
+
+test "geometry larger than the budget is not stored" := do
+  let result ← Tessellation.tessellatePathNDC (Path.circle ⟨0, 0⟩ 20) Color.red canvasW canvasH
+  let key : TessellationKey :=
+    { commands := #[], fillRule := .nonZero, style := .fill (.solid Color.red), scale := 1 }
+  let cache := (TessellationCache.empty 16).insert key.hash key result
+  ensure (cache.entries.size == 0 && cache.bytes == 0) "Oversized entry was stored"
+
+#generate_tests
+
+end Afferent.Tests.TessellationCacheTests
@@ -7,6 +7,8 @@ import Afferent.Core.Types
 import Afferent.Core.Path
 import Afferent.Core.Paint
 import Afferent.Render.Tessellation
+import Afferent.Render.NativeTessellation
+import Afferent.Canvas.State
 
 
 namespace Afferent.Tests.TessellationTests
@@ -149,6 +151,106 @@ test "flattenCubicBezier ends at p3" := do
   shouldBeNear lastPt.x 150.0
   shouldBeNear lastPt.y 50.0
 
+/-- Point on a cubic Bezier at t, by the Bernstein form. -/
+private def cubicAt (p0 p1 p2 p3 : Point) (t : Float) : Point :=
+  let u := 1 - t
+  let w0 := u * u * u
+  let w1 := 3 * u * u * t
+  let w2 := 3 * u * t * t
+  let w3 := t * t * t
+  ⟨w0 * p0.x + w1 * p1.x + w2 * p2.x + w3 * p3.x, w0 * p0.y + w1 * p1.y + w2 * p2.y + w3 * p3.y⟩
+
+/-- Distance from p to the segment ab. -/
+private def segmentDistance (p a b : Point) : Float :=
+  let dx := b.x - a.x
+  let dy := b.y - a.y
+  let len2 := dx * dx + dy * dy
+  let t := if len2 > 0 then (((p.x - a.x) * dx + (p.y - a.y) * dy) / len2).max 0 |>.min 1 else 0
+  Point.distance p ⟨a.x + t * dx, a.y + t * dy⟩
+
+test "flattenCubicBezier emits the Wang's formula segment count" := do
+  -- Second differences (100,-100) and (-100,-100): ⌈√(0.75 · 141.42 / 0.5)⌉ = 15
+  let result := flattenCubicBezier ⟨0, 0⟩ ⟨0, 100⟩ ⟨100, 100⟩ ⟨100, 0⟩ 0.5
+  ensure (result.size == 15) s!"Expected 15 points, got {result.size}"
+  ensure (cubicSegmentCount ⟨0, 0⟩ ⟨0, 100⟩ ⟨100, 100⟩ ⟨100, 0⟩ 0.5 == 15) "Segment count mismatch"
+  let nan := 0.0 / 0.0
+  ensure ((flattenCubicBezier ⟨0, 0⟩ ⟨nan, 0⟩ ⟨1, 1⟩ ⟨2, 0⟩).size == 1) "NaN control points emit one segment"
+  ensure ((flattenCubicBezier ⟨0, 0⟩ ⟨1.0e30, 0⟩ ⟨1, 1⟩ ⟨2, 0⟩).size == maxCurveSegments)
+    "Huge control points are clamped"
+
+test "flattened cubic and quadratic stay within tolerance of the curve" := do
+  let curves : Array (Point × Point × Point × Point) := #[
+    (⟨0, 0⟩, ⟨0, 100⟩, ⟨100, 100⟩, ⟨100, 0⟩),
+    (⟨10, 300⟩, ⟨400, -200⟩, ⟨-200, -200⟩, ⟨300, 300⟩),
+    (⟨0, 0⟩, ⟨800, 10⟩, ⟨-10, 600⟩, ⟨700, 700⟩)]
+  for (p0, p1, p2, p3) in curves do
+    for tolerance in [0.1, 0.5, 2.0] do
+      let flat := #[p0] ++ flattenCubicBezier p0 p1 p2 p3 tolerance
+      for s in [:201] do
+        let q := cubicAt p0 p1 p2 p3 (s.toFloat / 200)
+        let mut best := 1.0e30
+        for i in [:flat.size - 1] do
+          best := best.min (segmentDistance q flat[i]! flat[i + 1]!)
+        ensure (best <= tolerance) s!"Curve point {s} is {best} from the polyline (tolerance {tolerance})"
+  -- A quadratic flattens like its degree-elevated cubic, with fewer segments
+  let quad := flattenQuadraticBezier ⟨0, 0⟩ ⟨50, 100⟩ ⟨100, 0⟩ 0.5
+  let cubic := flattenCubicBezier ⟨0, 0⟩ (Point.lerp ⟨0, 0⟩ ⟨50, 100⟩ (2.0 / 3.0))
+    (Point.lerp ⟨100, 0⟩ ⟨50, 100⟩ (2.0 / 3.0)) ⟨100, 0⟩ 0.5
+  ensure (quad.size <= cubic.size) s!"Quadratic used {quad.size} segments, cubic {cubic.size}"
+  for p in quad do
+    -- Every point lies on y = 2x - x²/50
+    ensure ((p.y - (2 * p.x - p.x * p.x / 50)).abs < 1e-9) s!"Point {p.x},{p.y} is off the parabola"
+
+test "segment count is unchanged when tolerance scales with the transform" := do
+  let t := Transform.rotate 0.7 |>.scaled 3 3
+  shouldBeNear t.maxScale 3.0
+  shouldBeNear (Transform.scale 2 5).maxScale 5.0
+  let path := Path.circle ⟨100, 100⟩ 40
+  let state := { CanvasState.default with transform := t }
+  let original := pathToPolygon path (0.5 / t.maxScale)
+  let transformed := pathToPolygon (state.transformPath path) 0.5
+  ensure (original.size == transformed.size)
+    s!"Original flattened to {original.size} points, transformed to {transformed.size}"
+
+/-! ## Arc Flattening Tests -/
+
+test "circle segment count follows its on-screen radius" := do
+  let dot := pathToPolygon (Path.circle ⟨10, 10⟩ 0.2)
+  ensure (dot.size <= 5) s!"A sub-pixel dot should stay a diamond, got {dot.size} points"
+  let small := pathToPolygon (Path.circle ⟨0, 0⟩ 10)
+  let state := { CanvasState.default with transform := Transform.scale 8 8 }
+  let zoomed := pathToPolygon (state.transformPath (Path.circle ⟨0, 0⟩ 10))
+  ensure (zoomed.size > small.size) s!"Zoomed circle got {zoomed.size} points, unzoomed {small.size}"
+  for p in zoomed do
+    let r := Float.sqrt (p.x * p.x + p.y * p.y)
+    ensure ((r - 80).abs < 1e-9) s!"Point {p.x},{p.y} is off the scaled circle"
+
+test "flattened circle stays within tolerance of the circle" := do
+  for radius in [3.0, 40.0, 900.0] do
+    let points := pathToPolygon (Path.circle ⟨0, 0⟩ radius)
+    for i in [:points.size] do
+      let a := points[i]!
+      let b := points[(i + 1) % points.size]!
+      let mid : Point := ⟨(a.x + b.x) / 2, (a.y + b.y) / 2⟩
+      let sag := radius - Float.sqrt (mid.x * mid.x + mid.y * mid.y)
+      ensure (sag <= 0.5 + 1e-9) s!"Chord {i} of radius {radius} strays {sag} from the circle"
+
+test "transformed circle closes exactly on its first point" := do
+  let t := Transform.translate 40 25 |>.rotated 0.3 |>.scaled 1.5 0.75
+  let state := { CanvasState.default with transform := t }
+  let (points, closed) := pathToPolygonWithClosed (state.transformPath (Path.circle ⟨100, 80⟩ 30))
+  ensure closed "Circle should be closed"
+  ensure (points.back! == points[0]!) "Closing point should repeat the first point exactly"
+
+test "arc under a non-uniform scale lies on the ellipse" := do
+  let path := Path.empty |>.moveTo ⟨20, 0⟩ |>.arc ⟨0, 0⟩ 20 0 3
+  let state := { CanvasState.default with transform := Transform.scale 4 1 }
+  let points := pathToPolygon (state.transformPath path)
+  ensure (points.size > 3) s!"Expected a stretched arc, got {points.size} points"
+  for p in points do
+    let e := (p.x / 80) * (p.x / 80) + (p.y / 20) * (p.y / 20)
+    ensure ((e - 1).abs < 1e-9) s!"Point {p.x},{p.y} is off the 80x20 ellipse"
+
 /-! ## Gradient Sampling Tests -/
 
 test "interpolateGradientStops at t=0 returns first color" := do
@@ -278,6 +380,49 @@ test "tessellateStroke handles closed paths" := do
   ensure (result.vertices.size > 0) "Should produce vertices for closed path"
   ensure (result.indices.size > 0) "Should produce indices for closed path"
 
+/-! ## Fringe Anti-aliasing Tests -/
+
+/-- Pixel x, y and alpha of vertex `i` of an NDC result on a 200x100 canvas. -/
+private def fringeVertex (result : TessellationResult) (i : Nat) : Float × Float × Float :=
+  ((result.vertices[6 * i]! + 1) / 2 * 200, (1 - result.vertices[6 * i + 1]!) / 2 * 100,
+   result.vertices[6 * i + 5]!)
+
+test "fringed stroke ramps alpha out half a pixel past each side and end" := do
+  let path := Path.empty |>.moveTo ⟨10, 50⟩ |>.lineTo ⟨110, 50⟩
+  let style := { StrokeStyle.default with lineWidth := 4.0 }
+  let result := tessellateStrokeNDC path style 200 100 (antialias := true)
+  -- Core L0, R0, L1, R1, then the outer ring in the same order
+  let expected : Array (Float × Float × Float) := #[
+    (10.5, 51.5, 1), (10.5, 48.5, 1), (109.5, 51.5, 1), (109.5, 48.5, 1),
+    (9.5, 52.5, 0), (9.5, 47.5, 0), (110.5, 52.5, 0), (110.5, 47.5, 0)]
+  ensure (result.vertices.size == 8 * 6) s!"Expected 8 vertices, got {result.vertices.size / 6}"
+  for i in [:8] do
+    let (x, y, a) := fringeVertex result i
+    let (ex, ey, ea) := expected[i]!
+    ensure ((x - ex).abs < 1e-9 && (y - ey).abs < 1e-9 && a == ea)
+      s!"Vertex {i} is ({x}, {y}, alpha {a}), expected ({ex}, {ey}, alpha {ea})"
+  -- Core quad, two side fringes and two end fringes
+  ensure (result.indices.size == 5 * 6) s!"Expected 30 indices, got {result.indices.size}"
+
+test "strokes thinner than the fringe keep their coverage" := do
+  let path := Path.empty |>.moveTo ⟨10, 50⟩ |>.lineTo ⟨110, 50⟩
+  let style := { StrokeStyle.default with lineWidth := 0.5 }
+  let result := tessellateStrokeNDC path style 200 100 (antialias := true)
+  let (_, y0, a0) := fringeVertex result 0
+  let (_, y1, _) := fringeVertex result 1
+  -- Zero-width core at 2/3 alpha: the 1.5px ramp covers as much as 0.5px opaque
+  ensure ((y0 - 50).abs < 1e-9 && (y1 - 50).abs < 1e-9) "Core should collapse onto the line"
+  ensure ((a0 - 2 / 3).abs < 1e-9) s!"Expected alpha 2/3, got {a0}"
+  ensure (result.indices.size == 4 * 6) s!"Expected only fringe quads, got {result.indices.size} indices"
+
+test "fringed closed stroke has side fringes but no end fringes" := do
+  let style := { StrokeStyle.default with lineWidth := 2.0 }
+  let result := tessellateStrokeNDC (Path.rectangle (Rect.mk' 20 20 100 50)) style 200 100
+    (antialias := true)
+  -- 5 edge pairs (the first point repeats to close): 4 core quads and 8 side fringes
+  ensure (result.vertices.size == 20 * 6) s!"Expected 20 vertices, got {result.vertices.size / 6}"
+  ensure (result.indices.size == 12 * 6) s!"Expected 72 indices, got {result.indices.size}"
+
 /-! ## Convex Path Tessellation Tests -/
 
 test "tessellateConvexPath produces correct output for triangle" := do
@@ -296,6 +441,124 @@ test "tessellateConvexPath produces correct output for hexagon" := do
   -- 4 triangles (fan from first vertex) = 12 indices
   ensure (result.indices.size == 12) s!"Expected 12 indices, got {result.indices.size}"
 
+/-! ## Batch Tests -/
+
+test "Batch.add appends vertices and offsets indices" := do
+  let a := tessellateRect (Rect.mk' 0 0 10 10) Color.red
+  let b := tessellateRect (Rect.mk' 20 0 10 10) Color.blue
+  let batch := (Batch.empty.add a).add b
+  ensure (batch.vertices.size == 48) s!"Expected 48 floats, got {batch.vertices.size}"
+  ensure (batch.vertexCount == 8) s!"Expected 8 vertices, got {batch.vertexCount}"
+  -- Second rect's vertices follow the first, unchanged
+  for i in [:24] do
+    ensure (batch.vertices[24 + i]! == b.vertices[i]!) s!"Vertex float {i} of second rect differs"
+  ensure (batch.indices[6]! == 4) s!"Expected remapped index 4, got {batch.indices[6]!}"
+
+test "Batch.append concatenates two batches" := do
+  let b1 := Batch.empty.add (tessellateRect (Rect.mk' 0 0 10 10) Color.red)
+  let b2 := Batch.empty.add (tessellateRect (Rect.mk' 5 5 10 10) Color.green)
+  let both := b1.append b2
+  ensure (both.vertices.size == 48) s!"Expected 48 floats, got {both.vertices.size}"
+  ensure (both.indices.size == 12) s!"Expected 12 indices, got {both.indices.size}"
+  shouldBeNear both.vertices[24]! 5.0
+
+test "Batch indices start as 16-bit" := do
+  let batch := Batch.empty.addRectDirect 10 10 0 5 Color.red 100 100
+  ensure (batch.indexFormat == .u16) "Expected u16 indices for a small batch"
+  ensure (batch.indexData.size == 12) s!"Expected 12 bytes for 6 indices, got {batch.indexData.size}"
+  ensure (batch.indices == #[0, 1, 2, 0, 2, 3]) s!"Unexpected indices {batch.indices}"
+
+test "Batch widens to 32-bit indices past 65536 vertices" := do
+  let mut batch := Batch.withCapacity 16384
+  for i in [:16384] do
+    batch := batch.addRectDirect i.toFloat 0 0 1 Color.red 100 100
+  ensure (batch.indexFormat == .u16) "65536 vertices still fit in u16"
+  ensure (batch.indexAt (batch.indexCount - 1) == 65535) "Last index should be 65535"
+  batch := batch.add (tessellateRect (Rect.mk' 0 0 10 10) Color.blue)
+  ensure (batch.indexFormat == .u32) "Expected u32 indices after 65536 vertices"
+  ensure (batch.indexCount == 16385 * 6) s!"Expected {16385 * 6} indices, got {batch.indexCount}"
+  ensure (batch.indexAt 6 == 4) "Earlier indices should survive widening"
+  ensure (batch.indexAt (batch.indexCount - 1) == 65539) s!"Expected 65539, got {batch.indexAt (batch.indexCount - 1)}"
+
+/-! ## Native Tessellator Parity -/
+
+/-- Paths covering every command: lines, quadratics, cubics, arcs, rects, arcTo. -/
+private def parityPaths : Array Path := #[
+  Path.triangle ⟨50, 0⟩ ⟨0, 100⟩ ⟨100, 100⟩,
+  Path.hexagon ⟨100, 100⟩ 50,
+  Path.star ⟨550, 300⟩ 50 25 5,
+  Path.polygon ⟨260, 420⟩ 40 5,
+  Path.circle ⟨620, 65⟩ 35,
+  Path.ellipse ⟨250, 300⟩ 30 50,
+  Path.roundedRect (Rect.mk' 450 130 120 80) 10,
+  Path.rectangle (Rect.mk' 50 30 100 70),
+  Path.heart ⟨560, 420⟩ 60,
+  Path.empty |>.moveTo ⟨10, 10⟩ |>.quadraticCurveTo ⟨80, 0⟩ ⟨150, 60⟩ |>.lineTo ⟨40, 90⟩,
+  Path.empty |>.moveTo ⟨0, 0⟩ |>.arcTo ⟨50, 0⟩ ⟨50, 50⟩ 10 |>.lineTo ⟨0, 50⟩ |>.closePath,
+  Path.empty |>.moveTo ⟨300, 200⟩ |>.arc ⟨300, 200⟩ 60 0.4 2.2 false |>.closePath,
+  Path.pie ⟨400, 300⟩ 45 (-0.5) 4.0,
+  Path.arcPath ⟨200, 500⟩ 70 3.5 0.2,
+  { Path.empty with commands := #[.rect (Rect.mk' 5 5 40 30)] }
+]
+
+/-- Run a writer builder and return the writer's vertices and decoded indices. -/
+private def runNative (m : VertexWriterM Unit) : IO (FloatArray × Array UInt32) := do
+  let w ← FFI.VertexWriter.create
+  m.run w
+  let bytes ← w.indexBytes
+  let format := if (← w.stats).indexWidth == 2 then IndexFormat.u16 else IndexFormat.u32
+  let vertices ← w.vertices
+  w.destroy
+  pure (vertices, (Array.range (bytes.size / format.bytesPerIndex)).map (format.get bytes))
+
+/-- Same topology and float32-equal vertices. -/
+private def sameAs (result : TessellationResult) (out : FloatArray × Array UInt32) : Bool := Id.run do
+  let (vertices, indices) := out
+  if vertices.size != result.vertices.size || indices != result.indices then return false
+  for i in [:vertices.size] do
+    let ref := result.vertices[i]!
+    if (vertices[i]! - ref).abs > 1e-6 * (1 + ref.abs) then return false
+  return true
+
+test "native fill matches tessellateConvexPathNDC" := do
+  for path in parityPaths do
+    let ref := tessellateConvexPathNDC path Color.green 1280 800
+    let out ← runNative (VertexWriterM.emitFillPath path Color.green 1280 800)
+    ensure (sameAs ref out) s!"Fill mismatch for {repr path.commands}"
+
+test "native stroke matches tessellateStrokeNDC for every cap and join" := do
+  for path in parityPaths do
+    for cap in [LineCap.butt, .square, .round] do
+      for join in [LineJoin.miter, .bevel, .round] do
+        let style := { StrokeStyle.default with lineWidth := 3, lineCap := cap, lineJoin := join, miterLimit := 4 }
+        let ref := tessellateStrokeNDC path style 1280 800
+        let out ← runNative (VertexWriterM.emitStrokePath path style 1280 800)
+        ensure (sameAs ref out) s!"Stroke mismatch ({repr cap}, {repr join}) for {repr path.commands}"
+
+test "native tessellation applies the transform like transformPath" := do
+  let t := Transform.translate 40 25 |>.rotated 0.3 |>.scaled 1.5 0.75
+  let state := { CanvasState.default with transform := t }
+  for path in parityPaths do
+    let fillRef := tessellateConvexPathNDC (state.transformPath path) Color.red 1280 800
+    ensure (sameAs fillRef (← runNative (VertexWriterM.emitFillPath path Color.red 1280 800 t)))
+      s!"Transformed fill mismatch for {repr path.commands}"
+    let strokeRef := tessellateStrokeNDC (state.transformPath path) StrokeStyle.default 1280 800
+    ensure (sameAs strokeRef (← runNative (VertexWriterM.emitStrokePath path StrokeStyle.default 1280 800 t)))
+      s!"Transformed stroke mismatch for {repr path.commands}"
+
+test "native tessellation keeps pixel coordinates without a canvas size" := do
+  let path := Path.hexagon ⟨100, 100⟩ 50
+  ensure (sameAs (tessellateConvexPath path Color.blue) (← runNative (VertexWriterM.emitFillPath path Color.blue 0 0)))
+    "Pixel-space fill should match tessellateConvexPath"
+
+test "native tessellator rejects a truncated command stream" := do
+  let w ← FFI.VertexWriter.create
+  let bad : FloatArray := ⟨#[3, 1, 2]⟩
+  ensure (← fails ((VertexWriterM.emitFillEncoded bad Color.red 100 100).run w))
+    "Expected a cubic with missing operands to fail"
+  ensure ((← w.vertexCount) == 0) "Nothing should be appended"
+  w.destroy
+
 #generate_tests
 
 end Afferent.Tests.TessellationTests
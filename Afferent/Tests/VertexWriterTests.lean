@@ -0,0 +1,217 @@
+/-
+  Afferent VertexWriter Tests
+  Typed emits against the native writer, parity with the Batch and
+  FloatArray builders they replace, index widening, growth, and rejection
+  of bad indices and strides (no GPU required).
+-/
+import Afferent.Tests.Framework
+import Afferent.Render.VertexWriter
+import Afferent.Render.Dynamic
+
+namespace Afferent.Tests.VertexWriterTests
+
+open Crucible
+open Afferent
+open Afferent.FFI
+open Afferent.Tests
+
+testSuite "VertexWriter Tests"
+
+/-- Element-wise comparison at float32 precision. -/
+private def nearAll (a b : FloatArray) (eps : Float := 1e-5) : Bool := Id.run do
+  if a.size != b.size then return false
+  for i in [:a.size] do
+    if (a[i]! - b[i]!).abs > eps then return false
+  return true
+
+private def decodeIndices (bytes : ByteArray) (width : Nat) : Array UInt32 :=
+  let format := if width == 2 then IndexFormat.u16 else IndexFormat.u32
+  (Array.range (bytes.size / width)).map (format.get bytes)
+
+private def writerIndices (w : VertexWriter) : IO (Array UInt32) := do
+  pure (decodeIndices (← w.indexBytes) (← w.stats).indexWidth)
+
+/-! ## Emitting -/
+
+test "emitVertex stores float32 vertices" := do
+  let w ← VertexWriter.create
+  VertexWriterM.run (do
+    VertexWriterM.emitVertex 0.5 (-0.25) ⟨1, 0.1, 0.2, 1⟩
+    VertexWriterM.emitVertex 1 2 ⟨0, 0, 0, 0⟩) w
+  ensure ((← w.vertexCount) == 2) "Expected 2 vertices"
+  ensure (nearAll (← w.vertices) ⟨#[0.5, -0.25, 1, 0.1, 0.2, 1, 1, 2, 0, 0, 0, 0]⟩)
+    "Vertices should round-trip at float32 precision"
+  w.destroy
+
+test "emitIndexTri is relative to the current shape" := do
+  let w ← VertexWriter.create
+  VertexWriterM.run (do
+    for _ in [:3] do VertexWriterM.emitVertex 0 0 Color.red
+    VertexWriterM.beginShape
+    for _ in [:3] do VertexWriterM.emitVertex 1 1 Color.red
+    VertexWriterM.emitIndexTri 0 1 2) w
+  ensure ((← writerIndices w) == #[3, 4, 5]) s!"Unexpected indices {← writerIndices w}"
+  w.destroy
+
+test "emitQuad matches Batch.addRectDirect" := do
+  let w ← VertexWriter.create
+  let mut batch := Batch.empty
+  for i in [:10] do
+    let x := i.toFloat * 30
+    batch := batch.addRectDirect x 40 (i.toFloat * 0.3) 12 Color.blue 800 600
+    (VertexWriterM.emitRectDirect x 40 (i.toFloat * 0.3) 12 Color.blue 800 600).run w
+  ensure (nearAll (← w.vertices) batch.vertices) "Vertices should match the batch"
+  ensure ((← writerIndices w) == batch.indices) "Indices should match the batch"
+  w.destroy
+
+test "emitTessellation matches Batch.add" := do
+  let results := #[
+    Tessellation.tessellateConvexPathNDC (Path.star ⟨50, 50⟩ 40 20 5) Color.red 800 600,
+    Tessellation.tessellateRectNDC (Rect.mk' 10 10 100 50) Color.green 800 600,
+    Tessellation.tessellateStrokeNDC (Path.circle ⟨200, 200⟩ 30) StrokeStyle.default 800 600
+  ]
+  let w ← VertexWriter.create
+  for r in results do
+    (VertexWriterM.emitTessellation r).run w
+  let batch := results.foldl Batch.add Batch.empty
+  ensure (nearAll (← w.vertices) batch.vertices) "Vertices should match the batch"
+  ensure ((← writerIndices w) == batch.indices) "Indices should match the batch"
+  w.destroy
+
+test "gradient rects use per-corner colors" := do
+  let style := FillStyle.gradient (.linear ⟨0, 0⟩ ⟨100, 0⟩ #[⟨0, Color.black⟩, ⟨1, Color.white⟩])
+  let rect := Rect.mk' 0 0 100 100
+  let w ← VertexWriter.create
+  (VertexWriterM.emitTransformedRect rect Transform.identity style 100 100).run w
+  let batch := Batch.empty.addTransformedRect rect Transform.identity style 100 100
+  ensure (nearAll (← w.vertices) batch.vertices) "Vertices should match the batch"
+  ensure ((← writerIndices w) == batch.indices) "Indices should match the batch"
+  w.destroy
+
+test "writeCircleData matches buildCircleData" := do
+  let particles := Render.Dynamic.ParticleState.create 100 800 600 3
+  let w ← VertexWriter.create 4
+  (Render.Dynamic.writeCircleData particles 5).run w
+  ensure (nearAll (← w.vertices) (Render.Dynamic.buildCircleData particles 5) 1e-3)
+    "Circle records should match"
+  w.destroy
+
+test "rect instance spans the emitTransformedRect quad" := do
+  let rect := Rect.mk' 10 20 100 50
+  let transform := (Transform.rotate 0.4).scaled 2 1.5 |>.translated 300 200
+  let quad ← VertexWriter.create
+  let inst ← VertexWriter.create 12
+  (VertexWriterM.emitTransformedRect rect transform (.solid Color.green) 800 600).run quad
+  (VertexWriterM.emitRectInstance rect transform Color.green 800 600).run inst
+  let q ← quad.vertices
+  let i ← inst.vertices
+  ensure (i.size == 12 && i[10]! == 0) "Expected one rect record"
+  -- Unit-square corners (-1,-1), (1,-1), (1,1), (-1,1) map to the quad's corners in order
+  let corners : Array (Float × Float) := #[(-1, -1), (1, -1), (1, 1), (-1, 1)]
+  let expanded := corners.foldl (init := FloatArray.empty) fun acc (u, v) =>
+    (acc.push (i[0]! + u * i[2]! + v * i[4]!)).push (i[1]! + u * i[3]! + v * i[5]!)
+  let quadCorners := (Array.range 4).foldl (init := FloatArray.empty) fun acc k =>
+    (acc.push q[k * 6]!).push q[k * 6 + 1]!
+  ensure (nearAll expanded quadCorners) "Instance corners should match the quad"
+  ensure (nearAll ⟨#[i[6]!, i[7]!, i[8]!, i[9]!]⟩ ⟨#[0, 1, 0, 1]⟩) "Instance color should be green"
+  quad.destroy
+  inst.destroy
+
+test "ellipse instance axes are the transformed radii in NDC" := do
+  let w ← VertexWriter.create 12
+  (VertexWriterM.emitEllipseInstance ⟨400, 300⟩ 40 20 (Transform.scale 2 2) Color.red 800 600).run w
+  let i ← w.vertices
+  -- Center (800, 600) is the bottom-right corner; radii 80 and 40 px
+  ensure (nearAll i ⟨#[1, -1, 0.2, 0, 0, -40.0 / 300.0, 1, 0, 0, 1, 1, 0]⟩) s!"Unexpected record {i}"
+  w.destroy
+
+/-! ## Capacity -/
+
+test "indices widen to 32-bit past 65536 vertices" := do
+  let w ← VertexWriter.create
+  for i in [:16385] do
+    (VertexWriterM.emitRectDirect (i % 100).toFloat 10 0 1 Color.red 800 600).run w
+  let s ← w.stats
+  ensure (s.vertexCount == 65540) s!"Unexpected vertex count {s.vertexCount}"
+  ensure (s.indexWidth == 4) "Expected 32-bit indices"
+  let indices ← writerIndices w
+  ensure (indices[indices.size - 1]! == 65539) s!"Unexpected last index {indices[indices.size - 1]!}"
+  ensure (indices[6]! == 4) "Earlier indices should survive widening"
+  w.clear
+  ensure ((← w.stats).indexWidth == 2) "Clear should return to 16-bit indices"
+  w.destroy
+
+test "preallocated capacity does not grow" := do
+  let w ← VertexWriter.create 6 400 600
+  for _ in [:100] do
+    (VertexWriterM.emitRectDirect 10 10 0 5 Color.red 800 600).run w
+  ensure ((← w.stats).grows == 0) "Expected no reallocations"
+  w.destroy
+
+test "clear keeps capacity for the next frame" := do
+  let w ← VertexWriter.create
+  for _ in [:1000] do
+    (VertexWriterM.emitRectDirect 10 10 0 5 Color.red 800 600).run w
+  let grows := (← w.stats).grows
+  w.clear
+  ensure ((← w.vertexCount) == 0 && (← w.indexCount) == 0) "Clear should drop all geometry"
+  for _ in [:1000] do
+    (VertexWriterM.emitRectDirect 10 10 0 5 Color.red 800 600).run w
+  ensure ((← w.stats).grows == grows) "Refilling after clear should not reallocate"
+  w.destroy
+
+test "auto-batch frames match Batch and reuse the writer" := do
+  -- The Canvas auto-batch pattern: rects and tessellated fills, then clear per frame
+  let shape := Tessellation.tessellateConvexPathNDC (Path.circle ⟨200, 150⟩ 40) Color.red 800 600
+  let rect := Rect.mk' 10 20 100 50
+  let transform := Transform.translate 30 40
+  let w ← VertexWriter.create
+  let mut batch := Batch.withCapacity 100
+  for _ in [:50] do
+    batch := batch.addTransformedRect rect transform (.solid Color.green) 800 600
+    batch := batch.add shape
+  let mut grows := 0
+  for frame in [:3] do
+    for _ in [:50] do
+      (VertexWriterM.emitTransformedRect rect transform (.solid Color.green) 800 600).run w
+      (VertexWriterM.emitTessellation shape).run w
+    ensure (nearAll (← w.vertices) batch.vertices) s!"Frame {frame}: vertices should match the batch"
+    ensure ((← writerIndices w) == batch.indices) s!"Frame {frame}: indices should match the batch"
+    if frame == 0 then grows := (← w.stats).grows
+    w.clear
+  ensure ((← w.stats).grows == grows) "Frames after the first should not reallocate"
+  w.destroy
+
+/-! ## Validation -/
+
+test "out-of-range triangle index is rejected" := do
+  let w ← VertexWriter.create
+  VertexWriterM.run (do
+    VertexWriterM.beginShape
+    VertexWriterM.emitVertex 0 0 Color.red
+    VertexWriterM.emitVertex 1 0 Color.red) w
+  ensure (← fails (w.emitIndexTri 0 1 2)) "Expected index 2 of 2 vertices to fail"
+  ensure ((← w.indexCount) == 0) "Nothing should be appended"
+  w.destroy
+
+test "malformed shape is rejected before writing" := do
+  let w ← VertexWriter.create
+  let bad : TessellationResult := { vertices := ⟨#[0, 0, 1, 1, 1, 1]⟩, indices := #[0, 0, 1] }
+  ensure (← fails ((VertexWriterM.emitTessellation bad).run w)) "Expected index 1 of 1 vertex to fail"
+  ensure ((← w.vertexCount) == 0) "No vertices should be written"
+  w.destroy
+
+test "emits of the wrong stride are rejected" := do
+  let w ← VertexWriter.create 4
+  ensure (← fails (w.emitVertex 0 0 1 1 1 1)) "Expected a 6-float vertex to fail on stride 4"
+  ensure (← fails (w.emit5 0 0 0 0 0)) "Expected a 5-float record to fail on stride 4"
+  ensure (← fails (w.emitQuad 0 0 1 0 1 1 0 1 1 1 1 1)) "Expected a quad to fail on stride 4"
+  ensure (← fails (w.emitShapeInstance 0 0 1 0 0 1 1 1 1 1 0))
+    "Expected a shape instance to fail on stride 4"
+  w.emit4 0 0 0 0
+  ensure ((← w.vertexCount) == 1) "Expected one record"
+  w.destroy
+
+#generate_tests
+
+end Afferent.Tests.VertexWriterTests
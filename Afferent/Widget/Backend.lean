@@ -4,6 +4,7 @@
   Converts abstract RenderCommands to Metal-backed drawing calls.
 -/
 import Afferent.Canvas.Context
+import Afferent.Render.CommandStream
 import Afferent.Text.Font
 import Afferent.Text.Measurer
 import Arbor
@@ -126,6 +127,111 @@ def executeCommands (reg : FontRegistry) (cmds : Array Arbor.RenderCommand) : Ca
   for cmd in cmds do
     executeCommand reg cmd
 
+/-! ## Packed command stream -/
+
+/-- Font table for a command stream: the registry's fonts, then the default font. -/
+def fontTable (reg : FontRegistry) : Array FFI.Font :=
+  let fonts := reg.fonts.map (·.handle)
+  match reg.defaultFont with
+  | some font => fonts.push font.handle
+  | none => fonts
+
+/-- Index of a font in `fontTable`, resolving like `FontRegistry.get`. -/
+private def fontIndex (reg : FontRegistry) (fontId : Arbor.FontId) : Option Nat :=
+  if fontId.id < reg.fonts.size then some fontId.id
+  else if reg.defaultFont.isSome then some reg.fonts.size
+  else none
+
+/-- Encode RenderCommands into a command stream, with the same semantics as
+    `executeCommand`: transforms and colors come from the Canvas state stack,
+    which is threaded through and returned. Path fills and strokes go through
+    `cache` when one is given. -/
+def encodeCommands (reg : FontRegistry) (cmds : Array Arbor.RenderCommand)
+    (stack : StateStack) (canvasWidth canvasHeight : Float)
+    (cache : Option (IO.Ref TessellationCache) := none)
+    : IO (CommandStream × StateStack) := do
+  let mut stream := CommandStream.withCapacity (cmds.size * 128)
+  let mut stack := stack
+  let fillPath : StateStack → Afferent.Path → CommandStream → IO CommandStream :=
+    fun stack path stream => do
+      let state := stack.current
+      let style := state.effectiveFillStyle
+      let result ← match cache with
+        | some cache => TessellationCache.fillPath cache path state style canvasWidth canvasHeight
+        | none => Tessellation.tessellatePathFillNDC path (state.transformPath path)
+            state.transform style canvasWidth canvasHeight
+      return stream.triangles result
+  let strokePath : StateStack → Afferent.Path → CommandStream → IO CommandStream :=
+    fun stack path stream => do
+      let state := stack.current
+      let style := { state.strokeStyle with color := state.effectiveStrokeColor }
+      let result ← match cache with
+        | some cache => TessellationCache.strokePath cache path state style canvasWidth canvasHeight
+        | none => pure (Tessellation.tessellateStrokeNDC (state.transformPath path) style
+            canvasWidth canvasHeight)
+      return stream.triangles result
+  for cmd in cmds do
+    match cmd with
+    | .fillRect rect color cornerRadius =>
+      stack := stack.setFillColor (toAfferentColor color)
+      let r := toAfferentRect rect
+      if cornerRadius > 0 then
+        stream ← fillPath stack (Afferent.Path.roundedRect r cornerRadius) stream
+      else
+        stream := stream.fillRect r stack.current.transform stack.current.effectiveFillStyle
+          canvasWidth canvasHeight
+    | .strokeRect rect color lineWidth cornerRadius =>
+      stack := (stack.setStrokeColor (toAfferentColor color)).setLineWidth lineWidth
+      let r := toAfferentRect rect
+      let path := if cornerRadius > 0 then Afferent.Path.roundedRect r cornerRadius
+        else Afferent.Path.rectangle r
+      stream ← strokePath stack path stream
+    | .fillText text x y fontId color =>
+      if let some idx := fontIndex reg fontId then
+        stream := stream.text idx text x y (toAfferentColor color) stack.current.transform
+    | .fillTextBlock text rect fontId color align valign =>
+      match reg.get fontId, fontIndex reg fontId with
+      | some font, some idx =>
+        let (textWidth, textHeight) ← font.measureText text
+        let x := match align with
+          | .left => rect.origin.x
+          | .center => rect.origin.x + (rect.size.width - textWidth) / 2
+          | .right => rect.origin.x + rect.size.width - textWidth
+        let y := match valign with
+          | .top => rect.origin.y + font.ascender
+          | .middle => rect.origin.y + (rect.size.height - textHeight) / 2 + font.ascender
+          | .bottom => rect.origin.y + rect.size.height - font.descender
+        stream := stream.text idx text x y (toAfferentColor color) stack.current.transform
+      | _, _ => pure ()
+    | .fillPolygon points color =>
+      if points.size >= 3 then
+        stack := stack.setFillColor (toAfferentColor color)
+        stream ← fillPath stack (polygonToPath points) stream
+    | .strokePolygon points color lineWidth =>
+      if points.size >= 3 then
+        stack := (stack.setStrokeColor (toAfferentColor color)).setLineWidth lineWidth
+        stream ← strokePath stack (polygonToPath points) stream
+    | .pushClip rect => stream := stream.pushClip (toAfferentRect rect)
+    | .popClip => stream := stream.popClip
+    | .pushTranslate dx dy => stack := stack.translate dx dy
+    | .popTransform => stack := stack.restore
+    | .save => stack := stack.save
+    | .restore => stack := stack.restore
+  pure (stream, stack)
+
+/-- Execute RenderCommands as one packed command stream: a single FFI call
+    for the whole frame instead of several per command. Nested clips are
+    intersected rather than replaced. -/
+def executeCommandsPacked (reg : FontRegistry) (cmds : Array Arbor.RenderCommand) : CanvasM Unit := do
+  -- Anything already queued on the Canvas must draw first
+  CanvasM.flushBatch
+  CanvasM.flushAutoBatch
+  let c ← get
+  let cache := if c.tessCacheEnabled then some c.tessCache else none
+  let (stream, stack) ← encodeCommands reg cmds c.stateStack c.baseWidth c.baseHeight cache
+  discard <| stream.execute c.ctx.renderer (fontTable reg) #[] c.baseWidth c.baseHeight
+  set { c with stateStack := stack }
+
 /-- Render an Arbor widget tree using CanvasM.
     This is the main entry point for rendering Arbor widgets with Afferent's Metal backend.
 
@@ -147,8 +253,8 @@ def renderArborWidget (reg : FontRegistry) (widget : Arbor.Widget)
   -- Collect render commands
   let commands := Arbor.collectCommands measuredWidget layouts
 
-  -- Execute commands
-  executeCommands reg commands
+  -- Execute commands (one FFI call for the frame)
+  executeCommandsPacked reg commands
 
 /-- Convenience function to render a widget built with Arbor's DSL.
     Takes a WidgetBuilder and executes the full render pipeline. -/
@@ -182,7 +288,7 @@ def renderArborWidgetCentered (reg : FontRegistry) (widget : Arbor.Widget)
   -- Save state, translate, render, restore
   CanvasM.save
   CanvasM.translate offsetX offsetY
-  executeCommands reg commands
+  executeCommandsPacked reg commands
   CanvasM.restore
 
 /-- Render an Arbor widget tree centered with debug borders.
@@ -211,7 +317,7 @@ def renderArborWidgetDebug (reg : FontRegistry) (widget : Arbor.Widget)
   -- Save state, translate, render, restore
   CanvasM.save
   CanvasM.translate offsetX offsetY
-  executeCommands reg commands
+  executeCommandsPacked reg commands
   CanvasM.restore
 
 end Afferent.Widget
@@ -6,6 +6,21 @@ import Afferent.Tests.TessellationTests
 import Afferent.Tests.FFISafetyTests
 import Afferent.Tests.AssetLoadingTests
 import Afferent.Tests.SeascapeSmokeTests
+import Afferent.Tests.PackedBufferTests
+import Afferent.Tests.SpatialHashTests
+import Afferent.Tests.ParticleSystemTests
+import Afferent.Tests.FixedStepperTests
+import Afferent.Tests.ParticleInitTests
+import Afferent.Tests.MeshTests
+import Afferent.Tests.FrameArenaTests
+import Afferent.Tests.CommandStreamTests
+import Afferent.Tests.VertexWriterTests
+import Afferent.Tests.PolygonFillTests
+import Afferent.Tests.TessellationCacheTests
+import Afferent.Tests.CullingTests
+import Afferent.Tests.PolylineTests
+import Afferent.Tests.DeferredTessellationTests
+import Afferent.Tests.GradientLUTTests
 import Crucible
 
 open Crucible
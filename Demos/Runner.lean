@@ -101,11 +101,20 @@ def unifiedDemo : IO Unit := do
   let bouncingParticles := Render.Dynamic.ParticleState.create 1000000 physWidthF physHeightF 42
   IO.println s!"Created {bouncingParticles.count} bouncing circles"
 
-  -- Sprite particles for Bunnymark-style benchmark (Lean physics, FloatBuffer rendering)
+  -- Sprite particles for Bunnymark-style benchmark (seed state for the fixed stepper)
   let spriteParticles := Render.Dynamic.ParticleState.create 1000000 physWidthF physHeightF 123
   let spriteBuffer ← FFI.FloatBuffer.create (spriteParticles.count.toUSize * 5)  -- 5 floats per sprite
   let circleBuffer ← FFI.FloatBuffer.create (bouncingParticles.count.toUSize * 4)  -- 4 floats per circle
-  IO.println s!"Created {spriteParticles.count} bouncing sprites (Lean physics, FloatBuffer rendering)"
+  IO.println s!"Created {spriteParticles.count} bouncing sprites (fixed-step native physics, FloatBuffer rendering)"
+
+  -- Fixed-timestep native steppers: physics runs at 120 Hz regardless of frame rate,
+  -- and the instance buffers get positions interpolated between steps.
+  let circleStepper ← FFI.FixedStepper.create bouncingParticles.count.toUInt32
+  FFI.FixedStepper.setBounds circleStepper physWidthF physHeightF circleRadius
+  let _ ← FFI.FixedStepper.load circleStepper bouncingParticles.data
+  let spriteStepper ← FFI.FixedStepper.create spriteParticles.count.toUInt32
+  FFI.FixedStepper.setBounds spriteStepper physWidthF physHeightF spriteHalfSize
+  let _ ← FFI.FixedStepper.load spriteStepper spriteParticles.data
 
   -- No GPU upload needed! Dynamic module sends positions each frame.
   IO.println "Using unified Dynamic rendering - CPU positions, GPU color/NDC."
@@ -141,8 +150,6 @@ def unifiedDemo : IO Unit := do
   let mut displayMode : Nat := startMode % 11
   let mut msaaEnabled : Bool := true
   let mut lastTime := startTime
-  let mut bouncingState := bouncingParticles
-  let mut spriteState := spriteParticles
   -- FPS counter (smoothed over multiple frames)
   let mut frameCount : Nat := 0
   let mut fpsAccumulator : Float := 0.0
@@ -207,19 +214,19 @@ def unifiedDemo : IO Unit := do
         c ← renderTriangleTest (c.resetTransform) t fontMedium gridParticles halfSize
       else if displayMode == 3 then
         -- Circle performance test: bouncing circles
-        bouncingState ← bouncingState.updateBouncingAndWriteCircles dt circleRadius circleBuffer
+        let _ ← FFI.FixedStepper.advance circleStepper dt circleBuffer .circles
         c ← run' (c.resetTransform) do
           setFillColor Color.white
-          fillTextXY s!"Circles: {bouncingState.count} dynamic circles [fused] (Space to advance)" (20 * screenScale) (30 * screenScale) fontMedium
-        Render.Dynamic.drawCirclesFromBuffer c.ctx.renderer circleBuffer bouncingState.count.toUInt32 t bouncingState.screenWidth bouncingState.screenHeight
+          fillTextXY s!"Circles: {bouncingParticles.count} dynamic circles [fixed 120Hz] (Space to advance)" (20 * screenScale) (30 * screenScale) fontMedium
+        Render.Dynamic.drawCirclesFromBuffer c.ctx.renderer circleBuffer bouncingParticles.count.toUInt32 t bouncingParticles.screenWidth bouncingParticles.screenHeight
       else if displayMode == 4 then
         -- Sprite performance test: bouncing textured sprites (Bunnymark)
-        -- Physics runs in Lean, rendering uses FloatBuffer for zero-copy GPU upload
-        spriteState ← spriteState.updateBouncingAndWriteSprites dt spriteHalfSize spriteBuffer
+        -- Fixed-step native physics, interpolated instances written straight to the FloatBuffer
+        let _ ← FFI.FixedStepper.advance spriteStepper dt spriteBuffer .sprites
         c ← run' (c.resetTransform) do
           setFillColor Color.white
-          fillTextXY s!"Sprites: {spriteState.count} textured sprites [fused] (Space to advance)" (20 * screenScale) (30 * screenScale) fontMedium
-        Render.Dynamic.drawSpritesFromBuffer c.ctx.renderer spriteTexture spriteBuffer spriteState.count.toUInt32 spriteHalfSize spriteState.screenWidth spriteState.screenHeight
+          fillTextXY s!"Sprites: {spriteParticles.count} textured sprites [fixed 120Hz] (Space to advance)" (20 * screenScale) (30 * screenScale) fontMedium
+        Render.Dynamic.drawSpritesFromBuffer c.ctx.renderer spriteTexture spriteBuffer spriteParticles.count.toUInt32 spriteHalfSize spriteParticles.screenWidth spriteParticles.screenHeight
       else if displayMode == 5 then
         -- Full-size Layout demo
         c ← run' (c.resetTransform) do
@@ -394,6 +401,8 @@ def unifiedDemo : IO Unit := do
   fontLarge.destroy
   fontHuge.destroy
   layoutFont.destroy
+  FFI.FixedStepper.destroy circleStepper
+  FFI.FixedStepper.destroy spriteStepper
   canvas.destroy
 
 /-- Main entry point - runs all demos -/
@@ -411,7 +411,7 @@ def OceanMesh.createProjectedGrid (gridSize : Nat) (fovY aspect : Float)
 
 /-- Sky dome mesh for procedural overcast sky. -/
 structure SkyDome where
-  vertices : Array Float   -- 10 floats per vertex
+  vertices : FloatArray    -- 10 floats per vertex
   indices : Array UInt32
   deriving Inhabited
 
@@ -423,7 +423,7 @@ def SkyDome.create (radius : Float) (segments : Nat) (rings : Nat) : SkyDome :=
   let lowerRings := rings / 2
   let totalRings := rings + lowerRings
   let (vertices, indices) := Id.run do
-    let mut vertices := Array.mkEmpty ((segments * totalRings + 2) * 10)
+    let mut vertices := FloatArray.emptyWithCapacity ((segments * totalRings + 2) * 10)
     let mut indices := Array.mkEmpty (segments * totalRings * 6)
 
     -- Zenith vertex (top of dome)
@@ -550,21 +550,24 @@ def SkyDome.create (radius : Float) (segments : Nat) (rings : Nat) : SkyDome :=
 
   { vertices, indices }
 
-private initialize seascapeSkyDomeCache : IO.Ref (Option SkyDome) ← IO.mkRef none
+private initialize seascapeSkyDomeCache : IO.Ref (Option FFI.Mesh) ← IO.mkRef none
 
-private def getSeascapeSkyDome : IO SkyDome := do
+/-- Sky dome geometry, uploaded once as a persistent mesh. -/
+private def getSeascapeSkyDome : IO FFI.Mesh := do
   match (← seascapeSkyDomeCache.get) with
-  | some dome => return dome
+  | some mesh => return mesh
   | none =>
       let dome := SkyDome.create 600.0 32 16
-      seascapeSkyDomeCache.set (some dome)
-      return dome
+      let mesh ← FFI.Mesh.create .lit dome.vertices dome.indices
+      seascapeSkyDomeCache.set (some mesh)
+      return mesh
 
 /-! ## Frigate Ship Asset -/
 
 /-- Cached frigate asset data (loaded once). -/
 private structure FrigateCache where
   asset : LoadedAsset
+  mesh : FFI.Mesh
   texture : Texture
 
 private initialize seascapeFrigateCache : IO.Ref (Option FrigateCache) ← IO.mkRef none
@@ -586,7 +589,10 @@ def loadFrigate : IO FrigateCache := do
           "assets/fictional-frigate/textures/frigate6_lambert2_BaseColor.png"
       let texture ← Texture.load texturePath
 
-      let cache := { asset, texture }
+      -- Upload the geometry once; per-frame draws only pass submesh ranges
+      let mesh ← FFI.Mesh.create .textured ⟨asset.vertices⟩ asset.indices
+
+      let cache := { asset, mesh, texture }
       seascapeFrigateCache.set (some cache)
       IO.println s!"Frigate loaded: {asset.vertices.size / 12} vertices, {asset.indices.size / 3} triangles"
       return cache
@@ -683,9 +689,10 @@ def renderSeascape (renderer : Renderer) (t : Float)
   let skyMvp := Matrix4.multiply proj (Matrix4.multiply view skyModel)
 
   -- Render sky first (it's at far distance) - no fog for sky
-  Renderer.drawMesh3D renderer
-    skyDome.vertices
-    skyDome.indices
+  Renderer.drawMesh renderer
+    skyDome
+    0
+    (← skyDome.indexCount)
     skyMvp.toArray
     skyModel.toArray
     lightDir
@@ -741,9 +748,8 @@ def renderSeascape (renderer : Renderer) (t : Float)
 
   -- Draw each submesh of the frigate
   for submesh in frigate.asset.subMeshes do
-    Renderer.drawMesh3DTextured renderer
-      frigate.asset.vertices
-      frigate.asset.indices
+    Renderer.drawMeshTextured renderer
+      frigate.mesh
       submesh.indexOffset
       submesh.indexCount
       frigateMvp.toArray
@@ -9,12 +9,25 @@ open Afferent Afferent.FFI Afferent.Render
 
 namespace Demos
 
+private initialize spinningCubeMeshCache : IO.Ref (Option FFI.Mesh) ← IO.mkRef none
+
+/-- Cube geometry, uploaded once as a persistent mesh. -/
+private def getCubeMesh : IO FFI.Mesh := do
+  match (← spinningCubeMeshCache.get) with
+  | some mesh => return mesh
+  | none =>
+      let mesh ← FFI.Mesh.create .lit Mesh.cubeVertexData Mesh.cubeIndices
+      spinningCubeMeshCache.set (some mesh)
+      return mesh
+
 /-- Render spinning cubes with a given view matrix.
     Internal helper used by both static and FPS camera versions. -/
 private def renderCubesWithView (renderer : Renderer) (t : Float)
     (proj view : Matrix4) : IO Unit := do
   -- Light direction (normalized, pointing from upper-right-front)
   let lightDir := #[0.5, 0.7, 0.5]
+  let cube ← getCubeMesh
+  let cubeIndexCount := Mesh.cubeIndices.size.toUInt32
 
   -- Draw 5x5 grid of cubes
   for row in [:5] do
@@ -39,9 +52,10 @@ private def renderCubesWithView (renderer : Renderer) (t : Float)
       let mvp := Matrix4.multiply proj viewModel
 
       -- Draw the cube
-      Renderer.drawMesh3D renderer
-        Mesh.cubeVertices
-        Mesh.cubeIndices
+      Renderer.drawMesh renderer
+        cube
+        0
+        cubeIndexCount
         mvp.toArray
         model.toArray
         lightDir
@@ -0,0 +1,72 @@
+/-
+  Afferent Benchmarks
+  Headless micro-benchmarks for the native data paths (no window or GPU).
+
+  Usage: afferent_bench [name ...]   -- runs all benchmarks when no names given
+-/
+import Examples.Bench.Harness
+import Examples.Bench.PackedBuffer
+import Examples.Bench.SpatialHash
+import Examples.Bench.ParticleSystem
+import Examples.Bench.FixedStepper
+import Examples.Bench.ParticleInit
+import Examples.Bench.Marshalling
+import Examples.Bench.FrameArena
+import Examples.Bench.CommandStream
+import Examples.Bench.IndexUpload
+import Examples.Bench.SpriteUpload
+import Examples.Bench.VertexWriter
+import Examples.Bench.PathTessellation
+import Examples.Bench.PolygonTriangulation
+import Examples.Bench.CurveFlattening
+import Examples.Bench.TessellationCache
+import Examples.Bench.AutoBatch
+import Examples.Bench.PrimitiveInstancing
+import Examples.Bench.Culling
+import Examples.Bench.FringeAA
+import Examples.Bench.PolylineReduction
+import Examples.Bench.ParallelTessellation
+import Examples.Bench.ArcFlattening
+import Examples.Bench.GradientLUT
+
+open Afferent.Bench
+
+def benchmarks : List Benchmark := [
+  PackedBufferBench.benchmark,
+  SpatialHashBench.benchmark,
+  ParticleSystemBench.benchmark,
+  FixedStepperBench.benchmark,
+  ParticleInitBench.benchmark,
+  MarshallingBench.benchmark,
+  FrameArenaBench.benchmark,
+  CommandStreamBench.benchmark,
+  IndexUploadBench.benchmark,
+  SpriteUploadBench.benchmark,
+  VertexWriterBench.benchmark,
+  PathTessellationBench.benchmark,
+  PolygonTriangulationBench.benchmark,
+  CurveFlatteningBench.benchmark,
+  TessellationCacheBench.benchmark,
+  AutoBatchBench.benchmark,
+  PrimitiveInstancingBench.benchmark,
+  CullingBench.benchmark,
+  FringeAABench.benchmark,
+  PolylineReductionBench.benchmark,
+  ParallelTessellationBench.benchmark,
+  ArcFlatteningBench.benchmark,
+  GradientLUTBench.benchmark
+]
+
+def main (args : List String) : IO UInt32 := do
+  if args.contains "--list" then
+    for b in benchmarks do
+      IO.println s!"{b.name}\t{b.description}"
+    return 0
+  let selected := if args.isEmpty then benchmarks else benchmarks.filter (args.contains ·.name)
+  if selected.isEmpty then
+    IO.eprintln s!"No benchmark matches {args}; use --list"
+    return 1
+  for b in selected do
+    b.run
+    IO.println ""
+  return 0
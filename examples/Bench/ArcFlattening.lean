@@ -0,0 +1,69 @@
+/-
+  Arc Flattening Benchmark
+  Circles, ellipses, rounded rects, pies and semicircles from the Shapes demo,
+  drawn at 0.25x, 1x and 4x zoom. Each arc is flattened straight from its
+  on-screen radius (PathCommand.ellipseArc) and, as the baseline, through the
+  quarter-turn cubics arcs used to be converted to. Reports vertices per
+  frame and flattening time for both.
+-/
+import Afferent.Render.Tessellation
+import Afferent.Canvas.State
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.ArcFlatteningBench
+
+open Afferent
+open Afferent.Tessellation
+open Afferent.Bench
+
+private def pi : Float := 3.14159265358979323846
+
+private def shapes : Array Path := #[
+  Path.circle ⟨550, 70⟩ 40, Path.circle ⟨650, 70⟩ 20, Path.circle ⟨750, 70⟩ 8,
+  Path.roundedRect (Rect.mk' 820 30 130 80) 15,
+  Path.ellipse ⟨380, 350⟩ 70 40, Path.ellipse ⟨520, 350⟩ 40 60,
+  Path.pie ⟨680, 350⟩ 60 0 (pi * 0.5), Path.pie ⟨680, 350⟩ 60 (pi * 0.5) pi,
+  Path.semicircle ⟨850, 350⟩ 50 0
+]
+
+/-- The path with every elliptical arc replaced by its cubics: `arcToBeziers` on
+    the unit circle, mapped through the arc's center and axes. -/
+private def toCubics (path : Path) : Path := Id.run do
+  let mut out := { Path.empty with fillRule := path.fillRule }
+  for cmd in path.commands do
+    match cmd with
+    | .ellipseArc center axisX axisY startAngle sweep =>
+      let map (p : Point) : Point :=
+        ⟨center.x + axisX.x * p.x + axisY.x * p.y, center.y + axisX.y * p.x + axisY.y * p.y⟩
+      for (cp1, cp2, p) in Path.arcToBeziers Point.zero 1 startAngle (startAngle + sweep) (sweep < 0) do
+        out := out.bezierCurveTo (map cp1) (map cp2) (map p)
+    | _ => out := { out with commands := out.commands.push cmd }
+  return out
+
+/-- Total flattened points over `paths`. -/
+private def flatten (paths : Array Path) (sink : IO.Ref Nat) : IO Unit :=
+  sink.set (paths.foldl (· + (pathToPolygon ·).size) 0)
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  IO.println "Arc flattening: screen-space ellipse arcs vs quarter-turn cubics, 0.5 px tolerance"
+  for zoom in [0.25, 1.0, 4.0] do
+    let state := { CanvasState.default with transform := Transform.scale zoom zoom }
+    let arcs := shapes.map state.transformPath
+    let cubics := arcs.map toCubics
+    let arcNs ← timeNs 500 (flatten arcs sink)
+    let arcPoints ← sink.get
+    let cubicNs ← timeNs 500 (flatten cubics sink)
+    let cubicPoints ← sink.get
+    report s!"Shapes demo arcs at {fmt zoom 2}x" [
+      ("ellipse arcs", s!"{arcPoints} verts, {fmt (arcNs / 1000.0)} us"),
+      ("cubics", s!"{cubicPoints} verts, {fmt (cubicNs / 1000.0)} us"),
+      ("ratio", s!"{fmt (arcPoints.toFloat / cubicPoints.toFloat)}x verts, {fmt (arcNs / cubicNs)}x time")
+    ]
+
+def benchmark : Benchmark :=
+  { name := "arc-flattening"
+    description := "Shapes demo arcs at 0.25x to 4x zoom: screen-space arc flattening vs cubics"
+    run := run }
+
+end Afferent.Bench.ArcFlatteningBench
@@ -0,0 +1,110 @@
+/-
+  Auto-Batch Benchmark
+  Per-frame cost of the Canvas auto-batch for the Shapes demo content
+  (rects via fillRect, every other shape a tessellated fill), tiled for
+  busier frames:
+  - before: a fresh `Batch.withCapacity 100` each frame, grown by Batch.add
+    and addTransformedRect, as endFrame used to reset it;
+  - after: one native VertexWriter kept on the Canvas, appended in place and
+    cleared, not freed, at each flush.
+  Tessellation is done once up front, as the tessellation cache does after
+  the first frame, so only batch accumulation is measured. Reports time and
+  Lean allocations (runtime heartbeats) per frame, and writer reallocations
+  after the first frame.
+-/
+import Afferent.Render.VertexWriter
+import Afferent.Render.PolygonFill
+import Afferent.Canvas.State
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.AutoBatchBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+private def pi : Float := 3.14159265358979323846
+
+private inductive Op where
+  | rect (rect : Rect) (color : Color)
+  | shape (result : TessellationResult)
+
+/-- The Shapes demo, tiled `copies` times with a small offset per copy. -/
+private def shapesFrame (copies : Nat) : IO (Array Op) := do
+  let mut ops := #[]
+  for i in [:copies] do
+    let dx := (i % 8).toFloat * 4
+    let dy := (i / 8).toFloat * 4
+    let state := { CanvasState.default with transform := Transform.translate dx dy }
+    for (x, color) in [(50.0, Color.red), (200.0, Color.green), (350.0, Color.blue)] do
+      ops := ops.push (.rect (Rect.mk' (x + dx) (30 + dy) 120 80) color)
+    let paths := #[
+      Path.circle ⟨550, 70⟩ 40, Path.circle ⟨650, 70⟩ 40, Path.circle ⟨750, 70⟩ 40,
+      Path.roundedRect (Rect.mk' 820 30 130 80) 15,
+      Path.star ⟨100, 200⟩ 50 25 5, Path.star ⟨220, 200⟩ 45 25 6, Path.star ⟨340, 200⟩ 40 25 8,
+      Path.polygon ⟨480, 200⟩ 45 3, Path.polygon ⟨600, 200⟩ 45 5,
+      Path.polygon ⟨720, 200⟩ 45 6, Path.polygon ⟨850, 200⟩ 45 8,
+      Path.heart ⟨100, 350⟩ 80, Path.heart ⟨230, 350⟩ 60,
+      Path.ellipse ⟨380, 350⟩ 70 40, Path.ellipse ⟨520, 350⟩ 40 60,
+      Path.pie ⟨680, 350⟩ 60 0 (pi * 0.5), Path.pie ⟨680, 350⟩ 60 (pi * 0.5) pi,
+      Path.pie ⟨680, 350⟩ 60 pi (pi * 1.5), Path.pie ⟨680, 350⟩ 60 (pi * 1.5) (pi * 2),
+      Path.semicircle ⟨850, 350⟩ 50 0,
+      Path.arcPath ⟨550, 530⟩ 50 0 (pi * 1.5) |>.closePath,
+      Path.roundedRect (Rect.mk' 650 470 100 80) 5, Path.roundedRect (Rect.mk' 780 470 100 80) 30,
+      Path.triangle ⟨100, 650⟩ ⟨180, 750⟩ ⟨20, 750⟩,
+      Path.equilateralTriangle ⟨280, 700⟩ 50, Path.equilateralTriangle ⟨380, 700⟩ 40
+    ]
+    for p in paths do
+      ops := ops.push (.shape (← Tessellation.tessellatePathNDC (state.transformPath p) Color.red canvasW canvasH))
+  return ops
+
+private def measure (copies : Nat) (sink : IO.Ref Nat) : IO Unit := do
+  let ops ← shapesFrame copies
+  let before : IO Unit := do
+    let mut batch := Batch.withCapacity 100
+    for op in ops do
+      match op with
+      | .rect r color => batch := batch.addTransformedRect r Transform.identity (.solid color) canvasW canvasH
+      | .shape result => batch := batch.add result
+    sink.set batch.indexCount
+  let w ← VertexWriter.create
+  let after : IO Unit := do
+    for op in ops do
+      match op with
+      | .rect r color =>
+        (VertexWriterM.emitTransformedRect r Transform.identity (.solid color) canvasW canvasH).run w
+      | .shape result => (VertexWriterM.emitTessellation result).run w
+    sink.set (← w.indexCount).toNat
+    w.clear
+  -- First frame sizes the writer; later frames should not grow it
+  after
+  let grows := (← w.stats).grows
+  let beforeNs ← timeNs 200 before
+  let afterNs ← timeNs 200 after
+  let beforeAllocs ← allocsPerIter 200 before
+  let afterAllocs ← allocsPerIter 200 after
+  let s ← w.stats
+  report s!"shapes demo x{copies}" [
+    ("shapes", toString ops.size),
+    ("before", s!"{fmt (beforeNs / 1000.0)} us, {fmt beforeAllocs 0} allocs"),
+    ("after", s!"{fmt (afterNs / 1000.0)} us, {fmt afterAllocs 0} allocs"),
+    ("speedup", s!"{fmt (beforeNs / afterNs)}x"),
+    ("writer grows", s!"{grows} first frame, {s.grows - grows} after"),
+    ("writer bytes", fmtBytes s.bytesReserved.toFloat)
+  ]
+  w.destroy
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  IO.println "Auto-batch: per-frame Batch vs persistent native writer"
+  for copies in [1, 10, 100] do
+    measure copies sink
+
+def benchmark : Benchmark :=
+  { name := "auto-batch"
+    description := "Shapes demo per-frame batch accumulation: fresh Batch vs reused native writer"
+    run := run }
+
+end Afferent.Bench.AutoBatchBench
@@ -0,0 +1,133 @@
+/-
+  Command Stream Benchmark
+  A widget-style frame (panels with rounded fills, borders, labels and
+  clips) submitted two ways:
+  - per command, as the Canvas path does: shapes are batched in Lean and
+    each flush creates vertex/index buffers, draws and destroys them
+    (5 crossings), plus one crossing per text draw and per scissor change;
+  - as one packed command stream, decoded natively in a single call.
+  Headless, so crossings that would reach the GPU are stood in for by a
+  minimal FFI call, and batch flushes do the same FloatArray narrowing as
+  buffer creation.
+-/
+import Afferent.Render.CommandStream
+import Afferent.FFI.FrameArena
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.CommandStreamBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private inductive Op where
+  | fill (rect : Rect) (radius : Float) (color : Color)
+  | stroke (rect : Rect) (color : Color)
+  | label (text : String) (x y : Float)
+  | clip (rect : Rect)
+  | unclip
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- `panels` panels, each clipped, with a background, border and two labels. -/
+private def frameOps (panels : Nat) : Array Op := Id.run do
+  let mut ops := #[]
+  for i in [:panels] do
+    let x := (i % 16).toFloat * 80
+    let y := (i / 16).toFloat * 50
+    let r := Rect.mk' x y 76 46
+    ops := ops.push (.clip r)
+    ops := ops.push (.fill r 4 ⟨0.2, 0.2, 0.25, 1⟩)
+    ops := ops.push (.fill (Rect.mk' (x + 4) (y + 24) 68 18) 0 ⟨0.3, 0.5, 0.9, 1⟩)
+    ops := ops.push (.stroke r ⟨0.6, 0.6, 0.7, 1⟩)
+    ops := ops.push (.label s!"Item {i}" (x + 6) (y + 16))
+    ops := ops.push (.label "value" (x + 8) (y + 38))
+    ops := ops.push .unclip
+  ops
+
+private def tessellate (op : Op) : Option TessellationResult :=
+  match op with
+  | .fill r radius color =>
+    if radius > 0 then
+      some (Tessellation.tessellateConvexPathNDC (Path.roundedRect r radius) color canvasW canvasH)
+    else
+      some (Tessellation.tessellateRectNDC r color canvasW canvasH)
+  | .stroke r color =>
+    some (Tessellation.tessellateStrokeNDC (Path.rectangle r)
+      { StrokeStyle.default with color, lineWidth := 1 } canvasW canvasH)
+  | _ => none
+
+/-- Per-command submission. Returns FFI crossings for the frame. -/
+private def legacyFrame (ops : Array Op) (arena : FrameArena) (header : ByteArray)
+    (sink : IO.Ref Float) : IO Nat := do
+  let crossing : IO Unit := do sink.modify (· + (← CommandStream.validate header 0 0).toFloat)
+  let mut batch := Batch.withCapacity 16
+  let mut crossings := 0
+  for op in ops do
+    match tessellate op with
+    | some result => batch := batch.add result
+    | none =>
+      if !batch.isEmpty then
+        -- createVertex (narrowing), createIndex, drawTriangles, destroy x2
+        sink.set (← arena.narrowScratch batch.vertices)
+        for _ in [:4] do crossing
+        crossings := crossings + 5
+        batch := Batch.withCapacity 16
+      match op with
+      | .clip _ =>
+        -- getSize + setScissor
+        crossing
+        crossing
+        crossings := crossings + 2
+      | _ =>
+        crossing
+        crossings := crossings + 1
+  arena.reset
+  pure crossings
+
+/-- Packed submission: encode, then one native call for the frame. -/
+private def streamFrame (ops : Array Op) (sink : IO.Ref Float) : IO ByteArray := do
+  let mut stream := CommandStream.withCapacity (ops.size * 128)
+  for op in ops do
+    match tessellate op with
+    | some result => stream := stream.triangles result
+    | none =>
+      match op with
+      | .label text x y => stream := stream.text 0 text x y ⟨1, 1, 1, 1⟩ Transform.identity
+      | .clip r => stream := stream.pushClip r
+      | _ => stream := stream.popClip
+  let bytes := stream.finish
+  sink.modify (· + (← CommandStream.validate bytes 1 0).toFloat)
+  pure bytes
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0.0
+  let arena ← FrameArena.create
+  let header := CommandStream.empty.finish
+  for panels in [50, 200] do
+    let ops := frameOps panels
+    IO.println s!"Command stream: {panels} panels, {ops.size} commands"
+    let crossingsRef ← IO.mkRef 0
+    let legacyNs ← timeNs 50 do
+      crossingsRef.set (← legacyFrame ops arena header sink)
+    let bytesRef ← IO.mkRef ByteArray.empty
+    let streamNs ← timeNs 50 do
+      bytesRef.set (← streamFrame ops sink)
+    let crossings ← crossingsRef.get
+    report "per frame" [
+      ("crossings (per command)", toString crossings),
+      ("crossings (stream)", "1"),
+      ("stream size", fmtBytes (← bytesRef.get).size.toFloat),
+      ("per command", s!"{fmt (legacyNs / 1000.0)} us"),
+      ("stream", s!"{fmt (streamNs / 1000.0)} us"),
+      ("speedup", s!"{fmt (legacyNs / streamNs)}x")
+    ]
+  arena.destroy
+
+def benchmark : Benchmark :=
+  { name := "command-stream"
+    description := "Widget frame: per-command FFI submission vs one packed command stream"
+    run := run }
+
+end Afferent.Bench.CommandStreamBench
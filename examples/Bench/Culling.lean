@@ -0,0 +1,92 @@
+/-
+  Culling Benchmark
+  A 1M-shape vector scene (circles, rects and stars scattered over the
+  canvas) viewed through a 10x zoom, so the view covers 1% of its extent:
+  the pan/zoom case of maps and diagrams. Each frame does what Canvas does
+  per draw: circles and rects become shape instances, stars are built as
+  paths and tessellated, all into writers that are cleared per frame.
+  - culling off: every shape is encoded;
+  - culling on: each shape's bounds (ellipse, rect corners or path hull) are
+    tested against the viewport first.
+  Reports time per frame and how many shapes were culled.
+-/
+import Afferent.Canvas.Culling
+import Afferent.Canvas.State
+import Afferent.Render.VertexWriter
+import Afferent.Render.PolygonFill
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.CullingBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- Deterministic scatter in [0, 1). -/
+private def hash (i : Nat) : Float :=
+  let s := Float.sin (i.toFloat * 12.9898) * 43758.5453
+  s - s.floor
+
+/-- Encode shape `i` of the scene under `t`, culling first if `cull`; true if culled. -/
+private def drawShape (i : Nat) (t : Transform) (cull : Bool) (tris shapes : VertexWriter) :
+    IO Bool := do
+  let view := Bounds.ofRect (Rect.mk' 0 0 canvasW canvasH)
+  let p : Point := ⟨hash (2 * i) * canvasW, hash (2 * i + 1) * canvasH⟩
+  let color := Color.hsv (hash i) 0.7 0.9
+  match i % 3 with
+  | 0 =>
+    if cull && (Culling.ellipseBounds t p 1.5 1.5).disjoint view then return true
+    (VertexWriterM.emitEllipseInstance p 1.5 1.5 t color canvasW canvasH).run shapes
+  | 1 =>
+    let rect := Rect.mk' p.x p.y 3 2
+    if cull && (Culling.rectBounds t rect).disjoint view then return true
+    (VertexWriterM.emitRectInstance rect t color canvasW canvasH).run shapes
+  | _ =>
+    let path := Path.star p 2 1 5
+    if cull then
+      if let some b := Culling.pathBounds t path then
+        if b.disjoint view then return true
+    let state := { CanvasState.default with transform := t }
+    let result ← Tessellation.tessellatePathNDC (state.transformPath path) color canvasW canvasH
+    (VertexWriterM.emitTessellation result).run tris
+  return false
+
+private def frame (count : Nat) (t : Transform) (cull : Bool) (tris shapes : VertexWriter)
+    (culled : IO.Ref Nat) : IO Unit := do
+  let mut n := 0
+  for i in [:count] do
+    if (← drawShape i t cull tris shapes) then n := n + 1
+  culled.set n
+  tris.clear
+  shapes.clear
+
+def run : IO Unit := do
+  let tris ← VertexWriter.create
+  let shapes ← VertexWriter.create 12
+  let culled ← IO.mkRef 0
+  -- 10x zoom about the canvas center: the view shows 1% of the scene
+  let zoom := Transform.translate (canvasW / 2) (canvasH / 2) |>.scaled 10 10
+    |>.translated (-canvasW / 2) (-canvasH / 2)
+  IO.println "Culling: 1M-shape scene zoomed to 1% of its extent"
+  for count in [100000, 1000000] do
+    let offNs ← timeNs 1 (frame count zoom false tris shapes culled) (warmup := 0)
+    let onNs ← timeNs 3 (frame count zoom true tris shapes culled) (warmup := 1)
+    let n ← culled.get
+    report s!"zoomed scene x{count}" [
+      ("culling off", s!"{fmt (offNs / 1.0e6)} ms/frame"),
+      ("culling on", s!"{fmt (onNs / 1.0e6)} ms/frame"),
+      ("speedup", s!"{fmt (offNs / onNs)}x"),
+      ("culled", s!"{n} ({fmt (n.toFloat / count.toFloat * 100)}%)")
+    ]
+  tris.destroy
+  shapes.destroy
+
+def benchmark : Benchmark :=
+  { name := "culling"
+    description := "1M-shape scene zoomed to 1% of its extent, with and without viewport culling"
+    run := run }
+
+end Afferent.Bench.CullingBench
@@ -0,0 +1,117 @@
+/-
+  Curve Flattening Benchmark
+  Wang's formula with forward differencing (flattenCubicBezier) against the
+  recursive de Casteljau subdivision it replaced (flattenCubicBezierSubdivide),
+  at a 0.5 px tolerance:
+  - circles of 4 to 1000 px radius, as the four cubics Path.arcToBeziers gives;
+  - scattered cubics across a 1280x800 canvas;
+  - quadratics, which the old flattener degree-elevated to cubics.
+  Reports vertices emitted per curve and time per curve.
+-/
+import Afferent.Render.Tessellation
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.CurveFlatteningBench
+
+open Afferent
+open Afferent.Tessellation
+open Afferent.Bench
+
+private def pi : Float := 3.14159265358979323846
+
+private abbrev Cubic := Point × Point × Point × Point
+
+/-- The cubics of a full circle, each with its start point. -/
+private def circleCubics (radius : Float) : Array Cubic := Id.run do
+  let mut current : Point := ⟨radius, 0⟩
+  let mut out := #[]
+  for (cp1, cp2, p) in Path.arcToBeziers Point.zero radius 0 (2 * pi) do
+    out := out.push (current, cp1, cp2, p)
+    current := p
+  return out
+
+/-- Deterministic scatter in [0, 1). -/
+private def hash (i : Nat) : Float :=
+  let s := Float.sin (i.toFloat * 12.9898) * 43758.5453
+  s - s.floor
+
+private def scatter (i : Nat) : Point := ⟨hash (2 * i) * 1280, hash (2 * i + 1) * 800⟩
+
+private def randomCubics (n : Nat) : Array Cubic :=
+  (Array.range n).map fun i => (scatter (4 * i), scatter (4 * i + 1), scatter (4 * i + 2), scatter (4 * i + 3))
+
+private def randomQuadratics (n : Nat) : Array (Point × Point × Point) :=
+  (Array.range n).map fun i => (scatter (3 * i), scatter (3 * i + 1), scatter (3 * i + 2))
+
+/-- The previous flattener: recursive de Casteljau subdivision until both control
+    points are within `tolerance` of the chord. -/
+private partial def flattenCubicBezierSubdivide (p0 p1 p2 p3 : Point) (tolerance : Float := 0.5) : Array Point :=
+  let rec go (p0 p1 p2 p3 : Point) (acc : Array Point) : Array Point :=
+    -- Check if curve is flat enough using distance from control points to line
+    let d1 := linePointDistance p0 p3 p1
+    let d2 := linePointDistance p0 p3 p2
+    if max d1 d2 < tolerance then
+      acc.push p3
+    else
+      -- Subdivide at t=0.5 using de Casteljau
+      let m01 := Point.midpoint p0 p1
+      let m12 := Point.midpoint p1 p2
+      let m23 := Point.midpoint p2 p3
+      let m012 := Point.midpoint m01 m12
+      let m123 := Point.midpoint m12 m23
+      let mid := Point.midpoint m012 m123
+      let acc' := go p0 m01 m012 mid acc
+      go mid m123 m23 p3 acc'
+  -- Start with capacity for typical curve subdivision depth (8-16 segments)
+  go p0 p1 p2 p3 (Array.mkEmpty 16)
+where
+  linePointDistance (lineStart lineEnd point : Point) : Float :=
+    let dx := lineEnd.x - lineStart.x
+    let dy := lineEnd.y - lineStart.y
+    let len := Float.sqrt (dx * dx + dy * dy)
+    if len < 0.0001 then
+      Point.distance lineStart point
+    else
+      Float.abs ((point.x - lineStart.x) * dy - (point.y - lineStart.y) * dx) / len
+
+/-- Time per curve and vertices emitted per curve of one flattener over `curves`. -/
+private def measure (curves : Array α) (flatten : α → Array Point) (sink : IO.Ref Nat) :
+    IO (Float × Float) := do
+  let iters := (200000 / curves.size).max 10
+  let ns ← timeNs iters do
+    sink.set (curves.foldl (fun n c => n + (flatten c).size) 0)
+  return (ns / curves.size.toFloat, (← sink.get).toFloat / curves.size.toFloat)
+
+private def row (title : String) (curves : Array α) (subdivide wang : α → Array Point)
+    (sink : IO.Ref Nat) : IO Unit := do
+  let (oldNs, oldVerts) ← measure curves subdivide sink
+  let (newNs, newVerts) ← measure curves wang sink
+  report title [
+    ("curves", toString curves.size),
+    ("subdivide", s!"{fmt oldVerts 1} verts, {fmt oldNs 0} ns"),
+    ("wang", s!"{fmt newVerts 1} verts, {fmt newNs 0} ns"),
+    ("speedup", s!"{fmt (oldNs / newNs)}x")
+  ]
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  let tolerance := 0.5
+  let subdivide : Cubic → Array Point := fun (p0, p1, p2, p3) =>
+    flattenCubicBezierSubdivide p0 p1 p2 p3 tolerance
+  let wang : Cubic → Array Point := fun (p0, p1, p2, p3) =>
+    flattenCubicBezier p0 p1 p2 p3 tolerance
+  IO.println "Curve flattening: Wang's formula vs recursive subdivision, 0.5 px tolerance"
+  for radius in [4.0, 20.0, 100.0, 1000.0] do
+    row s!"circle r={fmt radius 0}" (circleCubics radius) subdivide wang sink
+  row "random cubics" (randomCubics 1000) subdivide wang sink
+  row "random quadratics" (randomQuadratics 1000)
+    (fun (p0, cp, p2) => flattenCubicBezierSubdivide p0 (Point.lerp p0 cp (2.0 / 3.0))
+      (Point.lerp p2 cp (2.0 / 3.0)) p2 tolerance)
+    (fun (p0, cp, p2) => flattenQuadraticBezier p0 cp p2 tolerance) sink
+
+def benchmark : Benchmark :=
+  { name := "curve-flattening"
+    description := "Vertices and ns per curve: Wang's formula flattening vs recursive subdivision"
+    run := run }
+
+end Afferent.Bench.CurveFlatteningBench
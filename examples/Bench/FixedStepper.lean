@@ -0,0 +1,57 @@
+/-
+  FixedStepper Benchmark
+  Per-frame cost of fixed substeps with the fused interpolated write, plus a
+  seeded headless run whose checksum should match on every machine.
+-/
+import Afferent.FFI.FloatBuffer
+import Afferent.FFI.FixedStepper
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.FixedStepperBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+private def benchCount (count : Nat) : IO Unit := do
+  let stepper ← FixedStepper.create count.toUInt32 (1.0 / 120.0)
+  stepper.setBounds 1920.0 1080.0 2.0
+  stepper.initRandom 1920.0 1080.0 200.0 42
+  let buf ← FloatBuffer.create (count * 4).toUSize
+  let iters := if count >= 1000000 then 30 else 120
+
+  -- 60 Hz frames at a 120 Hz step: two substeps per frame, last one fused with the write
+  let frameNs ← timeNs iters do
+    let _ ← stepper.advance (1.0 / 60.0) buf .circles
+  let headlessNs ← timeNs iters (stepper.run 1)
+
+  report s!"particles={count}" [
+    ("frame(2 substeps+write)", s!"{fmt (frameNs / 1.0e6)} ms"),
+    ("headlessStep", s!"{fmt (headlessNs / 1.0e6)} ms"),
+    ("perParticleStep", s!"{fmt (headlessNs / count.toFloat)} ns")
+  ]
+  buf.destroy
+  stepper.destroy
+
+/-- Reference run: 10k particles, seed 42, 1200 steps. The checksum is
+    bit-exact, so it can be compared across machines and builds. -/
+private def reference : IO Unit := do
+  let stepper ← FixedStepper.create 10000 (1.0 / 120.0)
+  stepper.setBounds 1920.0 1080.0 2.0
+  stepper.initRandom 1920.0 1080.0 200.0 42
+  stepper.run 1200
+  let sum ← stepper.checksum
+  report "reference(10k, seed 42, 1200 steps)" [("checksum", s!"{sum}")]
+  stepper.destroy
+
+def run : IO Unit := do
+  IO.println "FixedStepper: fixed substeps + interpolated instance write"
+  for count in [100000, 1000000] do
+    benchCount count
+  reference
+
+def benchmark : Benchmark :=
+  { name := "fixed_stepper"
+    description := "fixed-timestep substeps with fused interpolated write; deterministic checksum"
+    run := run }
+
+end Afferent.Bench.FixedStepperBench
@@ -0,0 +1,65 @@
+/-
+  FrameArena Benchmark
+  Simulated frames of transient draw-call conversions: each frame narrows
+  ~200 FloatArrays of mixed sizes into scratch and releases them. Compares
+  passthrough mode (one malloc/free per conversion, the old bridge
+  behaviour) with the bump-pointer arena, reporting mallocs per frame.
+-/
+import Afferent.FFI.FrameArena
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.FrameArenaBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+/-- Payload sizes of one frame: many small batches, a few large ones. -/
+private def frameSizes : Array Nat := Id.run do
+  let mut sizes := #[]
+  for i in [:200] do
+    sizes := sizes.push (if i % 50 == 0 then 65536 else if i % 10 == 0 then 4096 else 96 + (i % 7) * 32)
+  sizes
+
+private def payloads : Array FloatArray :=
+  frameSizes.map fun n => ⟨(Array.range n).map (·.toFloat)⟩
+
+private def runFrames (arena : FrameArena) (frames : Nat) (sink : IO.Ref Float) : IO Float := do
+  let data := payloads
+  timeNs frames do
+    for p in data do
+      sink.set (← arena.narrowScratch p)
+    arena.reset
+
+def run : IO Unit := do
+  let frames := 200
+  IO.println s!"FrameArena: {frameSizes.size} transient conversions per frame, {frames} frames"
+  let sink ← IO.mkRef 0.0
+
+  let passthrough ← FrameArena.create
+  passthrough.setPassthrough true
+  let passNs ← runFrames passthrough frames sink
+  let passStats ← passthrough.stats
+  passthrough.destroy
+
+  let arena ← FrameArena.create
+  let arenaNs ← runFrames arena frames sink
+  let arenaStats ← arena.stats
+  arena.destroy
+
+  report "per frame" [
+    ("mallocs (passthrough)", toString passStats.lastFrameAllocs),
+    ("mallocs (arena)", toString arenaStats.lastFrameAllocs),
+    ("arena total mallocs", toString arenaStats.systemAllocs),
+    ("arena high-water", s!"{arenaStats.highWaterBytes / 1024} KiB"),
+    ("arena capacity", s!"{arenaStats.capacityBytes / 1024} KiB in {arenaStats.blockCount} block(s)"),
+    ("passthrough", s!"{fmt (passNs / 1000.0)} us"),
+    ("arena", s!"{fmt (arenaNs / 1000.0)} us"),
+    ("speedup", s!"{fmt (passNs / arenaNs)}x")
+  ]
+
+def benchmark : Benchmark :=
+  { name := "frame-arena"
+    description := "Per-frame transient conversions: malloc/free per call vs bump-pointer arena"
+    run := run }
+
+end Afferent.Bench.FrameArenaBench
@@ -0,0 +1,80 @@
+/-
+  Fringe Anti-aliasing Benchmark
+  Geometry cost of smoothing edges with a one-pixel alpha fringe instead of
+  4x MSAA, on the Shapes demo paths:
+  - fills: circles, stars, polygons, hearts, pies and rounded rects;
+  - strokes: the same outlines stroked 2px wide.
+  Each is tessellated with and without `antialias`; reports vertices,
+  indices and upload bytes per frame and their overhead, plus tessellation
+  time. MSAA's cost is fill rate and a 4-sample color target, which a
+  headless run cannot measure; the fringe trades it for this geometry.
+-/
+import Afferent.Render.PolygonFill
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.FringeAABench
+
+open Afferent
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+private def pi : Float := 3.14159265358979323846
+
+private def shapes : Array Path := #[
+  Path.circle ⟨550, 70⟩ 40, Path.circle ⟨650, 70⟩ 20, Path.circle ⟨750, 70⟩ 8,
+  Path.roundedRect (Rect.mk' 820 30 130 80) 15,
+  Path.star ⟨100, 200⟩ 50 25 5, Path.star ⟨220, 200⟩ 45 25 6, Path.star ⟨340, 200⟩ 40 25 8,
+  Path.polygon ⟨480, 200⟩ 45 3, Path.polygon ⟨600, 200⟩ 45 5,
+  Path.polygon ⟨720, 200⟩ 45 6, Path.polygon ⟨850, 200⟩ 45 8,
+  Path.heart ⟨100, 350⟩ 80, Path.heart ⟨230, 350⟩ 60,
+  Path.ellipse ⟨380, 350⟩ 70 40, Path.ellipse ⟨520, 350⟩ 40 60,
+  Path.pie ⟨680, 350⟩ 60 0 (pi * 0.5), Path.pie ⟨680, 350⟩ 60 (pi * 0.5) pi,
+  Path.semicircle ⟨850, 350⟩ 50 0,
+  Path.triangle ⟨100, 650⟩ ⟨180, 750⟩ ⟨20, 750⟩
+]
+
+/-- Vertices and indices of one frame of `tessellate` over the shapes. -/
+private def frame (tessellate : Path → IO TessellationResult) (sink : IO.Ref (Nat × Nat)) :
+    IO Unit := do
+  let mut vertices := 0
+  let mut indices := 0
+  for path in shapes do
+    let result ← tessellate path
+    vertices := vertices + result.vertices.size / 6
+    indices := indices + result.indices.size
+  sink.set (vertices, indices)
+
+private def measure (name : String) (plain fringed : Path → IO TessellationResult)
+    (sink : IO.Ref (Nat × Nat)) : IO Unit := do
+  let plainNs ← timeNs 200 (frame plain sink)
+  let (plainV, plainI) ← sink.get
+  let fringedNs ← timeNs 200 (frame fringed sink)
+  let (fringeV, fringeI) ← sink.get
+  -- float32 x, y, r, g, b, a per vertex and 32-bit indices, as uploaded
+  let bytes (v i : Nat) := (v * 24 + i * 4).toFloat
+  let overhead (a b : Nat) := s!"+{fmt ((b.toFloat / a.toFloat - 1) * 100) 0}%"
+  report name [
+    ("plain", s!"{plainV} verts, {plainI} idx, {fmtBytes (bytes plainV plainI)}, {fmt (plainNs / 1000.0)} us"),
+    ("fringe", s!"{fringeV} verts, {fringeI} idx, {fmtBytes (bytes fringeV fringeI)}, {fmt (fringedNs / 1000.0)} us"),
+    ("overhead", s!"{overhead plainV fringeV} verts, {overhead plainI fringeI} idx, {fmt (fringedNs / plainNs)}x time")
+  ]
+
+def run : IO Unit := do
+  let sink ← IO.mkRef (0, 0)
+  IO.println "Fringe AA: geometry overhead of one-pixel alpha fringes vs plain tessellation"
+  measure "shapes demo fills"
+    (fun p => Tessellation.tessellatePathNDC p Color.red canvasW canvasH)
+    (fun p => Tessellation.tessellatePathNDC p Color.red canvasW canvasH (antialias := true)) sink
+  let style := { StrokeStyle.default with lineWidth := 2.0 }
+  measure "shapes demo strokes 2px"
+    (fun p => pure (Tessellation.tessellateStrokeNDC p style canvasW canvasH))
+    (fun p => pure (Tessellation.tessellateStrokeNDC p style canvasW canvasH (antialias := true)))
+    sink
+
+def benchmark : Benchmark :=
+  { name := "fringe-aa"
+    description := "Shapes demo fills and strokes: vertex overhead of fringe anti-aliasing"
+    run := run }
+
+end Afferent.Bench.FringeAABench
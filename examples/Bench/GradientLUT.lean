@@ -0,0 +1,141 @@
+/-
+  Gradient LUT Benchmark
+  The Gradients demo's fills (multi-stop rects, radial circles, a gradient
+  star, heart and rounded rect) sampled by searching the stops for every
+  sample (Tessellation.sampleFillStyle) against 256-entry tables fetched
+  from a GradientLUTCache:
+  - per vertex: each fill tessellated as a path, as the Canvas draws it;
+  - per pixel: every pixel of each fill's bounds, the work a backend
+    evaluating gradients per pixel would do.
+  Reports time per frame and the largest color difference.
+-/
+import Afferent.Render.PolygonFill
+import Afferent.Render.GradientLUT
+import Afferent.Canvas.Culling
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.GradientLUTBench
+
+open Afferent
+open Afferent.Bench
+
+private def canvasW : Float := 1000
+private def canvasH : Float := 700
+
+private def sunset : Array GradientStop := #[
+  { position := 0.0, color := Color.hsva 0.667 0.667 0.3 1.0 },
+  { position := 0.3, color := Color.hsva 0.833 0.6 0.5 1.0 },
+  { position := 0.5, color := Color.hsva 0.024 0.778 0.9 1.0 },
+  { position := 0.7, color := Color.hsva 0.083 0.8 1.0 1.0 },
+  { position := 1.0, color := Color.hsva 0.139 0.6 1.0 1.0 }
+]
+
+private def chrome : Array GradientStop := #[
+  { position := 0.0, color := Color.hsva 0.0 0.0 0.3 1.0 },
+  { position := 0.2, color := Color.hsva 0.0 0.0 0.9 1.0 },
+  { position := 0.4, color := Color.hsva 0.0 0.0 0.5 1.0 },
+  { position := 0.6, color := Color.hsva 0.0 0.0 0.8 1.0 },
+  { position := 0.8, color := Color.hsva 0.0 0.0 0.4 1.0 },
+  { position := 1.0, color := Color.hsva 0.0 0.0 0.6 1.0 }
+]
+
+private def rainbow : Array GradientStop :=
+  gradient![Color.red, Color.orange, Color.yellow, Color.green, Color.blue, Color.purple,
+    Color.magenta]
+
+/-- The Gradients demo's fills. -/
+private def fills : Array (Path × FillStyle) := #[
+  (Path.rectangle (Rect.mk' 50 30 150 80),
+    .linearGradient ⟨50, 70⟩ ⟨200, 70⟩ gradient![Color.red, Color.yellow]),
+  (Path.rectangle (Rect.mk' 50 140 400 80), .linearGradient ⟨50, 180⟩ ⟨450, 180⟩ rainbow),
+  (Path.rectangle (Rect.mk' 480 140 180 80), .linearGradient ⟨570, 140⟩ ⟨570, 220⟩ sunset),
+  (Path.rectangle (Rect.mk' 230 560 150 100), .linearGradient ⟨230, 560⟩ ⟨230, 660⟩ chrome),
+  (Path.circle ⟨120, 320⟩ 70,
+    .radialGradient ⟨120, 320⟩ 70 gradient![Color.white, Color.blue]),
+  (Path.circle ⟨280, 320⟩ 70,
+    .radialGradient ⟨280, 320⟩ 70 gradient![Color.yellow, Color.orange, Color.red]),
+  (Path.roundedRect (Rect.mk' 50 420 150 100) 20,
+    .linearGradient ⟨50, 420⟩ ⟨200, 520⟩ gradient![Color.red, Color.blue]),
+  (Path.ellipse ⟨330, 470⟩ 80 50,
+    .radialGradient ⟨330, 470⟩ 80 gradient![Color.yellow, Color.purple]),
+  (Path.star ⟨520, 470⟩ 60 30 5,
+    .linearGradient ⟨460, 410⟩ ⟨580, 530⟩ gradient![Color.yellow, Color.orange, Color.red]),
+  (Path.heart ⟨700, 470⟩ 70,
+    .radialGradient ⟨700, 450⟩ 80
+      gradient![Color.hsva 0.0 0.5 1.0 1.0, Color.red, Color.hsva 0.0 1.0 0.5 1.0])
+]
+
+private def colorDistance (a b : Color) : Float :=
+  max (max (a.r - b.r).abs (a.g - b.g).abs) (max (a.b - b.b).abs (a.a - b.a).abs)
+
+/-- Pixel centers of a path's bounds. -/
+private def pixels (path : Path) : Array Point := Id.run do
+  let some b := Culling.pathBounds Transform.identity path | return #[]
+  let mut out := #[]
+  for y in [:(b.maxY - b.minY).toUInt64.toNat] do
+    for x in [:(b.maxX - b.minX).toUInt64.toNat] do
+      out := out.push ⟨b.minX.floor + x.toFloat + 0.5, b.minY.floor + y.toFloat + 0.5⟩
+  return out
+
+/-- Sum of red over `points`, sampled by `sample`. -/
+private def sumRed (points : Array Point) (sample : Point → Color) : Float :=
+  points.foldl (fun s p => s + (sample p).r) 0.0
+
+def run : IO Unit := do
+  let cache ← IO.mkRef ({} : GradientLUTCache)
+  let sink ← IO.mkRef 0.0
+  IO.println "Gradient LUT: stop search per sample vs cached 256-entry tables, Gradients demo fills"
+  -- Per vertex: tessellate every fill
+  let exactVertex : IO Unit := do
+    let mut floats := 0
+    for (path, style) in fills do
+      let r ← Tessellation.tessellatePathFillNDC path path .identity style canvasW canvasH
+      floats := floats + r.vertices.size
+    sink.set floats.toFloat
+  let lutVertex : IO Unit := do
+    let mut floats := 0
+    for (path, style) in fills do
+      let lut ← GradientLUTCache.forStyle cache style
+      let r ← Tessellation.tessellatePathFillNDC path path .identity style canvasW canvasH
+        (lut := lut)
+      floats := floats + r.vertices.size
+    sink.set floats.toFloat
+  let exactVertexNs ← timeNs 200 exactVertex
+  let lutVertexNs ← timeNs 200 lutVertex
+  -- Per pixel: evaluate each fill over its bounds
+  let areas := fills.map fun (path, _) => pixels path
+  let exactPixel : IO Unit := do
+    let mut sum := 0.0
+    for (_, style) in fills, area in areas do
+      sum := sum + sumRed area (Tessellation.sampleFillStyle style)
+    sink.set sum
+  let lutPixel : IO Unit := do
+    let mut sum := 0.0
+    for (_, style) in fills, area in areas do
+      let lut ← GradientLUTCache.forStyle cache style
+      sum := sum + sumRed area (GradientLUT.sampler lut style)
+    sink.set sum
+  let exactPixelNs ← timeNs 5 exactPixel
+  let lutPixelNs ← timeNs 5 lutPixel
+  let mut maxError := 0.0
+  for (_, style) in fills, area in areas do
+    let sample := GradientLUT.sampler (← GradientLUTCache.forStyle cache style) style
+    for p in area do
+      maxError := max maxError (colorDistance (sample p) (Tessellation.sampleFillStyle style p))
+  let pixelCount := areas.foldl (· + ·.size) 0
+  report s!"{fills.size} gradient fills" [
+    ("per vertex, stops", s!"{fmt (exactVertexNs / 1000.0)} us/frame"),
+    ("per vertex, LUT",
+      s!"{fmt (lutVertexNs / 1000.0)} us/frame, {fmt (exactVertexNs / lutVertexNs)}x"),
+    ("per pixel, stops", s!"{pixelCount} px, {fmt (exactPixelNs / 1.0e6)} ms/frame"),
+    ("per pixel, LUT",
+      s!"{fmt (lutPixelNs / 1.0e6)} ms/frame, {fmt (exactPixelNs / lutPixelNs)}x"),
+    ("max color error", s!"{fmt (maxError * 255.0)} / 255")
+  ]
+
+def benchmark : Benchmark :=
+  { name := "gradient-lut"
+    description := "Gradients demo fills sampled per vertex and per pixel: stop search vs LUTs"
+    run := run }
+
+end Afferent.Bench.GradientLUTBench
@@ -0,0 +1,50 @@
+/-
+  Afferent Benchmark Harness
+  Minimal timing/reporting helpers shared by the headless benchmarks.
+-/
+
+namespace Afferent.Bench
+
+/-- A named headless benchmark. -/
+structure Benchmark where
+  name : String
+  description : String
+  run : IO Unit
+
+/-- Run `action` `warmup` times untimed, then `iters` times; returns mean ns per iteration. -/
+def timeNs (iters : Nat) (action : IO Unit) (warmup : Nat := 3) : IO Float := do
+  for _ in [0:warmup] do action
+  let start ← IO.monoNanosNow
+  for _ in [0:iters] do action
+  let stop ← IO.monoNanosNow
+  pure ((stop - start).toFloat / (iters.max 1).toFloat)
+
+/-- Mean Lean small-object allocations (runtime heartbeats) per run of `action`. -/
+def allocsPerIter (iters : Nat) (action : IO Unit) : IO Float := do
+  let h0 ← IO.getNumHeartbeats
+  for _ in [0:iters] do action
+  let h1 ← IO.getNumHeartbeats
+  pure ((h1 - h0).toFloat / (iters.max 1).toFloat)
+
+/-- Format a float with a fixed number of decimals. -/
+def fmt (x : Float) (decimals : Nat := 2) : String :=
+  let scale := (10 : Float) ^ decimals.toFloat
+  let n := (x.abs * scale).round.toUInt64.toNat
+  let whole := n / 10 ^ decimals
+  let frac := toString (n % 10 ^ decimals)
+  let sign := if x < 0 then "-" else ""
+  if decimals == 0 then s!"{sign}{whole}"
+  else s!"{sign}{whole}.{"".pushn '0' (decimals - frac.length)}{frac}"
+
+/-- Human-readable byte count. -/
+def fmtBytes (bytes : Float) : String :=
+  if bytes >= 1048576.0 then s!"{fmt (bytes / 1048576.0)} MiB"
+  else if bytes >= 1024.0 then s!"{fmt (bytes / 1024.0)} KiB"
+  else s!"{fmt bytes 0} B"
+
+/-- Print one result row: `name  key=value  key=value ...`. -/
+def report (name : String) (fields : List (String × String)) : IO Unit := do
+  let cols := fields.map fun (k, v) => s!"{k}={v}"
+  IO.println s!"  {name.pushn ' ' (28 - min 28 name.length)} {" ".intercalate cols}"
+
+end Afferent.Bench
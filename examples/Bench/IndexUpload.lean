@@ -0,0 +1,105 @@
+/-
+  Index Upload Benchmark
+  Index traffic for batched frames modelled on the Shapes and Widgets demos:
+  - the legacy path accumulates an `Array UInt32` and the upload unboxes it
+    element by element into 32-bit indices;
+  - batches now accumulate packed little-endian u16 indices in a ByteArray
+    that is copied with one memcpy (u32 only past 65536 vertices).
+  Headless, so the upload is measured up to the copy into native memory.
+-/
+import Afferent.Render.Tessellation
+import Afferent.FFI.Marshal
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.IndexUploadBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- Stars, polygons, circles, ellipses and rounded rects, as in the Shapes demo,
+    tiled `copies` times. -/
+private def shapesScene (copies : Nat) : Array TessellationResult := Id.run do
+  let mut out := #[]
+  for i in [:copies] do
+    let dx := (i % 8).toFloat * 150
+    let dy := (i / 8).toFloat * 100
+    let paths := #[
+      Path.star ⟨dx + 50, dy + 50⟩ 40 20 5,
+      Path.polygon ⟨dx + 100, dy + 50⟩ 30 6,
+      Path.circle ⟨dx + 50, dy + 80⟩ 25,
+      Path.ellipse ⟨dx + 100, dy + 80⟩ 30 15,
+      Path.roundedRect (Rect.mk' dx dy 120 60) 10
+    ]
+    for p in paths do
+      out := out.push (Tessellation.tessellateConvexPathNDC p Color.red canvasW canvasH)
+  out
+
+/-- Boxes, cards and borders, as in the Widgets demo, tiled `copies` times. -/
+private def widgetsScene (copies : Nat) : Array TessellationResult := Id.run do
+  let mut out := #[]
+  for i in [:copies] do
+    let x := (i % 16).toFloat * 80
+    let y := (i / 16).toFloat * 50
+    let r := Rect.mk' x y 76 46
+    out := out.push (Tessellation.tessellateConvexPathNDC (Path.roundedRect r 12) Color.blue canvasW canvasH)
+    out := out.push (Tessellation.tessellateRectNDC (Rect.mk' (x + 4) (y + 24) 68 18) Color.green canvasW canvasH)
+    out := out.push (Tessellation.tessellateStrokeNDC (Path.rectangle r)
+      { StrokeStyle.default with color := Color.white, lineWidth := 1 } canvasW canvasH)
+  out
+
+/-- The pre-u16 accumulation: offset indices pushed onto an `Array UInt32`. -/
+private def legacyIndices (results : Array TessellationResult) : Array UInt32 := Id.run do
+  let mut indices := Array.mkEmpty (results.size * 10)
+  let mut offset : UInt32 := 0
+  for r in results do
+    for i in r.indices do
+      indices := indices.push (i + offset)
+    offset := offset + (r.vertices.size / 6).toUInt32
+  indices
+
+private def batchOf (results : Array TessellationResult) : Batch :=
+  results.foldl Batch.add (Batch.withCapacity results.size)
+
+private def runScene (name : String) (results : Array TessellationResult) : IO Unit := do
+  let sink ← IO.mkRef (0 : UInt64)
+  let legacy := legacyIndices results
+  let batch := batchOf results
+  let width := batch.indexFormat.bytesPerIndex.toUInt8
+  let arrayNs ← timeNs 200 do
+    sink.set (← Marshal.copyIndexArray legacy)
+  let bytesNs ← timeNs 200 do
+    sink.set (← Marshal.copyIndexBytes batch.indexData width)
+  let buildLegacyNs ← timeNs 20 do
+    sink.set (legacyIndices results).size.toUInt64
+  let buildBatchNs ← timeNs 20 do
+    sink.set (batchOf results).indexCount.toUInt64
+  let same := (← Marshal.copyIndexArray legacy) == (← Marshal.copyIndexBytes batch.indexData width)
+  IO.println s!"Index upload: {name}, {batch.vertexCount} vertices, {batch.indexCount} indices ({repr batch.indexFormat})"
+  report "per frame" [
+    ("u32 bytes", fmtBytes (legacy.size * 4).toFloat),
+    ("batch bytes", fmtBytes batch.indexData.size.toFloat),
+    ("saved", s!"{fmt (100 - 100 * batch.indexData.size.toFloat / (legacy.size * 4).toFloat) 0}%"),
+    ("marshal Array UInt32", s!"{fmt (arrayNs / 1000.0)} us"),
+    ("marshal ByteArray", s!"{fmt (bytesNs / 1000.0)} us"),
+    ("speedup", s!"{fmt (arrayNs / bytesNs)}x"),
+    ("build Array UInt32", s!"{fmt (buildLegacyNs / 1000.0)} us"),
+    ("build Batch", s!"{fmt (buildBatchNs / 1000.0)} us"),
+    ("results match", toString same)
+  ]
+
+def run : IO Unit := do
+  runScene "shapes demo x64" (shapesScene 64)
+  runScene "widgets demo x256" (widgetsScene 256)
+  -- Large enough to cross 65536 vertices and fall back to u32
+  runScene "shapes demo x2048" (shapesScene 2048)
+
+def benchmark : Benchmark :=
+  { name := "index-upload"
+    description := "Batched index upload: Array UInt32 unboxing vs packed u16/u32 ByteArray"
+    run := run }
+
+end Afferent.Bench.IndexUploadBench
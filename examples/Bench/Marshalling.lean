@@ -0,0 +1,62 @@
+/-
+  Marshalling Benchmark
+  Cost of handing 1M floats to native code: `Array Float` (boxed, unboxed
+  element by element) vs `FloatArray` (contiguous, SIMD-narrowed). Also
+  times building each representation in Lean, since that is the other half
+  of every per-frame upload.
+-/
+import Afferent.FFI.Marshal
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.MarshallingBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+private def buildArray (n : Nat) (seed : Float) : Array Float := Id.run do
+  let mut arr := Array.mkEmpty n
+  for i in [:n] do
+    arr := arr.push (i.toFloat * 0.5 + seed)
+  arr
+
+private def buildFloatArray (n : Nat) (seed : Float) : FloatArray := Id.run do
+  let mut arr := FloatArray.emptyWithCapacity n
+  for i in [:n] do
+    arr := arr.push (i.toFloat * 0.5 + seed)
+  arr
+
+def run : IO Unit := do
+  let n := 1000000
+  IO.println s!"Marshalling: {n} floats, Lean -> float32"
+  let sink ← IO.mkRef 0.0
+  let seedRef ← IO.mkRef (0 : Nat)
+  let next : IO Float := seedRef.modifyGet fun s => (s.toFloat, s + 1)
+
+  let buildArrayNs ← timeNs 5 do
+    sink.set (buildArray n (← next)).size.toFloat
+  let buildFloatArrayNs ← timeNs 5 do
+    sink.set (buildFloatArray n (← next)).size.toFloat
+
+  let arr := buildArray n 1.0
+  let farr := buildFloatArray n 1.0
+  let arrayNs ← timeNs 20 do
+    sink.set (← Marshal.narrowArray arr)
+  let floatArrayNs ← timeNs 20 do
+    sink.set (← Marshal.narrowFloatArray farr)
+  let same := (← Marshal.narrowArray arr) == (← Marshal.narrowFloatArray farr)
+
+  report "per 1M floats" [
+    ("build Array Float", s!"{fmt (buildArrayNs / 1.0e6)} ms"),
+    ("build FloatArray", s!"{fmt (buildFloatArrayNs / 1.0e6)} ms"),
+    ("marshal Array Float", s!"{fmt (arrayNs / 1.0e6) (decimals := 3)} ms"),
+    ("marshal FloatArray", s!"{fmt (floatArrayNs / 1.0e6) (decimals := 3)} ms"),
+    ("speedup", s!"{fmt (arrayNs / floatArrayNs)}x"),
+    ("results match", toString same)
+  ]
+
+def benchmark : Benchmark :=
+  { name := "marshalling"
+    description := "1M floats to native: Array Float unboxing vs FloatArray SIMD narrowing"
+    run := run }
+
+end Afferent.Bench.MarshallingBench
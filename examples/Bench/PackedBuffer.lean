@@ -0,0 +1,55 @@
+/-
+  PackedBuffer Benchmark
+  Bytes written per frame for all-f32 instance streams vs packed schemas,
+  plus the CPU cost of the pack kernel.
+-/
+import Afferent.FFI.FloatBuffer
+import Afferent.FFI.PackedBuffer
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.PackedBufferBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+/-- Fill a FloatBuffer with `count` instances of `floats` plausible values each. -/
+private def fillSource (count floats : Nat) : IO FloatBuffer := do
+  let buf ← FloatBuffer.create (count * floats).toUSize
+  for i in [0:count * floats] do
+    let v := (i % 97).toFloat / 97.0
+    buf.set i.toUSize v
+  pure buf
+
+private def benchSchema (label : String) (schema : PackedSchema) (count : Nat) : IO Unit := do
+  let floats := schema.floatCount
+  let src ← fillSource count floats
+  let packed ← PackedBuffer.create schema count.toUSize
+  let bytesRef ← IO.mkRef (0 : USize)
+  let ns ← timeNs 50 do
+    bytesRef.set (← packed.packFromFloatBuffer 0 src count.toUSize)
+  let packedBytes := (← bytesRef.get).toNat.toFloat
+  let f32Bytes := (count * floats * 4).toFloat
+  report s!"{label} x{count}" [
+    ("f32/frame", fmtBytes f32Bytes),
+    ("packed/frame", fmtBytes packedBytes),
+    ("stride", s!"{← packed.stride}B"),
+    ("saved", s!"{fmt ((1.0 - packedBytes / f32Bytes) * 100.0) 1}%"),
+    ("pack", s!"{fmt (ns / 1000.0)} us"),
+    ("ns/inst", fmt (ns / count.toFloat))
+  ]
+  packed.destroy
+  src.destroy
+
+def run : IO Unit := do
+  IO.println "PackedBuffer: bytes written per frame"
+  for count in [10000, 100000, 1000000] do
+    benchSchema "instanceRect" PackedSchema.instanceRect count
+    benchSchema "sprite" PackedSchema.sprite count
+    benchSchema "dynamicCircle" PackedSchema.dynamicCircle count
+
+def benchmark : Benchmark :=
+  { name := "packed_buffer"
+    description := "f32 vs packed instance bytes per frame and pack throughput"
+    run := run }
+
+end Afferent.Bench.PackedBufferBench
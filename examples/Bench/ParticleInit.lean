@@ -0,0 +1,61 @@
+/-
+  ParticleInit Benchmark
+  Startup cost of 4M particles: the old Lean LCG loop vs the native
+  counter-based initializer at 1 thread and all threads.
+-/
+import Afferent.FFI.FloatBuffer
+import Afferent.FFI.ParticleInit
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.ParticleInitBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+/-- The previous `ParticleState.create` loop, kept as the baseline. -/
+private def leanLcg (count : Nat) (w h : Float) (seed : Nat) : FloatArray := Id.run do
+  let mut arr := FloatArray.emptyWithCapacity (count * 5)
+  let mut s := seed
+  for i in [:count] do
+    s := (s * 1103515245 + 12345) % (2^31)
+    let x := (s.toFloat / 2147483648.0) * w
+    s := (s * 1103515245 + 12345) % (2^31)
+    let y := (s.toFloat / 2147483648.0) * h
+    s := (s * 1103515245 + 12345) % (2^31)
+    let vx := (s.toFloat / 2147483648.0 - 0.5) * 400.0
+    s := (s * 1103515245 + 12345) % (2^31)
+    let vy := (s.toFloat / 2147483648.0 - 0.5) * 400.0
+    arr := arr.push x |>.push y |>.push vx |>.push vy |>.push (i.toFloat / count.toFloat)
+  arr
+
+def run : IO Unit := do
+  IO.println "ParticleInit: 4M particles [x, y, vx, vy, hue]"
+  let count := 4000000
+  let init : ParticleInit := { position := .rect 0.0 0.0 1920.0 1080.0, velocity := .box 200.0 }
+  let sizeRef ← IO.mkRef 0
+  -- Seeds vary per iteration so the pure calls cannot be shared
+  let seedRef ← IO.mkRef (1 : Nat)
+  let next : IO Nat := seedRef.modifyGet fun s => (s, s + 1)
+  let leanNs ← timeNs 2 (warmup := 1) do
+    sizeRef.set (leanLcg count 1920.0 1080.0 (← next)).size
+  let oneNs ← timeNs 5 do
+    sizeRef.set (Particles.generate count init (← next).toUInt32 1).size
+  let allNs ← timeNs 5 do
+    sizeRef.set (Particles.generate count init (← next).toUInt32 0).size
+  let buf ← FloatBuffer.create (count * 5).toUSize
+  let bufNs ← timeNs 5 do
+    buf.initParticles count.toUInt32 init (← next).toUInt32
+  buf.destroy
+  report s!"count={count}" [
+    ("leanLcg", s!"{fmt (leanNs / 1.0e6)} ms"),
+    ("native(1 thread)", s!"{fmt (oneNs / 1.0e6)} ms"),
+    ("native(all threads)", s!"{fmt (allNs / 1.0e6)} ms"),
+    ("floatBuffer(all threads)", s!"{fmt (bufNs / 1.0e6)} ms")
+  ]
+
+def benchmark : Benchmark :=
+  { name := "particle_init"
+    description := "4M particle setup: Lean LCG loop vs parallel Philox initializer"
+    run := run }
+
+end Afferent.Bench.ParticleInitBench
@@ -0,0 +1,61 @@
+/-
+  ParticleSystem Benchmark
+  Steady-state spawn/update/compact throughput with the fused FloatBuffer write.
+-/
+import Afferent.FFI.FloatBuffer
+import Afferent.FFI.ParticleSystem
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.ParticleSystemBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+private def benchCapacity (capacity : Nat) (layout : ParticleLayout) : IO Unit := do
+  let sys ← ParticleSystem.create capacity.toUInt32 7
+  -- Four emitters whose combined rate refills the system about once per average lifetime
+  let rate := capacity.toFloat / 1.25 / 4.0
+  for k in [0:4] do
+    let _ ← sys.addEmitter {
+      x := 200.0 + k.toFloat * 300.0, y := 500.0, rate := rate,
+      speedMin := 50.0, speedMax := 200.0, lifeMin := 0.5, lifeMax := 2.0,
+      sizeStart := 3.0, sizeEnd := 0.0, hueStart := 0.0, hueEnd := 1.0, spin := 1.0 }
+  sys.setGravity 0.0 300.0
+  sys.setDrag 0.5
+  let _ ← sys.addAttractor 800.0 400.0 1.0e6 20.0
+  let buf ← FloatBuffer.create (capacity * layout.floatCount).toUSize
+  let dt := 1.0 / 60.0
+  -- Warm up to steady state before timing
+  for _ in [0:120] do
+    let _ ← sys.step dt buf layout
+  let before ← sys.stats
+  let iters := if capacity >= 1000000 then 30 else 120
+  let stepNs ← timeNs iters (warmup := 0) do
+    let _ ← sys.step dt buf layout
+  let after ← sys.stats
+  let spawned := (after.totalSpawned - before.totalSpawned).toFloat / iters.toFloat
+  let died := (after.totalDied - before.totalDied).toFloat / iters.toFloat
+
+  let layoutName := if layout == .circles then "circles" else "sprites"
+  report s!"capacity={capacity} layout={layoutName}" [
+    ("step", s!"{fmt (stepNs / 1.0e6)} ms"),
+    ("live", s!"{after.live}"),
+    ("perParticle", s!"{fmt (stepNs / after.live.toFloat)} ns"),
+    ("spawned/step", fmt spawned 0),
+    ("died/step", fmt died 0)
+  ]
+  buf.destroy
+  sys.destroy
+
+def run : IO Unit := do
+  IO.println "ParticleSystem: emit + integrate + compact + write"
+  for capacity in [100000, 1000000] do
+    benchCapacity capacity .circles
+  benchCapacity 1000000 .sprites
+
+def benchmark : Benchmark :=
+  { name := "particle_system"
+    description := "emitter spawn, force integration and swap-remove compaction at 100k and 1M"
+    run := run }
+
+end Afferent.Bench.ParticleSystemBench
@@ -0,0 +1,116 @@
+/-
+  Path Tessellation Benchmark
+  Paths per second for the Shapes demo fills and the Strokes demo strokes:
+  - Lean: tessellateConvexPathNDC / tessellateStrokeNDC, appended to a Batch;
+  - native: the same paths encoded and tessellated in C into a VertexWriter;
+  - native, pre-encoded: command streams built once, as a retained scene would.
+-/
+import Afferent.Render.NativeTessellation
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.PathTessellationBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+private def pi : Float := 3.14159265358979323846
+
+/-- The filled paths of the Shapes demo. -/
+private def shapesPaths : Array Path := #[
+  Path.rectangle (Rect.mk' 50 30 120 80),
+  Path.rectangle (Rect.mk' 200 30 120 80),
+  Path.rectangle (Rect.mk' 350 30 120 80),
+  Path.circle ⟨550, 70⟩ 40, Path.circle ⟨650, 70⟩ 40, Path.circle ⟨750, 70⟩ 40,
+  Path.roundedRect (Rect.mk' 820 30 130 80) 15,
+  Path.star ⟨100, 200⟩ 50 25 5, Path.star ⟨220, 200⟩ 45 25 6, Path.star ⟨340, 200⟩ 40 25 8,
+  Path.polygon ⟨480, 200⟩ 45 3, Path.polygon ⟨600, 200⟩ 45 5,
+  Path.polygon ⟨720, 200⟩ 45 6, Path.polygon ⟨850, 200⟩ 45 8,
+  Path.heart ⟨100, 350⟩ 80, Path.heart ⟨230, 350⟩ 60,
+  Path.ellipse ⟨380, 350⟩ 70 40, Path.ellipse ⟨520, 350⟩ 40 60,
+  Path.pie ⟨680, 350⟩ 60 0 (pi * 0.5), Path.pie ⟨680, 350⟩ 60 (pi * 0.5) pi,
+  Path.pie ⟨680, 350⟩ 60 pi (pi * 1.5), Path.pie ⟨680, 350⟩ 60 (pi * 1.5) (pi * 2),
+  Path.semicircle ⟨850, 350⟩ 50 0,
+  Path.arcPath ⟨550, 530⟩ 50 0 (pi * 1.5) |>.closePath,
+  Path.roundedRect (Rect.mk' 650 470 100 80) 5, Path.roundedRect (Rect.mk' 780 470 100 80) 30,
+  Path.triangle ⟨100, 650⟩ ⟨180, 750⟩ ⟨20, 750⟩,
+  Path.equilateralTriangle ⟨280, 700⟩ 50, Path.equilateralTriangle ⟨380, 700⟩ 40
+]
+
+/-- The stroked paths of the Strokes demo, with their line widths. -/
+private def strokesPaths : Array (Path × Float) := #[
+  (Path.rectangle (Rect.mk' 50 30 100 70), 1), (Path.rectangle (Rect.mk' 180 30 100 70), 2),
+  (Path.rectangle (Rect.mk' 310 30 100 70), 4), (Path.rectangle (Rect.mk' 440 30 100 70), 8),
+  (Path.circle ⟨620, 65⟩ 35, 2), (Path.circle ⟨720, 65⟩ 35, 4), (Path.circle ⟨820, 65⟩ 35, 6),
+  (Path.empty |>.moveTo ⟨50, 140⟩ |>.lineTo ⟨200, 140⟩, 1),
+  (Path.empty |>.moveTo ⟨50, 160⟩ |>.lineTo ⟨200, 160⟩, 2),
+  (Path.empty |>.moveTo ⟨250, 130⟩ |>.lineTo ⟨350, 220⟩, 2),
+  (Path.roundedRect (Rect.mk' 450 130 120 80) 10, 3),
+  (Path.roundedRect (Rect.mk' 600 130 120 80) 20, 4),
+  (Path.roundedRect (Rect.mk' 750 130 120 80) 30, 5),
+  (Path.ellipse ⟨100, 300⟩ 60 30, 2), (Path.ellipse ⟨250, 300⟩ 30 50, 3),
+  (Path.ellipse ⟨400, 300⟩ 50 50, 4),
+  (Path.star ⟨550, 300⟩ 50 25 5, 2), (Path.star ⟨680, 300⟩ 45 20 6, 3),
+  (Path.star ⟨810, 300⟩ 40 18 8, 4),
+  (Path.polygon ⟨80, 420⟩ 40 3, 2), (Path.polygon ⟨260, 420⟩ 40 5, 2),
+  (Path.polygon ⟨440, 420⟩ 40 8, 2), (Path.heart ⟨560, 420⟩ 60, 3)
+]
+
+private def styleOf (width : Float) : StrokeStyle :=
+  { StrokeStyle.default with color := Color.white, lineWidth := width }
+
+private def row (title : String) (paths : Nat) (leanNs nativeNs encodedNs : Float)
+    (vertices : Nat) : IO Unit :=
+  let perSec (ns : Float) := fmt (paths.toFloat / (ns / 1.0e9)) 0
+  report title [
+    ("paths", toString paths),
+    ("vertices", toString vertices),
+    ("lean", s!"{perSec leanNs} paths/s"),
+    ("native", s!"{perSec nativeNs} paths/s"),
+    ("pre-encoded", s!"{perSec encodedNs} paths/s"),
+    ("speedup", s!"{fmt (leanNs / nativeNs)}x / {fmt (leanNs / encodedNs)}x")
+  ]
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  let w ← VertexWriter.create 6 65536 131072
+  let iters := 500
+  IO.println "Path tessellation: Shapes and Strokes demo content"
+
+  let fillLean ← timeNs iters do
+    let batch := shapesPaths.foldl (fun b p =>
+      b.add (Tessellation.tessellateConvexPathNDC p Color.red canvasW canvasH)) (Batch.withCapacity 32)
+    sink.set batch.vertexCount
+  let fillNative ← timeNs iters do
+    w.clear
+    VertexWriterM.run (shapesPaths.forM fun p => VertexWriterM.emitFillPath p Color.red canvasW canvasH) w
+  let encodedFills := shapesPaths.map NativeTessellation.encodePath
+  let fillEncoded ← timeNs iters do
+    w.clear
+    VertexWriterM.run (encodedFills.forM fun c => VertexWriterM.emitFillEncoded c Color.red canvasW canvasH) w
+  row "shapes demo fills" shapesPaths.size fillLean fillNative fillEncoded (← w.vertexCount).toNat
+
+  let strokeLean ← timeNs iters do
+    let batch := strokesPaths.foldl (fun b (p, width) =>
+      b.add (Tessellation.tessellateStrokeNDC p (styleOf width) canvasW canvasH)) (Batch.withCapacity 32)
+    sink.set batch.vertexCount
+  let strokeNative ← timeNs iters do
+    w.clear
+    VertexWriterM.run (strokesPaths.forM fun (p, width) =>
+      VertexWriterM.emitStrokePath p (styleOf width) canvasW canvasH) w
+  let encodedStrokes := strokesPaths.map fun (p, width) => (NativeTessellation.encodePath p, width)
+  let strokeEncoded ← timeNs iters do
+    w.clear
+    VertexWriterM.run (encodedStrokes.forM fun (c, width) =>
+      VertexWriterM.emitStrokeEncoded c (styleOf width) canvasW canvasH) w
+  row "strokes demo strokes" strokesPaths.size strokeLean strokeNative strokeEncoded (← w.vertexCount).toNat
+  w.destroy
+
+def benchmark : Benchmark :=
+  { name := "path-tessellation"
+    description := "Shapes/Strokes demo paths per second: Lean tessellator vs native C into a VertexWriter"
+    run := run }
+
+end Afferent.Bench.PathTessellationBench
@@ -0,0 +1,83 @@
+/-
+  Polygon Triangulation Benchmark
+  The native polygon triangulator from 10 to 100k vertices:
+  - star: a simple concave ring, ear clipped;
+  - holed: a concave ring with a concave hole, ear clipped after bridging;
+  - {m/2}: a self-intersecting star polygon, swept under even-odd;
+  - fan: the Lean convex fan, which non-convex fills used to get, for scale.
+  Reports time per polygon and vertices per second.
+-/
+import Afferent.Render.PolygonFill
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.PolygonTriangulationBench
+
+open Afferent
+open Afferent.Tessellation
+open Afferent.Bench
+
+private def pi : Float := 3.14159265358979323846
+
+/-- `n` points around a circle at radius r(i); x, y pairs. -/
+private def ring (n : Nat) (cx cy : Float) (radius : Nat → Float) (step : Nat := 1) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (n * 2)
+  for i in [:n] do
+    let angle := 2 * pi * ((i * step) % n).toFloat / n.toFloat
+    out := out.push (cx + radius i * Float.cos angle) |>.push (cy + radius i * Float.sin angle)
+  return out
+
+private def starRadius (outer inner : Float) (i : Nat) : Float :=
+  if i % 2 == 0 then outer else inner
+
+private def row (title : String) (vertices : Nat) (ns : Float) (triangles : Nat) : IO Unit :=
+  report title [
+    ("vertices", toString vertices),
+    ("triangles", toString triangles),
+    ("time", s!"{fmt (ns / 1000.0)} us"),
+    ("rate", s!"{fmt (vertices.toFloat / (ns / 1.0e9) / 1.0e6)} Mverts/s")
+  ]
+
+private def measure (title : String) (points : FloatArray) (ends : Array UInt32) (rule : FillRule)
+    (sink : IO.Ref Nat) : IO Unit := do
+  let vertices := points.size / 2
+  let iters := (200000 / vertices).max 3
+  let ns ← timeNs iters do
+    let (_, indices, _) ← FFI.Tessellator.triangulate points ends (fillRuleCode rule)
+    sink.set indices.size
+  row title vertices ns ((← sink.get) / 3)
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  IO.println "Polygon triangulation: native ear clipping and sweep, 10 to 100k vertices"
+  for n in [10, 100, 1000, 10000, 100000] do
+    let star := ring n 0 0 (starRadius 1000 700)
+    measure s!"star {n}" star #[n.toUInt32] .nonZero sink
+
+    let outer := n / 2
+    let hole := ring (n - outer) 0 0 (starRadius 500 350)
+    -- Reverse the hole so it winds against the outer ring
+    let holeReversed := Id.run do
+      let mut out := FloatArray.emptyWithCapacity hole.size
+      for k in [:hole.size / 2] do
+        let j := hole.size / 2 - 1 - k
+        out := out.push hole[2 * j]! |>.push hole[2 * j + 1]!
+      return out
+    let holed := (ring outer 0 0 (starRadius 1000 800)) ++ holeReversed
+    measure s!"holed {n}" holed #[outer.toUInt32, n.toUInt32] .nonZero sink
+
+    -- {m/2}, m odd: each vertex joined to the next but one, so every edge
+    -- crosses its neighbours' and the centre is wound twice
+    let m := if n % 2 == 0 then n + 1 else n
+    let selfCrossing := ring m 0 0 (fun _ => 1000) 2
+    measure s!"\{m/2} {m}" selfCrossing #[m.toUInt32] .evenOdd sink
+
+    let fanNs ← timeNs ((200000 / n).max 3) do
+      sink.set (triangulateConvexFan n).size
+    row s!"fan {n}" n fanNs ((← sink.get) / 3)
+
+def benchmark : Benchmark :=
+  { name := "polygon-triangulation"
+    description := "Native triangulator on stars, holed rings and {m/2} star polygons of 10 to 100k vertices"
+    run := run }
+
+end Afferent.Bench.PolygonTriangulationBench
@@ -0,0 +1,80 @@
+/-
+  Polyline Reduction Benchmark
+  Stroking 1M- and 10M-point series 1px wide across a 1280px canvas, as a
+  chart of a long time series does:
+  - unreduced: every point goes to the native stroker;
+  - reduced: min/max per pixel column first (`emitStrokePolyline`);
+  - reduced, non-monotonic: a dense Lissajous figure through RDP.
+  Reports time per stroke, points kept and vertices emitted. The series is
+  encoded once outside the timed loop, so the unreduced time is the stroker's.
+-/
+import Afferent.Render.Polyline
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.PolylineReductionBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+/-- `count` samples of a noisy signal spanning the canvas width. -/
+private def timeSeries (count : Nat) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (2 * count)
+  for i in [:count] do
+    let x := i.toFloat * canvasW / count.toFloat
+    out := out.push x |>.push (400 + 200 * Float.sin (x * 0.02) + 80 * Float.sin (i.toFloat * 0.37))
+  out
+
+/-- `count` samples of a Lissajous figure, retraced 50 times. -/
+private def lissajous (count : Nat) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (2 * count)
+  for i in [:count] do
+    let t := i.toFloat / count.toFloat * 314.159265358979
+    out := out.push (640 + 500 * Float.sin (3 * t)) |>.push (400 + 300 * Float.sin (4 * t + 0.5))
+  out
+
+private def stroke (action : VertexWriterM Unit) (writer : VertexWriter) (sink : IO.Ref Nat) :
+    IO Unit := do
+  action.run writer
+  sink.set (← writer.vertexCount).toNat
+  writer.clear
+
+def run : IO Unit := do
+  let writer ← VertexWriter.create
+  let sink ← IO.mkRef 0
+  let style := { StrokeStyle.default with lineWidth := 1.0 }
+  IO.println "Polyline reduction: 1px strokes of long series on a 1280px canvas"
+  for count in [1000000, 10000000] do
+    let series := timeSeries count
+    let encoded := Polyline.encode series
+    let full := VertexWriterM.emitStrokeEncoded encoded style canvasW canvasH
+    let reduced := VertexWriterM.emitStrokePolyline series style canvasW canvasH
+    let fullNs ← timeNs 1 (stroke full writer sink) (warmup := 0)
+    let fullVerts ← sink.get
+    let reducedNs ← timeNs 3 (stroke reduced writer sink) (warmup := 1)
+    let reducedVerts ← sink.get
+    let kept := (← Polyline.reduce series).size / 2
+    report s!"time series x{count}" [
+      ("unreduced", s!"{fmt (fullNs / 1.0e6)} ms, {fullVerts} verts"),
+      ("min/max reduced", s!"{fmt (reducedNs / 1.0e6)} ms, {reducedVerts} verts, {kept} points kept"),
+      ("speedup", s!"{fmt (fullNs / reducedNs)}x")
+    ]
+  let curve := lissajous 10000000
+  let rdp := VertexWriterM.emitStrokePolyline curve style canvasW canvasH
+  let rdpNs ← timeNs 3 (stroke rdp writer sink) (warmup := 1)
+  let rdpVerts ← sink.get
+  let kept := (← Polyline.reduce curve).size / 2
+  report "lissajous x10000000" [
+    ("RDP reduced", s!"{fmt (rdpNs / 1.0e6)} ms, {rdpVerts} verts, {kept} points kept")
+  ]
+  writer.destroy
+
+def benchmark : Benchmark :=
+  { name := "polyline-reduction"
+    description := "Stroke time of 1M and 10M-point series with and without native decimation"
+    run := run }
+
+end Afferent.Bench.PolylineReductionBench
@@ -0,0 +1,127 @@
+/-
+  Primitive Instancing Benchmark
+  A frame of 100k mixed Canvas fills (solid rects, circles and ellipses, with
+  one star in 50 as a path that still needs triangles), encoded the way the
+  auto-batch does it:
+  - triangles: rects as quads, circles and ellipses through Path.circle /
+    Path.ellipse and the fill tessellator;
+  - instanced: rects, circles and ellipses as 48-byte shape instances, runs
+    broken only where a star needs triangles, as Canvas keeps painter's order.
+  Headless, so each draw is counted and its writer cleared instead of drawn.
+  Reports time per frame, bytes that would be uploaded, and draw calls.
+-/
+import Afferent.Render.VertexWriter
+import Afferent.Render.PolygonFill
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.PrimitiveInstancingBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+private inductive Prim where
+  | rect (rect : Rect) (color : Color)
+  | ellipse (center : Point) (rx ry : Float) (color : Color)
+  | star (center : Point) (color : Color)
+
+/-- Deterministic scatter in [0, 1). -/
+private def hash (i : Nat) : Float :=
+  let s := Float.sin (i.toFloat * 12.9898) * 43758.5453
+  s - s.floor
+
+private def scene (count : Nat) : Array Prim := Id.run do
+  let mut out : Array Prim := #[]
+  for i in [:count] do
+    let p : Point := ⟨hash (3 * i) * canvasW, hash (3 * i + 1) * canvasH⟩
+    let size := 2 + hash (3 * i + 2) * 10
+    let color := Color.hsv (hash i) 0.7 0.9
+    out := out.push <|
+      if i % 50 == 49 then .star p color
+      else match i % 3 with
+        | 0 => .rect (Rect.mk' p.x p.y size (size * 0.6)) color
+        | 1 => .ellipse p size size color
+        | _ => .ellipse p size (size * 0.5) color
+  out
+
+/-- Accumulated draws and upload bytes of one encoded frame. -/
+private structure FrameStats where
+  draws : Nat := 0
+  bytes : Nat := 0
+
+/-- Count a draw of `w`'s contents (float32 vertices plus indices) and clear it. -/
+private def drawAndClear (w : VertexWriter) (stats : IO.Ref FrameStats) : IO Unit := do
+  let s ← w.stats
+  if s.vertexCount == 0 then return
+  stats.modify fun f => { draws := f.draws + 1,
+    bytes := f.bytes + s.vertexCount * s.stride * 4 + s.indexCount * s.indexWidth }
+  w.clear
+
+private def starPath (center : Point) : Path := Path.star center 8 4 5
+
+private def trianglesFrame (prims : Array Prim) (tris : VertexWriter) (stats : IO.Ref FrameStats) :
+    IO Unit := do
+  for prim in prims do
+    match prim with
+    | .rect r color =>
+      (VertexWriterM.emitTransformedRect r Transform.identity (.solid color) canvasW canvasH).run tris
+    | .ellipse c rx ry color =>
+      let path := if rx == ry then Path.circle c rx else Path.ellipse c rx ry
+      let result ← Tessellation.tessellatePathNDC path color canvasW canvasH
+      (VertexWriterM.emitTessellation result).run tris
+    | .star c color =>
+      let result ← Tessellation.tessellatePathNDC (starPath c) color canvasW canvasH
+      (VertexWriterM.emitTessellation result).run tris
+  drawAndClear tris stats
+
+private def instancedFrame (prims : Array Prim) (tris shapes : VertexWriter)
+    (stats : IO.Ref FrameStats) : IO Unit := do
+  for prim in prims do
+    match prim with
+    | .rect r color =>
+      drawAndClear tris stats
+      (VertexWriterM.emitRectInstance r Transform.identity color canvasW canvasH).run shapes
+    | .ellipse c rx ry color =>
+      drawAndClear tris stats
+      (VertexWriterM.emitEllipseInstance c rx ry Transform.identity color canvasW canvasH).run shapes
+    | .star c color =>
+      drawAndClear shapes stats
+      let result ← Tessellation.tessellatePathNDC (starPath c) color canvasW canvasH
+      (VertexWriterM.emitTessellation result).run tris
+  drawAndClear tris stats
+  drawAndClear shapes stats
+
+def run : IO Unit := do
+  let tris ← VertexWriter.create
+  let shapes ← VertexWriter.create 12
+  let stats ← IO.mkRef ({} : FrameStats)
+  IO.println "Primitive instancing: Canvas fills as triangles vs shape instances"
+  for count in [10000, 100000] do
+    let prims := scene count
+    let iters := if count > 10000 then 5 else 20
+    let triNs ← timeNs iters (trianglesFrame prims tris stats) (warmup := 1)
+    let triStats ← stats.get
+    stats.set {}
+    let instNs ← timeNs iters (instancedFrame prims tris shapes stats) (warmup := 1)
+    let instStats ← stats.get
+    stats.set {}
+    let perFrame (f : FrameStats) (n : Nat) := (f.draws / n, f.bytes.toFloat / n.toFloat)
+    let (triDraws, triBytes) := perFrame triStats (iters + 1)
+    let (instDraws, instBytes) := perFrame instStats (iters + 1)
+    report s!"mixed x{count}" [
+      ("triangles", s!"{fmt (triNs / 1.0e6)} ms, {fmtBytes triBytes}, {triDraws} draws"),
+      ("instanced", s!"{fmt (instNs / 1.0e6)} ms, {fmtBytes instBytes}, {instDraws} draws"),
+      ("speedup", s!"{fmt (triNs / instNs)}x")
+    ]
+  tris.destroy
+  shapes.destroy
+
+def benchmark : Benchmark :=
+  { name := "primitive-instancing"
+    description := "100k mixed rects/circles/ellipses: tessellated triangles vs Canvas shape instances"
+    run := run }
+
+end Afferent.Bench.PrimitiveInstancingBench
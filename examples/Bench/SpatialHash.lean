@@ -0,0 +1,56 @@
+/-
+  SpatialHash Benchmark
+  Rebuild and query cost at 100k and 1M particles, plus the collision resolver.
+-/
+import Afferent.FFI.FloatBuffer
+import Afferent.FFI.Texture
+import Afferent.FFI.SpatialHash
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.SpatialHashBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+private def benchCount (count : Nat) : IO Unit := do
+  -- Keep density constant (~1 particle per 16 px²) so results compare across sizes
+  let side := count.toFloat.sqrt * 4.0
+  let radius := 2.0
+  let buf ← FloatBuffer.create (count * 5).toUSize
+  FloatBuffer.initSprites buf count.toUInt32 side side 42
+  let hash ← SpatialHash.create (radius * 2.0)
+  let iters := if count >= 1000000 then 5 else 20
+
+  let rebuildNs ← timeNs iters (hash.rebuild buf count.toUInt32 5)
+  let pairsRef ← IO.mkRef (0 : UInt64)
+  let pairsNs ← timeNs iters do
+    pairsRef.set (← hash.countPairs (radius * 2.0))
+  let queries := 10000
+  let queryNs ← timeNs iters do
+    for q in [0:queries] do
+      let t := q.toFloat / queries.toFloat
+      let _ ← hash.queryRadius (t * side) ((1.0 - t) * side) (radius * 2.0) 64
+  let contactsRef ← IO.mkRef (0 : UInt32)
+  let collideNs ← timeNs iters do
+    contactsRef.set (← hash.updateSpritesColliding buf count.toUInt32 (1.0 / 60.0) radius side side)
+
+  report s!"particles={count}" [
+    ("rebuild", s!"{fmt (rebuildNs / 1.0e6)} ms"),
+    ("pairs", s!"{fmt (pairsNs / 1.0e6)} ms ({← pairsRef.get})"),
+    ("radiusQuery", s!"{fmt (queryNs / queries.toFloat)} ns"),
+    ("step+collide", s!"{fmt (collideNs / 1.0e6)} ms ({← contactsRef.get} contacts)")
+  ]
+  hash.destroy
+  buf.destroy
+
+def run : IO Unit := do
+  IO.println "SpatialHash: rebuild + query"
+  for count in [100000, 1000000] do
+    benchCount count
+
+def benchmark : Benchmark :=
+  { name := "spatial_hash"
+    description := "grid rebuild, pair/radius queries and collision step at 100k and 1M particles"
+    run := run }
+
+end Afferent.Bench.SpatialHashBench
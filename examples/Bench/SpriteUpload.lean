@@ -0,0 +1,78 @@
+/-
+  Sprite Upload Benchmark
+  Per-frame CPU work for 1M sprites whose state lives in a Lean FloatArray,
+  headless:
+  - mirrored: the fused update writes sprite instances into a FloatBuffer,
+    which the draw then copies into the GPU buffer;
+  - in place: the update runs on the particle FloatArray itself and the draw
+    packs sprites from that array while copying into the GPU buffer.
+  The GPU buffer is stood in for by a second FloatBuffer; the in-place path
+  drops the intermediate write and read of 20 bytes per sprite. The demo
+  runner's sprite mode takes neither path: its FixedStepper keeps the state
+  native and writes instances straight into the buffer it draws from.
+-/
+import Afferent.Render.Dynamic
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.SpriteUploadBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Render.Dynamic
+open Afferent.Bench
+
+private def width : Float := 1920
+private def height : Float := 1080
+private def halfSize : Float := 15
+private def dt : Float := 1.0 / 60.0
+
+/-- Mean ns per frame over `frames` frames of the mirrored path. -/
+private def mirrored (count frames : Nat) (sprites staging : FloatBuffer) : IO Float := do
+  let mut p := ParticleState.create count width height 7
+  let n := (count * 5).toUSize
+  let start ← IO.monoNanosNow
+  for _ in [:frames] do
+    p ← p.updateBouncingAndWriteSprites dt halfSize sprites
+    FloatBuffer.copy staging 0 sprites 0 n
+  let stop ← IO.monoNanosNow
+  pure ((stop - start).toFloat / frames.toFloat)
+
+/-- Mean ns per frame over `frames` frames of the in-place path. -/
+private def inPlace (count frames : Nat) (staging : FloatBuffer) : IO Float := do
+  let mut p := ParticleState.create count width height 7
+  let start ← IO.monoNanosNow
+  for _ in [:frames] do
+    p ← p.updateBouncingInPlace dt halfSize
+    FloatBuffer.writeSpritesFromParticles staging p.data p.count.toUInt32 halfSize 0 1
+  let stop ← IO.monoNanosNow
+  pure ((stop - start).toFloat / frames.toFloat)
+
+def run : IO Unit := do
+  let count := 1000000
+  let frames := 30
+  let sprites ← FloatBuffer.create (count * 5).toUSize
+  let staging ← FloatBuffer.create (count * 5).toUSize
+  IO.println s!"Sprite upload: {count} sprites, {frames} frames"
+  -- Warm both paths once so page faults are not charged to either
+  discard <| mirrored count 2 sprites staging
+  discard <| inPlace count 2 staging
+  let mirroredNs ← mirrored count frames sprites staging
+  let mirroredOut ← staging.get 0
+  let inPlaceNs ← inPlace count frames staging
+  let inPlaceOut ← staging.get 0
+  report "per frame" [
+    ("mirrored", s!"{fmt (mirroredNs / 1.0e6)} ms"),
+    ("in place", s!"{fmt (inPlaceNs / 1.0e6)} ms"),
+    ("speedup", s!"{fmt (mirroredNs / inPlaceNs)}x"),
+    ("intermediate bytes dropped", fmtBytes (count * 5 * 4 * 2).toFloat),
+    ("results match", toString (mirroredOut == inPlaceOut))
+  ]
+  sprites.destroy
+  staging.destroy
+
+def benchmark : Benchmark :=
+  { name := "sprite-upload"
+    description := "1M sprites: FloatBuffer mirror + copy vs in-place FloatArray packed during upload"
+    run := run }
+
+end Afferent.Bench.SpriteUploadBench
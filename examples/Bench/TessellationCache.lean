@@ -0,0 +1,105 @@
+/-
+  Tessellation Cache Benchmark
+  Frame encode time for the Widgets demo content (background, colored boxes,
+  rounded cards, grid cells and debug borders), as `encodeCommands` does it:
+  rounded fills and borders tessellated every frame, against the same frame
+  with the tessellation cache on, where each shape after the first frame is a
+  lookup and an affine map. Tiled copies stand in for busier UIs.
+-/
+import Afferent.Canvas.TessellationCache
+import Afferent.Render.CommandStream
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.TessellationCacheBench
+
+open Afferent
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+private inductive Op where
+  | fill (rect : Rect) (radius : Float) (color : Color)
+  | border (rect : Rect) (color : Color)
+
+/-- The Widgets demo at 2x scale, centered with debug borders, tiled `copies` times. -/
+private def widgetsFrame (copies : Nat) : Array Op := Id.run do
+  let mut ops := #[]
+  let border := Color.rgba 0.5 1.0 0.5 0.5
+  for i in [:copies] do
+    let ox := (i % 4).toFloat * 8
+    let oy := (i / 4).toFloat * 8
+    let cell (x y w h : Float) : Rect := Rect.mk' (ox + x) (oy + y) w h
+    ops := ops.push (.fill (cell 0 0 1000 760) 0 (Color.gray 0.15))
+    for k in [:5] do
+      let r := cell (60 + k.toFloat * 184) 120 160 160
+      ops := ops.push (.fill r 0 (Color.hsv (k.toFloat / 5) 0.7 0.9))
+      ops := ops.push (.border r border)
+    for k in [:3] do
+      let card := cell (60 + k.toFloat * 300) 300 280 140
+      ops := ops.push (.fill card 24 (Color.hsv (k.toFloat / 3) 0.6 0.3))
+      ops := ops.push (.border card border)
+      let inner := cell (100 + k.toFloat * 300) 360 120 80
+      ops := ops.push (.fill inner 0 (Color.hsv (k.toFloat / 3) 0.5 0.7))
+      ops := ops.push (.border inner border)
+    for k in [:6] do
+      let r := cell (60 + (k % 3).toFloat * 300) (460 + (k / 3).toFloat * 116) 284 100
+      ops := ops.push (.fill r 0 (Color.hsv (k.toFloat / 10) 0.6 0.8))
+      ops := ops.push (.border r border)
+  ops
+
+/-- Encode one frame; with a cache, fills and borders go through it. -/
+private def encodeFrame (ops : Array Op) (cache : Option (IO.Ref TessellationCache))
+    (translate : Float) : IO CommandStream := do
+  let mut stream := CommandStream.withCapacity (ops.size * 128)
+  let state := { CanvasState.default with transform := Transform.translate translate translate }
+  for op in ops do
+    match op with
+    | .fill r radius color =>
+      if radius > 0 then
+        let path := Path.roundedRect r radius
+        let result ← match cache with
+          | some cache => TessellationCache.fillPath cache path state (.solid color) canvasW canvasH
+          | none => Tessellation.tessellatePathFillNDC path (state.transformPath path) state.transform
+              (.solid color) canvasW canvasH
+        stream := stream.triangles result
+      else
+        stream := stream.fillRect r state.transform (.solid color) canvasW canvasH
+    | .border r color =>
+      let path := Path.rectangle r
+      let style := { StrokeStyle.default with color, lineWidth := 1 }
+      let result ← match cache with
+        | some cache => TessellationCache.strokePath cache path state style canvasW canvasH
+        | none => pure (Tessellation.tessellateStrokeNDC (state.transformPath path) style canvasW canvasH)
+      stream := stream.triangles result
+  pure stream
+
+def run : IO Unit := do
+  let sink ← IO.mkRef 0
+  for copies in [1, 10, 40] do
+    let ops := widgetsFrame copies
+    let offNs ← timeNs 100 do
+      sink.set (← encodeFrame ops none 140).finish.size
+    let cache ← IO.mkRef TessellationCache.empty
+    -- Scrolling every frame: translations still hit
+    let frame ← IO.mkRef 0.0
+    let onNs ← timeNs 100 do
+      frame.modify (· + 1)
+      sink.set (← encodeFrame ops (some cache) (140 + (← frame.get))).finish.size
+    let stats := (← cache.get).stats
+    let lookups := stats.hits + stats.misses
+    report s!"widgets demo x{copies}" [
+      ("shapes", toString ops.size),
+      ("cache off", s!"{fmt (offNs / 1000.0)} us/frame"),
+      ("cache on", s!"{fmt (onNs / 1000.0)} us/frame"),
+      ("speedup", s!"{fmt (offNs / onNs)}x"),
+      ("hit rate", s!"{fmt (stats.hits.toFloat / lookups.toFloat * 100)}%"),
+      ("cached", s!"{stats.entries} entries, {fmtBytes stats.bytes.toFloat}")
+    ]
+
+def benchmark : Benchmark :=
+  { name := "tessellation-cache"
+    description := "Widgets demo frame encode time with the tessellation cache off and on"
+    run := run }
+
+end Afferent.Bench.TessellationCacheBench
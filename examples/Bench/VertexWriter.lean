@@ -0,0 +1,103 @@
+/-
+  Vertex Writer Benchmark
+  Per-frame geometry building, Lean arrays vs the native VertexWriter:
+  - rects: 10k rotated quads via Batch.addRectDirect vs emitRectDirect;
+  - shapes: tessellated paths appended via Batch.add vs emitTessellation;
+  - circles: 100k dynamic circle records via buildCircleData vs writeCircleData.
+  The array paths include the float32 narrowing their upload performs; the
+  writer already holds float32 and is cleared, not reallocated, per frame.
+  Reports time and Lean allocations (runtime heartbeats) per frame.
+-/
+import Afferent.Render.VertexWriter
+import Afferent.Render.Dynamic
+import Afferent.FFI.FrameArena
+import Examples.Bench.Harness
+
+namespace Afferent.Bench.VertexWriterBench
+
+open Afferent
+open Afferent.FFI
+open Afferent.Render.Dynamic
+open Afferent.Bench
+
+private def canvasW : Float := 1280
+private def canvasH : Float := 800
+
+private def compare (title : String) (iters : Nat) (arrays writer : IO Unit)
+    (w : VertexWriter) : IO Unit := do
+  let arraysNs ← timeNs iters arrays
+  let writerNs ← timeNs iters writer
+  let arraysAllocs ← allocsPerIter iters arrays
+  let writerAllocs ← allocsPerIter iters writer
+  let s ← w.stats
+  report title [
+    ("arrays", s!"{fmt (arraysNs / 1000.0)} us"),
+    ("writer", s!"{fmt (writerNs / 1000.0)} us"),
+    ("speedup", s!"{fmt (arraysNs / writerNs)}x"),
+    ("allocs arrays", fmt arraysAllocs 0),
+    ("allocs writer", fmt writerAllocs 0),
+    ("writer grows", toString s.grows),
+    ("writer bytes", fmtBytes s.bytesReserved.toFloat)
+  ]
+
+private def rects (arena : FrameArena) (sink : IO.Ref Float) : IO Unit := do
+  let count := 10000
+  let w ← VertexWriter.create
+  let arrays : IO Unit := do
+    let mut batch := Batch.withCapacity count
+    for i in [:count] do
+      batch := batch.addRectDirect (i % 128).toFloat (i / 128).toFloat (i.toFloat * 0.01) 4 Color.red canvasW canvasH
+    sink.set (← arena.narrowScratch batch.vertices)
+  let writer : IO Unit := do
+    w.clear
+    VertexWriterM.run (do
+      for i in [:count] do
+        VertexWriterM.emitRectDirect (i % 128).toFloat (i / 128).toFloat (i.toFloat * 0.01) 4 Color.red canvasW canvasH) w
+  compare s!"rects x{count}" 50 arrays writer w
+  w.destroy
+
+private def shapes (arena : FrameArena) (sink : IO.Ref Float) : IO Unit := do
+  let results : Array TessellationResult := Id.run do
+    let mut out := #[]
+    for i in [:512] do
+      let dx := (i % 16).toFloat * 80
+      let dy := (i / 16).toFloat * 25
+      out := out.push (Tessellation.tessellateConvexPathNDC (Path.star ⟨dx + 40, dy + 12⟩ 12 6 5) Color.red canvasW canvasH)
+      out := out.push (Tessellation.tessellateConvexPathNDC (Path.roundedRect (Rect.mk' dx dy 76 22) 6) Color.blue canvasW canvasH)
+    out
+  let w ← VertexWriter.create
+  let arrays : IO Unit := do
+    let batch := results.foldl Batch.add (Batch.withCapacity results.size)
+    sink.set (← arena.narrowScratch batch.vertices)
+  let writer : IO Unit := do
+    w.clear
+    VertexWriterM.run (results.forM VertexWriterM.emitTessellation) w
+  compare s!"shapes x{results.size}" 50 arrays writer w
+  w.destroy
+
+private def circles (arena : FrameArena) (sink : IO.Ref Float) : IO Unit := do
+  let particles := ParticleState.create 100000 canvasW canvasH 11
+  let w ← VertexWriter.create 4
+  let arrays : IO Unit := do
+    sink.set (← arena.narrowScratch (buildCircleData particles 3))
+  let writer : IO Unit := do
+    w.clear
+    (writeCircleData particles 3).run w
+  compare s!"circles x{particles.count}" 20 arrays writer w
+  w.destroy
+
+def run : IO Unit := do
+  let arena ← FrameArena.create
+  let sink ← IO.mkRef 0.0
+  IO.println "Vertex writer: per-frame build, Lean arrays vs native writer"
+  rects arena sink
+  shapes arena sink
+  circles arena sink
+  arena.destroy
+
+def benchmark : Benchmark :=
+  { name := "vertex-writer"
+    description := "Geometry building: FloatArray/ByteArray batches vs native VertexWriter emits"
+    run := run }
+
+end Afferent.Bench.VertexWriterBench
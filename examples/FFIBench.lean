@@ -0,0 +1,172 @@
+/-
+  Afferent FFI Overhead Benchmark
+  Per-binding cost of crossing into native code: argument marshalling,
+  external-object lookup and IO result allocation. Bindings run in a tight
+  loop against a headless window/renderer, whose draw calls return right
+  after argument handling, so what is measured is the FFI layer itself.
+
+  Reports ns/call and Lean small allocations/call (runtime heartbeats) as
+  JSON, net of an empty-loop baseline, for tracking across releases.
+
+  Usage: afferent_ffi_bench [--iters N] [--font PATH] [--out FILE]
+-/
+import Afferent.FFI
+import Examples.Bench.Harness
+
+namespace Afferent.FFIBench
+
+open Afferent.FFI
+open Afferent.Bench
+
+structure Result where
+  group : String
+  name : String
+  iters : Nat
+  nsPerCall : Float
+  allocsPerCall : Float
+
+/-- Time `iters` calls of `action`, returning raw (ns, allocations) per call. -/
+private def sample (iters : Nat) (action : IO Unit) : IO (Float × Float) := do
+  for _ in [:iters / 10 + 1] do action
+  let h0 ← IO.getNumHeartbeats
+  let t0 ← IO.monoNanosNow
+  for _ in [:iters] do action
+  let t1 ← IO.monoNanosNow
+  let h1 ← IO.getNumHeartbeats
+  let n := (iters.max 1).toFloat
+  pure ((t1 - t0).toFloat / n, (h1 - h0).toFloat / n)
+
+/-- Collects results, subtracting the cost of the loop itself. -/
+private structure Runner where
+  iters : Nat
+  baseline : Float × Float
+  results : IO.Ref (Array Result)
+
+private def Runner.run (r : Runner) (group name : String) (action : IO Unit)
+    (iters : Nat := r.iters) : IO Unit := do
+  let (ns, allocs) ← sample iters action
+  let ns := max 0 (ns - r.baseline.1)
+  let allocs := max 0 (allocs - r.baseline.2)
+  r.results.modify (·.push { group, name, iters, nsPerCall := ns, allocsPerCall := allocs })
+  IO.eprintln s!"  {group}.{name}: {fmt ns} ns, {fmt allocs} allocs"
+
+private def jsonEscape (s : String) : String :=
+  s.foldl (init := "") fun acc c =>
+    match c with
+    | '"' => acc ++ "\\\""
+    | '\\' => acc ++ "\\\\"
+    | _ => acc.push c
+
+private def toJson (baseline : Float × Float) (results : Array Result) : String :=
+  let rows := results.toList.map fun r =>
+    s!"    \{\"group\": \"{jsonEscape r.group}\", \"name\": \"{jsonEscape r.name}\", " ++
+    s!"\"iters\": {r.iters}, \"ns_per_call\": {fmt r.nsPerCall 3}, \"allocs_per_call\": {fmt r.allocsPerCall 3}}"
+  "{\n" ++
+  "  \"schema\": 1,\n" ++
+  s!"  \"baseline\": \{\"ns_per_call\": {fmt baseline.1 3}, \"allocs_per_call\": {fmt baseline.2 3}},\n" ++
+  "  \"results\": [\n" ++ ",\n".intercalate rows ++ "\n  ]\n}\n"
+
+/-- 8-float instance records for `count` instanced shapes. -/
+private def instanceData (count : Nat) : FloatArray := Id.run do
+  let mut out := FloatArray.emptyWithCapacity (count * 8)
+  for i in [:count] do
+    out := out.push i.toFloat |>.push 10 |>.push 0 |>.push 4
+      |>.push 1 |>.push 0.5 |>.push 0.25 |>.push 1
+  out
+
+private def floatBufferBench (r : Runner) : IO Unit := do
+  let buf ← FloatBuffer.create 1024
+  r.run "float_buffer" "set" (buf.set 7 1.5)
+  r.run "float_buffer" "get" (discard <| buf.get 7)
+  r.run "float_buffer" "set_vec8" (buf.setVec8 8 1 2 3 4 5 6 7 8)
+  r.run "float_buffer" "set_vec5" (buf.setVec5 8 1 2 3 4 5)
+  buf.destroy
+
+private def textBench (r : Runner) (fontPath : String) : IO Unit := do
+  try
+    let font ← Font.load fontPath 16
+    r.run "text" "measure_short" (discard <| Text.measure font "Hello")
+    r.run "text" "measure_long" (discard <| Text.measure font
+      "The quick brown fox jumps over the lazy dog, twice over for good measure.")
+    r.run "text" "get_metrics" (discard <| font.getMetrics)
+    font.destroy
+  catch e =>
+    IO.eprintln s!"  text: skipped ({e})"
+
+private def bufferBench (r : Runner) (renderer : Renderer) : IO Unit := do
+  let quadF : FloatArray := ⟨#[-1, -1, 1, 0, 0, 1, 1, -1, 0, 1, 0, 1, 1, 1, 0, 0, 1, 1]⟩
+  let quadA : Array Float := quadF.data
+  let idxA : Array UInt32 := #[0, 1, 2]
+  let idx16 : ByteArray := ⟨#[0, 0, 1, 0, 2, 0]⟩
+  -- beginFrame recycles pooled buffers; on a headless renderer it draws nothing
+  r.run "renderer" "begin_frame" (discard <| renderer.beginFrame 0 0 0 1)
+  r.run "buffer" "create_destroy_vertex_array" do
+    (← Buffer.createVertex renderer quadA).destroy
+    discard <| renderer.beginFrame 0 0 0 1
+  r.run "buffer" "create_destroy_vertex_float_array" do
+    (← Buffer.createVertexFloatArray renderer quadF).destroy
+    discard <| renderer.beginFrame 0 0 0 1
+  r.run "buffer" "create_destroy_index_array" do
+    (← Buffer.createIndex renderer idxA).destroy
+    discard <| renderer.beginFrame 0 0 0 1
+  r.run "buffer" "create_destroy_index_u16_bytes" do
+    (← Buffer.createIndexU16ByteArray renderer idx16).destroy
+    discard <| renderer.beginFrame 0 0 0 1
+
+private def instancedBench (r : Runner) (renderer : Renderer) : IO Unit := do
+  for count in [1, 100, 10000] do
+    let data := instanceData count
+    let boxed := data.data
+    let buf ← FloatBuffer.create (count * 8).toUSize
+    for i in [:count * 8] do
+      buf.set i.toUSize data[i]!
+    let iters := if count ≥ 10000 then r.iters / 100 else r.iters
+    let n := count.toUInt32
+    r.run "instanced" s!"rects_array_{count}" (renderer.drawInstancedRects boxed n) iters
+    r.run "instanced" s!"rects_float_array_{count}" (renderer.drawInstancedRectsFloatArray data n) iters
+    r.run "instanced" s!"rects_buffer_{count}" (renderer.drawInstancedRectsBuffer buf n) iters
+    r.run "instanced" s!"circles_float_array_{count}" (renderer.drawInstancedCirclesFloatArray data n) iters
+    buf.destroy
+
+private def windowBench (r : Runner) (window : Window) : IO Unit := do
+  r.run "window" "poll_events" window.pollEvents
+  r.run "window" "should_close" (discard window.shouldClose)
+  r.run "window" "get_size" (discard window.getSize)
+  r.run "window" "get_mouse_pos" (discard window.getMousePos)
+  r.run "window" "get_mouse_buttons" (discard window.getMouseButtons)
+  r.run "window" "get_modifiers" (discard window.getModifiers)
+  r.run "window" "get_scroll_delta" (discard window.getScrollDelta)
+  r.run "window" "get_click" (discard window.getClick)
+  r.run "window" "has_key_pressed" (discard window.hasKeyPressed)
+  r.run "window" "is_key_down" (discard <| window.isKeyDown 13)
+
+private def argValue (args : List String) (flag : String) : Option String :=
+  match args.dropWhile (· != flag) with
+  | _ :: v :: _ => some v
+  | _ => none
+
+def run (args : List String) : IO UInt32 := do
+  let iters := (argValue args "--iters" >>= String.toNat?).getD 200000
+  let fontPath := (argValue args "--font").getD "/System/Library/Fonts/Monaco.ttf"
+  let window ← Window.createHeadless 1280 800
+  let renderer ← Renderer.create window
+  let baseline ← sample iters (pure ())
+  let r : Runner := { iters, baseline, results := (← IO.mkRef #[]) }
+  IO.eprintln s!"FFI overhead: {iters} iterations, loop baseline {fmt baseline.1} ns"
+  floatBufferBench r
+  textBench r fontPath
+  bufferBench r renderer
+  instancedBench r renderer
+  windowBench r window
+  renderer.destroy
+  window.destroy
+  let json := toJson baseline (← r.results.get)
+  match argValue args "--out" with
+  | some path => IO.FS.writeFile path json
+  | none => IO.print json
+  return 0
+
+end Afferent.FFIBench
+
+def main (args : List String) : IO UInt32 :=
+  Afferent.FFIBench.run args
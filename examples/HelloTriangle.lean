@@ -22,20 +22,20 @@ def main : IO Unit := do
 
   -- Define a triangle in NDC coordinates (-1 to 1)
   -- Each vertex: x, y, r, g, b, a
-  let vertices : Array Float := #[
+  let vertices : FloatArray := ⟨#[
     -- Top vertex (red)
      0.0,  0.5,   1.0, 0.0, 0.0, 1.0,
     -- Bottom left (green)
     -0.5, -0.5,   0.0, 1.0, 0.0, 1.0,
     -- Bottom right (blue)
      0.5, -0.5,   0.0, 0.0, 1.0, 1.0
-  ]
+  ]⟩
 
   let indices : Array UInt32 := #[0, 1, 2]
 
   -- Create GPU buffers
   IO.println "Creating buffers..."
-  let vertexBuffer ← Buffer.createVertex renderer vertices
+  let vertexBuffer ← Buffer.createVertexFloatArray renderer vertices
   let indexBuffer ← Buffer.createIndex renderer indices
 
   IO.println "Entering render loop... (close window to exit)"
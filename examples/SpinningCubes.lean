@@ -15,6 +15,10 @@ def main : IO Unit := do
   let window ← Window.create 800 600 "Spinning Cubes"
   let renderer ← Renderer.create window
 
+  -- Upload the cube once; every draw below reuses the same GPU buffers
+  let cube ← FFI.Mesh.create .lit Mesh.cubeVertexData Mesh.cubeIndices
+  let cubeIndexCount := Mesh.cubeIndices.size.toUInt32
+
   -- Track time
   let startTime ← IO.monoMsNow
 
@@ -62,9 +66,10 @@ def main : IO Unit := do
           let mvp := Matrix4.multiply proj viewModel
 
           -- Draw the cube
-          Renderer.drawMesh3D renderer
-            Mesh.cubeVertices
-            Mesh.cubeIndices
+          Renderer.drawMesh renderer
+            cube
+            0
+            cubeIndexCount
             mvp.toArray
             model.toArray
             lightDir
@@ -73,5 +78,6 @@ def main : IO Unit := do
       renderer.endFrame
 
   -- Cleanup
+  cube.destroy
   Renderer.destroy renderer
   Window.destroy window
@@ -62,6 +62,16 @@ lean_exe map_tile_fetch_test where
   root := `Examples.MapTileFetchTest
   moreLinkArgs := commonLinkArgs
 
+-- Headless benchmarks (native data paths, no window/GPU)
+lean_exe afferent_bench where
+  root := `Examples.Bench
+  moreLinkArgs := commonLinkArgs
+
+-- Per-binding FFI overhead (headless window/renderer, JSON output)
+lean_exe afferent_ffi_bench where
+  root := `Examples.FFIBench
+  moreLinkArgs := commonLinkArgs
+
 -- Test executable
 @[test_driver]
 lean_exe afferent_tests where
@@ -127,6 +137,140 @@ target float_buffer_o pkg : FilePath := do
     "-O2"
   ] #[] "cc"
 
+target packed_buffer_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "packed_buffer.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "packed_buffer.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target spatial_hash_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "spatial_hash.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "spatial_hash.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target particle_system_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "particle_system.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "particle_system.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+-- FMA contraction is disabled so fixed-step results are bit-identical across machines
+target fixed_stepper_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "fixed_stepper.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "fixed_stepper.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2",
+    "-ffp-contract=off"
+  ] #[] "cc"
+
+target particle_init_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "particle_init.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "particle_init.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target narrow_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "narrow.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "narrow.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target mesh_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "mesh.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "mesh.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target frame_arena_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "frame_arena.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "frame_arena.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target vertex_writer_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "vertex_writer.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "vertex_writer.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target path_tessellator_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "path_tessellator.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "path_tessellator.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2",
+    -- Match Lean's unfused Float arithmetic exactly
+    "-ffp-contract=off"
+  ] #[] "cc"
+
+target polygon_triangulator_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "polygon_triangulator.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "polygon_triangulator.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target polyline_reducer_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "polyline_reducer.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "polyline_reducer.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
+target command_stream_o pkg : FilePath := do
+  let oFile := pkg.buildDir / "native" / "command_stream.o"
+  let srcFile := pkg.dir / "native" / "src" / "common" / "command_stream.c"
+  let includeDir := pkg.dir / "native" / "include"
+  buildO oFile (← inputTextFile srcFile) #[
+    "-I", includeDir.toString,
+    "-fPIC",
+    "-O2"
+  ] #[] "cc"
+
 target texture_o pkg : FilePath := do
   let oFile := pkg.buildDir / "native" / "texture.o"
   let srcFile := pkg.dir / "native" / "src" / "texture.c"
@@ -146,5 +290,18 @@ extern_lib libafferent_native pkg := do
   let textO ← text_render_o.fetch
   let bridgeO ← lean_bridge_o.fetch
   let floatBufferO ← float_buffer_o.fetch
+  let packedBufferO ← packed_buffer_o.fetch
+  let spatialHashO ← spatial_hash_o.fetch
+  let particleSystemO ← particle_system_o.fetch
+  let fixedStepperO ← fixed_stepper_o.fetch
+  let particleInitO ← particle_init_o.fetch
+  let narrowO ← narrow_o.fetch
+  let meshO ← mesh_o.fetch
+  let frameArenaO ← frame_arena_o.fetch
+  let vertexWriterO ← vertex_writer_o.fetch
+  let pathTessellatorO ← path_tessellator_o.fetch
+  let polygonTriangulatorO ← polygon_triangulator_o.fetch
+  let polylineReducerO ← polyline_reducer_o.fetch
+  let commandStreamO ← command_stream_o.fetch
   let textureO ← texture_o.fetch
-  buildStaticLib (pkg.staticLibDir / name) #[windowO, metalO, textO, bridgeO, floatBufferO, textureO]
+  buildStaticLib (pkg.staticLibDir / name) #[windowO, metalO, textO, bridgeO, floatBufferO, packedBufferO, spatialHashO, particleSystemO, fixedStepperO, particleInitO, narrowO, meshO, frameArenaO, vertexWriterO, pathTessellatorO, polygonTriangulatorO, polylineReducerO, commandStreamO, textureO]
@@ -15,6 +15,13 @@ typedef struct AfferentRenderer* AfferentRendererRef;
 typedef struct AfferentBuffer* AfferentBufferRef;
 typedef struct AfferentFont* AfferentFontRef;
 typedef struct AfferentFloatBuffer* AfferentFloatBufferRef;
+typedef struct AfferentPackedBuffer* AfferentPackedBufferRef;
+typedef struct AfferentSpatialHash* AfferentSpatialHashRef;
+typedef struct AfferentParticleSystem* AfferentParticleSystemRef;
+typedef struct AfferentFixedStepper* AfferentFixedStepperRef;
+typedef struct AfferentMesh* AfferentMeshRef;
+typedef struct AfferentFrameArena* AfferentFrameArenaRef;
+typedef struct AfferentVertexWriter* AfferentVertexWriterRef;
 typedef struct AfferentTexture* AfferentTextureRef;
 
 // Result codes
@@ -35,6 +42,12 @@ typedef struct {
     float color[4];
 } AfferentVertex;
 
+// Element type of an index buffer
+typedef enum {
+    AFFERENT_INDEX_U16 = 0,
+    AFFERENT_INDEX_U32 = 1,
+} AfferentIndexFormat;
+
 // 3D Vertex structure (for 3D mesh rendering)
 typedef struct {
     float position[3];  // x, y, z
@@ -57,6 +70,15 @@ AfferentResult afferent_window_create(
     const char* title,
     AfferentWindowRef* out_window
 );
+// Headless window: a Metal device but no NSWindow or view. Input getters
+// read zeroed state, poll_events does nothing and a renderer created on it
+// never begins a frame, so draw calls return after argument handling.
+// Used to measure FFI overhead without a display.
+AfferentResult afferent_window_create_headless(
+    uint32_t width,
+    uint32_t height,
+    AfferentWindowRef* out_window
+);
 void afferent_window_destroy(AfferentWindowRef window);
 bool afferent_window_should_close(AfferentWindowRef window);
 void afferent_window_poll_events(AfferentWindowRef window);
@@ -105,6 +127,9 @@ void afferent_renderer_set_msaa_enabled(AfferentRendererRef renderer, bool enabl
 // Override drawable pixel scale (1.0 disables Retina). Pass <= 0 to restore native scale.
 void afferent_renderer_set_drawable_scale(AfferentRendererRef renderer, float scale);
 
+// Transient scratch arena owned by the renderer, reset by begin_frame
+AfferentFrameArenaRef afferent_renderer_frame_arena(AfferentRendererRef renderer);
+
 // Buffer management
 AfferentResult afferent_buffer_create_vertex(
     AfferentRendererRef renderer,
@@ -118,6 +143,14 @@ AfferentResult afferent_buffer_create_index(
     uint32_t index_count,
     AfferentBufferRef* out_buffer
 );
+// 16-bit indices: half the upload and GPU index bandwidth; any batch with at
+// most 65536 vertices fits. draw_triangles picks the index type per buffer.
+AfferentResult afferent_buffer_create_index_u16(
+    AfferentRendererRef renderer,
+    const uint16_t* indices,
+    uint32_t index_count,
+    AfferentBufferRef* out_buffer
+);
 void afferent_buffer_destroy(AfferentBufferRef buffer);
 
 // Drawing
@@ -153,6 +186,17 @@ void afferent_renderer_draw_instanced_circles(
     uint32_t instance_count
 );
 
+// Instanced Canvas shapes: rects and ellipses as affine images of the unit
+// square/disc, interleaved freely in one draw.
+// instance_data: array of 12 floats per instance:
+//   center.x, center.y, axisX.x, axisX.y, axisY.x, axisY.y (NDC),
+//   r, g, b, a, kind (0 = rect, 1 = ellipse), padding
+void afferent_renderer_draw_instanced_shapes(
+    AfferentRendererRef renderer,
+    const float* instance_data,
+    uint32_t instance_count
+);
+
 // Scissor rect for clipping (in pixel coordinates)
 void afferent_renderer_set_scissor(
     AfferentRendererRef renderer,
@@ -243,6 +287,609 @@ void afferent_float_buffer_init_sprites(AfferentFloatBufferRef buf, uint32_t cou
 void afferent_float_buffer_update_sprites(AfferentFloatBufferRef buf, uint32_t count,
     float dt, float halfSize, float screenWidth, float screenHeight);
 
+// Copy `count` floats between buffers (ranges must fit both capacities)
+void afferent_float_buffer_copy(AfferentFloatBufferRef dst, size_t dst_index,
+    AfferentFloatBufferRef src, size_t src_index, size_t count);
+
+// Particle state kept in the Lean FloatArray payload itself:
+// [x, y, vx, vy, hue] per particle (5 doubles). These read or update that
+// memory directly, so the state never needs a FloatBuffer mirror.
+void afferent_particles_update_bouncing(double* particles, uint32_t count,
+    double dt, double radius, double width, double height);
+// Write [x, y, rotation(=0), halfSize, alpha(=1)] per particle (draw_sprites layout)
+void afferent_particles_pack_sprites(const double* particles, uint32_t count,
+    float half_size, float* out);
+
+// ============================================================================
+// PackedBuffer - schema-driven packed instance data
+// Each field has its own encoding, so instances shrink from all-f32 layouts
+// (e.g. 32-byte InstanceData) to 12-16 bytes. Callers pack/unpack plain float
+// streams: one float per scalar field, four floats per unorm8x4 field.
+// ============================================================================
+
+#define AFFERENT_PACKED_MAX_FIELDS 16
+
+typedef enum {
+    AFFERENT_FIELD_F32 = 0,       // 1 float  -> 4 bytes
+    AFFERENT_FIELD_F16 = 1,       // 1 float  -> 2 bytes (IEEE half, round-to-nearest-even)
+    AFFERENT_FIELD_UNORM8X4 = 2,  // 4 floats -> 4 bytes (clamped to [0, 1], e.g. RGBA)
+    AFFERENT_FIELD_SNORM16 = 3,   // 1 float  -> 2 bytes (clamped to [-1, 1])
+} AfferentFieldEncoding;
+
+// Scalar half-float kernels
+uint16_t afferent_pack_f16(float value);
+float afferent_unpack_f16(uint16_t bits);
+
+// Fields are laid out in schema order; 4-byte fields are 4-byte aligned and
+// the stride is rounded up to a multiple of 4.
+AfferentResult afferent_packed_buffer_create(const uint8_t* encodings, uint32_t field_count,
+    size_t capacity, AfferentPackedBufferRef* out);
+void afferent_packed_buffer_destroy(AfferentPackedBufferRef buf);
+size_t afferent_packed_buffer_capacity(AfferentPackedBufferRef buf);
+uint32_t afferent_packed_buffer_stride(AfferentPackedBufferRef buf);
+uint32_t afferent_packed_buffer_floats_per_instance(AfferentPackedBufferRef buf);
+const uint8_t* afferent_packed_buffer_data(AfferentPackedBufferRef buf);
+
+// Pack `count` instances starting at instance `first`. Ranges are clamped to
+// capacity. Returns the number of bytes written.
+size_t afferent_packed_buffer_pack(AfferentPackedBufferRef buf, size_t first,
+    const float* src, size_t count);
+size_t afferent_packed_buffer_pack_f64(AfferentPackedBufferRef buf, size_t first,
+    const double* src, size_t count);
+size_t afferent_packed_buffer_pack_from_float_buffer(AfferentPackedBufferRef buf, size_t first,
+    AfferentFloatBufferRef src, size_t count);
+
+// Unpack `count` instances starting at instance `first`. Returns instances read.
+size_t afferent_packed_buffer_unpack(AfferentPackedBufferRef buf, size_t first,
+    float* dst, size_t count);
+size_t afferent_packed_buffer_unpack_f64(AfferentPackedBufferRef buf, size_t first,
+    double* dst, size_t count);
+
+// ============================================================================
+// SpatialHash - uniform-grid neighbor queries over particle float streams
+// Particles are read as [x, y, ...] with `stride` floats per particle.
+// Rebuild fits a grid to the particle bounds and counting-sorts by cell ID;
+// storage is reused across rebuilds.
+// ============================================================================
+
+AfferentResult afferent_spatial_hash_create(float cell_size, AfferentSpatialHashRef* out);
+void afferent_spatial_hash_destroy(AfferentSpatialHashRef h);
+// Effective cell size of the last rebuild (>= the requested size; grows when
+// the bounds would otherwise need more than ~2 cells per particle)
+float afferent_spatial_hash_cell_size(AfferentSpatialHashRef h);
+uint32_t afferent_spatial_hash_count(AfferentSpatialHashRef h);
+
+AfferentResult afferent_spatial_hash_rebuild(AfferentSpatialHashRef h, const float* data,
+    uint32_t count, uint32_t stride);
+
+// Particles within `radius` of (x, y). Writes up to max_results indices and
+// returns the total number found.
+uint32_t afferent_spatial_hash_query_radius(AfferentSpatialHashRef h, float x, float y,
+    float radius, uint32_t* out_indices, uint32_t max_results);
+
+// Unordered pairs (i < j) at most `radius` apart, written as [i, j] into
+// out_pairs (up to max_pairs pairs). Returns the total number of pairs.
+uint64_t afferent_spatial_hash_query_pairs(AfferentSpatialHashRef h, float radius,
+    uint32_t* out_pairs, uint64_t max_pairs);
+
+// Rebuild from `data` and resolve overlaps between equal-mass discs of
+// `radius` in place: positions are separated and approaching pairs exchange
+// normal velocity (restitution 1 = elastic). Layout: [x, y, vx, vy, ...],
+// stride >= 4. Returns the number of contacts resolved.
+uint32_t afferent_spatial_hash_resolve_collisions(AfferentSpatialHashRef h, float* data,
+    uint32_t count, uint32_t stride, float radius, float restitution);
+
+// ============================================================================
+// ParticleSystem - native emitters, lifetimes, forces and color-over-life
+// Dead particles are swap-removed so the live set is always [0, live_count);
+// each step writes that range densely in dynamic-circle or sprite layout.
+// ============================================================================
+
+typedef struct {
+    float x, y;                      // Emitter position (pixels)
+    float rate;                      // Particles per second (0 = bursts only)
+    float speed_min, speed_max;      // Initial speed (pixels/second)
+    float angle, spread;             // Emission direction and half-angle (radians)
+    float life_min, life_max;        // Lifetime (seconds)
+    float size_start, size_end;      // Radius / half size over life
+    float hue_start, hue_end;        // Hue (0-1) over life
+    float alpha_start, alpha_end;    // Sprite alpha over life
+    float spin;                      // Sprite rotation speed (radians/second)
+} AfferentEmitterDesc;
+
+typedef enum {
+    AFFERENT_PARTICLE_LAYOUT_CIRCLES = 0,  // [x, y, hueBase, radius] (draw_dynamic_circles)
+    AFFERENT_PARTICLE_LAYOUT_SPRITES = 1,  // [x, y, rotation, halfSize, alpha] (draw_sprites)
+} AfferentParticleLayout;
+
+typedef struct {
+    uint32_t live;
+    uint64_t total_spawned;
+    uint64_t total_died;
+    uint64_t total_dropped;          // Spawns rejected because the system was full
+} AfferentParticleStats;
+
+AfferentResult afferent_particle_system_create(uint32_t capacity, uint32_t seed,
+    AfferentParticleSystemRef* out);
+void afferent_particle_system_destroy(AfferentParticleSystemRef sys);
+void afferent_particle_system_clear(AfferentParticleSystemRef sys);
+uint32_t afferent_particle_system_live_count(AfferentParticleSystemRef sys);
+uint32_t afferent_particle_system_capacity(AfferentParticleSystemRef sys);
+void afferent_particle_system_get_stats(AfferentParticleSystemRef sys, AfferentParticleStats* out);
+
+// Emitters return their index, or -1 on failure
+int32_t afferent_particle_system_add_emitter(AfferentParticleSystemRef sys,
+    const AfferentEmitterDesc* desc);
+void afferent_particle_system_set_emitter_position(AfferentParticleSystemRef sys,
+    uint32_t emitter, float x, float y);
+void afferent_particle_system_set_emitter_rate(AfferentParticleSystemRef sys,
+    uint32_t emitter, float rate);
+void afferent_particle_system_set_emitter_active(AfferentParticleSystemRef sys,
+    uint32_t emitter, bool active);
+uint32_t afferent_particle_system_burst(AfferentParticleSystemRef sys, uint32_t emitter,
+    uint32_t count);
+
+// Forces: constant gravity, linear drag, and up to 8 point attractors
+// (inverse-square with softening; negative strength repels)
+void afferent_particle_system_set_gravity(AfferentParticleSystemRef sys, float gx, float gy);
+void afferent_particle_system_set_drag(AfferentParticleSystemRef sys, float drag);
+int32_t afferent_particle_system_add_attractor(AfferentParticleSystemRef sys,
+    float x, float y, float strength, float softening);
+void afferent_particle_system_set_attractor(AfferentParticleSystemRef sys,
+    uint32_t attractor, float x, float y, float strength);
+void afferent_particle_system_clear_attractors(AfferentParticleSystemRef sys);
+
+// Floats per particle for a layout (4 for circles, 5 for sprites)
+uint32_t afferent_particle_layout_floats(AfferentParticleLayout layout);
+
+// Emit, age, integrate and compact in one pass, writing live particles to
+// `out` (may be NULL). Returns the live count after the step.
+uint32_t afferent_particle_system_step(AfferentParticleSystemRef sys, float dt,
+    float* out, size_t out_capacity_floats, AfferentParticleLayout layout);
+
+// Write the current live range without stepping. Returns particles written.
+uint32_t afferent_particle_system_write(AfferentParticleSystemRef sys,
+    float* out, size_t out_capacity_floats, AfferentParticleLayout layout);
+
+// ============================================================================
+// FixedStepper - deterministic fixed-timestep bouncing particles
+// Frame time is consumed in whole fixed substeps; the instance buffer gets
+// positions interpolated between the previous and current step. Results
+// depend only on the step count, so seeded headless runs are reproducible.
+// State layout: [x, y, vx, vy, hue] per particle.
+// ============================================================================
+
+AfferentResult afferent_fixed_stepper_create(uint32_t count, float fixed_dt,
+    uint32_t max_substeps, AfferentFixedStepperRef* out);
+void afferent_fixed_stepper_destroy(AfferentFixedStepperRef s);
+void afferent_fixed_stepper_set_bounds(AfferentFixedStepperRef s, float width, float height,
+    float radius);
+uint32_t afferent_fixed_stepper_count(AfferentFixedStepperRef s);
+float afferent_fixed_stepper_alpha(AfferentFixedStepperRef s);
+uint64_t afferent_fixed_stepper_step_count(AfferentFixedStepperRef s);
+double afferent_fixed_stepper_dropped_time(AfferentFixedStepperRef s);
+
+// Seed positions in [0, width) x [0, height) and velocities in [-max_speed, max_speed)
+void afferent_fixed_stepper_init_random(AfferentFixedStepperRef s, float width, float height,
+    float max_speed, uint32_t seed);
+// Load `count` particles of 5 doubles each; returns the number loaded.
+// Both init calls reset the accumulator and step count.
+uint32_t afferent_fixed_stepper_load(AfferentFixedStepperRef s, const double* data,
+    size_t count);
+const float* afferent_fixed_stepper_state(AfferentFixedStepperRef s);
+
+// Add frame time, run the whole substeps it covers (at most max_substeps;
+// excess time is dropped) and write interpolated instances to `out` (may be
+// NULL) in circle or sprite layout. Returns the substeps taken.
+uint32_t afferent_fixed_stepper_advance(AfferentFixedStepperRef s, double frame_dt,
+    float* out, size_t out_capacity_floats, AfferentParticleLayout layout);
+// Write interpolated instances without stepping. Returns particles written.
+uint32_t afferent_fixed_stepper_write(AfferentFixedStepperRef s, float* out,
+    size_t out_capacity_floats, AfferentParticleLayout layout);
+
+// Headless: run exactly `steps` fixed steps, ignoring the accumulator
+void afferent_fixed_stepper_run(AfferentFixedStepperRef s, uint32_t steps);
+// FNV-1a hash of the current state bits, for cross-machine comparisons
+uint64_t afferent_fixed_stepper_checksum(AfferentFixedStepperRef s);
+
+// ============================================================================
+// ParticleInit - parallel particle initialization (counter-based RNG)
+// Each particle's values depend only on (seed, index) via Philox4x32-10, so
+// the output is identical for any thread count.
+// Output layout: [x, y, vx, vy, hue] per particle.
+// ============================================================================
+
+typedef enum {
+    AFFERENT_INIT_POSITION_RECT = 0,      // p = [x, y, width, height]
+    AFFERENT_INIT_POSITION_DISC = 1,      // p = [cx, cy, radius] (uniform over area)
+    AFFERENT_INIT_POSITION_GAUSSIAN = 2,  // p = [cx, cy, sigma]
+} AfferentInitPosition;
+
+typedef enum {
+    AFFERENT_INIT_VELOCITY_ZERO = 0,
+    AFFERENT_INIT_VELOCITY_BOX = 1,          // v = [maxSpeed]: each axis in [-max, max)
+    AFFERENT_INIT_VELOCITY_DIRECTIONAL = 2,  // v = [minSpeed, maxSpeed], random direction
+} AfferentInitVelocity;
+
+typedef enum {
+    AFFERENT_INIT_HUE_BY_INDEX = 0,   // index / count
+    AFFERENT_INIT_HUE_RANDOM = 1,     // h = [min, max]
+    AFFERENT_INIT_HUE_CONSTANT = 2,   // h = [hue]
+} AfferentInitHue;
+
+typedef struct {
+    AfferentInitPosition position;
+    float p[4];
+    AfferentInitVelocity velocity;
+    float v[2];
+    AfferentInitHue hue;
+    float h[2];
+} AfferentParticleInitDesc;
+
+// threads = 0 uses one thread per online CPU (small counts stay single-threaded)
+void afferent_particle_init_f32(const AfferentParticleInitDesc* desc, uint32_t count,
+    uint32_t seed, uint32_t threads, float* out);
+void afferent_particle_init_f64(const AfferentParticleInitDesc* desc, uint32_t count,
+    uint32_t seed, uint32_t threads, double* out);
+// Threads actually used for `count` particles when `requested` are asked for
+uint32_t afferent_particle_init_thread_count(uint32_t count, uint32_t requested);
+
+// Raw Philox4x32-10 block: 4 random words for a 128-bit counter and 64-bit key
+void afferent_philox4x32(uint32_t counter0, uint32_t counter1, uint32_t counter2,
+    uint32_t counter3, uint32_t key0, uint32_t key1, uint32_t out[4]);
+
+// ============================================================================
+// Narrow - f64 -> f32 conversion (SSE2/NEON with scalar tail)
+// Used by the FFI to turn Lean FloatArray data into GPU-ready float buffers.
+// ============================================================================
+
+void afferent_narrow_f64_to_f32(const double* src, float* dst, size_t count);
+
+// ============================================================================
+// Mesh - persistent 3D geometry (uploaded once, drawn by handle)
+// The CPU-side copy lives here; GPU backends create their buffers from it on
+// first draw and afterwards re-upload only the dirty ranges.
+// ============================================================================
+
+typedef enum {
+    AFFERENT_MESH_FORMAT_LIT = 0,       // pos[3], normal[3], color[4] (AfferentVertex3D)
+    AFFERENT_MESH_FORMAT_TEXTURED = 1,  // pos[3], normal[3], uv[2], color[4]
+} AfferentMeshFormat;
+
+typedef struct {
+    uint64_t vertex_updates;
+    uint64_t index_updates;
+    uint64_t cpu_bytes;
+    bool gpu_resident;
+} AfferentMeshStats;
+
+// Releases backend GPU buffers when the mesh is destroyed or they are replaced
+typedef void (*AfferentMeshGpuRelease)(void* gpu_vertices, void* gpu_indices);
+
+uint32_t afferent_mesh_format_floats(AfferentMeshFormat format);
+
+// Fails if any index is out of range for vertex_count
+AfferentResult afferent_mesh_create(AfferentMeshFormat format, const double* vertices,
+    uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, AfferentMeshRef* out);
+void afferent_mesh_destroy(AfferentMeshRef mesh);
+AfferentMeshFormat afferent_mesh_format(AfferentMeshRef mesh);
+uint32_t afferent_mesh_vertex_count(AfferentMeshRef mesh);
+uint32_t afferent_mesh_index_count(AfferentMeshRef mesh);
+const float* afferent_mesh_vertices(AfferentMeshRef mesh);
+const uint32_t* afferent_mesh_indices(AfferentMeshRef mesh);
+
+// Overwrite a sub-range in place (counts cannot change); false if out of range
+bool afferent_mesh_update_vertices(AfferentMeshRef mesh, uint32_t first_vertex,
+    const double* data, uint32_t vertex_count);
+bool afferent_mesh_update_indices(AfferentMeshRef mesh, uint32_t first_index,
+    const uint32_t* data, uint32_t index_count);
+
+// Merged range touched since the last upload; false when clean
+bool afferent_mesh_dirty_vertices(AfferentMeshRef mesh, uint32_t* first, uint32_t* count);
+bool afferent_mesh_dirty_indices(AfferentMeshRef mesh, uint32_t* first, uint32_t* count);
+void afferent_mesh_clear_dirty(AfferentMeshRef mesh);
+void afferent_mesh_get_stats(AfferentMeshRef mesh, AfferentMeshStats* out);
+
+// Clamp a submesh range to the index buffer; false if nothing is left to draw
+bool afferent_mesh_clamp_range(AfferentMeshRef mesh, uint32_t* index_offset, uint32_t* index_count);
+
+// Backend GPU buffer slots (opaque to the common code); setting them releases
+// the previous pair
+void* afferent_mesh_gpu_vertices(AfferentMeshRef mesh);
+void* afferent_mesh_gpu_indices(AfferentMeshRef mesh);
+void afferent_mesh_set_gpu_buffers(AfferentMeshRef mesh, void* vertices, void* indices,
+    AfferentMeshGpuRelease release);
+
+// ============================================================================
+// FrameArena - bump-pointer scratch memory for one frame
+// Allocations are 16-byte aligned and never freed individually: callers take
+// a mark, allocate, and rewind once the data has been consumed, and reset
+// drops everything at the start of the next frame. Reset folds overflow
+// blocks into a single block sized to the high-water mark, so a steady
+// workload stops calling malloc after its first frames. Not thread-safe.
+// ============================================================================
+
+typedef struct {
+    void* block;
+    size_t used;
+} AfferentFrameArenaMark;
+
+typedef struct {
+    uint64_t bytes_in_use;        // Live bytes in the current frame
+    uint64_t frame_peak_bytes;    // Peak live bytes of the last completed frame
+    uint64_t high_water_bytes;    // Peak live bytes over the arena's lifetime
+    uint64_t capacity_bytes;      // Bytes held in blocks (live + spare)
+    uint32_t block_count;
+    uint64_t frames;              // Resets so far
+    uint64_t system_allocs;       // Total mallocs made by the arena
+    uint64_t last_frame_allocs;   // Mallocs during the last completed frame
+} AfferentFrameArenaStats;
+
+// initial_bytes = 0 starts empty and allocates on first use
+AfferentResult afferent_frame_arena_create(size_t initial_bytes, AfferentFrameArenaRef* out);
+void afferent_frame_arena_destroy(AfferentFrameArenaRef arena);
+
+// NULL on out-of-memory; size 0 returns a valid unique pointer
+void* afferent_frame_arena_alloc(AfferentFrameArenaRef arena, size_t size);
+AfferentFrameArenaMark afferent_frame_arena_mark(AfferentFrameArenaRef arena);
+void afferent_frame_arena_rewind(AfferentFrameArenaRef arena, AfferentFrameArenaMark mark);
+void afferent_frame_arena_reset(AfferentFrameArenaRef arena);
+
+// Passthrough mode mallocs every allocation separately and frees it on
+// rewind/reset, i.e. the per-call malloc/free pattern the arena replaces.
+// Used to measure mallocs per frame with and without the arena.
+void afferent_frame_arena_set_passthrough(AfferentFrameArenaRef arena, bool passthrough);
+void afferent_frame_arena_get_stats(AfferentFrameArenaRef arena, AfferentFrameArenaStats* out);
+
+// ============================================================================
+// VertexWriter - growable float32 vertex and packed index storage
+// Lean builders emit vertices and triangles straight into native memory
+// instead of accumulating FloatArray/ByteArray batches, so geometry is
+// stored once, at upload precision, and handed to the GPU without a
+// conversion pass. Vertices are `stride` floats each (6 for AfferentVertex,
+// 4/5 for dynamic-shape records). Indices stay 16-bit until the writer
+// holds more than 65536 vertices, then are widened once to 32-bit.
+// Storage doubles on demand and is kept across clear. Not thread-safe.
+// ============================================================================
+
+typedef struct {
+    uint64_t vertex_count;
+    uint64_t index_count;
+    uint64_t vertex_capacity;     // Vertices that fit without growing
+    uint64_t index_capacity;      // Indices that fit without growing
+    uint64_t bytes_reserved;      // Vertex + index storage held
+    uint64_t grows;               // Reallocations since creation
+    uint32_t stride;              // Floats per vertex
+    AfferentIndexFormat index_format;
+} AfferentVertexWriterStats;
+
+// Capacities are hints (0 allocates on first use)
+AfferentResult afferent_vertex_writer_create(uint32_t stride, size_t vertex_capacity,
+    size_t index_capacity, AfferentVertexWriterRef* out);
+void afferent_vertex_writer_destroy(AfferentVertexWriterRef writer);
+
+// Drop all geometry, keeping capacity; indices go back to 16-bit
+void afferent_vertex_writer_clear(AfferentVertexWriterRef writer);
+
+// Start a shape: triangle indices are relative to the next vertex emitted
+void afferent_vertex_writer_begin_shape(AfferentVertexWriterRef writer);
+
+// Reserve `count` vertices and return where to write their stride*count
+// floats; NULL on out-of-memory
+float* afferent_vertex_writer_emit_vertices(AfferentVertexWriterRef writer, uint32_t count);
+
+// Append a triangle with shape-relative indices; false (nothing appended)
+// if an index does not refer to a vertex already emitted
+bool afferent_vertex_writer_emit_tri(AfferentVertexWriterRef writer, uint32_t a, uint32_t b, uint32_t c);
+
+// Append an AfferentVertex quad (stride 6): corners xy[8] in order, one
+// color, triangles (0,1,2) and (0,2,3). False on out-of-memory or stride.
+bool afferent_vertex_writer_emit_quad(AfferentVertexWriterRef writer, const float* corners, const float* color);
+
+// Make room for `vertices` more vertices and `indices` more indices
+// (widening first if needed), so a shape's emits never reallocate midway
+bool afferent_vertex_writer_reserve(AfferentVertexWriterRef writer, uint32_t vertices, uint32_t indices);
+
+uint32_t afferent_vertex_writer_vertex_count(AfferentVertexWriterRef writer);
+uint32_t afferent_vertex_writer_index_count(AfferentVertexWriterRef writer);
+uint32_t afferent_vertex_writer_stride(AfferentVertexWriterRef writer);
+AfferentIndexFormat afferent_vertex_writer_index_format(AfferentVertexWriterRef writer);
+const float* afferent_vertex_writer_vertices(AfferentVertexWriterRef writer);
+// uint16_t* or uint32_t* depending on the index format
+const void* afferent_vertex_writer_indices(AfferentVertexWriterRef writer);
+void afferent_vertex_writer_get_stats(AfferentVertexWriterRef writer, AfferentVertexWriterStats* out);
+
+// ============================================================================
+// Path tessellator - native flattening, convex fill and stroke expansion
+// Paths arrive as a float64 command stream (Lean Float, so no precision is
+// lost on the way in): each command is its opcode followed by its operands.
+//   MOVE_TO x y             LINE_TO x y
+//   QUAD_TO cx cy x y       CUBIC_TO c1x c1y c2x c2y x y
+//   ARC_TO x1 y1 x2 y2 r    ARC cx cy r start end ccw(0/1)
+//   RECT x y w h            CLOSE
+//   ELLIPSE_ARC cx cy ux uy vx vy start sweep
+// The transform is applied to the commands the way Canvas transformPath
+// does: points, arc and ellipse axes are transformed, rect sizes and arcTo
+// radii are not. Arcs are flattened straight to points on the transformed
+// ellipse, as many as its on-screen radius needs. Output
+// vertices are AfferentVertex-layout, appended to a stride-6 VertexWriter as
+// one shape, in NDC when ndc_width/height are > 0 (pixels otherwise). The
+// arithmetic mirrors Afferent.Tessellation step for step, so results equal
+// the Lean reference up to the float32 narrowing of the output.
+// ============================================================================
+
+typedef enum {
+    AFFERENT_PATH_MOVE_TO = 0,
+    AFFERENT_PATH_LINE_TO = 1,
+    AFFERENT_PATH_QUAD_TO = 2,
+    AFFERENT_PATH_CUBIC_TO = 3,
+    AFFERENT_PATH_ARC_TO = 4,
+    AFFERENT_PATH_ARC = 5,
+    AFFERENT_PATH_RECT = 6,
+    AFFERENT_PATH_CLOSE = 7,
+    AFFERENT_PATH_ELLIPSE_ARC = 8,
+} AfferentPathOp;
+
+typedef enum {
+    AFFERENT_LINE_CAP_BUTT = 0,
+    AFFERENT_LINE_CAP_ROUND = 1,
+    AFFERENT_LINE_CAP_SQUARE = 2,
+} AfferentLineCap;
+
+typedef enum {
+    AFFERENT_LINE_JOIN_MITER = 0,
+    AFFERENT_LINE_JOIN_ROUND = 1,
+    AFFERENT_LINE_JOIN_BEVEL = 2,
+} AfferentLineJoin;
+
+typedef struct {
+    const double* commands;     // Encoded path
+    size_t command_length;      // In doubles
+    const double* transform;    // a, b, c, d, tx, ty; NULL for identity
+    double tolerance;           // Max flattening error in pixels
+    double ndc_width;           // Canvas size for NDC output; 0 keeps pixels
+    double ndc_height;
+} AfferentPathInput;
+
+typedef struct {
+    float color[4];
+    double line_width;
+    double miter_limit;
+    AfferentLineCap cap;
+    AfferentLineJoin join;
+} AfferentStrokeParams;
+
+// Fan-triangulated fill of the flattened polygon (convex paths). Fewer than
+// three points appends nothing. False on a malformed stream or out-of-memory,
+// in which case nothing was appended.
+bool afferent_tessellate_fill_convex(const AfferentPathInput* path, const float* color,
+    AfferentVertexWriterRef out);
+
+// Stroke of the flattened polyline as a left/right triangle strip
+bool afferent_tessellate_stroke(const AfferentPathInput* path, const AfferentStrokeParams* stroke,
+    AfferentVertexWriterRef out);
+
+// ============================================================================
+// Polygon triangulator - fills of concave, holed and self-intersecting paths
+// Input is flattened contours as x, y pairs; contour_ends[i] is the point
+// index one past contour i, and every contour is implicitly closed. Contours
+// that neither cross nor touch, where each one separates filled from
+// unfilled area under the fill rule, are ear clipped with holes bridged in
+// (output points are the input points less duplicates). Anything else is
+// filled by a scanline sweep that emits trapezoids on new points. Triangles
+// cover exactly the area the fill rule selects.
+// ============================================================================
+
+typedef enum {
+    AFFERENT_FILL_RULE_NONZERO = 0,
+    AFFERENT_FILL_RULE_EVENODD = 1,
+} AfferentFillRule;
+
+typedef enum {
+    AFFERENT_TRIANGULATE_EMPTY = 0,      // No contour with three distinct points
+    AFFERENT_TRIANGULATE_EAR_CLIP = 1,
+    AFFERENT_TRIANGULATE_SWEEP = 2,
+} AfferentTriangulateMethod;
+
+typedef struct {
+    double* points;          // x, y pairs
+    uint32_t point_count;
+    uint32_t* indices;       // 3 per triangle
+    uint32_t index_count;
+    AfferentTriangulateMethod method;
+} AfferentTriangulation;
+
+// False on non-finite points, decreasing contour ends, a sweep that exceeds
+// its event budget or out-of-memory; the result then holds nothing. Otherwise free it with afferent_triangulation_free.
+bool afferent_triangulate(const double* points, const uint32_t* contour_ends,
+    uint32_t contour_count, AfferentFillRule rule, AfferentTriangulation* out);
+void afferent_triangulation_free(AfferentTriangulation* t);
+
+// ============================================================================
+// Polyline reducer - drop points of long polylines before stroking
+// Input is `count` points as x, y pairs, compared in pixel space under
+// `transform` (a, b, c, d, tx, ty; NULL for identity). The kept points are
+// written to `out` (room for `count` points) untransformed, in input order,
+// first and last always included. MINMAX keeps the first, lowest, highest
+// and last point of each run in a pixel column 2 * tolerance wide; RDP keeps
+// points more than `tolerance` pixels off the simplified line; AUTO picks
+// MINMAX when the pixel x is monotonic and RDP otherwise. Fewer than three
+// points, or a tolerance that is not positive, are copied as they are.
+// ============================================================================
+
+typedef enum {
+    AFFERENT_POLYLINE_REDUCE_AUTO = 0,
+    AFFERENT_POLYLINE_REDUCE_MINMAX = 1,
+    AFFERENT_POLYLINE_REDUCE_RDP = 2,
+} AfferentPolylineReduce;
+
+// False on non-finite points or out-of-memory, with nothing written
+bool afferent_polyline_reduce(const double* points, size_t count, const double* transform,
+    double tolerance, AfferentPolylineReduce method, double* out, size_t* out_count);
+
+// ============================================================================
+// Command stream - a whole frame of 2D draws in one buffer
+// Little-endian, every field 4 bytes (strings zero-padded to 4), so float
+// payloads can be handed to the backend in place. Layout:
+//   header:  u32 magic 'AFCS', u32 version
+//   command: u32 opcode, payload
+//     TRIANGLES  u32 vertexCount, u32 indexCount, AfferentVertex[vertexCount],
+//                u32 indices[indexCount]                (fills and strokes, NDC)
+//     TEXT       u32 font, f32 x, y, r, g, b, a, f32 transform[6],
+//                u32 byteLength, UTF-8 bytes (padded)
+//     PUSH_CLIP  f32 x, y, width, height (logical pixels, intersected with parent)
+//     POP_CLIP
+//     SPRITES    u32 texture, u32 count, f32 [x, y, rotation, halfSize, alpha][count]
+// Fonts and textures are indices into tables passed alongside the stream.
+// The whole stream is validated before anything is dispatched, so a
+// malformed frame draws nothing. Decoding never reads outside the buffer.
+// ============================================================================
+
+#define AFFERENT_COMMAND_STREAM_MAGIC 0x53434641u   // "AFCS"
+#define AFFERENT_COMMAND_STREAM_VERSION 1u
+#define AFFERENT_COMMAND_STREAM_MAX_CLIP_DEPTH 32u
+
+typedef enum {
+    AFFERENT_CMD_TRIANGLES = 1,
+    AFFERENT_CMD_TEXT = 2,
+    AFFERENT_CMD_PUSH_CLIP = 3,
+    AFFERENT_CMD_POP_CLIP = 4,
+    AFFERENT_CMD_SPRITES = 5,
+} AfferentCommandOp;
+
+// Backend callbacks; clips arrive already intersected, in logical pixels.
+// Pointers into the stream are only valid for the duration of the call.
+typedef struct {
+    void (*triangles)(void* ctx, const AfferentVertex* vertices, uint32_t vertex_count,
+        const uint32_t* indices, uint32_t index_count);
+    void (*text)(void* ctx, uint32_t font, const char* utf8, uint32_t length,
+        float x, float y, const float* color, const float* transform);
+    void (*set_clip)(void* ctx, float x, float y, float width, float height);
+    void (*reset_clip)(void* ctx);
+    void (*sprites)(void* ctx, uint32_t texture, const float* data, uint32_t count);
+} AfferentCommandSink;
+
+typedef struct {
+    uint32_t commands;        // Commands dispatched (or validated)
+    uint32_t draws;           // TRIANGLES + TEXT + SPRITES commands
+    size_t error_offset;      // Byte offset of the first bad command
+    const char* error;        // Static description; NULL on success
+} AfferentCommandStreamInfo;
+
+// Validate the stream and, if sink is non-NULL, dispatch it. Unbalanced
+// PUSH_CLIPs are closed with reset_clip at the end. Returns false (and sets
+// info->error) on a malformed stream, in which case nothing was dispatched.
+// `data` must be 4-byte aligned.
+bool afferent_command_stream_execute(const uint8_t* data, size_t size,
+    uint32_t font_count, uint32_t texture_count,
+    const AfferentCommandSink* sink, void* ctx, AfferentCommandStreamInfo* info);
+
+// Decode into a human-readable log, one line per sink call (tests/debugging).
+// Returns a malloc'd NUL-terminated string (caller frees), or NULL with
+// info->error set.
+char* afferent_command_stream_record(const uint8_t* data, size_t size,
+    uint32_t font_count, uint32_t texture_count, AfferentCommandStreamInfo* info);
+
 // ============================================================================
 // Animated rendering - GPU-side animation for maximum performance
 // Static data uploaded once, only time uniform sent per frame
@@ -396,6 +1043,19 @@ void afferent_renderer_draw_sprites_instance_buffer(
     float canvasHeight
 );
 
+// Draw sprites straight from particle state ([x, y, vx, vy, hue] doubles),
+// packing into the GPU instance buffer during the upload copy. `particles`
+// is only read during the call.
+void afferent_renderer_draw_sprites_particles(
+    AfferentRendererRef renderer,
+    AfferentTextureRef texture,
+    const double* particles,
+    uint32_t count,
+    float half_size,
+    float canvas_width,
+    float canvas_height
+);
+
 // Draw sprites from FloatBuffer (zero-copy path for 1M+ sprites)
 // Buffer layout: [x, y, vx, vy, rotation] per sprite (physics layout)
 void afferent_renderer_draw_sprites_buffer(
@@ -516,6 +1176,49 @@ void afferent_renderer_draw_mesh_3d_textured(
     AfferentTextureRef texture
 );
 
+// ============================================================================
+// Persistent Mesh rendering
+// ============================================================================
+
+// Draw indices [index_offset, index_offset + index_count) of a Mesh handle.
+// Lit meshes ignore `texture`; textured meshes require it. Pass NULL
+// camera_pos/fog_color to disable fog.
+void afferent_renderer_draw_mesh(
+    AfferentRendererRef renderer,
+    AfferentMeshRef mesh,
+    uint32_t index_offset,
+    uint32_t index_count,
+    const float* mvp_matrix,
+    const float* model_matrix,
+    const float* light_dir,
+    float ambient,
+    const float* camera_pos,
+    const float* fog_color,
+    float fog_start,
+    float fog_end,
+    AfferentTextureRef texture
+);
+
+// ============================================================================
+// Command stream execution
+// ============================================================================
+
+// Execute a command stream (see "Command stream" above) in one call. NDC
+// conversion of text and sprites uses canvas_width/height; clips are scaled
+// from logical to drawable pixels. Returns false on a malformed stream.
+bool afferent_renderer_execute_commands(
+    AfferentRendererRef renderer,
+    const uint8_t* data,
+    size_t size,
+    const AfferentFontRef* fonts,
+    uint32_t font_count,
+    const AfferentTextureRef* textures,
+    uint32_t texture_count,
+    float canvas_width,
+    float canvas_height,
+    AfferentCommandStreamInfo* info
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,251 @@
+/*
+ * CommandStream - Decoder for packed 2D frame command streams
+ *
+ * Lean encodes a frame's fills, strokes, text, clips and sprites into one
+ * ByteArray (format in afferent.h), and the renderer executes it in a single
+ * FFI call instead of a create/draw/destroy round trip per shape. Decoding is
+ * backend-independent: commands are dispatched to a sink of callbacks, which
+ * the Metal renderer implements for drawing and the recording sink below
+ * implements for tests. The stream is untrusted input - every length, count
+ * and index is checked before use, and the whole stream is validated before
+ * the first callback so a bad frame is rejected atomically.
+ */
+
+#include "afferent.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+} Reader;
+
+static inline bool read_u32(Reader* r, uint32_t* out) {
+    if (r->size - r->pos < 4) return false;
+    memcpy(out, r->data + r->pos, 4);
+    r->pos += 4;
+    return true;
+}
+
+static inline bool read_f32(Reader* r, float* out) {
+    if (r->size - r->pos < 4) return false;
+    memcpy(out, r->data + r->pos, 4);
+    r->pos += 4;
+    return true;
+}
+
+// Borrow `bytes` from the stream in place; the caller guarantees alignment
+static inline const void* take(Reader* r, uint64_t bytes) {
+    if ((uint64_t)(r->size - r->pos) < bytes) return NULL;
+    const void* p = r->data + r->pos;
+    r->pos += (size_t)bytes;
+    return p;
+}
+
+typedef struct {
+    float x, y, width, height;
+} ClipRect;
+
+static ClipRect clip_intersect(ClipRect a, ClipRect b) {
+    float x0 = a.x > b.x ? a.x : b.x;
+    float y0 = a.y > b.y ? a.y : b.y;
+    float x1 = (a.x + a.width) < (b.x + b.width) ? (a.x + a.width) : (b.x + b.width);
+    float y1 = (a.y + a.height) < (b.y + b.height) ? (a.y + a.height) : (b.y + b.height);
+    ClipRect out = { x0, y0, x1 > x0 ? x1 - x0 : 0.0f, y1 > y0 ? y1 - y0 : 0.0f };
+    return out;
+}
+
+// One pass over the stream. With sink == NULL it only validates.
+static bool decode(const uint8_t* data, size_t size, uint32_t font_count, uint32_t texture_count,
+    const AfferentCommandSink* sink, void* ctx, AfferentCommandStreamInfo* info) {
+    Reader r = { data, size, 0 };
+    ClipRect clips[AFFERENT_COMMAND_STREAM_MAX_CLIP_DEPTH];
+    uint32_t depth = 0;
+    size_t start = 0;
+
+#define FAIL(msg) do { info->error = (msg); info->error_offset = start; return false; } while (0)
+
+    uint32_t magic = 0, version = 0;
+    if (((uintptr_t)data & 3) != 0) FAIL("stream is not 4-byte aligned");
+    if (!read_u32(&r, &magic) || magic != AFFERENT_COMMAND_STREAM_MAGIC) FAIL("bad magic");
+    if (!read_u32(&r, &version) || version != AFFERENT_COMMAND_STREAM_VERSION) FAIL("unsupported version");
+
+    while (r.pos < r.size) {
+        start = r.pos;
+        uint32_t op = 0;
+        if (!read_u32(&r, &op)) FAIL("truncated opcode");
+
+        switch (op) {
+        case AFFERENT_CMD_TRIANGLES: {
+            uint32_t vertex_count = 0, index_count = 0;
+            if (!read_u32(&r, &vertex_count) || !read_u32(&r, &index_count)) FAIL("truncated triangles header");
+            const AfferentVertex* vertices = take(&r, (uint64_t)vertex_count * sizeof(AfferentVertex));
+            const uint32_t* indices = take(&r, (uint64_t)index_count * sizeof(uint32_t));
+            if (!vertices || !indices) FAIL("truncated triangles payload");
+            if (index_count % 3 != 0) FAIL("index count is not a multiple of 3");
+            if (!sink) {
+                for (uint32_t i = 0; i < index_count; i++) {
+                    if (indices[i] >= vertex_count) FAIL("index out of range");
+                }
+            } else if (index_count > 0) {
+                sink->triangles(ctx, vertices, vertex_count, indices, index_count);
+            }
+            info->draws++;
+            break;
+        }
+        case AFFERENT_CMD_TEXT: {
+            uint32_t font = 0, length = 0;
+            float pos[2];
+            if (!read_u32(&r, &font) || !read_f32(&r, &pos[0]) || !read_f32(&r, &pos[1])) FAIL("truncated text header");
+            const float* color = take(&r, 4 * sizeof(float));
+            const float* transform = take(&r, 6 * sizeof(float));
+            if (!color || !transform || !read_u32(&r, &length)) FAIL("truncated text header");
+            const char* utf8 = take(&r, ((uint64_t)length + 3) & ~(uint64_t)3);
+            if (!utf8) FAIL("truncated text payload");
+            if (font >= font_count) FAIL("font index out of range");
+            if (sink) sink->text(ctx, font, utf8, length, pos[0], pos[1], color, transform);
+            info->draws++;
+            break;
+        }
+        case AFFERENT_CMD_PUSH_CLIP: {
+            ClipRect rect;
+            if (!read_f32(&r, &rect.x) || !read_f32(&r, &rect.y) ||
+                !read_f32(&r, &rect.width) || !read_f32(&r, &rect.height)) FAIL("truncated clip");
+            if (depth == AFFERENT_COMMAND_STREAM_MAX_CLIP_DEPTH) FAIL("clip stack overflow");
+            if (depth > 0) rect = clip_intersect(clips[depth - 1], rect);
+            clips[depth++] = rect;
+            if (sink) sink->set_clip(ctx, rect.x, rect.y, rect.width, rect.height);
+            break;
+        }
+        case AFFERENT_CMD_POP_CLIP:
+            if (depth == 0) FAIL("clip stack underflow");
+            depth--;
+            if (sink) {
+                if (depth > 0) {
+                    ClipRect top = clips[depth - 1];
+                    sink->set_clip(ctx, top.x, top.y, top.width, top.height);
+                } else {
+                    sink->reset_clip(ctx);
+                }
+            }
+            break;
+        case AFFERENT_CMD_SPRITES: {
+            uint32_t texture = 0, count = 0;
+            if (!read_u32(&r, &texture) || !read_u32(&r, &count)) FAIL("truncated sprites header");
+            const float* sprites = take(&r, (uint64_t)count * 5 * sizeof(float));
+            if (!sprites) FAIL("truncated sprites payload");
+            if (texture >= texture_count) FAIL("texture index out of range");
+            if (sink && count > 0) sink->sprites(ctx, texture, sprites, count);
+            info->draws++;
+            break;
+        }
+        default:
+            FAIL("unknown opcode");
+        }
+        info->commands++;
+    }
+#undef FAIL
+
+    if (sink && depth > 0) sink->reset_clip(ctx);
+    return true;
+}
+
+bool afferent_command_stream_execute(const uint8_t* data, size_t size,
+    uint32_t font_count, uint32_t texture_count,
+    const AfferentCommandSink* sink, void* ctx, AfferentCommandStreamInfo* info) {
+    AfferentCommandStreamInfo local;
+    if (!info) info = &local;
+    memset(info, 0, sizeof(*info));
+    if (!data) {
+        info->error = "null stream";
+        return false;
+    }
+
+    if (!decode(data, size, font_count, texture_count, NULL, NULL, info)) return false;
+    if (!sink) return true;
+    memset(info, 0, sizeof(*info));
+    return decode(data, size, font_count, texture_count, sink, ctx, info);
+}
+
+// ============== Recording sink ==============
+
+typedef struct {
+    char* text;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} Log;
+
+static void log_printf(Log* log, const char* fmt, ...) {
+    if (log->failed) return;
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(log->text + log->length, log->capacity - log->length, fmt, args);
+        va_end(args);
+        if (n < 0) {
+            log->failed = true;
+            return;
+        }
+        if ((size_t)n < log->capacity - log->length) {
+            log->length += (size_t)n;
+            return;
+        }
+        size_t capacity = log->capacity * 2 + (size_t)n + 1;
+        char* grown = realloc(log->text, capacity);
+        if (!grown) {
+            log->failed = true;
+            return;
+        }
+        log->text = grown;
+        log->capacity = capacity;
+    }
+}
+
+static void record_triangles(void* ctx, const AfferentVertex* vertices, uint32_t vertex_count,
+    const uint32_t* indices, uint32_t index_count) {
+    (void)indices;
+    const AfferentVertex* v = &vertices[0];
+    log_printf(ctx, "triangles %u %u %g %g %g %g %g %g\n", vertex_count, index_count,
+        v->position[0], v->position[1], v->color[0], v->color[1], v->color[2], v->color[3]);
+}
+
+static void record_text(void* ctx, uint32_t font, const char* utf8, uint32_t length,
+    float x, float y, const float* color, const float* transform) {
+    log_printf(ctx, "text %u \"%.*s\" %g %g %g %g %g %g [%g %g %g %g %g %g]\n", font, (int)length, utf8,
+        x, y, color[0], color[1], color[2], color[3],
+        transform[0], transform[1], transform[2], transform[3], transform[4], transform[5]);
+}
+
+static void record_set_clip(void* ctx, float x, float y, float width, float height) {
+    log_printf(ctx, "clip %g %g %g %g\n", x, y, width, height);
+}
+
+static void record_reset_clip(void* ctx) {
+    log_printf(ctx, "unclip\n");
+}
+
+static void record_sprites(void* ctx, uint32_t texture, const float* data, uint32_t count) {
+    log_printf(ctx, "sprites %u %u %g %g %g %g %g\n", texture, count,
+        data[0], data[1], data[2], data[3], data[4]);
+}
+
+char* afferent_command_stream_record(const uint8_t* data, size_t size,
+    uint32_t font_count, uint32_t texture_count, AfferentCommandStreamInfo* info) {
+    static const AfferentCommandSink sink = {
+        record_triangles, record_text, record_set_clip, record_reset_clip, record_sprites
+    };
+    Log log = { malloc(256), 0, 256, false };
+    if (!log.text) return NULL;
+    log.text[0] = '\0';
+
+    if (!afferent_command_stream_execute(data, size, font_count, texture_count, &sink, &log, info) ||
+        log.failed) {
+        free(log.text);
+        return NULL;
+    }
+    return log.text;
+}
@@ -0,0 +1,286 @@
+/*
+ * FixedStepper - Deterministic fixed-timestep bouncing simulation
+ *
+ * Wall-clock frame time is fed into an accumulator and consumed in whole
+ * fixed substeps, so the simulation result depends only on the number of
+ * steps taken, never on the frame rate. The previous and current states are
+ * kept side by side (pointer-swapped, no copies) and the render instance
+ * buffer is written with positions interpolated by the leftover fraction of
+ * a step, fused into the last substep of the frame.
+ *
+ * Determinism: state is float32, stepping uses only IEEE add/mul/compare and
+ * this file is built with FMA contraction disabled, so a headless run from
+ * the same seed produces bit-identical state on every conforming machine.
+ */
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STEPPER_FLOATS 5  // [x, y, vx, vy, hue] per particle
+
+struct AfferentFixedStepper {
+    float* prev;
+    float* curr;
+    uint32_t count;
+
+    float fixed_dt;
+    uint32_t max_substeps;
+    double accumulator;     // Unconsumed frame time (seconds)
+    float alpha;            // accumulator / fixed_dt after the last advance
+
+    float width, height;
+    float radius;
+
+    uint64_t step_count;
+    double dropped_time;    // Frame time discarded by the max_substeps clamp
+};
+
+AfferentResult afferent_fixed_stepper_create(uint32_t count, float fixed_dt,
+    uint32_t max_substeps, AfferentFixedStepperRef* out) {
+    if (!out || count == 0 || !(fixed_dt > 0.0f)) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    AfferentFixedStepperRef s = calloc(1, sizeof(struct AfferentFixedStepper));
+    if (!s) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    size_t floats = (size_t)count * STEPPER_FLOATS;
+    s->prev = calloc(floats, sizeof(float));
+    s->curr = calloc(floats, sizeof(float));
+    if (!s->prev || !s->curr) {
+        free(s->prev);
+        free(s->curr);
+        free(s);
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    s->count = count;
+    s->fixed_dt = fixed_dt;
+    s->max_substeps = max_substeps > 0 ? max_substeps : 1;
+    s->width = 1.0f;
+    s->height = 1.0f;
+
+    *out = s;
+    return AFFERENT_OK;
+}
+
+void afferent_fixed_stepper_destroy(AfferentFixedStepperRef s) {
+    if (s) {
+        free(s->prev);
+        free(s->curr);
+        free(s);
+    }
+}
+
+void afferent_fixed_stepper_set_bounds(AfferentFixedStepperRef s, float width, float height,
+    float radius) {
+    s->width = width;
+    s->height = height;
+    s->radius = radius;
+}
+
+uint32_t afferent_fixed_stepper_count(AfferentFixedStepperRef s) {
+    return s->count;
+}
+
+float afferent_fixed_stepper_alpha(AfferentFixedStepperRef s) {
+    return s->alpha;
+}
+
+uint64_t afferent_fixed_stepper_step_count(AfferentFixedStepperRef s) {
+    return s->step_count;
+}
+
+double afferent_fixed_stepper_dropped_time(AfferentFixedStepperRef s) {
+    return s->dropped_time;
+}
+
+// Restart timing and make prev == curr (no interpolation across a reset)
+static void reset_timing(AfferentFixedStepperRef s) {
+    memcpy(s->prev, s->curr, (size_t)s->count * STEPPER_FLOATS * sizeof(float));
+    s->accumulator = 0.0;
+    s->alpha = 0.0f;
+    s->step_count = 0;
+    s->dropped_time = 0.0;
+}
+
+// PCG32 (XSH-RR); integer-only, so seeding is exact everywhere
+static inline uint32_t pcg32_next(uint64_t* state) {
+    uint64_t old = *state;
+    *state = old * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+static inline float rand_unit(uint64_t* state) {
+    // 24 random bits scaled by 2^-24 is exact in float32
+    return (float)(pcg32_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+void afferent_fixed_stepper_init_random(AfferentFixedStepperRef s, float width, float height,
+    float max_speed, uint32_t seed) {
+    uint64_t state = (uint64_t)seed * 0x9E3779B97F4A7C15ULL + 1;
+    pcg32_next(&state);
+    float inv_count = 1.0f / (float)s->count;
+    for (uint32_t i = 0; i < s->count; i++) {
+        float* p = s->curr + (size_t)i * STEPPER_FLOATS;
+        p[0] = rand_unit(&state) * width;
+        p[1] = rand_unit(&state) * height;
+        p[2] = (rand_unit(&state) - 0.5f) * 2.0f * max_speed;
+        p[3] = (rand_unit(&state) - 0.5f) * 2.0f * max_speed;
+        p[4] = (float)i * inv_count;
+    }
+    reset_timing(s);
+}
+
+uint32_t afferent_fixed_stepper_load(AfferentFixedStepperRef s, const double* data,
+    size_t count) {
+    uint32_t n = count < s->count ? (uint32_t)count : s->count;
+    for (size_t i = 0; i < (size_t)n * STEPPER_FLOATS; i++) {
+        s->curr[i] = (float)data[i];
+    }
+    if (n < s->count) {
+        memset(s->curr + (size_t)n * STEPPER_FLOATS, 0,
+            (size_t)(s->count - n) * STEPPER_FLOATS * sizeof(float));
+    }
+    reset_timing(s);
+    return n;
+}
+
+const float* afferent_fixed_stepper_state(AfferentFixedStepperRef s) {
+    return s->curr;
+}
+
+// ============================================================================
+// Stepping
+// ============================================================================
+
+static inline void write_instance(const float* prev, const float* curr, float alpha,
+    float radius, AfferentParticleLayout layout, float* out) {
+    float x = prev[0] + (curr[0] - prev[0]) * alpha;
+    float y = prev[1] + (curr[1] - prev[1]) * alpha;
+    if (layout == AFFERENT_PARTICLE_LAYOUT_CIRCLES) {
+        out[0] = x;
+        out[1] = y;
+        out[2] = curr[4];
+        out[3] = radius;
+    } else {
+        out[0] = x;
+        out[1] = y;
+        out[2] = 0.0f;
+        out[3] = radius;
+        out[4] = 1.0f;
+    }
+}
+
+// One fixed step from prev into curr; optionally writes interpolated instances.
+static void step_once(AfferentFixedStepperRef s, float* out, size_t out_slots,
+    AfferentParticleLayout layout) {
+    float* tmp = s->prev;
+    s->prev = s->curr;
+    s->curr = tmp;
+
+    const float dt = s->fixed_dt;
+    const float r = s->radius;
+    const float max_x = s->width - r;
+    const float max_y = s->height - r;
+    const float alpha = s->alpha;
+    const uint32_t stride = afferent_particle_layout_floats(layout);
+    const float* src = s->prev;
+    float* dst = s->curr;
+
+    for (uint32_t i = 0; i < s->count; i++) {
+        const float* p = src + (size_t)i * STEPPER_FLOATS;
+        float* q = dst + (size_t)i * STEPPER_FLOATS;
+        float x = p[0] + p[2] * dt;
+        float y = p[1] + p[3] * dt;
+        float vx = p[2];
+        float vy = p[3];
+
+        if (x < r) { x = r; vx = -vx; }
+        else if (x > max_x) { x = max_x; vx = -vx; }
+        if (y < r) { y = r; vy = -vy; }
+        else if (y > max_y) { y = max_y; vy = -vy; }
+
+        q[0] = x;
+        q[1] = y;
+        q[2] = vx;
+        q[3] = vy;
+        q[4] = p[4];
+
+        if (i < out_slots) {
+            write_instance(p, q, alpha, r, layout, out + (size_t)i * stride);
+        }
+    }
+    s->step_count++;
+}
+
+uint32_t afferent_fixed_stepper_write(AfferentFixedStepperRef s, float* out,
+    size_t out_capacity_floats, AfferentParticleLayout layout) {
+    if (!s || !out) return 0;
+    uint32_t stride = afferent_particle_layout_floats(layout);
+    size_t slots = out_capacity_floats / stride;
+    uint32_t n = s->count < slots ? s->count : (uint32_t)slots;
+    for (uint32_t i = 0; i < n; i++) {
+        write_instance(s->prev + (size_t)i * STEPPER_FLOATS, s->curr + (size_t)i * STEPPER_FLOATS,
+            s->alpha, s->radius, layout, out + (size_t)i * stride);
+    }
+    return n;
+}
+
+uint32_t afferent_fixed_stepper_advance(AfferentFixedStepperRef s, double frame_dt,
+    float* out, size_t out_capacity_floats, AfferentParticleLayout layout) {
+    if (!s) return 0;
+    if (frame_dt > 0.0) s->accumulator += frame_dt;  // Also rejects NaN
+
+    // Clamp so a long stall cannot trigger an ever-growing catch-up
+    double dt = (double)s->fixed_dt;
+    double max_time = dt * (double)s->max_substeps;
+    if (s->accumulator > max_time) {
+        s->dropped_time += s->accumulator - max_time;
+        s->accumulator = max_time;
+    }
+
+    uint32_t substeps = 0;
+    while (s->accumulator >= dt && substeps < s->max_substeps) {
+        s->accumulator -= dt;
+        substeps++;
+    }
+    // Alpha is known before stepping, so the last substep can write the
+    // interpolated instances in the same pass
+    s->alpha = (float)(s->accumulator / dt);
+
+    size_t out_slots = out ? out_capacity_floats / afferent_particle_layout_floats(layout) : 0;
+    for (uint32_t k = 0; k < substeps; k++) {
+        bool last = k + 1 == substeps;
+        step_once(s, last ? out : NULL, last ? out_slots : 0, layout);
+    }
+    if (substeps == 0 && out) {
+        afferent_fixed_stepper_write(s, out, out_capacity_floats, layout);
+    }
+    return substeps;
+}
+
+void afferent_fixed_stepper_run(AfferentFixedStepperRef s, uint32_t steps) {
+    if (!s) return;
+    s->alpha = 0.0f;
+    for (uint32_t k = 0; k < steps; k++) {
+        step_once(s, NULL, 0, AFFERENT_PARTICLE_LAYOUT_CIRCLES);
+    }
+}
+
+uint64_t afferent_fixed_stepper_checksum(AfferentFixedStepperRef s) {
+    // FNV-1a over the raw bits of the current state
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char* bytes = (const unsigned char*)s->curr;
+    size_t n = (size_t)s->count * STEPPER_FLOATS * sizeof(float);
+    for (size_t i = 0; i < n; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
@@ -88,28 +88,65 @@ void afferent_float_buffer_set_vec5(AfferentFloatBufferRef buf, size_t index,
     ptr[4] = v4;
 }
 
+void afferent_float_buffer_copy(AfferentFloatBufferRef dst, size_t dst_index,
+    AfferentFloatBufferRef src, size_t src_index, size_t count) {
+    // memmove: dst and src may be the same buffer
+    memmove(dst->data + dst_index, src->data + src_index, count * sizeof(float));
+}
+
+// ============================================================================
+// Particle state in Lean FloatArray memory
+// Layout: [x, y, vx, vy, hue] per particle (5 doubles)
+// ============================================================================
+
+void afferent_particles_update_bouncing(double* p, uint32_t count,
+    double dt, double radius, double width, double height) {
+    for (uint32_t i = 0; i < count; i++) {
+        double* q = p + (size_t)i * 5;
+        double x = q[0] + q[2] * dt;
+        double y = q[1] + q[3] * dt;
+
+        if (x < radius) { x = radius; q[2] = -q[2]; }
+        else if (x > width - radius) { x = width - radius; q[2] = -q[2]; }
+        if (y < radius) { y = radius; q[3] = -q[3]; }
+        else if (y > height - radius) { y = height - radius; q[3] = -q[3]; }
+
+        q[0] = x;
+        q[1] = y;
+    }
+}
+
+void afferent_particles_pack_sprites(const double* p, uint32_t count,
+    float half_size, float* out) {
+    for (uint32_t i = 0; i < count; i++) {
+        const double* q = p + (size_t)i * 5;
+        float* o = out + (size_t)i * 5;
+        o[0] = (float)q[0];
+        o[1] = (float)q[1];
+        o[2] = 0.0f;
+        o[3] = half_size;
+        o[4] = 1.0f;
+    }
+}
+
 // ============================================================================
 // Sprite System - High-performance bouncing sprites with C-side physics
 // Layout: [x, y, vx, vy, rotation] per sprite (5 floats)
 // ============================================================================
 
-// Initialize sprites with random positions and velocities
+// Initialize sprites with random positions and velocities.
+// Uses the parallel counter-based initializer; rotation (slot 4) is zero.
 void afferent_float_buffer_init_sprites(AfferentFloatBufferRef buf, uint32_t count,
     float screenWidth, float screenHeight, uint32_t seed) {
-    uint32_t s = seed;
-    for (uint32_t i = 0; i < count; i++) {
-        float* ptr = buf->data + i * 5;
-        // Simple LCG random
-        s = s * 1103515245 + 12345;
-        ptr[0] = ((float)(s & 0x7FFFFFFF) / 2147483648.0f) * screenWidth;  // x
-        s = s * 1103515245 + 12345;
-        ptr[1] = ((float)(s & 0x7FFFFFFF) / 2147483648.0f) * screenHeight; // y
-        s = s * 1103515245 + 12345;
-        ptr[2] = (((float)(s & 0x7FFFFFFF) / 2147483648.0f) - 0.5f) * 400.0f; // vx
-        s = s * 1103515245 + 12345;
-        ptr[3] = (((float)(s & 0x7FFFFFFF) / 2147483648.0f) - 0.5f) * 400.0f; // vy
-        ptr[4] = 0.0f; // rotation
-    }
+    AfferentParticleInitDesc desc = {
+        .position = AFFERENT_INIT_POSITION_RECT,
+        .p = { 0.0f, 0.0f, screenWidth, screenHeight },
+        .velocity = AFFERENT_INIT_VELOCITY_BOX,
+        .v = { 200.0f, 0.0f },
+        .hue = AFFERENT_INIT_HUE_CONSTANT,
+        .h = { 0.0f, 0.0f },
+    };
+    afferent_particle_init_f32(&desc, count, seed, 0, buf->data);
 }
 
 // Update sprite physics (bouncing) - runs entirely in C, no FFI overhead per sprite
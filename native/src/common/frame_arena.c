@@ -0,0 +1,229 @@
+/*
+ * FrameArena - Bump-pointer scratch memory with per-frame reset
+ *
+ * FFI conversions (Lean arrays to float buffers, text vertices, 3D vertex
+ * structs) need scratch memory that only lives until the data has been
+ * copied into a GPU buffer. Allocating it from a per-renderer arena replaces
+ * a malloc/free pair per call (and the process-global grow-only buffers the
+ * bridge used to keep) with a pointer bump.
+ *
+ * Memory is a chain of blocks. A full block is left in place and a new one
+ * is pushed; rewinding to a mark parks the newer blocks on a spare list for
+ * reuse. On reset, a frame that needed more than one block gets them folded
+ * into a single block sized to the high-water mark, so after the first few
+ * frames of a steady workload the arena never calls malloc.
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGN 16
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* prev;    // Older block (live chain or spare list)
+    size_t capacity;
+    size_t used;
+} ArenaBlock;
+
+// Block data starts after the header, rounded up to the allocation alignment
+#define BLOCK_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+struct AfferentFrameArena {
+    ArenaBlock* head;           // Newest live block
+    ArenaBlock* spare;          // Released blocks, reused before calling malloc
+    size_t default_block;
+    bool passthrough;
+
+    size_t live_bytes;
+    size_t frame_peak;
+    size_t last_frame_peak;
+    size_t high_water;
+
+    uint64_t frames;
+    uint64_t system_allocs;
+    uint64_t frame_allocs;
+    uint64_t last_frame_allocs;
+};
+
+static inline size_t align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static ArenaBlock* block_new(AfferentFrameArenaRef arena, size_t capacity) {
+    ArenaBlock* b = malloc(BLOCK_HEADER + capacity);
+    if (!b) return NULL;
+    b->prev = NULL;
+    b->capacity = capacity;
+    b->used = 0;
+    arena->system_allocs++;
+    arena->frame_allocs++;
+    return b;
+}
+
+static void free_list(ArenaBlock* b) {
+    while (b) {
+        ArenaBlock* prev = b->prev;
+        free(b);
+        b = prev;
+    }
+}
+
+// Pop the head block onto the spare list (or free it in passthrough mode)
+static void release_head(AfferentFrameArenaRef arena) {
+    ArenaBlock* b = arena->head;
+    arena->head = b->prev;
+    arena->live_bytes -= b->used;
+    if (arena->passthrough) {
+        free(b);
+    } else {
+        b->used = 0;
+        b->prev = arena->spare;
+        arena->spare = b;
+    }
+}
+
+AfferentResult afferent_frame_arena_create(size_t initial_bytes, AfferentFrameArenaRef* out) {
+    if (!out) return AFFERENT_ERROR_BUFFER_FAILED;
+    AfferentFrameArenaRef arena = calloc(1, sizeof(struct AfferentFrameArena));
+    if (!arena) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    arena->default_block = initial_bytes > 0 ? align_up(initial_bytes) : ARENA_DEFAULT_BLOCK;
+    if (initial_bytes > 0) {
+        arena->spare = block_new(arena, arena->default_block);
+        if (!arena->spare) {
+            free(arena);
+            return AFFERENT_ERROR_BUFFER_FAILED;
+        }
+    }
+    *out = arena;
+    return AFFERENT_OK;
+}
+
+void afferent_frame_arena_destroy(AfferentFrameArenaRef arena) {
+    if (arena) {
+        free_list(arena->head);
+        free_list(arena->spare);
+        free(arena);
+    }
+}
+
+// First spare block that fits, unlinked from the spare list
+static ArenaBlock* take_spare(AfferentFrameArenaRef arena, size_t size) {
+    ArenaBlock** link = &arena->spare;
+    while (*link) {
+        ArenaBlock* b = *link;
+        if (b->capacity >= size) {
+            *link = b->prev;
+            return b;
+        }
+        link = &b->prev;
+    }
+    return NULL;
+}
+
+void* afferent_frame_arena_alloc(AfferentFrameArenaRef arena, size_t size) {
+    if (!arena) return NULL;
+    size_t aligned = align_up(size > 0 ? size : 1);
+    if (aligned < size) return NULL;  // Overflow
+
+    ArenaBlock* b = arena->head;
+    if (arena->passthrough || !b || b->capacity - b->used < aligned) {
+        b = arena->passthrough ? NULL : take_spare(arena, aligned);
+        if (!b) {
+            size_t capacity = aligned;
+            if (!arena->passthrough) {
+                size_t grown = arena->head ? arena->head->capacity * 2 : 0;
+                if (capacity < arena->default_block) capacity = arena->default_block;
+                if (capacity < grown) capacity = grown;
+            }
+            b = block_new(arena, capacity);
+            if (!b) return NULL;
+        }
+        b->used = 0;
+        b->prev = arena->head;
+        arena->head = b;
+    }
+
+    void* ptr = (unsigned char*)b + BLOCK_HEADER + b->used;
+    b->used += aligned;
+    arena->live_bytes += aligned;
+    if (arena->live_bytes > arena->frame_peak) arena->frame_peak = arena->live_bytes;
+    if (arena->live_bytes > arena->high_water) arena->high_water = arena->live_bytes;
+    return ptr;
+}
+
+AfferentFrameArenaMark afferent_frame_arena_mark(AfferentFrameArenaRef arena) {
+    AfferentFrameArenaMark mark = { NULL, 0 };
+    if (arena && arena->head) {
+        mark.block = arena->head;
+        mark.used = arena->head->used;
+    }
+    return mark;
+}
+
+void afferent_frame_arena_rewind(AfferentFrameArenaRef arena, AfferentFrameArenaMark mark) {
+    if (!arena) return;
+    // Marks nest LIFO; a mark taken before the last reset releases everything
+    while (arena->head && arena->head != mark.block) {
+        release_head(arena);
+    }
+    if (arena->head && arena->head->used > mark.used) {
+        arena->live_bytes -= arena->head->used - mark.used;
+        arena->head->used = mark.used;
+    }
+}
+
+void afferent_frame_arena_reset(AfferentFrameArenaRef arena) {
+    if (!arena) return;
+    while (arena->head) {
+        release_head(arena);
+    }
+
+    if (!arena->passthrough && arena->spare && arena->spare->prev) {
+        // Several blocks: replace them with one that fits the whole peak
+        size_t capacity = align_up(arena->high_water);
+        if (capacity < arena->default_block) capacity = arena->default_block;
+        ArenaBlock* merged = block_new(arena, capacity);
+        if (merged) {
+            free_list(arena->spare);
+            arena->spare = merged;
+        }
+    }
+
+    arena->last_frame_peak = arena->frame_peak;
+    arena->last_frame_allocs = arena->frame_allocs;
+    arena->frame_peak = 0;
+    arena->frame_allocs = 0;
+    arena->frames++;
+}
+
+void afferent_frame_arena_set_passthrough(AfferentFrameArenaRef arena, bool passthrough) {
+    if (!arena || arena->passthrough == passthrough) return;
+    while (arena->head) {
+        release_head(arena);
+    }
+    free_list(arena->spare);
+    arena->spare = NULL;
+    arena->passthrough = passthrough;
+}
+
+void afferent_frame_arena_get_stats(AfferentFrameArenaRef arena, AfferentFrameArenaStats* out) {
+    if (!arena || !out) return;
+    memset(out, 0, sizeof(*out));
+    out->bytes_in_use = arena->live_bytes;
+    out->frame_peak_bytes = arena->last_frame_peak;
+    out->high_water_bytes = arena->high_water;
+    out->frames = arena->frames;
+    out->system_allocs = arena->system_allocs;
+    out->last_frame_allocs = arena->last_frame_allocs;
+    for (ArenaBlock* b = arena->head; b; b = b->prev) {
+        out->capacity_bytes += b->capacity;
+        out->block_count++;
+    }
+    for (ArenaBlock* b = arena->spare; b; b = b->prev) {
+        out->capacity_bytes += b->capacity;
+        out->block_count++;
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ * Mesh - Persistent 3D mesh storage shared by the GPU backends
+ *
+ * Vertices and indices are narrowed/copied into C memory once at creation.
+ * The backend creates its GPU buffers from this copy on first draw and
+ * afterwards only re-uploads the vertex/index ranges touched by updates,
+ * which are tracked here as one merged dirty range per stream. Nothing in
+ * this file talks to the GPU, so the bookkeeping is testable headless.
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t first;
+    uint32_t end;    // Exclusive; first == end means clean
+} DirtyRange;
+
+struct AfferentMesh {
+    AfferentMeshFormat format;
+    uint32_t floats_per_vertex;
+
+    float* vertices;
+    uint32_t vertex_count;
+    uint32_t* indices;
+    uint32_t index_count;
+
+    DirtyRange vertex_dirty;
+    DirtyRange index_dirty;
+
+    // Backend-owned GPU buffers, released through the callback on destroy
+    void* gpu_vertices;
+    void* gpu_indices;
+    AfferentMeshGpuRelease gpu_release;
+
+    uint64_t vertex_updates;
+    uint64_t index_updates;
+};
+
+uint32_t afferent_mesh_format_floats(AfferentMeshFormat format) {
+    return format == AFFERENT_MESH_FORMAT_TEXTURED ? 12 : 10;
+}
+
+AfferentResult afferent_mesh_create(AfferentMeshFormat format, const double* vertices,
+    uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, AfferentMeshRef* out) {
+    if (!out || !vertices || !indices || vertex_count == 0 || index_count == 0) {
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+    // Every index must address an existing vertex
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (indices[i] >= vertex_count) return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    AfferentMeshRef mesh = calloc(1, sizeof(struct AfferentMesh));
+    if (!mesh) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    mesh->format = format;
+    mesh->floats_per_vertex = afferent_mesh_format_floats(format);
+    size_t floats = (size_t)vertex_count * mesh->floats_per_vertex;
+    mesh->vertices = malloc(floats * sizeof(float));
+    mesh->indices = malloc((size_t)index_count * sizeof(uint32_t));
+    if (!mesh->vertices || !mesh->indices) {
+        free(mesh->vertices);
+        free(mesh->indices);
+        free(mesh);
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    afferent_narrow_f64_to_f32(vertices, mesh->vertices, floats);
+    memcpy(mesh->indices, indices, (size_t)index_count * sizeof(uint32_t));
+    mesh->vertex_count = vertex_count;
+    mesh->index_count = index_count;
+
+    *out = mesh;
+    return AFFERENT_OK;
+}
+
+void afferent_mesh_destroy(AfferentMeshRef mesh) {
+    if (!mesh) return;
+    if (mesh->gpu_release && (mesh->gpu_vertices || mesh->gpu_indices)) {
+        mesh->gpu_release(mesh->gpu_vertices, mesh->gpu_indices);
+    }
+    free(mesh->vertices);
+    free(mesh->indices);
+    free(mesh);
+}
+
+AfferentMeshFormat afferent_mesh_format(AfferentMeshRef mesh) {
+    return mesh->format;
+}
+
+uint32_t afferent_mesh_vertex_count(AfferentMeshRef mesh) {
+    return mesh->vertex_count;
+}
+
+uint32_t afferent_mesh_index_count(AfferentMeshRef mesh) {
+    return mesh->index_count;
+}
+
+const float* afferent_mesh_vertices(AfferentMeshRef mesh) {
+    return mesh->vertices;
+}
+
+const uint32_t* afferent_mesh_indices(AfferentMeshRef mesh) {
+    return mesh->indices;
+}
+
+static void dirty_add(DirtyRange* r, uint32_t first, uint32_t end) {
+    if (r->first == r->end) {
+        r->first = first;
+        r->end = end;
+    } else {
+        if (first < r->first) r->first = first;
+        if (end > r->end) r->end = end;
+    }
+}
+
+bool afferent_mesh_update_vertices(AfferentMeshRef mesh, uint32_t first_vertex,
+    const double* data, uint32_t vertex_count) {
+    if (!mesh || !data) return false;
+    if ((uint64_t)first_vertex + vertex_count > mesh->vertex_count) return false;
+    if (vertex_count == 0) return true;
+
+    size_t stride = mesh->floats_per_vertex;
+    afferent_narrow_f64_to_f32(data, mesh->vertices + (size_t)first_vertex * stride,
+        (size_t)vertex_count * stride);
+    dirty_add(&mesh->vertex_dirty, first_vertex, first_vertex + vertex_count);
+    mesh->vertex_updates++;
+    return true;
+}
+
+bool afferent_mesh_update_indices(AfferentMeshRef mesh, uint32_t first_index,
+    const uint32_t* data, uint32_t index_count) {
+    if (!mesh || !data) return false;
+    if ((uint64_t)first_index + index_count > mesh->index_count) return false;
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (data[i] >= mesh->vertex_count) return false;
+    }
+    if (index_count == 0) return true;
+
+    memcpy(mesh->indices + first_index, data, (size_t)index_count * sizeof(uint32_t));
+    dirty_add(&mesh->index_dirty, first_index, first_index + index_count);
+    mesh->index_updates++;
+    return true;
+}
+
+static bool dirty_peek(const DirtyRange* r, uint32_t* first, uint32_t* count) {
+    *first = r->first;
+    *count = r->end - r->first;
+    return *count > 0;
+}
+
+bool afferent_mesh_dirty_vertices(AfferentMeshRef mesh, uint32_t* first, uint32_t* count) {
+    return dirty_peek(&mesh->vertex_dirty, first, count);
+}
+
+bool afferent_mesh_dirty_indices(AfferentMeshRef mesh, uint32_t* first, uint32_t* count) {
+    return dirty_peek(&mesh->index_dirty, first, count);
+}
+
+void afferent_mesh_clear_dirty(AfferentMeshRef mesh) {
+    memset(&mesh->vertex_dirty, 0, sizeof(DirtyRange));
+    memset(&mesh->index_dirty, 0, sizeof(DirtyRange));
+}
+
+void afferent_mesh_get_stats(AfferentMeshRef mesh, AfferentMeshStats* out) {
+    if (!mesh || !out) return;
+    out->vertex_updates = mesh->vertex_updates;
+    out->index_updates = mesh->index_updates;
+    out->cpu_bytes = (uint64_t)mesh->vertex_count * mesh->floats_per_vertex * sizeof(float) +
+        (uint64_t)mesh->index_count * sizeof(uint32_t);
+    out->gpu_resident = mesh->gpu_vertices != NULL && mesh->gpu_indices != NULL;
+}
+
+bool afferent_mesh_clamp_range(AfferentMeshRef mesh, uint32_t* index_offset, uint32_t* index_count) {
+    if (!mesh || *index_offset >= mesh->index_count) return false;
+    uint32_t available = mesh->index_count - *index_offset;
+    if (*index_count > available) *index_count = available;
+    return *index_count > 0;
+}
+
+void* afferent_mesh_gpu_vertices(AfferentMeshRef mesh) {
+    return mesh->gpu_vertices;
+}
+
+void* afferent_mesh_gpu_indices(AfferentMeshRef mesh) {
+    return mesh->gpu_indices;
+}
+
+void afferent_mesh_set_gpu_buffers(AfferentMeshRef mesh, void* vertices, void* indices,
+    AfferentMeshGpuRelease release) {
+    if (mesh->gpu_release && (mesh->gpu_vertices || mesh->gpu_indices)) {
+        mesh->gpu_release(mesh->gpu_vertices, mesh->gpu_indices);
+    }
+    mesh->gpu_vertices = vertices;
+    mesh->gpu_indices = indices;
+    mesh->gpu_release = release;
+}
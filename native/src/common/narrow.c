@@ -0,0 +1,43 @@
+/*
+ * Narrow - f64 to f32 conversion for FFI marshalling
+ *
+ * Lean's FloatArray stores unboxed doubles contiguously, while every GPU
+ * buffer in the renderer is float32. Converting a FloatArray is therefore a
+ * straight streaming narrow, which this file vectorizes with SSE2 (x86-64)
+ * or NEON (arm64) and finishes with a scalar tail.
+ */
+
+#include "afferent.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NARROW_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NARROW_NEON 1
+#endif
+
+void afferent_narrow_f64_to_f32(const double* src, float* dst, size_t count) {
+    size_t i = 0;
+#if defined(NARROW_SSE2)
+    // 8 doubles -> 8 floats per iteration (cvtpd2ps yields 2 floats per lane pair)
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        __m128 c = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 4));
+        __m128 d = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 6));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(dst + i + 4, _mm_movelh_ps(c, d));
+    }
+#elif defined(NARROW_NEON)
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(src + i)), vld1q_f64(src + i + 2));
+        float32x4_t b = vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(src + i + 4)), vld1q_f64(src + i + 6));
+        vst1q_f32(dst + i, a);
+        vst1q_f32(dst + i + 4, b);
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = (float)src[i];
+    }
+}
@@ -0,0 +1,386 @@
+/*
+ * PackedBuffer - Schema-driven packed instance buffer
+ *
+ * FloatBuffer stores every instance field as a 32-bit float, so a rect
+ * instance (pos2, angle, halfSize, rgba4) costs 32 bytes. PackedBuffer
+ * stores each field with its own encoding (f32, f16, unorm8x4, snorm16),
+ * which lets the same instance shrink to 12-16 bytes.
+ *
+ * Callers still produce/consume plain float streams; pack/unpack kernels
+ * translate between the logical float layout and the packed byte layout.
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+struct AfferentPackedBuffer {
+    uint8_t* data;
+    size_t capacity;            // Capacity in instances
+    uint32_t stride;            // Bytes per packed instance (multiple of 4)
+    uint32_t float_count;       // Logical floats per instance
+    uint32_t field_count;
+    uint8_t encodings[AFFERENT_PACKED_MAX_FIELDS];
+    uint16_t offsets[AFFERENT_PACKED_MAX_FIELDS];  // Byte offset of each field
+};
+
+// ============================================================================
+// Scalar kernels
+// ============================================================================
+
+// IEEE 754 binary32 -> binary16 with round-to-nearest-even.
+// Overflow saturates to infinity; NaN stays NaN.
+uint16_t afferent_pack_f16(float value) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+    // Apple Silicon: single hardware conversion, same rounding as the portable path
+    __fp16 h = (__fp16)value;
+    uint16_t bits;
+    memcpy(&bits, &h, sizeof(bits));
+    return bits;
+#else
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+
+    uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t exp = (x >> 23) & 0xFFu;
+    uint32_t mant = x & 0x7FFFFFu;
+
+    if (exp == 0xFFu) {
+        return (uint16_t)(sign | 0x7C00u | (mant ? 0x200u : 0u));
+    }
+
+    int32_t e = (int32_t)exp - 127 + 15;
+    if (e >= 31) {
+        return (uint16_t)(sign | 0x7C00u);
+    }
+
+    if (e <= 0) {
+        // Result is a half subnormal (or zero)
+        if (e < -10) return (uint16_t)sign;
+        mant |= 0x800000u;
+        uint32_t shift = (uint32_t)(14 - e);
+        uint32_t half = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (rem > halfway || (rem == halfway && (half & 1u))) half++;
+        return (uint16_t)(sign | half);
+    }
+
+    uint32_t half = ((uint32_t)e << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1FFFu;
+    // A carry out of the mantissa correctly bumps the exponent (up to infinity)
+    if (rem > 0x1000u || (rem == 0x1000u && (half & 1u))) half++;
+    return (uint16_t)(sign | half);
+#endif
+}
+
+float afferent_unpack_f16(uint16_t bits) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+    __fp16 h;
+    memcpy(&h, &bits, sizeof(h));
+    return (float)h;
+#else
+    uint32_t sign = (uint32_t)(bits & 0x8000u) << 16;
+    uint32_t exp = (bits >> 10) & 0x1Fu;
+    uint32_t mant = bits & 0x3FFu;
+    uint32_t x;
+
+    if (exp == 0) {
+        if (mant == 0) {
+            x = sign;
+        } else {
+            // Normalize the half subnormal into a float normal
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400u)) {
+                mant <<= 1;
+                exp--;
+            }
+            mant &= 0x3FFu;
+            x = sign | (exp << 23) | (mant << 13);
+        }
+    } else if (exp == 0x1Fu) {
+        x = sign | 0x7F800000u | (mant << 13);
+    } else {
+        x = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+    }
+
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+#endif
+}
+
+// Clamp to [0, 1] and quantize to 8 bits. NaN encodes as 0.
+static inline uint8_t pack_unorm8(float v) {
+    v = v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+// Clamp to [-1, 1] and quantize to a signed 16-bit integer. NaN encodes as 0.
+static inline uint16_t pack_snorm16(float v) {
+    v = v > -1.0f ? (v < 1.0f ? v : 1.0f) : (v == v ? -1.0f : 0.0f);
+    int16_t q = (int16_t)lrintf(v * 32767.0f);
+    return (uint16_t)q;
+}
+
+static inline float unpack_snorm16(uint16_t bits) {
+    int16_t q = (int16_t)bits;
+    float v = (float)q / 32767.0f;
+    return v < -1.0f ? -1.0f : v;
+}
+
+static uint32_t encoding_bytes(uint8_t encoding) {
+    switch (encoding) {
+        case AFFERENT_FIELD_F32:      return 4;
+        case AFFERENT_FIELD_F16:      return 2;
+        case AFFERENT_FIELD_UNORM8X4: return 4;
+        case AFFERENT_FIELD_SNORM16:  return 2;
+        default:                      return 0;
+    }
+}
+
+static uint32_t encoding_floats(uint8_t encoding) {
+    return encoding == AFFERENT_FIELD_UNORM8X4 ? 4 : 1;
+}
+
+// ============================================================================
+// Buffer lifecycle
+// ============================================================================
+
+AfferentResult afferent_packed_buffer_create(
+    const uint8_t* encodings,
+    uint32_t field_count,
+    size_t capacity,
+    AfferentPackedBufferRef* out
+) {
+    if (!out || !encodings || field_count == 0 || field_count > AFFERENT_PACKED_MAX_FIELDS) {
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    AfferentPackedBufferRef buf = calloc(1, sizeof(struct AfferentPackedBuffer));
+    if (!buf) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    // Lay fields out in schema order; 2-byte fields are packed back to back
+    uint32_t offset = 0;
+    uint32_t floats = 0;
+    for (uint32_t i = 0; i < field_count; i++) {
+        uint32_t bytes = encoding_bytes(encodings[i]);
+        if (bytes == 0) {
+            free(buf);
+            return AFFERENT_ERROR_BUFFER_FAILED;
+        }
+        // Keep 4-byte fields 4-byte aligned so the GPU can fetch them directly
+        if (bytes == 4) offset = (offset + 3u) & ~3u;
+        buf->encodings[i] = encodings[i];
+        buf->offsets[i] = (uint16_t)offset;
+        offset += bytes;
+        floats += encoding_floats(encodings[i]);
+    }
+
+    buf->field_count = field_count;
+    buf->float_count = floats;
+    buf->stride = (offset + 3u) & ~3u;
+    buf->capacity = capacity;
+
+    buf->data = calloc(capacity > 0 ? capacity : 1, buf->stride);
+    if (!buf->data) {
+        free(buf);
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    *out = buf;
+    return AFFERENT_OK;
+}
+
+void afferent_packed_buffer_destroy(AfferentPackedBufferRef buf) {
+    if (buf) {
+        free(buf->data);
+        free(buf);
+    }
+}
+
+size_t afferent_packed_buffer_capacity(AfferentPackedBufferRef buf) {
+    return buf->capacity;
+}
+
+uint32_t afferent_packed_buffer_stride(AfferentPackedBufferRef buf) {
+    return buf->stride;
+}
+
+uint32_t afferent_packed_buffer_floats_per_instance(AfferentPackedBufferRef buf) {
+    return buf->float_count;
+}
+
+const uint8_t* afferent_packed_buffer_data(AfferentPackedBufferRef buf) {
+    return buf->data;
+}
+
+// ============================================================================
+// Pack / unpack kernels
+// ============================================================================
+
+static inline void pack_instance(AfferentPackedBufferRef buf, const float* src, uint8_t* dst) {
+    for (uint32_t f = 0; f < buf->field_count; f++) {
+        uint8_t* out = dst + buf->offsets[f];
+        switch (buf->encodings[f]) {
+            case AFFERENT_FIELD_F32:
+                memcpy(out, src, 4);
+                src += 1;
+                break;
+            case AFFERENT_FIELD_F16: {
+                uint16_t h = afferent_pack_f16(src[0]);
+                memcpy(out, &h, 2);
+                src += 1;
+                break;
+            }
+            case AFFERENT_FIELD_UNORM8X4:
+                out[0] = pack_unorm8(src[0]);
+                out[1] = pack_unorm8(src[1]);
+                out[2] = pack_unorm8(src[2]);
+                out[3] = pack_unorm8(src[3]);
+                src += 4;
+                break;
+            case AFFERENT_FIELD_SNORM16: {
+                uint16_t s = pack_snorm16(src[0]);
+                memcpy(out, &s, 2);
+                src += 1;
+                break;
+            }
+        }
+    }
+}
+
+static inline void unpack_instance(AfferentPackedBufferRef buf, const uint8_t* src, float* dst) {
+    for (uint32_t f = 0; f < buf->field_count; f++) {
+        const uint8_t* in = src + buf->offsets[f];
+        switch (buf->encodings[f]) {
+            case AFFERENT_FIELD_F32:
+                memcpy(dst, in, 4);
+                dst += 1;
+                break;
+            case AFFERENT_FIELD_F16: {
+                uint16_t h;
+                memcpy(&h, in, 2);
+                dst[0] = afferent_unpack_f16(h);
+                dst += 1;
+                break;
+            }
+            case AFFERENT_FIELD_UNORM8X4:
+                dst[0] = (float)in[0] / 255.0f;
+                dst[1] = (float)in[1] / 255.0f;
+                dst[2] = (float)in[2] / 255.0f;
+                dst[3] = (float)in[3] / 255.0f;
+                dst += 4;
+                break;
+            case AFFERENT_FIELD_SNORM16: {
+                uint16_t s;
+                memcpy(&s, in, 2);
+                dst[0] = unpack_snorm16(s);
+                dst += 1;
+                break;
+            }
+        }
+    }
+}
+
+// Clamp [first, first + count) to the buffer capacity; returns the usable count.
+static inline size_t clamp_range(AfferentPackedBufferRef buf, size_t first, size_t count) {
+    if (first >= buf->capacity) return 0;
+    size_t avail = buf->capacity - first;
+    return count < avail ? count : avail;
+}
+
+size_t afferent_packed_buffer_pack(
+    AfferentPackedBufferRef buf,
+    size_t first,
+    const float* src,
+    size_t count
+) {
+    if (!buf || !src) return 0;
+    count = clamp_range(buf, first, count);
+
+    uint8_t* dst = buf->data + first * buf->stride;
+    for (size_t i = 0; i < count; i++) {
+        pack_instance(buf, src, dst);
+        src += buf->float_count;
+        dst += buf->stride;
+    }
+    return count * buf->stride;
+}
+
+size_t afferent_packed_buffer_pack_f64(
+    AfferentPackedBufferRef buf,
+    size_t first,
+    const double* src,
+    size_t count
+) {
+    if (!buf || !src) return 0;
+    count = clamp_range(buf, first, count);
+
+    // Narrow one instance at a time into a stack scratch, then reuse the f32 kernel
+    float scratch[AFFERENT_PACKED_MAX_FIELDS * 4];
+    uint8_t* dst = buf->data + first * buf->stride;
+    for (size_t i = 0; i < count; i++) {
+        for (uint32_t k = 0; k < buf->float_count; k++) {
+            scratch[k] = (float)src[k];
+        }
+        pack_instance(buf, scratch, dst);
+        src += buf->float_count;
+        dst += buf->stride;
+    }
+    return count * buf->stride;
+}
+
+size_t afferent_packed_buffer_unpack(
+    AfferentPackedBufferRef buf,
+    size_t first,
+    float* dst,
+    size_t count
+) {
+    if (!buf || !dst) return 0;
+    count = clamp_range(buf, first, count);
+
+    const uint8_t* src = buf->data + first * buf->stride;
+    for (size_t i = 0; i < count; i++) {
+        unpack_instance(buf, src, dst);
+        src += buf->stride;
+        dst += buf->float_count;
+    }
+    return count;
+}
+
+size_t afferent_packed_buffer_unpack_f64(
+    AfferentPackedBufferRef buf,
+    size_t first,
+    double* dst,
+    size_t count
+) {
+    if (!buf || !dst) return 0;
+    count = clamp_range(buf, first, count);
+
+    float scratch[AFFERENT_PACKED_MAX_FIELDS * 4];
+    const uint8_t* src = buf->data + first * buf->stride;
+    for (size_t i = 0; i < count; i++) {
+        unpack_instance(buf, src, scratch);
+        for (uint32_t k = 0; k < buf->float_count; k++) {
+            dst[k] = (double)scratch[k];
+        }
+        src += buf->stride;
+        dst += buf->float_count;
+    }
+    return count;
+}
+
+size_t afferent_packed_buffer_pack_from_float_buffer(
+    AfferentPackedBufferRef buf,
+    size_t first,
+    AfferentFloatBufferRef src,
+    size_t count
+) {
+    if (!buf || !src) return 0;
+    // Never read past the end of the source FloatBuffer
+    size_t src_instances = afferent_float_buffer_capacity(src) / buf->float_count;
+    if (count > src_instances) count = src_instances;
+    return afferent_packed_buffer_pack(buf, first, afferent_float_buffer_data(src), count);
+}
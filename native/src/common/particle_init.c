@@ -0,0 +1,219 @@
+/*
+ * ParticleInit - Parallel particle initialization on a counter-based RNG
+ *
+ * Every random value is a pure function of (seed, particle index) through
+ * Philox4x32-10, so the index range can be split across any number of
+ * threads and the output is bit-identical to a single-threaded run. This
+ * replaces the serial LCG loops that set up particle state at startup.
+ *
+ * Output layout: [x, y, vx, vy, hue] per particle, as float (FloatBuffer) or
+ * double (Lean FloatArray).
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define INIT_FLOATS 5
+#define INIT_MAX_THREADS 64
+// Below this many particles per thread, spawning threads costs more than it saves
+#define INIT_MIN_PER_THREAD 16384
+
+// ============================================================================
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+// ============================================================================
+
+typedef struct { uint32_t v[4]; } Philox4;
+
+static inline uint32_t mulhilo32(uint32_t a, uint32_t b, uint32_t* hi) {
+    uint64_t product = (uint64_t)a * (uint64_t)b;
+    *hi = (uint32_t)(product >> 32);
+    return (uint32_t)product;
+}
+
+static inline Philox4 philox4x32_10(Philox4 ctr, uint32_t key0, uint32_t key1) {
+    for (int round = 0; round < 10; round++) {
+        uint32_t hi0, hi1;
+        uint32_t lo0 = mulhilo32(0xD2511F53u, ctr.v[0], &hi0);
+        uint32_t lo1 = mulhilo32(0xCD9E8D57u, ctr.v[2], &hi1);
+        Philox4 next = {{ hi1 ^ ctr.v[1] ^ key0, lo1, hi0 ^ ctr.v[3] ^ key1, lo0 }};
+        ctr = next;
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+    return ctr;
+}
+
+void afferent_philox4x32(uint32_t counter0, uint32_t counter1, uint32_t counter2,
+    uint32_t counter3, uint32_t key0, uint32_t key1, uint32_t out[4]) {
+    Philox4 ctr = {{ counter0, counter1, counter2, counter3 }};
+    Philox4 r = philox4x32_10(ctr, key0, key1);
+    memcpy(out, r.v, sizeof(r.v));
+}
+
+// Uniform in [0, 1) with 24 bits (exact in float)
+static inline float unit_open(uint32_t bits) {
+    return (float)(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform in (0, 1] for logarithms
+static inline float unit_nonzero(uint32_t bits) {
+    return ((float)(bits >> 8) + 1.0f) * (1.0f / 16777216.0f);
+}
+
+#define TWO_PI 6.28318530717958647692f
+
+// ============================================================================
+// Per-particle generation
+// ============================================================================
+
+static void generate_one(const AfferentParticleInitDesc* d, uint32_t seed, uint32_t count,
+    uint32_t index, float out[INIT_FLOATS]) {
+    // Counter (index, stream, 0, 0): stream 0 drives position, stream 1 velocity and hue
+    Philox4 c0 = {{ index, 0, 0, 0 }};
+    Philox4 c1 = {{ index, 1, 0, 0 }};
+    Philox4 a = philox4x32_10(c0, seed, 0x41464652u);
+    Philox4 b = philox4x32_10(c1, seed, 0x41464652u);
+
+    float x, y;
+    switch (d->position) {
+        case AFFERENT_INIT_POSITION_DISC: {
+            // sqrt keeps the density uniform over the disc's area
+            float r = d->p[2] * sqrtf(unit_open(a.v[0]));
+            float t = TWO_PI * unit_open(a.v[1]);
+            x = d->p[0] + r * cosf(t);
+            y = d->p[1] + r * sinf(t);
+            break;
+        }
+        case AFFERENT_INIT_POSITION_GAUSSIAN: {
+            // Box-Muller
+            float m = d->p[2] * sqrtf(-2.0f * logf(unit_nonzero(a.v[0])));
+            float t = TWO_PI * unit_open(a.v[1]);
+            x = d->p[0] + m * cosf(t);
+            y = d->p[1] + m * sinf(t);
+            break;
+        }
+        case AFFERENT_INIT_POSITION_RECT:
+        default:
+            x = d->p[0] + unit_open(a.v[0]) * d->p[2];
+            y = d->p[1] + unit_open(a.v[1]) * d->p[3];
+            break;
+    }
+
+    float vx, vy;
+    switch (d->velocity) {
+        case AFFERENT_INIT_VELOCITY_BOX:
+            vx = (unit_open(b.v[0]) - 0.5f) * 2.0f * d->v[0];
+            vy = (unit_open(b.v[1]) - 0.5f) * 2.0f * d->v[0];
+            break;
+        case AFFERENT_INIT_VELOCITY_DIRECTIONAL: {
+            float speed = d->v[0] + (d->v[1] - d->v[0]) * unit_open(b.v[0]);
+            float t = TWO_PI * unit_open(b.v[1]);
+            vx = speed * cosf(t);
+            vy = speed * sinf(t);
+            break;
+        }
+        case AFFERENT_INIT_VELOCITY_ZERO:
+        default:
+            vx = 0.0f;
+            vy = 0.0f;
+            break;
+    }
+
+    float hue;
+    switch (d->hue) {
+        case AFFERENT_INIT_HUE_RANDOM:
+            hue = d->h[0] + (d->h[1] - d->h[0]) * unit_open(b.v[2]);
+            break;
+        case AFFERENT_INIT_HUE_CONSTANT:
+            hue = d->h[0];
+            break;
+        case AFFERENT_INIT_HUE_BY_INDEX:
+        default:
+            hue = (float)((double)index / (double)count);
+            break;
+    }
+
+    out[0] = x;
+    out[1] = y;
+    out[2] = vx;
+    out[3] = vy;
+    out[4] = hue;
+}
+
+typedef struct {
+    const AfferentParticleInitDesc* desc;
+    uint32_t seed;
+    uint32_t count;
+    uint32_t begin, end;
+    float* out_f32;
+    double* out_f64;
+} InitRange;
+
+static void* init_range(void* arg) {
+    const InitRange* r = (const InitRange*)arg;
+    float v[INIT_FLOATS];
+    for (uint32_t i = r->begin; i < r->end; i++) {
+        generate_one(r->desc, r->seed, r->count, i, v);
+        size_t base = (size_t)i * INIT_FLOATS;
+        if (r->out_f32) {
+            memcpy(r->out_f32 + base, v, sizeof(v));
+        } else {
+            for (int k = 0; k < INIT_FLOATS; k++) r->out_f64[base + k] = (double)v[k];
+        }
+    }
+    return NULL;
+}
+
+uint32_t afferent_particle_init_thread_count(uint32_t count, uint32_t requested) {
+    uint32_t threads = requested;
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+    uint32_t useful = count / INIT_MIN_PER_THREAD;
+    if (threads > useful) threads = useful;
+    if (threads > INIT_MAX_THREADS) threads = INIT_MAX_THREADS;
+    return threads > 0 ? threads : 1;
+}
+
+static void init_parallel(const AfferentParticleInitDesc* desc, uint32_t count, uint32_t seed,
+    uint32_t threads, float* out_f32, double* out_f64) {
+    threads = afferent_particle_init_thread_count(count, threads);
+
+    InitRange ranges[INIT_MAX_THREADS];
+    pthread_t handles[INIT_MAX_THREADS];
+    bool started[INIT_MAX_THREADS];
+    uint32_t chunk = (count + threads - 1) / threads;
+
+    for (uint32_t t = 0; t < threads; t++) {
+        uint32_t begin = t * chunk;
+        uint32_t end = begin + chunk < count ? begin + chunk : count;
+        ranges[t] = (InitRange){ desc, seed, count, begin, end, out_f32, out_f64 };
+        // Thread 0 runs on the caller; a failed spawn also falls back to the caller
+        started[t] = t > 0 && pthread_create(&handles[t], NULL, init_range, &ranges[t]) == 0;
+    }
+    init_range(&ranges[0]);
+    for (uint32_t t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            init_range(&ranges[t]);
+        }
+    }
+}
+
+void afferent_particle_init_f32(const AfferentParticleInitDesc* desc, uint32_t count,
+    uint32_t seed, uint32_t threads, float* out) {
+    if (!desc || !out || count == 0) return;
+    init_parallel(desc, count, seed, threads, out, NULL);
+}
+
+void afferent_particle_init_f64(const AfferentParticleInitDesc* desc, uint32_t count,
+    uint32_t seed, uint32_t threads, double* out) {
+    if (!desc || !out || count == 0) return;
+    init_parallel(desc, count, seed, threads, NULL, out);
+}
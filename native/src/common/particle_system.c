@@ -0,0 +1,368 @@
+/*
+ * ParticleSystem - Native emitters, lifetimes and forces
+ *
+ * Unlike the fixed-count bouncing particles in float_buffer.c, particles here
+ * are spawned by emitters, age, and die. Dead particles are removed with
+ * swap-remove (the last live particle moves into the hole), so the live set is
+ * always the dense range [0, live_count). Each step writes that range straight
+ * into a FloatBuffer in dynamic-circle or sprite layout, ready to draw with
+ * count = live_count.
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PARTICLE_MAX_ATTRACTORS 8
+
+typedef struct {
+    float x, y;
+    float vx, vy;
+    float age;
+    float inv_life;     // 1 / lifetime, so normalized age is a multiply
+    uint32_t emitter;
+} Particle;
+
+typedef struct {
+    AfferentEmitterDesc desc;
+    float spawn_accumulator;   // Fractional particles carried between steps
+    bool active;
+} Emitter;
+
+typedef struct {
+    float x, y;
+    float strength;
+    float softening2;
+} Attractor;
+
+struct AfferentParticleSystem {
+    Particle* particles;
+    uint32_t capacity;
+    uint32_t live;
+
+    Emitter* emitters;
+    uint32_t emitter_count;
+    uint32_t emitter_capacity;
+
+    Attractor attractors[PARTICLE_MAX_ATTRACTORS];
+    uint32_t attractor_count;
+
+    float gravity_x, gravity_y;
+    float drag;
+
+    uint64_t rng_state;
+    uint64_t total_spawned;
+    uint64_t total_died;
+    uint64_t total_dropped;    // Spawns that did not fit in capacity
+};
+
+// PCG32 (XSH-RR): small, fast and reproducible for a given seed
+static inline uint32_t pcg32_next(uint64_t* state) {
+    uint64_t old = *state;
+    *state = old * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+static inline float rand_unit(uint64_t* state) {
+    return (float)(pcg32_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline float rand_range(uint64_t* state, float lo, float hi) {
+    return lo + (hi - lo) * rand_unit(state);
+}
+
+static inline float lerpf(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+AfferentResult afferent_particle_system_create(uint32_t capacity, uint32_t seed,
+    AfferentParticleSystemRef* out) {
+    if (!out || capacity == 0) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    AfferentParticleSystemRef sys = calloc(1, sizeof(struct AfferentParticleSystem));
+    if (!sys) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    sys->particles = malloc((size_t)capacity * sizeof(Particle));
+    if (!sys->particles) {
+        free(sys);
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    sys->capacity = capacity;
+    sys->rng_state = (uint64_t)seed * 0x9E3779B97F4A7C15ULL + 1;
+    pcg32_next(&sys->rng_state);
+
+    *out = sys;
+    return AFFERENT_OK;
+}
+
+void afferent_particle_system_destroy(AfferentParticleSystemRef sys) {
+    if (sys) {
+        free(sys->particles);
+        free(sys->emitters);
+        free(sys);
+    }
+}
+
+void afferent_particle_system_clear(AfferentParticleSystemRef sys) {
+    sys->live = 0;
+    for (uint32_t i = 0; i < sys->emitter_count; i++) {
+        sys->emitters[i].spawn_accumulator = 0.0f;
+    }
+}
+
+uint32_t afferent_particle_system_live_count(AfferentParticleSystemRef sys) {
+    return sys->live;
+}
+
+uint32_t afferent_particle_system_capacity(AfferentParticleSystemRef sys) {
+    return sys->capacity;
+}
+
+void afferent_particle_system_get_stats(AfferentParticleSystemRef sys, AfferentParticleStats* out) {
+    if (!out) return;
+    out->live = sys->live;
+    out->total_spawned = sys->total_spawned;
+    out->total_died = sys->total_died;
+    out->total_dropped = sys->total_dropped;
+}
+
+// ============================================================================
+// Emitters and forces
+// ============================================================================
+
+int32_t afferent_particle_system_add_emitter(AfferentParticleSystemRef sys,
+    const AfferentEmitterDesc* desc) {
+    if (!sys || !desc) return -1;
+
+    if (sys->emitter_count == sys->emitter_capacity) {
+        uint32_t cap = sys->emitter_capacity ? sys->emitter_capacity * 2 : 4;
+        Emitter* grown = realloc(sys->emitters, (size_t)cap * sizeof(Emitter));
+        if (!grown) return -1;
+        sys->emitters = grown;
+        sys->emitter_capacity = cap;
+    }
+
+    Emitter* e = &sys->emitters[sys->emitter_count];
+    e->desc = *desc;
+    // Normalize ranges so spawning never sees inverted or zero lifetimes
+    if (e->desc.life_min < 1e-4f) e->desc.life_min = 1e-4f;
+    if (e->desc.life_max < e->desc.life_min) e->desc.life_max = e->desc.life_min;
+    if (e->desc.speed_max < e->desc.speed_min) e->desc.speed_max = e->desc.speed_min;
+    e->spawn_accumulator = 0.0f;
+    e->active = true;
+    return (int32_t)sys->emitter_count++;
+}
+
+void afferent_particle_system_set_emitter_position(AfferentParticleSystemRef sys,
+    uint32_t emitter, float x, float y) {
+    if (!sys || emitter >= sys->emitter_count) return;
+    sys->emitters[emitter].desc.x = x;
+    sys->emitters[emitter].desc.y = y;
+}
+
+void afferent_particle_system_set_emitter_rate(AfferentParticleSystemRef sys,
+    uint32_t emitter, float rate) {
+    if (!sys || emitter >= sys->emitter_count) return;
+    sys->emitters[emitter].desc.rate = rate > 0.0f ? rate : 0.0f;
+}
+
+void afferent_particle_system_set_emitter_active(AfferentParticleSystemRef sys,
+    uint32_t emitter, bool active) {
+    if (!sys || emitter >= sys->emitter_count) return;
+    sys->emitters[emitter].active = active;
+}
+
+void afferent_particle_system_set_gravity(AfferentParticleSystemRef sys, float gx, float gy) {
+    sys->gravity_x = gx;
+    sys->gravity_y = gy;
+}
+
+void afferent_particle_system_set_drag(AfferentParticleSystemRef sys, float drag) {
+    sys->drag = drag > 0.0f ? drag : 0.0f;
+}
+
+int32_t afferent_particle_system_add_attractor(AfferentParticleSystemRef sys,
+    float x, float y, float strength, float softening) {
+    if (!sys || sys->attractor_count >= PARTICLE_MAX_ATTRACTORS) return -1;
+    Attractor* a = &sys->attractors[sys->attractor_count];
+    a->x = x;
+    a->y = y;
+    a->strength = strength;
+    // Softening keeps the force finite when a particle passes through the center
+    a->softening2 = softening > 1e-3f ? softening * softening : 1e-6f;
+    return (int32_t)sys->attractor_count++;
+}
+
+void afferent_particle_system_set_attractor(AfferentParticleSystemRef sys,
+    uint32_t attractor, float x, float y, float strength) {
+    if (!sys || attractor >= sys->attractor_count) return;
+    sys->attractors[attractor].x = x;
+    sys->attractors[attractor].y = y;
+    sys->attractors[attractor].strength = strength;
+}
+
+void afferent_particle_system_clear_attractors(AfferentParticleSystemRef sys) {
+    sys->attractor_count = 0;
+}
+
+// ============================================================================
+// Spawning
+// ============================================================================
+
+static uint32_t spawn(AfferentParticleSystemRef sys, uint32_t emitter, uint32_t n) {
+    const AfferentEmitterDesc* d = &sys->emitters[emitter].desc;
+    uint32_t room = sys->capacity - sys->live;
+    uint32_t spawned = n < room ? n : room;
+    sys->total_dropped += n - spawned;
+
+    Particle* p = sys->particles + sys->live;
+    for (uint32_t i = 0; i < spawned; i++) {
+        float angle = d->angle + rand_range(&sys->rng_state, -d->spread, d->spread);
+        float speed = rand_range(&sys->rng_state, d->speed_min, d->speed_max);
+        float life = rand_range(&sys->rng_state, d->life_min, d->life_max);
+        p[i].x = d->x;
+        p[i].y = d->y;
+        p[i].vx = cosf(angle) * speed;
+        p[i].vy = sinf(angle) * speed;
+        p[i].age = 0.0f;
+        p[i].inv_life = 1.0f / life;
+        p[i].emitter = emitter;
+    }
+
+    sys->live += spawned;
+    sys->total_spawned += spawned;
+    return spawned;
+}
+
+uint32_t afferent_particle_system_burst(AfferentParticleSystemRef sys, uint32_t emitter, uint32_t count) {
+    if (!sys || emitter >= sys->emitter_count) return 0;
+    return spawn(sys, emitter, count);
+}
+
+static void emit_for_step(AfferentParticleSystemRef sys, float dt) {
+    for (uint32_t e = 0; e < sys->emitter_count; e++) {
+        Emitter* em = &sys->emitters[e];
+        if (!em->active || em->desc.rate <= 0.0f) continue;
+        em->spawn_accumulator += em->desc.rate * dt;
+        uint32_t n = (uint32_t)em->spawn_accumulator;
+        em->spawn_accumulator -= (float)n;
+        if (n > 0) spawn(sys, e, n);
+    }
+}
+
+// ============================================================================
+// Step: emit, age, integrate, compact, write
+// ============================================================================
+
+static inline void write_instance(AfferentParticleSystemRef sys, const Particle* p,
+    AfferentParticleLayout layout, float* out) {
+    const AfferentEmitterDesc* d = &sys->emitters[p->emitter].desc;
+    float t = p->age * p->inv_life;
+    if (t > 1.0f) t = 1.0f;
+    float size = lerpf(d->size_start, d->size_end, t);
+
+    if (layout == AFFERENT_PARTICLE_LAYOUT_CIRCLES) {
+        // DynamicCircleData: [x, y, hueBase, radius]
+        out[0] = p->x;
+        out[1] = p->y;
+        out[2] = lerpf(d->hue_start, d->hue_end, t);
+        out[3] = size;
+    } else {
+        // SpriteInstanceData: [x, y, rotation, halfSize, alpha]
+        out[0] = p->x;
+        out[1] = p->y;
+        out[2] = p->age * d->spin;
+        out[3] = size;
+        out[4] = lerpf(d->alpha_start, d->alpha_end, t);
+    }
+}
+
+uint32_t afferent_particle_layout_floats(AfferentParticleLayout layout) {
+    return layout == AFFERENT_PARTICLE_LAYOUT_CIRCLES ? 4 : 5;
+}
+
+uint32_t afferent_particle_system_step(
+    AfferentParticleSystemRef sys,
+    float dt,
+    float* out,
+    size_t out_capacity_floats,
+    AfferentParticleLayout layout
+) {
+    if (!sys) return 0;
+    if (dt < 0.0f) dt = 0.0f;
+
+    emit_for_step(sys, dt);
+
+    float gx = sys->gravity_x * dt;
+    float gy = sys->gravity_y * dt;
+    // Implicit linear drag: stable for any dt, exact decay as dt -> 0
+    float damp = 1.0f / (1.0f + sys->drag * dt);
+    uint32_t attractors = sys->attractor_count;
+    uint32_t stride = afferent_particle_layout_floats(layout);
+    size_t out_slots = out ? out_capacity_floats / stride : 0;
+
+    Particle* ps = sys->particles;
+    uint32_t live = sys->live;
+    uint32_t i = 0;
+    while (i < live) {
+        Particle* p = &ps[i];
+        p->age += dt;
+        if (p->age * p->inv_life >= 1.0f) {
+            // Swap-remove: move the last live particle into this slot and
+            // process it next without advancing i
+            *p = ps[--live];
+            sys->total_died++;
+            continue;
+        }
+
+        float vx = p->vx + gx;
+        float vy = p->vy + gy;
+        for (uint32_t a = 0; a < attractors; a++) {
+            const Attractor* at = &sys->attractors[a];
+            float dx = at->x - p->x;
+            float dy = at->y - p->y;
+            float d2 = dx * dx + dy * dy + at->softening2;
+            float f = at->strength * dt / (d2 * sqrtf(d2));
+            vx += dx * f;
+            vy += dy * f;
+        }
+        vx *= damp;
+        vy *= damp;
+        p->vx = vx;
+        p->vy = vy;
+        p->x += vx * dt;
+        p->y += vy * dt;
+
+        if (i < out_slots) {
+            write_instance(sys, p, layout, out + (size_t)i * stride);
+        }
+        i++;
+    }
+
+    sys->live = live;
+    return live;
+}
+
+uint32_t afferent_particle_system_write(
+    AfferentParticleSystemRef sys,
+    float* out,
+    size_t out_capacity_floats,
+    AfferentParticleLayout layout
+) {
+    if (!sys || !out) return 0;
+    uint32_t stride = afferent_particle_layout_floats(layout);
+    size_t slots = out_capacity_floats / stride;
+    uint32_t n = sys->live < slots ? sys->live : (uint32_t)slots;
+    for (uint32_t i = 0; i < n; i++) {
+        write_instance(sys, &sys->particles[i], layout, out + (size_t)i * stride);
+    }
+    return n;
+}
@@ -0,0 +1,463 @@
+/*
+ * Path tessellator - flatten, fill and stroke paths in native code
+ *
+ * A port of Afferent.Tessellation (pathToPolygonWithClosed, the Wang's formula
+ * flattener, convex fan fill, expandPolylineToStroke and
+ * strokeEdgesToTriangles) over plain double arrays, so tessellating a path
+ * allocates nothing per segment. Operations are kept in the same order as
+ * the Lean code, and the file is built with -ffp-contract=off so no
+ * multiply-add is fused, so the flattened points are bit-identical to the
+ * reference; only the float32 output narrowing differs.
+ */
+
+#include "afferent.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Tessellation.maxCurveSegments
+#define TESS_MAX_CURVE_SEGMENTS 4096u
+#define TESS_INLINE_POINTS 256
+
+typedef struct { double x, y; } TessPoint;
+
+// Growable point list with inline storage for typical paths
+typedef struct {
+    TessPoint* data;
+    size_t count;
+    size_t capacity;
+    bool failed;
+    TessPoint inline_data[TESS_INLINE_POINTS];
+} PointList;
+
+static void points_init(PointList* list) {
+    list->data = list->inline_data;
+    list->count = 0;
+    list->capacity = TESS_INLINE_POINTS;
+    list->failed = false;
+}
+
+static void points_free(PointList* list) {
+    if (list->data != list->inline_data) free(list->data);
+}
+
+static void points_push(PointList* list, double x, double y) {
+    if (list->count == list->capacity) {
+        if (list->failed) return;
+        size_t capacity = list->capacity * 2;
+        TessPoint* data = list->data == list->inline_data
+            ? malloc(capacity * sizeof(TessPoint))
+            : realloc(list->data, capacity * sizeof(TessPoint));
+        if (!data) {
+            list->failed = true;
+            return;
+        }
+        if (list->data == list->inline_data) memcpy(data, list->inline_data, list->count * sizeof(TessPoint));
+        list->data = data;
+        list->capacity = capacity;
+    }
+    list->data[list->count].x = x;
+    list->data[list->count].y = y;
+    list->count++;
+}
+
+static inline TessPoint pt(double x, double y) {
+    TessPoint p = { x, y };
+    return p;
+}
+
+static inline double lean_max(double a, double b) {
+    return a <= b ? b : a;
+}
+
+static inline double lean_min(double a, double b) {
+    return a <= b ? a : b;
+}
+
+// Float.toUInt32 semantics: saturating, NaN and negatives to 0
+static inline uint32_t lean_to_u32(double a) {
+    return 0.0 <= a ? (a < 4294967296.0 ? (uint32_t)a : UINT32_MAX) : 0;
+}
+
+// wangSegmentCount: ceil(sqrt(degree_factor * m / tolerance)) clamped to
+// [1, TESS_MAX_CURVE_SEGMENTS]
+static uint32_t wang_segment_count(double degree_factor, double m, double tolerance) {
+    uint32_t n = lean_to_u32(ceil(sqrt(degree_factor * m / tolerance)));
+    if (n < 1) return 1;
+    if (n > TESS_MAX_CURVE_SEGMENTS) return TESS_MAX_CURVE_SEGMENTS;
+    return n;
+}
+
+// Appends the flattened curve excluding p0 (flattenCubicBezier)
+static void flatten_cubic(PointList* out, TessPoint p0, TessPoint p1, TessPoint p2, TessPoint p3,
+    double tolerance) {
+    double sx = p0.x - 2.0 * p1.x + p2.x;
+    double sy = p0.y - 2.0 * p1.y + p2.y;
+    double tx = p1.x - 2.0 * p2.x + p3.x;
+    double ty = p1.y - 2.0 * p2.y + p3.y;
+    double m = lean_max(sqrt(sx * sx + sy * sy), sqrt(tx * tx + ty * ty));
+    uint32_t n = wang_segment_count(0.75, m, tolerance);
+    if (n > 1) {
+        double h = 1.0 / (double)n;
+        double h2 = h * h;
+        double h3 = h2 * h;
+        // B(t) = a t^3 + b t^2 + c t + p0
+        double ax = (p3.x - p0.x) + 3.0 * (p1.x - p2.x);
+        double ay = (p3.y - p0.y) + 3.0 * (p1.y - p2.y);
+        double bx = 3.0 * (p0.x - 2.0 * p1.x + p2.x);
+        double by = 3.0 * (p0.y - 2.0 * p1.y + p2.y);
+        double cx = 3.0 * (p1.x - p0.x);
+        double cy = 3.0 * (p1.y - p0.y);
+        double dx = ax * h3 + bx * h2 + cx * h;
+        double dy = ay * h3 + by * h2 + cy * h;
+        double ddx = 6.0 * ax * h3 + 2.0 * bx * h2;
+        double ddy = 6.0 * ay * h3 + 2.0 * by * h2;
+        double dddx = 6.0 * ax * h3;
+        double dddy = 6.0 * ay * h3;
+        double x = p0.x;
+        double y = p0.y;
+        for (uint32_t i = 1; i < n; i++) {
+            x = x + dx;
+            y = y + dy;
+            dx = dx + ddx;
+            dy = dy + ddy;
+            ddx = ddx + dddx;
+            ddy = ddy + dddy;
+            points_push(out, x, y);
+        }
+    }
+    points_push(out, p3.x, p3.y);
+}
+
+// flattenQuadraticBezier
+static void flatten_quadratic(PointList* out, TessPoint p0, TessPoint cp, TessPoint p2, double tolerance) {
+    double ax = p0.x - 2.0 * cp.x + p2.x;
+    double ay = p0.y - 2.0 * cp.y + p2.y;
+    uint32_t n = wang_segment_count(0.25, sqrt(ax * ax + ay * ay), tolerance);
+    if (n > 1) {
+        double h = 1.0 / (double)n;
+        double h2 = h * h;
+        double bx = 2.0 * (cp.x - p0.x);
+        double by = 2.0 * (cp.y - p0.y);
+        double dx = ax * h2 + bx * h;
+        double dy = ay * h2 + by * h;
+        double ddx = 2.0 * ax * h2;
+        double ddy = 2.0 * ay * h2;
+        double x = p0.x;
+        double y = p0.y;
+        for (uint32_t i = 1; i < n; i++) {
+            x = x + dx;
+            y = y + dy;
+            dx = dx + ddx;
+            dy = dy + ddy;
+            points_push(out, x, y);
+        }
+    }
+    points_push(out, p2.x, p2.y);
+}
+
+// ellipseArcSegmentCount: chords sized to the larger semi-axis (Transform.maxScale
+// of the axis matrix), at least one per quarter turn
+static uint32_t ellipse_arc_segment_count(TessPoint u, TessPoint v, double sweep, double tolerance) {
+    double p = u.x * u.x + u.y * u.y;
+    double q = v.x * v.x + v.y * v.y;
+    double r = u.x * v.x + u.y * v.y;
+    double half = (p - q) / 2.0;
+    double radius = sqrt((p + q) / 2.0 + sqrt(half * half + r * r));
+    double quarters = ceil(fabs(sweep) / (3.14159265358979323846 / 2.0));
+    double chords = radius > tolerance / 2.0
+        ? ceil(fabs(sweep) / (2.0 * acos(1.0 - tolerance / radius)))
+        : 0.0;
+    uint32_t n = lean_to_u32(quarters <= chords ? chords : quarters);
+    if (n < 1) return 1;
+    if (n > TESS_MAX_CURVE_SEGMENTS) return TESS_MAX_CURVE_SEGMENTS;
+    return n;
+}
+
+// Path.ellipsePoint
+static inline TessPoint ellipse_point(TessPoint c, TessPoint u, TessPoint v, double angle) {
+    double co = cos(angle);
+    double si = sin(angle);
+    return pt(c.x + u.x * co + v.x * si, c.y + u.y * co + v.y * si);
+}
+
+// flattenEllipseArc: appends the points after the start, snapping an end within
+// a millionth of the tolerance of close_to onto it. Returns the end point.
+static TessPoint flatten_ellipse_arc(PointList* out, TessPoint center, TessPoint u, TessPoint v,
+    double start_angle, double sweep, TessPoint close_to, double tolerance) {
+    uint32_t n = ellipse_arc_segment_count(u, v, sweep, tolerance);
+    TessPoint last = center;
+    for (uint32_t i = 1; i <= n; i++) {
+        double angle = start_angle + sweep * (double)i / (double)n;
+        last = ellipse_point(center, u, v, angle);
+        if (i == n) {
+            double snap = tolerance * 1e-6;
+            if (fabs(last.x - close_to.x) <= snap && fabs(last.y - close_to.y) <= snap) last = close_to;
+        }
+        points_push(out, last.x, last.y);
+    }
+    return last;
+}
+
+// Path.arcSweep
+static double arc_sweep(double start_angle, double end_angle, bool ccw) {
+    double two_pi = 2.0 * 3.14159265358979323846;
+    double sweep = end_angle - start_angle;
+    if (ccw) return sweep > 0 ? sweep - two_pi : sweep;
+    return sweep < 0 ? sweep + two_pi : sweep;
+}
+
+static inline TessPoint apply_transform(const double* t, double x, double y) {
+    if (!t) return pt(x, y);
+    return pt(t[0] * x + t[2] * y + t[4], t[1] * x + t[3] * y + t[5]);
+}
+
+static inline TessPoint apply_vector(const double* t, double x, double y) {
+    if (!t) return pt(x, y);
+    return pt(t[0] * x + t[2] * y, t[1] * x + t[3] * y);
+}
+
+// pathToPolygonWithClosed over the encoded stream. False if malformed.
+static bool flatten_path(const AfferentPathInput* path, PointList* out, bool* closed) {
+    const double* c = path->commands;
+    const double* t = path->transform;
+    size_t n = path->command_length;
+    size_t i = 0;
+    TessPoint current = pt(0, 0);
+    TessPoint subpath_start = pt(0, 0);
+    *closed = false;
+
+    while (i < n) {
+        double op_value = c[i++];
+        if (!(op_value >= 0 && op_value <= AFFERENT_PATH_ELLIPSE_ARC)) return false;
+        size_t operands;
+        switch ((AfferentPathOp)(int)op_value) {
+            case AFFERENT_PATH_MOVE_TO:
+            case AFFERENT_PATH_LINE_TO: operands = 2; break;
+            case AFFERENT_PATH_QUAD_TO: operands = 4; break;
+            case AFFERENT_PATH_CUBIC_TO: operands = 6; break;
+            case AFFERENT_PATH_ARC_TO: operands = 5; break;
+            case AFFERENT_PATH_ARC: operands = 6; break;
+            case AFFERENT_PATH_RECT: operands = 4; break;
+            case AFFERENT_PATH_ELLIPSE_ARC: operands = 8; break;
+            default: operands = 0; break;
+        }
+        if (n - i < operands) return false;
+        const double* a = c + i;
+        i += operands;
+
+        switch ((AfferentPathOp)(int)op_value) {
+            case AFFERENT_PATH_MOVE_TO: {
+                TessPoint p = apply_transform(t, a[0], a[1]);
+                current = p;
+                subpath_start = p;
+                points_push(out, p.x, p.y);
+                break;
+            }
+            case AFFERENT_PATH_LINE_TO: {
+                TessPoint p = apply_transform(t, a[0], a[1]);
+                current = p;
+                points_push(out, p.x, p.y);
+                break;
+            }
+            case AFFERENT_PATH_QUAD_TO: {
+                TessPoint cp = apply_transform(t, a[0], a[1]);
+                TessPoint p = apply_transform(t, a[2], a[3]);
+                flatten_quadratic(out, current, cp, p, path->tolerance);
+                current = p;
+                break;
+            }
+            case AFFERENT_PATH_CUBIC_TO: {
+                TessPoint cp1 = apply_transform(t, a[0], a[1]);
+                TessPoint cp2 = apply_transform(t, a[2], a[3]);
+                TessPoint p = apply_transform(t, a[4], a[5]);
+                flatten_cubic(out, current, cp1, cp2, p, path->tolerance);
+                current = p;
+                break;
+            }
+            case AFFERENT_PATH_ARC_TO: {
+                // Approximated by lines through p1 and p2, as in the Lean reference
+                TessPoint p1 = apply_transform(t, a[0], a[1]);
+                TessPoint p2 = apply_transform(t, a[2], a[3]);
+                points_push(out, p1.x, p1.y);
+                points_push(out, p2.x, p2.y);
+                current = p2;
+                break;
+            }
+            case AFFERENT_PATH_ARC: {
+                // Drawn as the transformed ellipse, as transformPath does
+                TessPoint center = apply_transform(t, a[0], a[1]);
+                TessPoint u = apply_vector(t, a[2], 0.0);
+                TessPoint v = apply_vector(t, 0.0, a[2]);
+                current = flatten_ellipse_arc(out, center, u, v, a[3], arc_sweep(a[3], a[4], a[5] != 0.0),
+                    subpath_start, path->tolerance);
+                break;
+            }
+            case AFFERENT_PATH_ELLIPSE_ARC: {
+                TessPoint center = apply_transform(t, a[0], a[1]);
+                TessPoint u = apply_vector(t, a[2], a[3]);
+                TessPoint v = apply_vector(t, a[4], a[5]);
+                current = flatten_ellipse_arc(out, center, u, v, a[6], a[7], subpath_start, path->tolerance);
+                break;
+            }
+            case AFFERENT_PATH_RECT: {
+                TessPoint o = apply_transform(t, a[0], a[1]);
+                double max_x = o.x + a[2];
+                double max_y = o.y + a[3];
+                points_push(out, o.x, o.y);
+                points_push(out, max_x, o.y);
+                points_push(out, max_x, max_y);
+                points_push(out, o.x, max_y);
+                current = o;
+                subpath_start = o;
+                *closed = true;
+                break;
+            }
+            case AFFERENT_PATH_CLOSE:
+                *closed = true;
+                current = subpath_start;
+                break;
+        }
+        if (out->failed) return false;
+    }
+    return true;
+}
+
+static inline void to_output(const AfferentPathInput* path, TessPoint p, float* v) {
+    if (path->ndc_width > 0 && path->ndc_height > 0) {
+        v[0] = (float)((p.x / path->ndc_width) * 2.0 - 1.0);
+        v[1] = (float)(1.0 - (p.y / path->ndc_height) * 2.0);
+    } else {
+        v[0] = (float)p.x;
+        v[1] = (float)p.y;
+    }
+}
+
+bool afferent_tessellate_fill_convex(const AfferentPathInput* path, const float* color,
+    AfferentVertexWriterRef out) {
+    if (afferent_vertex_writer_stride(out) != 6) return false;
+    PointList points;
+    points_init(&points);
+    bool closed;
+    bool ok = flatten_path(path, &points, &closed);
+    size_t count = points.count;
+    if (ok && count >= 3) {
+        ok = count <= UINT32_MAX / 3 &&
+            afferent_vertex_writer_reserve(out, (uint32_t)count, (uint32_t)((count - 2) * 3));
+        if (ok) {
+            afferent_vertex_writer_begin_shape(out);
+            float* v = afferent_vertex_writer_emit_vertices(out, (uint32_t)count);
+            for (size_t i = 0; i < count; i++, v += 6) {
+                to_output(path, points.data[i], v);
+                memcpy(v + 2, color, 4 * sizeof(float));
+            }
+            for (uint32_t i = 1; i + 1 < count; i++) {
+                afferent_vertex_writer_emit_tri(out, 0, i, i + 1);
+            }
+        }
+    }
+    points_free(&points);
+    return ok;
+}
+
+static inline TessPoint normalize(double dx, double dy) {
+    double len = sqrt(dx * dx + dy * dy);
+    if (len < 0.0001) return pt(0, 0);
+    return pt(dx / len, dy / len);
+}
+
+// Cap point pair at p; `extend` is -1 (start), 0 (none) or +1 (end)
+static void push_cap(PointList* left, PointList* right, TessPoint p, TessPoint dir, TessPoint normal,
+    double hw, AfferentLineCap cap, double extend) {
+    if (cap == AFFERENT_LINE_CAP_SQUARE) {
+        double bx = extend < 0 ? p.x - dir.x * hw : p.x + dir.x * hw;
+        double by = extend < 0 ? p.y - dir.y * hw : p.y + dir.y * hw;
+        points_push(left, bx + normal.x * hw, by + normal.y * hw);
+        points_push(right, bx - normal.x * hw, by - normal.y * hw);
+    } else {
+        // Round caps are drawn as butt caps, as in the Lean reference
+        points_push(left, p.x + normal.x * hw, p.y + normal.y * hw);
+        points_push(right, p.x - normal.x * hw, p.y - normal.y * hw);
+    }
+}
+
+// expandPolylineToStroke
+static void expand_stroke(const PointList* points, double hw, const AfferentStrokeParams* s,
+    PointList* left, PointList* right) {
+    size_t n = points->count;
+    if (n < 2) return;
+    const TessPoint* p = points->data;
+    for (size_t i = 0; i < n; i++) {
+        if (i == 0) {
+            TessPoint dir = normalize(p[1].x - p[0].x, p[1].y - p[0].y);
+            TessPoint normal = pt(-dir.y, dir.x);
+            push_cap(left, right, p[0], dir, normal, hw, s->cap, -1);
+        } else if (i == n - 1) {
+            TessPoint dir = normalize(p[i].x - p[i - 1].x, p[i].y - p[i - 1].y);
+            TessPoint normal = pt(-dir.y, dir.x);
+            push_cap(left, right, p[i], dir, normal, hw, s->cap, 1);
+        } else {
+            TessPoint dir1 = normalize(p[i].x - p[i - 1].x, p[i].y - p[i - 1].y);
+            TessPoint dir2 = normalize(p[i + 1].x - p[i].x, p[i + 1].y - p[i].y);
+            TessPoint n1 = pt(-dir1.y, dir1.x);
+            TessPoint n2 = pt(-dir2.y, dir2.x);
+            TessPoint avg = normalize((n1.x + n2.x) / 2.0, (n1.y + n2.y) / 2.0);
+            double dot = dir1.x * dir2.x + dir1.y * dir2.y;
+            double miter_scale = dot > -0.999 ? 1.0 / sqrt((1.0 + dot) / 2.0) : s->miter_limit;
+            if (s->join == AFFERENT_LINE_JOIN_BEVEL) {
+                points_push(left, p[i].x + n1.x * hw, p[i].y + n1.y * hw);
+                points_push(left, p[i].x + n2.x * hw, p[i].y + n2.y * hw);
+                points_push(right, p[i].x - n1.x * hw, p[i].y - n1.y * hw);
+                points_push(right, p[i].x - n2.x * hw, p[i].y - n2.y * hw);
+            } else {
+                // Round joins are drawn as miters, as in the Lean reference
+                double scale = lean_min(miter_scale, s->miter_limit);
+                points_push(left, p[i].x + avg.x * hw * scale, p[i].y + avg.y * hw * scale);
+                points_push(right, p[i].x - avg.x * hw * scale, p[i].y - avg.y * hw * scale);
+            }
+        }
+    }
+}
+
+bool afferent_tessellate_stroke(const AfferentPathInput* path, const AfferentStrokeParams* stroke,
+    AfferentVertexWriterRef out) {
+    if (afferent_vertex_writer_stride(out) != 6) return false;
+    PointList points, left, right;
+    points_init(&points);
+    points_init(&left);
+    points_init(&right);
+    bool closed;
+    bool ok = flatten_path(path, &points, &closed);
+    if (ok && points.count >= 2) {
+        if (closed) points_push(&points, points.data[0].x, points.data[0].y);
+        expand_stroke(&points, stroke->line_width / 2.0, stroke, &left, &right);
+        ok = !points.failed && !left.failed && !right.failed;
+    }
+    // strokeEdgesToTriangles
+    size_t pairs = left.count < right.count ? left.count : right.count;
+    if (ok && left.count >= 2 && right.count >= 2) {
+        ok = pairs <= UINT32_MAX / 6 &&
+            afferent_vertex_writer_reserve(out, (uint32_t)(pairs * 2), (uint32_t)((pairs - 1) * 6));
+        if (ok) {
+            afferent_vertex_writer_begin_shape(out);
+            float* v = afferent_vertex_writer_emit_vertices(out, (uint32_t)(pairs * 2));
+            for (size_t i = 0; i < pairs; i++) {
+                to_output(path, left.data[i], v);
+                memcpy(v + 2, stroke->color, 4 * sizeof(float));
+                v += 6;
+                to_output(path, right.data[i], v);
+                memcpy(v + 2, stroke->color, 4 * sizeof(float));
+                v += 6;
+            }
+            for (uint32_t i = 0; i + 1 < pairs; i++) {
+                uint32_t base = i * 2;
+                afferent_vertex_writer_emit_tri(out, base, base + 1, base + 2);
+                afferent_vertex_writer_emit_tri(out, base + 1, base + 3, base + 2);
+            }
+        }
+    }
+    points_free(&points);
+    points_free(&left);
+    points_free(&right);
+    return ok;
+}
@@ -0,0 +1,1246 @@
+/*
+ * Polygon triangulator - fills of concave, holed and self-intersecting paths
+ *
+ * Two strategies over the same flattened contours:
+ *  - ear clipping (after Mapbox earcut) when no two edges cross or touch and
+ *    every contour separates filled from unfilled area under the fill rule:
+ *    each outer ring gets its holes bridged in, and on rings over 80 points
+ *    the reflex vertices (the only ones that can block an ear) are bucketed
+ *    in a grid, so an ear test only visits the cells under its triangle.
+ *    Emits input points only, n - 2 triangles per simple ring.
+ *  - a Bentley-Ottmann sweep for everything else (crossing edges, touching
+ *    rings, same-direction nested rings under nonzero). Edges are kept in x
+ *    order along the sweep line, crossings are found between neighbours and
+ *    queued as events, and the spans the fill rule selects become
+ *    trapezoids, kept open while their two bounding edges stay neighbours,
+ *    so a tall span costs one trapezoid rather than one per event.
+ * The sweep's crossing test (run in check mode) decides which applies. Both
+ * are O((n + k) log n) for n points and k crossings on typical outlines.
+ */
+
+#include "afferent.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Rings with more points than this get a reflex-vertex grid
+#define TRI_HASH_THRESHOLD 80
+// Ring nesting is found by pairwise point-in-ring tests; past this many
+// rings the sweep is used instead
+#define TRI_MAX_CLASSIFIED_RINGS 256
+// Sweep event budget, per pair of edges
+#define TRI_SWEEP_EVENTS_PER_PAIR 4
+
+typedef struct { double x, y; } TriPoint;
+
+typedef struct { uint32_t start, end; } TriRing;
+
+// Growable output buffers
+typedef struct {
+    double* points;
+    uint32_t point_count;
+    uint32_t point_capacity;
+    uint32_t* indices;
+    uint32_t index_count;
+    uint32_t index_capacity;
+    bool failed;
+} TriBuffer;
+
+static bool grow(void** data, uint32_t* capacity, uint32_t needed, size_t element) {
+    if (needed <= *capacity) return true;
+    uint32_t next = *capacity ? *capacity : 64;
+    while (next < needed) {
+        if (next > UINT32_MAX / 2) return false;
+        next *= 2;
+    }
+    void* grown = realloc(*data, (size_t)next * element);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = next;
+    return true;
+}
+
+static uint32_t push_point(TriBuffer* b, double x, double y) {
+    if (b->failed) return 0;
+    if (!grow((void**)&b->points, &b->point_capacity, (b->point_count + 1) * 2, sizeof(double))) {
+        b->failed = true;
+        return 0;
+    }
+    b->points[b->point_count * 2] = x;
+    b->points[b->point_count * 2 + 1] = y;
+    return b->point_count++;
+}
+
+static void push_triangle(TriBuffer* b, uint32_t i0, uint32_t i1, uint32_t i2) {
+    if (b->failed) return;
+    if (!grow((void**)&b->indices, &b->index_capacity, b->index_count + 3, sizeof(uint32_t))) {
+        b->failed = true;
+        return;
+    }
+    b->indices[b->index_count++] = i0;
+    b->indices[b->index_count++] = i1;
+    b->indices[b->index_count++] = i2;
+}
+
+// Inputs are checked finite up front, so plain comparisons do (fmin and
+// fmax are library calls unless NaN handling is relaxed)
+static inline double min_d(double a, double b) { return a < b ? a : b; }
+static inline double max_d(double a, double b) { return a > b ? a : b; }
+
+static inline bool fill_rule_inside(AfferentFillRule rule, int32_t winding) {
+    return rule == AFFERENT_FILL_RULE_EVENODD ? (winding & 1) != 0 : winding != 0;
+}
+
+// ============================================================================
+// Ear clipping (port of earcut: linked rings, hole bridges, reflex grid)
+// ============================================================================
+
+typedef struct EarNode EarNode;
+struct EarNode {
+    double x, y;
+    uint32_t i;
+    uint32_t lap;            // Id of the lap the node is queued for
+    bool steiner;
+    bool removed;
+    EarNode* prev;
+    EarNode* next;
+};
+
+typedef struct {
+    const TriPoint* points;
+    EarNode* nodes;          // Pool sized up front: points + 2 per hole bridge
+    uint32_t node_count;
+    TriBuffer* out;
+    EarNode** lap_nodes;     // Ear candidates of this lap and the next, each
+    EarNode** next_nodes;    // sized like the pool
+    uint32_t lap_id;
+    // Reflex-vertex grid; cols == 0 when the ring is small enough to scan
+    uint32_t cols, rows;
+    double min_x, min_y;
+    double inv_cell_w, inv_cell_h;
+    uint32_t* cell_start;    // cols * rows + 1 offsets into cell_nodes
+    EarNode** cell_nodes;
+} EarContext;
+
+static EarNode* insert_node(EarContext* c, uint32_t i, EarNode* last) {
+    EarNode* p = &c->nodes[c->node_count++];
+    p->x = c->points[i].x;
+    p->y = c->points[i].y;
+    p->i = i;
+    p->lap = 0;
+    p->steiner = false;
+    p->removed = false;
+    if (!last) {
+        p->prev = p;
+        p->next = p;
+    } else {
+        p->next = last->next;
+        p->prev = last;
+        last->next->prev = p;
+        last->next = p;
+    }
+    return p;
+}
+
+static void remove_node(EarNode* p) {
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+    p->removed = true;
+}
+
+static inline bool same_point(const EarNode* a, const EarNode* b) {
+    return a->x == b->x && a->y == b->y;
+}
+
+// Twice the signed area of p, q, r; positive is a reflex turn for ear tests
+static inline double turn(const EarNode* p, const EarNode* q, const EarNode* r) {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+static inline bool point_in_triangle(double ax, double ay, double bx, double by,
+                                     double cx, double cy, double px, double py) {
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+           (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+static inline bool point_in_triangle_except_first(double ax, double ay, double bx, double by,
+                                                  double cx, double cy, double px, double py) {
+    return !(ax == px && ay == py) && point_in_triangle(ax, ay, bx, by, cx, cy, px, py);
+}
+
+// Ring area in earcut's orientation convention
+static double ring_area(const TriPoint* points, TriRing ring) {
+    double sum = 0.0;
+    uint32_t j = ring.end - 1;
+    for (uint32_t i = ring.start; i < ring.end; i++) {
+        sum += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+        j = i;
+    }
+    return sum;
+}
+
+static EarNode* linked_ring(EarContext* c, TriRing ring, bool clockwise) {
+    EarNode* last = NULL;
+    if (clockwise == (ring_area(c->points, ring) > 0)) {
+        for (uint32_t i = ring.start; i < ring.end; i++) last = insert_node(c, i, last);
+    } else {
+        for (uint32_t i = ring.end; i-- > ring.start;) last = insert_node(c, i, last);
+    }
+    if (last && same_point(last, last->next)) {
+        remove_node(last);
+        last = last->next;
+    }
+    return last;
+}
+
+// Drop duplicate and collinear points between start and end
+static EarNode* filter_points(EarNode* start, EarNode* end) {
+    if (!start) return start;
+    if (!end) end = start;
+    EarNode* p = start;
+    bool again;
+    do {
+        again = false;
+        if (!p->steiner && (same_point(p, p->next) || turn(p->prev, p, p->next) == 0)) {
+            remove_node(p);
+            p = end = p->prev;
+            if (p == p->next) break;
+            again = true;
+        } else {
+            p = p->next;
+        }
+    } while (again || p != end);
+    return end;
+}
+
+static inline uint32_t grid_col(const EarContext* c, double x) {
+    double k = (x - c->min_x) * c->inv_cell_w;
+    return k <= 0 ? 0 : (k >= c->cols ? c->cols - 1 : (uint32_t)k);
+}
+
+static inline uint32_t grid_row(const EarContext* c, double y) {
+    double k = (y - c->min_y) * c->inv_cell_h;
+    return k <= 0 ? 0 : (k >= c->rows ? c->rows - 1 : (uint32_t)k);
+}
+
+static inline uint32_t grid_cell(const EarContext* c, uint32_t col, uint32_t row) {
+    return row * c->cols + col;
+}
+
+// Bucket the ring's reflex vertices into a grid of about one per cell.
+// Only reflex vertices can block an ear, and clipping never turns a convex
+// vertex reflex, so the grid stays a superset until the ring is refiltered.
+static bool index_reflex(EarContext* c, EarNode* start) {
+    c->cols = 0;
+    uint32_t count = 0, reflex = 0;
+    double min_x = start->x, max_x = min_x, min_y = start->y, max_y = min_y;
+    EarNode* p = start;
+    do {
+        count++;
+        if (turn(p->prev, p, p->next) >= 0) reflex++;
+        min_x = min_d(min_x, p->x);
+        max_x = max_d(max_x, p->x);
+        min_y = min_d(min_y, p->y);
+        max_y = max_d(max_y, p->y);
+        p = p->next;
+    } while (p != start);
+    if (count <= TRI_HASH_THRESHOLD) return true;
+
+    double w = max_d(max_x - min_x, DBL_MIN);
+    double h = max_d(max_y - min_y, DBL_MIN);
+    uint32_t cols = 1, rows = 1;
+    if (reflex > 0) {
+        double fit = ceil(sqrt((double)reflex * w / h));
+        cols = fit < 1 ? 1 : (fit > reflex ? reflex : (uint32_t)fit);
+        rows = (reflex + cols - 1) / cols;
+    }
+    uint32_t cells = cols * rows;
+    uint32_t* cell_start = realloc(c->cell_start, ((size_t)cells + 1) * sizeof(uint32_t));
+    if (!cell_start) return false;
+    c->cell_start = cell_start;
+    EarNode** cell_nodes = realloc(c->cell_nodes, ((size_t)reflex + 1) * sizeof(EarNode*));
+    if (!cell_nodes) return false;
+    c->cell_nodes = cell_nodes;
+    c->cols = cols;
+    c->rows = rows;
+    c->min_x = min_x;
+    c->min_y = min_y;
+    c->inv_cell_w = cols / w;
+    c->inv_cell_h = rows / h;
+
+    // Counting sort of the reflex vertices by cell
+    memset(cell_start, 0, ((size_t)cells + 1) * sizeof(uint32_t));
+    p = start;
+    do {
+        if (turn(p->prev, p, p->next) >= 0) {
+            cell_start[grid_cell(c, grid_col(c, p->x), grid_row(c, p->y)) + 1]++;
+        }
+        p = p->next;
+    } while (p != start);
+    for (uint32_t k = 0; k < cells; k++) cell_start[k + 1] += cell_start[k];
+    p = start;
+    do {
+        if (turn(p->prev, p, p->next) >= 0) {
+            uint32_t cell = grid_cell(c, grid_col(c, p->x), grid_row(c, p->y));
+            cell_nodes[cell_start[cell]++] = p;
+        }
+        p = p->next;
+    } while (p != start);
+    for (uint32_t k = cells; k > 0; k--) cell_start[k] = cell_start[k - 1];
+    cell_start[0] = 0;
+    return true;
+}
+
+static bool is_ear(const EarNode* ear) {
+    const EarNode* a = ear->prev;
+    const EarNode* b = ear;
+    const EarNode* c = ear->next;
+    if (turn(a, b, c) >= 0) return false;
+
+    double x0 = min_d(a->x, min_d(b->x, c->x)), y0 = min_d(a->y, min_d(b->y, c->y));
+    double x1 = max_d(a->x, max_d(b->x, c->x)), y1 = max_d(a->y, max_d(b->y, c->y));
+    for (const EarNode* p = c->next; p != a; p = p->next) {
+        if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+            point_in_triangle_except_first(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+            turn(p->prev, p, p->next) >= 0) return false;
+    }
+    return true;
+}
+
+// Widen [lo, hi] by the x extent of segment pq within y0 <= y <= y1
+static void triangle_band_x(const EarNode* p, const EarNode* q, double y0, double y1,
+                            double* lo, double* hi) {
+    if (max_d(p->y, q->y) < y0 || min_d(p->y, q->y) > y1) return;
+    double xa = p->x, xb = q->x;
+    if (p->y != q->y) {
+        double dxdy = (q->x - p->x) / (q->y - p->y);
+        double top = min_d(p->y, q->y), bottom = max_d(p->y, q->y);
+        xa = p->x + (min_d(max_d(y0, top), bottom) - p->y) * dxdy;
+        xb = p->x + (min_d(max_d(y1, top), bottom) - p->y) * dxdy;
+    }
+    *lo = min_d(*lo, min_d(xa, xb));
+    *hi = max_d(*hi, max_d(xa, xb));
+}
+
+static bool is_ear_indexed(const EarContext* ctx, const EarNode* ear) {
+    const EarNode* a = ear->prev;
+    const EarNode* b = ear;
+    const EarNode* c = ear->next;
+    if (turn(a, b, c) >= 0) return false;
+
+    double x0 = min_d(a->x, min_d(b->x, c->x)), y0 = min_d(a->y, min_d(b->y, c->y));
+    double x1 = max_d(a->x, max_d(b->x, c->x)), y1 = max_d(a->y, max_d(b->y, c->y));
+    uint32_t row0 = grid_row(ctx, y0), row1 = grid_row(ctx, y1);
+    double cell_h = 1.0 / ctx->inv_cell_h;
+    for (uint32_t row = row0; row <= row1; row++) {
+        // Only the columns the triangle spans within this row (plus one each
+        // side, so points on an edge survive rounding at cell borders)
+        double band_lo = max_d(y0, ctx->min_y + (row - 0.5) * cell_h);
+        double band_hi = min_d(y1, ctx->min_y + (row + 1.5) * cell_h);
+        double lo = INFINITY, hi = -INFINITY;
+        triangle_band_x(a, b, band_lo, band_hi, &lo, &hi);
+        triangle_band_x(b, c, band_lo, band_hi, &lo, &hi);
+        triangle_band_x(c, a, band_lo, band_hi, &lo, &hi);
+        if (lo > hi) continue;
+        uint32_t col0 = grid_col(ctx, lo), col1 = grid_col(ctx, hi);
+        if (col0 > 0) col0--;
+        if (col1 + 1 < ctx->cols) col1++;
+        for (uint32_t col = col0; col <= col1; col++) {
+            uint32_t cell = grid_cell(ctx, col, row);
+            for (uint32_t k = ctx->cell_start[cell]; k < ctx->cell_start[cell + 1]; k++) {
+                const EarNode* p = ctx->cell_nodes[k];
+                if (!p->removed && p != a && p != b && p != c &&
+                    p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+                    point_in_triangle_except_first(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                    turn(p->prev, p, p->next) >= 0) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static inline void queue_for_lap(EarContext* c, EarNode* p, uint32_t id, uint32_t* count) {
+    if (p->lap == id) return;
+    p->lap = id;
+    c->next_nodes[(*count)++] = p;
+}
+
+// Clip ears lap by lap until two nodes remain. As in earcut, the neighbours
+// of a clipped ear are skipped for the rest of the lap; they make up the next
+// lap, so each lap only retests triangles that changed. When a lap clips
+// nothing the whole ring is retried (a blocking reflex vertex elsewhere may
+// have turned convex). A whole-ring lap that clips nothing filters
+// degenerate points and retries once; a second stall reports failure and
+// the caller falls back to the sweep.
+static bool earcut_linked(EarContext* c, EarNode* ear, int pass) {
+    if (!ear) return true;
+    if (!index_reflex(c, ear)) return false;
+
+    uint32_t size = 0;
+    uint32_t id = ++c->lap_id;
+    uint32_t lap_count = 0;
+    bool whole_ring = true;
+    EarNode* p = ear;
+    do {
+        p->lap = id;
+        c->lap_nodes[lap_count++] = p;
+        size++;
+        p = p->next;
+    } while (p != ear);
+
+    while (size > 2) {
+        uint32_t next_id = ++c->lap_id;
+        uint32_t next_count = 0;
+        for (uint32_t k = 0; k < lap_count && size > 2; k++) {
+            EarNode* e = c->lap_nodes[k];
+            if (e->removed || e->lap != id) continue;
+            if (c->cols != 0 ? is_ear_indexed(c, e) : is_ear(e)) {
+                EarNode* prev = e->prev;
+                EarNode* next = e->next;
+                push_triangle(c->out, prev->i, e->i, next->i);
+                remove_node(e);
+                size--;
+                queue_for_lap(c, prev, next_id, &next_count);
+                queue_for_lap(c, next, next_id, &next_count);
+                ear = next;
+            }
+        }
+        if (size <= 2) break;
+        if (next_count == 0) {
+            if (whole_ring) {
+                if (pass == 0) return earcut_linked(c, filter_points(ear, NULL), 1);
+                return false;
+            }
+            p = ear;
+            do {
+                queue_for_lap(c, p, next_id, &next_count);
+                p = p->next;
+            } while (p != ear);
+        }
+        whole_ring = next_count == size;
+        EarNode** swap = c->lap_nodes;
+        c->lap_nodes = c->next_nodes;
+        c->next_nodes = swap;
+        lap_count = next_count;
+        id = next_id;
+    }
+    return true;
+}
+
+static bool locally_inside(const EarNode* a, const EarNode* b) {
+    return turn(a->prev, a, a->next) < 0
+        ? turn(a, b, a->next) >= 0 && turn(a, a->prev, b) >= 0
+        : turn(a, b, a->prev) < 0 || turn(a, a->next, b) < 0;
+}
+
+static bool sector_contains_sector(const EarNode* m, const EarNode* p) {
+    return turn(m->prev, m, p->prev) < 0 && turn(p->next, m, m->next) < 0;
+}
+
+// Outer-ring vertex visible from the hole's leftmost point
+static EarNode* find_hole_bridge(EarNode* hole, EarNode* outer) {
+    EarNode* p = outer;
+    double hx = hole->x, hy = hole->y;
+    double qx = -INFINITY;
+    EarNode* m = NULL;
+
+    // Nearest outer edge hit by a ray from the hole point to the left
+    do {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if (x <= hx && x > qx) {
+                qx = x;
+                m = p->x < p->next->x ? p : p->next;
+                if (x == hx) return m;
+            }
+        }
+        p = p->next;
+    } while (p != outer);
+    if (!m) return NULL;
+
+    // Reflex points inside the triangle (hole, hit, m) can block the bridge;
+    // take the one with the smallest angle to the ray instead
+    EarNode* stop = m;
+    double mx = m->x, my = m->y;
+    double tan_min = INFINITY;
+    p = m;
+    do {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+            double tan = fabs(hy - p->y) / (hx - p->x);
+            if (locally_inside(p, hole) &&
+                (tan < tan_min || (tan == tan_min &&
+                    (p->x > m->x || (p->x == m->x && sector_contains_sector(m, p)))))) {
+                m = p;
+                tan_min = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+    return m;
+}
+
+// Join two rings with a doubled edge a-b; returns the copy of b
+static EarNode* split_polygon(EarContext* c, EarNode* a, EarNode* b) {
+    EarNode* a2 = &c->nodes[c->node_count++];
+    EarNode* b2 = &c->nodes[c->node_count++];
+    *a2 = *a;
+    *b2 = *b;
+    a2->steiner = b2->steiner = false;
+    EarNode* an = a->next;
+    EarNode* bp = b->prev;
+    a->next = b;
+    b->prev = a;
+    a2->next = an;
+    an->prev = a2;
+    b2->next = a2;
+    a2->prev = b2;
+    bp->next = b2;
+    b2->prev = bp;
+    return b2;
+}
+
+static EarNode* leftmost(EarNode* start) {
+    EarNode* p = start;
+    EarNode* best = start;
+    do {
+        if (p->x < best->x || (p->x == best->x && p->y < best->y)) best = p;
+        p = p->next;
+    } while (p != start);
+    return best;
+}
+
+static int compare_node_x(const void* a, const void* b) {
+    const EarNode* p = *(const EarNode* const*)a;
+    const EarNode* q = *(const EarNode* const*)b;
+    if (p->x != q->x) return p->x < q->x ? -1 : 1;
+    if (p->y != q->y) return p->y < q->y ? -1 : 1;
+    return 0;
+}
+
+// Bridge holes into the outer ring, left to right. NULL if a hole has no
+// visible outer vertex (it was not inside after all).
+static EarNode* eliminate_holes(EarContext* c, const TriRing* holes, uint32_t hole_count,
+                                EarNode* outer, EarNode** queue) {
+    for (uint32_t h = 0; h < hole_count; h++) {
+        EarNode* list = linked_ring(c, holes[h], false);
+        if (list == list->next) list->steiner = true;
+        queue[h] = leftmost(list);
+    }
+    qsort(queue, hole_count, sizeof(EarNode*), compare_node_x);
+    for (uint32_t h = 0; h < hole_count; h++) {
+        EarNode* bridge = find_hole_bridge(queue[h], outer);
+        if (!bridge) return NULL;
+        EarNode* reverse = split_polygon(c, bridge, queue[h]);
+        filter_points(reverse, reverse->next);
+        outer = filter_points(bridge, bridge->next);
+    }
+    return outer;
+}
+
+// Triangulate one outer ring and its holes into out
+static bool earcut_group(EarContext* c, TriRing outer_ring, const TriRing* holes,
+                         uint32_t hole_count, EarNode** queue) {
+    EarNode* outer = linked_ring(c, outer_ring, true);
+    if (!outer || outer->next == outer->prev) return true;
+    if (hole_count > 0) {
+        outer = eliminate_holes(c, holes, hole_count, outer, queue);
+        if (!outer) return false;
+    }
+
+    return earcut_linked(c, outer, 0);
+}
+
+// ============================================================================
+// Ring classification: may the rings be ear clipped under this fill rule?
+// ============================================================================
+
+static bool point_in_ring(const TriPoint* points, TriRing ring, TriPoint q) {
+    bool inside = false;
+    uint32_t j = ring.end - 1;
+    for (uint32_t i = ring.start; i < ring.end; i++) {
+        TriPoint a = points[i], b = points[j];
+        if ((a.y > q.y) != (b.y > q.y) &&
+            q.x < (b.x - a.x) * (q.y - a.y) / (b.y - a.y) + a.x) inside = !inside;
+        j = i;
+    }
+    return inside;
+}
+
+// Given rings that neither cross nor touch, find each ring's parent (the
+// innermost ring containing it) and whether it bounds filled area from
+// inside (outer) or from outside (hole). False when some ring has the same
+// fill on both sides, e.g. a same-direction ring nested under nonzero.
+static bool classify_rings(const TriPoint* points, const TriRing* rings, uint32_t ring_count,
+                           AfferentFillRule rule, int32_t* parent, bool* outer) {
+    if (ring_count > TRI_MAX_CLASSIFIED_RINGS) return false;
+    int32_t direction[TRI_MAX_CLASSIFIED_RINGS];
+    uint32_t depth[TRI_MAX_CLASSIFIED_RINGS];
+    uint8_t* contains = calloc((size_t)ring_count * ring_count, 1);
+    if (!contains) return false;
+
+    for (uint32_t k = 0; k < ring_count; k++) {
+        double area = -ring_area(points, rings[k]);
+        direction[k] = area > 0 ? 1 : (area < 0 ? -1 : 0);
+        depth[k] = 0;
+    }
+    for (uint32_t k = 0; k < ring_count; k++) {
+        for (uint32_t j = 0; j < ring_count; j++) {
+            if (j != k && point_in_ring(points, rings[j], points[rings[k].start])) {
+                contains[j * ring_count + k] = 1;
+                depth[k]++;
+            }
+        }
+    }
+
+    bool ok = true;
+    for (uint32_t k = 0; k < ring_count && ok; k++) {
+        int32_t winding_outside = 0;
+        parent[k] = -1;
+        for (uint32_t j = 0; j < ring_count; j++) {
+            if (!contains[j * ring_count + k]) continue;
+            winding_outside += direction[j];
+            if (parent[k] < 0 || depth[j] > depth[parent[k]]) parent[k] = (int32_t)j;
+        }
+        bool filled_outside = fill_rule_inside(rule, winding_outside);
+        bool filled_inside = fill_rule_inside(rule, winding_outside + direction[k]);
+        ok = direction[k] != 0 && filled_inside != filled_outside;
+        outer[k] = filled_inside;
+    }
+    free(contains);
+    return ok;
+}
+
+// ============================================================================
+// Sweep (Bentley-Ottmann style: a treap of the edges crossing the sweep line
+// in x order, vertex events in (y, x) order and a heap of crossing events)
+// ============================================================================
+
+#define SWEEP_NIL UINT32_MAX
+
+typedef struct {
+    double xt, yt;           // Upper endpoint (smaller y)
+    double xb, yb;
+    double dxdy;
+    uint32_t vt, vb;         // Point indices of the endpoints
+    int32_t winding;         // +1 for downward edges, -1 for upward
+    int32_t right_winding;   // Winding number just right of the edge
+    uint32_t partner;        // Right edge of the open span this edge bounds
+    double span_top;
+    uint32_t left, right, parent, priority;   // Status treap links
+} SweepEdge;
+
+typedef struct {
+    double y, x;
+    uint32_t i;
+} SweepVertex;
+
+typedef struct {
+    double y, x;
+    double reach;            // x distance at which edges count as passing through
+} SweepEvent;
+
+typedef struct {
+    SweepEdge* edges;
+    uint32_t edge_count;
+    SweepVertex* vertices;   // Sorted by (y, x)
+    uint32_t vertex_count;
+    uint32_t* starts;        // Two slots per point: edges whose upper end it is
+    uint32_t* group;         // Scratch: edges through the current event point
+    uint32_t* pending;       // Scratch: edges to insert below it
+    SweepEvent* heap;
+    uint32_t heap_count;
+    uint32_t heap_capacity;
+    uint32_t root;
+    uint32_t seed;
+    double eps;
+    double y, x;             // Current event point
+} Sweep;
+
+static int compare_vertices(const void* a, const void* b) {
+    const SweepVertex* p = a;
+    const SweepVertex* q = b;
+    if (p->y != q->y) return p->y < q->y ? -1 : 1;
+    if (p->x != q->x) return p->x < q->x ? -1 : 1;
+    return 0;
+}
+
+static inline bool event_before(double ya, double xa, double yb, double xb) {
+    return ya < yb || (ya == yb && xa < xb);
+}
+
+static void sweep_free(Sweep* s) {
+    free(s->edges);
+    free(s->vertices);
+    free(s->starts);
+    free(s->group);
+    free(s->pending);
+    free(s->heap);
+}
+
+static inline bool is_flat(const SweepEdge* e) {
+    return e->dxdy == INFINITY;
+}
+
+// Where an edge meets the sweep line at height y. Events on one row are
+// taken left to right, as if the plane were sheared by an infinitesimal
+// y += d * x: a horizontal edge then runs steeply down to the right and
+// meets the sweep line at the current event's x while that lies on it.
+static inline double edge_x(const Sweep* s, const SweepEdge* e, double y) {
+    if (is_flat(e)) return min_d(max_d(s->x, e->xt), e->xb);
+    if (y <= e->yt) return e->xt;
+    if (y >= e->yb) return e->xb;
+    return e->xt + (y - e->yt) * e->dxdy;
+}
+
+static bool sweep_init(Sweep* s, const TriPoint* points, uint32_t point_count,
+                       const TriRing* rings, uint32_t ring_count) {
+    memset(s, 0, sizeof(*s));
+    s->edges = malloc((size_t)point_count * sizeof(SweepEdge));
+    s->vertices = malloc((size_t)point_count * sizeof(SweepVertex));
+    s->starts = malloc((size_t)point_count * 2 * sizeof(uint32_t));
+    s->group = malloc((size_t)point_count * sizeof(uint32_t));
+    s->pending = malloc((size_t)point_count * sizeof(uint32_t));
+    double* ys = malloc((size_t)point_count * sizeof(double));
+    if (!s->edges || !s->vertices || !s->starts || !s->group || !s->pending || !ys) {
+        free(ys);
+        sweep_free(s);
+        return false;
+    }
+    for (uint32_t i = 0; i < point_count * 2; i++) s->starts[i] = SWEEP_NIL;
+
+    double extent = 1.0;
+    for (uint32_t r = 0; r < ring_count; r++) {
+        for (uint32_t i = rings[r].start; i < rings[r].end; i++) {
+            extent = max_d(extent, max_d(fabs(points[i].x), fabs(points[i].y)));
+            s->vertices[s->vertex_count++] = (SweepVertex){ points[i].y, points[i].x, i };
+        }
+    }
+    s->eps = extent * 1e-9;
+
+    // Rows of vertices closer than eps share one y. An edge between two of
+    // them would otherwise be so steep that its crossings round back onto
+    // the row it starts in (symmetric stars put vertex pairs 1 ulp apart).
+    qsort(s->vertices, s->vertex_count, sizeof(SweepVertex), compare_vertices);
+    double row = s->vertex_count > 0 ? s->vertices[0].y : 0.0;
+    for (uint32_t k = 0; k < s->vertex_count; k++) {
+        if (s->vertices[k].y - row > s->eps) row = s->vertices[k].y;
+        s->vertices[k].y = row;
+        ys[s->vertices[k].i] = row;
+    }
+    qsort(s->vertices, s->vertex_count, sizeof(SweepVertex), compare_vertices);
+
+    uint32_t edge_count = 0;
+    for (uint32_t r = 0; r < ring_count; r++) {
+        for (uint32_t i = rings[r].start; i < rings[r].end; i++) {
+            uint32_t j = i + 1 < rings[r].end ? i + 1 : rings[r].start;
+            TriPoint a = { points[i].x, ys[i] }, b = { points[j].x, ys[j] };
+
+            // "Down" is later in (y, x) event order
+            SweepEdge* e = &s->edges[edge_count];
+            bool down = a.y < b.y || (a.y == b.y && a.x < b.x);
+            TriPoint top = down ? a : b, bottom = down ? b : a;
+            e->xt = top.x;
+            e->yt = top.y;
+            e->xb = bottom.x;
+            e->yb = bottom.y;
+            e->dxdy = a.y == b.y ? INFINITY : (bottom.x - top.x) / (bottom.y - top.y);
+            e->vt = down ? i : j;
+            e->vb = down ? j : i;
+            e->winding = down ? 1 : -1;
+            uint32_t* slot = &s->starts[e->vt * 2];
+            slot[slot[0] == SWEEP_NIL ? 0 : 1] = edge_count++;
+        }
+    }
+    s->edge_count = edge_count;
+    free(ys);
+    return true;
+}
+
+static void sweep_reset(Sweep* s) {
+    s->root = SWEEP_NIL;
+    s->heap_count = 0;
+    s->seed = 0x9E3779B9u;
+    for (uint32_t i = 0; i < s->edge_count; i++) {
+        SweepEdge* e = &s->edges[i];
+        e->partner = SWEEP_NIL;
+        e->left = e->right = e->parent = SWEEP_NIL;
+    }
+}
+
+// ---- Crossing-event heap ----
+
+static bool heap_push(Sweep* s, double y, double x, double reach) {
+    if (!grow((void**)&s->heap, &s->heap_capacity, s->heap_count + 1, sizeof(SweepEvent))) return false;
+    uint32_t i = s->heap_count++;
+    while (i > 0) {
+        uint32_t up = (i - 1) / 2;
+        if (!event_before(y, x, s->heap[up].y, s->heap[up].x)) break;
+        s->heap[i] = s->heap[up];
+        i = up;
+    }
+    s->heap[i] = (SweepEvent){ y, x, reach };
+    return true;
+}
+
+static void heap_pop(Sweep* s) {
+    SweepEvent last = s->heap[--s->heap_count];
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t child = i * 2 + 1;
+        if (child >= s->heap_count) break;
+        if (child + 1 < s->heap_count &&
+            event_before(s->heap[child + 1].y, s->heap[child + 1].x, s->heap[child].y, s->heap[child].x)) child++;
+        if (!event_before(s->heap[child].y, s->heap[child].x, last.y, last.x)) break;
+        s->heap[i] = s->heap[child];
+        i = child;
+    }
+    if (s->heap_count > 0) s->heap[i] = last;
+}
+
+// ---- Status treap (in-order = left to right along the sweep line) ----
+
+static inline SweepEdge* E(Sweep* s, uint32_t i) { return &s->edges[i]; }
+
+static void rotate_up(Sweep* s, uint32_t x) {
+    uint32_t p = E(s, x)->parent;
+    uint32_t g = E(s, p)->parent;
+    if (E(s, p)->left == x) {
+        E(s, p)->left = E(s, x)->right;
+        if (E(s, x)->right != SWEEP_NIL) E(s, E(s, x)->right)->parent = p;
+        E(s, x)->right = p;
+    } else {
+        E(s, p)->right = E(s, x)->left;
+        if (E(s, x)->left != SWEEP_NIL) E(s, E(s, x)->left)->parent = p;
+        E(s, x)->left = p;
+    }
+    E(s, p)->parent = x;
+    E(s, x)->parent = g;
+    if (g == SWEEP_NIL) s->root = x;
+    else if (E(s, g)->left == p) E(s, g)->left = x;
+    else E(s, g)->right = x;
+}
+
+// Insert x right after `after` (first when after is NIL)
+static void treap_insert_after(Sweep* s, uint32_t after, uint32_t x) {
+    SweepEdge* e = E(s, x);
+    s->seed ^= s->seed << 13;
+    s->seed ^= s->seed >> 17;
+    s->seed ^= s->seed << 5;
+    e->priority = s->seed;
+    e->left = e->right = SWEEP_NIL;
+    if (s->root == SWEEP_NIL) {
+        e->parent = SWEEP_NIL;
+        s->root = x;
+        return;
+    }
+    uint32_t p;
+    bool as_left;
+    if (after == SWEEP_NIL) {
+        for (p = s->root; E(s, p)->left != SWEEP_NIL;) p = E(s, p)->left;
+        as_left = true;
+    } else if (E(s, after)->right == SWEEP_NIL) {
+        p = after;
+        as_left = false;
+    } else {
+        for (p = E(s, after)->right; E(s, p)->left != SWEEP_NIL;) p = E(s, p)->left;
+        as_left = true;
+    }
+    if (as_left) E(s, p)->left = x;
+    else E(s, p)->right = x;
+    e->parent = p;
+    while (e->parent != SWEEP_NIL && E(s, e->parent)->priority < e->priority) rotate_up(s, x);
+}
+
+static void treap_remove(Sweep* s, uint32_t x) {
+    SweepEdge* e = E(s, x);
+    while (e->left != SWEEP_NIL && e->right != SWEEP_NIL) {
+        uint32_t child = E(s, e->left)->priority > E(s, e->right)->priority ? e->left : e->right;
+        rotate_up(s, child);
+    }
+    uint32_t child = e->left != SWEEP_NIL ? e->left : e->right;
+    if (child != SWEEP_NIL) E(s, child)->parent = e->parent;
+    if (e->parent == SWEEP_NIL) s->root = child;
+    else if (E(s, e->parent)->left == x) E(s, e->parent)->left = child;
+    else E(s, e->parent)->right = child;
+    e->left = e->right = e->parent = SWEEP_NIL;
+}
+
+static uint32_t treap_next(Sweep* s, uint32_t x) {
+    if (E(s, x)->right != SWEEP_NIL) {
+        for (x = E(s, x)->right; E(s, x)->left != SWEEP_NIL;) x = E(s, x)->left;
+        return x;
+    }
+    uint32_t p = E(s, x)->parent;
+    while (p != SWEEP_NIL && E(s, p)->right == x) {
+        x = p;
+        p = E(s, p)->parent;
+    }
+    return p;
+}
+
+static uint32_t treap_prev(Sweep* s, uint32_t x) {
+    if (E(s, x)->left != SWEEP_NIL) {
+        for (x = E(s, x)->left; E(s, x)->right != SWEEP_NIL;) x = E(s, x)->right;
+        return x;
+    }
+    uint32_t p = E(s, x)->parent;
+    while (p != SWEEP_NIL && E(s, p)->left == x) {
+        x = p;
+        p = E(s, p)->parent;
+    }
+    return p;
+}
+
+static uint32_t treap_last(Sweep* s) {
+    uint32_t x = s->root;
+    if (x == SWEEP_NIL) return x;
+    while (E(s, x)->right != SWEEP_NIL) x = E(s, x)->right;
+    return x;
+}
+
+// First edge whose x on the sweep line is >= x
+static uint32_t treap_lower_bound(Sweep* s, double x) {
+    uint32_t found = SWEEP_NIL;
+    for (uint32_t n = s->root; n != SWEEP_NIL;) {
+        if (edge_x(s, E(s, n), s->y) >= x) {
+            found = n;
+            n = E(s, n)->left;
+        } else {
+            n = E(s, n)->right;
+        }
+    }
+    return found;
+}
+
+// ---- Event handling ----
+
+// Queue the crossing of neighbours a (left) and b below the sweep line.
+// The event always lies strictly after the current point: a crossing that
+// rounds onto or behind it moves to the next representable x or y, as one
+// queued at the current point would be popped and queued again forever.
+static bool schedule_crossing(Sweep* s, uint32_t a, uint32_t b) {
+    if (a == SWEEP_NIL || b == SWEEP_NIL) return true;
+    const SweepEdge* ea = E(s, a);
+    const SweepEdge* eb = E(s, b);
+    if (is_flat(eb)) return true;        // Moves right, away from a
+    if (is_flat(ea)) {
+        // Overtakes b where b passes through the row before the flat ends
+        if (eb->yb == ea->yt || eb->yt == ea->yt) return true;
+        double x = edge_x(s, eb, ea->yt);
+        if (x > ea->xb) return true;
+        return heap_push(s, s->y, x > s->x ? x : nextafter(s->x, INFINITY), s->eps);
+    }
+    double y_end = min_d(ea->yb, eb->yb);
+    if (edge_x(s, ea, y_end) <= edge_x(s, eb, y_end) + s->eps) return true;
+    double closing = ea->dxdy - eb->dxdy;
+    double y = closing > 0 ? s->y + (edge_x(s, eb, s->y) - edge_x(s, ea, s->y)) / closing : s->y;
+    if (!(y >= s->y)) y = s->y;
+    if (y > y_end) y = y_end;
+    double xa = edge_x(s, ea, y), xb = edge_x(s, eb, y);
+    double x = (xa + xb) * 0.5;
+    if (y == s->y && x <= s->x) {
+        if (y_end == s->y) return true;  // Both end on this row
+        y = nextafter(s->y, INFINITY);
+        xa = edge_x(s, ea, y);
+        xb = edge_x(s, eb, y);
+        x = (xa + xb) * 0.5;
+    }
+    return heap_push(s, y, x, fabs(xa - xb) * 0.5 + s->eps);
+}
+
+// Check mode: neighbours a (left) and b may only meet at a shared lower vertex
+static bool neighbours_apart(Sweep* s, uint32_t a, uint32_t b) {
+    if (a == SWEEP_NIL || b == SWEEP_NIL) return true;
+    const SweepEdge* ea = E(s, a);
+    const SweepEdge* eb = E(s, b);
+    if (is_flat(eb)) return true;
+    if (is_flat(ea)) {
+        if (eb->yb == ea->yt && eb->vb == ea->vb) return true;
+        return edge_x(s, eb, ea->yt) > ea->xb + s->eps;
+    }
+    double y_end = min_d(ea->yb, eb->yb);
+    if (edge_x(s, ea, y_end) < edge_x(s, eb, y_end) - s->eps) return true;
+    return ea->yb == eb->yb && ea->vb == eb->vb;
+}
+
+static void close_span(Sweep* s, uint32_t left, double y, TriBuffer* out) {
+    SweepEdge* l = E(s, left);
+    if (l->partner == SWEEP_NIL) return;
+    const SweepEdge* r = E(s, l->partner);
+    double top = l->span_top;
+    l->partner = SWEEP_NIL;
+    if (y <= top) return;
+
+    double lt = edge_x(s, l, top), rt = edge_x(s, r, top);
+    double lb = edge_x(s, l, y), rb = edge_x(s, r, y);
+    bool top_open = rt > lt, bottom_open = rb > lb;
+    if (!top_open && !bottom_open) return;
+    uint32_t base = push_point(out, lt, top);
+    push_point(out, rt, top);
+    push_point(out, rb, y);
+    push_point(out, lb, y);
+    if (top_open) push_triangle(out, base, base + 1, base + 2);
+    if (bottom_open) push_triangle(out, base, base + 2, base + 3);
+}
+
+static void open_span(Sweep* s, uint32_t left, AfferentFillRule rule) {
+    SweepEdge* l = E(s, left);
+    if (!fill_rule_inside(rule, l->right_winding)) return;
+    uint32_t right = treap_next(s, left);
+    if (right == SWEEP_NIL) return;
+    l->partner = right;
+    l->span_top = s->y;
+}
+
+// Sweep every event. Check mode returns false at the first crossing or
+// contact between edges that do not share a vertex. Fill mode emits the
+// spans the rule selects, each kept open until one of its two bounding
+// edges gains a new neighbour, then closed as one trapezoid. Both give up
+// (fill mode as a failure) past TRI_SWEEP_EVENTS_PER_PAIR events per edge
+// pair, well beyond one per vertex and crossing, should rounding keep
+// feeding the heap.
+static bool sweep_run(Sweep* s, bool check, AfferentFillRule rule, TriBuffer* out) {
+    sweep_reset(s);
+    uint32_t vi = 0;
+    uint64_t budget = s->vertex_count + TRI_SWEEP_EVENTS_PER_PAIR * (uint64_t)s->edge_count * s->edge_count;
+    while (vi < s->vertex_count || s->heap_count > 0) {
+        if (out && out->failed) return false;
+        if (budget-- == 0) {
+            if (out) out->failed = true;
+            return false;
+        }
+        double reach = s->eps;
+        if (vi < s->vertex_count && (s->heap_count == 0 ||
+            !event_before(s->heap[0].y, s->heap[0].x, s->vertices[vi].y, s->vertices[vi].x))) {
+            s->y = s->vertices[vi].y;
+            s->x = s->vertices[vi].x;
+        } else {
+            s->y = s->heap[0].y;
+            s->x = s->heap[0].x;
+        }
+
+        // Everything at this point: its vertices' new edges, merged crossings
+        uint32_t vertex = SWEEP_NIL;
+        uint32_t pending = 0;
+        while (vi < s->vertex_count && s->vertices[vi].y == s->y && s->vertices[vi].x == s->x) {
+            uint32_t v = s->vertices[vi++].i;
+            if (check && vertex != SWEEP_NIL) return false;
+            vertex = v;
+            for (uint32_t k = 0; k < 2; k++) {
+                if (s->starts[v * 2 + k] != SWEEP_NIL) s->pending[pending++] = s->starts[v * 2 + k];
+            }
+        }
+        // Crossings computed from different pairs land a few ulps apart
+        while (s->heap_count > 0 && s->heap[0].y - s->y <= s->eps && fabs(s->heap[0].x - s->x) <= s->eps) {
+            reach = max_d(reach, s->heap[0].reach);
+            heap_pop(s);
+        }
+
+        // Edges through the point are contiguous in the status
+        uint32_t first = treap_lower_bound(s, s->x - reach);
+        uint32_t left = first != SWEEP_NIL ? treap_prev(s, first) : treap_last(s);
+        uint32_t group = 0;
+        for (uint32_t n = first; n != SWEEP_NIL && edge_x(s, E(s, n), s->y) <= s->x + reach; n = treap_next(s, n)) {
+            s->group[group++] = n;
+        }
+        if (group == 0 && pending == 0) continue;
+
+        if (check) {
+            for (uint32_t g = 0; g < group; g++) {
+                const SweepEdge* e = E(s, s->group[g]);
+                if (e->yb != s->y || e->vb != vertex) return false;
+            }
+        } else {
+            if (left != SWEEP_NIL) close_span(s, left, s->y, out);
+            for (uint32_t g = 0; g < group; g++) close_span(s, s->group[g], s->y, out);
+        }
+
+        // Drop edges ending here; the rest continue below with the new ones
+        for (uint32_t g = 0; g < group; g++) {
+            uint32_t id = s->group[g];
+            treap_remove(s, id);
+            if (event_before(s->y, s->x, E(s, id)->yb, E(s, id)->xb)) s->pending[pending++] = id;
+        }
+        // Below the point the order is by slope
+        for (uint32_t i = 1; i < pending; i++) {
+            uint32_t id = s->pending[i];
+            double slope = E(s, id)->dxdy;
+            uint32_t j = i;
+            while (j > 0 && (E(s, s->pending[j - 1])->dxdy > slope ||
+                             (E(s, s->pending[j - 1])->dxdy == slope && s->pending[j - 1] > id))) {
+                s->pending[j] = s->pending[j - 1];
+                j--;
+            }
+            s->pending[j] = id;
+        }
+        uint32_t after = left;
+        for (uint32_t i = 0; i < pending; i++) {
+            treap_insert_after(s, after, s->pending[i]);
+            after = s->pending[i];
+        }
+
+        if (!check) {
+            int32_t winding = left != SWEEP_NIL ? E(s, left)->right_winding : 0;
+            for (uint32_t i = 0; i < pending; i++) {
+                SweepEdge* e = E(s, s->pending[i]);
+                winding += e->winding;
+                e->right_winding = winding;
+            }
+            if (left != SWEEP_NIL) open_span(s, left, rule);
+            for (uint32_t i = 0; i < pending; i++) open_span(s, s->pending[i], rule);
+        }
+
+        uint32_t a = left, b;
+        if (pending == 0) {
+            b = left != SWEEP_NIL ? treap_next(s, left) : treap_lower_bound(s, -INFINITY);
+        } else {
+            b = s->pending[0];
+        }
+        uint32_t c = pending > 0 ? s->pending[pending - 1] : SWEEP_NIL;
+        uint32_t d = c != SWEEP_NIL ? treap_next(s, c) : SWEEP_NIL;
+        if (check) {
+            if (!neighbours_apart(s, a, b) || !neighbours_apart(s, c, d)) return false;
+        } else if (!schedule_crossing(s, a, b) || !schedule_crossing(s, c, d)) {
+            out->failed = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Entry point
+// ============================================================================
+
+bool afferent_triangulate(const double* points, const uint32_t* contour_ends,
+                          uint32_t contour_count, AfferentFillRule rule,
+                          AfferentTriangulation* out) {
+    memset(out, 0, sizeof(*out));
+    uint32_t point_count = contour_count > 0 ? contour_ends[contour_count - 1] : 0;
+    for (uint32_t c = 0; c < contour_count; c++) {
+        if (c > 0 && contour_ends[c] < contour_ends[c - 1]) return false;
+    }
+    for (uint32_t i = 0; i < point_count * 2; i++) {
+        if (!isfinite(points[i])) return false;
+    }
+
+    // Copy into rings without repeated points or closing duplicates
+    TriBuffer clean = {0};
+    TriRing* rings = malloc((size_t)(contour_count ? contour_count : 1) * sizeof(TriRing));
+    if (!rings) return false;
+    uint32_t ring_count = 0;
+    uint32_t start = 0;
+    for (uint32_t c = 0; c < contour_count; c++) {
+        uint32_t first = clean.point_count;
+        for (uint32_t i = start; i < contour_ends[c]; i++) {
+            double x = points[i * 2], y = points[i * 2 + 1];
+            uint32_t n = clean.point_count - first;
+            if (n > 0 && clean.points[(clean.point_count - 1) * 2] == x &&
+                clean.points[(clean.point_count - 1) * 2 + 1] == y) continue;
+            push_point(&clean, x, y);
+        }
+        while (clean.point_count - first > 1 &&
+               clean.points[first * 2] == clean.points[(clean.point_count - 1) * 2] &&
+               clean.points[first * 2 + 1] == clean.points[(clean.point_count - 1) * 2 + 1]) {
+            clean.point_count--;
+        }
+        if (clean.point_count - first < 3) clean.point_count = first;
+        else rings[ring_count++] = (TriRing){ first, clean.point_count };
+        start = contour_ends[c];
+    }
+    if (clean.failed) {
+        free(clean.points);
+        free(rings);
+        return false;
+    }
+    if (ring_count == 0) {
+        free(clean.points);
+        free(rings);
+        out->method = AFFERENT_TRIANGULATE_EMPTY;
+        return true;
+    }
+
+    const TriPoint* pts = (const TriPoint*)clean.points;
+    Sweep sweep;
+    if (!sweep_init(&sweep, pts, clean.point_count, rings, ring_count)) {
+        free(clean.points);
+        free(rings);
+        return false;
+    }
+
+    bool clipped = false;
+    int32_t* parent = malloc((size_t)ring_count * sizeof(int32_t));
+    bool* outer = malloc((size_t)ring_count * sizeof(bool));
+    EarNode* nodes = malloc(((size_t)clean.point_count + 2 * (size_t)ring_count) * sizeof(EarNode));
+    EarNode** laps = malloc(2 * ((size_t)clean.point_count + 2 * (size_t)ring_count) * sizeof(EarNode*));
+    EarNode** queue = malloc((size_t)ring_count * sizeof(EarNode*));
+    TriRing* holes = malloc((size_t)ring_count * sizeof(TriRing));
+    if (parent && outer && nodes && laps && queue && holes &&
+        sweep_run(&sweep, true, rule, NULL) && classify_rings(pts, rings, ring_count, rule, parent, outer)) {
+        TriBuffer tris = {0};
+        EarContext ctx = {
+            .points = pts, .nodes = nodes, .out = &tris,
+            .lap_nodes = laps, .next_nodes = laps + clean.point_count + 2 * ring_count
+        };
+        clipped = true;
+        for (uint32_t r = 0; r < ring_count && clipped; r++) {
+            if (!outer[r]) continue;
+            uint32_t hole_count = 0;
+            for (uint32_t h = 0; h < ring_count; h++) {
+                if (parent[h] == (int32_t)r && !outer[h]) holes[hole_count++] = rings[h];
+            }
+            ctx.node_count = 0;
+            clipped = earcut_group(&ctx, rings[r], holes, hole_count, queue) && !tris.failed;
+        }
+        free(ctx.cell_start);
+        free(ctx.cell_nodes);
+        if (clipped) {
+            out->points = clean.points;
+            out->point_count = clean.point_count;
+            out->indices = tris.indices;
+            out->index_count = tris.index_count;
+            out->method = AFFERENT_TRIANGULATE_EAR_CLIP;
+            clean.points = NULL;
+        } else {
+            free(tris.indices);
+        }
+    }
+    free(parent);
+    free(outer);
+    free(nodes);
+    free(laps);
+    free(queue);
+    free(holes);
+
+    bool ok = true;
+    if (!clipped) {
+        TriBuffer trapezoids = {0};
+        if (!sweep_run(&sweep, false, rule, &trapezoids)) {
+            free(trapezoids.points);
+            free(trapezoids.indices);
+            ok = false;
+        } else {
+            out->points = trapezoids.points;
+            out->point_count = trapezoids.point_count;
+            out->indices = trapezoids.indices;
+            out->index_count = trapezoids.index_count;
+            out->method = AFFERENT_TRIANGULATE_SWEEP;
+        }
+    }
+    sweep_free(&sweep);
+    free(clean.points);
+    free(rings);
+    return ok;
+}
+
+void afferent_triangulation_free(AfferentTriangulation* t) {
+    free(t->points);
+    free(t->indices);
+    t->points = NULL;
+    t->indices = NULL;
+    t->point_count = 0;
+    t->index_count = 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Polyline reducer - drop the points of a long polyline a stroke cannot show
+ *
+ * Line and chart series of millions of points put many points on each
+ * pixel, and the stroker would expand every one of them. Points are
+ * compared in pixel space (after the canvas transform) and the survivors are
+ * returned untransformed, so the reduced polyline goes through the same
+ * transform and stroker as the original would have:
+ *  - min/max per column, for series whose pixel x never reverses: each run
+ *    of points in one column of width 2 * tolerance keeps its first, lowest,
+ *    highest and last point, in input order (M4 aggregation). The strokes of
+ *    the full and reduced series cover the same pixels. O(n), no allocation.
+ *  - Ramer-Douglas-Peucker for anything else: a radial pass first drops
+ *    points within tolerance of the last kept one (the cheap bulk of the
+ *    work on dense data), then each span keeps its point farthest from the
+ *    span's chord while that is over tolerance, on an explicit stack.
+ *    O(n log n) on typical paths.
+ */
+
+#include "afferent.h"
+#include <math.h>
+#include <stdlib.h>
+
+typedef struct {
+    double a, b, c, d, tx, ty;
+} ReduceTransform;
+
+static inline void to_pixels(const ReduceTransform* t, const double* p, double* x, double* y) {
+    *x = t->a * p[0] + t->c * p[1] + t->tx;
+    *y = t->b * p[0] + t->d * p[1] + t->ty;
+}
+
+static inline void copy_point(const double* points, size_t i, double* out, size_t* kept) {
+    out[2 * *kept] = points[2 * i];
+    out[2 * *kept + 1] = points[2 * i + 1];
+    (*kept)++;
+}
+
+// True when the transformed x never decreases, or never increases
+static bool x_is_monotonic(const double* points, size_t count, const ReduceTransform* t) {
+    bool rising = true, falling = true;
+    double prev_x, y;
+    to_pixels(t, points, &prev_x, &y);
+    for (size_t i = 1; i < count && (rising || falling); i++) {
+        double x;
+        to_pixels(t, points + 2 * i, &x, &y);
+        if (x < prev_x) rising = false;
+        if (x > prev_x) falling = false;
+        prev_x = x;
+    }
+    return rising || falling;
+}
+
+static size_t reduce_minmax(const double* points, size_t count, const ReduceTransform* t,
+    double column_width, double* out) {
+    size_t kept = 0;
+    size_t i = 0;
+    while (i < count) {
+        double x, y;
+        to_pixels(t, points + 2 * i, &x, &y);
+        double column = floor(x / column_width);
+        size_t first = i, low = i, high = i, last = i;
+        double low_y = y, high_y = y;
+        for (i++; i < count; i++) {
+            to_pixels(t, points + 2 * i, &x, &y);
+            if (floor(x / column_width) != column) break;
+            if (y < low_y) { low_y = y; low = i; }
+            if (y > high_y) { high_y = y; high = i; }
+            last = i;
+        }
+        // Emit the (up to) four in input order, each once
+        size_t picks[4] = { first, low, high, last };
+        for (int a = 1; a < 4; a++) {
+            for (int b = a; b > 0 && picks[b] < picks[b - 1]; b--) {
+                size_t tmp = picks[b];
+                picks[b] = picks[b - 1];
+                picks[b - 1] = tmp;
+            }
+        }
+        for (int a = 0; a < 4; a++) {
+            if (a == 0 || picks[a] != picks[a - 1]) copy_point(points, picks[a], out, &kept);
+        }
+    }
+    return kept;
+}
+
+// Squared distance from p to the segment a-b (to a when they coincide)
+static inline double segment_distance_sq(double px, double py, double ax, double ay,
+    double bx, double by) {
+    double dx = bx - ax, dy = by - ay;
+    double len_sq = dx * dx + dy * dy;
+    double s = len_sq > 0.0 ? ((px - ax) * dx + (py - ay) * dy) / len_sq : 0.0;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    double ex = ax + s * dx - px, ey = ay + s * dy - py;
+    return ex * ex + ey * ey;
+}
+
+typedef struct { size_t start, end; } ReduceSpan;
+
+static bool reduce_rdp(const double* points, size_t count, const ReduceTransform* t,
+    double tolerance, double* out, size_t* out_count) {
+    // Radial pass: indices and pixel positions of points at least tolerance apart
+    size_t* index = malloc(count * sizeof(size_t));
+    double* pixel = malloc(count * 2 * sizeof(double));
+    if (!index || !pixel) {
+        free(index);
+        free(pixel);
+        return false;
+    }
+    double tol_sq = tolerance * tolerance;
+    size_t m = 0;
+    for (size_t i = 0; i < count; i++) {
+        double x, y;
+        to_pixels(t, points + 2 * i, &x, &y);
+        if (m > 0 && i + 1 < count) {
+            double dx = x - pixel[2 * (m - 1)], dy = y - pixel[2 * (m - 1) + 1];
+            if (dx * dx + dy * dy <= tol_sq) continue;
+        }
+        index[m] = i;
+        pixel[2 * m] = x;
+        pixel[2 * m + 1] = y;
+        m++;
+    }
+
+    uint8_t* keep = calloc(m, 1);
+    ReduceSpan* stack = malloc(m * sizeof(ReduceSpan));
+    if (!keep || !stack) {
+        free(index);
+        free(pixel);
+        free(keep);
+        free(stack);
+        return false;
+    }
+    keep[0] = keep[m - 1] = 1;
+    size_t top = 0;
+    if (m > 2) stack[top++] = (ReduceSpan){ 0, m - 1 };
+    while (top > 0) {
+        ReduceSpan span = stack[--top];
+        const double* a = pixel + 2 * span.start;
+        const double* b = pixel + 2 * span.end;
+        double worst = tol_sq;
+        size_t split = span.start;
+        for (size_t k = span.start + 1; k < span.end; k++) {
+            double d = segment_distance_sq(pixel[2 * k], pixel[2 * k + 1], a[0], a[1], b[0], b[1]);
+            if (d > worst) { worst = d; split = k; }
+        }
+        if (split == span.start) continue;
+        keep[split] = 1;
+        // Each push splits a span at an interior point, so the stack holds at most m spans
+        if (split - span.start > 1) stack[top++] = (ReduceSpan){ span.start, split };
+        if (span.end - split > 1) stack[top++] = (ReduceSpan){ split, span.end };
+    }
+
+    size_t kept = 0;
+    for (size_t k = 0; k < m; k++) {
+        if (keep[k]) copy_point(points, index[k], out, &kept);
+    }
+    *out_count = kept;
+    free(index);
+    free(pixel);
+    free(keep);
+    free(stack);
+    return true;
+}
+
+bool afferent_polyline_reduce(const double* points, size_t count, const double* transform,
+    double tolerance, AfferentPolylineReduce method, double* out, size_t* out_count) {
+    *out_count = 0;
+    for (size_t i = 0; i < count * 2; i++) {
+        if (!isfinite(points[i])) return false;
+    }
+    ReduceTransform t = transform
+        ? (ReduceTransform){ transform[0], transform[1], transform[2], transform[3], transform[4], transform[5] }
+        : (ReduceTransform){ 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+    if (count < 3 || !(tolerance > 0.0)) {
+        for (size_t i = 0; i < count; i++) copy_point(points, i, out, out_count);
+        return true;
+    }
+    if (method == AFFERENT_POLYLINE_REDUCE_AUTO) {
+        method = x_is_monotonic(points, count, &t)
+            ? AFFERENT_POLYLINE_REDUCE_MINMAX : AFFERENT_POLYLINE_REDUCE_RDP;
+    }
+    if (method == AFFERENT_POLYLINE_REDUCE_MINMAX) {
+        *out_count = reduce_minmax(points, count, &t, 2.0 * tolerance, out);
+        return true;
+    }
+    return reduce_rdp(points, count, &t, tolerance, out, out_count);
+}
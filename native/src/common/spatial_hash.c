@@ -0,0 +1,402 @@
+/*
+ * SpatialHash - Uniform-grid spatial hash for particle neighbor queries
+ *
+ * Each rebuild fits a row-major grid of square cells over the particles'
+ * bounding box and bins them with a counting sort over cell IDs (two linear
+ * passes, no per-cell allocation). Particles end up contiguous per cell with
+ * their positions copied into a sorted array, so neighboring cells are also
+ * neighbors in memory. If the bounds would need more than ~2 cells per
+ * particle, the effective cell size grows so memory stays O(count).
+ *
+ * Input is any float stream with [x, y, ...] at the start of each particle
+ * (e.g. the sprite FloatBuffer layout [x, y, vx, vy, rotation]).
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+struct AfferentSpatialHash {
+    float cell_size;             // Requested (minimum) cell size
+    float cell;                  // Effective cell size of the last rebuild
+    float inv_cell;
+    float min_x;
+    float min_y;
+    int32_t grid_w;
+    int32_t grid_h;
+    uint32_t count;              // Particles binned by the last rebuild
+    uint32_t particle_capacity;
+    uint32_t cell_capacity;
+    uint32_t* cell_start;        // grid_w * grid_h + 1 entries; cell c spans [cell_start[c], cell_start[c+1])
+    uint32_t* particle_cell;     // Cell of each particle, in input order
+    uint32_t* sorted;            // Particle indices sorted by cell
+    float* sorted_xy;            // Positions in sorted order (2 floats per particle)
+};
+
+// Grid coordinate of `v` along one axis, clamped to [0, n). NaN maps to 0.
+static inline int32_t grid_coord(float v, float origin, float inv_cell, int32_t n) {
+    float s = (v - origin) * inv_cell;
+    if (!(s >= 0.0f)) return 0;
+    if (s >= (float)n) return n - 1;
+    return (int32_t)s;
+}
+
+// Unclamped floor of a grid coordinate, for query ranges that may leave the grid.
+static inline int64_t grid_floor(float v, float origin, float inv_cell) {
+    double s = ((double)v - (double)origin) * (double)inv_cell;
+    if (s < -1e15) return INT32_MIN;
+    if (s > 1e15) return INT32_MAX;
+    return (int64_t)floor(s);
+}
+
+AfferentResult afferent_spatial_hash_create(float cell_size, AfferentSpatialHashRef* out) {
+    if (!out || !(cell_size > 0.0f)) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    AfferentSpatialHashRef h = calloc(1, sizeof(struct AfferentSpatialHash));
+    if (!h) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    h->cell_size = cell_size;
+    h->cell = cell_size;
+    h->inv_cell = 1.0f / cell_size;
+    *out = h;
+    return AFFERENT_OK;
+}
+
+void afferent_spatial_hash_destroy(AfferentSpatialHashRef h) {
+    if (h) {
+        free(h->cell_start);
+        free(h->particle_cell);
+        free(h->sorted);
+        free(h->sorted_xy);
+        free(h);
+    }
+}
+
+float afferent_spatial_hash_cell_size(AfferentSpatialHashRef h) {
+    return h->cell;
+}
+
+uint32_t afferent_spatial_hash_count(AfferentSpatialHashRef h) {
+    return h->count;
+}
+
+// Grow per-particle and per-cell storage; storage is kept across rebuilds.
+static bool ensure_capacity(AfferentSpatialHashRef h, uint32_t count, uint32_t cells) {
+    if (count > h->particle_capacity) {
+        uint32_t cap = count + count / 2;
+        uint32_t* cell = realloc(h->particle_cell, (size_t)cap * sizeof(uint32_t));
+        if (!cell) return false;
+        h->particle_cell = cell;
+        uint32_t* sorted = realloc(h->sorted, (size_t)cap * sizeof(uint32_t));
+        if (!sorted) return false;
+        h->sorted = sorted;
+        float* xy = realloc(h->sorted_xy, (size_t)cap * 2 * sizeof(float));
+        if (!xy) return false;
+        h->sorted_xy = xy;
+        h->particle_capacity = cap;
+    }
+    if (cells > h->cell_capacity) {
+        uint32_t* start = realloc(h->cell_start, ((size_t)cells + 1) * sizeof(uint32_t));
+        if (!start) return false;
+        h->cell_start = start;
+        h->cell_capacity = cells;
+    }
+    return true;
+}
+
+// Fit the grid to the finite particle bounds, coarsening cells when the
+// requested size would need more than `max_cells`.
+static void fit_grid(AfferentSpatialHashRef h, const float* data, uint32_t count, uint32_t stride) {
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+    for (uint32_t i = 0; i < count; i++) {
+        const float* p = data + (size_t)i * stride;
+        if (isfinite(p[0]) && isfinite(p[1])) {
+            if (p[0] < min_x) min_x = p[0];
+            if (p[0] > max_x) max_x = p[0];
+            if (p[1] < min_y) min_y = p[1];
+            if (p[1] > max_y) max_y = p[1];
+        }
+    }
+    if (min_x > max_x) {
+        min_x = max_x = 0.0f;
+        min_y = max_y = 0.0f;
+    }
+
+    double w = (double)max_x - (double)min_x;
+    double ht = (double)max_y - (double)min_y;
+    double max_cells = (double)count * 2.0 + 16.0;
+    double cell = h->cell_size;
+    double gw = floor(w / cell) + 1.0;
+    double gh = floor(ht / cell) + 1.0;
+    if (gw * gh > max_cells) {
+        cell = fmax(cell, sqrt((w * ht) / max_cells));
+        gw = floor(w / cell) + 1.0;
+        gh = floor(ht / cell) + 1.0;
+        while (gw * gh > max_cells) {
+            cell *= 1.25;
+            gw = floor(w / cell) + 1.0;
+            gh = floor(ht / cell) + 1.0;
+        }
+    }
+
+    h->cell = (float)cell;
+    h->inv_cell = (float)(1.0 / cell);
+    h->min_x = min_x;
+    h->min_y = min_y;
+    h->grid_w = (int32_t)gw;
+    h->grid_h = (int32_t)gh;
+}
+
+AfferentResult afferent_spatial_hash_rebuild(
+    AfferentSpatialHashRef h,
+    const float* data,
+    uint32_t count,
+    uint32_t stride
+) {
+    if (!h || (!data && count > 0) || stride < 2) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    fit_grid(h, data, count, stride);
+    uint32_t cells = (uint32_t)h->grid_w * (uint32_t)h->grid_h;
+    if (!ensure_capacity(h, count, cells)) {
+        h->count = 0;
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+
+    float inv = h->inv_cell;
+    uint32_t* start = h->cell_start;
+    memset(start, 0, ((size_t)cells + 1) * sizeof(uint32_t));
+
+    // Pass 1: cell histogram
+    for (uint32_t i = 0; i < count; i++) {
+        const float* p = data + (size_t)i * stride;
+        int32_t cx = grid_coord(p[0], h->min_x, inv, h->grid_w);
+        int32_t cy = grid_coord(p[1], h->min_y, inv, h->grid_h);
+        uint32_t c = (uint32_t)cy * (uint32_t)h->grid_w + (uint32_t)cx;
+        h->particle_cell[i] = c;
+        start[c]++;
+    }
+
+    // Inclusive prefix sum: start[c] = end of cell c
+    uint32_t sum = 0;
+    for (uint32_t c = 0; c < cells; c++) {
+        sum += start[c];
+        start[c] = sum;
+    }
+    start[cells] = sum;
+
+    // Pass 2: scatter in reverse so indices stay ascending within a cell;
+    // afterwards start[c] is the beginning of cell c.
+    for (uint32_t i = count; i-- > 0;) {
+        uint32_t pos = --start[h->particle_cell[i]];
+        const float* p = data + (size_t)i * stride;
+        h->sorted[pos] = i;
+        h->sorted_xy[pos * 2 + 0] = p[0];
+        h->sorted_xy[pos * 2 + 1] = p[1];
+    }
+
+    h->count = count;
+    return AFFERENT_OK;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+uint32_t afferent_spatial_hash_query_radius(
+    AfferentSpatialHashRef h,
+    float x,
+    float y,
+    float radius,
+    uint32_t* out_indices,
+    uint32_t max_results
+) {
+    if (!h || h->count == 0 || !(radius >= 0.0f)) return 0;
+
+    int64_t ix0 = grid_floor(x - radius, h->min_x, h->inv_cell);
+    int64_t ix1 = grid_floor(x + radius, h->min_x, h->inv_cell);
+    int64_t iy0 = grid_floor(y - radius, h->min_y, h->inv_cell);
+    int64_t iy1 = grid_floor(y + radius, h->min_y, h->inv_cell);
+    if (ix0 < 0) ix0 = 0;
+    if (iy0 < 0) iy0 = 0;
+    if (ix1 >= h->grid_w) ix1 = h->grid_w - 1;
+    if (iy1 >= h->grid_h) iy1 = h->grid_h - 1;
+    // A circle wholly off one side of the grid leaves an empty span
+    if (ix0 > ix1 || iy0 > iy1) return 0;
+
+    float r2 = radius * radius;
+    uint32_t found = 0;
+    for (int64_t cy = iy0; cy <= iy1; cy++) {
+        // Cells of one row are contiguous, so scan the whole row span at once
+        uint32_t row = (uint32_t)cy * (uint32_t)h->grid_w;
+        uint32_t k0 = h->cell_start[row + (uint32_t)ix0];
+        uint32_t k1 = h->cell_start[row + (uint32_t)ix1 + 1];
+        for (uint32_t k = k0; k < k1; k++) {
+            float dx = h->sorted_xy[k * 2] - x;
+            float dy = h->sorted_xy[k * 2 + 1] - y;
+            if (dx * dx + dy * dy <= r2) {
+                if (found < max_results && out_indices) out_indices[found] = h->sorted[k];
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+// Visit every candidate pair of sorted slots (ka, kb) whose cells are within
+// `reach` cells of each other, each unordered pair exactly once (half stencil).
+// The visitor performs its own distance test.
+typedef void (*pair_visitor)(void* ctx, uint32_t ka, uint32_t kb);
+
+static void for_each_candidate_pair(AfferentSpatialHashRef h, int32_t reach,
+                                    pair_visitor visit, void* ctx) {
+    int32_t gw = h->grid_w;
+    int32_t gh = h->grid_h;
+    const uint32_t* start = h->cell_start;
+
+    for (int32_t cy = 0; cy < gh; cy++) {
+        for (int32_t cx = 0; cx < gw; cx++) {
+            uint32_t c = (uint32_t)cy * (uint32_t)gw + (uint32_t)cx;
+            uint32_t a0 = start[c];
+            uint32_t a1 = start[c + 1];
+            if (a0 == a1) continue;
+
+            // Same cell
+            for (uint32_t ka = a0; ka < a1; ka++) {
+                for (uint32_t kb = ka + 1; kb < a1; kb++) visit(ctx, ka, kb);
+            }
+
+            // Rest of this row to the right, then full rows below
+            for (int32_t dy = 0; dy <= reach; dy++) {
+                int32_t ny = cy + dy;
+                if (ny >= gh) break;
+                int32_t nx0 = dy == 0 ? cx + 1 : cx - reach;
+                int32_t nx1 = cx + reach;
+                if (nx0 < 0) nx0 = 0;
+                if (nx1 >= gw) nx1 = gw - 1;
+                if (nx0 > nx1) continue;
+                uint32_t row = (uint32_t)ny * (uint32_t)gw;
+                uint32_t b0 = start[row + (uint32_t)nx0];
+                uint32_t b1 = start[row + (uint32_t)nx1 + 1];
+                for (uint32_t ka = a0; ka < a1; ka++) {
+                    for (uint32_t kb = b0; kb < b1; kb++) visit(ctx, ka, kb);
+                }
+            }
+        }
+    }
+}
+
+static int32_t reach_for(AfferentSpatialHashRef h, float radius) {
+    double cells = ceil((double)radius * (double)h->inv_cell);
+    if (cells < 1.0) return 1;
+    double limit = (double)(h->grid_w > h->grid_h ? h->grid_w : h->grid_h);
+    return (int32_t)(cells < limit ? cells : limit);
+}
+
+typedef struct {
+    AfferentSpatialHashRef h;
+    float r2;
+    uint32_t* out_pairs;
+    uint64_t max_pairs;
+    uint64_t found;
+} PairQuery;
+
+static void visit_pair_query(void* ctx, uint32_t ka, uint32_t kb) {
+    PairQuery* q = (PairQuery*)ctx;
+    const float* xy = q->h->sorted_xy;
+    float dx = xy[kb * 2] - xy[ka * 2];
+    float dy = xy[kb * 2 + 1] - xy[ka * 2 + 1];
+    if (dx * dx + dy * dy > q->r2) return;
+
+    if (q->found < q->max_pairs && q->out_pairs) {
+        uint32_t i = q->h->sorted[ka];
+        uint32_t j = q->h->sorted[kb];
+        q->out_pairs[q->found * 2 + 0] = i < j ? i : j;
+        q->out_pairs[q->found * 2 + 1] = i < j ? j : i;
+    }
+    q->found++;
+}
+
+uint64_t afferent_spatial_hash_query_pairs(
+    AfferentSpatialHashRef h,
+    float radius,
+    uint32_t* out_pairs,
+    uint64_t max_pairs
+) {
+    if (!h || h->count == 0 || !(radius >= 0.0f)) return 0;
+
+    PairQuery q = { h, radius * radius, out_pairs, max_pairs, 0 };
+    for_each_candidate_pair(h, reach_for(h, radius), visit_pair_query, &q);
+    return q.found;
+}
+
+// ============================================================================
+// Collision resolution
+// Layout: [x, y, vx, vy, ...] per particle (stride >= 4)
+// ============================================================================
+
+typedef struct {
+    AfferentSpatialHashRef h;
+    float* data;
+    uint32_t stride;
+    float diameter;
+    float diameter2;
+    float bounce;
+    uint32_t contacts;
+} CollisionPass;
+
+static void visit_collision(void* ctx, uint32_t ka, uint32_t kb) {
+    CollisionPass* c = (CollisionPass*)ctx;
+    // Candidates come from the grid as built this step; distances use live
+    // positions so earlier corrections in this pass are respected.
+    float* a = c->data + (size_t)c->h->sorted[ka] * c->stride;
+    float* b = c->data + (size_t)c->h->sorted[kb] * c->stride;
+    float dx = b[0] - a[0];
+    float dy = b[1] - a[1];
+    float dist2 = dx * dx + dy * dy;
+    if (dist2 >= c->diameter2) return;
+
+    float dist = sqrtf(dist2);
+    float nx = 1.0f, ny = 0.0f;
+    if (dist > 1e-6f) {
+        nx = dx / dist;
+        ny = dy / dist;
+    }
+
+    // Split the overlap evenly (equal masses)
+    float push = 0.5f * (c->diameter - dist);
+    a[0] -= nx * push;
+    a[1] -= ny * push;
+    b[0] += nx * push;
+    b[1] += ny * push;
+
+    // Exchange the normal velocity component only when approaching
+    float vrel = (b[2] - a[2]) * nx + (b[3] - a[3]) * ny;
+    if (vrel < 0.0f) {
+        float impulse = -c->bounce * vrel;
+        a[2] -= impulse * nx;
+        a[3] -= impulse * ny;
+        b[2] += impulse * nx;
+        b[3] += impulse * ny;
+    }
+    c->contacts++;
+}
+
+uint32_t afferent_spatial_hash_resolve_collisions(
+    AfferentSpatialHashRef h,
+    float* data,
+    uint32_t count,
+    uint32_t stride,
+    float radius,
+    float restitution
+) {
+    if (!h || !data || count == 0 || stride < 4 || !(radius > 0.0f)) return 0;
+    if (afferent_spatial_hash_rebuild(h, data, count, stride) != AFFERENT_OK) return 0;
+
+    float diameter = radius * 2.0f;
+    CollisionPass pass = {
+        h, data, stride, diameter, diameter * diameter, 0.5f * (1.0f + restitution), 0
+    };
+    for_each_candidate_pair(h, reach_for(h, diameter), visit_collision, &pass);
+    return pass.contacts;
+}
@@ -355,6 +355,8 @@ static inline void apply_transform(float px, float py, const float* t,
 // Generate vertex data for rendering text with transform support
 // Vertex format: pos.x, pos.y, uv.x, uv.y, r, g, b, a (8 floats per vertex)
 // Transform is [a, b, c, d, tx, ty] (6 floats), or NULL for identity
+// With an arena the output lives there (caller rewinds); otherwise it is
+// malloc'd and the caller must free it.
 // Returns number of vertices generated
 int afferent_text_generate_vertices(
     AfferentFontRef font,
@@ -365,6 +367,7 @@ int afferent_text_generate_vertices(
     float screen_width,
     float screen_height,
     const float* transform,
+    AfferentFrameArenaRef arena,
     float** out_vertices,
     uint32_t** out_indices,
     uint32_t* out_vertex_count,
@@ -390,13 +393,22 @@ int afferent_text_generate_vertices(
     }
 
     // Allocate max possible vertices (4 per character) and indices (6 per character)
-    float* vertices = malloc(text_len * 4 * 8 * sizeof(float));
-    uint32_t* indices = malloc(text_len * 6 * sizeof(uint32_t));
-
-    if (!vertices || !indices) {
-        free(vertices);
-        free(indices);
-        return 0;
+    float* vertices;
+    uint32_t* indices;
+    if (arena) {
+        vertices = afferent_frame_arena_alloc(arena, text_len * 4 * 8 * sizeof(float));
+        indices = afferent_frame_arena_alloc(arena, text_len * 6 * sizeof(uint32_t));
+        if (!vertices || !indices) {
+            return 0;
+        }
+    } else {
+        vertices = malloc(text_len * 4 * 8 * sizeof(float));
+        indices = malloc(text_len * 6 * sizeof(uint32_t));
+        if (!vertices || !indices) {
+            free(vertices);
+            free(indices);
+            return 0;
+        }
     }
 
     float cursor_x = x;
@@ -0,0 +1,216 @@
+/*
+ * VertexWriter - Growable native vertex and index storage
+ *
+ * Geometry built in Lean used to be accumulated into FloatArray/ByteArray
+ * batches (float64 vertices, re-pushed on every append) and narrowed to
+ * float32 when uploaded. The writer keeps the same data in native memory at
+ * upload precision: each emit writes float32 vertices and packed indices in
+ * place, growth is a doubling realloc, and drawing hands the storage to the
+ * GPU as-is.
+ *
+ * Indices follow the Batch rules: 16-bit until more than 65536 vertices
+ * have been emitted, then re-encoded once as 32-bit.
+ */
+
+#include "afferent.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WRITER_MIN_VERTICES 64
+#define WRITER_MIN_INDICES 96
+#define WRITER_U16_MAX_VERTICES 65536u
+
+struct AfferentVertexWriter {
+    float* vertices;
+    size_t vertex_count;
+    size_t vertex_capacity;
+    uint32_t stride;
+
+    void* indices;              // uint16_t or uint32_t per index_format
+    size_t index_count;
+    size_t index_capacity;
+    AfferentIndexFormat index_format;
+
+    size_t shape_base;          // First vertex of the current shape
+    uint64_t grows;
+};
+
+static inline size_t index_size(AfferentIndexFormat format) {
+    return format == AFFERENT_INDEX_U16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+static bool grow_vertices(AfferentVertexWriterRef w, size_t needed) {
+    if (needed <= w->vertex_capacity) return true;
+    size_t capacity = w->vertex_capacity * 2;
+    if (capacity < WRITER_MIN_VERTICES) capacity = WRITER_MIN_VERTICES;
+    if (capacity < needed) capacity = needed;
+    float* data = realloc(w->vertices, capacity * w->stride * sizeof(float));
+    if (!data) return false;
+    w->vertices = data;
+    w->vertex_capacity = capacity;
+    w->grows++;
+    return true;
+}
+
+static bool grow_indices(AfferentVertexWriterRef w, size_t needed) {
+    if (needed <= w->index_capacity) return true;
+    size_t capacity = w->index_capacity * 2;
+    if (capacity < WRITER_MIN_INDICES) capacity = WRITER_MIN_INDICES;
+    if (capacity < needed) capacity = needed;
+    void* data = realloc(w->indices, capacity * index_size(w->index_format));
+    if (!data) return false;
+    w->indices = data;
+    w->index_capacity = capacity;
+    w->grows++;
+    return true;
+}
+
+// Re-encode the indices as 32-bit, keeping the index capacity
+static bool widen_indices(AfferentVertexWriterRef w) {
+    size_t capacity = w->index_capacity > 0 ? w->index_capacity : WRITER_MIN_INDICES;
+    uint32_t* wide = malloc(capacity * sizeof(uint32_t));
+    if (!wide) return false;
+    const uint16_t* narrow = w->indices;
+    for (size_t i = 0; i < w->index_count; i++) wide[i] = narrow[i];
+    free(w->indices);
+    w->indices = wide;
+    w->index_capacity = capacity;
+    w->index_format = AFFERENT_INDEX_U32;
+    w->grows++;
+    return true;
+}
+
+static inline void put_index(AfferentVertexWriterRef w, size_t value) {
+    if (w->index_format == AFFERENT_INDEX_U16) {
+        ((uint16_t*)w->indices)[w->index_count++] = (uint16_t)value;
+    } else {
+        ((uint32_t*)w->indices)[w->index_count++] = (uint32_t)value;
+    }
+}
+
+AfferentResult afferent_vertex_writer_create(uint32_t stride, size_t vertex_capacity,
+    size_t index_capacity, AfferentVertexWriterRef* out) {
+    if (!out || stride == 0) return AFFERENT_ERROR_BUFFER_FAILED;
+
+    AfferentVertexWriterRef w = calloc(1, sizeof(struct AfferentVertexWriter));
+    if (!w) return AFFERENT_ERROR_BUFFER_FAILED;
+    w->stride = stride;
+    w->index_format = AFFERENT_INDEX_U16;
+    if (!grow_vertices(w, vertex_capacity) || !grow_indices(w, index_capacity)) {
+        afferent_vertex_writer_destroy(w);
+        return AFFERENT_ERROR_BUFFER_FAILED;
+    }
+    // Up-front reservation is not growth
+    w->grows = 0;
+
+    *out = w;
+    return AFFERENT_OK;
+}
+
+void afferent_vertex_writer_destroy(AfferentVertexWriterRef writer) {
+    if (writer) {
+        free(writer->vertices);
+        free(writer->indices);
+        free(writer);
+    }
+}
+
+void afferent_vertex_writer_clear(AfferentVertexWriterRef writer) {
+    writer->vertex_count = 0;
+    writer->index_count = 0;
+    writer->shape_base = 0;
+    if (writer->index_format == AFFERENT_INDEX_U32) {
+        // Same bytes now hold twice as many 16-bit indices
+        writer->index_capacity *= 2;
+        writer->index_format = AFFERENT_INDEX_U16;
+    }
+}
+
+void afferent_vertex_writer_begin_shape(AfferentVertexWriterRef writer) {
+    writer->shape_base = writer->vertex_count;
+}
+
+bool afferent_vertex_writer_reserve(AfferentVertexWriterRef writer, uint32_t vertices, uint32_t indices) {
+    size_t vertex_total = writer->vertex_count + vertices;
+    if (vertex_total > UINT32_MAX) return false;
+    if (writer->index_format == AFFERENT_INDEX_U16 && vertex_total > WRITER_U16_MAX_VERTICES) {
+        if (!widen_indices(writer)) return false;
+    }
+    return grow_vertices(writer, vertex_total) &&
+        grow_indices(writer, writer->index_count + indices);
+}
+
+float* afferent_vertex_writer_emit_vertices(AfferentVertexWriterRef writer, uint32_t count) {
+    if (!afferent_vertex_writer_reserve(writer, count, 0)) return NULL;
+    float* out = writer->vertices + writer->vertex_count * writer->stride;
+    writer->vertex_count += count;
+    return out;
+}
+
+bool afferent_vertex_writer_emit_tri(AfferentVertexWriterRef writer, uint32_t a, uint32_t b, uint32_t c) {
+    size_t available = writer->vertex_count - writer->shape_base;
+    if (a >= available || b >= available || c >= available) return false;
+    if (!grow_indices(writer, writer->index_count + 3)) return false;
+    size_t base = writer->shape_base;
+    put_index(writer, base + a);
+    put_index(writer, base + b);
+    put_index(writer, base + c);
+    return true;
+}
+
+bool afferent_vertex_writer_emit_quad(AfferentVertexWriterRef writer, const float* corners, const float* color) {
+    if (writer->stride != 6) return false;
+    if (!afferent_vertex_writer_reserve(writer, 4, 6)) return false;
+    size_t base = writer->vertex_count;
+    float* v = writer->vertices + base * 6;
+    for (int i = 0; i < 4; i++) {
+        v[0] = corners[i * 2];
+        v[1] = corners[i * 2 + 1];
+        memcpy(v + 2, color, 4 * sizeof(float));
+        v += 6;
+    }
+    writer->vertex_count += 4;
+    put_index(writer, base);
+    put_index(writer, base + 1);
+    put_index(writer, base + 2);
+    put_index(writer, base);
+    put_index(writer, base + 2);
+    put_index(writer, base + 3);
+    return true;
+}
+
+uint32_t afferent_vertex_writer_vertex_count(AfferentVertexWriterRef writer) {
+    return (uint32_t)writer->vertex_count;
+}
+
+uint32_t afferent_vertex_writer_index_count(AfferentVertexWriterRef writer) {
+    return (uint32_t)writer->index_count;
+}
+
+uint32_t afferent_vertex_writer_stride(AfferentVertexWriterRef writer) {
+    return writer->stride;
+}
+
+AfferentIndexFormat afferent_vertex_writer_index_format(AfferentVertexWriterRef writer) {
+    return writer->index_format;
+}
+
+const float* afferent_vertex_writer_vertices(AfferentVertexWriterRef writer) {
+    return writer->vertices;
+}
+
+const void* afferent_vertex_writer_indices(AfferentVertexWriterRef writer) {
+    return writer->indices;
+}
+
+void afferent_vertex_writer_get_stats(AfferentVertexWriterRef writer, AfferentVertexWriterStats* out) {
+    out->vertex_count = writer->vertex_count;
+    out->index_count = writer->index_count;
+    out->vertex_capacity = writer->vertex_capacity;
+    out->index_capacity = writer->index_capacity;
+    out->bytes_reserved = writer->vertex_capacity * writer->stride * sizeof(float) +
+        writer->index_capacity * index_size(writer->index_format);
+    out->grows = writer->grows;
+    out->stride = writer->stride;
+    out->index_format = writer->index_format;
+}
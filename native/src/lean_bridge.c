@@ -36,6 +36,13 @@ static lean_external_class* g_buffer_class = NULL;
 static lean_external_class* g_font_class = NULL;
 static lean_external_class* g_float_buffer_class = NULL;
 static lean_external_class* g_texture_class = NULL;
+static lean_external_class* g_packed_buffer_class = NULL;
+static lean_external_class* g_spatial_hash_class = NULL;
+static lean_external_class* g_particle_system_class = NULL;
+static lean_external_class* g_fixed_stepper_class = NULL;
+static lean_external_class* g_mesh_class = NULL;
+static lean_external_class* g_frame_arena_class = NULL;
+static lean_external_class* g_vertex_writer_class = NULL;
 static uint8_t g_afferent_initialized = 0;
 
 // Weak reference so we don't double-free if Lean GC happens after explicit destroy
@@ -72,6 +79,34 @@ static void texture_finalizer(void* ptr) {
     // Same as above
 }
 
+static void packed_buffer_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void spatial_hash_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void particle_system_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void fixed_stepper_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void mesh_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void frame_arena_finalizer(void* ptr) {
+    // Same as above
+}
+
+static void vertex_writer_finalizer(void* ptr) {
+    // Same as above
+}
+
 static void afferent_ensure_initialized(void) {
     if (g_afferent_initialized) return;
 
@@ -81,6 +116,13 @@ static void afferent_ensure_initialized(void) {
     g_font_class = lean_register_external_class(font_finalizer, afferent_external_foreach);
     g_float_buffer_class = lean_register_external_class(float_buffer_finalizer, afferent_external_foreach);
     g_texture_class = lean_register_external_class(texture_finalizer, afferent_external_foreach);
+    g_packed_buffer_class = lean_register_external_class(packed_buffer_finalizer, afferent_external_foreach);
+    g_spatial_hash_class = lean_register_external_class(spatial_hash_finalizer, afferent_external_foreach);
+    g_particle_system_class = lean_register_external_class(particle_system_finalizer, afferent_external_foreach);
+    g_fixed_stepper_class = lean_register_external_class(fixed_stepper_finalizer, afferent_external_foreach);
+    g_mesh_class = lean_register_external_class(mesh_finalizer, afferent_external_foreach);
+    g_frame_arena_class = lean_register_external_class(frame_arena_finalizer, afferent_external_foreach);
+    g_vertex_writer_class = lean_register_external_class(vertex_writer_finalizer, afferent_external_foreach);
 
     // Initialize text subsystem
     afferent_text_init();
@@ -129,6 +171,25 @@ LEAN_EXPORT lean_obj_res lean_afferent_window_create(
     return lean_io_result_mk_ok(obj);
 }
 
+// Headless window (no display; for benchmarks)
+LEAN_EXPORT lean_obj_res lean_afferent_window_create_headless(
+    uint32_t width,
+    uint32_t height,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentWindowRef window = NULL;
+    AfferentResult result = afferent_window_create_headless(width, height, &window);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create headless window")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_window_class, window);
+    return lean_io_result_mk_ok(obj);
+}
+
 // Window destroy
 LEAN_EXPORT lean_obj_res lean_afferent_window_destroy(lean_obj_arg window_obj, lean_obj_arg world) {
     AfferentWindowRef window = (AfferentWindowRef)lean_get_external_data(window_obj);
@@ -378,6 +439,42 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_end_frame(lean_obj_arg renderer_
     return lean_io_result_mk_ok(lean_box(0));
 }
 
+// ============== Frame arena scratch ==============
+// Transient conversions borrow memory from the renderer's frame arena: take a
+// mark, convert, hand the data to the backend (which copies it), then rewind.
+// A call costs a pointer bump instead of a malloc/free pair.
+
+// Boxed Array Float -> float scratch; NULL on OOM
+static float* scratch_floats(AfferentFrameArenaRef arena, b_lean_obj_arg arr, size_t count) {
+    float* out = afferent_frame_arena_alloc(arena, count * sizeof(float));
+    if (out) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = (float)lean_unbox_float(lean_array_get_core(arr, i));
+        }
+    }
+    return out;
+}
+
+// FloatArray -> float scratch (SIMD narrow); NULL on OOM
+static float* scratch_narrow(AfferentFrameArenaRef arena, b_lean_obj_arg float_arr, size_t count) {
+    float* out = afferent_frame_arena_alloc(arena, count * sizeof(float));
+    if (out) {
+        afferent_narrow_f64_to_f32(lean_float_array_cptr(float_arr), out, count);
+    }
+    return out;
+}
+
+// Array UInt32 (elements [first, first + count)) -> index scratch; NULL on OOM
+static uint32_t* scratch_indices(AfferentFrameArenaRef arena, b_lean_obj_arg arr, size_t first, size_t count) {
+    uint32_t* out = afferent_frame_arena_alloc(arena, count * sizeof(uint32_t));
+    if (out) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = lean_unbox_uint32(lean_array_get_core(arr, first + i));
+        }
+    }
+    return out;
+}
+
 // Create vertex buffer from Float array
 // Each vertex is 6 floats: position[2], color[4]
 LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_vertex(
@@ -396,27 +493,18 @@ LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_vertex(
             lean_mk_string("Empty vertex array")));
     }
 
-    AfferentVertex* vertices = malloc(vertex_count * sizeof(AfferentVertex));
+    // AfferentVertex is 6 packed floats: position[2], color[4]
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex* vertices = (AfferentVertex*)scratch_floats(arena, vertices_arr, vertex_count * 6);
     if (!vertices) {
         return lean_io_result_mk_error(lean_mk_io_user_error(
             lean_mk_string("Failed to allocate vertex memory")));
     }
 
-    for (size_t i = 0; i < vertex_count; i++) {
-        size_t base = i * 6;
-        // Position
-        vertices[i].position[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 0));
-        vertices[i].position[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 1));
-        // Color
-        vertices[i].color[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 2));
-        vertices[i].color[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 3));
-        vertices[i].color[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 4));
-        vertices[i].color[3] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 5));
-    }
-
     AfferentBufferRef buffer = NULL;
     AfferentResult result = afferent_buffer_create_vertex(renderer, vertices, (uint32_t)vertex_count, &buffer);
-    free(vertices);
+    afferent_frame_arena_rewind(arena, scratch);
 
     if (result != AFFERENT_OK) {
         return lean_io_result_mk_error(lean_mk_io_user_error(
@@ -442,19 +530,132 @@ LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_index(
             lean_mk_string("Empty index array")));
     }
 
-    uint32_t* indices = malloc(count * sizeof(uint32_t));
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    uint32_t* indices = scratch_indices(arena, indices_arr, 0, count);
     if (!indices) {
         return lean_io_result_mk_error(lean_mk_io_user_error(
             lean_mk_string("Failed to allocate index memory")));
     }
 
-    for (size_t i = 0; i < count; i++) {
-        indices[i] = lean_unbox_uint32(lean_array_get_core(indices_arr, i));
+    AfferentBufferRef buffer = NULL;
+    AfferentResult result = afferent_buffer_create_index(renderer, indices, (uint32_t)count, &buffer);
+    afferent_frame_arena_rewind(arena, scratch);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create index buffer")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_buffer_class, buffer);
+    return lean_io_result_mk_ok(obj);
+}
+
+// Create vertex buffer from FloatArray (unboxed doubles, 6 per vertex)
+// AfferentVertex is 6 packed floats, so the data narrows straight into place.
+LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_vertex_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg vertices_arr,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+
+    size_t arr_size = (size_t)lean_unbox(lean_float_array_size(vertices_arr));
+    size_t vertex_count = arr_size / 6;
+
+    if (vertex_count == 0) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Empty vertex array")));
+    }
+
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex* vertices = (AfferentVertex*)scratch_narrow(arena, vertices_arr, vertex_count * 6);
+    if (!vertices) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate vertex memory")));
+    }
+
+    AfferentBufferRef buffer = NULL;
+    AfferentResult result = afferent_buffer_create_vertex(renderer, vertices, (uint32_t)vertex_count, &buffer);
+    afferent_frame_arena_rewind(arena, scratch);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create vertex buffer")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_buffer_class, buffer);
+    return lean_io_result_mk_ok(obj);
+}
+
+// Create index buffer from ByteArray (little-endian u32 per index)
+LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_index_byte_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg indices_arr,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+
+    size_t count = lean_sarray_size(indices_arr) / sizeof(uint32_t);
+    if (count == 0) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Empty index array")));
+    }
+
+    // ByteArray data is only byte-aligned in principle; copy instead of casting
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    uint32_t* indices = afferent_frame_arena_alloc(arena, count * sizeof(uint32_t));
+    if (!indices) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate index memory")));
     }
+    memcpy(indices, lean_sarray_cptr(indices_arr), count * sizeof(uint32_t));
 
     AfferentBufferRef buffer = NULL;
     AfferentResult result = afferent_buffer_create_index(renderer, indices, (uint32_t)count, &buffer);
-    free(indices);
+    afferent_frame_arena_rewind(arena, scratch);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create index buffer")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_buffer_class, buffer);
+    return lean_io_result_mk_ok(obj);
+}
+
+// Create index buffer from ByteArray (little-endian u16 per index)
+LEAN_EXPORT lean_obj_res lean_afferent_buffer_create_index_u16_byte_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg indices_arr,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+
+    size_t count = lean_sarray_size(indices_arr) / sizeof(uint16_t);
+    if (count == 0) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Empty index array")));
+    }
+
+    // Same as above: copy through the arena rather than casting the byte data
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    uint16_t* indices = afferent_frame_arena_alloc(arena, count * sizeof(uint16_t));
+    if (!indices) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate index memory")));
+    }
+    memcpy(indices, lean_sarray_cptr(indices_arr), count * sizeof(uint16_t));
+
+    AfferentBufferRef buffer = NULL;
+    AfferentResult result = afferent_buffer_create_index_u16(renderer, indices, (uint32_t)count, &buffer);
+    afferent_frame_arena_rewind(arena, scratch);
 
     if (result != AFFERENT_OK) {
         return lean_io_result_mk_error(lean_mk_io_user_error(
@@ -488,10 +689,6 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_triangles(
     return lean_io_result_mk_ok(lean_box(0));
 }
 
-// Reusable buffer for instanced rendering (avoids per-frame malloc)
-static float* g_instance_buffer = NULL;
-static size_t g_instance_buffer_capacity = 0;
-
 // Draw instanced rectangles - GPU-accelerated transforms
 // instance_data_arr: Array Float with 8 floats per instance
 //   (pos.x, pos.y, angle, halfSize, r, g, b, a)
@@ -510,24 +707,14 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_rects(
         return lean_io_result_mk_ok(lean_box(0));  // Silent fail on invalid input
     }
 
-    // Reuse or grow the static buffer
-    if (arr_size > g_instance_buffer_capacity) {
-        free(g_instance_buffer);
-        g_instance_buffer = malloc(arr_size * sizeof(float));
-        g_instance_buffer_capacity = g_instance_buffer ? arr_size : 0;
-    }
-
-    if (!g_instance_buffer) {
-        return lean_io_result_mk_ok(lean_box(0));
-    }
-
-    // Convert Lean array to float array (reusing buffer)
-    for (size_t i = 0; i < arr_size; i++) {
-        g_instance_buffer[i] = (float)lean_unbox_float(lean_array_get_core(instance_data_arr, i));
+    // Convert Lean array to float array in frame scratch
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, instance_data_arr, expected_size);
+    if (data) {
+        afferent_renderer_draw_instanced_rects(renderer, data, instance_count);
     }
-
-    afferent_renderer_draw_instanced_rects(renderer, g_instance_buffer, instance_count);
-    // Don't free - reuse next frame
+    afferent_frame_arena_rewind(arena, scratch);
 
     return lean_io_result_mk_ok(lean_box(0));
 }
@@ -548,21 +735,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_triangles(
         return lean_io_result_mk_ok(lean_box(0));
     }
 
-    if (arr_size > g_instance_buffer_capacity) {
-        free(g_instance_buffer);
-        g_instance_buffer = malloc(arr_size * sizeof(float));
-        g_instance_buffer_capacity = g_instance_buffer ? arr_size : 0;
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, instance_data_arr, expected_size);
+    if (data) {
+        afferent_renderer_draw_instanced_triangles(renderer, data, instance_count);
     }
-
-    if (!g_instance_buffer) {
-        return lean_io_result_mk_ok(lean_box(0));
-    }
-
-    for (size_t i = 0; i < arr_size; i++) {
-        g_instance_buffer[i] = (float)lean_unbox_float(lean_array_get_core(instance_data_arr, i));
-    }
-
-    afferent_renderer_draw_instanced_triangles(renderer, g_instance_buffer, instance_count);
+    afferent_frame_arena_rewind(arena, scratch);
 
     return lean_io_result_mk_ok(lean_box(0));
 }
@@ -583,22 +762,79 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_circles(
         return lean_io_result_mk_ok(lean_box(0));
     }
 
-    if (arr_size > g_instance_buffer_capacity) {
-        free(g_instance_buffer);
-        g_instance_buffer = malloc(arr_size * sizeof(float));
-        g_instance_buffer_capacity = g_instance_buffer ? arr_size : 0;
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, instance_data_arr, expected_size);
+    if (data) {
+        afferent_renderer_draw_instanced_circles(renderer, data, instance_count);
     }
+    afferent_frame_arena_rewind(arena, scratch);
 
-    if (!g_instance_buffer) {
-        return lean_io_result_mk_ok(lean_box(0));
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Narrow FloatArray instance data into frame scratch.
+// Returns NULL (draw nothing) on short input or allocation failure.
+static const float* instance_data_from_float_array(AfferentFrameArenaRef arena, lean_obj_arg data_arr,
+    uint32_t instance_count) {
+    size_t arr_size = (size_t)lean_unbox(lean_float_array_size(data_arr));
+    size_t expected_size = (size_t)instance_count * 8;
+
+    if (arr_size < expected_size || instance_count == 0) {
+        return NULL;
     }
+    return scratch_narrow(arena, data_arr, expected_size);
+}
 
-    for (size_t i = 0; i < arr_size; i++) {
-        g_instance_buffer[i] = (float)lean_unbox_float(lean_array_get_core(instance_data_arr, i));
+// Draw instanced rectangles from FloatArray (8 floats per instance, same layout as above)
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_rects_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg instance_data_arr,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = instance_data_from_float_array(arena, instance_data_arr, instance_count);
+    if (data) {
+        afferent_renderer_draw_instanced_rects(renderer, data, instance_count);
     }
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
 
-    afferent_renderer_draw_instanced_circles(renderer, g_instance_buffer, instance_count);
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_triangles_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg instance_data_arr,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = instance_data_from_float_array(arena, instance_data_arr, instance_count);
+    if (data) {
+        afferent_renderer_draw_instanced_triangles(renderer, data, instance_count);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
 
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_circles_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg instance_data_arr,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = instance_data_from_float_array(arena, instance_data_arr, instance_count);
+    if (data) {
+        afferent_renderer_draw_instanced_circles(renderer, data, instance_count);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -853,6 +1089,55 @@ LEAN_EXPORT lean_obj_res lean_afferent_float_buffer_write_sprites_from_particles
     return lean_io_result_mk_ok(lean_box(0));
 }
 
+// Copy floats between FloatBuffers (ranges are checked against capacity)
+LEAN_EXPORT lean_obj_res lean_afferent_float_buffer_copy(
+    b_lean_obj_arg dst_obj,
+    size_t dst_index,
+    b_lean_obj_arg src_obj,
+    size_t src_index,
+    size_t count,
+    lean_obj_arg world
+) {
+    AfferentFloatBufferRef dst = (AfferentFloatBufferRef)lean_get_external_data(dst_obj);
+    AfferentFloatBufferRef src = (AfferentFloatBufferRef)lean_get_external_data(src_obj);
+    size_t dst_cap = afferent_float_buffer_capacity(dst);
+    size_t src_cap = afferent_float_buffer_capacity(src);
+    if (dst_index > dst_cap || count > dst_cap - dst_index ||
+        src_index > src_cap || count > src_cap - src_index) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("FloatBuffer copy out of range")));
+    }
+    afferent_float_buffer_copy(dst, dst_index, src, src_index, count);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Update bouncing physics in place in the particle FloatArray itself.
+// Takes ownership of the array and returns it; the update is in place when
+// the caller held the only reference, otherwise it runs on a fresh copy.
+LEAN_EXPORT lean_obj_res lean_afferent_particles_update_bouncing(
+    lean_obj_arg particle_data_arr,
+    uint32_t count,
+    double dt,
+    double radius,
+    double screenWidth,
+    double screenHeight,
+    lean_obj_arg world
+) {
+    if (!lean_is_exclusive(particle_data_arr)) {
+        lean_object* copy = lean_copy_float_array(particle_data_arr);
+        particle_data_arr = copy;
+    }
+
+    size_t arr_size = (size_t)lean_unbox(lean_float_array_size(particle_data_arr));
+    if ((size_t)count * 5 > arr_size) {
+        count = (uint32_t)(arr_size / 5);
+    }
+
+    afferent_particles_update_bouncing(lean_float_array_cptr(particle_data_arr), count,
+        dt, radius, screenWidth, screenHeight);
+    return lean_io_result_mk_ok(particle_data_arr);
+}
+
 // ============================================================================
 // FUSED PHYSICS + PACKING (FloatArray particle state -> FloatBuffer instances)
 // ============================================================================
@@ -877,7 +1162,6 @@ LEAN_EXPORT lean_obj_res lean_afferent_particles_update_bouncing_and_write_sprit
     // Ensure exclusive so in-place mutation is safe.
     if (!lean_is_exclusive(particle_data_arr)) {
         lean_object* copy = lean_copy_float_array(particle_data_arr);
-        lean_dec(particle_data_arr);
         particle_data_arr = copy;
     }
 
@@ -950,7 +1234,6 @@ LEAN_EXPORT lean_obj_res lean_afferent_particles_update_bouncing_and_write_circl
 
     if (!lean_is_exclusive(particle_data_arr)) {
         lean_object* copy = lean_copy_float_array(particle_data_arr);
-        lean_dec(particle_data_arr);
         particle_data_arr = copy;
     }
 
@@ -1005,54 +1288,1763 @@ LEAN_EXPORT lean_obj_res lean_afferent_particles_update_bouncing_and_write_circl
     return lean_io_result_mk_ok(particle_data_arr);
 }
 
-// Draw instanced shapes directly from FloatBuffer (zero-copy path)
-LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_rects_buffer(
-    lean_obj_arg renderer_obj,
-    lean_obj_arg buffer_obj,
-    uint32_t instance_count,
+// ============== PackedBuffer FFI ==============
+// Schema-driven packed instance data (f32 / f16 / unorm8x4 / snorm16 fields)
+
+// schema_arr: ByteArray of AfferentFieldEncoding values, one per field.
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_create(
+    b_lean_obj_arg schema_arr,
+    size_t capacity,
     lean_obj_arg world
 ) {
-    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
-    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    afferent_ensure_initialized();
+    size_t field_count = lean_sarray_size(schema_arr);
+    AfferentPackedBufferRef buffer = NULL;
+    AfferentResult result = afferent_packed_buffer_create(
+        lean_sarray_cptr(schema_arr), (uint32_t)field_count, capacity, &buffer);
 
-    // Direct pointer pass - no conversion needed!
-    afferent_renderer_draw_instanced_rects(
-        renderer,
-        afferent_float_buffer_data(buffer),
-        instance_count
-    );
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create packed buffer")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_packed_buffer_class, buffer);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_destroy(lean_obj_arg buffer_obj, lean_obj_arg world) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    afferent_packed_buffer_destroy(buffer);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
-LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_triangles_buffer(
-    lean_obj_arg renderer_obj,
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_capacity(lean_obj_arg buffer_obj, lean_obj_arg world) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    return lean_io_result_mk_ok(lean_box_usize(afferent_packed_buffer_capacity(buffer)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_stride(lean_obj_arg buffer_obj, lean_obj_arg world) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_packed_buffer_stride(buffer)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_floats_per_instance(lean_obj_arg buffer_obj, lean_obj_arg world) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_packed_buffer_floats_per_instance(buffer)));
+}
+
+// Pack instances from a FloatArray (doubles narrowed to f32 before encoding).
+// Returns bytes written; count is clamped to what the array holds.
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_pack_float_array(
     lean_obj_arg buffer_obj,
-    uint32_t instance_count,
+    size_t first,
+    b_lean_obj_arg src_arr,
+    size_t count,
     lean_obj_arg world
 ) {
-    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
-    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    size_t floats = afferent_packed_buffer_floats_per_instance(buffer);
+    size_t available = (size_t)lean_unbox(lean_float_array_size(src_arr)) / floats;
+    if (count > available) count = available;
 
-    afferent_renderer_draw_instanced_triangles(
-        renderer,
-        afferent_float_buffer_data(buffer),
-        instance_count
-    );
-    return lean_io_result_mk_ok(lean_box(0));
+    size_t written = afferent_packed_buffer_pack_f64(buffer, first, lean_float_array_cptr(src_arr), count);
+    return lean_io_result_mk_ok(lean_box_usize(written));
 }
 
-LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_circles_buffer(
-    lean_obj_arg renderer_obj,
+// Pack instances straight from a FloatBuffer (no Lean-side copy). Returns bytes written.
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_pack_from_float_buffer(
     lean_obj_arg buffer_obj,
-    uint32_t instance_count,
+    size_t first,
+    lean_obj_arg src_obj,
+    size_t count,
     lean_obj_arg world
 ) {
-    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
-    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    AfferentFloatBufferRef src = (AfferentFloatBufferRef)lean_get_external_data(src_obj);
+    size_t written = afferent_packed_buffer_pack_from_float_buffer(buffer, first, src, count);
+    return lean_io_result_mk_ok(lean_box_usize(written));
+}
 
-    afferent_renderer_draw_instanced_circles(
-        renderer,
-        afferent_float_buffer_data(buffer),
+// Decode instances back into a fresh FloatArray (floats_per_instance doubles each).
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_unpack_float_array(
+    lean_obj_arg buffer_obj,
+    size_t first,
+    size_t count,
+    lean_obj_arg world
+) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    size_t capacity = afferent_packed_buffer_capacity(buffer);
+    if (first >= capacity) {
+        count = 0;
+    } else if (count > capacity - first) {
+        count = capacity - first;
+    }
+
+    size_t n = count * afferent_packed_buffer_floats_per_instance(buffer);
+    lean_object* arr = lean_alloc_sarray(sizeof(double), n, n);
+    afferent_packed_buffer_unpack_f64(buffer, first, lean_float_array_cptr(arr), count);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Copy the raw packed bytes of [first, first + count) into a ByteArray.
+LEAN_EXPORT lean_obj_res lean_afferent_packed_buffer_to_byte_array(
+    lean_obj_arg buffer_obj,
+    size_t first,
+    size_t count,
+    lean_obj_arg world
+) {
+    AfferentPackedBufferRef buffer = (AfferentPackedBufferRef)lean_get_external_data(buffer_obj);
+    size_t capacity = afferent_packed_buffer_capacity(buffer);
+    if (first >= capacity) {
+        count = 0;
+    } else if (count > capacity - first) {
+        count = capacity - first;
+    }
+
+    size_t stride = afferent_packed_buffer_stride(buffer);
+    size_t n = count * stride;
+    lean_object* arr = lean_alloc_sarray(1, n, n);
+    if (n > 0) {
+        memcpy(lean_sarray_cptr(arr), afferent_packed_buffer_data(buffer) + first * stride, n);
+    }
+    return lean_io_result_mk_ok(arr);
+}
+
+// ============== SpatialHash FFI ==============
+// Uniform-grid neighbor queries over particle FloatBuffers ([x, y, ...] per particle)
+
+// Number of whole particles a FloatBuffer can hold at `stride`, clamped to `count`.
+static uint32_t float_buffer_particle_count(AfferentFloatBufferRef buffer, uint32_t count, uint32_t stride) {
+    if (!buffer || stride == 0) return 0;
+    size_t available = afferent_float_buffer_capacity(buffer) / stride;
+    return (size_t)count < available ? count : (uint32_t)available;
+}
+
+static lean_object* mk_uint32_array(const uint32_t* values, size_t n) {
+    lean_object* arr = lean_alloc_array(n, n);
+    lean_object** items = lean_array_cptr(arr);
+    for (size_t i = 0; i < n; i++) {
+        items[i] = lean_box_uint32(values[i]);
+    }
+    return arr;
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_create(double cell_size, lean_obj_arg world) {
+    afferent_ensure_initialized();
+    AfferentSpatialHashRef hash = NULL;
+    AfferentResult result = afferent_spatial_hash_create((float)cell_size, &hash);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create spatial hash (cell size must be > 0)")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_spatial_hash_class, hash);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_destroy(lean_obj_arg hash_obj, lean_obj_arg world) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    afferent_spatial_hash_destroy(hash);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_cell_size(lean_obj_arg hash_obj, lean_obj_arg world) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    return lean_io_result_mk_ok(lean_box_float((double)afferent_spatial_hash_cell_size(hash)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_rebuild(
+    lean_obj_arg hash_obj,
+    lean_obj_arg buffer_obj,
+    uint32_t count,
+    uint32_t stride,
+    lean_obj_arg world
+) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    if (stride < 2) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to rebuild spatial hash (stride must be >= 2)")));
+    }
+    count = float_buffer_particle_count(buffer, count, stride);
+
+    if (afferent_spatial_hash_rebuild(hash, afferent_float_buffer_data(buffer), count, stride) != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to rebuild spatial hash")));
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Indices of particles within `radius` of (x, y), at most max_results of them.
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_query_radius(
+    lean_obj_arg hash_obj,
+    double x,
+    double y,
+    double radius,
+    uint32_t max_results,
+    lean_obj_arg world
+) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    uint32_t* results = max_results > 0 ? malloc((size_t)max_results * sizeof(uint32_t)) : NULL;
+    if (max_results > 0 && !results) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate spatial hash query results")));
+    }
+
+    uint32_t found = afferent_spatial_hash_query_radius(hash, (float)x, (float)y, (float)radius,
+        results, max_results);
+    lean_object* arr = mk_uint32_array(results, found < max_results ? found : max_results);
+    free(results);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Pairs at most `radius` apart, flattened as [i0, j0, i1, j1, ...] (i < j), at most max_pairs.
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_query_pairs(
+    lean_obj_arg hash_obj,
+    double radius,
+    uint32_t max_pairs,
+    lean_obj_arg world
+) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    uint32_t* pairs = max_pairs > 0 ? malloc((size_t)max_pairs * 2 * sizeof(uint32_t)) : NULL;
+    if (max_pairs > 0 && !pairs) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate spatial hash pair results")));
+    }
+
+    uint64_t found = afferent_spatial_hash_query_pairs(hash, (float)radius, pairs, max_pairs);
+    uint64_t kept = found < max_pairs ? found : max_pairs;
+    lean_object* arr = mk_uint32_array(pairs, (size_t)kept * 2);
+    free(pairs);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Number of pairs at most `radius` apart (no result storage).
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_count_pairs(
+    lean_obj_arg hash_obj,
+    double radius,
+    lean_obj_arg world
+) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    uint64_t found = afferent_spatial_hash_query_pairs(hash, (float)radius, NULL, 0);
+    return lean_io_result_mk_ok(lean_box_uint64(found));
+}
+
+// Rebuild and resolve disc collisions in place. Layout: [x, y, vx, vy, ...] (stride >= 4).
+LEAN_EXPORT lean_obj_res lean_afferent_spatial_hash_resolve_collisions(
+    lean_obj_arg hash_obj,
+    lean_obj_arg buffer_obj,
+    uint32_t count,
+    uint32_t stride,
+    double radius,
+    double restitution,
+    lean_obj_arg world
+) {
+    AfferentSpatialHashRef hash = (AfferentSpatialHashRef)lean_get_external_data(hash_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    count = float_buffer_particle_count(buffer, count, stride);
+
+    uint32_t contacts = afferent_spatial_hash_resolve_collisions(hash,
+        (float*)afferent_float_buffer_data(buffer), count, stride, (float)radius, (float)restitution);
+    return lean_io_result_mk_ok(lean_box_uint32(contacts));
+}
+
+// ============== ParticleSystem FFI ==============
+// Emitter-driven particles; each step writes the live range into a FloatBuffer
+
+#define PARTICLE_EMITTER_PARAMS 16
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_create(
+    uint32_t capacity,
+    uint32_t seed,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentParticleSystemRef sys = NULL;
+    AfferentResult result = afferent_particle_system_create(capacity, seed, &sys);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create particle system")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_particle_system_class, sys);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_destroy(lean_obj_arg sys_obj, lean_obj_arg world) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_destroy(sys);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_clear(lean_obj_arg sys_obj, lean_obj_arg world) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_clear(sys);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_live_count(lean_obj_arg sys_obj, lean_obj_arg world) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_particle_system_live_count(sys)));
+}
+
+// Stats as [live, totalSpawned, totalDied, totalDropped].
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_stats(lean_obj_arg sys_obj, lean_obj_arg world) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    AfferentParticleStats stats;
+    afferent_particle_system_get_stats(sys, &stats);
+
+    lean_object* arr = lean_alloc_array(4, 4);
+    lean_object** items = lean_array_cptr(arr);
+    items[0] = lean_box_uint64((uint64_t)stats.live);
+    items[1] = lean_box_uint64(stats.total_spawned);
+    items[2] = lean_box_uint64(stats.total_died);
+    items[3] = lean_box_uint64(stats.total_dropped);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Emitter parameters arrive as a FloatArray in AfferentEmitterDesc field order.
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_add_emitter(
+    lean_obj_arg sys_obj,
+    b_lean_obj_arg params_arr,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    size_t n = lean_unbox(lean_float_array_size(params_arr));
+    if (n < PARTICLE_EMITTER_PARAMS) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to add emitter (expected 16 parameters)")));
+    }
+
+    const double* p = lean_float_array_cptr(params_arr);
+    float fields[PARTICLE_EMITTER_PARAMS];
+    for (size_t i = 0; i < PARTICLE_EMITTER_PARAMS; i++) {
+        fields[i] = (float)p[i];
+    }
+    AfferentEmitterDesc desc;
+    memcpy(&desc, fields, sizeof(desc));
+
+    int32_t index = afferent_particle_system_add_emitter(sys, &desc);
+    if (index < 0) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to add emitter")));
+    }
+    return lean_io_result_mk_ok(lean_box_uint32((uint32_t)index));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_emitter_position(
+    lean_obj_arg sys_obj,
+    uint32_t emitter,
+    double x,
+    double y,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_emitter_position(sys, emitter, (float)x, (float)y);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_emitter_rate(
+    lean_obj_arg sys_obj,
+    uint32_t emitter,
+    double rate,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_emitter_rate(sys, emitter, (float)rate);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_emitter_active(
+    lean_obj_arg sys_obj,
+    uint32_t emitter,
+    uint8_t active,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_emitter_active(sys, emitter, active != 0);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_burst(
+    lean_obj_arg sys_obj,
+    uint32_t emitter,
+    uint32_t count,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    uint32_t spawned = afferent_particle_system_burst(sys, emitter, count);
+    return lean_io_result_mk_ok(lean_box_uint32(spawned));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_gravity(
+    lean_obj_arg sys_obj,
+    double gx,
+    double gy,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_gravity(sys, (float)gx, (float)gy);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_drag(
+    lean_obj_arg sys_obj,
+    double drag,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_drag(sys, (float)drag);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_add_attractor(
+    lean_obj_arg sys_obj,
+    double x,
+    double y,
+    double strength,
+    double softening,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    int32_t index = afferent_particle_system_add_attractor(sys, (float)x, (float)y,
+        (float)strength, (float)softening);
+    if (index < 0) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to add attractor (limit is 8)")));
+    }
+    return lean_io_result_mk_ok(lean_box_uint32((uint32_t)index));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_set_attractor(
+    lean_obj_arg sys_obj,
+    uint32_t attractor,
+    double x,
+    double y,
+    double strength,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_set_attractor(sys, attractor, (float)x, (float)y, (float)strength);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_clear_attractors(lean_obj_arg sys_obj, lean_obj_arg world) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    afferent_particle_system_clear_attractors(sys);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Step and write live particles into the FloatBuffer. Returns the live count.
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_step(
+    lean_obj_arg sys_obj,
+    double dt,
+    lean_obj_arg buffer_obj,
+    uint8_t layout,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    uint32_t live = afferent_particle_system_step(sys, (float)dt,
+        (float*)afferent_float_buffer_data(buffer), afferent_float_buffer_capacity(buffer),
+        (AfferentParticleLayout)layout);
+    return lean_io_result_mk_ok(lean_box_uint32(live));
+}
+
+// Write live particles without stepping. Returns the number written.
+LEAN_EXPORT lean_obj_res lean_afferent_particle_system_write(
+    lean_obj_arg sys_obj,
+    lean_obj_arg buffer_obj,
+    uint8_t layout,
+    lean_obj_arg world
+) {
+    AfferentParticleSystemRef sys = (AfferentParticleSystemRef)lean_get_external_data(sys_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    uint32_t written = afferent_particle_system_write(sys,
+        (float*)afferent_float_buffer_data(buffer), afferent_float_buffer_capacity(buffer),
+        (AfferentParticleLayout)layout);
+    return lean_io_result_mk_ok(lean_box_uint32(written));
+}
+
+// ============== FixedStepper FFI ==============
+// Fixed-timestep bouncing particles with interpolated instance output
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_create(
+    uint32_t count,
+    double fixed_dt,
+    uint32_t max_substeps,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentFixedStepperRef stepper = NULL;
+    AfferentResult result = afferent_fixed_stepper_create(count, (float)fixed_dt, max_substeps, &stepper);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create fixed stepper (count and step must be > 0)")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_fixed_stepper_class, stepper);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_destroy(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    afferent_fixed_stepper_destroy(stepper);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_set_bounds(
+    lean_obj_arg stepper_obj,
+    double width,
+    double height,
+    double radius,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    afferent_fixed_stepper_set_bounds(stepper, (float)width, (float)height, (float)radius);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_init_random(
+    lean_obj_arg stepper_obj,
+    double width,
+    double height,
+    double max_speed,
+    uint32_t seed,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    afferent_fixed_stepper_init_random(stepper, (float)width, (float)height, (float)max_speed, seed);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// data: FloatArray [x, y, vx, vy, hue] per particle (e.g. ParticleState.data).
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_load(
+    lean_obj_arg stepper_obj,
+    b_lean_obj_arg data_arr,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    size_t n = lean_unbox(lean_float_array_size(data_arr)) / 5;
+    uint32_t loaded = afferent_fixed_stepper_load(stepper, lean_float_array_cptr(data_arr), n);
+    return lean_io_result_mk_ok(lean_box_uint32(loaded));
+}
+
+// Add frame time, run the covered substeps and write interpolated instances.
+// Returns the number of substeps taken.
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_advance(
+    lean_obj_arg stepper_obj,
+    double frame_dt,
+    lean_obj_arg buffer_obj,
+    uint8_t layout,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    uint32_t substeps = afferent_fixed_stepper_advance(stepper, frame_dt,
+        (float*)afferent_float_buffer_data(buffer), afferent_float_buffer_capacity(buffer),
+        (AfferentParticleLayout)layout);
+    return lean_io_result_mk_ok(lean_box_uint32(substeps));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_write(
+    lean_obj_arg stepper_obj,
+    lean_obj_arg buffer_obj,
+    uint8_t layout,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    uint32_t written = afferent_fixed_stepper_write(stepper,
+        (float*)afferent_float_buffer_data(buffer), afferent_float_buffer_capacity(buffer),
+        (AfferentParticleLayout)layout);
+    return lean_io_result_mk_ok(lean_box_uint32(written));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_run(
+    lean_obj_arg stepper_obj,
+    uint32_t steps,
+    lean_obj_arg world
+) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    afferent_fixed_stepper_run(stepper, steps);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_alpha(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    return lean_io_result_mk_ok(lean_box_float((double)afferent_fixed_stepper_alpha(stepper)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_step_count(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    return lean_io_result_mk_ok(lean_box_uint64(afferent_fixed_stepper_step_count(stepper)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_dropped_time(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    return lean_io_result_mk_ok(lean_box_float(afferent_fixed_stepper_dropped_time(stepper)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_checksum(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    return lean_io_result_mk_ok(lean_box_uint64(afferent_fixed_stepper_checksum(stepper)));
+}
+
+// Current state as a FloatArray [x, y, vx, vy, hue] per particle.
+LEAN_EXPORT lean_obj_res lean_afferent_fixed_stepper_state(lean_obj_arg stepper_obj, lean_obj_arg world) {
+    AfferentFixedStepperRef stepper = (AfferentFixedStepperRef)lean_get_external_data(stepper_obj);
+    size_t n = (size_t)afferent_fixed_stepper_count(stepper) * 5;
+    const float* state = afferent_fixed_stepper_state(stepper);
+    lean_object* arr = lean_alloc_sarray(sizeof(double), n, n);
+    double* dst = lean_float_array_cptr(arr);
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = (double)state[i];
+    }
+    return lean_io_result_mk_ok(arr);
+}
+
+// ============== ParticleInit FFI ==============
+// Parallel particle initialization; output is independent of thread count
+
+#define PARTICLE_INIT_PARAMS 11
+
+// params: [positionKind, p0, p1, p2, p3, velocityKind, v0, v1, hueKind, h0, h1]
+static bool particle_init_desc_from_params(b_lean_obj_arg params_arr, AfferentParticleInitDesc* desc) {
+    if (lean_unbox(lean_float_array_size(params_arr)) < PARTICLE_INIT_PARAMS) return false;
+    const double* p = lean_float_array_cptr(params_arr);
+    desc->position = (AfferentInitPosition)(uint32_t)p[0];
+    for (int i = 0; i < 4; i++) desc->p[i] = (float)p[1 + i];
+    desc->velocity = (AfferentInitVelocity)(uint32_t)p[5];
+    desc->v[0] = (float)p[6];
+    desc->v[1] = (float)p[7];
+    desc->hue = (AfferentInitHue)(uint32_t)p[8];
+    desc->h[0] = (float)p[9];
+    desc->h[1] = (float)p[10];
+    return true;
+}
+
+// Pure: returns a FloatArray [x, y, vx, vy, hue] per particle.
+LEAN_EXPORT lean_obj_res lean_afferent_particles_generate(
+    uint32_t count,
+    b_lean_obj_arg params_arr,
+    uint32_t seed,
+    uint32_t threads
+) {
+    AfferentParticleInitDesc desc;
+    if (!particle_init_desc_from_params(params_arr, &desc)) count = 0;
+
+    size_t n = (size_t)count * 5;
+    lean_object* arr = lean_alloc_sarray(sizeof(double), n, n);
+    afferent_particle_init_f64(&desc, count, seed, threads, lean_float_array_cptr(arr));
+    return arr;
+}
+
+// Fill a FloatBuffer with [x, y, vx, vy, hue] per particle (count clamped to capacity).
+LEAN_EXPORT lean_obj_res lean_afferent_float_buffer_init_particles(
+    lean_obj_arg buffer_obj,
+    uint32_t count,
+    b_lean_obj_arg params_arr,
+    uint32_t seed,
+    uint32_t threads,
+    lean_obj_arg world
+) {
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+    AfferentParticleInitDesc desc;
+    if (!particle_init_desc_from_params(params_arr, &desc)) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to init particles (expected 11 parameters)")));
+    }
+    count = float_buffer_particle_count(buffer, count, 5);
+    afferent_particle_init_f32(&desc, count, seed, threads, (float*)afferent_float_buffer_data(buffer));
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// ============== Marshalling FFI ==============
+// Renderer-free versions of the two Lean -> float32 conversion paths, so
+// their cost can be measured headless. Both narrow into scratch allocated
+// for the call (the same cost on either path) and return a float sum so the
+// work cannot be skipped.
+
+static double marshal_checksum(const float* data, size_t count) {
+    // Sample a handful of elements; a full pass would dominate the timing
+    double sum = 0.0;
+    size_t step = count / 16 + 1;
+    for (size_t i = 0; i < count; i += step) sum += data[i];
+    return sum;
+}
+
+static lean_obj_res marshal_alloc_error(void) {
+    return lean_io_result_mk_error(lean_mk_io_user_error(
+        lean_mk_string("Failed to allocate marshal buffer")));
+}
+
+// Array Float: one boxed Float object per element
+LEAN_EXPORT lean_obj_res lean_afferent_marshal_array(lean_obj_arg arr, lean_obj_arg world) {
+    size_t count = lean_array_size(arr);
+    float* dst = malloc((count > 0 ? count : 1) * sizeof(float));
+    if (!dst) return marshal_alloc_error();
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = (float)lean_unbox_float(lean_array_get_core(arr, i));
+    }
+    double sum = marshal_checksum(dst, count);
+    free(dst);
+    return lean_io_result_mk_ok(lean_box_float(sum));
+}
+
+// FloatArray: contiguous doubles narrowed with SIMD
+LEAN_EXPORT lean_obj_res lean_afferent_marshal_float_array(lean_obj_arg arr, lean_obj_arg world) {
+    size_t count = (size_t)lean_unbox(lean_float_array_size(arr));
+    float* dst = malloc((count > 0 ? count : 1) * sizeof(float));
+    if (!dst) return marshal_alloc_error();
+    afferent_narrow_f64_to_f32(lean_float_array_cptr(arr), dst, count);
+    double sum = marshal_checksum(dst, count);
+    free(dst);
+    return lean_io_result_mk_ok(lean_box_float(sum));
+}
+
+// Index uploads: Array UInt32 is unboxed element by element, ByteArray
+// (u16 or u32) is one memcpy. Both return a sampled sum of the indices.
+static uint32_t* marshal_index_alloc(size_t bytes) {
+    size_t count = (bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    return malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_marshal_index_array(b_lean_obj_arg arr, lean_obj_arg world) {
+    size_t count = lean_array_size(arr);
+    uint32_t* dst = marshal_index_alloc(count * sizeof(uint32_t));
+    if (!dst) return marshal_alloc_error();
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = lean_unbox_uint32(lean_array_get_core(arr, i));
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i += count / 16 + 1) sum += dst[i];
+    free(dst);
+    return lean_io_result_mk_ok(lean_box_uint64(sum));
+}
+
+// `width` is the index size in bytes (2 or 4)
+LEAN_EXPORT lean_obj_res lean_afferent_marshal_index_bytes(b_lean_obj_arg bytes, uint8_t width, lean_obj_arg world) {
+    size_t size = lean_sarray_size(bytes);
+    uint32_t* dst = marshal_index_alloc(size);
+    if (!dst) return marshal_alloc_error();
+    memcpy(dst, lean_sarray_cptr(bytes), size);
+    uint64_t sum = 0;
+    if (width == 2) {
+        const uint16_t* src = (const uint16_t*)dst;
+        size_t count = size / sizeof(uint16_t);
+        for (size_t i = 0; i < count; i += count / 16 + 1) sum += src[i];
+    } else {
+        size_t count = size / sizeof(uint32_t);
+        for (size_t i = 0; i < count; i += count / 16 + 1) sum += dst[i];
+    }
+    free(dst);
+    return lean_io_result_mk_ok(lean_box_uint64(sum));
+}
+
+// ============== Mesh FFI ==============
+// Persistent 3D meshes: geometry crosses the FFI once, draws pass only the handle
+
+// Copy an Array UInt32 into malloc'd memory (caller frees); NULL on OOM
+static uint32_t* index_array_copy(b_lean_obj_arg arr, size_t count) {
+    uint32_t* out = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    if (!out) return NULL;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = lean_unbox_uint32(lean_array_get_core(arr, i));
+    }
+    return out;
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_create(
+    uint8_t format,
+    b_lean_obj_arg vertices_arr,
+    b_lean_obj_arg indices_arr,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentMeshFormat fmt = (AfferentMeshFormat)format;
+    size_t vertex_count = (size_t)lean_unbox(lean_float_array_size(vertices_arr)) / afferent_mesh_format_floats(fmt);
+    size_t index_count = lean_array_size(indices_arr);
+
+    uint32_t* indices = index_array_copy(indices_arr, index_count);
+    if (!indices) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate index memory")));
+    }
+
+    AfferentMeshRef mesh = NULL;
+    AfferentResult result = afferent_mesh_create(fmt, lean_float_array_cptr(vertices_arr),
+        (uint32_t)vertex_count, indices, (uint32_t)index_count, &mesh);
+    free(indices);
+
+    if (result != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create mesh (empty geometry or index out of range)")));
+    }
+
+    lean_object* obj = lean_alloc_external(g_mesh_class, mesh);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_destroy(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    afferent_mesh_destroy(mesh);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_vertex_count(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_mesh_vertex_count(mesh)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_index_count(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_mesh_index_count(mesh)));
+}
+
+// data holds whole vertices in the mesh's format
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_update_vertices(
+    lean_obj_arg mesh_obj,
+    uint32_t first_vertex,
+    b_lean_obj_arg data_arr,
+    lean_obj_arg world
+) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    uint32_t stride = afferent_mesh_format_floats(afferent_mesh_format(mesh));
+    size_t count = (size_t)lean_unbox(lean_float_array_size(data_arr)) / stride;
+    if (!afferent_mesh_update_vertices(mesh, first_vertex, lean_float_array_cptr(data_arr), (uint32_t)count)) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Mesh vertex update out of range")));
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_update_indices(
+    lean_obj_arg mesh_obj,
+    uint32_t first_index,
+    b_lean_obj_arg indices_arr,
+    lean_obj_arg world
+) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    size_t count = lean_array_size(indices_arr);
+    uint32_t* indices = index_array_copy(indices_arr, count);
+    if (!indices) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate index memory")));
+    }
+    bool ok = afferent_mesh_update_indices(mesh, first_index, indices, (uint32_t)count);
+    free(indices);
+    if (!ok) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Mesh index update out of range")));
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// CPU-side vertex storage (float32 widened back to Float)
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_vertex_data(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    size_t n = (size_t)afferent_mesh_vertex_count(mesh) * afferent_mesh_format_floats(afferent_mesh_format(mesh));
+    lean_object* arr = lean_alloc_sarray(sizeof(double), n, n);
+    double* dst = lean_float_array_cptr(arr);
+    const float* src = afferent_mesh_vertices(mesh);
+    for (size_t i = 0; i < n; i++) dst[i] = (double)src[i];
+    return lean_io_result_mk_ok(arr);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_index_data(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    return lean_io_result_mk_ok(mk_uint32_array(afferent_mesh_indices(mesh), afferent_mesh_index_count(mesh)));
+}
+
+// Pending uploads as [vertexFirst, vertexCount, indexFirst, indexCount] (count 0 = clean)
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_dirty_ranges(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    uint32_t ranges[4];
+    afferent_mesh_dirty_vertices(mesh, &ranges[0], &ranges[1]);
+    afferent_mesh_dirty_indices(mesh, &ranges[2], &ranges[3]);
+    return lean_io_result_mk_ok(mk_uint32_array(ranges, 4));
+}
+
+// Stats as [vertexUpdates, indexUpdates, cpuBytes, gpuResident]
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_stats(lean_obj_arg mesh_obj, lean_obj_arg world) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    AfferentMeshStats stats;
+    afferent_mesh_get_stats(mesh, &stats);
+
+    lean_object* arr = lean_alloc_array(4, 4);
+    lean_object** items = lean_array_cptr(arr);
+    items[0] = lean_box_uint64(stats.vertex_updates);
+    items[1] = lean_box_uint64(stats.index_updates);
+    items[2] = lean_box_uint64(stats.cpu_bytes);
+    items[3] = lean_box_uint64(stats.gpu_resident ? 1 : 0);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Submesh range clamped to the index buffer, as [offset, count] (count 0 = nothing to draw)
+LEAN_EXPORT lean_obj_res lean_afferent_mesh_clamp_range(
+    lean_obj_arg mesh_obj,
+    uint32_t index_offset,
+    uint32_t index_count,
+    lean_obj_arg world
+) {
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    uint32_t range[2] = { index_offset, index_count };
+    if (!afferent_mesh_clamp_range(mesh, &range[0], &range[1])) range[1] = 0;
+    return lean_io_result_mk_ok(mk_uint32_array(range, 2));
+}
+
+// Shared uniform conversion for the mesh draw calls
+static void mesh_draw_matrices(b_lean_obj_arg mvp_matrix, b_lean_obj_arg model_matrix,
+    b_lean_obj_arg light_dir, float mvp[16], float model[16], float light[3]) {
+    for (size_t i = 0; i < 16; i++) {
+        mvp[i] = (float)lean_unbox_float(lean_array_get_core(mvp_matrix, i));
+        model[i] = (float)lean_unbox_float(lean_array_get_core(model_matrix, i));
+    }
+    for (size_t i = 0; i < 3; i++) {
+        light[i] = (float)lean_unbox_float(lean_array_get_core(light_dir, i));
+    }
+}
+
+static void float3_from_array(b_lean_obj_arg arr, float out[3]) {
+    for (size_t i = 0; i < 3; i++) {
+        out[i] = (float)lean_unbox_float(lean_array_get_core(arr, i));
+    }
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg mesh_obj,
+    uint32_t index_offset,
+    uint32_t index_count,
+    b_lean_obj_arg mvp_matrix,
+    b_lean_obj_arg model_matrix,
+    b_lean_obj_arg light_dir,
+    double ambient,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    float mvp[16], model[16], light[3];
+    mesh_draw_matrices(mvp_matrix, model_matrix, light_dir, mvp, model, light);
+    afferent_renderer_draw_mesh(renderer, mesh, index_offset, index_count, mvp, model, light,
+        (float)ambient, NULL, NULL, 0.0f, 0.0f, NULL);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_with_fog(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg mesh_obj,
+    uint32_t index_offset,
+    uint32_t index_count,
+    b_lean_obj_arg mvp_matrix,
+    b_lean_obj_arg model_matrix,
+    b_lean_obj_arg light_dir,
+    double ambient,
+    b_lean_obj_arg camera_pos_arr,
+    b_lean_obj_arg fog_color_arr,
+    double fog_start,
+    double fog_end,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    float mvp[16], model[16], light[3], camera_pos[3], fog_color[3];
+    mesh_draw_matrices(mvp_matrix, model_matrix, light_dir, mvp, model, light);
+    float3_from_array(camera_pos_arr, camera_pos);
+    float3_from_array(fog_color_arr, fog_color);
+    afferent_renderer_draw_mesh(renderer, mesh, index_offset, index_count, mvp, model, light,
+        (float)ambient, camera_pos, fog_color, (float)fog_start, (float)fog_end, NULL);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_textured(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg mesh_obj,
+    uint32_t index_offset,
+    uint32_t index_count,
+    b_lean_obj_arg mvp_matrix,
+    b_lean_obj_arg model_matrix,
+    b_lean_obj_arg light_dir,
+    double ambient,
+    b_lean_obj_arg camera_pos_arr,
+    b_lean_obj_arg fog_color_arr,
+    double fog_start,
+    double fog_end,
+    lean_obj_arg texture_obj,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentMeshRef mesh = (AfferentMeshRef)lean_get_external_data(mesh_obj);
+    AfferentTextureRef texture = (AfferentTextureRef)lean_get_external_data(texture_obj);
+    float mvp[16], model[16], light[3], camera_pos[3], fog_color[3];
+    mesh_draw_matrices(mvp_matrix, model_matrix, light_dir, mvp, model, light);
+    float3_from_array(camera_pos_arr, camera_pos);
+    float3_from_array(fog_color_arr, fog_color);
+    afferent_renderer_draw_mesh(renderer, mesh, index_offset, index_count, mvp, model, light,
+        (float)ambient, camera_pos, fog_color, (float)fog_start, (float)fog_end, texture);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// ============== Frame Arena FFI ==============
+// Renderer-owned arena stats, plus standalone arenas for headless tests/benchmarks
+
+static lean_object* frame_arena_stats_array(AfferentFrameArenaRef arena) {
+    AfferentFrameArenaStats stats;
+    memset(&stats, 0, sizeof(stats));
+    afferent_frame_arena_get_stats(arena, &stats);
+
+    lean_object* arr = lean_alloc_array(8, 8);
+    lean_object** items = lean_array_cptr(arr);
+    items[0] = lean_box_uint64(stats.bytes_in_use);
+    items[1] = lean_box_uint64(stats.frame_peak_bytes);
+    items[2] = lean_box_uint64(stats.high_water_bytes);
+    items[3] = lean_box_uint64(stats.capacity_bytes);
+    items[4] = lean_box_uint64(stats.block_count);
+    items[5] = lean_box_uint64(stats.frames);
+    items[6] = lean_box_uint64(stats.system_allocs);
+    items[7] = lean_box_uint64(stats.last_frame_allocs);
+    return arr;
+}
+
+// Stats as [bytesInUse, framePeak, highWater, capacity, blocks, frames, systemAllocs, lastFrameAllocs]
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_frame_arena_stats(lean_obj_arg renderer_obj, lean_obj_arg world) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    return lean_io_result_mk_ok(frame_arena_stats_array(afferent_renderer_frame_arena(renderer)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_set_frame_arena_passthrough(
+    lean_obj_arg renderer_obj,
+    uint8_t passthrough,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    afferent_frame_arena_set_passthrough(afferent_renderer_frame_arena(renderer), passthrough != 0);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_create(uint64_t initial_bytes, lean_obj_arg world) {
+    afferent_ensure_initialized();
+    AfferentFrameArenaRef arena = NULL;
+    if (afferent_frame_arena_create((size_t)initial_bytes, &arena) != AFFERENT_OK) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to create frame arena")));
+    }
+    lean_object* obj = lean_alloc_external(g_frame_arena_class, arena);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_destroy(lean_obj_arg arena_obj, lean_obj_arg world) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    afferent_frame_arena_destroy(arena);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Allocate (and touch) `bytes` of scratch; false on out-of-memory
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_alloc(
+    lean_obj_arg arena_obj,
+    uint64_t bytes,
+    lean_obj_arg world
+) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    void* ptr = afferent_frame_arena_alloc(arena, (size_t)bytes);
+    if (ptr) memset(ptr, 0, (size_t)bytes);
+    return lean_io_result_mk_ok(lean_box(ptr != NULL));
+}
+
+// Mark as [block address, used bytes]; only meaningful to rewind on the same arena
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_mark(lean_obj_arg arena_obj, lean_obj_arg world) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    AfferentFrameArenaMark mark = afferent_frame_arena_mark(arena);
+
+    lean_object* arr = lean_alloc_array(2, 2);
+    lean_object** items = lean_array_cptr(arr);
+    items[0] = lean_box_uint64((uint64_t)(uintptr_t)mark.block);
+    items[1] = lean_box_uint64((uint64_t)mark.used);
+    return lean_io_result_mk_ok(arr);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_rewind(
+    lean_obj_arg arena_obj,
+    uint64_t block,
+    uint64_t used,
+    lean_obj_arg world
+) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    AfferentFrameArenaMark mark = { (void*)(uintptr_t)block, (size_t)used };
+    afferent_frame_arena_rewind(arena, mark);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_reset(lean_obj_arg arena_obj, lean_obj_arg world) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    afferent_frame_arena_reset(arena);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_set_passthrough(
+    lean_obj_arg arena_obj,
+    uint8_t passthrough,
+    lean_obj_arg world
+) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    afferent_frame_arena_set_passthrough(arena, passthrough != 0);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_stats(lean_obj_arg arena_obj, lean_obj_arg world) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    return lean_io_result_mk_ok(frame_arena_stats_array(arena));
+}
+
+// One transient conversion the way the draw calls do it: mark, narrow the
+// FloatArray into scratch, consume it (sampled sum), rewind.
+LEAN_EXPORT lean_obj_res lean_afferent_frame_arena_narrow_scratch(
+    lean_obj_arg arena_obj,
+    b_lean_obj_arg data_arr,
+    lean_obj_arg world
+) {
+    AfferentFrameArenaRef arena = (AfferentFrameArenaRef)lean_get_external_data(arena_obj);
+    size_t count = (size_t)lean_unbox(lean_float_array_size(data_arr));
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_narrow(arena, data_arr, count);
+    if (!data) {
+        afferent_frame_arena_rewind(arena, scratch);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Frame arena allocation failed")));
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i += 64) sum += data[i];
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box_float(sum));
+}
+
+// ============== Command Stream FFI ==============
+// A whole frame of packed 2D commands (ByteArray) executed in one call
+
+static lean_obj_res command_stream_error(const AfferentCommandStreamInfo* info) {
+    char message[128];
+    snprintf(message, sizeof(message), "Command stream error at byte %zu: %s",
+        info->error_offset, info->error ? info->error : "out of memory");
+    return lean_io_result_mk_error(lean_mk_io_user_error(lean_mk_string(message)));
+}
+
+// Returns the number of commands executed; fails without drawing anything
+// if the stream is malformed
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_execute_commands(
+    lean_obj_arg renderer_obj,
+    b_lean_obj_arg stream_arr,
+    b_lean_obj_arg fonts_arr,
+    b_lean_obj_arg textures_arr,
+    double canvas_width,
+    double canvas_height,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    size_t font_count = lean_array_size(fonts_arr);
+    size_t texture_count = lean_array_size(textures_arr);
+
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentFontRef* fonts = afferent_frame_arena_alloc(arena, font_count * sizeof(AfferentFontRef));
+    AfferentTextureRef* textures = afferent_frame_arena_alloc(arena, texture_count * sizeof(AfferentTextureRef));
+    if (!fonts || !textures) {
+        afferent_frame_arena_rewind(arena, scratch);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate command stream tables")));
+    }
+    for (size_t i = 0; i < font_count; i++) {
+        fonts[i] = (AfferentFontRef)lean_get_external_data(lean_array_get_core(fonts_arr, i));
+    }
+    for (size_t i = 0; i < texture_count; i++) {
+        textures[i] = (AfferentTextureRef)lean_get_external_data(lean_array_get_core(textures_arr, i));
+    }
+
+    AfferentCommandStreamInfo info;
+    bool ok = afferent_renderer_execute_commands(renderer,
+        lean_sarray_cptr(stream_arr), lean_sarray_size(stream_arr),
+        fonts, (uint32_t)font_count, textures, (uint32_t)texture_count,
+        (float)canvas_width, (float)canvas_height, &info);
+    afferent_frame_arena_rewind(arena, scratch);
+
+    if (!ok) return command_stream_error(&info);
+    return lean_io_result_mk_ok(lean_box_uint32(info.commands));
+}
+
+// Validate a stream without a renderer; returns the command count
+LEAN_EXPORT lean_obj_res lean_afferent_command_stream_validate(
+    b_lean_obj_arg stream_arr,
+    uint32_t font_count,
+    uint32_t texture_count,
+    lean_obj_arg world
+) {
+    AfferentCommandStreamInfo info;
+    if (!afferent_command_stream_execute(lean_sarray_cptr(stream_arr), lean_sarray_size(stream_arr),
+            font_count, texture_count, NULL, NULL, &info)) {
+        return command_stream_error(&info);
+    }
+    return lean_io_result_mk_ok(lean_box_uint32(info.commands));
+}
+
+// Decode a stream through the recording sink (one line per backend call)
+LEAN_EXPORT lean_obj_res lean_afferent_command_stream_record(
+    b_lean_obj_arg stream_arr,
+    uint32_t font_count,
+    uint32_t texture_count,
+    lean_obj_arg world
+) {
+    AfferentCommandStreamInfo info;
+    char* log = afferent_command_stream_record(lean_sarray_cptr(stream_arr), lean_sarray_size(stream_arr),
+        font_count, texture_count, &info);
+    if (!log) return command_stream_error(&info);
+    lean_object* str = lean_mk_string(log);
+    free(log);
+    return lean_io_result_mk_ok(str);
+}
+
+// ============== VertexWriter FFI ==============
+
+static lean_obj_res vertex_writer_error(const char* message) {
+    return lean_io_result_mk_error(lean_mk_io_user_error(lean_mk_string(message)));
+}
+
+static lean_obj_res vertex_writer_stride_error(uint32_t expected) {
+    char message[64];
+    snprintf(message, sizeof(message), "VertexWriter: expected stride %u", expected);
+    return vertex_writer_error(message);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_create(
+    uint32_t stride,
+    uint64_t vertex_capacity,
+    uint64_t index_capacity,
+    lean_obj_arg world
+) {
+    afferent_ensure_initialized();
+    AfferentVertexWriterRef writer = NULL;
+    if (afferent_vertex_writer_create(stride, (size_t)vertex_capacity, (size_t)index_capacity, &writer) != AFFERENT_OK) {
+        return vertex_writer_error("Failed to create vertex writer");
+    }
+    lean_object* obj = lean_alloc_external(g_vertex_writer_class, writer);
+    return lean_io_result_mk_ok(obj);
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_destroy(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    afferent_vertex_writer_destroy(writer);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_clear(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    afferent_vertex_writer_clear(writer);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_begin_shape(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    afferent_vertex_writer_begin_shape(writer);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// One AfferentVertex (stride 6): position and color
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit_vertex(
+    lean_obj_arg writer_obj,
+    double x, double y,
+    double r, double g, double b, double a,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 6) return vertex_writer_stride_error(6);
+    float* v = afferent_vertex_writer_emit_vertices(writer, 1);
+    if (!v) return vertex_writer_error("VertexWriter: out of memory");
+    v[0] = (float)x; v[1] = (float)y;
+    v[2] = (float)r; v[3] = (float)g; v[4] = (float)b; v[5] = (float)a;
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// One 4-float record (dynamic circles)
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit4(
+    lean_obj_arg writer_obj,
+    double f0, double f1, double f2, double f3,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 4) return vertex_writer_stride_error(4);
+    float* v = afferent_vertex_writer_emit_vertices(writer, 1);
+    if (!v) return vertex_writer_error("VertexWriter: out of memory");
+    v[0] = (float)f0; v[1] = (float)f1; v[2] = (float)f2; v[3] = (float)f3;
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// One 5-float record (dynamic rects/triangles)
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit5(
+    lean_obj_arg writer_obj,
+    double f0, double f1, double f2, double f3, double f4,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 5) return vertex_writer_stride_error(5);
+    float* v = afferent_vertex_writer_emit_vertices(writer, 1);
+    if (!v) return vertex_writer_error("VertexWriter: out of memory");
+    v[0] = (float)f0; v[1] = (float)f1; v[2] = (float)f2; v[3] = (float)f3; v[4] = (float)f4;
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// One 12-float Canvas shape instance (see afferent_renderer_draw_instanced_shapes)
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit_shape_instance(
+    lean_obj_arg writer_obj,
+    double cx, double cy, double ax, double ay, double bx, double by,
+    double r, double g, double b, double a, double kind,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 12) return vertex_writer_stride_error(12);
+    float* v = afferent_vertex_writer_emit_vertices(writer, 1);
+    if (!v) return vertex_writer_error("VertexWriter: out of memory");
+    v[0] = (float)cx; v[1] = (float)cy;
+    v[2] = (float)ax; v[3] = (float)ay;
+    v[4] = (float)bx; v[5] = (float)by;
+    v[6] = (float)r; v[7] = (float)g; v[8] = (float)b; v[9] = (float)a;
+    v[10] = (float)kind; v[11] = 0.0f;
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Solid-color quad: corners in order, triangles (0,1,2) and (0,2,3)
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit_quad(
+    lean_obj_arg writer_obj,
+    double x0, double y0, double x1, double y1,
+    double x2, double y2, double x3, double y3,
+    double r, double g, double b, double a,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 6) return vertex_writer_stride_error(6);
+    const float corners[8] = {
+        (float)x0, (float)y0, (float)x1, (float)y1,
+        (float)x2, (float)y2, (float)x3, (float)y3
+    };
+    const float color[4] = { (float)r, (float)g, (float)b, (float)a };
+    if (!afferent_vertex_writer_emit_quad(writer, corners, color)) {
+        return vertex_writer_error("VertexWriter: out of memory");
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit_index_tri(
+    lean_obj_arg writer_obj,
+    uint32_t a, uint32_t b, uint32_t c,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (!afferent_vertex_writer_emit_tri(writer, a, b, c)) {
+        return vertex_writer_error("VertexWriter: triangle index out of range for the current shape");
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// A whole shape in one call: `stride`-float vertices (narrowed) and
+// shape-relative indices. Indices are checked before anything is written.
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_emit_shape(
+    lean_obj_arg writer_obj,
+    b_lean_obj_arg vertices_arr,
+    b_lean_obj_arg indices_arr,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    size_t stride = afferent_vertex_writer_stride(writer);
+    size_t float_count = (size_t)lean_unbox(lean_float_array_size(vertices_arr));
+    size_t vertex_count = float_count / stride;
+    size_t index_count = lean_array_size(indices_arr);
+    if (vertex_count * stride != float_count) {
+        return vertex_writer_error("VertexWriter: vertex data is not a whole number of vertices");
+    }
+    if (vertex_count > UINT32_MAX || index_count % 3 != 0 || index_count > UINT32_MAX) {
+        return vertex_writer_error("VertexWriter: malformed shape");
+    }
+    lean_object** items = lean_array_cptr(indices_arr);
+    for (size_t i = 0; i < index_count; i++) {
+        if (lean_unbox_uint32(items[i]) >= vertex_count) {
+            return vertex_writer_error("VertexWriter: triangle index out of range for the current shape");
+        }
+    }
+    if (vertex_count == 0) return lean_io_result_mk_ok(lean_box(0));
+    if (!afferent_vertex_writer_reserve(writer, (uint32_t)vertex_count, (uint32_t)index_count)) {
+        return vertex_writer_error("VertexWriter: out of memory");
+    }
+    afferent_vertex_writer_begin_shape(writer);
+    float* out = afferent_vertex_writer_emit_vertices(writer, (uint32_t)vertex_count);
+    const double* src = lean_float_array_cptr(vertices_arr);
+    for (size_t i = 0; i < float_count; i++) out[i] = (float)src[i];
+    for (size_t i = 0; i < index_count; i += 3) {
+        afferent_vertex_writer_emit_tri(writer,
+            lean_unbox_uint32(items[i]), lean_unbox_uint32(items[i + 1]), lean_unbox_uint32(items[i + 2]));
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_vertex_count(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_vertex_writer_vertex_count(writer)));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_index_count(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    return lean_io_result_mk_ok(lean_box_uint32(afferent_vertex_writer_index_count(writer)));
+}
+
+// Stats as [vertices, indices, vertexCapacity, indexCapacity, bytesReserved, grows, stride, indexFormat]
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_stats(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    AfferentVertexWriterStats stats;
+    memset(&stats, 0, sizeof(stats));
+    afferent_vertex_writer_get_stats(writer, &stats);
+
+    lean_object* arr = lean_alloc_array(8, 8);
+    lean_object** items = lean_array_cptr(arr);
+    items[0] = lean_box_uint64(stats.vertex_count);
+    items[1] = lean_box_uint64(stats.index_count);
+    items[2] = lean_box_uint64(stats.vertex_capacity);
+    items[3] = lean_box_uint64(stats.index_capacity);
+    items[4] = lean_box_uint64(stats.bytes_reserved);
+    items[5] = lean_box_uint64(stats.grows);
+    items[6] = lean_box_uint64(stats.stride);
+    items[7] = lean_box_uint64((uint64_t)stats.index_format);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Copy the vertex floats out (widened to Float) for inspection and interop
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_vertices(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    size_t n = (size_t)afferent_vertex_writer_vertex_count(writer) * afferent_vertex_writer_stride(writer);
+    lean_object* arr = lean_alloc_sarray(sizeof(double), n, n);
+    const float* src = afferent_vertex_writer_vertices(writer);
+    double* dst = lean_float_array_cptr(arr);
+    for (size_t i = 0; i < n; i++) dst[i] = src[i];
+    return lean_io_result_mk_ok(arr);
+}
+
+// Copy the packed little-endian indices out (2 or 4 bytes each)
+LEAN_EXPORT lean_obj_res lean_afferent_vertex_writer_index_bytes(lean_obj_arg writer_obj, lean_obj_arg world) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    size_t width = afferent_vertex_writer_index_format(writer) == AFFERENT_INDEX_U16 ? 2 : 4;
+    size_t n = (size_t)afferent_vertex_writer_index_count(writer) * width;
+    lean_object* arr = lean_alloc_sarray(1, n, n);
+    if (n > 0) memcpy(lean_sarray_cptr(arr), afferent_vertex_writer_indices(writer), n);
+    return lean_io_result_mk_ok(arr);
+}
+
+// Draw the writer's triangles (stride 6, NDC) as one indexed draw. The
+// storage is already float32/packed, so it is copied into GPU buffers as-is.
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_vertex_writer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg writer_obj,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 6) return vertex_writer_stride_error(6);
+    uint32_t vertex_count = afferent_vertex_writer_vertex_count(writer);
+    uint32_t index_count = afferent_vertex_writer_index_count(writer);
+    if (vertex_count == 0 || index_count == 0) return lean_io_result_mk_ok(lean_box(0));
+
+    AfferentBufferRef vertex_buffer = NULL;
+    AfferentBufferRef index_buffer = NULL;
+    const AfferentVertex* vertices = (const AfferentVertex*)afferent_vertex_writer_vertices(writer);
+    if (afferent_buffer_create_vertex(renderer, vertices, vertex_count, &vertex_buffer) != AFFERENT_OK) {
+        return vertex_writer_error("Failed to create vertex buffer");
+    }
+    AfferentResult result = afferent_vertex_writer_index_format(writer) == AFFERENT_INDEX_U16
+        ? afferent_buffer_create_index_u16(renderer, afferent_vertex_writer_indices(writer), index_count, &index_buffer)
+        : afferent_buffer_create_index(renderer, afferent_vertex_writer_indices(writer), index_count, &index_buffer);
+    if (result != AFFERENT_OK) {
+        afferent_buffer_destroy(vertex_buffer);
+        return vertex_writer_error("Failed to create index buffer");
+    }
+    afferent_renderer_draw_triangles(renderer, vertex_buffer, index_buffer, index_count);
+    afferent_buffer_destroy(vertex_buffer);
+    afferent_buffer_destroy(index_buffer);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Draw dynamic shapes from a writer of 4-float (circles) or 5-float
+// (rects/triangles) records, one record per shape
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_shapes_writer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg writer_obj,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 12) return vertex_writer_stride_error(12);
+    uint32_t count = afferent_vertex_writer_vertex_count(writer);
+    if (count > 0) {
+        afferent_renderer_draw_instanced_shapes(renderer, afferent_vertex_writer_vertices(writer), count);
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_circles_writer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg writer_obj,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 4) return vertex_writer_stride_error(4);
+    uint32_t count = afferent_vertex_writer_vertex_count(writer);
+    if (count > 0) {
+        afferent_renderer_draw_dynamic_circles(renderer, afferent_vertex_writer_vertices(writer), count,
+            (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_rects_writer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg writer_obj,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 5) return vertex_writer_stride_error(5);
+    uint32_t count = afferent_vertex_writer_vertex_count(writer);
+    if (count > 0) {
+        afferent_renderer_draw_dynamic_rects(renderer, afferent_vertex_writer_vertices(writer), count,
+            (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_triangles_writer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg writer_obj,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    if (afferent_vertex_writer_stride(writer) != 5) return vertex_writer_stride_error(5);
+    uint32_t count = afferent_vertex_writer_vertex_count(writer);
+    if (count > 0) {
+        afferent_renderer_draw_dynamic_triangles(renderer, afferent_vertex_writer_vertices(writer), count,
+            (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// ============== Path Tessellator FFI ==============
+
+// Fill in the path input from Lean arguments; an empty transform is identity
+static bool path_input_from_lean(AfferentPathInput* in, b_lean_obj_arg commands_arr,
+    b_lean_obj_arg transform_arr, double tolerance, double ndc_width, double ndc_height) {
+    size_t transform_len = (size_t)lean_unbox(lean_float_array_size(transform_arr));
+    if (transform_len != 0 && transform_len != 6) return false;
+    in->commands = lean_float_array_cptr(commands_arr);
+    in->command_length = (size_t)lean_unbox(lean_float_array_size(commands_arr));
+    in->transform = transform_len == 6 ? lean_float_array_cptr(transform_arr) : NULL;
+    in->tolerance = tolerance;
+    in->ndc_width = ndc_width;
+    in->ndc_height = ndc_height;
+    return true;
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_tessellate_fill_convex(
+    lean_obj_arg writer_obj,
+    b_lean_obj_arg commands_arr,
+    b_lean_obj_arg transform_arr,
+    double tolerance,
+    double ndc_width,
+    double ndc_height,
+    double r, double g, double b, double a,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    AfferentPathInput in;
+    if (!path_input_from_lean(&in, commands_arr, transform_arr, tolerance, ndc_width, ndc_height)) {
+        return vertex_writer_error("Tessellator: transform must have 6 entries");
+    }
+    const float color[4] = { (float)r, (float)g, (float)b, (float)a };
+    if (!afferent_tessellate_fill_convex(&in, color, writer)) {
+        return vertex_writer_error("Tessellator: malformed path, stride mismatch or out of memory");
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_tessellate_stroke(
+    lean_obj_arg writer_obj,
+    b_lean_obj_arg commands_arr,
+    b_lean_obj_arg transform_arr,
+    double tolerance,
+    double ndc_width,
+    double ndc_height,
+    double r, double g, double b, double a,
+    double line_width,
+    double miter_limit,
+    uint8_t cap,
+    uint8_t join,
+    lean_obj_arg world
+) {
+    AfferentVertexWriterRef writer = (AfferentVertexWriterRef)lean_get_external_data(writer_obj);
+    AfferentPathInput in;
+    if (!path_input_from_lean(&in, commands_arr, transform_arr, tolerance, ndc_width, ndc_height)) {
+        return vertex_writer_error("Tessellator: transform must have 6 entries");
+    }
+    AfferentStrokeParams stroke = {
+        .color = { (float)r, (float)g, (float)b, (float)a },
+        .line_width = line_width,
+        .miter_limit = miter_limit,
+        .cap = (AfferentLineCap)cap,
+        .join = (AfferentLineJoin)join,
+    };
+    if (!afferent_tessellate_stroke(&in, &stroke, writer)) {
+        return vertex_writer_error("Tessellator: malformed path, stride mismatch or out of memory");
+    }
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// ============== Polygon Triangulator FFI ==============
+
+// Triangulate flattened contours under a fill rule.
+// Returns (points, indices, method) as FloatArray × Array UInt32 × UInt8.
+LEAN_EXPORT lean_obj_res lean_afferent_triangulate(
+    b_lean_obj_arg points_arr,
+    b_lean_obj_arg contour_ends_arr,
+    uint8_t rule,
+    lean_obj_arg world
+) {
+    size_t contour_count = lean_array_size(contour_ends_arr);
+    uint32_t* contour_ends = malloc((contour_count ? contour_count : 1) * sizeof(uint32_t));
+    if (!contour_ends) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Triangulator: out of memory")));
+    }
+    for (size_t i = 0; i < contour_count; i++) {
+        contour_ends[i] = lean_unbox_uint32(lean_array_get_core(contour_ends_arr, i));
+    }
+    size_t point_count = (size_t)lean_unbox(lean_float_array_size(points_arr)) / 2;
+    if (contour_count > 0 && contour_ends[contour_count - 1] > point_count) {
+        free(contour_ends);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Triangulator: contour end past the last point")));
+    }
+
+    AfferentTriangulation t;
+    bool ok = afferent_triangulate(lean_float_array_cptr(points_arr), contour_ends, (uint32_t)contour_count,
+        rule == AFFERENT_FILL_RULE_EVENODD ? AFFERENT_FILL_RULE_EVENODD : AFFERENT_FILL_RULE_NONZERO, &t);
+    free(contour_ends);
+    if (!ok) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Triangulator: non-finite point, decreasing contour ends, sweep event limit or out of memory")));
+    }
+
+    size_t n = (size_t)t.point_count * 2;
+    lean_object* points = lean_alloc_sarray(sizeof(double), n, n);
+    if (n > 0) memcpy(lean_float_array_cptr(points), t.points, n * sizeof(double));
+    lean_object* indices = mk_uint32_array(t.indices, t.index_count);
+    uint8_t method = (uint8_t)t.method;
+    afferent_triangulation_free(&t);
+
+    lean_object* inner = lean_alloc_ctor(0, 2, 0);
+    lean_ctor_set(inner, 0, indices);
+    lean_ctor_set(inner, 1, lean_box(method));
+    lean_object* outer = lean_alloc_ctor(0, 2, 0);
+    lean_ctor_set(outer, 0, points);
+    lean_ctor_set(outer, 1, inner);
+    return lean_io_result_mk_ok(outer);
+}
+
+// ============== Polyline Reducer FFI ==============
+
+// Reduce a polyline (x, y pairs) for stroking under a transform (empty or 6 entries).
+// Returns the kept points as a FloatArray, untransformed.
+LEAN_EXPORT lean_obj_res lean_afferent_polyline_reduce(
+    b_lean_obj_arg points_arr,
+    b_lean_obj_arg transform_arr,
+    double tolerance,
+    uint8_t method,
+    lean_obj_arg world
+) {
+    size_t transform_len = (size_t)lean_unbox(lean_float_array_size(transform_arr));
+    if (transform_len != 0 && transform_len != 6) {
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Polyline: transform must have 6 entries")));
+    }
+    size_t count = (size_t)lean_unbox(lean_float_array_size(points_arr)) / 2;
+    lean_object* out = lean_alloc_sarray(sizeof(double), 0, count * 2);
+    size_t kept = 0;
+    bool ok = afferent_polyline_reduce(lean_float_array_cptr(points_arr), count,
+        transform_len == 6 ? lean_float_array_cptr(transform_arr) : NULL, tolerance,
+        method <= AFFERENT_POLYLINE_REDUCE_RDP ? (AfferentPolylineReduce)method : AFFERENT_POLYLINE_REDUCE_AUTO,
+        lean_float_array_cptr(out), &kept);
+    if (!ok) {
+        lean_dec(out);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Polyline: non-finite point or out of memory")));
+    }
+    lean_sarray_set_size(out, kept * 2);
+    return lean_io_result_mk_ok(out);
+}
+
+// Draw instanced shapes directly from FloatBuffer (zero-copy path)
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_rects_buffer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg buffer_obj,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+
+    // Direct pointer pass - no conversion needed!
+    afferent_renderer_draw_instanced_rects(
+        renderer,
+        afferent_float_buffer_data(buffer),
+        instance_count
+    );
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_triangles_buffer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg buffer_obj,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+
+    afferent_renderer_draw_instanced_triangles(
+        renderer,
+        afferent_float_buffer_data(buffer),
+        instance_count
+    );
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_instanced_circles_buffer(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg buffer_obj,
+    uint32_t instance_count,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFloatBufferRef buffer = (AfferentFloatBufferRef)lean_get_external_data(buffer_obj);
+
+    afferent_renderer_draw_instanced_circles(
+        renderer,
+        afferent_float_buffer_data(buffer),
         instance_count
     );
     return lean_io_result_mk_ok(lean_box(0));
@@ -1074,15 +3066,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_upload_animated_rects(
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
     // Convert Lean Float array to C float array (one-time upload)
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        data[i] = (float)lean_unbox_float(lean_array_get_core(data_arr, i));
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_upload_animated_rects(renderer, data, count);
     }
-
-    afferent_renderer_upload_animated_rects(renderer, data, count);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1095,15 +3085,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_upload_animated_triangles(
 ) {
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        data[i] = (float)lean_unbox_float(lean_array_get_core(data_arr, i));
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_upload_animated_triangles(renderer, data, count);
     }
-
-    afferent_renderer_upload_animated_triangles(renderer, data, count);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1116,15 +3104,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_upload_animated_circles(
 ) {
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        data[i] = (float)lean_unbox_float(lean_array_get_core(data_arr, i));
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_upload_animated_circles(renderer, data, count);
     }
-
-    afferent_renderer_upload_animated_circles(renderer, data, count);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1178,15 +3164,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_upload_orbital_particles(
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
     // Convert Lean Float array to C float array (one-time upload)
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        data[i] = (float)lean_unbox_float(lean_array_get_core(data_arr, i));
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_upload_orbital_particles(renderer, data, count, (float)centerX, (float)centerY);
     }
-
-    afferent_renderer_upload_orbital_particles(renderer, data, count, (float)centerX, (float)centerY);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1215,16 +3199,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_circles(
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
     // Extract float array data - 4 floats per circle
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        lean_object* elem = lean_array_get_core(data_arr, i);
-        data[i] = (float)lean_unbox_float(elem);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_draw_dynamic_circles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
     }
-
-    afferent_renderer_draw_dynamic_circles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1265,16 +3246,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_rects(
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
     // Extract float array data - 5 floats per rect
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        lean_object* elem = lean_array_get_core(data_arr, i);
-        data[i] = (float)lean_unbox_float(elem);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_draw_dynamic_rects(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
     }
-
-    afferent_renderer_draw_dynamic_rects(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1292,16 +3270,87 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_triangles(
     AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
 
     // Extract float array data - 5 floats per triangle
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        lean_object* elem = lean_array_get_core(data_arr, i);
-        data[i] = (float)lean_unbox_float(elem);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_draw_dynamic_triangles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Narrow `count` shapes of `stride` floats each into frame scratch; NULL on short input or OOM
+static const float* dynamic_data_from_float_array(AfferentFrameArenaRef arena, lean_obj_arg data_arr,
+    uint32_t count, size_t stride) {
+    size_t arr_size = (size_t)lean_unbox(lean_float_array_size(data_arr));
+    size_t needed = (size_t)count * stride;
+    if (count == 0 || arr_size < needed) {
+        return NULL;
+    }
+    return scratch_narrow(arena, data_arr, needed);
+}
+
+// Draw dynamic circles from FloatArray: [pixelX, pixelY, hueBase, radiusPixels] × count
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_circles_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg data_arr,
+    uint32_t count,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = dynamic_data_from_float_array(arena, data_arr, count, 4);
+    if (data) {
+        afferent_renderer_draw_dynamic_circles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
     }
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
 
-    afferent_renderer_draw_dynamic_triangles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
+// Draw dynamic rects from FloatArray: [pixelX, pixelY, hueBase, halfSizePixels, rotation] × count
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_rects_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg data_arr,
+    uint32_t count,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = dynamic_data_from_float_array(arena, data_arr, count, 5);
+    if (data) {
+        afferent_renderer_draw_dynamic_rects(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
 
-    free(data);
+// Draw dynamic triangles from FloatArray: [pixelX, pixelY, hueBase, halfSizePixels, rotation] × count
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_dynamic_triangles_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg data_arr,
+    uint32_t count,
+    double time,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    const float* data = dynamic_data_from_float_array(arena, data_arr, count, 5);
+    if (data) {
+        afferent_renderer_draw_dynamic_triangles(renderer, data, count, (float)time, (float)canvasWidth, (float)canvasHeight);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1392,16 +3441,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_sprites(
     AfferentTextureRef texture = (AfferentTextureRef)lean_get_external_data(texture_obj);
 
     // Extract float array data - 5 floats per sprite
-    size_t arr_size = lean_array_size(data_arr);
-    float* data = malloc(arr_size * sizeof(float));
-    for (size_t i = 0; i < arr_size; i++) {
-        lean_object* elem = lean_array_get_core(data_arr, i);
-        data[i] = (float)lean_unbox_float(elem);
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* data = scratch_floats(arena, data_arr, lean_array_size(data_arr));
+    if (data) {
+        afferent_renderer_draw_sprites(renderer, texture, data, count, (float)canvasWidth, (float)canvasHeight);
     }
-
-    afferent_renderer_draw_sprites(renderer, texture, data, count, (float)canvasWidth, (float)canvasHeight);
-
-    free(data);
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1483,6 +3529,34 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_sprites_instance_buffer(
     return lean_io_result_mk_ok(lean_box(0));
 }
 
+// Draw sprites straight from a particle FloatArray ([x, y, vx, vy, hue]).
+// The array is borrowed: its payload is read in place during this call only.
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_sprites_particles(
+    b_lean_obj_arg renderer_obj,
+    b_lean_obj_arg texture_obj,
+    b_lean_obj_arg particle_data_arr,
+    uint32_t count,
+    double halfSize,
+    double canvasWidth,
+    double canvasHeight,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+    AfferentTextureRef texture = (AfferentTextureRef)lean_get_external_data(texture_obj);
+
+    size_t arr_size = (size_t)lean_unbox(lean_float_array_size(particle_data_arr));
+    if ((size_t)count * 5 > arr_size) {
+        count = (uint32_t)(arr_size / 5);
+    }
+
+    afferent_renderer_draw_sprites_particles(
+        renderer, texture,
+        lean_float_array_cptr(particle_data_arr),
+        count, (float)halfSize, (float)canvasWidth, (float)canvasHeight
+    );
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
 // Draw a textured rectangle with source and destination rectangles
 // Used for map tile rendering with cropping and scaling
 LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_textured_rect(
@@ -1538,40 +3612,18 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d(
         return lean_io_result_mk_ok(lean_box(0));
     }
 
-    AfferentVertex3D* vertices = malloc(vertex_count * sizeof(AfferentVertex3D));
-    if (!vertices) {
-        return lean_io_result_mk_error(lean_mk_io_user_error(
-            lean_mk_string("Failed to allocate vertex buffer")));
-    }
-
-    for (size_t i = 0; i < vertex_count; i++) {
-        size_t base = i * 10;
-        // Position
-        vertices[i].position[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 0));
-        vertices[i].position[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 1));
-        vertices[i].position[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 2));
-        // Normal
-        vertices[i].normal[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 3));
-        vertices[i].normal[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 4));
-        vertices[i].normal[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 5));
-        // Color
-        vertices[i].color[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 6));
-        vertices[i].color[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 7));
-        vertices[i].color[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 8));
-        vertices[i].color[3] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 9));
-    }
+    // AfferentVertex3D is 10 packed floats: position[3], normal[3], color[4]
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex3D* vertices = (AfferentVertex3D*)scratch_floats(arena, vertices_arr, vertex_count * 10);
 
     // Convert index array
     size_t index_count = lean_array_size(indices_arr);
-    uint32_t* indices = malloc(index_count * sizeof(uint32_t));
-    if (!indices) {
-        free(vertices);
+    uint32_t* indices = scratch_indices(arena, indices_arr, 0, index_count);
+    if (!vertices || !indices) {
+        afferent_frame_arena_rewind(arena, scratch);
         return lean_io_result_mk_error(lean_mk_io_user_error(
-            lean_mk_string("Failed to allocate index buffer")));
-    }
-
-    for (size_t i = 0; i < index_count; i++) {
-        indices[i] = lean_unbox_uint32(lean_array_get_core(indices_arr, i));
+            lean_mk_string("Failed to allocate mesh buffers")));
     }
 
     // Convert MVP matrix (16 floats)
@@ -1599,9 +3651,7 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d(
         mvp, model, light, (float)ambient
     );
 
-    free(vertices);
-    free(indices);
-
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1635,40 +3685,18 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_with_fog(
         return lean_io_result_mk_ok(lean_box(0));
     }
 
-    AfferentVertex3D* vertices = malloc(vertex_count * sizeof(AfferentVertex3D));
-    if (!vertices) {
-        return lean_io_result_mk_error(lean_mk_io_user_error(
-            lean_mk_string("Failed to allocate vertex buffer")));
-    }
-
-    for (size_t i = 0; i < vertex_count; i++) {
-        size_t base = i * 10;
-        // Position
-        vertices[i].position[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 0));
-        vertices[i].position[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 1));
-        vertices[i].position[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 2));
-        // Normal
-        vertices[i].normal[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 3));
-        vertices[i].normal[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 4));
-        vertices[i].normal[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 5));
-        // Color
-        vertices[i].color[0] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 6));
-        vertices[i].color[1] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 7));
-        vertices[i].color[2] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 8));
-        vertices[i].color[3] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, base + 9));
-    }
+    // AfferentVertex3D is 10 packed floats: position[3], normal[3], color[4]
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex3D* vertices = (AfferentVertex3D*)scratch_floats(arena, vertices_arr, vertex_count * 10);
 
     // Convert index array
     size_t index_count = lean_array_size(indices_arr);
-    uint32_t* indices = malloc(index_count * sizeof(uint32_t));
-    if (!indices) {
-        free(vertices);
+    uint32_t* indices = scratch_indices(arena, indices_arr, 0, index_count);
+    if (!vertices || !indices) {
+        afferent_frame_arena_rewind(arena, scratch);
         return lean_io_result_mk_error(lean_mk_io_user_error(
-            lean_mk_string("Failed to allocate index buffer")));
-    }
-
-    for (size_t i = 0; i < index_count; i++) {
-        indices[i] = lean_unbox_uint32(lean_array_get_core(indices_arr, i));
+            lean_mk_string("Failed to allocate mesh buffers")));
     }
 
     // Convert MVP matrix (16 floats)
@@ -1709,9 +3737,111 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_with_fog(
         camera_pos, fog_color, (float)fog_start, (float)fog_end
     );
 
-    free(vertices);
-    free(indices);
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Draw 3D mesh from a FloatArray of vertices (10 per vertex, same layout as above).
+// AfferentVertex3D is 10 packed floats, so the vertices narrow straight into place.
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg vertices_arr,
+    lean_obj_arg indices_arr,
+    lean_obj_arg mvp_matrix,
+    lean_obj_arg model_matrix,
+    lean_obj_arg light_dir,
+    double ambient,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+
+    size_t vertex_count = (size_t)lean_unbox(lean_float_array_size(vertices_arr)) / 10;
+    size_t index_count = lean_array_size(indices_arr);
+    if (vertex_count == 0 || index_count == 0) {
+        return lean_io_result_mk_ok(lean_box(0));
+    }
+
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex3D* vertices = (AfferentVertex3D*)scratch_narrow(arena, vertices_arr, vertex_count * 10);
+    uint32_t* indices = scratch_indices(arena, indices_arr, 0, index_count);
+    if (!vertices || !indices) {
+        afferent_frame_arena_rewind(arena, scratch);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate mesh buffers")));
+    }
+
+    float mvp[16], model[16], light[3];
+    for (size_t i = 0; i < 16; i++) {
+        mvp[i] = (float)lean_unbox_float(lean_array_get_core(mvp_matrix, i));
+        model[i] = (float)lean_unbox_float(lean_array_get_core(model_matrix, i));
+    }
+    for (size_t i = 0; i < 3; i++) {
+        light[i] = (float)lean_unbox_float(lean_array_get_core(light_dir, i));
+    }
+
+    afferent_renderer_draw_mesh_3d(
+        renderer, vertices, (uint32_t)vertex_count,
+        indices, (uint32_t)index_count,
+        mvp, model, light, (float)ambient
+    );
+
+    afferent_frame_arena_rewind(arena, scratch);
+    return lean_io_result_mk_ok(lean_box(0));
+}
+
+// Draw 3D mesh with fog from a FloatArray of vertices (10 per vertex)
+LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_with_fog_float_array(
+    lean_obj_arg renderer_obj,
+    lean_obj_arg vertices_arr,
+    lean_obj_arg indices_arr,
+    lean_obj_arg mvp_matrix,
+    lean_obj_arg model_matrix,
+    lean_obj_arg light_dir,
+    double ambient,
+    lean_obj_arg camera_pos_arr,
+    lean_obj_arg fog_color_arr,
+    double fog_start,
+    double fog_end,
+    lean_obj_arg world
+) {
+    AfferentRendererRef renderer = (AfferentRendererRef)lean_get_external_data(renderer_obj);
+
+    size_t vertex_count = (size_t)lean_unbox(lean_float_array_size(vertices_arr)) / 10;
+    size_t index_count = lean_array_size(indices_arr);
+    if (vertex_count == 0 || index_count == 0) {
+        return lean_io_result_mk_ok(lean_box(0));
+    }
+
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    AfferentVertex3D* vertices = (AfferentVertex3D*)scratch_narrow(arena, vertices_arr, vertex_count * 10);
+    uint32_t* indices = scratch_indices(arena, indices_arr, 0, index_count);
+    if (!vertices || !indices) {
+        afferent_frame_arena_rewind(arena, scratch);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate mesh buffers")));
+    }
+
+    float mvp[16], model[16], light[3], camera_pos[3], fog_color[3];
+    for (size_t i = 0; i < 16; i++) {
+        mvp[i] = (float)lean_unbox_float(lean_array_get_core(mvp_matrix, i));
+        model[i] = (float)lean_unbox_float(lean_array_get_core(model_matrix, i));
+    }
+    for (size_t i = 0; i < 3; i++) {
+        light[i] = (float)lean_unbox_float(lean_array_get_core(light_dir, i));
+        camera_pos[i] = (float)lean_unbox_float(lean_array_get_core(camera_pos_arr, i));
+        fog_color[i] = (float)lean_unbox_float(lean_array_get_core(fog_color_arr, i));
+    }
+
+    afferent_renderer_draw_mesh_3d_with_fog(
+        renderer, vertices, (uint32_t)vertex_count,
+        indices, (uint32_t)index_count,
+        mvp, model, light, (float)ambient,
+        camera_pos, fog_color, (float)fog_start, (float)fog_end
+    );
 
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
 
@@ -1812,18 +3942,6 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_ocean_projected_grid_with_f
 // Textured 3D Mesh Rendering FFI
 // =============================================================================
 
-// Cached CPU-side conversions for 3D mesh draws.
-// The Seascape frigate is drawn as many submeshes that all share the same
-// vertex/index arrays. Re-converting and malloc/free per submesh is extremely
-// expensive and can lead to memory pressure/crashes.
-static lean_object* g_cached_mesh_vertices_arr = NULL;
-static float* g_cached_mesh_vertices = NULL;
-static size_t g_cached_mesh_vertices_floats = 0;
-
-static lean_object* g_cached_mesh_indices_arr = NULL;
-static uint32_t* g_cached_mesh_indices = NULL;
-static size_t g_cached_mesh_indices_count = 0;
-
 // Draw textured 3D mesh with fog
 // vertices_arr: Array Float (12 floats per vertex: pos[3], normal[3], uv[2], color[4])
 // indices_arr: Array UInt32
@@ -1856,68 +3974,25 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_textured(
         return lean_io_result_mk_ok(lean_box(0));
     }
 
-    // Convert/cached vertices
-    if (g_cached_mesh_vertices_arr != vertices_arr || g_cached_mesh_vertices_floats != vert_floats) {
-        if (g_cached_mesh_vertices_arr) {
-            lean_dec(g_cached_mesh_vertices_arr);
-            g_cached_mesh_vertices_arr = NULL;
-        }
-        if (g_cached_mesh_vertices) {
-            free(g_cached_mesh_vertices);
-            g_cached_mesh_vertices = NULL;
-        }
-
-        g_cached_mesh_vertices = malloc(vert_floats * sizeof(float));
-        if (!g_cached_mesh_vertices) {
-            return lean_io_result_mk_error(lean_mk_io_user_error(
-                lean_mk_string("Failed to allocate vertex buffer")));
-        }
-
-        for (size_t i = 0; i < vert_floats; i++) {
-            g_cached_mesh_vertices[i] = (float)lean_unbox_float(lean_array_get_core(vertices_arr, i));
-        }
-
-        g_cached_mesh_vertices_floats = vert_floats;
-        g_cached_mesh_vertices_arr = vertices_arr;
-        lean_inc(g_cached_mesh_vertices_arr);
-    }
-
-    // Convert/cached indices
-    size_t total_indices = lean_array_size(indices_arr);
-    if (g_cached_mesh_indices_arr != indices_arr || g_cached_mesh_indices_count != total_indices) {
-        if (g_cached_mesh_indices_arr) {
-            lean_dec(g_cached_mesh_indices_arr);
-            g_cached_mesh_indices_arr = NULL;
-        }
-        if (g_cached_mesh_indices) {
-            free(g_cached_mesh_indices);
-            g_cached_mesh_indices = NULL;
-        }
-
-        g_cached_mesh_indices = malloc(total_indices * sizeof(uint32_t));
-        if (!g_cached_mesh_indices) {
-            return lean_io_result_mk_error(lean_mk_io_user_error(
-                lean_mk_string("Failed to allocate index buffer")));
-        }
-
-        for (size_t i = 0; i < total_indices; i++) {
-            g_cached_mesh_indices[i] = lean_unbox_uint32(lean_array_get_core(indices_arr, i));
-        }
-
-        g_cached_mesh_indices_count = total_indices;
-        g_cached_mesh_indices_arr = indices_arr;
-        lean_inc(g_cached_mesh_indices_arr);
-    }
-
     // Clamp to valid range.
+    size_t total_indices = lean_array_size(indices_arr);
     if (index_offset >= total_indices) {
         return lean_io_result_mk_ok(lean_box(0));
     }
     if ((size_t)index_offset + (size_t)index_count > total_indices) {
         index_count = (uint32_t)(total_indices - (size_t)index_offset);
-        if (index_count == 0) {
-            return lean_io_result_mk_ok(lean_box(0));
-        }
+    }
+
+    // Convert the vertices and only the drawn index range into frame scratch.
+    // Submeshes drawn every frame should use a persistent Mesh instead.
+    AfferentFrameArenaRef arena = afferent_renderer_frame_arena(renderer);
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    float* vertices = scratch_floats(arena, vertices_arr, vertex_count * 12);
+    uint32_t* indices = scratch_indices(arena, indices_arr, index_offset, index_count);
+    if (!vertices || !indices) {
+        afferent_frame_arena_rewind(arena, scratch);
+        return lean_io_result_mk_error(lean_mk_io_user_error(
+            lean_mk_string("Failed to allocate mesh buffers")));
     }
 
     // Convert matrices and vectors
@@ -1937,12 +4012,13 @@ LEAN_EXPORT lean_obj_res lean_afferent_renderer_draw_mesh_3d_textured(
     // Draw the textured mesh
     afferent_renderer_draw_mesh_3d_textured(
         renderer,
-        g_cached_mesh_vertices, (uint32_t)vertex_count,
-        g_cached_mesh_indices, index_offset, index_count,
+        vertices, (uint32_t)vertex_count,
+        indices, 0, index_count,
         mvp, model, light, (float)ambient,
         camera_pos, fog_color, (float)fog_start, (float)fog_end,
         texture
     );
 
+    afferent_frame_arena_rewind(arena, scratch);
     return lean_io_result_mk_ok(lean_box(0));
 }
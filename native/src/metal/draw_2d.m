@@ -26,7 +26,8 @@ void afferent_renderer_draw_triangles(
 
     [renderer->currentEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
                                          indexCount:index_count
-                                          indexType:MTLIndexTypeUInt32
+                                          indexType:(index_buffer->indexFormat == AFFERENT_INDEX_U16
+                                                        ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32)
                                         indexBuffer:index_buffer->mtlBuffer
                                   indexBufferOffset:0];
 }
@@ -159,6 +160,48 @@ void afferent_renderer_draw_instanced_circles(
     }
 }
 
+// Draw instanced Canvas shapes - rects and ellipses in one draw
+void afferent_renderer_draw_instanced_shapes(
+    AfferentRendererRef renderer,
+    const float* instance_data,
+    uint32_t instance_count
+) {
+    if (!renderer || !renderer->currentEncoder || !instance_data || instance_count == 0) {
+        return;
+    }
+
+    @autoreleasepool {
+        size_t data_size = instance_count * sizeof(ShapeInstanceData);
+        id<MTLBuffer> instanceBuffer = pool_acquire_buffer(
+            renderer->device,
+            g_buffer_pool.vertex_pool,
+            &g_buffer_pool.vertex_pool_count,
+            data_size,
+            true
+        );
+
+        if (!instanceBuffer) {
+            NSLog(@"Failed to create shape instance buffer");
+            return;
+        }
+
+        memcpy(instanceBuffer.contents, instance_data, data_size);
+
+        // The pass is single-sampled while MSAA is off
+        [renderer->currentEncoder setRenderPipelineState:renderer->msaaEnabled
+            ? renderer->shapePipelineStateMSAA : renderer->shapePipelineStateNoMSAA];
+        [renderer->currentEncoder setVertexBuffer:instanceBuffer offset:0 atIndex:0];
+
+        // Draw: 4 vertices per quad (triangle strip)
+        [renderer->currentEncoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                                     vertexStart:0
+                                     vertexCount:4
+                                   instanceCount:instance_count];
+
+        [renderer->currentEncoder setRenderPipelineState:renderer->pipelineState];
+    }
+}
+
 void afferent_renderer_set_scissor(
     AfferentRendererRef renderer,
     uint32_t x,
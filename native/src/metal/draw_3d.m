@@ -297,6 +297,33 @@ void afferent_renderer_draw_mesh_3d_with_fog(
     }
 }
 
+// Get or create the Metal texture for a texture handle (cached on the handle)
+static id<MTLTexture> ensure_mesh_texture(AfferentRendererRef renderer, AfferentTextureRef texture) {
+    id<MTLTexture> metalTex = (__bridge id<MTLTexture>)afferent_texture_get_metal_texture(texture);
+
+    if (!metalTex) {
+        // Create Metal texture from pixel data
+        const uint8_t* pixelData = afferent_texture_get_data(texture);
+        uint32_t texWidth, texHeight;
+        afferent_texture_get_size(texture, &texWidth, &texHeight);
+
+        if (!pixelData || texWidth == 0 || texHeight == 0) {
+            NSLog(@"Invalid texture data for 3D textured mesh");
+            return nil;
+        }
+
+        metalTex = createMetalTexture(renderer->device, pixelData, texWidth, texHeight);
+        if (!metalTex) {
+            NSLog(@"Failed to create Metal texture for 3D textured mesh");
+            return nil;
+        }
+
+        // Store the Metal texture in the texture handle (retain with __bridge_retained)
+        afferent_texture_set_metal_texture(texture, (__bridge_retained void*)metalTex);
+    }
+    return metalTex;
+}
+
 // 3D Textured Mesh Rendering with diffuse texture, lighting, and fog
 void afferent_renderer_draw_mesh_3d_textured(
     AfferentRendererRef renderer,
@@ -321,29 +348,8 @@ void afferent_renderer_draw_mesh_3d_textured(
     }
 
     @autoreleasepool {
-        // Get or create Metal texture for this texture handle
-        id<MTLTexture> metalTex = (__bridge id<MTLTexture>)afferent_texture_get_metal_texture(texture);
-
-        if (!metalTex) {
-            // Create Metal texture from pixel data
-            const uint8_t* pixelData = afferent_texture_get_data(texture);
-            uint32_t texWidth, texHeight;
-            afferent_texture_get_size(texture, &texWidth, &texHeight);
-
-            if (!pixelData || texWidth == 0 || texHeight == 0) {
-                NSLog(@"Invalid texture data for 3D textured mesh");
-                return;
-            }
-
-            metalTex = createMetalTexture(renderer->device, pixelData, texWidth, texHeight);
-            if (!metalTex) {
-                NSLog(@"Failed to create Metal texture for 3D textured mesh");
-                return;
-            }
-
-            // Store the Metal texture in the texture handle (retain with __bridge_retained)
-            afferent_texture_set_metal_texture(texture, (__bridge_retained void*)metalTex);
-        }
+        id<MTLTexture> metalTex = ensure_mesh_texture(renderer, texture);
+        if (!metalTex) return;
 
         // Acquire temporary vertex buffer (pooled)
         // 12 floats per vertex: position(3) + normal(3) + uv(2) + color(4)
@@ -419,3 +425,154 @@ void afferent_renderer_draw_mesh_3d_textured(
         [renderer->currentEncoder setRenderPipelineState:renderer->pipelineState];
     }
 }
+
+// ============================================================================
+// Persistent Mesh rendering
+// ============================================================================
+
+static void release_mesh_buffers(void* gpu_vertices, void* gpu_indices) {
+    // Transfer ownership back to ARC so the buffers are released
+    id<MTLBuffer> vb = (__bridge_transfer id<MTLBuffer>)gpu_vertices;
+    id<MTLBuffer> ib = (__bridge_transfer id<MTLBuffer>)gpu_indices;
+    vb = nil;
+    ib = nil;
+}
+
+// Create GPU buffers on first use, and fresh ones for every update: draws already
+// encoded this frame still read the old buffers, which their command buffer
+// retains until it completes, so they are never written once bound.
+// Only the dirty range is written from the CPU copy. The clean ranges on either
+// side are blitted from the old buffer on the GPU, in a command buffer committed
+// now, so the queue runs it before the frame's draws that read the new buffer.
+static id<MTLBuffer> replace_mesh_buffer(AfferentRendererRef renderer, id<MTLBuffer> old,
+    const void* data, size_t length, size_t dirty_offset, size_t dirty_length,
+    id<MTLCommandBuffer>* blits) {
+    if (!old) {
+        return [renderer->device newBufferWithBytes:data length:length
+                                            options:MTLResourceStorageModeShared];
+    }
+    id<MTLBuffer> fresh = [renderer->device newBufferWithLength:length
+                                                        options:MTLResourceStorageModeShared];
+    if (!fresh) return nil;
+    memcpy((uint8_t*)fresh.contents + dirty_offset, (const uint8_t*)data + dirty_offset, dirty_length);
+
+    size_t tail = dirty_offset + dirty_length;
+    if (dirty_offset == 0 && tail == length) return fresh;
+    if (!*blits) *blits = [renderer->commandQueue commandBuffer];
+    id<MTLBlitCommandEncoder> blit = [*blits blitCommandEncoder];
+    if (dirty_offset > 0) {
+        [blit copyFromBuffer:old sourceOffset:0 toBuffer:fresh destinationOffset:0 size:dirty_offset];
+    }
+    if (tail < length) {
+        [blit copyFromBuffer:old sourceOffset:tail toBuffer:fresh destinationOffset:tail size:length - tail];
+    }
+    [blit endEncoding];
+    return fresh;
+}
+
+static bool sync_mesh_buffers(AfferentRendererRef renderer, AfferentMeshRef mesh) {
+    size_t stride = afferent_mesh_format_floats(afferent_mesh_format(mesh)) * sizeof(float);
+    id<MTLBuffer> vb = (__bridge id<MTLBuffer>)afferent_mesh_gpu_vertices(mesh);
+    id<MTLBuffer> ib = (__bridge id<MTLBuffer>)afferent_mesh_gpu_indices(mesh);
+    uint32_t vertex_first = 0, vertex_count = 0, index_first = 0, index_count = 0;
+    bool vertices_dirty = afferent_mesh_dirty_vertices(mesh, &vertex_first, &vertex_count) || !vb;
+    bool indices_dirty = afferent_mesh_dirty_indices(mesh, &index_first, &index_count) || !ib;
+    if (!vertices_dirty && !indices_dirty) return true;
+
+    id<MTLCommandBuffer> blits = nil;
+    if (vertices_dirty) {
+        vb = replace_mesh_buffer(renderer, vb, afferent_mesh_vertices(mesh),
+            afferent_mesh_vertex_count(mesh) * stride, vertex_first * stride, vertex_count * stride, &blits);
+    }
+    if (indices_dirty) {
+        ib = replace_mesh_buffer(renderer, ib, afferent_mesh_indices(mesh),
+            afferent_mesh_index_count(mesh) * sizeof(uint32_t), index_first * sizeof(uint32_t),
+            index_count * sizeof(uint32_t), &blits);
+    }
+    [blits commit];
+    if (!vb || !ib) {
+        NSLog(@"Failed to create mesh buffers");
+        return false;
+    }
+    // Releases the previous pair; a buffer kept from it is retained again first
+    afferent_mesh_set_gpu_buffers(mesh, (__bridge_retained void*)vb, (__bridge_retained void*)ib,
+        release_mesh_buffers);
+    afferent_mesh_clear_dirty(mesh);
+    return true;
+}
+
+void afferent_renderer_draw_mesh(
+    AfferentRendererRef renderer,
+    AfferentMeshRef mesh,
+    uint32_t index_offset,
+    uint32_t index_count,
+    const float* mvp_matrix,
+    const float* model_matrix,
+    const float* light_dir,
+    float ambient,
+    const float* camera_pos,
+    const float* fog_color,
+    float fog_start,
+    float fog_end,
+    AfferentTextureRef texture
+) {
+    if (!renderer || !renderer->currentEncoder || !mesh || !mvp_matrix || !model_matrix || !light_dir) {
+        return;
+    }
+    if (!afferent_mesh_clamp_range(mesh, &index_offset, &index_count)) return;
+    bool textured = afferent_mesh_format(mesh) == AFFERENT_MESH_FORMAT_TEXTURED;
+    if (textured && !texture) return;
+
+    @autoreleasepool {
+        if (!sync_mesh_buffers(renderer, mesh)) return;
+        id<MTLBuffer> vb = (__bridge id<MTLBuffer>)afferent_mesh_gpu_vertices(mesh);
+        id<MTLBuffer> ib = (__bridge id<MTLBuffer>)afferent_mesh_gpu_indices(mesh);
+
+        // Scene3DUniforms is the prefix of Scene3DTexturedUniforms
+        Scene3DTexturedUniforms uniforms;
+        memset(&uniforms, 0, sizeof(uniforms));
+        memcpy(uniforms.modelViewProj, mvp_matrix, 64);
+        memcpy(uniforms.modelMatrix, model_matrix, 64);
+        memcpy(uniforms.lightDir, light_dir, 12);
+        uniforms.ambient = ambient;
+        if (camera_pos && fog_color) {
+            memcpy(uniforms.cameraPos, camera_pos, 12);
+            memcpy(uniforms.fogColor, fog_color, 12);
+            uniforms.fogStart = fog_start;
+            uniforms.fogEnd = fog_end;
+        } else {
+            // start == end disables fog in the shader
+            uniforms.fogColor[0] = 0.5f;
+            uniforms.fogColor[1] = 0.5f;
+            uniforms.fogColor[2] = 0.5f;
+        }
+        uniforms.uvScale[0] = 1.0f;
+        uniforms.uvScale[1] = 1.0f;
+
+        size_t uniform_size = textured ? sizeof(Scene3DTexturedUniforms) : sizeof(Scene3DUniforms);
+        [renderer->currentEncoder setRenderPipelineState:textured ? renderer->pipeline3DTextured : renderer->pipeline3D];
+        [renderer->currentEncoder setDepthStencilState:renderer->depthState];
+        [renderer->currentEncoder setVertexBuffer:vb offset:0 atIndex:0];
+        [renderer->currentEncoder setVertexBytes:&uniforms length:uniform_size atIndex:1];
+        [renderer->currentEncoder setFragmentBytes:&uniforms length:uniform_size atIndex:0];
+
+        if (textured) {
+            id<MTLTexture> metalTex = ensure_mesh_texture(renderer, texture);
+            if (!metalTex) {
+                [renderer->currentEncoder setRenderPipelineState:renderer->pipelineState];
+                return;
+            }
+            [renderer->currentEncoder setFragmentTexture:metalTex atIndex:0];
+            [renderer->currentEncoder setFragmentSamplerState:renderer->texturedMeshSampler atIndex:0];
+        }
+
+        // Submesh: draw straight out of the resident index buffer at an offset
+        [renderer->currentEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                             indexCount:index_count
+                                              indexType:MTLIndexTypeUInt32
+                                            indexBuffer:ib
+                                      indexBufferOffset:(NSUInteger)index_offset * sizeof(uint32_t)];
+
+        [renderer->currentEncoder setRenderPipelineState:renderer->pipelineState];
+    }
+}
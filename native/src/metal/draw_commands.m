@@ -0,0 +1,81 @@
+// draw_commands.m - Metal sink for packed 2D command streams
+#import "render.h"
+
+typedef struct {
+    AfferentRendererRef renderer;
+    const AfferentFontRef* fonts;
+    const AfferentTextureRef* textures;
+    float canvasWidth;
+    float canvasHeight;
+} CommandSinkContext;
+
+static void command_triangles(void* ctx, const AfferentVertex* vertices, uint32_t vertex_count,
+    const uint32_t* indices, uint32_t index_count) {
+    CommandSinkContext* c = (CommandSinkContext*)ctx;
+    AfferentBufferRef vertex_buffer = NULL;
+    AfferentBufferRef index_buffer = NULL;
+    if (afferent_buffer_create_vertex(c->renderer, vertices, vertex_count, &vertex_buffer) != AFFERENT_OK ||
+        afferent_buffer_create_index(c->renderer, indices, index_count, &index_buffer) != AFFERENT_OK) {
+        return;
+    }
+    afferent_renderer_draw_triangles(c->renderer, vertex_buffer, index_buffer, index_count);
+}
+
+static void command_text(void* ctx, uint32_t font, const char* utf8, uint32_t length,
+    float x, float y, const float* color, const float* transform) {
+    CommandSinkContext* c = (CommandSinkContext*)ctx;
+    // The stream's string is not NUL-terminated; copy it into frame scratch
+    AfferentFrameArenaRef arena = c->renderer->frameArena;
+    AfferentFrameArenaMark scratch = afferent_frame_arena_mark(arena);
+    char* text = afferent_frame_arena_alloc(arena, (size_t)length + 1);
+    if (text) {
+        memcpy(text, utf8, length);
+        text[length] = '\0';
+        afferent_text_render(c->renderer, c->fonts[font], text, x, y,
+            color[0], color[1], color[2], color[3], transform, c->canvasWidth, c->canvasHeight);
+    }
+    afferent_frame_arena_rewind(arena, scratch);
+}
+
+// Clips arrive in logical canvas pixels; scale to the drawable like Canvas.clip
+static void command_set_clip(void* ctx, float x, float y, float width, float height) {
+    CommandSinkContext* c = (CommandSinkContext*)ctx;
+    float scaleX = c->canvasWidth > 0 ? (float)c->renderer->screenWidth / c->canvasWidth : 1.0f;
+    float scaleY = c->canvasHeight > 0 ? (float)c->renderer->screenHeight / c->canvasHeight : 1.0f;
+    float sx = x * scaleX, sy = y * scaleY;
+    float sw = width * scaleX, sh = height * scaleY;
+    afferent_renderer_set_scissor(c->renderer,
+        sx > 0 ? (uint32_t)sx : 0, sy > 0 ? (uint32_t)sy : 0,
+        sw > 0 ? (uint32_t)sw : 0, sh > 0 ? (uint32_t)sh : 0);
+}
+
+static void command_reset_clip(void* ctx) {
+    CommandSinkContext* c = (CommandSinkContext*)ctx;
+    afferent_renderer_reset_scissor(c->renderer);
+}
+
+static void command_sprites(void* ctx, uint32_t texture, const float* data, uint32_t count) {
+    CommandSinkContext* c = (CommandSinkContext*)ctx;
+    afferent_renderer_draw_sprites(c->renderer, c->textures[texture], data, count,
+        c->canvasWidth, c->canvasHeight);
+}
+
+bool afferent_renderer_execute_commands(
+    AfferentRendererRef renderer,
+    const uint8_t* data,
+    size_t size,
+    const AfferentFontRef* fonts,
+    uint32_t font_count,
+    const AfferentTextureRef* textures,
+    uint32_t texture_count,
+    float canvas_width,
+    float canvas_height,
+    AfferentCommandStreamInfo* info
+) {
+    static const AfferentCommandSink sink = {
+        command_triangles, command_text, command_set_clip, command_reset_clip, command_sprites
+    };
+    CommandSinkContext ctx = { renderer, fonts, textures, canvas_width, canvas_height };
+    return afferent_command_stream_execute(data, size, font_count, texture_count,
+        renderer->currentEncoder ? &sink : NULL, &ctx, info);
+}
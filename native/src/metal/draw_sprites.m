@@ -85,17 +85,19 @@ id<MTLTexture> createMetalTexture(id<MTLDevice> device, const uint8_t* data, uin
     return texture;
 }
 
-// Draw textured sprites (positions/rotation updated each frame)
-// data: [pixelX, pixelY, rotation, halfSizePixels, alpha] × count (5 floats per sprite)
-void afferent_renderer_draw_sprites(
+// Upload and draw `count` sprites. Instance data comes either from `data`
+// (already SpriteInstanceData) or is packed from `particles` during the copy.
+static void draw_sprites_common(
     AfferentRendererRef renderer,
     AfferentTextureRef texture,
     const float* data,
+    const double* particles,
+    float halfSize,
     uint32_t count,
     float canvasWidth,
     float canvasHeight
 ) {
-    if (!renderer || !renderer->currentEncoder || !texture || !data || count == 0) {
+    if (!renderer || !renderer->currentEncoder || !texture || (!data && !particles) || count == 0) {
         return;
     }
 
@@ -137,7 +139,11 @@ void afferent_renderer_draw_sprites(
             return;
         }
 
-        memcpy(spriteBuffer.contents, data, dataSize);
+        if (data) {
+            memcpy(spriteBuffer.contents, data, dataSize);
+        } else {
+            afferent_particles_pack_sprites(particles, count, halfSize, (float*)spriteBuffer.contents);
+        }
 
         SpriteUniforms uniforms = {
             .canvasWidth = canvasWidth,
@@ -157,6 +163,32 @@ void afferent_renderer_draw_sprites(
     }
 }
 
+// Draw textured sprites (positions/rotation updated each frame)
+// data: [pixelX, pixelY, rotation, halfSizePixels, alpha] × count (5 floats per sprite)
+void afferent_renderer_draw_sprites(
+    AfferentRendererRef renderer,
+    AfferentTextureRef texture,
+    const float* data,
+    uint32_t count,
+    float canvasWidth,
+    float canvasHeight
+) {
+    draw_sprites_common(renderer, texture, data, NULL, 0.0f, count, canvasWidth, canvasHeight);
+}
+
+// Draw sprites from particle state; the layout conversion happens in the upload copy
+void afferent_renderer_draw_sprites_particles(
+    AfferentRendererRef renderer,
+    AfferentTextureRef texture,
+    const double* particles,
+    uint32_t count,
+    float half_size,
+    float canvas_width,
+    float canvas_height
+) {
+    draw_sprites_common(renderer, texture, NULL, particles, half_size, count, canvas_width, canvas_height);
+}
+
 // Draw sprites from FloatBuffer that already contains SpriteInstanceData layout
 void afferent_renderer_draw_sprites_instance_buffer(
     AfferentRendererRef renderer,
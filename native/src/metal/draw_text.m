@@ -72,7 +72,8 @@ AfferentResult afferent_text_render(
             return AFFERENT_OK;  // Nothing to render
         }
 
-        // Generate vertex data
+        // Generate vertex data into the frame arena (released before returning)
+        AfferentFrameArenaMark scratch = afferent_frame_arena_mark(renderer->frameArena);
         float* vertices = NULL;
         uint32_t* indices = NULL;
         uint32_t vertex_count = 0;
@@ -84,12 +85,12 @@ AfferentResult afferent_text_render(
             font, text, x, y, r, g, b, a,
             canvas_width, canvas_height,
             transform,
+            renderer->frameArena,
             &vertices, &indices, &vertex_count, &index_count
         );
 
         if (!success || vertex_count == 0) {
-            free(vertices);
-            free(indices);
+            afferent_frame_arena_rewind(renderer->frameArena, scratch);
             return AFFERENT_OK;
         }
 
@@ -97,15 +98,13 @@ AfferentResult afferent_text_render(
         id<MTLTexture> fontTexture = ensureFontTexture(renderer, font);
         updateFontTexture(renderer, font);
 
-        // Ensure staging buffer is large enough (grows as needed, never shrinks)
-        if (vertex_count > g_text_vertex_staging_capacity) {
-            free(g_text_vertex_staging);
-            g_text_vertex_staging_capacity = vertex_count + 64;  // Add some headroom
-            g_text_vertex_staging = malloc(g_text_vertex_staging_capacity * sizeof(TextVertex));
+        // Convert float vertex data to TextVertex format in arena scratch
+        TextVertex* textVertices = afferent_frame_arena_alloc(renderer->frameArena,
+            vertex_count * sizeof(TextVertex));
+        if (!textVertices) {
+            afferent_frame_arena_rewind(renderer->frameArena, scratch);
+            return AFFERENT_ERROR_TEXT_FAILED;
         }
-
-        // Convert float vertex data to TextVertex format using staging buffer
-        TextVertex* textVertices = g_text_vertex_staging;
         for (uint32_t i = 0; i < vertex_count; i++) {
             size_t base = i * 8;  // 8 floats per vertex
             textVertices[i].position[0] = vertices[base + 0];
@@ -145,10 +144,8 @@ AfferentResult afferent_text_render(
             memcpy(indexBuffer.contents, indices, index_buffer_size);
         }
 
-        // Free the vertex/index data generated by afferent_text_generate_vertices
-        // (staging buffer is kept for reuse)
-        free(vertices);
-        free(indices);
+        // Scratch has been copied into the pooled buffers
+        afferent_frame_arena_rewind(renderer->frameArena, scratch);
 
         if (!vertexBuffer || !indexBuffer) {
             return AFFERENT_ERROR_TEXT_FAILED;
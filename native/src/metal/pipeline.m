@@ -303,6 +303,40 @@ AfferentResult create_pipelines(struct AfferentRenderer* renderer) {
         return AFFERENT_ERROR_PIPELINE_FAILED;
     }
 
+    // Create Canvas shape pipeline (rect and ellipse instances in one draw)
+    id<MTLFunction> shapeVertexFunction = [instancedLibrary newFunctionWithName:@"shape_instance_vertex"];
+    id<MTLFunction> shapeFragmentFunction = [instancedLibrary newFunctionWithName:@"shape_instance_fragment"];
+    if (!shapeVertexFunction || !shapeFragmentFunction) {
+        NSLog(@"Failed to find shape instance shader functions");
+        return AFFERENT_ERROR_PIPELINE_FAILED;
+    }
+
+    MTLRenderPipelineDescriptor *shapePipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
+    shapePipelineDesc.vertexFunction = shapeVertexFunction;
+    shapePipelineDesc.fragmentFunction = shapeFragmentFunction;
+    shapePipelineDesc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
+    shapePipelineDesc.rasterSampleCount = 4;  // Match MSAA by default
+    shapePipelineDesc.colorAttachments[0].blendingEnabled = YES;
+    shapePipelineDesc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorSourceAlpha;
+    shapePipelineDesc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+    shapePipelineDesc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
+    shapePipelineDesc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+    renderer->shapePipelineStateMSAA = [renderer->device newRenderPipelineStateWithDescriptor:shapePipelineDesc
+                                                                                        error:&error];
+    if (!renderer->shapePipelineStateMSAA) {
+        NSLog(@"Shape pipeline creation failed (MSAA): %@", error);
+        return AFFERENT_ERROR_PIPELINE_FAILED;
+    }
+
+    shapePipelineDesc.rasterSampleCount = 1;
+    renderer->shapePipelineStateNoMSAA = [renderer->device newRenderPipelineStateWithDescriptor:shapePipelineDesc
+                                                                                          error:&error];
+    if (!renderer->shapePipelineStateNoMSAA) {
+        NSLog(@"Shape pipeline creation failed (no MSAA): %@", error);
+        return AFFERENT_ERROR_PIPELINE_FAILED;
+    }
+
     // ====================================================================
     // Create animated pipelines (GPU-side animation for maximum performance)
     // ====================================================================
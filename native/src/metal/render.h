@@ -28,6 +28,7 @@ extern int afferent_text_generate_vertices(
     float r, float g, float b, float a,
     float screen_width, float screen_height,
     const float* transform,
+    AfferentFrameArenaRef arena,
     float** out_vertices,
     uint32_t** out_indices,
     uint32_t* out_vertex_count,
@@ -61,6 +62,8 @@ struct AfferentRenderer {
     id<MTLRenderPipelineState> instancedPipelineState; // For instanced rect rendering
     id<MTLRenderPipelineState> trianglePipelineState;  // For instanced triangle rendering
     id<MTLRenderPipelineState> circlePipelineState;    // For instanced circle rendering
+    id<MTLRenderPipelineState> shapePipelineStateMSAA;   // For Canvas rect/ellipse instances
+    id<MTLRenderPipelineState> shapePipelineStateNoMSAA;
     // Animated pipelines (GPU-side animation)
     id<MTLRenderPipelineState> animatedRectPipelineState;
     id<MTLRenderPipelineState> animatedTrianglePipelineState;
@@ -118,12 +121,15 @@ struct AfferentRenderer {
     // Orbital center (stored at upload time)
     float orbitalCenterX;
     float orbitalCenterY;
+    // Scratch for transient conversions (FFI arrays, text vertices); reset each frame
+    AfferentFrameArenaRef frameArena;
 };
 
 // Internal buffer structure
 struct AfferentBuffer {
     id<MTLBuffer> mtlBuffer;
     uint32_t count;
+    AfferentIndexFormat indexFormat;  // Index buffers only
 };
 
 // ============================================================================
@@ -159,10 +165,6 @@ typedef struct {
 // Global buffer pool
 extern BufferPool g_buffer_pool;
 
-// Staging buffer for text vertex conversion (reused across frames)
-extern TextVertex* g_text_vertex_staging;
-extern size_t g_text_vertex_staging_capacity;
-
 // Buffer pool functions (buffer_pool.m)
 struct AfferentBuffer* pool_acquire_wrapper(void);
 id<MTLBuffer> pool_acquire_buffer(id<MTLDevice> device, PooledBuffer* pool, int* count, size_t required_size, bool is_vertex);
@@ -11,6 +11,7 @@
 #import "draw_animated.m"
 #import "draw_sprites.m"
 #import "draw_3d.m"
+#import "draw_commands.m"
 
 // ============================================================================
 // Renderer Creation and Destruction
@@ -80,6 +81,12 @@ AfferentResult afferent_renderer_create(
         renderer->orbitalCenterX = 0;
         renderer->orbitalCenterY = 0;
 
+        if (afferent_frame_arena_create(256 * 1024, &renderer->frameArena) != AFFERENT_OK) {
+            NSLog(@"Failed to create frame arena");
+            free(renderer);
+            return AFFERENT_ERROR_INIT_FAILED;
+        }
+
         *out_renderer = renderer;
         return AFFERENT_OK;
     }
@@ -87,6 +94,7 @@ AfferentResult afferent_renderer_create(
 
 void afferent_renderer_destroy(AfferentRendererRef renderer) {
     if (renderer) {
+        afferent_frame_arena_destroy(renderer->frameArena);
         free(renderer);
     }
 }
@@ -124,6 +132,11 @@ void afferent_renderer_set_drawable_scale(AfferentRendererRef renderer, float sc
     }
 }
 
+// Per-renderer scratch for the FFI layer; valid until the next begin_frame.
+AfferentFrameArenaRef afferent_renderer_frame_arena(AfferentRendererRef renderer) {
+    return renderer ? renderer->frameArena : NULL;
+}
+
 // ============================================================================
 // Frame Management
 // ============================================================================
@@ -132,6 +145,8 @@ AfferentResult afferent_renderer_begin_frame(AfferentRendererRef renderer, float
     @autoreleasepool {
         // Reset buffer pool at frame start - all buffers become available for reuse
         pool_reset_frame();
+        // Last frame's transient scratch is dead once its draws were encoded
+        afferent_frame_arena_reset(renderer->frameArena);
 
         CAMetalLayer *metalLayer = afferent_window_get_metal_layer(renderer->window);
         if (!metalLayer) {
@@ -261,14 +276,16 @@ AfferentResult afferent_buffer_create_vertex(
     }
 }
 
-AfferentResult afferent_buffer_create_index(
+// Copy indices of either width into a pooled index buffer
+static AfferentResult buffer_create_index_bytes(
     AfferentRendererRef renderer,
-    const uint32_t* indices,
+    const void* indices,
     uint32_t index_count,
+    AfferentIndexFormat format,
     AfferentBufferRef* out_buffer
 ) {
     @autoreleasepool {
-        size_t required_size = index_count * sizeof(uint32_t);
+        size_t required_size = index_count * (format == AFFERENT_INDEX_U16 ? sizeof(uint16_t) : sizeof(uint32_t));
 
         // Get a buffer from the pool (or create a new one)
         id<MTLBuffer> mtlBuffer = pool_acquire_buffer(
@@ -290,7 +307,26 @@ AfferentResult afferent_buffer_create_index(
         struct AfferentBuffer *buffer = pool_acquire_wrapper();
         buffer->count = index_count;
         buffer->mtlBuffer = mtlBuffer;
+        buffer->indexFormat = format;
         *out_buffer = buffer;
         return AFFERENT_OK;
     }
 }
+
+AfferentResult afferent_buffer_create_index(
+    AfferentRendererRef renderer,
+    const uint32_t* indices,
+    uint32_t index_count,
+    AfferentBufferRef* out_buffer
+) {
+    return buffer_create_index_bytes(renderer, indices, index_count, AFFERENT_INDEX_U32, out_buffer);
+}
+
+AfferentResult afferent_buffer_create_index_u16(
+    AfferentRendererRef renderer,
+    const uint16_t* indices,
+    uint32_t index_count,
+    AfferentBufferRef* out_buffer
+) {
+    return buffer_create_index_bytes(renderer, indices, index_count, AFFERENT_INDEX_U16, out_buffer);
+}
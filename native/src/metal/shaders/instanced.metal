@@ -134,3 +134,58 @@ fragment float4 instanced_circle_fragment(CircleVertexOut in [[stage_in]]) {
     if (alpha < 0.01) discard_fragment();
     return float4(in.color.rgb, in.color.a * alpha);
 }
+
+// === CANVAS SHAPE SHADER ===
+// Rects and ellipses routed from Canvas fills: each instance is the affine
+// image of the unit square or disc, so any transform the Canvas applies is
+// exact and rects and ellipses can share one draw
+
+struct ShapeInstanceData {
+    packed_float2 center;    // NDC (8 bytes)
+    packed_float2 axisX;     // Image of (1, 0) in NDC (8 bytes)
+    packed_float2 axisY;     // Image of (0, 1) in NDC (8 bytes)
+    packed_float4 color;     // RGBA (16 bytes)
+    float kind;              // 0 = rect, 1 = ellipse (4 bytes)
+    float padding;           // (4 bytes)
+};  // Total: 48 bytes
+
+struct ShapeVertexOut {
+    float4 position [[position]];
+    float4 color;
+    float2 uv;   // -1 to 1 across the unit shape
+    float kind;
+};
+
+vertex ShapeVertexOut shape_instance_vertex(
+    uint vid [[vertex_id]],
+    uint iid [[instance_id]],
+    constant ShapeInstanceData* instances [[buffer(0)]]
+) {
+    float2 unitQuad[4] = {
+        float2(-1, -1),
+        float2( 1, -1),
+        float2(-1,  1),
+        float2( 1,  1)
+    };
+
+    ShapeInstanceData inst = instances[iid];
+    float2 v = unitQuad[vid];
+    float2 finalPos = float2(inst.center) + v.x * float2(inst.axisX) + v.y * float2(inst.axisY);
+
+    ShapeVertexOut out;
+    out.position = float4(finalPos, 0.0, 1.0);
+    out.color = inst.color;
+    out.uv = v;
+    out.kind = inst.kind;
+    return out;
+}
+
+fragment float4 shape_instance_fragment(ShapeVertexOut in [[stage_in]]) {
+    if (in.kind < 0.5) return in.color;
+    // Ellipse: unit circle in uv, edge softened over one pixel
+    float dist = length(in.uv);
+    float width = max(fwidth(dist), 1e-4);
+    float alpha = 1.0 - smoothstep(1.0 - width, 1.0, dist);
+    if (alpha < 0.01) discard_fragment();
+    return float4(in.color.rgb, in.color.a * alpha);
+}
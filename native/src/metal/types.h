@@ -19,6 +19,16 @@ typedef struct __attribute__((packed)) {
     float color[4];     // RGBA (16 bytes)
 } InstanceData;  // Total: 32 bytes
 
+// Canvas shape instance (matches shader) - 48 bytes packed
+typedef struct __attribute__((packed)) {
+    float center[2];    // NDC (8 bytes)
+    float axisX[2];     // Image of unit x in NDC (8 bytes)
+    float axisY[2];     // Image of unit y in NDC (8 bytes)
+    float color[4];     // RGBA (16 bytes)
+    float kind;         // 0 = rect, 1 = ellipse (4 bytes)
+    float padding;      // (4 bytes)
+} ShapeInstanceData;  // Total: 48 bytes
+
 // Animated instance data structure (matches shader) - 24 bytes
 typedef struct {
     float pixelPos[2];      // Position in pixel coordinates (8 bytes)
@@ -41,6 +41,9 @@ struct AfferentWindow {
     float clickX[AFFERENT_CLICK_CAP];
     float clickY[AFFERENT_CLICK_CAP];
     uint16_t clickModifiers[AFFERENT_CLICK_CAP];
+    // Size reported by headless windows (no view to query)
+    uint32_t headlessWidth;
+    uint32_t headlessHeight;
 };
 
 static inline void afferent_window_push_click(struct AfferentWindow *w, uint8_t button, float x, float y, uint16_t modifiers) {
@@ -468,6 +471,32 @@ AfferentResult afferent_window_create(
     }
 }
 
+AfferentResult afferent_window_create_headless(
+    uint32_t width,
+    uint32_t height,
+    AfferentWindowRef* out_window
+) {
+    @autoreleasepool {
+        id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+        if (!device) {
+            NSLog(@"Failed to create Metal device");
+            return AFFERENT_ERROR_DEVICE_FAILED;
+        }
+
+        // No window, view or delegate; messages to them are no-ops returning zero
+        struct AfferentWindow *handle = calloc(1, sizeof(struct AfferentWindow));
+        if (!handle) {
+            return AFFERENT_ERROR_INIT_FAILED;
+        }
+        handle->device = device;
+        handle->headlessWidth = width;
+        handle->headlessHeight = height;
+
+        *out_window = handle;
+        return AFFERENT_OK;
+    }
+}
+
 void afferent_window_destroy(AfferentWindowRef window) {
     if (window) {
         @autoreleasepool {
@@ -482,6 +511,7 @@ bool afferent_window_should_close(AfferentWindowRef window) {
 }
 
 void afferent_window_poll_events(AfferentWindowRef window) {
+    if (window && !window->nsWindow) return;
     @autoreleasepool {
         NSEvent *event;
         while ((event = [NSApp nextEventMatchingMask:NSEventMaskAny
@@ -495,7 +525,10 @@ void afferent_window_poll_events(AfferentWindowRef window) {
 }
 
 void afferent_window_get_size(AfferentWindowRef window, uint32_t* width, uint32_t* height) {
-    if (window) {
+    if (window && !window->view) {
+        *width = window->headlessWidth;
+        *height = window->headlessHeight;
+    } else if (window) {
         CGSize size = window->view.metalLayer.drawableSize;
         *width = (uint32_t)size.width;
         *height = (uint32_t)size.height;